@@ -178,6 +178,18 @@ CommandLineHandler::CommandLineHandler()
             .set_syntax("filename")
             .set_exact_value_count(1));
 
+    parser().add_option_handler(
+        &m_progress_stream
+            .add_name("--progress-stream")
+            .set_description("write rendering progress and time estimates to a file, as one JSON object per line")
+            .set_syntax("filename")
+            .set_exact_value_count(1));
+
+    parser().add_option_handler(
+        &m_asynchronous_logging
+            .add_name("--asynchronous-logging")
+            .set_description("write renderer messages from a background thread"));
+
     parser().add_option_handler(
         &m_disable_autosave
             .add_name("--disable-autosave")
@@ -81,6 +81,8 @@ class CommandLineHandler
     foundation::FlagOptionHandler                       m_send_to_stdout;
     foundation::FlagOptionHandler                       m_disable_autosave;
     foundation::ValueOptionHandler<std::string>         m_save_light_paths;
+    foundation::ValueOptionHandler<std::string>         m_progress_stream;
+    foundation::FlagOptionHandler                       m_asynchronous_logging;
 
     // Developer-oriented options.
     foundation::ValueOptionHandler<std::string>         m_run_unit_tests;
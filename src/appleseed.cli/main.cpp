@@ -71,6 +71,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <memory>
 #include <string>
 
@@ -548,8 +549,22 @@ namespace
         if (!configure_project(project.ref(), params))
             return false;
 
+        // Open the progress stream if one was requested.
+        std::ofstream progress_stream;
+        if (g_cl.m_progress_stream.is_set())
+        {
+            const char* file_path = g_cl.m_progress_stream.value().c_str();
+            progress_stream.open(file_path);
+            if (!progress_stream.is_open())
+            {
+                LOG_ERROR(g_logger, "failed to open progress stream %s: i/o error.", file_path);
+                return false;
+            }
+        }
+
         // Create the tile callback factory.
         std::unique_ptr<ITileCallbackFactory> tile_callback_factory;
+        bool progress_stream_used = false;
         if (g_cl.m_send_to_stdout.is_set())
         {
             tile_callback_factory.reset(
@@ -564,10 +579,19 @@ namespace
                 tile_callback_factory.reset(
                     new ProgressTileCallbackFactory(
                         global_logger(),
-                        params.get_optional<size_t>("passes", 1)));
+                        params.get_optional<size_t>("passes", 1),
+                        progress_stream.is_open() ? &progress_stream : nullptr));
+                progress_stream_used = true;
             }
         }
 
+        if (progress_stream.is_open() && !progress_stream_used)
+        {
+            LOG_WARNING(
+                g_logger,
+                "progress stream is not written when rendering to standard output, to a display or progressively.");
+        }
+
         SearchPaths resource_search_paths;
         Application::initialize_resource_search_paths(resource_search_paths);
 
@@ -764,6 +788,10 @@ int main(int argc, char* argv[])
     // target of the global logger.
     global_logger().initialize_from(g_logger);
 
+    // Optionally move the writing of renderer messages off the rendering threads.
+    if (g_cl.m_asynchronous_logging.is_set())
+        global_logger().set_asynchronous();
+
     bool success = true;
 
     // Run unit tests.
@@ -784,6 +812,9 @@ int main(int argc, char* argv[])
         else success = success && render(project_filename);
     }
 
+    // Write pending renderer messages while the log targets are still alive.
+    global_logger().set_asynchronous(false);
+
     const int return_code = success ? 0 : 1;
     LOG_DEBUG(g_logger, "returning code %d.", return_code);
 
@@ -44,8 +44,11 @@
 #include "foundation/utility/stopwatch.h"
 
 // Standard headers.
+#include <algorithm>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 using namespace foundation;
 using namespace renderer;
@@ -63,11 +66,14 @@ namespace
       : public TileCallbackBase
     {
       public:
-        ProgressTileCallback(Logger& logger, const size_t pass_count)
+        ProgressTileCallback(
+            Logger&         logger,
+            const size_t    pass_count,
+            std::ostream*   progress_stream)
           : m_logger(logger)
-          , m_rendered_pixels(0)
-          , m_rendered_tiles(0)
           , m_pass_count(pass_count)
+          , m_progress_stream(progress_stream)
+          , m_rendered_pixels(0)
         {
         }
 
@@ -79,9 +85,29 @@ namespace
 
         void on_tiled_frame_begin(const Frame* frame) override
         {
-            // Do not restart the stopwatch if it is already running.
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            // Do not restart the stopwatch and forget tile costs if the render is already under way.
             if (m_rendered_pixels == 0)
+            {
+                const CanvasProperties& props = frame->image().properties();
+                m_estimator.reset(new RenderTimeEstimator(props, m_pass_count));
+                m_tile_begin_times.assign(props.m_tile_count, 0.0);
                 m_stopwatch.start();
+            }
+        }
+
+        void on_tile_begin(
+            const Frame*    frame,
+            const size_t    tile_x,
+            const size_t    tile_y,
+            const size_t    thread_index,
+            const size_t    thread_count) override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            const size_t tile_count_x = frame->image().properties().m_tile_count_x;
+            m_tile_begin_times[tile_y * tile_count_x + tile_x] = m_stopwatch.measure().get_seconds();
         }
 
         void on_tile_end(
@@ -91,42 +117,74 @@ namespace
         {
             boost::mutex::scoped_lock lock(m_mutex);
 
+            const CanvasProperties& props = frame->image().properties();
+
+            // Measure the time it took to render this tile.
+            const double elapsed_time = m_stopwatch.measure().get_seconds();
+            const double tile_time = elapsed_time - m_tile_begin_times[tile_y * props.m_tile_count_x + tile_x];
+            m_estimator->record_tile(tile_x, tile_y, tile_time);
+
             // Keep track of the total number of rendered pixels.
             const Tile& tile = frame->image().tile(tile_x, tile_y);
             m_rendered_pixels += tile.get_pixel_count();
 
-            // Retrieve the total number of pixels.
-            const size_t total_pixels = frame->image().properties().m_pixel_count * m_pass_count;
+            // Retrieve the total number of pixels and tiles.
+            const size_t total_pixels = props.m_pixel_count * m_pass_count;
+            const size_t total_tiles = props.m_tile_count * m_pass_count;
+            const size_t rendered_tiles = m_estimator->get_rendered_tile_count();
 
-            // Keep track of the total number of rendered tiles.
-            ++m_rendered_tiles;
+            // Estimate remaining render time from the predicted cost of the remaining tiles.
+            const double remaining_time = m_estimator->estimate_remaining_time(elapsed_time);
 
-            // Retrieve the total number of tiles.
-            const size_t total_tiles = frame->image().properties().m_tile_count * m_pass_count;
-
-            // Estimate remaining render time.
-            m_stopwatch.measure();
-            const double elapsed_time = m_stopwatch.get_seconds();
-            const double remaining_time = (elapsed_time / m_rendered_tiles) * (total_tiles - m_rendered_tiles);
+            // Compute rendering throughput.
+            const double rcp_elapsed_time = elapsed_time > 0.0 ? 1.0 / elapsed_time : 0.0;
+            const double tiles_per_second = rendered_tiles * rcp_elapsed_time;
+            const double pixels_per_second = m_estimator->get_rendered_pixel_count() * rcp_elapsed_time;
 
             // Print a progress message.
-            if (m_rendered_tiles <= total_tiles)
+            if (rendered_tiles <= total_tiles)
             {
                 LOG_INFO(
                     m_logger,
-                    "rendering, %s done; about %s remaining...",
+                    "rendering, %s done; about %s remaining (%s tiles/s)...",
                     pretty_percent(m_rendered_pixels, total_pixels).c_str(),
-                    pretty_time(remaining_time).c_str());
+                    pretty_time(std::max(remaining_time, 0.0)).c_str(),
+                    pretty_scalar(tiles_per_second).c_str());
+            }
+
+            // Write a progress record.
+            if (m_progress_stream)
+            {
+                *m_progress_stream
+                    << "{\"tile_x\": " << tile_x
+                    << ", \"tile_y\": " << tile_y
+                    << ", \"tile_time\": " << tile_time
+                    << ", \"rendered_tiles\": " << rendered_tiles
+                    << ", \"total_tiles\": " << total_tiles
+                    << ", \"progress\": " << m_estimator->get_progress()
+                    << ", \"elapsed_time\": " << elapsed_time
+                    << ", \"remaining_time\": ";
+
+                if (remaining_time >= 0.0)
+                    *m_progress_stream << remaining_time;
+                else *m_progress_stream << "null";
+
+                *m_progress_stream
+                    << ", \"tiles_per_second\": " << tiles_per_second
+                    << ", \"pixels_per_second\": " << pixels_per_second
+                    << "}" << std::endl;
             }
         }
 
       private:
-        Logger&                             m_logger;
-        const size_t                        m_pass_count;
-        boost::mutex                        m_mutex;
-        size_t                              m_rendered_pixels;
-        size_t                              m_rendered_tiles;
-        Stopwatch<DefaultWallclockTimer>    m_stopwatch;
+        Logger&                                 m_logger;
+        const size_t                            m_pass_count;
+        std::ostream*                           m_progress_stream;
+        boost::mutex                            m_mutex;
+        size_t                                  m_rendered_pixels;
+        std::unique_ptr<RenderTimeEstimator>    m_estimator;
+        std::vector<double>                     m_tile_begin_times;
+        Stopwatch<DefaultWallclockTimer>        m_stopwatch;
     };
 }
 
@@ -142,12 +200,13 @@ struct ProgressTileCallbackFactory::Impl
 
 ProgressTileCallbackFactory::ProgressTileCallbackFactory(
     Logger&         logger,
-    const size_t    pass_count)
+    const size_t    pass_count,
+    std::ostream*   progress_stream)
   : impl(new Impl())
 {
     impl->m_callback =
         std::unique_ptr<ITileCallback>(
-            new ProgressTileCallback(logger, pass_count));
+            new ProgressTileCallback(logger, pass_count, progress_stream));
 }
 
 ProgressTileCallbackFactory::~ProgressTileCallbackFactory()
@@ -34,6 +34,7 @@
 
 // Standard headers.
 #include <cstddef>
+#include <iosfwd>
 
 // Forward declarations.
 namespace foundation { class Logger; }
@@ -45,7 +46,12 @@ class ProgressTileCallbackFactory
   : public renderer::ITileCallbackFactory
 {
   public:
-    ProgressTileCallbackFactory(foundation::Logger& logger, const size_t pass_count);
+    // If a progress stream is provided, a JSON object describing the progress of
+    // the render is written to it on a separate line each time a tile is rendered.
+    ProgressTileCallbackFactory(
+        foundation::Logger&     logger,
+        const size_t            pass_count,
+        std::ostream*           progress_stream = nullptr);
 
     // Destructor.
     ~ProgressTileCallbackFactory() override;
@@ -98,6 +98,20 @@ namespace
         logger->set_format(category, format);
     }
 
+    void logger_set_asynchronous(Logger* logger, const bool asynchronous)
+    {
+        // Disabling asynchronous logging waits for the background thread,
+        // which may need the GIL to write to Python log targets.
+        ScopedGILUnlock unlock;
+        logger->set_asynchronous(asynchronous);
+    }
+
+    void logger_flush(Logger* logger)
+    {
+        ScopedGILUnlock unlock;
+        logger->flush();
+    }
+
     void logger_add_target(Logger* logger, bpy::object target)
     {
         ILogTargetWrap* p = bpy::extract<ILogTargetWrap*>(target);
@@ -129,6 +143,11 @@ void bind_logger()
 
     bpy::class_<Logger, boost::noncopyable>("Logger", bpy::no_init)
         .def("set_enabled", &Logger::set_enabled)
+        .def("set_asynchronous", logger_set_asynchronous)
+        .def("is_asynchronous", &Logger::is_asynchronous)
+        .def("set_max_queued_size", &Logger::set_max_queued_size)
+        .def("flush", logger_flush)
+        .def("get_dropped_message_count", &Logger::get_dropped_message_count)
         .def("set_verbosity_level", &Logger::set_verbosity_level)
         .def("get_verbosity_level", &Logger::get_verbosity_level)
         .def("reset_all_formats", &Logger::reset_all_formats)
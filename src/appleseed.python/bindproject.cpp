@@ -350,7 +350,8 @@ void bind_project()
         .value("OmitReadingMeshFiles", ProjectFileReader::OmitReadingMeshFiles)
         .value("OmitProjectFileUpdate", ProjectFileReader::OmitProjectFileUpdate)
         .value("OmitSearchPaths", ProjectFileReader::OmitSearchPaths)
-        .value("OmitProjectSchemaValidation", ProjectFileReader::OmitProjectSchemaValidation);
+        .value("OmitProjectSchemaValidation", ProjectFileReader::OmitProjectSchemaValidation)
+        .value("UseLightweightParser", ProjectFileReader::UseLightweightParser);
 
     bpy::class_<ProjectFileReader>("ProjectFileReader")
         .def("read", &project_file_reader_read_default_opts)
@@ -27,12 +27,17 @@
 // THE SOFTWARE.
 //
 
+// appleseed.python headers.
+#include "dict2dict.h"
+
 // appleseed.renderer headers.
 #include "renderer/api/log.h"
 #include "renderer/modeling/project/eventcounters.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/oiiomaketexture.h"
 
 // appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
 #include "foundation/platform/python.h"
 #include "foundation/utility/api/apistring.h"
 
@@ -63,6 +68,11 @@ namespace
         if (!success)
             PyErr_SetString(PyExc_RuntimeError, error_msg.c_str());
     }
+
+    bpy::dict memory_tracker_get_entries(const MemoryTracker* tracker)
+    {
+        return dictionary_to_bpy_dict(tracker->get_entries());
+    }
 }
 
 void bind_utility()
@@ -85,5 +95,30 @@ void bind_utility()
 
     bpy::def("global_logger", global_logger, bpy::return_value_policy<bpy::reference_existing_object>());
 
+    bpy::enum_<MemoryTracker::Category>("MemoryTrackerCategory")
+        .value("Object", MemoryTracker::CategoryObject)
+        .value("Texture", MemoryTracker::CategoryTexture)
+        .value("Tree", MemoryTracker::CategoryTree)
+        .value("FrameBuffer", MemoryTracker::CategoryFrameBuffer);
+
+    bpy::class_<MemoryTracker, boost::noncopyable>("MemoryTracker")
+        .def("get_category_name", &MemoryTracker::get_category_name).staticmethod("get_category_name")
+        .def("set", &MemoryTracker::set)
+        .def("add", &MemoryTracker::add)
+        .def("subtract", &MemoryTracker::subtract)
+        .def("remove", &MemoryTracker::remove)
+        .def("clear", &MemoryTracker::clear)
+        .def("get_size", &MemoryTracker::get_size)
+        .def("get_owner_size", &MemoryTracker::get_owner_size)
+        .def("get_category_size", &MemoryTracker::get_category_size)
+        .def("get_total_size", &MemoryTracker::get_total_size)
+        .def("get_peak_total_size", &MemoryTracker::get_peak_total_size)
+        .def("set_soft_budget", &MemoryTracker::set_soft_budget)
+        .def("get_soft_budget", &MemoryTracker::get_soft_budget)
+        .def("check_budget", &MemoryTracker::check_budget)
+        .def("get_entries", memory_tracker_get_entries);
+
+    bpy::def("global_memory_tracker", global_memory_tracker, bpy::return_value_policy<bpy::reference_existing_object>());
+
     bpy::def("oiio_make_texture", &make_texture);
 }
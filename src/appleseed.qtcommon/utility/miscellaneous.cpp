@@ -157,7 +157,7 @@ QString get_project_files_filter(const int filters)
     QStringList filter_list;
 
     if (filters & ProjectFilesFilterAllProjects)
-        filter_list << "Project Files (*.appleseed *.appleseedz)";
+        filter_list << "Project Files (*.appleseed *.appleseedz *.appleseedb)";
 
     if (filters & ProjectFilesFilterPlainProjects)
         filter_list << "Plain Project Files (*.appleseed)";
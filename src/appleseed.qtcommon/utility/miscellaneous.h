@@ -56,7 +56,7 @@ QString get_oiio_image_files_filter();
 
 enum ProjectFilesFilter
 {
-    ProjectFilesFilterAllProjects       = 1UL << 0,     // all project files extensions
+    ProjectFilesFilterAllProjects       = 1UL << 0,     // all project files extensions (including .appleseedb)
     ProjectFilesFilterPlainProjects     = 1UL << 1,     // .appleseed extension
     ProjectFilesFilterPackedProjects    = 1UL << 2,     // .appleseedz extension
     ProjectFilesFilterDefault           =
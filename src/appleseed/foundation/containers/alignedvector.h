@@ -40,7 +40,8 @@ namespace foundation
 
 //
 // foundation::AlignedVector is a partial specialization of std::vector for
-// the foundation::AlignedAllocator memory allocator.
+// the foundation::AlignedAllocator memory allocator. Another allocator with
+// the same interface, such as foundation::LargeAllocator, may be substituted.
 //
 // foundation::AlignedVector also works around a particularity in Visual Studio's
 // implementation of the STL where std::vector::resize() takes the value of new
@@ -73,12 +74,12 @@ struct VectorElementWrapper
 };
 
 #ifdef _MSC_VER
-#define ALIGNED_VECTOR_BASE std::vector<VectorElementWrapper<T>, AlignedAllocator<VectorElementWrapper<T>>>
+#define ALIGNED_VECTOR_BASE std::vector<VectorElementWrapper<T>, Allocator<VectorElementWrapper<T>>>
 #else
-#define ALIGNED_VECTOR_BASE std::vector<T, AlignedAllocator<T>>
+#define ALIGNED_VECTOR_BASE std::vector<T, Allocator<T>>
 #endif
 
-template <typename T>
+template <typename T, template <typename> class Allocator = AlignedAllocator>
 class AlignedVector
   : public ALIGNED_VECTOR_BASE
 {
@@ -34,6 +34,7 @@
 
 // Standard headers.
 #include <cstring>
+#include <fstream>
 
 namespace foundation
 {
@@ -163,4 +164,25 @@ std::ostream& operator<<(std::ostream& o, const MurmurHash& hash)
     return o;
 }
 
+bool hash_file_contents(const std::string& filepath, MurmurHash& hash)
+{
+    std::ifstream file(filepath.c_str(), std::ios::in | std::ios::binary);
+
+    if (!file.is_open())
+        return false;
+
+    const size_t ChunkSize = 1024 * 1024;
+    std::string chunk;
+
+    while (file)
+    {
+        chunk.resize(ChunkSize);
+        file.read(&chunk[0], ChunkSize);
+        chunk.resize(static_cast<size_t>(file.gcount()));
+        hash.append(chunk);
+    }
+
+    return !file.bad();
+}
+
 }   // namespace foundation
@@ -83,6 +83,9 @@ class APPLESEED_DLLSYMBOL MurmurHash
 
 std::ostream& operator<<(std::ostream& o, const MurmurHash& hash);
 
+// Append the contents of a file to a hash. Return false if the file could not be read.
+APPLESEED_DLLSYMBOL bool hash_file_contents(const std::string& filepath, MurmurHash& hash);
+
 
 //
 // MurmurHash class implementation.
@@ -38,6 +38,7 @@
 // Standard headers.
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 namespace foundation
 {
@@ -53,13 +54,15 @@ class AccumulatorTile
     AccumulatorTile(
         const size_t        width,
         const size_t        height,
-        const size_t        channel_count);
+        const size_t        channel_count,
+        std::uint8_t*       storage = nullptr);     // if provided, use this memory for pixel storage
 
     AccumulatorTile(
         const size_t        width,
         const size_t        height,
         const size_t        channel_count,
-        const AABB2u&       crop_window);
+        const AABB2u&       crop_window,
+        std::uint8_t*       storage = nullptr);     // if provided, use this memory for pixel storage
 
     // Tile properties.
     size_t get_channel_count() const;   // number of channels in one pixel, excluding the weight channel
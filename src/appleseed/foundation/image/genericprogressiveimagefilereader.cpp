@@ -73,6 +73,8 @@ struct GenericProgressiveImageFileReader::Impl
 
     bool                                    m_supports_random_access;
     bool                                    m_is_tiled;
+    int                                     m_subimage;
+    int                                     m_mip_level;
     CanvasProperties                        m_props;
 
     void open()
@@ -83,6 +85,8 @@ struct GenericProgressiveImageFileReader::Impl
             throw ExceptionIOError(OIIO::geterror().c_str());
 
         m_supports_random_access = m_input->supports("random_access") != 0;
+        m_subimage = 0;
+        m_mip_level = 0;
         read_spec(m_input->spec());
     }
 
@@ -155,6 +159,8 @@ GenericProgressiveImageFileReader::GenericProgressiveImageFileReader(Logger* log
     impl->m_input = nullptr;
     impl->m_supports_random_access = false;
     impl->m_is_tiled = false;
+    impl->m_subimage = 0;
+    impl->m_mip_level = 0;
 }
 
 GenericProgressiveImageFileReader::~GenericProgressiveImageFileReader()
@@ -249,7 +255,49 @@ bool GenericProgressiveImageFileReader::choose_subimage(const size_t subimage) c
         spec);
 
     if (success)
+    {
+        impl->m_subimage = static_cast<int>(subimage);
+        impl->m_mip_level = 0;
+        impl->read_spec(spec);
+    }
+
+    return success;
+}
+
+size_t GenericProgressiveImageFileReader::get_mip_level_count() const
+{
+    assert(is_open());
+
+    // OpenImageIO does not expose the number of MIP levels: probe them one by one.
+    OIIO::ImageSpec spec;
+    int level_count = 1;
+    while (impl->m_input->seek_subimage(impl->m_subimage, level_count, spec))
+        ++level_count;
+
+    // Go back to the MIP level that was selected before probing.
+    impl->m_input->seek_subimage(impl->m_subimage, impl->m_mip_level, spec);
+
+    return static_cast<size_t>(level_count);
+}
+
+bool GenericProgressiveImageFileReader::choose_mip_level(const size_t level) const
+{
+    assert(is_open());
+
+    if (static_cast<int>(level) == impl->m_mip_level)
+        return true;
+
+    OIIO::ImageSpec spec;
+    const bool success = impl->m_input->seek_subimage(
+        impl->m_subimage,
+        static_cast<int>(level),
+        spec);
+
+    if (success)
+    {
+        impl->m_mip_level = static_cast<int>(level);
         impl->read_spec(spec);
+    }
 
     return success;
 }
@@ -366,8 +414,23 @@ void GenericProgressiveImageFileReader::read_tile(
 
         if (!impl->m_supports_random_access)
         {
+            const int subimage = impl->m_subimage;
+            const int mip_level = impl->m_mip_level;
+
             close();
             impl->open();
+
+            // Go back to the layer and MIP level that were selected before reopening the file.
+            if (subimage != 0 || mip_level != 0)
+            {
+                OIIO::ImageSpec spec;
+                if (impl->m_input->seek_subimage(subimage, mip_level, spec))
+                {
+                    impl->m_subimage = subimage;
+                    impl->m_mip_level = mip_level;
+                    impl->read_spec(spec);
+                }
+            }
         }
 
         // TODO: placeholder values for `chbegin` and `chend`
@@ -82,6 +82,13 @@ class APPLESEED_DLLSYMBOL GenericProgressiveImageFileReader
     // Choose the layer in the image file if available.
     bool choose_subimage(const size_t subimage) const;
 
+    // Return the number of MIP levels of the current layer (1 if the layer is not mipmapped).
+    size_t get_mip_level_count() const;
+
+    // Choose the MIP level in the current layer. Level 0 is the full resolution image.
+    // Canvas properties and tiles are then read from this MIP level.
+    bool choose_mip_level(const size_t level) const;
+
     // Read an image tile. Returns a newly allocated tile.
     Tile* read_tile(
         const size_t        tile_x,
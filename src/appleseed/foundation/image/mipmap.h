@@ -0,0 +1,214 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/image/tile.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// Generation of MIP levels by box-filtering the previous, finer level.
+//
+// Each pixel of level L is the average of the 2 x 2 pixels of level L - 1 it covers.
+// Pixels of level L - 1 left over on the right and bottom edges (when its dimensions
+// are odd) are folded into the last column and row.
+//
+// The tiles of level L - 1 are fetched through a tile accessor, a class with a
+//
+//   const Tile& get_tile(const size_t tile_x, const size_t tile_y);
+//
+// method, so that a level can for instance be generated from an image file tile
+// by tile without loading the whole file.
+//
+
+// Tile accessor over the tiles of an image.
+class ImageTileAccessor
+{
+  public:
+    explicit ImageTileAccessor(const Image& image);
+
+    const Tile& get_tile(const size_t tile_x, const size_t tile_y);
+
+  private:
+    const Image& m_image;
+};
+
+// Generate a given tile of a MIP level from the previous, finer level.
+template <typename TileAccessor>
+Tile* generate_mip_level_tile(
+    TileAccessor&               source,
+    const CanvasProperties&     source_props,
+    const CanvasProperties&     level_props,
+    const size_t                tile_x,
+    const size_t                tile_y);
+
+// Generate all the tiles of a MIP level from the previous, finer level.
+template <typename TileAccessor>
+std::unique_ptr<Image> generate_mip_level(
+    TileAccessor&               source,
+    const CanvasProperties&     source_props,
+    const CanvasProperties&     level_props);
+
+
+//
+// ImageTileAccessor class implementation.
+//
+
+inline ImageTileAccessor::ImageTileAccessor(const Image& image)
+  : m_image(image)
+{
+}
+
+inline const Tile& ImageTileAccessor::get_tile(const size_t tile_x, const size_t tile_y)
+{
+    return m_image.tile(tile_x, tile_y);
+}
+
+
+//
+// MIP level generation functions implementation.
+//
+
+template <typename TileAccessor>
+Tile* generate_mip_level_tile(
+    TileAccessor&               source,
+    const CanvasProperties&     source_props,
+    const CanvasProperties&     level_props,
+    const size_t                tile_x,
+    const size_t                tile_y)
+{
+    const size_t channel_count = source_props.m_channel_count;
+
+    // Compute the extent of the tile in MIP level space.
+    const size_t origin_x = tile_x * level_props.m_tile_width;
+    const size_t origin_y = tile_y * level_props.m_tile_height;
+    const size_t width = std::min(level_props.m_tile_width, level_props.m_canvas_width - origin_x);
+    const size_t height = std::min(level_props.m_tile_height, level_props.m_canvas_height - origin_y);
+
+    // Compute the extent of the tile in source level space.
+    const size_t source_x0 = origin_x * 2;
+    const size_t source_y0 = origin_y * 2;
+    const size_t source_x1 =
+        origin_x + width == level_props.m_canvas_width
+            ? source_props.m_canvas_width
+            : (origin_x + width) * 2;
+    const size_t source_y1 =
+        origin_y + height == level_props.m_canvas_height
+            ? source_props.m_canvas_height
+            : (origin_y + height) * 2;
+
+    std::vector<float> sums(width * height * channel_count, 0.0f);
+    std::vector<float> weights(width * height, 0.0f);
+
+    // Accumulate the source level tiles overlapping the tile.
+    const size_t source_tile_x0 = source_x0 / source_props.m_tile_width;
+    const size_t source_tile_y0 = source_y0 / source_props.m_tile_height;
+    const size_t source_tile_x1 = (source_x1 - 1) / source_props.m_tile_width;
+    const size_t source_tile_y1 = (source_y1 - 1) / source_props.m_tile_height;
+
+    for (size_t ty = source_tile_y0; ty <= source_tile_y1; ++ty)
+    {
+        for (size_t tx = source_tile_x0; tx <= source_tile_x1; ++tx)
+        {
+            const Tile& source_tile = source.get_tile(tx, ty);
+
+            const size_t tile_origin_x = tx * source_props.m_tile_width;
+            const size_t tile_origin_y = ty * source_props.m_tile_height;
+            const size_t x0 = std::max(source_x0, tile_origin_x);
+            const size_t y0 = std::max(source_y0, tile_origin_y);
+            const size_t x1 = std::min(source_x1, tile_origin_x + source_tile.get_width());
+            const size_t y1 = std::min(source_y1, tile_origin_y + source_tile.get_height());
+
+            for (size_t y = y0; y < y1; ++y)
+            {
+                const size_t dy = std::min(y / 2, level_props.m_canvas_height - 1) - origin_y;
+
+                for (size_t x = x0; x < x1; ++x)
+                {
+                    const size_t dx = std::min(x / 2, level_props.m_canvas_width - 1) - origin_x;
+                    const size_t index = dy * width + dx;
+
+                    float* sum = &sums[index * channel_count];
+                    for (size_t c = 0; c < channel_count; ++c)
+                        sum[c] += source_tile.get_component<float>(x - tile_origin_x, y - tile_origin_y, c);
+
+                    weights[index] += 1.0f;
+                }
+            }
+        }
+    }
+
+    // Normalize the accumulated values.
+    Tile* tile = new Tile(width, height, channel_count, level_props.m_pixel_format);
+
+    for (size_t i = 0, e = width * height; i < e; ++i)
+    {
+        assert(weights[i] > 0.0f);
+        const float rcp_weight = 1.0f / weights[i];
+
+        for (size_t c = 0; c < channel_count; ++c)
+            tile->set_component(i, c, sums[i * channel_count + c] * rcp_weight);
+    }
+
+    return tile;
+}
+
+template <typename TileAccessor>
+std::unique_ptr<Image> generate_mip_level(
+    TileAccessor&               source,
+    const CanvasProperties&     source_props,
+    const CanvasProperties&     level_props)
+{
+    std::unique_ptr<Image> image(new Image(level_props));
+
+    for (size_t ty = 0; ty < level_props.m_tile_count_y; ++ty)
+    {
+        for (size_t tx = 0; tx < level_props.m_tile_count_x; ++tx)
+        {
+            image->set_tile(
+                tx, ty,
+                generate_mip_level_tile(source, source_props, level_props, tx, ty));
+        }
+    }
+
+    return image;
+}
+
+}   // namespace foundation
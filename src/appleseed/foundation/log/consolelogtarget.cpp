@@ -77,6 +77,12 @@ namespace
             reset_text_color();
         }
 
+        // Flush messages written so far.
+        void flush() override
+        {
+            fflush(m_file);
+        }
+
       private:
         FILE* m_file;
 
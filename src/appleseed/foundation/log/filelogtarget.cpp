@@ -72,6 +72,12 @@ void FileLogTarget::write(
     }
 }
 
+void FileLogTarget::flush()
+{
+    if (m_file != nullptr)
+        fflush(m_file);
+}
+
 bool FileLogTarget::open(const char* filename)
 {
     assert(filename);
@@ -69,6 +69,9 @@ class APPLESEED_DLLSYMBOL FileLogTarget
         const char*                 header,
         const char*                 message) override;
 
+    // Flush messages written so far.
+    void flush() override;
+
     bool open(const char* filename);
 
     void close();
@@ -57,6 +57,10 @@ class APPLESEED_DLLSYMBOL ILogTarget
         const size_t                line,
         const char*                 header,
         const char*                 message) = 0;
+
+    // Flush messages written so far. Called after each batch of messages
+    // written by an asynchronous logger. The default implementation does nothing.
+    virtual void flush() {}
 };
 
 }   // namespace foundation
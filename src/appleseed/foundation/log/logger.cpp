@@ -32,6 +32,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/log/ilogtarget.h"
+#include "foundation/platform/atomic.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/snprintf.h"
 #include "foundation/platform/system.h"
@@ -41,6 +42,10 @@
 
 // Boost headers.
 #include "boost/date_time/posix_time/posix_time.hpp"
+#include "boost/lockfree/queue.hpp"
+#include "boost/thread/condition_variable.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
 
 // Standard headers.
 #include <algorithm>
@@ -50,6 +55,8 @@
 #include <cstdlib>
 #include <list>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 using namespace boost::posix_time;
@@ -71,12 +78,13 @@ namespace
             const LogMessage::Category  category,
             const ptime&                datetime,
             const size_t                thread,
+            const std::uint64_t         process_size,
             const std::string&          message)
           : m_category(LogMessage::get_category_name(category))
           , m_padded_category(LogMessage::get_padded_category_name(category))
           , m_datetime(to_iso_extended_string(datetime) + 'Z')
           , m_thread(pad_left(to_string(thread), '0', 3))
-          , m_process_size(pad_left(to_string(System::get_process_virtual_memory_size() / (1024 * 1024)) + " MB", ' ', 8))
+          , m_process_size(pad_left(to_string(process_size / (1024 * 1024)) + " MB", ' ', 8))
           , m_message(message)
         {
         }
@@ -202,35 +210,292 @@ namespace
 // Logger class implementation.
 //
 
+namespace
+{
+    const size_t InitialBufferSize = 1024;      // in bytes
+    const size_t MaxBufferSize = 1024 * 1024;   // in bytes
+
+    const size_t MaxQueuedMessageCount = 16 * 1024;
+    const size_t FlushIntervalMs = 5;
+
+    struct QueuedMessage
+    {
+        LogMessage::Category    m_category;
+        const char*             m_file;
+        size_t                  m_line;
+        ptime                   m_datetime;
+        boost::thread::id       m_thread_id;
+        std::string             m_message;
+
+        size_t get_size() const
+        {
+            return sizeof(QueuedMessage) + m_message.size();
+        }
+    };
+}
+
 struct Logger::Impl
 {
     typedef std::list<ILogTarget*> LogTargetContainer;
 
-    boost::mutex            m_mutex;
-    bool                    m_enabled;
-    LogMessage::Category    m_verbosity_level;
-    LogTargetContainer      m_targets;
-    std::vector<char>       m_message_buffer;
-    ThreadMap               m_thread_map;
-    Formatter               m_formatter;
+    typedef boost::lockfree::queue<
+        QueuedMessage*,
+        boost::lockfree::fixed_sized<true>
+    > MessageQueue;
+
+    boost::mutex                    m_mutex;
+    boost::atomic<bool>             m_enabled;
+    boost::atomic<int>              m_verbosity_level;
+    LogTargetContainer              m_targets;
+    std::vector<char>               m_message_buffer;
+    ThreadMap                       m_thread_map;
+    Formatter                       m_formatter;
+
+    // Asynchronous mode.
+    boost::atomic<bool>             m_asynchronous;
+    boost::atomic<size_t>           m_max_queued_size;
+    boost::atomic<size_t>           m_queued_size;
+    boost::atomic<std::uint64_t>    m_dropped_message_count;
+    std::uint64_t                   m_reported_dropped_message_count;
+    std::unique_ptr<MessageQueue>   m_queue;
+    std::unique_ptr<boost::thread>  m_flusher_thread;
+    boost::mutex                    m_flusher_mutex;
+    boost::condition_variable       m_flusher_wakeup;
+    bool                            m_stop_flusher;
+    boost::mutex                    m_batch_mutex;      // serializes batches to preserve message order
+
+    Impl()
+      : m_enabled(true)
+      , m_verbosity_level(LogMessage::Info)
+      , m_asynchronous(false)
+      , m_max_queued_size(DefaultMaxQueuedSize)
+      , m_queued_size(0)
+      , m_dropped_message_count(0)
+      , m_reported_dropped_message_count(0)
+      , m_stop_flusher(false)
+    {
+    }
+
+    // Format the header and message and send them to all log targets.
+    // The caller must hold m_mutex.
+    void write_to_targets(
+        const LogMessage::Category  category,
+        const char*                 file,
+        const size_t                line,
+        const ptime&                datetime,
+        const boost::thread::id     thread_id,
+        const std::uint64_t         process_size,
+        const char*                 message_body);
+
+    // Start the background thread that writes queued messages, if it's not already running.
+    void start_flusher();
+
+    // Stop the background thread after it has written all queued messages.
+    void stop_flusher();
+
+    // Body of the background thread.
+    void run_flusher();
+
+    // Write all queued messages to log targets.
+    void write_queued_messages();
+
+    // Try to queue a message. Return false if the queue is full.
+    bool queue_message(QueuedMessage* message);
 };
 
-namespace
+void Logger::Impl::write_to_targets(
+    const LogMessage::Category  category,
+    const char*                 file,
+    const size_t                line,
+    const ptime&                datetime,
+    const boost::thread::id     thread_id,
+    const std::uint64_t         process_size,
+    const char*                 message_body)
 {
-    const size_t InitialBufferSize = 1024;      // in bytes
-    const size_t MaxBufferSize = 1024 * 1024;   // in bytes
+    // Format the header and message.
+    const size_t thread = m_thread_map.thread_id_to_int(thread_id);
+    const FormatEvaluator format_evaluator(category, datetime, thread, process_size, message_body);
+    const std::string header = format_evaluator.evaluate(m_formatter.get_header_format(category));
+    std::string message = format_evaluator.evaluate(m_formatter.get_message_format(category));
+
+    // Remove trailing newline characters from the message.
+    message = trim_right(message, "\n");
+
+    if (!message.empty())
+    {
+        // Send the header and message to all log targets.
+        for (const_each<LogTargetContainer> i = m_targets; i; ++i)
+        {
+            ILogTarget* target = *i;
+            target->write(
+                category,
+                file,
+                line,
+                header.c_str(),
+                message.c_str());
+        }
+    }
+}
+
+void Logger::Impl::start_flusher()
+{
+    boost::mutex::scoped_lock lock(m_flusher_mutex);
+
+    if (m_flusher_thread)
+        return;
+
+    if (!m_queue)
+    {
+        boost::mutex::scoped_lock batch_lock(m_batch_mutex);
+        m_queue.reset(new MessageQueue(MaxQueuedMessageCount));
+    }
+
+    m_stop_flusher = false;
+    m_flusher_thread.reset(new boost::thread(&Impl::run_flusher, this));
+}
+
+void Logger::Impl::stop_flusher()
+{
+    {
+        boost::mutex::scoped_lock lock(m_flusher_mutex);
+
+        if (!m_flusher_thread)
+            return;
+
+        m_stop_flusher = true;
+        m_flusher_wakeup.notify_one();
+    }
+
+    m_flusher_thread->join();
+    m_flusher_thread.reset();
+
+    // Write messages that may have been queued after the background thread exited.
+    write_queued_messages();
+}
+
+void Logger::Impl::run_flusher()
+{
+    while (true)
+    {
+        bool stop;
+
+        {
+            boost::mutex::scoped_lock lock(m_flusher_mutex);
+
+            if (!m_stop_flusher)
+                m_flusher_wakeup.timed_wait(lock, boost::posix_time::milliseconds(FlushIntervalMs));
+
+            stop = m_stop_flusher;
+        }
+
+        write_queued_messages();
+
+        if (stop)
+            break;
+    }
+}
+
+void Logger::Impl::write_queued_messages()
+{
+    boost::mutex::scoped_lock batch_lock(m_batch_mutex);
+
+    if (!m_queue)
+        return;
+
+    // Collect a batch of messages.
+    std::vector<QueuedMessage*> batch;
+    QueuedMessage* message;
+    while (m_queue->pop(message))
+    {
+        m_queued_size -= message->get_size();
+        batch.push_back(message);
+    }
+
+    const std::uint64_t dropped_message_count = m_dropped_message_count;
+
+    if (!batch.empty() || dropped_message_count != m_reported_dropped_message_count)
+    {
+        // Write the whole batch while holding the lock only once.
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        if (m_enabled)
+        {
+            // Query the process size once per batch.
+            const std::uint64_t process_size = System::get_process_virtual_memory_size();
+
+            for (const QueuedMessage* m : batch)
+            {
+                write_to_targets(
+                    m->m_category,
+                    m->m_file,
+                    m->m_line,
+                    m->m_datetime,
+                    m->m_thread_id,
+                    process_size,
+                    m->m_message.c_str());
+            }
+
+            if (dropped_message_count != m_reported_dropped_message_count)
+            {
+                const std::string message_body =
+                    "the log queue was full, " +
+                    to_string(dropped_message_count - m_reported_dropped_message_count) +
+                    " message(s) were dropped.";
+
+                write_to_targets(
+                    LogMessage::Warning,
+                    __FILE__,
+                    __LINE__,
+                    microsec_clock::universal_time(),
+                    boost::this_thread::get_id(),
+                    process_size,
+                    message_body.c_str());
+            }
+
+            for (const_each<LogTargetContainer> i = m_targets; i; ++i)
+                (*i)->flush();
+        }
+
+        m_reported_dropped_message_count = dropped_message_count;
+    }
+
+    for (QueuedMessage* m : batch)
+        delete m;
+}
+
+bool Logger::Impl::queue_message(QueuedMessage* message)
+{
+    // Reserve space for the message within the memory budget.
+    const size_t message_size = message->get_size();
+    if (m_queued_size.fetch_add(message_size) + message_size > m_max_queued_size)
+    {
+        m_queued_size -= message_size;
+        return false;
+    }
+
+    if (!m_queue->push(message))
+    {
+        m_queued_size -= message_size;
+        return false;
+    }
+
+    return true;
 }
 
 Logger::Logger()
   : impl(new Impl())
 {
-    impl->m_enabled = true;
-    impl->m_verbosity_level = LogMessage::Info;
     impl->m_message_buffer.resize(InitialBufferSize);
 }
 
 Logger::~Logger()
 {
+    impl->stop_flusher();
+
+    // Messages may have been queued while no background thread was running,
+    // for instance by a thread racing with set_asynchronous(false).
+    impl->write_queued_messages();
+
     delete impl;
 }
 
@@ -239,8 +504,8 @@ void Logger::initialize_from(const Logger& source)
     boost::mutex::scoped_lock source_lock(source.impl->m_mutex);
     boost::mutex::scoped_lock this_lock(impl->m_mutex);
 
-    impl->m_enabled = source.impl->m_enabled;
-    impl->m_verbosity_level = source.impl->m_verbosity_level;
+    impl->m_enabled = source.impl->m_enabled.load();
+    impl->m_verbosity_level = source.impl->m_verbosity_level.load();
 
     impl->m_targets.clear();
     for (const_each<Impl::LogTargetContainer> i = source.impl->m_targets; i; ++i)
@@ -253,6 +518,40 @@ void Logger::initialize_from(const Logger& source)
     }
 }
 
+void Logger::set_asynchronous(const bool asynchronous)
+{
+    if (asynchronous)
+    {
+        impl->start_flusher();
+        impl->m_asynchronous = true;
+    }
+    else
+    {
+        impl->m_asynchronous = false;
+        impl->stop_flusher();
+    }
+}
+
+bool Logger::is_asynchronous() const
+{
+    return impl->m_asynchronous;
+}
+
+void Logger::set_max_queued_size(const size_t size)
+{
+    impl->m_max_queued_size = size;
+}
+
+void Logger::flush()
+{
+    impl->write_queued_messages();
+}
+
+std::uint64_t Logger::get_dropped_message_count() const
+{
+    return impl->m_dropped_message_count;
+}
+
 void Logger::set_enabled(const bool enabled)
 {
     boost::mutex::scoped_lock lock(impl->m_mutex);
@@ -268,7 +567,7 @@ void Logger::set_verbosity_level(const LogMessage::Category level)
 LogMessage::Category Logger::get_verbosity_level() const
 {
     boost::mutex::scoped_lock lock(impl->m_mutex);
-    return impl->m_verbosity_level;
+    return static_cast<LogMessage::Category>(impl->m_verbosity_level.load());
 }
 
 void Logger::reset_all_formats()
@@ -364,6 +663,64 @@ void Logger::write(
     const size_t                        line,
     APPLESEED_PRINTF_FMT const char*    format, ...)
 {
+    if (impl->m_asynchronous && category != LogMessage::Fatal)
+    {
+        if (category < impl->m_verbosity_level || !impl->m_enabled)
+            return;
+
+        // Format the message body on the calling thread.
+        std::vector<char> buffer(InitialBufferSize);
+        va_list argptr;
+        va_start(argptr, format);
+        const bool formatting_succeeded =
+            write_to_buffer(buffer, MaxBufferSize, format, argptr);
+        va_end(argptr);
+
+        std::unique_ptr<QueuedMessage> message(new QueuedMessage());
+        message->m_category = formatting_succeeded ? category : LogMessage::Error;
+        message->m_file = file;
+        message->m_line = line;
+        message->m_datetime = microsec_clock::universal_time();
+        message->m_thread_id = boost::this_thread::get_id();
+        message->m_message = &buffer[0];
+
+        if (impl->queue_message(message.get()))
+        {
+            message.release();
+            return;
+        }
+
+        // The queue is full: drop unimportant messages and write other ones synchronously.
+        if (message->m_category < LogMessage::Warning)
+        {
+            ++impl->m_dropped_message_count;
+            return;
+        }
+
+        // Write the messages queued so far first so that this one doesn't overtake them.
+        impl->write_queued_messages();
+
+        boost::mutex::scoped_lock lock(impl->m_mutex);
+
+        if (impl->m_enabled)
+        {
+            impl->write_to_targets(
+                message->m_category,
+                file,
+                line,
+                message->m_datetime,
+                message->m_thread_id,
+                System::get_process_virtual_memory_size(),
+                message->m_message.c_str());
+        }
+
+        return;
+    }
+
+    // Make sure fatal messages are written after all queued messages.
+    if (category == LogMessage::Fatal)
+        impl->write_queued_messages();
+
     boost::mutex::scoped_lock lock(impl->m_mutex);
 
     if (category < impl->m_verbosity_level)
@@ -378,37 +735,21 @@ void Logger::write(
         va_start(argptr, format);
         const bool formatting_succeeded =
             write_to_buffer(impl->m_message_buffer, MaxBufferSize, format, argptr);
+        va_end(argptr);
 
         // If formatting failed, print the message as an error.
         if (!formatting_succeeded)
             effective_category = LogMessage::Error;
 
-        // Retrieve the current UTC time.
-        const ptime datetime(microsec_clock::universal_time());
-
-        // Format the header and message.
-        const size_t thread = impl->m_thread_map.thread_id_to_int(boost::this_thread::get_id());
-        const FormatEvaluator format_evaluator(effective_category, datetime, thread, &impl->m_message_buffer[0]);
-        const std::string header = format_evaluator.evaluate(impl->m_formatter.get_header_format(effective_category));
-        std::string message = format_evaluator.evaluate(impl->m_formatter.get_message_format(effective_category));
-
-        // Remove trailing newline characters from the message.
-        message = trim_right(message, "\n");
-
-        if (!message.empty())
-        {
-            // Send the header and message to all log targets.
-            for (const_each<Impl::LogTargetContainer> i = impl->m_targets; i; ++i)
-            {
-                ILogTarget* target = *i;
-                target->write(
-                    effective_category,
-                    file,
-                    line,
-                    header.c_str(),
-                    message.c_str());
-            }
-        }
+        // Format the header and message and send them to all log targets.
+        impl->write_to_targets(
+            effective_category,
+            file,
+            line,
+            microsec_clock::universal_time(),
+            boost::this_thread::get_id(),
+            System::get_process_virtual_memory_size(),
+            &impl->m_message_buffer[0]);
     }
 
     // Terminate the application if the message category is 'Fatal'.
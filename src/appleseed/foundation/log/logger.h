@@ -39,6 +39,7 @@
 
 // Standard headers.
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 // Forward declarations.
@@ -52,6 +53,13 @@ namespace foundation
 //
 // All methods of this class are thread-safe.
 //
+// By default, messages are formatted and written to all log targets by the thread calling
+// write(). In asynchronous mode, the calling thread only formats the message body and pushes
+// it to a bounded lock-free queue; a background thread then writes queued messages to log
+// targets in batches. When the queue is full, debug and info messages are dropped, while
+// more important messages are written synchronously. Fatal messages are always written
+// synchronously, after all queued messages.
+//
 
 class APPLESEED_DLLSYMBOL Logger
   : public NonCopyable
@@ -72,6 +80,20 @@ class APPLESEED_DLLSYMBOL Logger
     // Enable/disable logging.
     void set_enabled(const bool enabled = true);
 
+    // Enable/disable asynchronous logging. Disabling asynchronous logging flushes the queue.
+    void set_asynchronous(const bool asynchronous = true);
+    bool is_asynchronous() const;
+
+    // Set the maximum amount of memory, in bytes, used by queued messages in asynchronous mode.
+    static const size_t DefaultMaxQueuedSize = 16 * 1024 * 1024;
+    void set_max_queued_size(const size_t size);
+
+    // Wait until all messages queued so far have been written to log targets.
+    void flush();
+
+    // Return the number of messages dropped in asynchronous mode since this logger was created.
+    std::uint64_t get_dropped_message_count() const;
+
     // Set/get the verbosity level.
     void set_verbosity_level(const LogMessage::Category level);
     LogMessage::Category get_verbosity_level() const;
@@ -74,6 +74,12 @@ namespace
             write_message(m_file, category, header, message);
         }
 
+        // Flush messages written so far.
+        void flush() override
+        {
+            fflush(m_file);
+        }
+
       private:
         FILE* m_file;
     };
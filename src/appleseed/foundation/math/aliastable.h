@@ -0,0 +1,298 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/math/scalar.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// Alias table for sampling discrete distributions in constant time.
+//
+// AliasTable has the same interface as CDF and can be used in its place: sample()
+// costs two memory accesses regardless of the number of items, instead of a binary
+// search. Unlike with a CDF, neighboring values of the sample may select unrelated
+// items, and the sample cannot be reused as is after selection: the second variant of
+// sample() returns a remapped value that can.
+//
+// The table is built using Vose's algorithm.
+//
+// References:
+//
+//   https://en.wikipedia.org/wiki/Alias_method
+//   http://www.keithschwarz.com/darts-dice-coins/
+//
+
+template <typename Item, typename Weight>
+class AliasTable
+{
+  public:
+    typedef std::pair<Item, Weight> ItemWeightPair;
+
+    // Constructor.
+    AliasTable();
+
+    // Return the number of items in the table.
+    size_t size() const;
+
+    // Return true if the table is empty.
+    bool empty() const;
+
+    // Return true if the table has at least one item with a positive weight.
+    bool valid() const;
+
+    // Return the sum of the weight of all inserted items.
+    Weight weight() const;
+
+    // Remove all items from the table.
+    void clear();
+
+    // Allocate memory for a given number of items.
+    void reserve(const size_t count);
+
+    // Insert an item with a given non-negative weight.
+    void insert(const Item& item, const Weight weight);
+
+    // Access the i'th item.
+    const ItemWeightPair& operator[](const size_t i) const;
+
+    // Prepare the table for sampling.
+    // This method must be called once and only once before sample() is called.
+    void prepare();
+
+    // Sample the table. x is in [0,1).
+    const ItemWeightPair& sample(const Weight x) const;
+
+    // Sample the table. x is in [0,1). Also return a value y in [0,1) that is
+    // uniformly distributed and independent of the returned item.
+    const ItemWeightPair& sample(const Weight x, Weight& y) const;
+
+  private:
+    struct Entry
+    {
+        Weight          m_threshold;    // probability of keeping the item of this entry
+        std::uint32_t   m_alias;        // index of the item to use otherwise
+    };
+
+    typedef std::vector<ItemWeightPair> ItemVector;
+    typedef std::vector<Entry> EntryVector;
+
+    ItemVector          m_items;
+    Weight              m_weight_sum;
+    EntryVector         m_entries;
+};
+
+
+//
+// AliasTable class implementation.
+//
+
+template <typename Item, typename Weight>
+inline AliasTable<Item, Weight>::AliasTable()
+  : m_weight_sum(0.0)
+{
+}
+
+template <typename Item, typename Weight>
+inline size_t AliasTable<Item, Weight>::size() const
+{
+    return m_items.size();
+}
+
+template <typename Item, typename Weight>
+inline bool AliasTable<Item, Weight>::empty() const
+{
+    return m_items.empty();
+}
+
+template <typename Item, typename Weight>
+inline bool AliasTable<Item, Weight>::valid() const
+{
+    return m_weight_sum > Weight(0.0);
+}
+
+template <typename Item, typename Weight>
+inline Weight AliasTable<Item, Weight>::weight() const
+{
+    return m_weight_sum;
+}
+
+template <typename Item, typename Weight>
+inline void AliasTable<Item, Weight>::clear()
+{
+    m_items.clear();
+    m_weight_sum = Weight(0.0);
+    m_entries.clear();
+}
+
+template <typename Item, typename Weight>
+inline void AliasTable<Item, Weight>::reserve(const size_t count)
+{
+    m_items.reserve(count);
+}
+
+template <typename Item, typename Weight>
+inline void AliasTable<Item, Weight>::insert(const Item& item, const Weight weight)
+{
+    assert(weight >= Weight(0.0));
+    m_items.push_back(std::make_pair(item, weight));
+    m_weight_sum += weight;
+}
+
+template <typename Item, typename Weight>
+inline const typename AliasTable<Item, Weight>::ItemWeightPair& AliasTable<Item, Weight>::operator[](const size_t i) const
+{
+    assert(i < m_items.size());
+    return m_items[i];
+}
+
+template <typename Item, typename Weight>
+void AliasTable<Item, Weight>::prepare()
+{
+    assert(valid());
+    assert(m_entries.empty());
+
+    const size_t item_count = m_items.size();
+    assert(item_count <= 0xFFFFFFFFu);
+
+    // Normalize weights so that they add up to 1.0.
+    const Weight rcp_weight_sum = Weight(1.0) / m_weight_sum;
+    for (size_t i = 0; i < item_count; ++i)
+        m_items[i].second *= rcp_weight_sum;
+
+    // Scale probabilities so that they average to 1.0 and split items into
+    // those below the average and those above it.
+    std::vector<double> scaled(item_count);
+    std::vector<std::uint32_t> small, large;
+    small.reserve(item_count);
+    large.reserve(item_count);
+
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        scaled[i] = static_cast<double>(m_items[i].second) * item_count;
+
+        if (scaled[i] < 1.0)
+            small.push_back(static_cast<std::uint32_t>(i));
+        else large.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    m_entries.resize(item_count);
+
+    // Fill the entry of each small item with the excess probability of a large item.
+    while (!small.empty() && !large.empty())
+    {
+        const std::uint32_t s = small.back();
+        const std::uint32_t l = large.back();
+        small.pop_back();
+
+        m_entries[s].m_threshold = static_cast<Weight>(scaled[s]);
+        m_entries[s].m_alias = l;
+
+        scaled[l] -= 1.0 - scaled[s];
+
+        if (scaled[l] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Remaining items have a probability of 1.0 up to numerical errors. Items with
+    // a null probability must never be returned: alias them to a nonzero item.
+    std::uint32_t nonzero_item = 0;
+    while (!(m_items[nonzero_item].second > Weight(0.0)))
+        ++nonzero_item;
+
+    for (const std::vector<std::uint32_t>* remaining : { &large, &small })
+    {
+        for (const std::uint32_t i : *remaining)
+        {
+            const bool nonzero = m_items[i].second > Weight(0.0);
+            m_entries[i].m_threshold = nonzero ? Weight(1.0) : Weight(0.0);
+            m_entries[i].m_alias = nonzero ? i : nonzero_item;
+        }
+    }
+}
+
+template <typename Item, typename Weight>
+inline const std::pair<Item, Weight>& AliasTable<Item, Weight>::sample(const Weight x) const
+{
+    assert(valid());
+    assert(!m_entries.empty());
+    assert(x >= Weight(0.0));
+    assert(x < Weight(1.0));
+
+    const size_t item_count = m_entries.size();
+    const Weight u = x * item_count;
+    const size_t i = std::min(truncate<size_t>(u), item_count - 1);
+    const Entry& entry = m_entries[i];
+
+    return m_items[u - i < entry.m_threshold ? i : entry.m_alias];
+}
+
+template <typename Item, typename Weight>
+inline const std::pair<Item, Weight>& AliasTable<Item, Weight>::sample(const Weight x, Weight& y) const
+{
+    assert(valid());
+    assert(!m_entries.empty());
+    assert(x >= Weight(0.0));
+    assert(x < Weight(1.0));
+
+    // Largest value strictly smaller than 1.
+    static const Weight OneMinusEps = std::nextafter(Weight(1.0), Weight(0.0));
+
+    const size_t item_count = m_entries.size();
+    const Weight u = x * item_count;
+    const size_t i = std::min(truncate<size_t>(u), item_count - 1);
+    const Entry& entry = m_entries[i];
+
+    // Remap the fractional part of u from the subinterval that selected the item to [0,1).
+    const Weight f = u - i;
+    const bool keep = f < entry.m_threshold;
+    y = keep
+        ? f / entry.m_threshold
+        : (f - entry.m_threshold) / (Weight(1.0) - entry.m_threshold);
+    y = std::min(std::max(y, Weight(0.0)), OneMinusEps);
+
+    return m_items[keep ? i : entry.m_alias];
+}
+
+}   // namespace foundation
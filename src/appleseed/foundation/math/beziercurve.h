@@ -37,6 +37,10 @@
 #include "foundation/math/ray.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 
 // Standard headers.
 #include <algorithm>
@@ -44,6 +48,7 @@
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <type_traits>
 
 namespace foundation
 {
@@ -301,6 +306,50 @@ class BezierCurveIntersector
 };
 
 
+//
+// A packet of up to four Bezier curves of the same degree, stored in structure-of-arrays
+// layout, allowing to cull four curves against a ray at once before running the exact
+// (scalar) intersection test on the surviving curves.
+//
+// The culling test is the one performed by BezierCurveIntersector at the root of its
+// recursion: a curve is rejected if the bounding box of its control points in ray space
+// doesn't overlap the square of half-size (max width / 2) centered on the ray, within
+// the ray's extent.
+//
+
+template <typename BezierCurveType>
+class BezierCurvePacket
+{
+  public:
+    typedef typename BezierCurveType::ValueType ValueType;
+    typedef typename BezierCurveType::MatrixType MatrixType;
+
+    // Maximum number of curves in a packet.
+    static const size_t Size = 4;
+
+    // Number of control points of each curve.
+    static const size_t ControlPointCount = BezierCurveType::Degree + 1;
+
+    // Constructor, creates an empty packet.
+    BezierCurvePacket();
+
+    // Store a curve in a given slot of the packet.
+    void set(const size_t index, const BezierCurveType& curve);
+
+    // Return a bitmask whose bit i is set if the curve in slot i may intersect the ray.
+    // `xfm` is a ray projection transform (see make_curve_projection_transform()) and
+    // `tmax` is the maximum distance along the ray, scaled by the norm of its direction.
+    size_t cull(const MatrixType& xfm, const ValueType tmax) const;
+
+  private:
+    APPLESEED_SIMD4_ALIGN ValueType m_x[ControlPointCount][Size];
+    APPLESEED_SIMD4_ALIGN ValueType m_y[ControlPointCount][Size];
+    APPLESEED_SIMD4_ALIGN ValueType m_z[ControlPointCount][Size];
+    APPLESEED_SIMD4_ALIGN ValueType m_half_max_width[Size];
+    size_t                          m_mask;
+};
+
+
 //
 // BezierCurveBase class implementation.
 //
@@ -1214,4 +1263,135 @@ bool BezierCurveIntersector<BezierCurveType>::converge(
     }
 }
 
+
+//
+// BezierCurvePacket class implementation.
+//
+
+template <typename BezierCurveType>
+BezierCurvePacket<BezierCurveType>::BezierCurvePacket()
+  : m_mask(0)
+{
+    for (size_t i = 0; i < ControlPointCount; ++i)
+    {
+        for (size_t j = 0; j < Size; ++j)
+        {
+            m_x[i][j] = ValueType(0.0);
+            m_y[i][j] = ValueType(0.0);
+            m_z[i][j] = ValueType(0.0);
+        }
+    }
+
+    for (size_t j = 0; j < Size; ++j)
+        m_half_max_width[j] = ValueType(0.0);
+}
+
+template <typename BezierCurveType>
+void BezierCurvePacket<BezierCurveType>::set(
+    const size_t            index,
+    const BezierCurveType&  curve)
+{
+    assert(index < Size);
+
+    for (size_t i = 0; i < ControlPointCount; ++i)
+    {
+        const typename BezierCurveType::VectorType& cp = curve.get_control_point(i);
+        m_x[i][index] = cp.x;
+        m_y[i][index] = cp.y;
+        m_z[i][index] = cp.z;
+    }
+
+    m_half_max_width[index] = ValueType(0.5) * curve.compute_max_width();
+    m_mask |= size_t(1) << index;
+}
+
+template <typename BezierCurveType>
+size_t BezierCurvePacket<BezierCurveType>::cull(
+    const MatrixType&       xfm,
+    const ValueType         tmax) const
+{
+    // Ray projection transforms are affine: the fourth row is (0, 0, 0, 1).
+    assert(xfm[12] == ValueType(0.0));
+    assert(xfm[13] == ValueType(0.0));
+    assert(xfm[14] == ValueType(0.0));
+    assert(xfm[15] == ValueType(1.0));
+
+#ifdef APPLESEED_USE_SSE
+
+    if constexpr (std::is_same<ValueType, float>::value)
+    {
+        const __m128 m0 = _mm_set1_ps(xfm[0]), m1 = _mm_set1_ps(xfm[1]), m2 = _mm_set1_ps(xfm[2]), m3 = _mm_set1_ps(xfm[3]);
+        const __m128 m4 = _mm_set1_ps(xfm[4]), m5 = _mm_set1_ps(xfm[5]), m6 = _mm_set1_ps(xfm[6]), m7 = _mm_set1_ps(xfm[7]);
+        const __m128 m8 = _mm_set1_ps(xfm[8]), m9 = _mm_set1_ps(xfm[9]), m10 = _mm_set1_ps(xfm[10]), m11 = _mm_set1_ps(xfm[11]);
+
+        const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128 min_x = inf, min_y = inf, min_z = inf;
+        __m128 max_x = _mm_sub_ps(_mm_setzero_ps(), inf), max_y = max_x, max_z = max_x;
+
+        for (size_t i = 0; i < ControlPointCount; ++i)
+        {
+            const __m128 x = _mm_load_ps(m_x[i]);
+            const __m128 y = _mm_load_ps(m_y[i]);
+            const __m128 z = _mm_load_ps(m_z[i]);
+
+            // Same order of operations as foundation::Matrix * foundation::Vector.
+            const __m128 px = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_mul_ps(m2, z)), m3);
+            const __m128 py = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m4, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m6, z)), m7);
+            const __m128 pz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m8, x), _mm_mul_ps(m9, y)), _mm_mul_ps(m10, z)), m11);
+
+            min_x = _mm_min_ps(min_x, px); max_x = _mm_max_ps(max_x, px);
+            min_y = _mm_min_ps(min_y, py); max_y = _mm_max_ps(max_y, py);
+            min_z = _mm_min_ps(min_z, pz); max_z = _mm_max_ps(max_z, pz);
+        }
+
+        const __m128 hw = _mm_load_ps(m_half_max_width);
+        const __m128 neg_hw = _mm_sub_ps(_mm_setzero_ps(), hw);
+
+        __m128 overlap = _mm_cmple_ps(min_z, _mm_set1_ps(tmax));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(max_z, _mm_set1_ps(1.0e-6f)));
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(min_x, hw));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(max_x, neg_hw));
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(min_y, hw));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(max_y, neg_hw));
+
+        return static_cast<size_t>(_mm_movemask_ps(overlap)) & m_mask;
+    }
+    else
+
+#endif  // APPLESEED_USE_SSE
+
+    {
+        size_t mask = 0;
+
+        for (size_t j = 0; j < Size; ++j)
+        {
+            ValueType min_x = std::numeric_limits<ValueType>::max(), max_x = -min_x;
+            ValueType min_y = min_x, max_y = max_x;
+            ValueType min_z = min_x, max_z = max_x;
+
+            for (size_t i = 0; i < ControlPointCount; ++i)
+            {
+                const ValueType x = m_x[i][j], y = m_y[i][j], z = m_z[i][j];
+
+                const ValueType px = xfm[0] * x + xfm[1] * y + xfm[ 2] * z + xfm[ 3];
+                const ValueType py = xfm[4] * x + xfm[5] * y + xfm[ 6] * z + xfm[ 7];
+                const ValueType pz = xfm[8] * x + xfm[9] * y + xfm[10] * z + xfm[11];
+
+                min_x = std::min(min_x, px); max_x = std::max(max_x, px);
+                min_y = std::min(min_y, py); max_y = std::max(max_y, py);
+                min_z = std::min(min_z, pz); max_z = std::max(max_z, pz);
+            }
+
+            const ValueType hw = m_half_max_width[j];
+
+            if (min_z <= tmax && max_z >= ValueType(1.0e-6) &&
+                min_x <= hw   && max_x >= -hw &&
+                min_y <= hw   && max_y >= -hw)
+                mask |= size_t(1) << j;
+        }
+
+        return mask & m_mask;
+    }
+}
+
 }   // namespace foundation
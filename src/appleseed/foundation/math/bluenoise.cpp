@@ -0,0 +1,300 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "bluenoise.h"
+
+namespace foundation
+{
+
+//
+// 64x64 blue noise mask (Gaussian energy filter with sigma = 1.9,
+// 10% initial binary pattern).
+//
+
+const std::uint16_t BlueNoiseMask[BlueNoiseMaskSize * BlueNoiseMaskSize] =
+{
+    3070, 2169,  787, 3943, 1089,  116,  629, 4077, 3346, 2014, 3868, 1066, 2192,  408, 1969, 2512,
+    3832, 1423,  491, 3098, 1585,  700, 3238,  193, 2412, 4051, 3025, 1931,  865, 1328, 3995, 1545,
+     601, 2533,  839, 3732,  347,  976, 3978,   94,  539, 3829, 3068, 1485, 2101, 1059, 2264, 1591,
+    3018, 1888, 3986, 2622, 3605, 1710, 2505,  445, 1845, 1276, 2163, 3490, 1666, 2024, 2499, 4017,
+    1752, 1393, 3671, 2327, 1587, 3076, 1411, 2225,  358, 2906,  235, 3114,  746, 4022, 1186, 3532,
+    2252,  217, 3375, 2072, 3739, 1053, 1869, 3807, 1236,  632, 1516, 2616, 3521, 2115,  162, 2991,
+    1128, 3849, 2126, 1738, 3091, 2215, 1201, 2574, 2934, 2312, 1840, 3597,  353, 3211, 4049,  854,
+    3416,  512,  779, 2315, 1366,   71, 3334, 3865, 2843,  311,  752, 2961, 3893,  867, 3287, 2820,
+     992,    9, 2602, 3201,  315, 3495, 2726, 1883, 1162, 2440, 1532, 3444, 1359, 2976,   60, 1625,
+     618, 2919, 1259,  847, 2335, 2634,  523, 2776, 2043, 3271,   93, 3716, 1706,  697, 2350, 3433,
+    1911, 3220, 1430,  507, 2447,  703, 3306, 1571, 3461,  829,  165, 2507,  717, 2836, 1952,  292,
+    1284, 3818, 2878,  319, 2988, 2119,  908, 1517, 1068, 3649, 2342,   67, 1145, 1480, 2284,  662,
+    3835, 2042, 1195,  587, 1776,  911, 3828,  762, 3223, 3704,  577, 2589, 1864, 2313, 2711, 3756,
+    1027, 2573, 1823, 3516,  107, 3011, 1452, 3563,  921, 2303, 2889, 1095,  330, 3823, 2747,  905,
+     410, 2649,  191, 3519, 3930, 1831, 2779,  313, 2082, 4014, 1682, 1168, 3780, 1412, 2386, 3107,
+    2663, 1647, 2048, 1143, 3702,  685, 3166, 2689, 1994, 3227, 1721, 2562, 3364, 1897,  430, 3575,
+    1605, 3384, 2848, 4029, 2134, 2496, 2954,   63, 1678,  993, 2086,  167, 3932,  903,  474, 3272,
+    1998, 3086, 4009,  441, 1671, 3911, 2191,  228, 1756, 3966, 1338, 2537, 3123, 1858, 1215, 1595,
+    4064, 2207, 1041, 2922, 1302,  115, 3797, 1032, 1361,  575, 2682, 3007, 3406,  206, 1761, 1003,
+    3621,   48, 2527, 3382, 1828, 3954, 2394,  508,  231, 3915, 1351,  567, 3698, 2913,  177, 2668,
+    2379,  814,  362, 1504, 3638, 1310,  461, 2325, 3981, 2770, 3589, 1252, 3151, 1743, 3505, 1477,
+     751,  267, 2380, 1362, 3298, 1125,  731, 3150,  404, 3410,  797,  520, 2186, 3356,  139, 2960,
+    3655,  757, 1689, 3345, 2013,  844, 2381, 3101, 3684, 3252, 1890,  937, 2181,  502, 3897,  687,
+    3273, 2253,  589,  930, 1418,  142, 1695, 1253, 3462,  837, 2756, 2065, 1021, 4086, 1321, 3148,
+    1113, 1907, 3031,  185, 3255, 1075, 1971, 3404, 1431,  329, 2261,  728, 2859,  302, 2467, 2175,
+    1205, 3815, 2767,  925, 2062, 2894, 2478, 3800, 2678, 1573, 1983, 3636, 1454, 3925,  615, 2393,
+    1356, 3196, 2504,  583, 2671, 3615, 1620, 2173,  413, 2429,    8, 3576, 1578, 2569, 2804, 2018,
+    1211, 1527, 4076, 2759, 3078, 3531, 2571, 2924, 2235, 1580, 3057,  279, 2456,  761, 2179,  496,
+    3953, 3556, 2544, 2242,  730, 2708, 3773,  633, 3006, 1847, 3349, 1598, 3795, 1092, 3675, 2972,
+      79, 3429, 1732,  594, 3629,  164, 1895, 1272,  995, 2974, 2403,    1, 2849,  968, 2629, 2064,
+     397, 1892,   39, 3963, 1150,  261, 2953,  675, 1490, 1206, 2884,  744, 4042, 1322, 3175,  148,
+    3714, 2915,  440, 1916,  298, 2149, 1083,  614, 4011,   22, 3620, 1832, 3275, 1502, 3449, 1733,
+      51, 1398,  975, 3870, 1796, 1538,  131, 2536, 1174,  897, 2636,   14, 2049, 1407,  606, 1887,
+    2614, 1547, 3119, 2230, 3980, 1497,  525, 3499, 2161,  254, 4054, 1178, 1810, 3210, 1638, 3771,
+    1102, 3558, 2855, 2260, 1408, 3398, 1923, 3993, 2617, 3784, 3329, 1981,  367, 1073, 2352, 1808,
+     816, 3497, 2444, 1271, 3843,  806, 3710, 1975, 3299,  965, 2337, 1170, 3858,  354, 2582, 2811,
+     656, 2106, 3344,  529, 2831, 3482, 3112, 2127, 4020, 3535,  531, 2330, 3941, 2732, 3314,  846,
+    4075, 1058,  369, 2528,  819, 2724, 3229, 1683, 3721,  660, 3326, 2560,  439,  733, 3426,  244,
+    3056,  882, 1540, 3805,  467, 3122,  894, 1739,  210,  988, 2281, 1693, 3028, 3744, 3424,  286,
+    2190, 1024, 1707, 3339, 2641, 1553, 3144,  406, 1770, 1428, 2697,  646, 2902, 2025,  923, 3741,
+    2406, 3000, 1655,  281, 1242, 2348,  813,  407, 1713, 1354, 3198, 2946, 1012, 1667,  423, 2374,
+    3539,  213, 1988, 3396, 1239, 3014,   62, 2372,  886, 1939, 3071, 1384, 2123, 3899, 2301, 1317,
+    2707, 2414, 1814,  696, 2091, 2731, 2460, 3470,  568, 2798, 1364,  113, 2541,  630, 1501, 2698,
+    3937, 3111,   32,  677, 2306,  225, 1163, 2834, 2469, 3766,  463, 3158, 1650,  166, 1288, 3208,
+     222, 1108, 2660, 4070, 3645, 1991, 1048, 3821, 2468,  224, 1955,  739, 3632,  159, 3082, 1307,
+    2137, 2879, 1433, 3788,  471, 1856, 3939, 1123, 2645,  391, 1559, 3580,  932, 2935, 1921,  588,
+    4021,  154, 3500, 3233, 1090,   87, 1312, 3707, 2045, 3195, 3942, 3543, 2117,  928, 2930, 1189,
+     527, 2047, 1414, 4003, 2992, 3656, 2113, 3484,  147,  835, 2155, 3442, 3977, 2291, 3601, 1822,
+    3901, 1947,  794, 3145, 1440,   57, 2938, 3290, 1525, 3706, 2791, 1208, 2196, 1829, 2572, 3831,
+     545, 1749, 3168, 2441,  981, 2205, 1404, 3430, 2874, 3875, 2277,  283, 2680,   81, 1139, 3690,
+    1495, 2140,  389, 2896, 1658, 4082, 2307,  345, 1124, 1581,  796,  455, 1846, 3363, 3845, 1663,
+    2485, 3551, 2793, 1821,  901,  558, 1668, 1360, 4065, 3002, 1906, 1248, 1029, 2653,  750, 1519,
+    2863, 3456,  326, 2224, 2502, 1803,  625, 2694, 2246,  936,  466, 3458, 4035, 1494, 3280,  904,
+    1149, 3654,  735,  125, 2700, 3567,  627,  241, 1789,  773, 1249, 3776, 3387, 1622, 3134, 2511,
+    3305,  848, 1264, 2579, 3625,  777, 3340, 1860, 2989, 2631, 2389, 3066, 1294,  176, 2267,  352,
+     772, 3267,  202, 1228, 2534, 3323, 2751, 1014,  671, 2610, 1568,   72,  370, 3037, 3319,  484,
+    2142, 1223, 3789,  970,  475, 3582, 3992, 1254,  174, 1763, 3125, 2509,  285,  665, 2932,   89,
+    2728, 2290, 1544, 4019, 1949, 2941, 1630, 3234, 2470, 2057, 3170,  569, 1874, 2360,  738,  428,
+    1742, 2982, 3917, 1963,  263, 1471, 2777,  610, 3903,   28, 3647, 1040, 4026, 2586, 3188, 1919,
+    3674, 1055, 2236, 3774, 2017,  396, 3889, 1809, 2208, 3350, 3614, 2428, 3796, 2006, 1396, 2458,
+      41, 1716, 2587, 3262, 1588, 3034, 2080,  778, 3353, 3873, 2010, 1392, 1054, 2361, 2059, 3952,
+    1882, 3464,  308, 3302, 1231,  426, 3734,  907, 4080,   34, 2928,  963, 1368, 4007, 2841, 1062,
+    3610, 2247,  573, 1002, 2422, 3094, 2130,  958, 1386, 2189, 1769,  666, 1562, 2785,  878, 1357,
+    2912, 1600,  497, 3092, 1489,   80, 2339, 3131,  249,  509,  917, 2873, 1751,  609, 4044,  938,
+    3058, 3617,  674, 1347, 2787,  138, 1091, 2391, 1468, 2911,  590, 2721, 3764, 3395, 1601,  446,
+    1339, 3023, 1031, 2588,  768, 2368, 2148, 1475, 1130, 2626, 1687, 3693, 2132,  203, 3437, 1979,
+     106, 2695, 1432, 3397, 3719,  124, 1701, 3557, 3228,  382, 2851, 3453, 2028,  516, 3748,   70,
+    2417, 4095, 2655,  719, 3459, 2825, 1115, 3660, 1291, 3947, 1469, 3224, 2278, 1156, 2727, 3385,
+    1885,  432, 3967, 2326, 1974, 3488, 3838, 2612,  312, 3573,  895,   69, 1731, 3105,  812, 3673,
+    2477,  616, 2114, 1690, 3599, 3083,  150, 2813, 3507,  483, 3376, 2398,  375, 2611, 1524, 1214,
+    3760, 3164,  300, 1854, 1233, 3957,  480, 2546, 1152, 3826, 2328,  247, 1230, 3281, 2164, 1735,
+    3511,  305, 1966, 1280, 3854,  851, 1643, 2501, 1902, 2734, 2098,  714,  349, 3725,  227, 1576,
+    2231, 2900, 1121,  270,  872, 1744,  521, 3152, 1893, 2265, 3936, 1274, 2146, 2581,  192, 1164,
+    3242, 3896,   11, 2786, 3965, 1345, 1835, 3825,  698, 1956, 1260, 3062,  793, 3259, 3888,  623,
+    2432, 1672,  802, 2885, 2287, 2712,  859, 2955, 1899,  718, 1453, 3099, 3969, 2538,  745, 1126,
+    3045,  943, 3342, 1754, 2193, 2983,  433,  647, 3297,   21, 1081, 3544, 2957, 1319, 2532,  818,
+    3775, 1439, 2674, 3320, 3724, 2964, 1323,  725, 1621, 1069, 3258, 2799,  486, 3554, 1853, 2845,
+    2219, 1583,  888, 1935,  533, 1063,  318, 3190, 2283, 1556,  252, 3964, 1023, 1785, 2210, 2999,
+     953, 2093, 4063, 3246,  604, 1523, 2069, 3358,   68, 2443, 3604,  899, 1834,  183, 2876, 3860,
+    1460, 2322,  602,  239, 2596, 3569, 2031, 4045, 3054, 1554, 3785, 2384, 1640, 1980, 3476, 3174,
+      88,  515, 2050, 1563, 2471,    3, 2209, 4032, 3393,  201, 2446, 1537,  711, 4047,  964, 1450,
+     275, 3737, 2996, 3485, 2466, 3357, 2719,  857, 2539, 3643, 2892, 2063, 1385, 2746,  468,   10,
+    3545, 2621,  398, 1117, 3501,  178, 3679, 1290, 4038, 1652, 2737,  425, 2254, 1596, 3432,  469,
+    2012, 2761, 3983, 3147, 1177,  101, 1400,  989, 2302,  304, 2623,  870,  161, 3985,  584, 1036,
+    2445, 4091, 3537,  691, 3199, 1185, 2853, 2008, 2673,  437, 3688, 2947, 2052, 3085, 2318, 3390,
+     643, 2601, 1198,  188, 1429, 2087, 1674, 4030, 1160,  553, 3443,  146, 2482, 3726, 3402, 1265,
+    1586, 3813, 1380, 2016, 2516, 1786, 3110, 1018,  310, 2124, 3296, 1056, 3015, 3720, 1246, 2638,
+       7, 3668, 1038, 1567, 2427, 3804, 2897, 1795, 3518, 1261, 3330, 1855, 3103, 2782, 2183, 1784,
+    3024, 1279,  926, 1875, 3814,  351,  962, 3593, 1436,  838, 1802, 1110,   43, 1329,  343, 3881,
+    1976, 3192, 1779, 2346, 3857,  673, 3039,   75, 2180, 1811,  947, 3169, 1632,  695, 1942, 2867,
+    2359,  741, 3073,  268, 3929,  669, 2308, 2642, 2910,  565, 3852, 1389, 1934,  638, 2426,  852,
+    1718, 3286,  709, 1905,  390, 3359,  742, 2692,  472, 2121,  678, 3859,  447, 1199, 1503, 3377,
+     232, 2840, 2298,  163, 2625, 1692, 2404,  597, 3063, 3890, 2354, 3423, 3802, 1704, 2459, 2744,
+    1085,  421,  784, 2865, 3538,  449, 1292, 3700, 2833, 1461, 3851, 2309,  348, 4040, 1079, 3205,
+     221, 1799, 3368, 2741, 1618,  909, 3781, 1435, 1838,  823, 3466, 2561,  120, 3216, 4057, 2122,
+    3060, 1336, 2273, 2812, 3639, 2095, 1631,  920, 3948, 2993, 1476, 2430,  972, 3685, 2590,  759,
+    2092, 1603, 3435, 3129, 1370, 3946, 3370, 1904,   97, 2177, 1281, 2605,  518, 3225,  826, 1526,
+    3650, 2154, 4089, 1608, 1008, 2666, 1924, 3309,  357, 2597,  748, 2979, 1222, 2662, 2166,  564,
+    3705, 1001, 2200, 1224, 2967,  420, 3417,   92, 3161, 2366, 1167,  327, 2829, 1529,  996,  378,
+    3475,  248, 3883,  544, 1244,  133, 3160, 2357,  256, 3609, 2817,  140, 2004, 3189,  322, 3921,
+    1147,  482, 3746,  659, 2118,  412, 2942, 1541, 1050, 3206,  301,  694, 2852, 1896, 3509,  122,
+    2943, 1304, 3293,   47, 2263, 3136,  820, 2397, 1094, 3549, 1990, 3360,   56, 1839, 3479, 1498,
+    2570, 3987,   65, 3587, 2418, 1943, 1103, 2102, 3612, 1579, 3960, 2037, 3570, 2297, 3779, 1862,
+    2677, 1610, 2506, 3008,  990, 4067, 2595, 1343, 1918, 1086, 1669, 3420, 1277, 2274, 1719, 3530,
+    2742, 2431, 1817, 1007, 2818, 1237,  801, 3712, 2701, 4071, 1641, 3626, 2129, 1025, 3982, 2276,
+     607, 2632, 1940,  339, 3819, 1478, 1759, 4012,  130, 1615,  540, 1373, 3898, 2850,  780,  381,
+    3046, 2021,  808, 1456,  592, 3288, 4087, 2810,  693,  435, 3029, 1741,  755, 1287,  547, 2908,
+    1144,  821, 3600, 2159, 1505, 1820, 3467,  598, 3221, 3810,  774, 2518, 4052,  595, 2927,  896,
+    3278, 1442,   31, 4036, 2525, 3560, 2237,  160, 2439, 1986,  885, 3033, 1467,  238, 1243, 3146,
+    1753,  942, 3686, 2463, 1171, 3419,  580, 2950, 2145, 3740, 3155, 2494,  951, 1646, 3658, 2377,
+    1286, 1728, 2823, 3830, 2627, 1644,  171, 1330, 2517, 1028, 2709,   33, 3369, 2543, 3130,  198,
+    3979, 1999,   46, 3351,  722, 2860,  291, 2244, 2765,   50, 2144,  424, 3074, 1546,  108, 1958,
+     713, 3644, 2985, 2015,  290, 1737, 3248,  581, 1348, 3401,  457, 2334, 3743, 2717, 2479,  379,
+    3438, 1507, 3048,  726, 2838, 2035,  240, 2583, 1283,  795, 2763, 2250,  297, 2077, 3181, 1106,
+     195, 3503, 3214,  314,  980, 2296, 3089, 1806, 3869, 2198, 3694, 1438,  948, 2156, 3646, 1496,
+    2390, 3194, 1297,  438, 2454, 3722, 1161,  883, 3559, 1425, 2635, 1871,  954, 3616, 2672, 3847,
+     374, 2211, 1176, 3333,  881, 1483, 3003, 3920, 1813, 2801, 1166,   19, 1734, 3328,  785, 3840,
+    2096,  179, 4004,  442, 1401, 3596,  969, 3863, 3283, 1870,  173, 1153, 3399, 4074,  640, 2687,
+    3786, 2223,  546, 1915, 1213, 3715,  786,  264, 3434,  561, 1926, 3173, 4034,  418, 1782,  679,
+    1016, 2738, 1676, 3912, 3095, 1961, 1584, 4001, 1757, 2981, 1212, 3914, 3253, 1132, 2353, 1337,
+    3182, 2580, 1664,  459, 3777, 2657, 1064,  260,  734, 3588, 3124, 4002,  636, 1973, 1377, 2846,
+    1051, 2392, 1825, 2729, 2212, 3180, 1694, 2358,  393, 1548, 3579, 2998, 1462,  451, 1927, 2937,
+     914, 1574, 2491, 4010, 2980, 2084, 2702, 3257, 1551, 1191, 2435,  205, 2805, 1227, 2994, 2040,
+    3394, 3678,  574, 2258,  966,  169, 3295,  350, 2416,  528, 3400,  186,  676, 2044,  258, 1791,
+     853, 2914, 3902,  639, 2321, 3472, 1930, 2201, 2492, 1569, 2112, 2565,  998, 2987,  464, 1635,
+    3523, 3219, 1210,  815, 3794,    2, 1129,  683, 2883, 4000,  924, 2419, 3767, 1709, 2555, 1334,
+     123, 3431,  720, 1422,   20, 3598,  454, 2382,  916, 2898, 3552,  817, 1629, 2317, 3861,   84,
+    2594,  317, 1866, 2905, 1434, 2547, 2808, 2056,  809, 3680, 2220, 1673, 2488, 2824, 3506, 4013,
+    1082,  136, 2055, 1416, 2839,   59, 1258, 3193, 3723,  918,  152, 1314, 3412, 2286, 3935, 2648,
+      77,  619, 3666, 1589, 2559, 1917, 3035, 3489, 2105, 2618,  549, 2027,   45,  776, 3307, 2182,
+    3880, 1868, 3137, 2807, 1724, 1035, 1355, 1962, 3988, 1767,  392, 3798, 2661,  572, 3260,  890,
+    1381, 4081, 1192,  775, 3590, 3827,  631, 1305, 3109, 1043, 2736, 1457, 3727, 3050,  517, 1558,
+    3413, 2480, 3571, 3118,  810, 1639, 4062,  372, 2888,  555, 2720, 3792, 1819,  219, 3642,  879,
+    2174, 1886, 2966,  250, 3335,  538, 3956, 1269,  284, 1774, 1403, 3230, 2806, 1229, 3548, 3027,
+     361, 1140, 2305,  490, 3853, 2531, 3447,  652, 3097,   90, 2108, 3336, 1057, 1914, 1512, 3528,
+    2371, 2094, 3036, 3354,  110, 2171, 1794, 3474, 3919,   13, 1945,  399,  915, 1268, 2197, 1933,
+    2745,  334, 1204, 1836, 3667, 2453, 1004, 3372, 1764, 1415, 2007, 3162,  356, 1181, 1514, 3075,
+    2526, 1313, 4028, 2351,  960, 1427, 2262, 2768,  831, 3378, 3699, 1052, 2311, 3945,  585,  985,
+    1642, 2699, 3648,  863, 3264, 2150,  200, 2750, 3695, 1474, 2548, 1309, 3047, 2217,  363, 2814,
+     207, 1665,  479, 2450, 1560, 1098,  287, 2603, 1606, 2289, 2925, 4078, 3204,  104, 3816,  701,
+    1399, 3990, 2249,  570,  230, 2706, 2083,  688, 2347, 3955, 3540,  792, 2452, 2875, 2032,  501,
+    3389, 1080,  366, 2832, 2030, 3681,  112, 1649, 3856, 2436,  212, 3072,  385, 1807, 2111, 2513,
+     246, 4050, 1995, 1298,  321, 1552, 2968, 1173, 2270,  952, 3492,  481,  747, 4016, 3659, 1142,
+    3153, 3837,  979, 2757, 3984, 3241, 2990,  864,  477, 3289, 1138,  740, 1783, 2646, 2369, 3303,
+    3017, 1700,  941, 3237, 3809, 1318, 3080,   95, 1165, 2975,  414, 1070, 1670, 4079, 3256,  749,
+    3834, 1778, 3502, 1549,  637, 3244, 2576, 1026, 2969,  661, 1959, 1577, 2691, 1320, 3747, 2881,
+    1444, 3212,  670, 2455, 3529, 1859, 4015,  783, 1712,  280, 3906, 1873, 2891,    0, 1746, 2490,
+     800, 3450, 1891, 1353,  686, 2001, 2344, 3772, 1417, 3586, 2514, 2066, 3463, 1593, 1006,  462,
+    3763,   26, 2551, 2870, 1951, 1515, 3504, 3876, 2609, 1555, 2151, 3332, 2665,   29, 2304, 1424,
+     269, 2153, 2670,  828, 3931, 3022, 1863,  450, 2135, 1218, 3525, 3997,  880, 3337,  155,  767,
+    3448, 1773,  128, 3064, 1015, 2633,  535, 3322, 2438, 3121, 2696, 1531, 2356, 3251, 1363, 2051,
+     586, 2656, 2266,   49, 3623,  417, 1184, 2710, 1852,  649,  144, 1341, 3850,  276, 2844, 1898,
+     791, 2090, 3553, 1099,  658,  299, 2285,  861, 1900,  245, 3745,  634, 1299, 1872, 3677, 1022,
+    2933, 3171,   82, 2424, 1137,  323, 1365, 3640, 3300, 2792,   27, 2232,  550, 2420, 2965, 2033,
+    1105, 2343, 2773, 3895, 2085, 1383,   73, 3759, 1937, 1255,  622, 3729, 1101,  874, 2764, 3891,
+    1570,  307, 3749, 3117, 2837, 1648, 3403,  216, 2203, 3933, 2794, 3069,  541, 2178, 3631, 1220,
+    3348, 1441,  394, 2340, 4043, 3291, 1750,  524, 2790, 3191, 2396,  940, 3478, 2803,  566, 2558,
+    1651, 3613, 1278, 1960, 3542, 1696, 2295, 4090,  856, 1491, 1781, 3183, 1045, 3871, 1624, 3572,
+     489, 3718,  889,  403, 1686, 3603, 2877, 2194,  997,  175, 3366, 2089,  377, 3607,  158, 3380,
+    2984, 1251, 1034, 1804,  807, 2461, 4056,  934, 3187, 1699, 1077, 2375,  876, 1509, 3116, 2433,
+    2664, 3926, 2978, 1623, 2681, 1245, 3016, 3711, 1061, 1376, 3923, 1715, 3049,  204, 3971, 2068,
+     845, 3877,  493, 2842, 3265,  170, 2718,  576, 2472,  296, 3735, 2585, 1397, 1901,  344, 2647,
+    1263, 1522, 2187, 3311, 1197,  645, 3140, 1566, 2762, 3940, 2529, 1675, 3038, 2256, 1903,  510,
+    2401, 4008, 2136, 3318, 1390,  560, 2099, 1513, 2893,  395, 3662, 1878, 3415, 4023,  211,  605,
+    1037,  118, 1842, 3451,  913,  149, 2054, 2497, 3436,   64, 2029,  456, 2216, 1510, 1207, 3355,
+     333, 2355, 1518,  706, 3799,  974, 2061, 3141, 1118, 1989, 3425,  729, 3051,  117, 2269, 3270,
+    3822, 3032,   16, 2557, 4085, 2405,  274,  830, 3520,  478, 1402,  769, 4055, 1235, 2606,  945,
+    1711,  712,  187, 2567, 3696, 3043,   85, 3510, 1275,  763, 2556,   37, 1175, 2715, 1702, 2019,
+    3669, 1308,  732, 2202,  494, 3862, 1465,  708, 1628, 2901,  827, 2619, 3641,  704, 2437, 2995,
+    1908, 1100, 3093, 2168, 2563, 1311, 3483, 1535, 2909, 3924,  500, 1247, 2819, 4048,  933,  628,
+    1780, 2828,  789, 1954, 3457, 1747, 1109, 3842, 1850, 2333, 3209, 2921,  237, 3526, 1479, 3846,
+    3236, 2890, 3574,  373, 1922, 1133, 3790, 2650, 2280, 3317, 3886, 2078, 2944,  710, 3274, 2324,
+    2802, 3157, 3778, 2553, 3217, 2772, 3547, 2365,  340, 4068, 3304, 1131, 3133, 3844, 1771,  111,
+    2690, 4058, 3445,   15, 1816,  419, 3867,  771, 1725,   83, 2172, 2387, 1607, 3536, 2005, 2489,
+    1087,  271, 3207, 1391,  519, 2899, 2128, 2639, 1266,   36, 2039, 1042, 1792,  599, 2778,   53,
+    2011, 1331, 2259, 1565, 2789,  900, 1745,  295, 1948,  522, 1617, 1372,  341, 3803, 1447,  443,
+    1936,  316, 1590,  986, 1910, 1146,  234, 3077, 1824, 1285, 2275, 1929,  376, 1410,  961, 3566,
+     612, 1358, 1680,  927, 3665, 2788, 2364,  266, 2608, 3284, 3687,  836, 3159,  384, 1464, 3347,
+    3962, 2107, 1636, 3879,  977,  143, 3703, 3294,  680, 2835, 3427, 3752, 2493, 2170, 3102, 1111,
+    3738,  465,  803, 3132, 3934, 2367,  664, 2951, 4027,  956, 3149, 3555, 2199, 2510,  898, 3469,
+    1179, 2257, 3040,   12, 1421, 3973, 2131,  850, 3787, 2725,  578, 3455,  180, 2552, 2854, 2195,
+    3197,  265, 2515, 2958,  642, 3235, 1190, 1928, 3009, 1378, 1065, 1844, 2669,  189, 1193, 2760,
+     460, 2338, 3585, 2654, 2997, 2248, 1484,  388, 1685, 3968,  884, 1521,  331, 3321,  822, 1660,
+    2434, 2684, 3383, 1203,  109, 3460, 1443, 3263, 1225, 2451, 2749,  233, 1093, 3079, 1775, 4094,
+     668, 2464, 3878, 3513,  600, 3325, 1653,  470, 2520,  982, 1543, 2936, 3989, 2073, 1609, 3782,
+     832, 1950, 3900, 2282, 1446, 2079, 4041,  912, 3565,  431, 3976,  603, 2116, 3866, 3628, 3067,
+     858, 1325,  208,  667, 1232, 3514,  855, 3113, 1977, 2568,  492, 2288, 1209, 3909, 1946, 3541,
+     257, 4084, 1787, 2041,  552, 2554, 2158, 3637,  181, 1827,  790, 3742, 1967,  542, 2688,  184,
+    2903, 1698,  833, 2003, 2652, 2336, 2861, 3689, 3143,   52, 3618, 1788,  782, 1097,  476, 3371,
+    1234, 2758,  368, 1078, 3418,  511,  151, 1634, 2233, 2498, 2797, 3388, 1688, 2423,  690, 1572,
+    1876, 3770, 3373, 2023, 2500, 1815, 4039, 2408,  214, 1352, 2956, 3578, 2730,  153, 3021, 1409,
+     655, 2239,  950, 2962, 3728, 1661,  991,  452, 2857, 1575, 2255, 3327, 1303, 3916, 1530, 3282,
+    3657, 1350,  383, 2970, 1196,  168, 1033, 1394, 1970, 2234, 1200, 3218, 2370, 3697, 3052,  102,
+    2395, 1564, 3584, 3088, 1736, 2679, 3755, 3163,  707, 1492,   44, 1256, 2959,  987,  119, 2226,
+    2593, 2895, 1046, 3179,   58,  498, 2809, 1134, 3446, 3848, 1017, 1884, 1614,  559, 2522, 1074,
+    2830, 1528, 3215,  342, 1344, 2733, 3994, 1985, 3178, 3882,  611,  134, 2977, 2362,  871, 2138,
+    1072, 2530, 3176, 3765, 1818, 4046,  736, 3481,  359, 3928,  663, 2754,  251, 1349, 2659, 1812,
+    4005,  657, 2120,   55,  811, 2402, 1300, 2868, 3480, 2034, 3708,  371, 3200, 1968, 3494, 4073,
+     332,  557, 1720, 3938, 1369, 3736, 1594,  716, 2071, 3249,   74,  754, 3165, 4018, 2046, 3441,
+    3682,  126, 3874, 2474,  723, 3343,   30, 1159,  825, 1375, 2521, 3630, 1708,  422, 3440,   76,
+    3999,  582, 2227,  262, 1520, 2110, 3231, 2685, 1755, 2487, 1487, 3392, 1997,  556, 2221,  931,
+    3203, 2847, 1382, 3713, 1889, 3949, 1013,  220, 1826, 1112, 2345,  843, 3836, 1388, 2740, 1148,
+    3087, 1466, 2331,  842, 2686, 2206, 3042,  336, 2341, 1730, 2676, 3692, 2167, 1257,  869,  411,
+    2349, 1841, 1136, 2104, 3592, 1801, 2319, 3013, 2651, 3454, 2075, 1019, 2800, 1219, 2630, 1837,
+    1420, 2774, 3331,  973, 3595, 2399,  534, 2939, 1127,  141, 3019,  959, 3974, 3508, 1536, 3812,
+     223, 1141, 3386, 2578,  409, 3004, 2141,  562, 2620, 4025, 2916, 1613, 2550,  530, 1762,  804,
+    3301, 2053, 3622,  253, 3405, 1932,  994, 3651, 2872,  571, 1426, 2448,  289, 2920, 3312, 1681,
+    2658, 3128,  514, 2882,  919,  306, 1463, 3839,  526,  288, 1849, 4060,  727, 3139, 3761, 2036,
+    3517,  760, 1729, 1270, 2624,   35,  910, 1604, 3820, 3562, 2139,  429, 1723, 2821,  756, 2503,
+    1978,  505, 2300,  957, 1611, 3316, 3594, 1451, 3213,  294,  650, 3379, 2188,  197, 3653, 2413,
+       4, 3894, 2564,  641, 1238, 3154,  190, 1482, 3904, 1182, 3524,  944, 3872, 1500,   24, 3793,
+     705, 1332, 3998, 1597, 3268, 2575, 3663, 2162, 1657, 3232, 2400,   54, 1508, 2271,  536,  236,
+    3026, 2373, 3885,  458, 3084, 3730, 3408, 1972, 2294,  764, 1301, 2584, 3279,    6, 1240, 3106,
+    3624, 1740, 4066, 2923,  194, 1217,  743, 2314, 1714, 3661, 1315,  967, 3041, 3950, 2009, 2866,
+    1295, 1637,  978, 2822, 1805, 4059, 2473,  788, 3292, 1982,  427, 3055, 1851, 2323, 2781, 1996,
+    1020, 2218, 3512,  100, 1957, 1250,  654, 1060, 2926,  873, 1273, 3583, 2856, 3338,  929, 1626,
+    1180,   99, 2880, 2074, 1833,  681, 1374, 2722,  215, 4083, 3138, 1913, 1071, 2378, 3753,  328,
+    1445, 2723,  689, 2060, 3824, 2475, 2753, 3918,   25, 2097, 2783, 1877,  346, 1488, 1096,  672,
+    3468, 3030,  309, 2185, 3581,  513, 1616, 2743, 2243,   91, 2615, 3391,  682, 1120,  485, 3635,
+    3020,  338, 2449,  834, 2766, 3100, 4031,  218, 3487, 2693, 3884,  405, 1938, 2540, 3970, 2160,
+    2675, 3672, 1010, 1458, 3991, 2523, 1107, 3269,  402, 1511, 2864,  548, 3887, 1612, 2143, 2948,
+     866, 3452,   98, 3250, 1405,  495, 1925,  902, 3115, 1151, 2407, 3791, 3527, 2604, 3254, 2293,
+     453, 1941, 3808, 3240, 1379,  121, 2986, 1047, 1765, 3951, 1293, 2125, 1654, 4061, 2508, 3352,
+    1758, 1473, 3910, 3409, 1677,  436, 2070, 2465, 1793, 1533, 2204,  624, 1088, 1371,  320, 3186,
+    1894,  608, 3365,  324, 2272,  182, 2971, 3754, 1800, 2411,  893, 3619,  272, 3374,  626, 1857,
+    2442, 1188, 2241, 1705, 1049, 3477, 2963, 1561,  415, 3361,  765,  532, 1656,  127,  860, 4037,
+    1449, 2535, 1122,  692, 2409, 2081, 3496, 3769,  621, 3104,  849, 3691,  196, 2940, 1340,  887,
+     156, 2713, 1183,  617, 2268, 3751, 1406, 3315,  766,  114, 3126, 3757, 2945, 1772, 3533,  798,
+    1282, 1599, 2486, 3120, 3561, 1697,  946, 2133,  591, 3428, 1221, 2228, 2703, 1387, 1011, 3996,
+    3568,  400, 2640, 3081, 3750,  278, 2165, 3611, 2637, 4072, 1419, 2949, 2214, 3156, 1830, 2775,
+    3608,   78, 1722, 2755, 3961,  875, 1216, 2545,  303, 1470, 2771, 2421,  380, 3247, 2240,  648,
+    3833, 2109, 1861, 3044,  999,    5, 2904, 1114, 3958, 2549, 1993,  892, 3407, 2385,  145, 3817,
+    2862, 4069, 1992,  840,  537, 2769, 1333, 3959, 2600, 3059, 1662,  137, 1984, 3010, 3222,   66,
+    2796, 1582, 3927,  737, 1879, 2524,  651, 1262, 1760,  105, 2022, 2519, 1116, 3855, 1306,  613,
+    2067,  939, 3414, 3108, 1542,  355, 1944, 3245, 2299, 3422, 1843, 1005, 3515, 1539, 1912, 2858,
+    3546, 3177,  259, 2599, 3577, 2410, 1920,  543, 3627, 1326,  293, 2716, 1499,  554, 2103, 2592,
+     386,   38, 2222, 1157, 3709, 3226,   86, 1953,  770,  335, 3676, 4024, 2495,  758, 1717, 2320,
+     563, 2026,  949, 1324,  132, 2871, 3972, 1000, 2329, 3261, 3664,  891,  365, 3491,  209, 2388,
+    2917, 3783,  277, 2238,  551, 3701, 2931, 1659,   61, 4033,  504, 2058, 3806, 1202,   42, 2542,
+    1067, 1413,  488, 4093, 1534,  715, 3239, 1627, 2816, 2292, 3202, 1187, 4006, 1703, 3065, 1076,
+    1455, 3493, 3005, 1748, 2566, 1506, 2332, 3522, 1135, 1486, 2780,  983,  448, 3439, 1172, 3768,
+    1459, 2973, 3683, 3243, 2383, 3421, 1493, 3127,  242, 2815,  593, 1865, 3061, 2643, 1645, 3313,
+    1155, 1481, 2607, 1867, 1316, 3465, 2644,  805, 1104, 1367, 3012,  721, 2613, 3090,  444, 3975,
+    1679, 2363,  868, 3341, 1241, 2152, 3908,  325,  955, 1798,  506, 3550,  199,  824, 3733, 3266,
+    2425,  935, 3841,  416,  702, 3905,  282, 2886, 3135, 2213, 3277, 1881, 1346, 3907, 2100, 2598,
+     273, 3486, 2229,  360, 1691,  877,  473, 1964, 3758, 1194, 1592, 3944, 1395, 2157,  724, 3913,
+     434, 3053,  753, 4088, 1039, 2376,  255, 3864, 2176, 2827, 3633, 1633, 2316,  906, 3276, 2020,
+     699, 3717, 2929, 1790, 2735,  172, 3001, 2577, 3731, 3362, 2076, 2457, 2907, 1880, 2245,  653,
+    1619, 1965, 2683, 1296, 3310, 2088,  971, 1684,  503, 3762,   23, 2415,  635, 2887,  157, 3142,
+    1084,  684, 1909, 1158, 2748, 3892, 2147, 2591,  781, 3473, 2251, 2739,   40, 3652, 1009, 2000,
+    1777, 2310, 3367,   18, 2038, 3167,  644, 1768, 3285, 2483,  401,  135, 3922, 1797, 1327, 2784,
+    3471,  103, 2184,  387, 3801, 2002, 1154, 1448,  799,   96, 1550, 1030, 3811, 1342, 2752, 3634,
+     499, 3411,  226, 2918, 1848, 2476, 3602, 2628, 1289,  841, 1727, 2704, 3606, 1557, 3308,  862,
+    1766, 2826, 4092, 2481,   17, 3534, 1335, 2952, 1726,  337, 1044, 3324,  487, 2462, 3184, 2795,
+     243, 3591, 1267, 2869, 1602, 2714, 3564, 1437, 1987,  922, 1226, 3381, 2705,  579, 3670,  229,
+    2484, 1119, 1472, 3185,  984,  620, 3498, 2279, 3096, 4053, 2667,  596, 3172,  364,  129, 1169
+};
+
+}   // namespace foundation
@@ -0,0 +1,74 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+
+namespace foundation
+{
+
+//
+// A tileable blue noise mask generated with the void-and-cluster method.
+// Each texel holds its rank in [0, BlueNoiseMaskSize^2); thresholding the
+// mask at any level yields a blue noise dither pattern.
+//
+// Reference:
+//
+//   Ulichney, The void-and-cluster method for dither array generation
+//   http://cv.ulichney.com/papers/1993-void-cluster.pdf
+//
+
+const size_t BlueNoiseMaskSize = 64;
+extern const std::uint16_t BlueNoiseMask[BlueNoiseMaskSize * BlueNoiseMaskSize];
+
+// Return the value of the blue noise mask at a given pixel, in (0, 1).
+// The mask is repeated to cover the whole plane.
+template <typename T>
+T blue_noise(const size_t x, const size_t y);
+
+
+//
+// Implementation.
+//
+
+template <typename T>
+inline T blue_noise(const size_t x, const size_t y)
+{
+    const size_t index =
+        (y % BlueNoiseMaskSize) * BlueNoiseMaskSize +
+        (x % BlueNoiseMaskSize);
+
+    return
+        (static_cast<T>(BlueNoiseMask[index]) + T(0.5)) /
+        static_cast<T>(BlueNoiseMaskSize * BlueNoiseMaskSize);
+}
+
+}   // namespace foundation
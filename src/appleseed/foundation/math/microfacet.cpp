@@ -30,8 +30,13 @@
 #include "microfacet.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/fastmath.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/specialfunctions.h"
+#include "foundation/memory/memory.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 
 // Standard headers.
 #include <cassert>
@@ -116,6 +121,201 @@ namespace
     }
 }
 
+#ifdef APPLESEED_USE_SSE
+
+namespace
+{
+    //
+    // SSE helpers used by the vectorized methods of the MDF classes.
+    //
+
+    // Return a where mask is set and b elsewhere.
+    inline __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    inline __m128 square(const __m128 x)
+    {
+        return _mm_mul_ps(x, x);
+    }
+
+    inline void normalize(__m128& x, __m128& y, __m128& z)
+    {
+        const __m128 rcp_norm =
+            _mm_div_ps(
+                _mm_set1_ps(1.0f),
+                _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(square(x), square(y)), square(z))));
+
+        x = _mm_mul_ps(x, rcp_norm);
+        y = _mm_mul_ps(y, rcp_norm);
+        z = _mm_mul_ps(z, rcp_norm);
+    }
+
+    // Compute the sine and cosine of angles in [0, 2*Pi].
+    void sincos(const __m128 phi, __m128& sin_phi, __m128& cos_phi)
+    {
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        const __m128 pi = _mm_set1_ps(Pi<float>());
+
+        // Map the angle to [-Pi, Pi] using sin(x) = -sin(x - Pi) and cos(x) = -cos(x - Pi).
+        const __m128 x = _mm_sub_ps(phi, pi);
+
+        // Fold the angle to [-Pi/2, Pi/2] using sin(x) = sin(Pi - x) and cos(x) = -cos(Pi - x).
+        const __m128 x_sign = _mm_and_ps(x, sign_mask);
+        const __m128 abs_x = _mm_andnot_ps(sign_mask, x);
+        const __m128 fold = _mm_cmpgt_ps(abs_x, _mm_set1_ps(HalfPi<float>()));
+        const __m128 y = select(fold, _mm_xor_ps(_mm_sub_ps(pi, abs_x), x_sign), x);
+        const __m128 y2 = square(y);
+
+        // Taylor series, accurate to float precision over [-Pi/2, Pi/2].
+        __m128 s = _mm_set1_ps(-1.0f / 39916800.0f);
+        s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(1.0f / 362880.0f));
+        s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(-1.0f / 5040.0f));
+        s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(1.0f / 120.0f));
+        s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(-1.0f / 6.0f));
+        s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(1.0f));
+        s = _mm_mul_ps(s, y);
+
+        __m128 c = _mm_set1_ps(1.0f / 479001600.0f);
+        c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(-1.0f / 3628800.0f));
+        c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(1.0f / 40320.0f));
+        c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(-1.0f / 720.0f));
+        c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(1.0f / 24.0f));
+        c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(-1.0f / 2.0f));
+        c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(1.0f));
+
+        sin_phi = _mm_xor_ps(s, sign_mask);
+        cos_phi = _mm_xor_ps(c, _mm_andnot_ps(fold, sign_mask));
+    }
+
+    __m128 stretched_roughness(
+        const __m128        m_x,
+        const __m128        m_z,
+        const __m128        sin_theta,
+        const float         alpha_x,
+        const float         alpha_y)
+    {
+        const __m128 isotropic = _mm_set1_ps(1.0f / (alpha_x * alpha_x));
+
+        if (alpha_x == alpha_y)
+            return isotropic;
+
+        const __m128 is_normal = _mm_cmpeq_ps(sin_theta, _mm_setzero_ps());
+        const __m128 safe_sin_theta = select(is_normal, _mm_set1_ps(1.0f), sin_theta);
+
+        const __m128 cos_phi_2_ax_2 = square(_mm_div_ps(m_x, _mm_mul_ps(safe_sin_theta, _mm_set1_ps(alpha_x))));
+        const __m128 sin_phi_2_ay_2 = square(_mm_div_ps(m_z, _mm_mul_ps(safe_sin_theta, _mm_set1_ps(alpha_y))));
+
+        return select(is_normal, isotropic, _mm_add_ps(cos_phi_2_ax_2, sin_phi_2_ay_2));
+    }
+
+    __m128 projected_roughness(
+        const __m128        m_x,
+        const __m128        m_z,
+        const __m128        sin_theta,
+        const float         alpha_x,
+        const float         alpha_y)
+    {
+        const __m128 isotropic = _mm_set1_ps(alpha_x);
+
+        if (alpha_x == alpha_y)
+            return isotropic;
+
+        const __m128 is_normal = _mm_cmpeq_ps(sin_theta, _mm_setzero_ps());
+        const __m128 safe_sin_theta = select(is_normal, _mm_set1_ps(1.0f), sin_theta);
+
+        const __m128 cos_phi_2_ax_2 = square(_mm_div_ps(_mm_mul_ps(m_x, _mm_set1_ps(alpha_x)), safe_sin_theta));
+        const __m128 sin_phi_2_ay_2 = square(_mm_div_ps(_mm_mul_ps(m_z, _mm_set1_ps(alpha_y)), safe_sin_theta));
+
+        return select(is_normal, isotropic, _mm_sqrt_ps(_mm_add_ps(cos_phi_2_ax_2, sin_phi_2_ay_2)));
+    }
+
+    __m128 beckmann_lambda(
+        const Vector3fx4&   v,
+        const float         alpha_x,
+        const float         alpha_y)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        const __m128 cos_theta = _mm_load_ps(v.y);
+        const __m128 sin_theta = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, square(cos_theta))));
+
+        // No shadowing at grazing angles and at normal incidence.
+        const __m128 is_degenerate =
+            _mm_or_ps(
+                _mm_cmpeq_ps(cos_theta, zero),
+                _mm_cmpeq_ps(sin_theta, zero));
+
+        const __m128 alpha =
+            projected_roughness(
+                _mm_load_ps(v.x),
+                _mm_load_ps(v.z),
+                sin_theta,
+                alpha_x,
+                alpha_y);
+
+        const __m128 safe_cos_theta = select(is_degenerate, one, cos_theta);
+        const __m128 safe_sin_theta = select(is_degenerate, one, sin_theta);
+
+        const __m128 tan_theta = _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_div_ps(safe_sin_theta, safe_cos_theta));
+        const __m128 a = _mm_div_ps(one, _mm_mul_ps(alpha, tan_theta));
+        const __m128 a2 = square(a);
+
+        const __m128 value =
+            _mm_div_ps(
+                _mm_add_ps(_mm_sub_ps(one, _mm_mul_ps(_mm_set1_ps(1.259f), a)), _mm_mul_ps(_mm_set1_ps(0.396f), a2)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(3.535f), a), _mm_mul_ps(_mm_set1_ps(2.181f), a2)));
+
+        const __m128 is_shadowed = _mm_andnot_ps(is_degenerate, _mm_cmplt_ps(a, _mm_set1_ps(1.6f)));
+
+        return _mm_and_ps(is_shadowed, value);
+    }
+
+    __m128 ggx_lambda(
+        const Vector3fx4&   v,
+        const float         alpha_x,
+        const float         alpha_y)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        const __m128 cos_theta = _mm_load_ps(v.y);
+        const __m128 cos_theta_2 = square(cos_theta);
+        const __m128 sin_theta = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, cos_theta_2)));
+
+        // No shadowing at grazing angles.
+        const __m128 is_grazing = _mm_cmpeq_ps(cos_theta, zero);
+
+        const __m128 alpha =
+            projected_roughness(
+                _mm_load_ps(v.x),
+                _mm_load_ps(v.z),
+                sin_theta,
+                alpha_x,
+                alpha_y);
+
+        const __m128 tan_theta_2 = _mm_div_ps(square(sin_theta), select(is_grazing, one, cos_theta_2));
+        const __m128 a2_rcp = _mm_mul_ps(square(alpha), tan_theta_2);
+        const __m128 value = _mm_mul_ps(_mm_sub_ps(_mm_sqrt_ps(_mm_add_ps(one, a2_rcp)), one), _mm_set1_ps(0.5f));
+
+        return _mm_andnot_ps(is_grazing, value);
+    }
+
+    void store_smith_g(
+        const __m128        lambda_sum,
+        float               result[4])
+    {
+        assert(is_aligned(result, 16));
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        _mm_store_ps(result, _mm_div_ps(one, _mm_add_ps(one, lambda_sum)));
+    }
+}
+
+#endif  // APPLESEED_USE_SSE
+
 
 //
 // BlinnMDF class implementation.
@@ -369,6 +569,167 @@ float BeckmannMDF::pdf(
     return pdf_visible_normals<BeckmannMDF>(v, m, alpha_x, alpha_y);
 }
 
+void BeckmannMDF::D(
+    const Vector3fx4&   m,
+    const float         alpha_x,
+    const float         alpha_y,
+    float               result[4])
+{
+#ifdef APPLESEED_USE_SSE
+
+    assert(is_aligned(result, 16));
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 cos_theta = _mm_load_ps(m.y);
+    const __m128 is_grazing = _mm_cmpeq_ps(cos_theta, zero);
+
+    const __m128 cos_theta_2 = square(cos_theta);
+    const __m128 sin_theta = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, cos_theta_2)));
+    const __m128 cos_theta_4 = square(cos_theta_2);
+    const __m128 tan_theta_2 = _mm_div_ps(_mm_sub_ps(one, cos_theta_2), select(is_grazing, one, cos_theta_2));
+
+    const __m128 A =
+        stretched_roughness(
+            _mm_load_ps(m.x),
+            _mm_load_ps(m.z),
+            sin_theta,
+            alpha_x,
+            alpha_y);
+
+    // fast_exp() clamps its argument, flush the results that would be denormals.
+    const __m128 exponent = _mm_sub_ps(zero, _mm_mul_ps(tan_theta_2, A));
+    const __m128 is_underflow = _mm_cmplt_ps(exponent, _mm_set1_ps(-87.0f));
+
+    const __m128 value =
+        _mm_div_ps(
+            fast_exp(exponent),
+            _mm_mul_ps(_mm_set1_ps(Pi<float>() * alpha_x * alpha_y), cos_theta_4));
+
+    _mm_store_ps(result, _mm_andnot_ps(_mm_or_ps(is_grazing, is_underflow), value));
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result[i] = D(m.get(i), alpha_x, alpha_y);
+
+#endif
+}
+
+void BeckmannMDF::G(
+    const Vector3fx4&   wi,
+    const Vector3fx4&   wo,
+    const Vector3fx4&   m,
+    const float         alpha_x,
+    const float         alpha_y,
+    float               result[4])
+{
+#ifdef APPLESEED_USE_SSE
+
+    store_smith_g(
+        _mm_add_ps(
+            beckmann_lambda(wo, alpha_x, alpha_y),
+            beckmann_lambda(wi, alpha_x, alpha_y)),
+        result);
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result[i] = G(wi.get(i), wo.get(i), m.get(i), alpha_x, alpha_y);
+
+#endif
+}
+
+void BeckmannMDF::G1(
+    const Vector3fx4&   v,
+    const Vector3fx4&   m,
+    const float         alpha_x,
+    const float         alpha_y,
+    float               result[4])
+{
+#ifdef APPLESEED_USE_SSE
+
+    store_smith_g(beckmann_lambda(v, alpha_x, alpha_y), result);
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result[i] = G1(v.get(i), m.get(i), alpha_x, alpha_y);
+
+#endif
+}
+
+void BeckmannMDF::sample(
+    const Vector3fx4&   v,
+    const Vector2fx4&   s,
+    const float         alpha_x,
+    const float         alpha_y,
+    Vector3fx4&         result)
+{
+#ifdef APPLESEED_USE_SSE
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 ax = _mm_set1_ps(alpha_x);
+    const __m128 ay = _mm_set1_ps(alpha_y);
+
+    // Stretch incident.
+    const __m128 v_y = _mm_load_ps(v.y);
+    const __m128 sign_cos_vn = _mm_and_ps(_mm_cmplt_ps(v_y, zero), sign_mask);
+    __m128 stretched_x = _mm_xor_ps(_mm_mul_ps(_mm_load_ps(v.x), ax), sign_cos_vn);
+    __m128 stretched_y = _mm_xor_ps(v_y, sign_cos_vn);
+    __m128 stretched_z = _mm_xor_ps(_mm_mul_ps(_mm_load_ps(v.z), ay), sign_cos_vn);
+    normalize(stretched_x, stretched_y, stretched_z);
+
+    // The slope distribution is inverted with data-dependent Newton iterations,
+    // one lane at a time.
+    APPLESEED_SIMD4_ALIGN float cos_theta[4];
+    APPLESEED_SIMD4_ALIGN float slope_x[4];
+    APPLESEED_SIMD4_ALIGN float slope_y[4];
+    _mm_store_ps(cos_theta, stretched_y);
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const Vector2f slope = sample_slope(cos_theta[i], s.get(i));
+        slope_x[i] = slope[0];
+        slope_y[i] = slope[1];
+    }
+
+    // Rotate by the azimuth of the stretched incident direction.
+    const __m128 is_normal = _mm_cmpge_ps(stretched_y, _mm_set1_ps(0.99999f));
+    const __m128 norm_xz =
+        select(
+            is_normal,
+            one,
+            _mm_sqrt_ps(_mm_add_ps(square(stretched_x), square(stretched_z))));
+    const __m128 cos_phi = select(is_normal, one, _mm_div_ps(stretched_x, norm_xz));
+    const __m128 sin_phi = _mm_andnot_ps(is_normal, _mm_div_ps(stretched_z, norm_xz));
+
+    const __m128 sx = _mm_load_ps(slope_x);
+    const __m128 sy = _mm_load_ps(slope_y);
+    const __m128 rotated_x = _mm_sub_ps(_mm_mul_ps(cos_phi, sx), _mm_mul_ps(sin_phi, sy));
+    const __m128 rotated_y = _mm_add_ps(_mm_mul_ps(sin_phi, sx), _mm_mul_ps(cos_phi, sy));
+
+    // Unstretch and normalize.
+    __m128 m_x = _mm_xor_ps(_mm_mul_ps(rotated_x, ax), sign_mask);
+    __m128 m_y = one;
+    __m128 m_z = _mm_xor_ps(_mm_mul_ps(rotated_y, ay), sign_mask);
+    normalize(m_x, m_y, m_z);
+
+    _mm_store_ps(result.x, m_x);
+    _mm_store_ps(result.y, m_y);
+    _mm_store_ps(result.z, m_z);
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result.set(i, sample(v.get(i), s.get(i), alpha_x, alpha_y));
+
+#endif
+}
+
 
 //
 // GGXMDF class implementation.
@@ -574,6 +935,185 @@ float GGXMDF::pdf(
         D(m, alpha) / std::abs(cos_theta_v);
 }
 
+void GGXMDF::D(
+    const Vector3fx4&   m,
+    const float         alpha_x,
+    const float         alpha_y,
+    float               result[4])
+{
+#ifdef APPLESEED_USE_SSE
+
+    assert(is_aligned(result, 16));
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 cos_theta = _mm_load_ps(m.y);
+    const __m128 is_grazing = _mm_cmpeq_ps(cos_theta, zero);
+
+    const __m128 cos_theta_2 = square(cos_theta);
+    const __m128 sin_theta = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, cos_theta_2)));
+    const __m128 cos_theta_4 = square(cos_theta_2);
+    const __m128 tan_theta_2 = _mm_div_ps(_mm_sub_ps(one, cos_theta_2), select(is_grazing, one, cos_theta_2));
+
+    const __m128 A =
+        stretched_roughness(
+            _mm_load_ps(m.x),
+            _mm_load_ps(m.z),
+            sin_theta,
+            alpha_x,
+            alpha_y);
+
+    const __m128 tmp = _mm_add_ps(one, _mm_mul_ps(tan_theta_2, A));
+    const __m128 value =
+        _mm_div_ps(
+            one,
+            _mm_mul_ps(
+                _mm_mul_ps(_mm_set1_ps(Pi<float>() * alpha_x * alpha_y), cos_theta_4),
+                square(tmp)));
+
+    _mm_store_ps(
+        result,
+        select(is_grazing, _mm_set1_ps(alpha_x * alpha_x * RcpPi<float>()), value));
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result[i] = D(m.get(i), alpha_x, alpha_y);
+
+#endif
+}
+
+void GGXMDF::G(
+    const Vector3fx4&   wi,
+    const Vector3fx4&   wo,
+    const Vector3fx4&   m,
+    const float         alpha_x,
+    const float         alpha_y,
+    float               result[4])
+{
+#ifdef APPLESEED_USE_SSE
+
+    store_smith_g(
+        _mm_add_ps(
+            ggx_lambda(wo, alpha_x, alpha_y),
+            ggx_lambda(wi, alpha_x, alpha_y)),
+        result);
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result[i] = G(wi.get(i), wo.get(i), m.get(i), alpha_x, alpha_y);
+
+#endif
+}
+
+void GGXMDF::G1(
+    const Vector3fx4&   v,
+    const Vector3fx4&   m,
+    const float         alpha_x,
+    const float         alpha_y,
+    float               result[4])
+{
+#ifdef APPLESEED_USE_SSE
+
+    store_smith_g(ggx_lambda(v, alpha_x, alpha_y), result);
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result[i] = G1(v.get(i), m.get(i), alpha_x, alpha_y);
+
+#endif
+}
+
+void GGXMDF::sample(
+    const Vector3fx4&   v,
+    const Vector2fx4&   s,
+    const float         alpha_x,
+    const float         alpha_y,
+    Vector3fx4&         result)
+{
+#ifdef APPLESEED_USE_SSE
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 pi = _mm_set1_ps(Pi<float>());
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 ax = _mm_set1_ps(alpha_x);
+    const __m128 ay = _mm_set1_ps(alpha_y);
+
+    // Stretch incident.
+    const __m128 v_y = _mm_load_ps(v.y);
+    const __m128 sign_cos_vn = _mm_and_ps(_mm_cmplt_ps(v_y, zero), sign_mask);
+    __m128 stretched_x = _mm_xor_ps(_mm_mul_ps(_mm_load_ps(v.x), ax), sign_cos_vn);
+    __m128 stretched_y = _mm_xor_ps(v_y, sign_cos_vn);
+    __m128 stretched_z = _mm_xor_ps(_mm_mul_ps(_mm_load_ps(v.z), ay), sign_cos_vn);
+    normalize(stretched_x, stretched_y, stretched_z);
+
+    // Build an orthonormal basis. cross(stretched, (0, 1, 0)) is (-stretched.z, 0, stretched.x).
+    const __m128 is_normal = _mm_cmpge_ps(v_y, _mm_set1_ps(0.9999f));
+    const __m128 rcp_norm_xz =
+        _mm_div_ps(
+            one,
+            select(
+                is_normal,
+                one,
+                _mm_sqrt_ps(_mm_add_ps(square(stretched_x), square(stretched_z)))));
+    const __m128 t1_x = select(is_normal, one, _mm_xor_ps(_mm_mul_ps(stretched_z, rcp_norm_xz), sign_mask));
+    const __m128 t1_z = _mm_andnot_ps(is_normal, _mm_mul_ps(stretched_x, rcp_norm_xz));
+    const __m128 t2_x = _mm_sub_ps(zero, _mm_mul_ps(t1_z, stretched_y));
+    const __m128 t2_y = _mm_sub_ps(_mm_mul_ps(t1_z, stretched_x), _mm_mul_ps(t1_x, stretched_z));
+    const __m128 t2_z = _mm_mul_ps(t1_x, stretched_y);
+
+    // Sample point with polar coordinates (r, phi).
+    const __m128 s0 = _mm_load_ps(s.x);
+    const __m128 s1 = _mm_load_ps(s.y);
+    const __m128 a = _mm_div_ps(one, _mm_add_ps(one, stretched_y));
+    const __m128 r = _mm_sqrt_ps(s0);
+    const __m128 in_first_half = _mm_cmplt_ps(s1, a);
+    const __m128 safe_one_minus_a = select(in_first_half, one, _mm_sub_ps(one, a));
+    const __m128 phi =
+        select(
+            in_first_half,
+            _mm_mul_ps(_mm_div_ps(s1, a), pi),
+            _mm_add_ps(pi, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(s1, a), safe_one_minus_a), pi)));
+
+    __m128 sin_phi, cos_phi;
+    sincos(phi, sin_phi, cos_phi);
+
+    const __m128 p1 = _mm_mul_ps(r, cos_phi);
+    const __m128 p2 = _mm_mul_ps(_mm_mul_ps(r, sin_phi), select(in_first_half, one, stretched_y));
+
+    // Compute normal.
+    const __m128 p3 =
+        _mm_sqrt_ps(
+            _mm_max_ps(
+                zero,
+                _mm_sub_ps(_mm_sub_ps(one, square(p1)), square(p2))));
+    const __m128 h_x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p1, t1_x), _mm_mul_ps(p2, t2_x)), _mm_mul_ps(p3, stretched_x));
+    const __m128 h_y = _mm_add_ps(_mm_mul_ps(p2, t2_y), _mm_mul_ps(p3, stretched_y));
+    const __m128 h_z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p1, t1_z), _mm_mul_ps(p2, t2_z)), _mm_mul_ps(p3, stretched_z));
+
+    // Unstretch and normalize.
+    __m128 m_x = _mm_mul_ps(h_x, ax);
+    __m128 m_y = _mm_max_ps(zero, h_y);
+    __m128 m_z = _mm_mul_ps(h_z, ay);
+    normalize(m_x, m_y, m_z);
+
+    _mm_store_ps(result.x, m_x);
+    _mm_store_ps(result.y, m_y);
+    _mm_store_ps(result.z, m_z);
+
+#else
+
+    for (size_t i = 0; i < 4; ++i)
+        result.set(i, sample(v.get(i), s.get(i), alpha_x, alpha_y));
+
+#endif
+}
+
+
 //
 // WardMDF class implementation.
 //
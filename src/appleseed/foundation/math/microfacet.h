@@ -34,10 +34,36 @@
 
 // Standard headers.
 #include <algorithm>
+#include <cstddef>
 
 namespace foundation
 {
 
+//
+// Packets of four 2D and 3D vectors in structure-of-arrays layout,
+// as consumed by the vectorized methods of the MDF classes.
+//
+
+struct Vector2fx4
+{
+    APPLESEED_SIMD4_ALIGN float x[4];
+    APPLESEED_SIMD4_ALIGN float y[4];
+
+    void set(const size_t i, const Vector2f& v);
+    Vector2f get(const size_t i) const;
+};
+
+struct Vector3fx4
+{
+    APPLESEED_SIMD4_ALIGN float x[4];
+    APPLESEED_SIMD4_ALIGN float y[4];
+    APPLESEED_SIMD4_ALIGN float z[4];
+
+    void set(const size_t i, const Vector3f& v);
+    Vector3f get(const size_t i) const;
+};
+
+
 //
 // Blinn-Phong Microfacet Distribution Function.
 //
@@ -147,6 +173,38 @@ class BeckmannMDF
         const float         alpha_x,
         const float         alpha_y);
 
+    // Vectorized versions of D(), G(), G1() and sample() operating on four
+    // directions at once. When APPLESEED_USE_SSE is defined, the `result`
+    // arrays must be 16-byte aligned.
+
+    static void D(
+        const Vector3fx4&   m,
+        const float         alpha_x,
+        const float         alpha_y,
+        float               result[4]);
+
+    static void G(
+        const Vector3fx4&   wi,
+        const Vector3fx4&   wo,
+        const Vector3fx4&   m,
+        const float         alpha_x,
+        const float         alpha_y,
+        float               result[4]);
+
+    static void G1(
+        const Vector3fx4&   v,
+        const Vector3fx4&   m,
+        const float         alpha_x,
+        const float         alpha_y,
+        float               result[4]);
+
+    static void sample(
+        const Vector3fx4&   v,
+        const Vector2fx4&   s,
+        const float         alpha_x,
+        const float         alpha_y,
+        Vector3fx4&         result);
+
   private:
     static Vector2f sample_slope(
         const float         cos_theta,
@@ -239,6 +297,38 @@ class GGXMDF
         const Vector3f&     m,
         const float         alpha);
 
+    // Vectorized versions of D(), G(), G1() and sample() operating on four
+    // directions at once. When APPLESEED_USE_SSE is defined, the `result`
+    // arrays must be 16-byte aligned.
+
+    static void D(
+        const Vector3fx4&   m,
+        const float         alpha_x,
+        const float         alpha_y,
+        float               result[4]);
+
+    static void G(
+        const Vector3fx4&   wi,
+        const Vector3fx4&   wo,
+        const Vector3fx4&   m,
+        const float         alpha_x,
+        const float         alpha_y,
+        float               result[4]);
+
+    static void G1(
+        const Vector3fx4&   v,
+        const Vector3fx4&   m,
+        const float         alpha_x,
+        const float         alpha_y,
+        float               result[4]);
+
+    static void sample(
+        const Vector3fx4&   v,
+        const Vector2fx4&   s,
+        const float         alpha_x,
+        const float         alpha_y,
+        Vector3fx4&         result);
+
   private:
     static float lambda(
         const Vector3f&     v,
@@ -408,4 +498,32 @@ class StdMDF
     static float S2(const float cot_theta, const float gamma);
 };
 
+
+//
+// Vector2fx4 and Vector3fx4 class implementation.
+//
+
+inline void Vector2fx4::set(const size_t i, const Vector2f& v)
+{
+    x[i] = v.x;
+    y[i] = v.y;
+}
+
+inline Vector2f Vector2fx4::get(const size_t i) const
+{
+    return Vector2f(x[i], y[i]);
+}
+
+inline void Vector3fx4::set(const size_t i, const Vector3f& v)
+{
+    x[i] = v.x;
+    y[i] = v.y;
+    z[i] = v.z;
+}
+
+inline Vector3f Vector3fx4::get(const size_t i) const
+{
+    return Vector3f(x[i], y[i], z[i]);
+}
+
 }   // namespace foundation
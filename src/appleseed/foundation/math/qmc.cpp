@@ -297,4 +297,111 @@ const double PrecomputedHaltonSequence[4 * PrecomputedHaltonSequenceSize] =
     0.9960937500000000, 0.1495198902606310, 0.0432000000000000, 0.4635568513119533
 };
 
+
+//
+// Generator matrices of the first dimensions of the Sobol sequence.
+//
+// Dimension 0 is the van der Corput sequence; dimensions 1 to 15 use the primitive
+// polynomials and initial direction numbers of Joe and Kuo (new-joe-kuo-6.21201).
+//
+
+const std::uint32_t SobolMatrices[SobolDimensionCount * 32] =
+{
+    // Dimension 0.
+    0x80000000u, 0x40000000u, 0x20000000u, 0x10000000u, 0x08000000u, 0x04000000u, 0x02000000u, 0x01000000u,
+    0x00800000u, 0x00400000u, 0x00200000u, 0x00100000u, 0x00080000u, 0x00040000u, 0x00020000u, 0x00010000u,
+    0x00008000u, 0x00004000u, 0x00002000u, 0x00001000u, 0x00000800u, 0x00000400u, 0x00000200u, 0x00000100u,
+    0x00000080u, 0x00000040u, 0x00000020u, 0x00000010u, 0x00000008u, 0x00000004u, 0x00000002u, 0x00000001u,
+
+    // Dimension 1.
+    0x80000000u, 0xC0000000u, 0xA0000000u, 0xF0000000u, 0x88000000u, 0xCC000000u, 0xAA000000u, 0xFF000000u,
+    0x80800000u, 0xC0C00000u, 0xA0A00000u, 0xF0F00000u, 0x88880000u, 0xCCCC0000u, 0xAAAA0000u, 0xFFFF0000u,
+    0x80008000u, 0xC000C000u, 0xA000A000u, 0xF000F000u, 0x88008800u, 0xCC00CC00u, 0xAA00AA00u, 0xFF00FF00u,
+    0x80808080u, 0xC0C0C0C0u, 0xA0A0A0A0u, 0xF0F0F0F0u, 0x88888888u, 0xCCCCCCCCu, 0xAAAAAAAAu, 0xFFFFFFFFu,
+
+    // Dimension 2.
+    0x80000000u, 0xC0000000u, 0x60000000u, 0x90000000u, 0xE8000000u, 0x5C000000u, 0x8E000000u, 0xC5000000u,
+    0x68800000u, 0x9CC00000u, 0xEE600000u, 0x55900000u, 0x80680000u, 0xC09C0000u, 0x60EE0000u, 0x90550000u,
+    0xE8808000u, 0x5CC0C000u, 0x8E606000u, 0xC5909000u, 0x6868E800u, 0x9C9C5C00u, 0xEEEE8E00u, 0x5555C500u,
+    0x8000E880u, 0xC0005CC0u, 0x60008E60u, 0x9000C590u, 0xE8006868u, 0x5C009C9Cu, 0x8E00EEEEu, 0xC5005555u,
+
+    // Dimension 3.
+    0x80000000u, 0xC0000000u, 0x20000000u, 0x50000000u, 0xF8000000u, 0x74000000u, 0xA2000000u, 0x93000000u,
+    0xD8800000u, 0x25400000u, 0x59E00000u, 0xE6D00000u, 0x78080000u, 0xB40C0000u, 0x82020000u, 0xC3050000u,
+    0x208F8000u, 0x51474000u, 0xFBEA2000u, 0x75D93000u, 0xA0858800u, 0x914E5400u, 0xDBE79E00u, 0x25DB6D00u,
+    0x58800080u, 0xE54000C0u, 0x79E00020u, 0xB6D00050u, 0x800800F8u, 0xC00C0074u, 0x200200A2u, 0x50050093u,
+
+    // Dimension 4.
+    0x80000000u, 0x40000000u, 0x20000000u, 0xB0000000u, 0xF8000000u, 0xDC000000u, 0x7A000000u, 0x9D000000u,
+    0x5A800000u, 0x2FC00000u, 0xA1600000u, 0xF0B00000u, 0xDA880000u, 0x6FC40000u, 0x81620000u, 0x40BB0000u,
+    0x22878000u, 0xB3C9C000u, 0xFB65A000u, 0xDDB2D000u, 0x78022800u, 0x9C0B3C00u, 0x5A0FB600u, 0x2D0DDB00u,
+    0xA2878080u, 0xF3C9C040u, 0xDB65A020u, 0x6DB2D0B0u, 0x800228F8u, 0x400B3CDCu, 0x200FB67Au, 0xB00DDB9Du,
+
+    // Dimension 5.
+    0x80000000u, 0x40000000u, 0x60000000u, 0x30000000u, 0xC8000000u, 0x24000000u, 0x56000000u, 0xFB000000u,
+    0xE0800000u, 0x70400000u, 0xA8600000u, 0x14300000u, 0x9EC80000u, 0xDF240000u, 0xB6D60000u, 0x8BBB0000u,
+    0x48008000u, 0x64004000u, 0x36006000u, 0xCB003000u, 0x2880C800u, 0x54402400u, 0xFE605600u, 0xEF30FB00u,
+    0x7E48E080u, 0xAF647040u, 0x1EB6A860u, 0x9F8B1430u, 0xD6C81EC8u, 0xBB249F24u, 0x80D6D6D6u, 0x40BBBBBBu,
+
+    // Dimension 6.
+    0x80000000u, 0xC0000000u, 0xA0000000u, 0xD0000000u, 0x58000000u, 0x94000000u, 0x3E000000u, 0xE3000000u,
+    0xBE800000u, 0x23C00000u, 0x1E200000u, 0xF3100000u, 0x46780000u, 0x67840000u, 0x78460000u, 0x84670000u,
+    0xC6788000u, 0xA784C000u, 0xD846A000u, 0x5467D000u, 0x9E78D800u, 0x33845400u, 0xE6469E00u, 0xB7673300u,
+    0x20F86680u, 0x104477C0u, 0xF8668020u, 0x4477C010u, 0x668020F8u, 0x77C01044u, 0x8020F866u, 0xC0104477u,
+
+    // Dimension 7.
+    0x80000000u, 0x40000000u, 0xA0000000u, 0x50000000u, 0x88000000u, 0x24000000u, 0x12000000u, 0x2D000000u,
+    0x76800000u, 0x9E400000u, 0x08200000u, 0x64100000u, 0xB2280000u, 0x7D140000u, 0xFEA20000u, 0xBA490000u,
+    0x1A248000u, 0x491B4000u, 0xC4B5A000u, 0xE3739000u, 0xF6800800u, 0xDE400400u, 0xA8200A00u, 0x34100500u,
+    0x3A280880u, 0x59140240u, 0xECA20120u, 0x974902D0u, 0x6CA48768u, 0xD75B49E4u, 0xCC95A082u, 0x87639641u,
+
+    // Dimension 8.
+    0x80000000u, 0x40000000u, 0xA0000000u, 0x50000000u, 0x28000000u, 0xD4000000u, 0x6A000000u, 0x71000000u,
+    0x38800000u, 0x58400000u, 0xEA200000u, 0x31100000u, 0x98A80000u, 0x08540000u, 0xC22A0000u, 0xE5250000u,
+    0xF2B28000u, 0x79484000u, 0xFAA42000u, 0xBD731000u, 0x18A80800u, 0x48540400u, 0x622A0A00u, 0xB5250500u,
+    0xDAB28280u, 0xAD484D40u, 0x90A426A0u, 0xCC731710u, 0x20280B88u, 0x10140184u, 0x880A04A2u, 0x84350611u,
+
+    // Dimension 9.
+    0x80000000u, 0x40000000u, 0xE0000000u, 0xB0000000u, 0x98000000u, 0x94000000u, 0x8A000000u, 0x5B000000u,
+    0x33800000u, 0xD9C00000u, 0x72200000u, 0x3F100000u, 0xC1B80000u, 0xA6EC0000u, 0x53860000u, 0x29F50000u,
+    0x0A3A8000u, 0x1B2AC000u, 0xD392E000u, 0x69FF7000u, 0xEA380800u, 0xAB2C0400u, 0x4BA60E00u, 0xFDE50B00u,
+    0x60028980u, 0xF006C940u, 0x7834E8A0u, 0x241A75B0u, 0x123A8B38u, 0xCF2AC99Cu, 0xB992E922u, 0x82FF78F1u,
+
+    // Dimension 10.
+    0x80000000u, 0x40000000u, 0xA0000000u, 0x10000000u, 0x08000000u, 0x6C000000u, 0x9E000000u, 0x23000000u,
+    0x57800000u, 0xADC00000u, 0x7FA00000u, 0x91D00000u, 0x49880000u, 0xCED40000u, 0x880A0000u, 0x2C0F0000u,
+    0x3E0D8000u, 0x3317C000u, 0x5FB06000u, 0xC1F8B000u, 0xE18D8800u, 0xB2D7C400u, 0x1E106A00u, 0x6328B100u,
+    0xF7858880u, 0xBDC3C2C0u, 0x77BA63E0u, 0xFDF7B330u, 0xD7800DF8u, 0xEDC0081Cu, 0xDFA0041Au, 0x81D00A2Du,
+
+    // Dimension 11.
+    0x80000000u, 0x40000000u, 0x20000000u, 0x30000000u, 0x58000000u, 0xAC000000u, 0x96000000u, 0x2B000000u,
+    0xD4800000u, 0x09400000u, 0xE2A00000u, 0x52500000u, 0x4E280000u, 0xC71C0000u, 0x629E0000u, 0x12670000u,
+    0x6E138000u, 0xF731C000u, 0x3A98A000u, 0xBE449000u, 0xF83B8800u, 0xDC2DC400u, 0xEE06A200u, 0xB7239300u,
+    0x1AA80D80u, 0x8E5C0EC0u, 0xA03E0B60u, 0x703701B0u, 0x783B88C8u, 0x9C2DCA54u, 0xCE06A74Au, 0x87239795u,
+
+    // Dimension 12.
+    0x80000000u, 0xC0000000u, 0xA0000000u, 0x50000000u, 0xF8000000u, 0x8C000000u, 0xE2000000u, 0x33000000u,
+    0x0F800000u, 0x21400000u, 0x95A00000u, 0x5E700000u, 0xD8080000u, 0x1C240000u, 0xBA160000u, 0xEF370000u,
+    0x15868000u, 0x9E6FC000u, 0x781B6000u, 0x4C349000u, 0x420E8800u, 0x630BCC00u, 0xF7AD6A00u, 0xAD739500u,
+    0x77800780u, 0x6D4004C0u, 0xD7A00420u, 0x3D700630u, 0x2F880F78u, 0xB1640AD4u, 0xCDB6077Au, 0x824706D7u,
+
+    // Dimension 13.
+    0x80000000u, 0xC0000000u, 0x60000000u, 0x90000000u, 0x38000000u, 0xC4000000u, 0x42000000u, 0xA3000000u,
+    0xF1800000u, 0xAA400000u, 0xFCE00000u, 0x85100000u, 0xE0080000u, 0x500C0000u, 0x58060000u, 0x54090000u,
+    0x7A038000u, 0x670C4000u, 0xB3842000u, 0x094A3000u, 0x0D6F1800u, 0x2F5AA400u, 0x1CE7CE00u, 0xD5145100u,
+    0xB8000080u, 0x040000C0u, 0x22000060u, 0x33000090u, 0xC9800038u, 0x6E4000C4u, 0xBEE00042u, 0x261000A3u,
+
+    // Dimension 14.
+    0x80000000u, 0x40000000u, 0x20000000u, 0xF0000000u, 0xA8000000u, 0x54000000u, 0x9A000000u, 0x9D000000u,
+    0x1E800000u, 0x5CC00000u, 0x7D200000u, 0x8D100000u, 0x24880000u, 0x71C40000u, 0xEBA20000u, 0x75DF0000u,
+    0x6BA28000u, 0x35D14000u, 0x4BA3A000u, 0xC5D2D000u, 0xE3A16800u, 0x91DB8C00u, 0x79AEF200u, 0x0CDF4100u,
+    0x672A8080u, 0x50154040u, 0x1A01A020u, 0xDD0DD0F0u, 0x3E83E8A8u, 0xACCACC54u, 0xD52D529Au, 0xD91D919Du,
+
+    // Dimension 15.
+    0x80000000u, 0xC0000000u, 0x20000000u, 0xD0000000u, 0xD8000000u, 0xC4000000u, 0x46000000u, 0x85000000u,
+    0xA5800000u, 0x76C00000u, 0xADA00000u, 0x6AB00000u, 0x2DA80000u, 0xAABC0000u, 0x0DAA0000u, 0x7AB10000u,
+    0xD5A78000u, 0xBEBD4000u, 0x93A3E000u, 0x3BB51000u, 0x3629B800u, 0x4D727C00u, 0x9B836200u, 0x27C4D700u,
+    0xB629B880u, 0x8D727CC0u, 0xBB836220u, 0xF7C4D7D0u, 0x6E29B858u, 0x49727C04u, 0xFD836266u, 0x72C4D755u,
+};
+
 }   // namespace foundation
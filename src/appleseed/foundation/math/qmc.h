@@ -30,6 +30,7 @@
 #pragma once
 
 // appleseed.foundation headers.
+#include "foundation/hash/hash.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/arch.h"
@@ -53,7 +54,6 @@ namespace foundation
 //   implement specializations of Halton and Hammersley sequences generators for bases (2,3).
 //   implement incremental radical inverse (for successive input values).
 //   implement vectorized radical inverse functions with SSE2.
-//   implement Sobol sequence generator.
 //
 
 
@@ -200,6 +200,62 @@ Vector<T, Dim> hammersley_zaremba_sequence(
     const size_t        i);             // sample number
 
 
+//
+// Sobol sequences with hash-based Owen scrambling.
+//
+// All return values are in the interval [0, 1)^Dim.
+//
+// References:
+//
+//   Joe and Kuo, Constructing Sobol Sequences with Better Two-Dimensional Projections
+//   https://web.maths.unsw.edu.au/~fkuo/sobol/joe-kuo-notes.pdf
+//
+//   Burley, Practical Hash-based Owen Scrambling
+//   http://www.jcgt.org/published/0009/04/01/paper.pdf
+//
+
+// Number of dimensions for which generator matrices are precomputed.
+const size_t SobolDimensionCount = 16;
+
+// Generator matrices of the first dimensions of the Sobol sequence (32 direction numbers per dimension).
+extern const std::uint32_t SobolMatrices[SobolDimensionCount * 32];
+
+// Return the i'th sample of a given dimension of the Sobol sequence, as a 32-bit fixed-point value.
+std::uint32_t sobol_uint32(
+    const size_t        dimension,      // dimension, in [0, SobolDimensionCount)
+    std::uint32_t       i);             // sample number
+
+// Reverse the order of the bits of a 32-bit integer.
+std::uint32_t reverse_bits_uint32(
+    std::uint32_t       value);
+
+// Nested uniform scrambling (Owen scrambling) of a 32-bit fixed-point value in [0, 1).
+std::uint32_t owen_scramble_uint32(
+    std::uint32_t       value,          // input digits
+    const std::uint32_t seed);          // scrambling seed
+
+// Shuffle the sample numbers of a Sobol sequence while preserving its stratification.
+// Only the 16 low bits get shuffled, which keeps the sample numbers small.
+std::uint32_t shuffle_sobol_index(
+    const std::uint32_t i,              // sample number
+    const std::uint32_t seed);          // shuffling seed
+
+// Return the i'th sample of a given dimension of an Owen-scrambled Sobol sequence.
+template <typename T>
+T scrambled_sobol(
+    const size_t        dimension,      // dimension, in [0, SobolDimensionCount)
+    const std::uint32_t seed,           // scrambling seed
+    const std::uint32_t i);             // sample number
+
+// Return the i'th sample of the first dimensions of an Owen-scrambled Sobol sequence.
+// The sample number is itself shuffled, so that sequences obtained with different
+// seeds are decorrelated from each other (this is how sequences get padded).
+template <typename T, size_t Dim>
+Vector<T, Dim> scrambled_sobol_sequence(
+    const std::uint32_t seed,           // scrambling seed
+    const std::uint32_t i);             // sample number
+
+
 //
 // Base-2 radical inverse functions implementation.
 //
@@ -2610,4 +2666,91 @@ inline Vector<T, Dim> hammersley_zaremba_sequence(
     return p;
 }
 
+
+//
+// Sobol sequences implementation.
+//
+
+inline std::uint32_t sobol_uint32(
+    const size_t        dimension,
+    std::uint32_t       i)
+{
+    assert(dimension < SobolDimensionCount);
+
+    const std::uint32_t* matrix = SobolMatrices + dimension * 32;
+    std::uint32_t result = 0;
+
+    // Branchless, since scrambled sample numbers have random bits.
+    for (; i != 0; i >>= 1, ++matrix)
+        result ^= *matrix & (0 - (i & 1));
+
+    return result;
+}
+
+inline std::uint32_t reverse_bits_uint32(
+    std::uint32_t       value)
+{
+    value = (value >> 16) | (value << 16);                                                      // 16-bit swap
+    value = ((value & 0xFF00FF00u) >> 8) | ((value & 0x00FF00FFu) << 8);                        // 8-bit swap
+    value = ((value & 0xF0F0F0F0u) >> 4) | ((value & 0x0F0F0F0Fu) << 4);                        // 4-bit swap
+    value = ((value & 0xCCCCCCCCu) >> 2) | ((value & 0x33333333u) << 2);                        // 2-bit swap
+    value = ((value & 0xAAAAAAAAu) >> 1) | ((value & 0x55555555u) << 1);                        // 1-bit swap
+    return value;
+}
+
+inline std::uint32_t owen_scramble_uint32(
+    std::uint32_t       value,
+    const std::uint32_t seed)
+{
+    // Laine-Karras style permutation: each bit only depends on the bits below it,
+    // which, once the digits are reversed, amounts to a nested uniform scramble.
+    value = reverse_bits_uint32(value);
+    value += seed;
+    value ^= value * 0x6C50B47Cu;
+    value ^= value * 0xB82F1E52u;
+    value ^= value * 0xC7AFE638u;
+    value ^= value * 0x8D22F6E6u;
+    return reverse_bits_uint32(value);
+}
+
+inline std::uint32_t shuffle_sobol_index(
+    const std::uint32_t i,
+    const std::uint32_t seed)
+{
+    // The upper digits of a nested uniform scramble only depend on the upper digits of its input.
+    return (i & 0xFFFF0000u) | (owen_scramble_uint32(i << 16, seed) >> 16);
+}
+
+template <typename T>
+inline T scrambled_sobol(
+    const size_t        dimension,
+    const std::uint32_t seed,
+    const std::uint32_t i)
+{
+    const std::uint32_t x =
+        owen_scramble_uint32(
+            sobol_uint32(dimension, i),
+            combine_hashes(seed, static_cast<std::uint32_t>(dimension)));
+
+    // Keep 24 bits so that the result is strictly less than 1 in single precision.
+    return static_cast<T>(x >> 8) * T(1.0 / 16777216.0);
+}
+
+template <typename T, size_t Dim>
+inline Vector<T, Dim> scrambled_sobol_sequence(
+    const std::uint32_t seed,
+    const std::uint32_t i)
+{
+    static_assert(Dim <= SobolDimensionCount, "foundation::scrambled_sobol_sequence() expects Dim <= SobolDimensionCount");
+
+    const std::uint32_t index = shuffle_sobol_index(i, seed);
+
+    Vector<T, Dim> p;
+
+    for (size_t d = 0; d < Dim; ++d)
+        p[d] = scrambled_sobol<T>(d, seed, index);
+
+    return p;
+}
+
 }   // namespace foundation
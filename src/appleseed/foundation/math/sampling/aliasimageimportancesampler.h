@@ -0,0 +1,326 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/aliastable.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/job/iabortswitch.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// An image importance sampler based on an alias table over the pixel importances.
+//
+// Sampling costs two memory accesses whatever the size of the image, instead of the two
+// binary searches over large arrays performed by ImageImportanceSampler. The part of the
+// first sample dimension that is not consumed by the alias table positions the sample
+// horizontally within the chosen pixel, and the second dimension positions it vertically.
+// Neighboring values of the first sample dimension may select unrelated pixels.
+//
+// No payload is stored per pixel. The pixel probabilities can be written to and read
+// from a stream so that they can be cached across renders.
+//
+// The ImageSampler type must conform to the prototype given in imageimportancesampler.h.
+// Payloads returned by the image sampler are ignored.
+//
+
+template <typename Importance>
+class AliasImageImportanceSampler
+  : public NonCopyable
+{
+  public:
+    typedef Vector<Importance, 2> Vector2Type;
+
+    // Constructor.
+    AliasImageImportanceSampler(
+        const size_t        width,
+        const size_t        height);
+
+    // Resample the image and rebuild the alias table.
+    template <typename ImageSampler>
+    void rebuild(
+        ImageSampler&       sampler,
+        IAbortSwitch*       abort_switch = nullptr);
+
+    // Sample the image and return the coordinates of the chosen pixel
+    // and its probability density.
+    void sample(
+        const Vector2Type&  s,
+        size_t&             x,
+        size_t&             y,
+        Importance&         probability) const;
+
+    // Sample the image and return the coordinates of the chosen pixel, the position
+    // of the sample within this pixel in [0,1)^2 and the probability density of the pixel.
+    void sample(
+        const Vector2Type&  s,
+        size_t&             x,
+        size_t&             y,
+        Vector2Type&        offset,
+        Importance&         probability) const;
+
+    // Return the probability density of a given pixel.
+    Importance get_pdf(
+        const size_t        x,
+        const size_t        y) const;
+
+    // Write the pixel probabilities to a binary stream.
+    void write(std::ostream& output) const;
+
+    // Read the pixel probabilities from a binary stream and rebuild the alias table.
+    // Return false if the stream is invalid or if its dimensions do not match.
+    bool read(std::istream& input);
+
+  private:
+    typedef AliasTable<std::uint32_t, Importance> PixelTable;
+
+    const size_t            m_width;
+    const size_t            m_height;
+    const Importance        m_rcp_pixel_count;
+
+    PixelTable              m_table;        // pixels in scanline order
+
+    void build_table(const std::vector<Importance>& importances);
+};
+
+
+//
+// AliasImageImportanceSampler class implementation.
+//
+
+template <typename Importance>
+AliasImageImportanceSampler<Importance>::AliasImageImportanceSampler(
+    const size_t            width,
+    const size_t            height)
+  : m_width(width)
+  , m_height(height)
+  , m_rcp_pixel_count(Importance(1.0) / (width * height))
+{
+    assert(width > 0);
+    assert(height > 0);
+    assert(width * height <= 0xFFFFFFFFu);
+}
+
+template <typename Importance>
+template <typename ImageSampler>
+void AliasImageImportanceSampler<Importance>::rebuild(
+    ImageSampler&           sampler,
+    IAbortSwitch*           abort_switch)
+{
+    m_table.clear();
+
+    std::vector<Importance> importances(m_width * m_height);
+
+    for (size_t y = 0; y < m_height; ++y)
+    {
+        // Fall back to uniform sampling.
+        if (is_aborted(abort_switch))
+            return;
+
+        for (size_t x = 0; x < m_width; ++x)
+        {
+            typename ImageSampler::Payload payload;
+            Importance importance;
+
+            sampler.sample(x, y, payload, importance);
+            assert(importance >= Importance(0.0));
+
+            importances[y * m_width + x] = importance;
+        }
+    }
+
+    build_table(importances);
+}
+
+template <typename Importance>
+void AliasImageImportanceSampler<Importance>::build_table(const std::vector<Importance>& importances)
+{
+    assert(importances.size() == m_width * m_height);
+
+    m_table.clear();
+    m_table.reserve(importances.size());
+
+    for (size_t i = 0, e = importances.size(); i < e; ++i)
+        m_table.insert(static_cast<std::uint32_t>(i), importances[i]);
+
+    if (m_table.valid())
+        m_table.prepare();
+    else m_table.clear();
+}
+
+template <typename Importance>
+inline void AliasImageImportanceSampler<Importance>::sample(
+    const Vector2Type&      s,
+    size_t&                 x,
+    size_t&                 y,
+    Importance&             probability) const
+{
+    Vector2Type offset;
+    sample(s, x, y, offset, probability);
+}
+
+template <typename Importance>
+inline void AliasImageImportanceSampler<Importance>::sample(
+    const Vector2Type&      s,
+    size_t&                 x,
+    size_t&                 y,
+    Vector2Type&            offset,
+    Importance&             probability) const
+{
+    assert(s[0] >= Importance(0.0) && s[0] < Importance(1.0));
+    assert(s[1] >= Importance(0.0) && s[1] < Importance(1.0));
+
+    if (m_table.valid())
+    {
+        const typename PixelTable::ItemWeightPair& result = m_table.sample(s[0], offset[0]);
+        x = result.first % m_width;
+        y = result.first / m_width;
+        offset[1] = s[1];
+        probability = result.second;
+    }
+    else
+    {
+        // Uniform random sampling.
+        const Importance fx = s[0] * m_width;
+        const Importance fy = s[1] * m_height;
+
+        x = std::min(truncate<size_t>(fx), m_width - 1);
+        y = std::min(truncate<size_t>(fy), m_height - 1);
+
+        offset[0] = fx - x;
+        offset[1] = fy - y;
+
+        probability = m_rcp_pixel_count;
+    }
+
+    assert(x < m_width && y < m_height);
+    assert(probability > Importance(0.0));
+}
+
+template <typename Importance>
+inline Importance AliasImageImportanceSampler<Importance>::get_pdf(
+    const size_t            x,
+    const size_t            y) const
+{
+    assert(x < m_width && y < m_height);
+
+    return
+        m_table.valid()
+            ? m_table[y * m_width + x].second
+            : m_rcp_pixel_count;
+}
+
+namespace impl
+{
+    const char AliasImageImportanceSamplerMagic[4] = { 'A', 'I', 'I', 'S' };
+    const std::uint32_t AliasImageImportanceSamplerVersion = 1;
+}
+
+template <typename Importance>
+void AliasImageImportanceSampler<Importance>::write(std::ostream& output) const
+{
+    const std::uint32_t version = impl::AliasImageImportanceSamplerVersion;
+    const std::uint32_t importance_size = sizeof(Importance);
+    const std::uint64_t width = m_width;
+    const std::uint64_t height = m_height;
+    const std::uint8_t valid = m_table.valid() ? 1 : 0;
+
+    output.write(impl::AliasImageImportanceSamplerMagic, sizeof(impl::AliasImageImportanceSamplerMagic));
+    output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    output.write(reinterpret_cast<const char*>(&importance_size), sizeof(importance_size));
+    output.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    output.write(reinterpret_cast<const char*>(&height), sizeof(height));
+    output.write(reinterpret_cast<const char*>(&valid), sizeof(valid));
+
+    if (valid)
+    {
+        std::vector<Importance> probabilities(m_table.size());
+        for (size_t i = 0, e = m_table.size(); i < e; ++i)
+            probabilities[i] = m_table[i].second;
+
+        output.write(
+            reinterpret_cast<const char*>(&probabilities[0]),
+            probabilities.size() * sizeof(Importance));
+    }
+}
+
+template <typename Importance>
+bool AliasImageImportanceSampler<Importance>::read(std::istream& input)
+{
+    char magic[sizeof(impl::AliasImageImportanceSamplerMagic)];
+    std::uint32_t version, importance_size;
+    std::uint64_t width, height;
+    std::uint8_t valid;
+
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&importance_size), sizeof(importance_size));
+    input.read(reinterpret_cast<char*>(&width), sizeof(width));
+    input.read(reinterpret_cast<char*>(&height), sizeof(height));
+    input.read(reinterpret_cast<char*>(&valid), sizeof(valid));
+
+    if (!input ||
+        std::memcmp(magic, impl::AliasImageImportanceSamplerMagic, sizeof(magic)) != 0 ||
+        version != impl::AliasImageImportanceSamplerVersion ||
+        importance_size != sizeof(Importance) ||
+        width != m_width ||
+        height != m_height)
+        return false;
+
+    if (!valid)
+    {
+        m_table.clear();
+        return true;
+    }
+
+    std::vector<Importance> probabilities(m_width * m_height);
+    input.read(reinterpret_cast<char*>(&probabilities[0]), probabilities.size() * sizeof(Importance));
+
+    if (!input)
+        return false;
+
+    build_table(probabilities);
+
+    return true;
+}
+
+}   // namespace foundation
@@ -30,16 +30,19 @@
 #pragma once
 
 // appleseed.foundation headers.
+#include "foundation/hash/hash.h"
 #include "foundation/math/permutation.h"
 #include "foundation/math/primes.h"
 #include "foundation/math/qmc.h"
 #include "foundation/math/rng/distribution.h"
+#include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/utility/test/helpers.h"
 
 // Standard headers.
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 // Unit test case declarations.
 DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, InitialStateIsCorrect);
@@ -47,6 +50,9 @@ DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestCopyConstruct
 DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestAssignmentOperator);
 DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestSplitting);
 DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestDoubleSplitting);
+DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, SobolMode_InitialStateIsCorrect);
+DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, SobolMode_TestSplitting);
+DECLARE_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, SobolMode_TestSplittingWithUnknownSampleCount);
 
 namespace foundation
 {
@@ -59,11 +65,23 @@ namespace foundation
 //   - Cranley-Patterson rotation
 //   - Monte Carlo padding
 //
-// Reference:
+// or, alternatively:
+//
+//   - Owen-scrambled Sobol sequences
+//   - padding by index shuffling
+//   - optional blue noise rotation in screen space
+//
+// References:
 //
 //   Kollig and Keller, Efficient Multidimensional Sampling
 //   www.uni-kl.de/AG-Heinrich/EMS.pdf
 //
+//   Burley, Practical Hash-based Owen Scrambling
+//   http://www.jcgt.org/published/0009/04/01/paper.pdf
+//
+//   Georgiev and Fajardo, Blue-noise Dithered Sampling
+//   https://www.arnoldrenderer.com/research/dither_abstract.pdf
+//
 
 template <typename RNG>
 class QMCSamplingContext
@@ -72,10 +90,15 @@ class QMCSamplingContext
     // Random number generator type.
     typedef RNG RNGType;
 
-    // This sampler can operate in two modes:
+    // This sampler can operate in three modes:
     //   1. In QMC mode, it uses possibly patent-encumbered techniques.
     //   2. In RNG mode, it works like `RNGSamplingContext` and sticks to random sampling.
-    enum Mode { QMCMode, RNGMode };
+    //   3. In Sobol mode, it uses Owen-scrambled Sobol sequences. The instance number
+    //      given at construction seeds the scrambling. Child contexts with a single
+    //      sample keep drawing the parent's current sample from the next dimensions of
+    //      the sequence; other child contexts, and dimensions beyond the precomputed
+    //      ones, use padding by index shuffling.
+    enum Mode { QMCMode, RNGMode, SobolMode };
 
     // Construct a sampling context of dimension 0.
     // The resulting sampling context cannot be used directly;
@@ -113,6 +136,12 @@ class QMCSamplingContext
     // Set the instance number.
     void set_instance(const size_t instance);
 
+    // In Sobol mode, rotate the samples of this context and of its future children
+    // by an offset in [0,1), for instance the value of a blue noise mask at the pixel.
+    // Pixels sharing the same instance number then share the same scrambled sequence
+    // and the rendering error gets distributed as blue noise in screen space.
+    void set_screen_offset(const double offset);
+
     // Return the next sample in [0,1)^N.
     // Works for scalars and `foundation::Vector<>`.
     template <typename T> T next2();
@@ -129,6 +158,9 @@ class QMCSamplingContext
     GRANT_ACCESS_TO_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestAssignmentOperator);
     GRANT_ACCESS_TO_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestSplitting);
     GRANT_ACCESS_TO_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, TestDoubleSplitting);
+    GRANT_ACCESS_TO_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, SobolMode_InitialStateIsCorrect);
+    GRANT_ACCESS_TO_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, SobolMode_TestSplitting);
+    GRANT_ACCESS_TO_TEST_CASE(Foundation_Math_Sampling_QMCSamplingContext, SobolMode_TestSplittingWithUnknownSampleCount);
 
     typedef Vector<double, 4> VectorType;
 
@@ -144,17 +176,32 @@ class QMCSamplingContext
     size_t      m_instance;
     VectorType  m_offset;
 
+    // Sobol mode only.
+    std::uint32_t   m_sequence_seed;        // seed of the root sequence
+    size_t          m_sequence_base;        // Sobol sample number of instance 0
+    std::uint32_t   m_scrambling_seed;      // seed of this dimension block
+    double          m_screen_offset;        // per-pixel offset, 0 if disabled
+    bool            m_padded;               // true if the sample number is no longer the root's
+
     // Cranley-Patterson rotation.
     template <typename T>
     static T rotate(T x, const T offset);
 
     QMCSamplingContext(
-        RNG&            rng,
-        const Mode      mode,
-        const size_t    base_dimension,
-        const size_t    base_instance,
-        const size_t    dimension,
-        const size_t    sample_count);
+        RNG&                rng,
+        const Mode          mode,
+        const size_t        base_dimension,
+        const size_t        base_instance,
+        const size_t        dimension,
+        const size_t        sample_count,
+        const std::uint32_t sequence_seed,
+        const size_t        sequence_base,
+        const double        screen_offset,
+        const bool          padded);
+
+    // Return the Sobol sample number and seed of a child context with a given number of samples.
+    size_t get_child_sequence_base(const size_t sample_count) const;
+    std::uint32_t get_child_sequence_seed(const size_t sample_count) const;
 
     void compute_offset();
 
@@ -182,6 +229,11 @@ inline QMCSamplingContext<RNG>::QMCSamplingContext(
   , m_sample_count(0)
   , m_instance(0)
   , m_offset(0.0)
+  , m_sequence_seed(hash_uint32(static_cast<std::uint32_t>(base_instance)))
+  , m_sequence_base(0)
+  , m_scrambling_seed(0)
+  , m_screen_offset(0.0)
+  , m_padded(false)
 {
 }
 
@@ -198,10 +250,18 @@ inline QMCSamplingContext<RNG>::QMCSamplingContext(
   , m_base_instance(0)
   , m_dimension(dimension)
   , m_sample_count(sample_count)
-  , m_instance(instance)
+  , m_instance(mode == SobolMode ? 0 : instance)
   , m_offset(0.0)
+  , m_sequence_seed(hash_uint32(static_cast<std::uint32_t>(instance)))
+  , m_sequence_base(0)
+  , m_scrambling_seed(0)
+  , m_screen_offset(0.0)
+  , m_padded(false)
 {
     assert(dimension <= VectorType::Dimension);
+
+    if (m_mode == SobolMode)
+        compute_offset();
 }
 
 template <typename RNG>
@@ -211,7 +271,11 @@ inline QMCSamplingContext<RNG>::QMCSamplingContext(
     const size_t        base_dimension,
     const size_t        base_instance,
     const size_t        dimension,
-    const size_t        sample_count)
+    const size_t        sample_count,
+    const std::uint32_t sequence_seed,
+    const size_t        sequence_base,
+    const double        screen_offset,
+    const bool          padded)
   : m_rng(rng)
   , m_mode(mode)
   , m_base_dimension(base_dimension)
@@ -219,10 +283,14 @@ inline QMCSamplingContext<RNG>::QMCSamplingContext(
   , m_dimension(dimension)
   , m_sample_count(sample_count)
   , m_instance(0)
+  , m_sequence_seed(sequence_seed)
+  , m_sequence_base(sequence_base)
+  , m_screen_offset(screen_offset)
+  , m_padded(padded)
 {
     assert(dimension <= VectorType::Dimension);
 
-    if (m_mode == QMCMode)
+    if (m_mode != RNGMode)
         compute_offset();
 }
 
@@ -239,6 +307,11 @@ QMCSamplingContext<RNG>::operator=(const QMCSamplingContext& rhs)
     m_sample_count = rhs.m_sample_count;
     m_instance = rhs.m_instance;
     m_offset = rhs.m_offset;
+    m_sequence_seed = rhs.m_sequence_seed;
+    m_sequence_base = rhs.m_sequence_base;
+    m_scrambling_seed = rhs.m_scrambling_seed;
+    m_screen_offset = rhs.m_screen_offset;
+    m_padded = rhs.m_padded;
 
     return *this;
 }
@@ -255,7 +328,11 @@ inline QMCSamplingContext<RNG> QMCSamplingContext<RNG>::split(
             m_base_dimension + m_dimension,         // dimension allocation
             m_base_instance + m_instance,           // decorrelation by generalization
             dimension,
-            sample_count);
+            sample_count,
+            get_child_sequence_seed(sample_count),
+            get_child_sequence_base(sample_count),
+            m_screen_offset,
+            m_padded || sample_count != 1);
 }
 
 template <typename RNG>
@@ -266,13 +343,19 @@ inline void QMCSamplingContext<RNG>::split_in_place(
     assert(m_sample_count == 0 || m_instance == m_sample_count);    // can't split in the middle of a sequence
     assert(dimension <= VectorType::Dimension);
 
+    const std::uint32_t sequence_seed = get_child_sequence_seed(sample_count);
+    const size_t sequence_base = get_child_sequence_base(sample_count);
+
     m_base_dimension += m_dimension;                // dimension allocation
     m_base_instance += m_instance;                  // decorrelation by generalization
     m_dimension = dimension;
     m_sample_count = sample_count;
     m_instance = 0;
+    m_sequence_seed = sequence_seed;
+    m_sequence_base = sequence_base;
+    m_padded = m_padded || sample_count != 1;
 
-    if (m_mode == QMCMode)
+    if (m_mode != RNGMode)
         compute_offset();
 }
 
@@ -282,6 +365,17 @@ inline void QMCSamplingContext<RNG>::set_instance(const size_t instance)
     m_instance = instance;
 }
 
+template <typename RNG>
+inline void QMCSamplingContext<RNG>::set_screen_offset(const double offset)
+{
+    assert(offset >= 0.0 && offset < 1.0);
+
+    m_screen_offset = offset;
+
+    if (m_mode == SobolMode)
+        compute_offset();
+}
+
 template <typename RNG>
 template <typename T>
 inline T QMCSamplingContext<RNG>::next2()
@@ -315,9 +409,47 @@ inline T QMCSamplingContext<RNG>::rotate(T x, const T offset)
     return x;
 }
 
+template <typename RNG>
+inline size_t QMCSamplingContext<RNG>::get_child_sequence_base(const size_t sample_count) const
+{
+    // Children of the current sample get the matching range of sample numbers,
+    // so that their dimensions remain stratified across the parent's samples.
+    const size_t current_sample = m_sequence_base + (m_instance > 0 ? m_instance - 1 : 0);
+    return current_sample * sample_count;
+}
+
+template <typename RNG>
+inline std::uint32_t QMCSamplingContext<RNG>::get_child_sequence_seed(const size_t sample_count) const
+{
+    if (sample_count > 0)
+        return m_sequence_seed;
+
+    // The number of samples is unknown: give each of the parent's samples its own sequence.
+    const size_t current_sample = m_sequence_base + (m_instance > 0 ? m_instance - 1 : 0);
+    return mix_uint32(m_sequence_seed, static_cast<std::uint32_t>(current_sample));
+}
+
 template <typename RNG>
 inline void QMCSamplingContext<RNG>::compute_offset()
 {
+    if (m_mode == SobolMode)
+    {
+        m_scrambling_seed =
+            mix_uint32(m_sequence_seed, static_cast<std::uint32_t>(m_base_dimension));
+
+        // Step the screen offset by the golden ratio from one dimension to the next
+        // so that dimensions do not all get rotated by the same amount.
+        for (size_t i = 0, d = m_base_dimension; i < m_dimension; ++i, ++d)
+        {
+            m_offset[i] =
+                m_screen_offset > 0.0
+                    ? frac(m_screen_offset + d * 0.6180339887498949)
+                    : 0.0;
+        }
+
+        return;
+    }
+
     for (size_t i = 0, d = m_base_dimension; i < m_dimension; ++i, ++d)
     {
         if (d < FaurePermutationTableSize)
@@ -377,6 +509,22 @@ inline Vector<T, N> QMCSamplingContext<RNG>::next2(Tag<Vector<T, N>>)
             }
         }
     }
+    else if (m_mode == SobolMode)
+    {
+        const std::uint32_t index = static_cast<std::uint32_t>(m_sequence_base + m_instance);
+
+        if (!m_padded && m_base_dimension + N <= SobolDimensionCount)
+        {
+            const std::uint32_t shuffled_index = shuffle_sobol_index(index, m_sequence_seed);
+
+            for (size_t i = 0; i < N; ++i)
+                v[i] = scrambled_sobol<T>(m_base_dimension + i, m_sequence_seed, shuffled_index);
+        }
+        else v = scrambled_sobol_sequence<T, N>(m_scrambling_seed, index);
+
+        for (size_t i = 0; i < N; ++i)
+            v[i] = rotate(v[i], static_cast<T>(m_offset[i]));
+    }
     else
     {
         for (size_t i = 0; i < N; ++i)
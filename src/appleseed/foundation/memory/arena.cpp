@@ -0,0 +1,220 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "arena.h"
+
+// Standard headers.
+#include <new>
+
+namespace foundation
+{
+
+//
+// Arena class implementation.
+//
+
+struct Arena::Block
+{
+    Block*  m_next;
+    size_t  m_size;                 // usable size in bytes
+
+    std::uint8_t* get_storage()
+    {
+        return reinterpret_cast<std::uint8_t*>(this) + StorageOffset;
+    }
+
+    static const size_t StorageOffset = (sizeof(Block*) + sizeof(size_t) + 15) & ~size_t(15);
+};
+
+namespace
+{
+    // Maximum number of regular blocks kept in the free list of a thread.
+    const size_t MaxFreeBlocksPerThread = 64;
+
+    template <typename Block>
+    Block* create_block(const size_t size)
+    {
+        void* ptr = aligned_malloc(Block::StorageOffset + size, 16);
+
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+
+        Block* block = static_cast<Block*>(ptr);
+        block->m_next = nullptr;
+        block->m_size = size;
+
+        return block;
+    }
+
+    // Regular blocks released by arenas destroyed on this thread.
+    template <typename Block>
+    struct FreeList
+    {
+        Block*  m_head;
+        size_t  m_count;
+
+        FreeList()
+          : m_head(nullptr)
+          , m_count(0)
+        {
+        }
+
+        ~FreeList()
+        {
+            while (m_head)
+            {
+                Block* next = m_head->m_next;
+                aligned_free(m_head);
+                m_head = next;
+            }
+        }
+
+        Block* pop()
+        {
+            Block* block = m_head;
+
+            if (block)
+            {
+                m_head = block->m_next;
+                block->m_next = nullptr;
+                --m_count;
+            }
+            else block = create_block<Block>(Arena::BlockSize);
+
+            return block;
+        }
+
+        void push(Block* block)
+        {
+            if (block->m_size == Arena::BlockSize && m_count < MaxFreeBlocksPerThread)
+            {
+                block->m_next = m_head;
+                m_head = block;
+                ++m_count;
+            }
+            else aligned_free(block);
+        }
+    };
+
+    template <typename Block>
+    FreeList<Block>& get_free_list()
+    {
+        static thread_local FreeList<Block> free_list;
+        return free_list;
+    }
+}
+
+Arena::Arena()
+  : m_first_block(nullptr)
+  , m_current_block(nullptr)
+  , m_current(nullptr)
+  , m_end(nullptr)
+  , m_block_begin(nullptr)
+  , m_size_before_block(0)
+  , m_peak_size(0)
+  , m_block_count(0)
+{
+}
+
+Arena::~Arena()
+{
+    if (m_first_block == nullptr)
+        return;
+
+    FreeList<Block>& free_list = get_free_list<Block>();
+
+    Block* block = m_first_block;
+
+    while (block)
+    {
+        Block* next = block->m_next;
+        free_list.push(block);
+        block = next;
+    }
+}
+
+void* Arena::allocate_slow(const size_t size)
+{
+    const size_t aligned_size = align(size, 16);
+
+    // Move on to the next block owned by the arena that can hold the allocation.
+    Block* block = m_current_block ? m_current_block->m_next : m_first_block;
+    Block* last_block = m_current_block;
+
+    while (block && block->m_size < aligned_size)
+    {
+        last_block = block;
+        block = block->m_next;
+    }
+
+    if (block == nullptr)
+    {
+        // Append a new block at the end of the chain. Skipped blocks are kept for later reuse.
+        block =
+            aligned_size <= BlockSize
+                ? get_free_list<Block>().pop()
+                : create_block<Block>(aligned_size);
+
+        if (last_block)
+            last_block->m_next = block;
+        else m_first_block = block;
+
+        ++m_block_count;
+    }
+
+    // Account for the blocks we are leaving behind.
+    if (m_current_block)
+    {
+        m_size_before_block += m_current_block->m_size;
+
+        for (const Block* b = m_current_block->m_next; b != block; b = b->m_next)
+            m_size_before_block += b->m_size;
+    }
+
+    m_current_block = block;
+    m_block_begin = block->get_storage();
+    m_end = m_block_begin + block->m_size;
+    m_current = m_block_begin + aligned_size;
+
+    update_peak_size();
+
+    return m_block_begin;
+}
+
+void Arena::rewind()
+{
+    m_current_block = m_first_block;
+    m_block_begin = m_first_block->get_storage();
+    m_end = m_block_begin + m_first_block->m_size;
+    m_current = m_block_begin;
+    m_size_before_block = 0;
+}
+
+}   // namespace foundation
@@ -30,9 +30,8 @@
 #pragma once
 
 // appleseed.foundation headers.
-#include "foundation/core/exceptions/exception.h"
+#include "foundation/core/concepts/noncopyable.h"
 #include "foundation/memory/memory.h"
-#include "foundation/platform/compiler.h"
 
 // Standard headers.
 #include <cassert>
@@ -45,11 +44,21 @@ namespace foundation
 //
 // An arena is a temporary heap providing extremely cheap memory allocation.
 //
+// Memory is carved out of a chain of blocks. Blocks are kept by the arena when it
+// is cleared and are returned to a per-thread free list when the arena is destroyed,
+// so that an arena in steady state never touches the heap. Allocations larger than
+// a block get a dedicated block of their own.
+//
 
 class Arena
+  : public NonCopyable
 {
   public:
+    // Usable size of a regular block, in bytes.
+    enum { BlockSize = 64 * 1024 };
+
     Arena();
+    ~Arena();
 
     void clear();
 
@@ -58,14 +67,33 @@ class Arena
     template <typename T> T* allocate();
     template <typename T> T* allocate_noinit();
 
-    const std::uint8_t* get_storage() const;
+    // Return the number of bytes currently allocated (including alignment padding
+    // and the unused tails of blocks that were skipped over).
+    size_t get_size() const;
 
-  private:
-    enum { ArenaSize = 384 * 1024 };    // bytes
+    // Return the largest number of bytes allocated at any time since construction
+    // or since the last call to reset_peak_size().
+    size_t get_peak_size() const;
+    void reset_peak_size();
 
-    APPLESEED_SIMD4_ALIGN std::uint8_t  m_storage[ArenaSize];
-    const std::uint8_t*                 m_end;
-    std::uint8_t*                       m_current;
+    // Return the number of blocks owned by the arena.
+    size_t get_block_count() const;
+
+  private:
+    struct Block;
+
+    Block*                  m_first_block;
+    Block*                  m_current_block;
+    std::uint8_t*           m_current;
+    const std::uint8_t*     m_end;
+    std::uint8_t*           m_block_begin;
+    size_t                  m_size_before_block;    // bytes in the blocks preceding the current one
+    size_t                  m_peak_size;
+    size_t                  m_block_count;
+
+    void* allocate_slow(const size_t size);
+    void rewind();
+    void update_peak_size();
 };
 
 
@@ -73,21 +101,20 @@ class Arena
 // Arena class implementation.
 //
 
-inline Arena::Arena()
-  : m_end(m_storage + ArenaSize)
-  , m_current(m_storage)
-{
-}
-
 inline void Arena::clear()
 {
-    m_current = m_storage;
+    update_peak_size();
+
+    if (m_current_block != m_first_block)
+        rewind();
+    else m_current = m_block_begin;
 }
 
 inline void* Arena::allocate(const size_t size)
 {
-    if (m_current + size > m_end)
-        throw Exception("out of arena memory");
+    // Blocks have a size multiple of 16 bytes, so the aligned size fits if the size does.
+    if (size > static_cast<size_t>(m_end - m_current))
+        return allocate_slow(size);
 
     void* ptr = m_current;
     m_current += align(size, 16);
@@ -113,9 +140,33 @@ inline T* Arena::allocate_noinit()
     return static_cast<T*>(allocate(sizeof(T)));
 }
 
-inline const std::uint8_t* Arena::get_storage() const
+inline size_t Arena::get_size() const
+{
+    return m_size_before_block + static_cast<size_t>(m_current - m_block_begin);
+}
+
+inline size_t Arena::get_peak_size() const
+{
+    const size_t size = get_size();
+    return size > m_peak_size ? size : m_peak_size;
+}
+
+inline void Arena::reset_peak_size()
 {
-    return m_storage;
+    m_peak_size = get_size();
+}
+
+inline size_t Arena::get_block_count() const
+{
+    return m_block_count;
+}
+
+inline void Arena::update_peak_size()
+{
+    const size_t size = get_size();
+
+    if (m_peak_size < size)
+        m_peak_size = size;
 }
 
 }   // namespace foundation
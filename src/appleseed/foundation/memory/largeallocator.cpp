@@ -0,0 +1,252 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "largeallocator.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/scalar.h"
+
+// appleseed.main headers.
+#include "main/allocator.h"
+
+// Standard headers.
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Platform headers.
+#if defined __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace foundation
+{
+
+namespace
+{
+    std::atomic<bool> g_use_huge_pages(true);
+    std::atomic<NUMAPolicy> g_numa_policy(NUMAPolicy::FirstTouch);
+
+#if defined __linux__
+
+    // Size of a transparent huge page on x86-64 and on AArch64 with 4 KB base pages.
+    const size_t HugePageSize = 2 * 1024 * 1024;
+
+    // Value of MPOL_INTERLEAVE in <numaif.h>; we call mbind() directly to avoid depending on libnuma.
+    const int MPolInterleave = 3;
+
+    // Bit mask of the online NUMA nodes (only the first 64 nodes are considered).
+    struct NUMANodes
+    {
+        std::uint64_t   m_mask;
+        size_t          m_count;
+
+        NUMANodes()
+          : m_mask(0)
+          , m_count(0)
+        {
+            // The file contains a list of node ranges such as "0-1" or "0,2-3".
+            std::ifstream file("/sys/devices/system/node/online");
+            std::string line;
+
+            if (std::getline(file, line))
+            {
+                const char* p = line.c_str();
+
+                while (*p >= '0' && *p <= '9')
+                {
+                    char* end;
+                    const unsigned long first = std::strtoul(p, &end, 10);
+                    unsigned long last = first;
+                    p = end;
+
+                    if (*p == '-')
+                    {
+                        last = std::strtoul(p + 1, &end, 10);
+                        p = end;
+                    }
+
+                    for (unsigned long i = first; i <= last && i < 64; ++i)
+                    {
+                        if ((m_mask & (std::uint64_t(1) << i)) == 0)
+                        {
+                            m_mask |= std::uint64_t(1) << i;
+                            ++m_count;
+                        }
+                    }
+
+                    if (*p == ',')
+                        ++p;
+                }
+            }
+
+            if (m_count == 0)
+            {
+                m_mask = 1;
+                m_count = 1;
+            }
+        }
+    };
+
+    const NUMANodes& get_numa_nodes()
+    {
+        static const NUMANodes nodes;
+        return nodes;
+    }
+
+#endif
+}
+
+void set_large_allocation_policy(
+    const bool          use_huge_pages,
+    const NUMAPolicy    numa_policy)
+{
+    g_use_huge_pages = use_huge_pages;
+    g_numa_policy = numa_policy;
+}
+
+bool get_large_allocation_use_huge_pages()
+{
+    return g_use_huge_pages;
+}
+
+NUMAPolicy get_large_allocation_numa_policy()
+{
+    return g_numa_policy;
+}
+
+size_t get_numa_node_count()
+{
+#if defined __linux__
+    return get_numa_nodes().m_count;
+#else
+    return 1;
+#endif
+}
+
+void* large_malloc(const size_t size, const size_t alignment)
+{
+    assert(size > 0);
+
+#if defined __linux__
+
+    if (size < LargeAllocationThreshold)
+        return aligned_malloc(size, alignment);
+
+    assert(alignment <= HugePageSize);
+
+    // Reserve enough address space to place the block on a huge page boundary.
+    const size_t mapping_size = next_multiple(size, HugePageSize);
+    const size_t reserved_size = mapping_size + HugePageSize;
+    void* reserved_ptr =
+        mmap(
+            nullptr,
+            reserved_size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS,
+            -1,
+            0);
+
+    // Handle allocation failures.
+    if (reserved_ptr == MAP_FAILED)
+    {
+        log_allocation_failure(reserved_size);
+        return nullptr;
+    }
+
+    // Give back the unused head and tail of the reservation.
+    std::uint8_t* base_ptr = static_cast<std::uint8_t*>(reserved_ptr);
+    std::uint8_t* ptr = align(base_ptr, HugePageSize);
+    const size_t head_size = ptr - base_ptr;
+    const size_t tail_size = reserved_size - head_size - mapping_size;
+    if (head_size > 0)
+        munmap(base_ptr, head_size);
+    if (tail_size > 0)
+        munmap(ptr + mapping_size, tail_size);
+
+    // Failures below are harmless: transparent huge pages may be disabled system-wide,
+    // and mbind() is unavailable on kernels built without NUMA support.
+#if defined MADV_HUGEPAGE && defined MADV_NOHUGEPAGE
+    madvise(ptr, mapping_size, g_use_huge_pages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+#endif
+
+#if defined SYS_mbind
+    if (g_numa_policy == NUMAPolicy::Interleave)
+    {
+        const NUMANodes& nodes = get_numa_nodes();
+
+        if (nodes.m_count > 1)
+        {
+            // The kernel expects the number of bits in the mask plus one.
+            syscall(SYS_mbind, ptr, mapping_size, MPolInterleave, &nodes.m_mask, 64 + 1, 0);
+        }
+    }
+#endif
+
+    log_allocation(ptr, ptr, mapping_size);
+
+    return ptr;
+
+#else
+
+    return aligned_malloc(size, alignment);
+
+#endif
+}
+
+void large_free(void* ptr, const size_t size)
+{
+    assert(ptr);
+
+#if defined __linux__
+
+    if (size < LargeAllocationThreshold)
+    {
+        aligned_free(ptr);
+        return;
+    }
+
+    log_deallocation(ptr, ptr);
+
+    munmap(ptr, next_multiple(size, HugePageSize));
+
+#else
+
+    aligned_free(ptr);
+
+#endif
+}
+
+}   // namespace foundation
@@ -0,0 +1,236 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/memory/memory.h"
+
+// Standard headers.
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace foundation
+{
+
+//
+// Allocation of large, long-lived blocks of memory such as acceleration structure
+// node arrays and framebuffers.
+//
+// On Linux, blocks of at least LargeAllocationThreshold bytes are mapped directly
+// from the operating system, aligned on huge page boundaries, and optionally backed
+// by transparent huge pages to reduce TLB misses during traversal. On multi-socket
+// machines, the pages of such blocks can also be interleaved across NUMA nodes so
+// that no single memory controller becomes a bottleneck.
+//
+// Smaller blocks, and all blocks on other platforms, fall back to aligned_malloc().
+//
+
+// Placement of the pages of large allocations on NUMA machines.
+enum class NUMAPolicy
+{
+    FirstTouch,     // pages are placed on the node of the thread that first writes them (operating system default)
+    Interleave      // pages are distributed round-robin across all nodes
+};
+
+// Blocks smaller than this size are always allocated with aligned_malloc().
+const size_t LargeAllocationThreshold = 2 * 1024 * 1024;
+
+// Set the policy applied to subsequent large allocations. Thread-safe.
+void set_large_allocation_policy(
+    const bool          use_huge_pages,
+    const NUMAPolicy    numa_policy);
+
+// Retrieve the policy applied to large allocations.
+bool get_large_allocation_use_huge_pages();
+NUMAPolicy get_large_allocation_numa_policy();
+
+// Return the number of NUMA nodes on this machine, or 1 if it cannot be determined.
+size_t get_numa_node_count();
+
+// Allocate a large block of memory. The block is at least aligned on the given boundary.
+// The contents of blocks obtained from the operating system are zero-initialized and
+// are only committed when first written.
+void* large_malloc(const size_t size, const size_t alignment);
+
+// Free a block of memory that was allocated with large_malloc(). The size must match
+// the size passed to large_malloc().
+void large_free(void* ptr, const size_t size);
+
+
+//
+// A standard-conformant allocator allocating memory with large_malloc().
+//
+
+template <typename T>
+class LargeAllocator
+{
+  public:
+    typedef T                   value_type;
+    typedef value_type*         pointer;
+    typedef const value_type*   const_pointer;
+    typedef value_type&         reference;
+    typedef const value_type&   const_reference;
+    typedef size_t              size_type;
+    typedef std::ptrdiff_t      difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef LargeAllocator<U> other;
+    };
+
+    explicit LargeAllocator(const size_t alignment = 16)
+      : m_alignment(alignment)
+    {
+    }
+
+    LargeAllocator(const LargeAllocator& rhs)
+      : m_alignment(rhs.m_alignment)
+    {
+    }
+
+    template <typename U>
+    LargeAllocator(const LargeAllocator<U>& rhs)
+      : m_alignment(rhs.m_alignment)
+    {
+    }
+
+    LargeAllocator& operator=(const LargeAllocator& rhs)
+    {
+        m_alignment = rhs.m_alignment;
+        return *this;
+    }
+
+    bool operator==(const LargeAllocator<T>& rhs) const
+    {
+        return m_alignment == rhs.m_alignment;
+    }
+
+    template <typename U>
+    bool operator==(const LargeAllocator<U>& rhs) const
+    {
+        return false;
+    }
+
+    template <typename U>
+    bool operator!=(const LargeAllocator<U>& rhs) const
+    {
+        return !operator==(rhs);
+    }
+
+    pointer address(reference x) const
+    {
+        return &x;
+    }
+
+    const_pointer address(const_reference x) const
+    {
+        return &x;
+    }
+
+    pointer allocate(size_type n, const_pointer hint = nullptr)
+    {
+        if (n == 0)
+            return nullptr;
+
+        pointer p = static_cast<pointer>(large_malloc(n * sizeof(T), m_alignment));
+
+        if (p == nullptr)
+             throw std::bad_alloc();
+
+        return p;
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if (p)
+            large_free(p, n * sizeof(T));
+    }
+
+    size_type max_size() const
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    void construct(pointer p, const_reference x)
+    {
+        new(p) value_type(x);
+    }
+
+    void destroy(pointer p)
+    {
+        p->~value_type();
+    }
+
+  private:
+    // Allow allocators of different types to access each other private members.
+    template <typename>
+    friend class LargeAllocator;
+
+    size_t m_alignment;
+};
+
+// A partial specialization for the void value type is required for rebinding
+// to another, different value type.
+template <>
+class LargeAllocator<void>
+{
+  public:
+    typedef void                value_type;
+    typedef value_type*         pointer;
+    typedef const value_type*   const_pointer;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef LargeAllocator<U> other;
+    };
+
+    explicit LargeAllocator(const size_t alignment = 16)
+      : m_alignment(alignment)
+    {
+    }
+
+    template <typename U>
+    LargeAllocator(const LargeAllocator<U>& rhs)
+      : m_alignment(rhs.m_alignment)
+    {
+    }
+
+  private:
+    // Allow allocators of different types to access each other private members.
+    template <typename>
+    friend class LargeAllocator;
+
+    const size_t m_alignment;
+};
+
+}   // namespace foundation
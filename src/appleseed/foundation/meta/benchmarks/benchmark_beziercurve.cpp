@@ -0,0 +1,154 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/beziercurve.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/ray.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/sampling/mappings.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace foundation;
+
+BENCHMARK_SUITE(Foundation_Math_BezierCurveIntersector)
+{
+    //
+    // A synthetic fur groom: strands of degree-3 curves growing out of a unit
+    // sphere, grouped by four as they would be in the leaves of a curve tree.
+    //
+
+    struct Fixture
+    {
+        typedef BezierCurveIntersector<BezierCurve3f> IntersectorType;
+        typedef BezierCurvePacket<BezierCurve3f> PacketType;
+
+        static const size_t StrandCount = 4096;
+        static const size_t RayCount = 64;
+
+        std::vector<BezierCurve3f>  m_curves;
+        std::vector<PacketType>     m_packets;
+        std::vector<Ray3f>          m_rays;
+        std::vector<Matrix4f>       m_xfms;
+        size_t                      m_hits;
+
+        Fixture()
+          : m_hits(0)
+        {
+            MersenneTwister rng;
+
+            for (size_t i = 0; i < StrandCount; ++i)
+            {
+                // Strands are generated in root order so that consecutive strands are close to each other.
+                const Vector2f s(
+                    (i + rand_float2(rng)) / StrandCount,
+                    rand_float2(rng));
+                const Vector3f root = sample_sphere_uniform(Vector2f(s[0], s[1]));
+
+                Vector3f ctrl_pts[4];
+                ctrl_pts[0] = root;
+                for (size_t j = 1; j < 4; ++j)
+                {
+                    const Vector3f jitter(
+                        rand_float1(rng, -0.02f, 0.02f),
+                        rand_float1(rng, -0.02f, 0.02f),
+                        rand_float1(rng, -0.02f, 0.02f));
+                    ctrl_pts[j] = ctrl_pts[j - 1] + root * 0.1f + jitter;
+                }
+
+                m_curves.emplace_back(ctrl_pts, 0.005f, 1.0f, Color3f(1.0f));
+            }
+
+            for (size_t i = 0; i < StrandCount; i += PacketType::Size)
+            {
+                PacketType packet;
+                for (size_t j = 0; j < PacketType::Size; ++j)
+                    packet.set(j, m_curves[i + j]);
+                m_packets.push_back(packet);
+            }
+
+            for (size_t i = 0; i < RayCount; ++i)
+            {
+                const Vector2f s(rand_float2(rng), rand_float2(rng));
+                const Vector3f v = sample_sphere_uniform(s);
+                const Ray3f ray(v * 3.0f, -v);
+
+                Matrix4f xfm;
+                make_curve_projection_transform(xfm, ray);
+
+                m_rays.push_back(ray);
+                m_xfms.push_back(xfm);
+            }
+        }
+    };
+
+    BENCHMARK_CASE_F(Intersect_Scalar, Fixture)
+    {
+        for (size_t r = 0; r < RayCount; ++r)
+        {
+            float u, v, t = std::numeric_limits<float>::max();
+
+            for (size_t i = 0; i < StrandCount; ++i)
+            {
+                if (IntersectorType::intersect(m_curves[i], m_rays[r], m_xfms[r], u, v, t))
+                    ++m_hits;
+            }
+        }
+    }
+
+    BENCHMARK_CASE_F(Intersect_Packets, Fixture)
+    {
+        for (size_t r = 0; r < RayCount; ++r)
+        {
+            float u, v, t = std::numeric_limits<float>::max();
+
+            for (size_t p = 0, i = 0; p < m_packets.size(); ++p, i += PacketType::Size)
+            {
+                const size_t mask = m_packets[p].cull(m_xfms[r], t);
+
+                for (size_t j = 0; j < PacketType::Size; ++j)
+                {
+                    if ((mask & (size_t(1) << j)) == 0)
+                        continue;
+
+                    if (IntersectorType::intersect(m_curves[i + j], m_rays[r], m_xfms[r], u, v, t))
+                        ++m_hits;
+                }
+            }
+        }
+    }
+}
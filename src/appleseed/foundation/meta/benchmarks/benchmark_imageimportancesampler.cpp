@@ -31,11 +31,13 @@
 #include "foundation/image/image.h"
 #include "foundation/math/rng/distribution.h"
 #include "foundation/math/rng/xorshift32.h"
+#include "foundation/math/sampling/aliasimageimportancesampler.h"
 #include "foundation/math/sampling/imageimportancesampler.h"
 #include "foundation/math/vector.h"
 #include "foundation/utility/benchmark.h"
 
 // Standard headers.
+#include <cmath>
 #include <cstddef>
 #include <memory>
 
@@ -43,41 +45,127 @@ using namespace foundation;
 
 BENCHMARK_SUITE(Foundation_Math_Sampling_ImageImportanceSampler)
 {
-    struct Fixture
+    // A procedural 8K environment map: a dim sky with a small, very bright sun.
+    class SunAndSkyImageSampler
     {
-        typedef ImageImportanceSampler<ImageSampler::Payload, float> ImportanceSamplerType;
+      public:
+        struct Payload {};
 
-        std::unique_ptr<ImportanceSamplerType>   m_importance_sampler;
-        Xorshift32                               m_rng;
+        static const size_t Width = 8192;
+        static const size_t Height = 4096;
 
-        Vector2u                                 m_texel_coords_sum;
-        float                                    m_texel_prob_sum;
+        void sample(const size_t x, const size_t y, Payload& payload, float& importance) const
+        {
+            const float dx = static_cast<float>(x) - 5000.0f;
+            const float dy = static_cast<float>(y) - 1200.0f;
+            importance =
+                0.1f +
+                0.05f * std::sin(x * 0.01f) * std::sin(y * 0.013f) +
+                1000.0f * std::exp(-(dx * dx + dy * dy) / 50.0f);
+        }
+    };
+
+    template <typename ImportanceSampler>
+    struct SamplerFixtureBase
+    {
+        std::unique_ptr<ImportanceSampler>  m_importance_sampler;
+        Xorshift32                          m_rng;
 
-        Fixture()
+        Vector2u                            m_texel_coords_sum;
+        float                               m_texel_prob_sum;
+
+        SamplerFixtureBase()
           : m_texel_coords_sum(0, 0)
           , m_texel_prob_sum(0.0f)
+        {
+        }
+
+        void sample()
+        {
+            const Vector2f s = rand_vector2<Vector2f>(m_rng);
+
+            Vector2u texel_coords;
+            float texel_prob;
+            m_importance_sampler->sample(s, texel_coords.x, texel_coords.y, texel_prob);
+
+            m_texel_coords_sum += texel_coords;
+            m_texel_prob_sum += texel_prob;
+        }
+    };
+
+    template <typename ImportanceSampler>
+    struct FixtureBase
+      : public SamplerFixtureBase<ImportanceSampler>
+    {
+        std::unique_ptr<Image>              m_image;
+
+        FixtureBase()
         {
             GenericImageFileReader reader;
-            std::unique_ptr<Image> image(reader.read("unit tests/inputs/test_imageimportancesampler_doge2.exr"));
+            m_image.reset(reader.read("unit tests/inputs/test_imageimportancesampler_doge2.exr"));
+
+            const size_t width = m_image->properties().m_canvas_width;
+            const size_t height = m_image->properties().m_canvas_height;
+
+            this->m_importance_sampler.reset(new ImportanceSampler(width, height));
+            rebuild();
+        }
 
-            const size_t width = image->properties().m_canvas_width;
-            const size_t height = image->properties().m_canvas_height;
+        void rebuild()
+        {
+            ImageSampler sampler(*m_image.get());
+            this->m_importance_sampler->rebuild(sampler);
+        }
+    };
+
+    template <typename ImportanceSampler>
+    struct LargeImageFixtureBase
+      : public SamplerFixtureBase<ImportanceSampler>
+    {
+        LargeImageFixtureBase()
+        {
+            this->m_importance_sampler.reset(
+                new ImportanceSampler(
+                    SunAndSkyImageSampler::Width,
+                    SunAndSkyImageSampler::Height));
 
-            m_importance_sampler.reset(new ImportanceSamplerType(width, height));
-            ImageSampler sampler(*image.get());
-            m_importance_sampler->rebuild(sampler);
+            SunAndSkyImageSampler sampler;
+            this->m_importance_sampler->rebuild(sampler);
         }
     };
 
+    typedef FixtureBase<ImageImportanceSampler<ImageSampler::Payload, float>> Fixture;
+    typedef FixtureBase<AliasImageImportanceSampler<float>> AliasFixture;
+    typedef LargeImageFixtureBase<ImageImportanceSampler<SunAndSkyImageSampler::Payload, float>> LargeImageFixture;
+    typedef LargeImageFixtureBase<AliasImageImportanceSampler<float>> LargeImageAliasFixture;
+
+    BENCHMARK_CASE_F(Rebuild, Fixture)
+    {
+        rebuild();
+    }
+
+    BENCHMARK_CASE_F(Rebuild_Alias, AliasFixture)
+    {
+        rebuild();
+    }
+
     BENCHMARK_CASE_F(Sample, Fixture)
     {
-        const Vector2f s = rand_vector2<Vector2f>(m_rng);
+        sample();
+    }
+
+    BENCHMARK_CASE_F(Sample_Alias, AliasFixture)
+    {
+        sample();
+    }
 
-        Vector2u texel_coords;
-        float texel_prob;
-        m_importance_sampler->sample(s, texel_coords.x, texel_coords.y, texel_prob);
+    BENCHMARK_CASE_F(Sample_LargeImage, LargeImageFixture)
+    {
+        sample();
+    }
 
-        m_texel_coords_sum += texel_coords;
-        m_texel_prob_sum += texel_prob;
+    BENCHMARK_CASE_F(Sample_LargeImage_Alias, LargeImageAliasFixture)
+    {
+        sample();
     }
 }
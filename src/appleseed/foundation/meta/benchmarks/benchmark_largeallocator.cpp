@@ -0,0 +1,149 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/lcg.h"
+#include "foundation/memory/largeallocator.h"
+#include "foundation/memory/memory.h"
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+using namespace foundation;
+
+BENCHMARK_SUITE(Foundation_Memory_LargeAllocator)
+{
+    // Random traversal of a node array much larger than the last level cache and
+    // than the reach of the TLB with 4 KB pages, similar to the access pattern of
+    // incoherent rays traversing a large BVH. To measure throughput per socket,
+    // pin the benchmark to one socket (e.g. with numactl --cpunodebind).
+
+    struct Node
+    {
+        std::uint32_t   m_next;
+        std::uint8_t    m_payload[60];
+    };
+
+    const size_t NodeCount = 1024 * 1024;       // 64 MB
+    const size_t TraversalLength = 1000;
+
+    enum AllocationMode
+    {
+        AlignedMalloc,
+        LargeMalloc,
+        LargeMallocWithHugePages,
+        LargeMallocInterleaved
+    };
+
+    template <AllocationMode Mode>
+    struct Fixture
+    {
+        Node*           m_nodes;
+        std::uint32_t   m_current;
+
+        Fixture()
+          : m_current(0)
+        {
+            const size_t size = NodeCount * sizeof(Node);
+
+            if (Mode == AlignedMalloc)
+                m_nodes = static_cast<Node*>(aligned_malloc(size, 64));
+            else
+            {
+                const bool use_huge_pages = get_large_allocation_use_huge_pages();
+                const NUMAPolicy numa_policy = get_large_allocation_numa_policy();
+
+                set_large_allocation_policy(
+                    Mode != LargeMalloc,
+                    Mode == LargeMallocInterleaved ? NUMAPolicy::Interleave : NUMAPolicy::FirstTouch);
+
+                m_nodes = static_cast<Node*>(large_malloc(size, 64));
+
+                set_large_allocation_policy(use_huge_pages, numa_policy);
+            }
+
+            if (m_nodes == nullptr)
+                throw std::bad_alloc();
+
+            // Link all nodes in a single random cycle (Sattolo's algorithm).
+            for (size_t i = 0; i < NodeCount; ++i)
+                m_nodes[i].m_next = static_cast<std::uint32_t>(i);
+
+            LCG rng;
+
+            for (size_t i = NodeCount - 1; i > 0; --i)
+            {
+                const size_t j = rand_int1(rng, 0, static_cast<std::int32_t>(i) - 1);
+                std::swap(m_nodes[i].m_next, m_nodes[j].m_next);
+            }
+        }
+
+        ~Fixture()
+        {
+            if (Mode == AlignedMalloc)
+                aligned_free(m_nodes);
+            else large_free(m_nodes, NodeCount * sizeof(Node));
+        }
+
+        void traverse()
+        {
+            std::uint32_t current = m_current;
+
+            for (size_t i = 0; i < TraversalLength; ++i)
+                current = m_nodes[current].m_next;
+
+            m_current = current;
+        }
+    };
+
+    BENCHMARK_CASE_F(RandomTraversal_AlignedMalloc, Fixture<AlignedMalloc>)
+    {
+        traverse();
+    }
+
+    BENCHMARK_CASE_F(RandomTraversal_LargeMalloc, Fixture<LargeMalloc>)
+    {
+        traverse();
+    }
+
+    BENCHMARK_CASE_F(RandomTraversal_LargeMallocWithHugePages, Fixture<LargeMallocWithHugePages>)
+    {
+        traverse();
+    }
+
+    BENCHMARK_CASE_F(RandomTraversal_LargeMallocInterleaved, Fixture<LargeMallocInterleaved>)
+    {
+        traverse();
+    }
+}
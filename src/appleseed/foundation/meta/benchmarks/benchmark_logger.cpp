@@ -0,0 +1,109 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/log/ilogtarget.h"
+#include "foundation/log/logger.h"
+#include "foundation/log/logmessage.h"
+#include "foundation/log/openfilelogtarget.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/benchmark.h"
+
+// Boost headers.
+#include "boost/thread/thread.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <cstdio>
+
+using namespace foundation;
+
+BENCHMARK_SUITE(Foundation_Log_Logger)
+{
+    const size_t ThreadCount = 64;
+    const size_t MessagesPerThread = 256;
+
+    struct Fixture
+    {
+        std::FILE*      m_file;
+        ILogTarget*     m_target;
+        Logger          m_logger;
+
+        Fixture()
+          : m_file(std::tmpfile())
+          , m_target(create_open_file_log_target(m_file))
+        {
+            m_logger.add_target(m_target);
+        }
+
+        ~Fixture()
+        {
+            m_logger.set_asynchronous(false);
+            m_logger.remove_target(m_target);
+            m_target->release();
+            std::fclose(m_file);
+        }
+
+        void write_from_many_threads()
+        {
+            boost::thread_group threads;
+
+            for (size_t i = 0; i < ThreadCount; ++i)
+            {
+                threads.create_thread(
+                    [this, i]()
+                    {
+                        for (size_t j = 0; j < MessagesPerThread; ++j)
+                        {
+                            m_logger.write(
+                                LogMessage::Info,
+                                __FILE__,
+                                __LINE__,
+                                "thread " FMT_SIZE_T " loaded tile (" FMT_SIZE_T ", " FMT_SIZE_T ").",
+                                i, j % 16, j / 16);
+                        }
+                    });
+            }
+
+            threads.join_all();
+        }
+    };
+
+    BENCHMARK_CASE_F(Write_Synchronous_64Threads, Fixture)
+    {
+        write_from_many_threads();
+    }
+
+    BENCHMARK_CASE_F(Write_Asynchronous_64Threads, Fixture)
+    {
+        m_logger.set_asynchronous();
+        write_from_many_threads();
+        m_logger.flush();
+    }
+}
@@ -32,8 +32,12 @@
 #include "foundation/math/rng/distribution.h"
 #include "foundation/math/rng/lcg.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
 #include "foundation/utility/benchmark.h"
 
+// Standard headers.
+#include <cstddef>
+
 using namespace foundation;
 
 BENCHMARK_SUITE(Foundation_Math_Microfacet)
@@ -81,6 +85,126 @@ BENCHMARK_SUITE(Foundation_Math_Microfacet)
         }
     };
 
+    // Compares the throughput of the scalar and vectorized methods. Each call
+    // processes PacketCount packets of four directions generated upfront.
+    template <typename MDFType>
+    struct PacketFixtureBase
+    {
+        static const size_t PacketCount = 64;
+
+        Vector3fx4  m_outgoing[PacketCount];    // view directions, unit-length
+        Vector3fx4  m_normals[PacketCount];     // microfacet normals, unit-length
+        Vector2fx4  m_samples[PacketCount];
+        float       m_dummy;
+        Vector3f    m_dummy_vec;
+
+        PacketFixtureBase()
+          : m_dummy(0.0f)
+          , m_dummy_vec(0.0f)
+        {
+            LCG rng;
+
+            for (size_t i = 0; i < PacketCount; ++i)
+            {
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    const float x = rand_float2(rng);
+                    const float z = rand_float2(rng);
+                    m_outgoing[i].set(j, normalize(Vector3f(x - 0.5f, 0.5f, z - 0.5f)));
+                    m_normals[i].set(j, normalize(Vector3f(rand_float2(rng), 0.5f, rand_float2(rng))));
+                    m_samples[i].set(j, Vector2f(rand_float2(rng), rand_float2(rng)));
+                }
+            }
+        }
+
+        void sample_scalar(const float alpha_x, const float alpha_y)
+        {
+            for (size_t p = 0; p < PacketCount; ++p)
+            {
+                Vector3f m[4];
+
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    m[i] =
+                        MDFType::sample(
+                            m_outgoing[p].get(i),
+                            m_samples[p].get(i),
+                            alpha_x,
+                            alpha_y);
+                }
+
+                m_dummy_vec += (m[0] + m[1]) + (m[2] + m[3]);
+            }
+        }
+
+        void sample_vectorized(const float alpha_x, const float alpha_y)
+        {
+            for (size_t p = 0; p < PacketCount; ++p)
+            {
+                Vector3fx4 m;
+                MDFType::sample(m_outgoing[p], m_samples[p], alpha_x, alpha_y, m);
+
+                m_dummy_vec += (m.get(0) + m.get(1)) + (m.get(2) + m.get(3));
+            }
+        }
+
+        void evaluate_scalar(const float alpha_x, const float alpha_y)
+        {
+            for (size_t p = 0; p < PacketCount; ++p)
+            {
+                float values[4];
+
+                for (size_t i = 0; i < 4; ++i)
+                    values[i] = MDFType::D(m_normals[p].get(i), alpha_x, alpha_y);
+
+                m_dummy += (values[0] + values[1]) + (values[2] + values[3]);
+            }
+        }
+
+        void evaluate_vectorized(const float alpha_x, const float alpha_y)
+        {
+            for (size_t p = 0; p < PacketCount; ++p)
+            {
+                APPLESEED_SIMD4_ALIGN float values[4];
+                MDFType::D(m_normals[p], alpha_x, alpha_y, values);
+
+                m_dummy += (values[0] + values[1]) + (values[2] + values[3]);
+            }
+        }
+
+        void shadow_scalar(const float alpha_x, const float alpha_y)
+        {
+            for (size_t p = 0; p < PacketCount; ++p)
+            {
+                float values[4];
+
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    values[i] =
+                        MDFType::G(
+                            m_normals[p].get(i),
+                            m_outgoing[p].get(i),
+                            m_normals[p].get(i),
+                            alpha_x,
+                            alpha_y);
+                }
+
+                m_dummy += (values[0] + values[1]) + (values[2] + values[3]);
+            }
+        }
+
+        void shadow_vectorized(const float alpha_x, const float alpha_y)
+        {
+            for (size_t p = 0; p < PacketCount; ++p)
+            {
+                APPLESEED_SIMD4_ALIGN float values[4];
+                MDFType::G(m_normals[p], m_outgoing[p], m_normals[p], alpha_x, alpha_y, values);
+
+                m_dummy += (values[0] + values[1]) + (values[2] + values[3]);
+            }
+        }
+    };
+
     //
     // Blinn-Phong MDF.
     //
@@ -109,6 +233,66 @@ BENCHMARK_SUITE(Foundation_Math_Microfacet)
         evaluate(0.5f, 0.5f);
     }
 
+    BENCHMARK_CASE_F(BeckmannMDF_Sample4_Scalar, PacketFixtureBase<BeckmannMDF>)
+    {
+        sample_scalar(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Sample4_Vectorized, PacketFixtureBase<BeckmannMDF>)
+    {
+        sample_vectorized(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Evaluate4_Scalar, PacketFixtureBase<BeckmannMDF>)
+    {
+        evaluate_scalar(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Evaluate4_Vectorized, PacketFixtureBase<BeckmannMDF>)
+    {
+        evaluate_vectorized(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Shadow4_Scalar, PacketFixtureBase<BeckmannMDF>)
+    {
+        shadow_scalar(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Shadow4_Vectorized, PacketFixtureBase<BeckmannMDF>)
+    {
+        shadow_vectorized(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Sample4_Anisotropic_Scalar, PacketFixtureBase<BeckmannMDF>)
+    {
+        sample_scalar(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Sample4_Anisotropic_Vectorized, PacketFixtureBase<BeckmannMDF>)
+    {
+        sample_vectorized(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Evaluate4_Anisotropic_Scalar, PacketFixtureBase<BeckmannMDF>)
+    {
+        evaluate_scalar(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Evaluate4_Anisotropic_Vectorized, PacketFixtureBase<BeckmannMDF>)
+    {
+        evaluate_vectorized(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Shadow4_Anisotropic_Scalar, PacketFixtureBase<BeckmannMDF>)
+    {
+        shadow_scalar(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(BeckmannMDF_Shadow4_Anisotropic_Vectorized, PacketFixtureBase<BeckmannMDF>)
+    {
+        shadow_vectorized(0.25f, 0.5f);
+    }
+
     //
     // Ward MDF.
     //
@@ -136,4 +320,64 @@ BENCHMARK_SUITE(Foundation_Math_Microfacet)
     {
         evaluate(0.5f, 0.5f);
     }
+
+    BENCHMARK_CASE_F(GGXMDF_Sample4_Scalar, PacketFixtureBase<GGXMDF>)
+    {
+        sample_scalar(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Sample4_Vectorized, PacketFixtureBase<GGXMDF>)
+    {
+        sample_vectorized(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Evaluate4_Scalar, PacketFixtureBase<GGXMDF>)
+    {
+        evaluate_scalar(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Evaluate4_Vectorized, PacketFixtureBase<GGXMDF>)
+    {
+        evaluate_vectorized(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Shadow4_Scalar, PacketFixtureBase<GGXMDF>)
+    {
+        shadow_scalar(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Shadow4_Vectorized, PacketFixtureBase<GGXMDF>)
+    {
+        shadow_vectorized(0.5f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Sample4_Anisotropic_Scalar, PacketFixtureBase<GGXMDF>)
+    {
+        sample_scalar(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Sample4_Anisotropic_Vectorized, PacketFixtureBase<GGXMDF>)
+    {
+        sample_vectorized(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Evaluate4_Anisotropic_Scalar, PacketFixtureBase<GGXMDF>)
+    {
+        evaluate_scalar(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Evaluate4_Anisotropic_Vectorized, PacketFixtureBase<GGXMDF>)
+    {
+        evaluate_vectorized(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Shadow4_Anisotropic_Scalar, PacketFixtureBase<GGXMDF>)
+    {
+        shadow_scalar(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_Shadow4_Anisotropic_Vectorized, PacketFixtureBase<GGXMDF>)
+    {
+        shadow_vectorized(0.25f, 0.5f);
+    }
 }
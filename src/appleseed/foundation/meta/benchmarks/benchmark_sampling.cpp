@@ -28,6 +28,7 @@
 //
 
 // appleseed.foundation headers.
+#include "foundation/hash/hash.h"
 #include "foundation/math/rng/distribution.h"
 #include "foundation/math/rng/mersennetwister.h"
 #include "foundation/math/sampling/mappings.h"
@@ -38,6 +39,7 @@
 
 // Standard headers.
 #include <cstddef>
+#include <cstdint>
 
 using namespace foundation;
 
@@ -111,6 +113,97 @@ BENCHMARK_SUITE(Foundation_Math_Sampling_QMCSamplingContext)
             m_v += context.next2<Vector2d>();
         }
     }
+
+    BENCHMARK_CASE_F(BenchmarkTrajectory_SobolMode, SamplingContextFixture)
+    {
+        const size_t InitialInstance = 1234567;
+        QMCSamplingContext<RNG> context(
+            m_rng,
+            QMCSamplingContext<RNG>::SobolMode,
+            1,
+            InitialInstance,
+            InitialInstance);
+
+        for (size_t i = 0; i < 32; ++i)
+        {
+            context.split_in_place(2, 1);
+            m_v += context.next2<Vector2d>();
+        }
+    }
+}
+
+BENCHMARK_SUITE(Foundation_Math_Sampling_QMCSamplingContext_Convergence)
+{
+    // Render the pixels of the scene used by the convergence unit tests
+    // (Foundation_Math_Sampling_QMCSamplingContext_Convergence in test_sampling.cpp),
+    // which plot the RMS error of each mode against the number of samples per pixel.
+    struct Fixture
+    {
+        typedef MersenneTwister RNG;
+        typedef QMCSamplingContext<RNG> SamplingContext;
+
+        static const size_t PixelCount = 64;
+
+        RNG         m_rng;
+        double      m_value;
+
+        Fixture()
+          : m_value(0.0)
+        {
+        }
+
+        static double shade(SamplingContext& context)
+        {
+            const Vector2d pixel_sample = context.next2<Vector2d>();
+
+            SamplingContext child_context = context.split(2, 1);
+            const Vector2d light_sample = child_context.next2<Vector2d>();
+
+            const double visibility = pixel_sample.x < pixel_sample.y ? 1.0 : 0.0;
+            return visibility * (light_sample.x * light_sample.x + light_sample.y);
+        }
+
+        void render(const SamplingContext::Mode mode, const size_t sample_count)
+        {
+            for (size_t i = 0; i < PixelCount; ++i)
+            {
+                SamplingContext context(m_rng, mode, 2, 0, hash_uint32(static_cast<std::uint32_t>(i)));
+
+                for (size_t j = 0; j < sample_count; ++j)
+                    m_value += shade(context);
+            }
+        }
+    };
+
+    BENCHMARK_CASE_F(Render_RNGMode_16Samples, Fixture)
+    {
+        render(SamplingContext::RNGMode, 16);
+    }
+
+    BENCHMARK_CASE_F(Render_QMCMode_16Samples, Fixture)
+    {
+        render(SamplingContext::QMCMode, 16);
+    }
+
+    BENCHMARK_CASE_F(Render_SobolMode_16Samples, Fixture)
+    {
+        render(SamplingContext::SobolMode, 16);
+    }
+
+    BENCHMARK_CASE_F(Render_RNGMode_64Samples, Fixture)
+    {
+        render(SamplingContext::RNGMode, 64);
+    }
+
+    BENCHMARK_CASE_F(Render_QMCMode_64Samples, Fixture)
+    {
+        render(SamplingContext::QMCMode, 64);
+    }
+
+    BENCHMARK_CASE_F(Render_SobolMode_64Samples, Fixture)
+    {
+        render(SamplingContext::SobolMode, 64);
+    }
 }
 
 BENCHMARK_SUITE(Foundation_Math_Sampling_Mappings)
@@ -0,0 +1,248 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/math/qmc.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/sampling/aliasimageimportancesampler.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Math_Sampling_AliasImageImportanceSampler)
+{
+    class RandomImageSampler
+    {
+      public:
+        struct Payload {};
+
+        RandomImageSampler(const size_t width, const size_t height)
+          : m_width(width)
+        {
+            MersenneTwister rng;
+
+            for (size_t i = 0; i < width * height; ++i)
+            {
+                // Leave some pixels black.
+                const float value = rand_float1(rng);
+                m_values.push_back(value < 0.2f ? 0.0f : value);
+            }
+        }
+
+        void sample(const size_t x, const size_t y, Payload& payload, float& importance) const
+        {
+            importance = m_values[y * m_width + x];
+        }
+
+      private:
+        const size_t        m_width;
+        std::vector<float>  m_values;
+    };
+
+    struct UniformBlackImageSampler
+    {
+        struct Payload {};
+
+        void sample(const size_t x, const size_t y, Payload& payload, float& importance) const
+        {
+            importance = 0.0f;
+        }
+    };
+
+    typedef AliasImageImportanceSampler<float> ImportanceSamplerType;
+
+    TEST_CASE(GetPDF_ReturnsSameProbabilityAsSample)
+    {
+        const size_t Width = 7;
+        const size_t Height = 5;
+
+        ImportanceSamplerType importance_sampler(Width, Height);
+        RandomImageSampler sampler(Width, Height);
+        importance_sampler.rebuild(sampler);
+
+        MersenneTwister rng;
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            const Vector2f s = rand_vector2<Vector2f>(rng);
+
+            size_t x, y;
+            Vector2f offset;
+            float prob_xy;
+            importance_sampler.sample(s, x, y, offset, prob_xy);
+
+            ASSERT_LT(Width, x);
+            ASSERT_LT(Height, y);
+            EXPECT_GT(0.0f, prob_xy);
+            EXPECT_EQ(prob_xy, importance_sampler.get_pdf(x, y));
+            EXPECT_TRUE(offset[0] >= 0.0f && offset[0] < 1.0f);
+            EXPECT_TRUE(offset[1] >= 0.0f && offset[1] < 1.0f);
+        }
+    }
+
+    TEST_CASE(GetPDF_SumsToOne)
+    {
+        const size_t Width = 13;
+        const size_t Height = 6;
+
+        ImportanceSamplerType importance_sampler(Width, Height);
+        RandomImageSampler sampler(Width, Height);
+        importance_sampler.rebuild(sampler);
+
+        float sum = 0.0f;
+
+        for (size_t y = 0; y < Height; ++y)
+        {
+            for (size_t x = 0; x < Width; ++x)
+                sum += importance_sampler.get_pdf(x, y);
+        }
+
+        EXPECT_FEQ_EPS(1.0f, sum, 1.0e-5f);
+    }
+
+    TEST_CASE(Sample_FrequenciesMatchPDF)
+    {
+        const size_t Width = 9;
+        const size_t Height = 3;
+        const size_t SampleCount = 64 * 1024;
+
+        ImportanceSamplerType importance_sampler(Width, Height);
+        RandomImageSampler sampler(Width, Height);
+        importance_sampler.rebuild(sampler);
+
+        std::vector<size_t> histogram(Width * Height, 0);
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            const size_t Bases[1] = { 2 };
+            const Vector2f s = hammersley_sequence<float, 2>(Bases, SampleCount, i);
+
+            size_t x, y;
+            float prob_xy;
+            importance_sampler.sample(s, x, y, prob_xy);
+
+            ++histogram[y * Width + x];
+        }
+
+        for (size_t y = 0; y < Height; ++y)
+        {
+            for (size_t x = 0; x < Width; ++x)
+            {
+                const float frequency = static_cast<float>(histogram[y * Width + x]) / SampleCount;
+                EXPECT_FEQ_EPS(importance_sampler.get_pdf(x, y), frequency, 1.0e-2f);
+            }
+        }
+    }
+
+    TEST_CASE(Sample_GivenUniformBlackImage)
+    {
+        ImportanceSamplerType importance_sampler(2, 2);
+        UniformBlackImageSampler sampler;
+        importance_sampler.rebuild(sampler);
+
+        size_t x, y;
+        float prob_xy;
+        importance_sampler.sample(Vector2f(0.0f, 0.0f), x, y, prob_xy);
+
+        EXPECT_EQ(0, x);
+        EXPECT_EQ(0, y);
+        EXPECT_EQ(0.25f, prob_xy);
+    }
+
+    TEST_CASE(GetPDF_GivenUniformBlackImage)
+    {
+        ImportanceSamplerType importance_sampler(2, 2);
+        UniformBlackImageSampler sampler;
+        importance_sampler.rebuild(sampler);
+
+        const float pdf = importance_sampler.get_pdf(0, 1);
+
+        EXPECT_EQ(0.25f, pdf);
+    }
+
+    TEST_CASE(Read_GivenWrittenProbabilities_RestoresSameDistribution)
+    {
+        const size_t Width = 6;
+        const size_t Height = 11;
+
+        ImportanceSamplerType importance_sampler(Width, Height);
+        RandomImageSampler sampler(Width, Height);
+        importance_sampler.rebuild(sampler);
+
+        std::stringstream stream;
+        importance_sampler.write(stream);
+
+        ImportanceSamplerType restored_importance_sampler(Width, Height);
+        ASSERT_TRUE(restored_importance_sampler.read(stream));
+
+        for (size_t y = 0; y < Height; ++y)
+        {
+            for (size_t x = 0; x < Width; ++x)
+                EXPECT_FEQ(importance_sampler.get_pdf(x, y), restored_importance_sampler.get_pdf(x, y));
+        }
+    }
+
+    TEST_CASE(Read_GivenMismatchedDimensions_ReturnsFalse)
+    {
+        ImportanceSamplerType importance_sampler(4, 4);
+        RandomImageSampler sampler(4, 4);
+        importance_sampler.rebuild(sampler);
+
+        std::stringstream stream;
+        importance_sampler.write(stream);
+
+        ImportanceSamplerType other_importance_sampler(4, 5);
+
+        EXPECT_FALSE(other_importance_sampler.read(stream));
+    }
+
+    TEST_CASE(Read_GivenTruncatedStream_ReturnsFalse)
+    {
+        ImportanceSamplerType importance_sampler(4, 4);
+        RandomImageSampler sampler(4, 4);
+        importance_sampler.rebuild(sampler);
+
+        std::stringstream stream;
+        importance_sampler.write(stream);
+
+        std::stringstream truncated_stream(stream.str().substr(0, stream.str().size() - 1));
+
+        ImportanceSamplerType other_importance_sampler(4, 4);
+
+        EXPECT_FALSE(other_importance_sampler.read(truncated_stream));
+    }
+}
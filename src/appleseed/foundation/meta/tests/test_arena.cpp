@@ -0,0 +1,125 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/memory/arena.h"
+#include "foundation/memory/memory.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Memory_Arena)
+{
+    TEST_CASE(Allocate_ReturnsAlignedPointers)
+    {
+        Arena arena;
+
+        void* p1 = arena.allocate(3);
+        void* p2 = arena.allocate(17);
+
+        EXPECT_TRUE(is_aligned(p1, 16));
+        EXPECT_TRUE(is_aligned(p2, 16));
+        EXPECT_EQ(static_cast<std::uint8_t*>(p1) + 16, p2);
+    }
+
+    TEST_CASE(Allocate_GivenMoreDataThanOneBlock_ChainsBlocks)
+    {
+        Arena arena;
+
+        const size_t ChunkSize = 1024;
+        const size_t ChunkCount = 3 * Arena::BlockSize / ChunkSize;
+
+        for (size_t i = 0; i < ChunkCount; ++i)
+            std::memset(arena.allocate(ChunkSize), 0xFF, ChunkSize);
+
+        EXPECT_EQ(3, arena.get_block_count());
+        EXPECT_EQ(ChunkCount * ChunkSize, arena.get_size());
+    }
+
+    TEST_CASE(Allocate_GivenSizeLargerThanBlock_Succeeds)
+    {
+        Arena arena;
+
+        const size_t Size = 2 * Arena::BlockSize + 1;
+        void* ptr = arena.allocate(Size);
+        std::memset(ptr, 0xFF, Size);
+
+        EXPECT_TRUE(is_aligned(ptr, 16));
+        EXPECT_EQ(1, arena.get_block_count());
+    }
+
+    TEST_CASE(Clear_ReusesBlocks)
+    {
+        Arena arena;
+
+        void* first = arena.allocate(Arena::BlockSize);
+        arena.allocate(Arena::BlockSize);
+
+        arena.clear();
+
+        EXPECT_EQ(first, arena.allocate(Arena::BlockSize));
+        arena.allocate(Arena::BlockSize);
+        EXPECT_EQ(2, arena.get_block_count());
+    }
+
+    TEST_CASE(GetPeakSize_AfterClear_ReturnsHighWaterMark)
+    {
+        Arena arena;
+
+        arena.allocate(Arena::BlockSize);
+        arena.allocate(Arena::BlockSize);
+        arena.clear();
+        arena.allocate(16);
+
+        EXPECT_EQ(16, arena.get_size());
+        EXPECT_EQ(2 * Arena::BlockSize, arena.get_peak_size());
+
+        arena.reset_peak_size();
+
+        EXPECT_EQ(16, arena.get_peak_size());
+    }
+
+    TEST_CASE(Destructor_ReturnsBlocksToFreeListOfThread)
+    {
+        void* ptr;
+
+        {
+            Arena arena;
+            ptr = arena.allocate(16);
+        }
+
+        Arena arena;
+        EXPECT_EQ(ptr, arena.allocate(16));
+    }
+}
@@ -34,6 +34,9 @@
 #include "foundation/math/beziercurve.h"
 #include "foundation/math/matrix.h"
 #include "foundation/math/ray.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/sampling/mappings.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/utility/countof.h"
@@ -729,3 +732,93 @@ TEST_SUITE(Foundation_Math_BezierCurveIntersector)
         render_curves_to_image(Curves, countof(Curves), "unit tests/outputs/test_beziercurveintersector_bezier3curve_checkboard.png", true);
     }
 }
+
+TEST_SUITE(Foundation_Math_BezierCurvePacket)
+{
+    TEST_CASE(Cull_GivenEmptyPacket_ReturnsEmptyMask)
+    {
+        const BezierCurvePacket<BezierCurve1f> packet;
+
+        const Ray3f ray(Vector3f(0.0f, 0.0f, -3.0f), Vector3f(0.0f, 0.0f, 1.0f));
+
+        Matrix4f xfm_matrix;
+        make_curve_projection_transform(xfm_matrix, ray);
+
+        EXPECT_EQ(0, packet.cull(xfm_matrix, std::numeric_limits<float>::max()));
+    }
+
+    TEST_CASE(Cull_GivenCurvesOnAndOffRay_ReturnsMaskOfCurvesOnRay)
+    {
+        const Vector3f ControlPoints1[] = { Vector3f(-0.5f, -0.5f, 0.0f), Vector3f(0.5f, 0.5f, 0.0f) };
+        const Vector3f ControlPoints2[] = { Vector3f(1.5f, 1.5f, 0.0f), Vector3f(2.5f, 2.5f, 0.0f) };
+        const Vector3f ControlPoints3[] = { Vector3f(-0.5f, 0.5f, 0.0f), Vector3f(0.5f, -0.5f, 0.0f) };
+
+        BezierCurvePacket<BezierCurve1f> packet;
+        packet.set(0, BezierCurve1f(ControlPoints1, 0.06f, 1.0f, Color3f(1.0f)));
+        packet.set(1, BezierCurve1f(ControlPoints2, 0.06f, 1.0f, Color3f(1.0f)));
+        packet.set(2, BezierCurve1f(ControlPoints3, 0.06f, 1.0f, Color3f(1.0f)));
+
+        const Ray3f ray(Vector3f(0.0f, 0.0f, -3.0f), Vector3f(0.0f, 0.0f, 1.0f));
+
+        Matrix4f xfm_matrix;
+        make_curve_projection_transform(xfm_matrix, ray);
+
+        EXPECT_EQ(5, packet.cull(xfm_matrix, std::numeric_limits<float>::max()));
+    }
+
+    TEST_CASE(Cull_GivenCurveBeyondRayExtent_ReturnsEmptyMask)
+    {
+        const Vector3f ControlPoints[] = { Vector3f(-0.5f, -0.5f, 0.0f), Vector3f(0.5f, 0.5f, 0.0f) };
+
+        BezierCurvePacket<BezierCurve1f> packet;
+        packet.set(0, BezierCurve1f(ControlPoints, 0.06f, 1.0f, Color3f(1.0f)));
+
+        const Ray3f ray(Vector3f(0.0f, 0.0f, -3.0f), Vector3f(0.0f, 0.0f, 1.0f));
+
+        Matrix4f xfm_matrix;
+        make_curve_projection_transform(xfm_matrix, ray);
+
+        EXPECT_EQ(0, packet.cull(xfm_matrix, 2.0f));
+    }
+
+    TEST_CASE(Cull_GivenRandomCurvesAndRays_NeverCullsIntersectedCurves)
+    {
+        MersenneTwister rng;
+
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            BezierCurve3f curves[4];
+            BezierCurvePacket<BezierCurve3f> packet;
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                Vector3f ctrl_pts[4];
+                for (size_t k = 0; k < 4; ++k)
+                {
+                    ctrl_pts[k] =
+                        Vector3f(
+                            rand_float1(rng, -1.0f, 1.0f),
+                            rand_float1(rng, -1.0f, 1.0f),
+                            rand_float1(rng, -1.0f, 1.0f));
+                }
+
+                curves[j] = BezierCurve3f(ctrl_pts, 0.1f, 1.0f, Color3f(1.0f));
+                packet.set(j, curves[j]);
+            }
+
+            const Vector3f dir = sample_sphere_uniform(Vector2f(rand_float2(rng), rand_float2(rng)));
+            const Ray3f ray(dir * -3.0f, dir);
+
+            Matrix4f xfm_matrix;
+            make_curve_projection_transform(xfm_matrix, ray);
+
+            const size_t mask = packet.cull(xfm_matrix, std::numeric_limits<float>::max());
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                if (BezierCurveIntersector<BezierCurve3f>::intersect(curves[j], ray, xfm_matrix))
+                    EXPECT_NEQ(0, mask & (size_t(1) << j));
+            }
+        }
+    }
+}
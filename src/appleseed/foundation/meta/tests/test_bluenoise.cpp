@@ -0,0 +1,91 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/math/bluenoise.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Math_BlueNoise)
+{
+    TEST_CASE(BlueNoiseMask_IsAPermutationOfRanks)
+    {
+        const size_t TexelCount = BlueNoiseMaskSize * BlueNoiseMaskSize;
+
+        std::vector<bool> used(TexelCount, false);
+
+        for (size_t i = 0; i < TexelCount; ++i)
+        {
+            ASSERT_LT(TexelCount, BlueNoiseMask[i]);
+            EXPECT_FALSE(used[BlueNoiseMask[i]]);
+            used[BlueNoiseMask[i]] = true;
+        }
+    }
+
+    TEST_CASE(BlueNoise_ReturnsValuesInOpenUnitInterval)
+    {
+        for (size_t y = 0; y < BlueNoiseMaskSize; ++y)
+        {
+            for (size_t x = 0; x < BlueNoiseMaskSize; ++x)
+            {
+                const float value = blue_noise<float>(x, y);
+                EXPECT_LT(1.0f, value);
+                EXPECT_GT(0.0f, value);
+            }
+        }
+    }
+
+    TEST_CASE(BlueNoise_IsTileable)
+    {
+        EXPECT_EQ(blue_noise<double>(3, 5), blue_noise<double>(3 + BlueNoiseMaskSize, 5));
+        EXPECT_EQ(blue_noise<double>(3, 5), blue_noise<double>(3, 5 + 2 * BlueNoiseMaskSize));
+    }
+
+    TEST_CASE(BlueNoise_NeighboringTexelsAreDissimilar)
+    {
+        // Unlike white noise, blue noise has little low-frequency energy:
+        // the mean absolute difference between horizontal neighbors is above 1/3.
+        double sum = 0.0;
+
+        for (size_t y = 0; y < BlueNoiseMaskSize; ++y)
+        {
+            for (size_t x = 0; x < BlueNoiseMaskSize; ++x)
+            {
+                const double d = blue_noise<double>(x + 1, y) - blue_noise<double>(x, y);
+                sum += d < 0.0 ? -d : d;
+            }
+        }
+
+        EXPECT_GT(0.37, sum / (BlueNoiseMaskSize * BlueNoiseMaskSize));
+    }
+}
@@ -0,0 +1,143 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/containers/alignedvector.h"
+#include "foundation/memory/largeallocator.h"
+#include "foundation/memory/memory.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Memory_LargeAllocator)
+{
+    struct RestorePolicy
+    {
+        const bool          m_use_huge_pages;
+        const NUMAPolicy    m_numa_policy;
+
+        RestorePolicy()
+          : m_use_huge_pages(get_large_allocation_use_huge_pages())
+          , m_numa_policy(get_large_allocation_numa_policy())
+        {
+        }
+
+        ~RestorePolicy()
+        {
+            set_large_allocation_policy(m_use_huge_pages, m_numa_policy);
+        }
+    };
+
+    bool is_zero(const std::uint8_t* ptr, const size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (ptr[i] != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    TEST_CASE(GetNUMANodeCount_ReturnsAtLeastOne)
+    {
+        EXPECT_GT(0, get_numa_node_count());
+    }
+
+    TEST_CASE(LargeMalloc_GivenSmallSize_ReturnsAlignedBlock)
+    {
+        const size_t Size = 1000;
+
+        void* ptr = large_malloc(Size, 64);
+
+        ASSERT_NEQ(nullptr, ptr);
+        EXPECT_TRUE(is_aligned(ptr, 64));
+
+        std::memset(ptr, 0xFF, Size);
+        large_free(ptr, Size);
+    }
+
+    TEST_CASE(LargeMalloc_GivenLargeSize_ReturnsAlignedZeroInitializedBlock)
+    {
+        const size_t Size = 3 * LargeAllocationThreshold + 1;
+
+        std::uint8_t* ptr = static_cast<std::uint8_t*>(large_malloc(Size, 64));
+
+        ASSERT_NEQ(nullptr, ptr);
+        EXPECT_TRUE(is_aligned(ptr, 64));
+        EXPECT_TRUE(is_zero(ptr, Size));
+
+        std::memset(ptr, 0xFF, Size);
+        large_free(ptr, Size);
+    }
+
+    TEST_CASE_F(LargeMalloc_WithoutHugePagesAndInterleavedPlacement_ReturnsWritableBlock, RestorePolicy)
+    {
+        set_large_allocation_policy(false, NUMAPolicy::Interleave);
+
+        const size_t Size = 2 * LargeAllocationThreshold;
+
+        std::uint8_t* ptr = static_cast<std::uint8_t*>(large_malloc(Size, 16));
+
+        ASSERT_NEQ(nullptr, ptr);
+        EXPECT_TRUE(is_zero(ptr, Size));
+
+        std::memset(ptr, 0xFF, Size);
+        EXPECT_EQ(0xFF, ptr[Size - 1]);
+
+        large_free(ptr, Size);
+    }
+
+    TEST_CASE(AlignedVector_UsingLargeAllocator_PreservesElementsWhenGrowingPastThreshold)
+    {
+        AlignedVector<std::uint32_t, LargeAllocator> v;
+
+        const size_t Count = 2 * LargeAllocationThreshold / sizeof(std::uint32_t);
+
+        for (size_t i = 0; i < Count; ++i)
+            v.push_back(static_cast<std::uint32_t>(i));
+
+        ASSERT_EQ(Count, v.size());
+
+        bool ok = true;
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            if (v[i] != static_cast<std::uint32_t>(i))
+                ok = false;
+        }
+
+        EXPECT_TRUE(ok);
+    }
+}
@@ -0,0 +1,197 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/log/logger.h"
+#include "foundation/log/logmessage.h"
+#include "foundation/log/stringlogtarget.h"
+#include "foundation/string/string.h"
+#include "foundation/memory/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+// Boost headers.
+#include "boost/thread/thread.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Log_Logger)
+{
+    struct Fixture
+    {
+        Logger                              m_logger;
+        auto_release_ptr<StringLogTarget>   m_target;
+
+        Fixture()
+          : m_target(create_string_log_target())
+        {
+            m_logger.set_all_formats("{message}");
+            m_logger.add_target(m_target.get());
+        }
+
+        ~Fixture()
+        {
+            m_logger.set_asynchronous(false);
+            m_logger.remove_target(m_target.get());
+        }
+
+        std::vector<std::string> get_lines() const
+        {
+            std::vector<std::string> lines;
+            split(m_target->get_string(), "\n", lines);
+
+            if (!lines.empty() && lines.back().empty())
+                lines.pop_back();
+
+            return lines;
+        }
+    };
+
+    TEST_CASE_F(Write_Synchronous_WritesMessageImmediately, Fixture)
+    {
+        m_logger.write(LogMessage::Info, __FILE__, __LINE__, "hello %d", 42);
+
+        EXPECT_EQ("hello 42\n", std::string(m_target->get_string()));
+    }
+
+    TEST_CASE_F(Flush_Asynchronous_WritesQueuedMessages, Fixture)
+    {
+        m_logger.set_asynchronous();
+
+        m_logger.write(LogMessage::Info, __FILE__, __LINE__, "hello %d", 42);
+        m_logger.flush();
+
+        EXPECT_EQ("hello 42\n", std::string(m_target->get_string()));
+    }
+
+    TEST_CASE_F(Write_Asynchronous_PreservesOrderOfMessagesFromOneThread, Fixture)
+    {
+        m_logger.set_asynchronous();
+
+        for (size_t i = 0; i < 100; ++i)
+            m_logger.write(LogMessage::Info, __FILE__, __LINE__, "%s", to_string(i).c_str());
+
+        m_logger.flush();
+
+        const std::vector<std::string> lines = get_lines();
+        ASSERT_EQ(100, lines.size());
+
+        for (size_t i = 0; i < 100; ++i)
+            EXPECT_EQ(to_string(i), lines[i]);
+    }
+
+    TEST_CASE_F(Write_Asynchronous_HonorsVerbosityLevel, Fixture)
+    {
+        m_logger.set_asynchronous();
+        m_logger.set_verbosity_level(LogMessage::Warning);
+
+        m_logger.write(LogMessage::Info, __FILE__, __LINE__, "info");
+        m_logger.write(LogMessage::Warning, __FILE__, __LINE__, "warning");
+        m_logger.flush();
+
+        EXPECT_EQ("warning\n", std::string(m_target->get_string()));
+    }
+
+    TEST_CASE_F(Write_AsynchronousFromManyThreads_WritesAllMessages, Fixture)
+    {
+        const size_t ThreadCount = 8;
+        const size_t MessageCount = 1000;
+
+        m_logger.set_asynchronous();
+
+        boost::thread_group threads;
+
+        for (size_t i = 0; i < ThreadCount; ++i)
+        {
+            threads.create_thread(
+                [this]()
+                {
+                    for (size_t j = 0; j < MessageCount; ++j)
+                        m_logger.write(LogMessage::Info, __FILE__, __LINE__, "message");
+                });
+        }
+
+        threads.join_all();
+        m_logger.flush();
+
+        const size_t written_count = get_lines().size();
+        EXPECT_EQ(ThreadCount * MessageCount, written_count + m_logger.get_dropped_message_count());
+    }
+
+    TEST_CASE_F(Write_AsynchronousWithFullQueue_DropsInfoMessagesButKeepsWarnings, Fixture)
+    {
+        m_logger.set_asynchronous();
+        m_logger.set_max_queued_size(0);
+
+        m_logger.write(LogMessage::Info, __FILE__, __LINE__, "info");
+        m_logger.write(LogMessage::Warning, __FILE__, __LINE__, "warning");
+        m_logger.flush();
+
+        EXPECT_EQ(1, m_logger.get_dropped_message_count());
+
+        const std::vector<std::string> lines = get_lines();
+        ASSERT_EQ(2, lines.size());
+        EXPECT_TRUE(starts_with(lines[0], "the log queue was full"));
+        EXPECT_EQ("warning", lines[1]);
+    }
+
+    TEST_CASE_F(Write_AsynchronousWithFullQueue_WritesWarningsAfterQueuedMessages, Fixture)
+    {
+        m_logger.set_asynchronous();
+
+        for (size_t i = 0; i < 10; ++i)
+            m_logger.write(LogMessage::Info, __FILE__, __LINE__, "%s", to_string(i).c_str());
+
+        m_logger.set_max_queued_size(0);
+        m_logger.write(LogMessage::Warning, __FILE__, __LINE__, "warning");
+        m_logger.flush();
+
+        const std::vector<std::string> lines = get_lines();
+        ASSERT_EQ(11, lines.size());
+
+        for (size_t i = 0; i < 10; ++i)
+            EXPECT_EQ(to_string(i), lines[i]);
+
+        EXPECT_EQ("warning", lines[10]);
+    }
+
+    TEST_CASE_F(SetAsynchronous_False_WritesQueuedMessages, Fixture)
+    {
+        m_logger.set_asynchronous();
+        m_logger.write(LogMessage::Info, __FILE__, __LINE__, "hello");
+        m_logger.set_asynchronous(false);
+
+        EXPECT_FALSE(m_logger.is_asynchronous());
+        EXPECT_EQ("hello\n", std::string(m_target->get_string()));
+    }
+}
@@ -235,6 +235,75 @@ TEST_SUITE(Foundation_Math_Microfacet)
     } while (false)
 
 
+    //
+    // Comparison of the vectorized methods against the scalar ones.
+    //
+
+    template <typename MDF>
+    bool vectorized_methods_match_scalar_methods(
+        const float   alpha_x,
+        const float   alpha_y,
+        const size_t  sample_count,
+        const float   eps)
+    {
+        for (size_t i = 0; i < sample_count; i += 4)
+        {
+            Vector3fx4 v, m;
+            Vector2fx4 s;
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                static const size_t Bases[] = { 2, 3, 5, 7, 11 };
+                const Vector<float, 6> q = hammersley_sequence<float, 6>(Bases, sample_count, i + j);
+
+                v.set(j, sample_sphere_uniform(Vector2f(q[0], q[1])));
+                m.set(j, sample_hemisphere_uniform(Vector2f(q[2], q[3])));
+                s.set(j, Vector2f(q[4], q[5]));
+            }
+
+            if (i == 0)
+            {
+                // Grazing angle and normal incidence.
+                m.set(0, Vector3f(1.0f, 0.0f, 0.0f));
+                m.set(1, Vector3f(0.0f, 1.0f, 0.0f));
+                v.set(2, Vector3f(0.0f, 0.0f, 1.0f));
+                v.set(3, Vector3f(0.0f, 1.0f, 0.0f));
+            }
+
+            APPLESEED_SIMD4_ALIGN float D[4];
+            APPLESEED_SIMD4_ALIGN float G[4];
+            APPLESEED_SIMD4_ALIGN float G1[4];
+            Vector3fx4 h;
+
+            MDF::D(m, alpha_x, alpha_y, D);
+            MDF::G(v, m, m, alpha_x, alpha_y, G);
+            MDF::G1(v, m, alpha_x, alpha_y, G1);
+            MDF::sample(v, s, alpha_x, alpha_y, h);
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                if (!feq(MDF::D(m.get(j), alpha_x, alpha_y), D[j], eps))
+                    return false;
+
+                if (!feq(MDF::G(v.get(j), m.get(j), m.get(j), alpha_x, alpha_y), G[j], eps))
+                    return false;
+
+                if (!feq(MDF::G1(v.get(j), m.get(j), alpha_x, alpha_y), G1[j], eps))
+                    return false;
+
+                const Vector3f expected_h = MDF::sample(v.get(j), s.get(j), alpha_x, alpha_y);
+
+                if (!fz(expected_h.x - h.x[j], eps) ||
+                    !fz(expected_h.y - h.y[j], eps) ||
+                    !fz(expected_h.z - h.z[j], eps))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+
     //
     // Test settings.
     //
@@ -245,6 +314,8 @@ TEST_SUITE(Foundation_Math_Microfacet)
     const size_t WeakWhiteFurnaceRuns = 128;
     const float WeakWhiteFurnaceAngleStep = 0.0125f;
     const float WeakWhiteFurnaceEps = 0.05f;
+    const size_t VectorizationTestSampleCount = 1024;
+    const float VectorizationEps = 1.0e-3f;
 
 
     //
@@ -330,6 +401,26 @@ TEST_SUITE(Foundation_Math_Microfacet)
         EXPECT_WEAK_WHITE_FURNACE_PASS(result);
     }
 
+    TEST_CASE(BeckmannMDF_Vectorized_Isotropic_MatchesScalar)
+    {
+        EXPECT_TRUE(
+            vectorized_methods_match_scalar_methods<BeckmannMDF>(
+                0.35f,
+                0.35f,
+                VectorizationTestSampleCount,
+                VectorizationEps));
+    }
+
+    TEST_CASE(BeckmannMDF_Vectorized_Anisotropic_MatchesScalar)
+    {
+        EXPECT_TRUE(
+            vectorized_methods_match_scalar_methods<BeckmannMDF>(
+                0.25f,
+                0.5f,
+                VectorizationTestSampleCount,
+                VectorizationEps));
+    }
+
 
     //
     // GGX MDF.
@@ -389,6 +480,26 @@ TEST_SUITE(Foundation_Math_Microfacet)
         EXPECT_WEAK_WHITE_FURNACE_PASS(result);
     }
 
+    TEST_CASE(GGXMDF_Vectorized_Isotropic_MatchesScalar)
+    {
+        EXPECT_TRUE(
+            vectorized_methods_match_scalar_methods<GGXMDF>(
+                0.35f,
+                0.35f,
+                VectorizationTestSampleCount,
+                VectorizationEps));
+    }
+
+    TEST_CASE(GGXMDF_Vectorized_Anisotropic_MatchesScalar)
+    {
+        EXPECT_TRUE(
+            vectorized_methods_match_scalar_methods<GGXMDF>(
+                0.25f,
+                0.5f,
+                VectorizationTestSampleCount,
+                VectorizationEps));
+    }
+
 
     //
     // Ward MDF.
@@ -0,0 +1,143 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/image/mipmap.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Image_MipMap)
+{
+    TEST_CASE(GenerateMipLevelTile_Given4x2Tile_AveragesEach2x2Block)
+    {
+        Image source(4, 2, 4, 2, 1, PixelFormatFloat);
+        for (size_t x = 0; x < 4; ++x)
+        {
+            source.tile(0, 0).set_component(x, 0, 0, static_cast<float>(x));
+            source.tile(0, 0).set_component(x, 1, 0, static_cast<float>(x + 4));
+        }
+
+        const CanvasProperties level_props(2, 1, 2, 1, 1, PixelFormatFloat);
+        ImageTileAccessor accessor(source);
+        const std::unique_ptr<Tile> tile(
+            generate_mip_level_tile(accessor, source.properties(), level_props, 0, 0));
+
+        EXPECT_EQ(2, tile->get_width());
+        EXPECT_EQ(1, tile->get_height());
+        EXPECT_FEQ(2.5f, tile->get_component<float>(0, 0, 0));        // (0 + 1 + 4 + 5) / 4
+        EXPECT_FEQ(4.5f, tile->get_component<float>(1, 0, 0));        // (2 + 3 + 6 + 7) / 4
+    }
+
+    TEST_CASE(GenerateMipLevelTile_Given3x1Image_FoldsLastColumnIntoLastPixel)
+    {
+        Image source(3, 1, 3, 1, 1, PixelFormatFloat);
+        source.tile(0, 0).set_component(0, 0, 0, 1.0f);
+        source.tile(0, 0).set_component(1, 0, 0, 2.0f);
+        source.tile(0, 0).set_component(2, 0, 0, 6.0f);
+
+        const CanvasProperties level_props(1, 1, 1, 1, 1, PixelFormatFloat);
+        ImageTileAccessor accessor(source);
+        const std::unique_ptr<Tile> tile(
+            generate_mip_level_tile(accessor, source.properties(), level_props, 0, 0));
+
+        EXPECT_FEQ(3.0f, tile->get_component<float>(0, 0, 0));
+    }
+
+    TEST_CASE(GenerateMipLevel_Given37x23ImageWith8x8Tiles_MatchesBruteForceBoxFilter)
+    {
+        const size_t Width = 37;
+        const size_t Height = 23;
+        const size_t ChannelCount = 3;
+        const size_t TileSize = 8;
+
+        Image source(Width, Height, TileSize, TileSize, ChannelCount, PixelFormatFloat);
+        for (size_t y = 0; y < Height; ++y)
+        {
+            for (size_t x = 0; x < Width; ++x)
+            {
+                for (size_t c = 0; c < ChannelCount; ++c)
+                {
+                    source.tile(x / TileSize, y / TileSize).set_component(
+                        x % TileSize, y % TileSize, c,
+                        static_cast<float>((x * 7 + y * 13 + c * 5) % 17));
+                }
+            }
+        }
+
+        const size_t level_width = Width / 2;
+        const size_t level_height = Height / 2;
+        const CanvasProperties level_props(level_width, level_height, TileSize, TileSize, ChannelCount, PixelFormatFloat);
+        ImageTileAccessor accessor(source);
+        const std::unique_ptr<Image> level(generate_mip_level(accessor, source.properties(), level_props));
+
+        // Each level pixel is the average of all the source pixels that map to it.
+        for (size_t y = 0; y < level_height; ++y)
+        {
+            for (size_t x = 0; x < level_width; ++x)
+            {
+                for (size_t c = 0; c < ChannelCount; ++c)
+                {
+                    float sum = 0.0f;
+                    size_t count = 0;
+
+                    for (size_t sy = 0; sy < Height; ++sy)
+                    {
+                        for (size_t sx = 0; sx < Width; ++sx)
+                        {
+                            if (std::min(sx / 2, level_width - 1) == x &&
+                                std::min(sy / 2, level_height - 1) == y)
+                            {
+                                sum += source.tile(sx / TileSize, sy / TileSize).get_component<float>(
+                                    sx % TileSize, sy % TileSize, c);
+                                ++count;
+                            }
+                        }
+                    }
+
+                    const float value =
+                        level->tile(x / TileSize, y / TileSize).get_component<float>(
+                            x % TileSize, y % TileSize, c);
+
+                    EXPECT_FEQ(sum / count, value);
+                }
+            }
+        }
+    }
+}
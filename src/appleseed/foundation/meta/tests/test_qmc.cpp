@@ -28,6 +28,7 @@
 //
 
 // appleseed.foundation headers.
+#include "foundation/hash/hash.h"
 #include "foundation/image/color.h"
 #include "foundation/image/genericimagefilewriter.h"
 #include "foundation/image/image.h"
@@ -49,6 +50,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -211,6 +213,108 @@ TEST_SUITE(Foundation_Math_QMC)
         EXPECT_FEQ(7.0 / 9, permuted_radical_inverse<double>(3, Perm, 7));
     }
 
+    TEST_CASE(ReverseBitsUint32)
+    {
+        EXPECT_EQ(0x00000000u, reverse_bits_uint32(0x00000000u));
+        EXPECT_EQ(0x80000000u, reverse_bits_uint32(0x00000001u));
+        EXPECT_EQ(0x0000000Fu, reverse_bits_uint32(0xF0000000u));
+        EXPECT_EQ(0x48D159E2u, reverse_bits_uint32(0x479A8B12u));
+    }
+
+    TEST_CASE(SobolUint32_FirstDimension_MatchesRadicalInverseBase2)
+    {
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            EXPECT_EQ(reverse_bits_uint32(i), sobol_uint32(0, i));
+    }
+
+    TEST_CASE(SobolUint32_SecondDimension_ReturnsExpectedValues)
+    {
+        EXPECT_EQ(0x00000000u, sobol_uint32(1, 0));
+        EXPECT_EQ(0x80000000u, sobol_uint32(1, 1));
+        EXPECT_EQ(0xC0000000u, sobol_uint32(1, 2));
+        EXPECT_EQ(0x40000000u, sobol_uint32(1, 3));
+        EXPECT_EQ(0xA0000000u, sobol_uint32(1, 4));
+        EXPECT_EQ(0x20000000u, sobol_uint32(1, 5));
+    }
+
+    // Return true if the first 2^m points form a (0,m,2)-net in base 2, i.e. if every
+    // elementary interval of area 2^-m contains exactly one point.
+    bool is_02_net(const std::vector<Vector2d>& points, const size_t m)
+    {
+        assert(points.size() == size_t(1) << m);
+
+        for (size_t log_x = 0; log_x <= m; ++log_x)
+        {
+            const size_t nx = size_t(1) << log_x;
+            const size_t ny = size_t(1) << (m - log_x);
+
+            std::vector<size_t> counts(nx * ny, 0);
+
+            for (const Vector2d& p : points)
+            {
+                const size_t x = truncate<size_t>(p.x * nx);
+                const size_t y = truncate<size_t>(p.y * ny);
+                ++counts[y * nx + x];
+            }
+
+            for (const size_t c : counts)
+            {
+                if (c != 1)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    TEST_CASE(SobolUint32_FirstTwoDimensionsFormA02Net)
+    {
+        std::vector<Vector2d> points;
+
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            points.emplace_back(
+                sobol_uint32(0, i) * Rcp2Pow32<double>(),
+                sobol_uint32(1, i) * Rcp2Pow32<double>());
+        }
+
+        EXPECT_TRUE(is_02_net(points, 8));
+    }
+
+    TEST_CASE(OwenScrambleUint32_PreservesStratification)
+    {
+        std::vector<bool> used(256, false);
+
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            const std::uint32_t x = owen_scramble_uint32(reverse_bits_uint32(i), 0x12345678u);
+            const std::uint32_t stratum = x >> 24;
+            EXPECT_FALSE(used[stratum]);
+            used[stratum] = true;
+        }
+    }
+
+    TEST_CASE(ScrambledSobolSequence_FirstTwoDimensionsFormA02Net)
+    {
+        for (std::uint32_t seed = 0; seed < 8; ++seed)
+        {
+            std::vector<Vector2d> points;
+
+            for (std::uint32_t i = 0; i < 256; ++i)
+                points.push_back(scrambled_sobol_sequence<double, 2>(hash_uint32(seed), i));
+
+            EXPECT_TRUE(is_02_net(points, 8));
+        }
+    }
+
+    TEST_CASE(ScrambledSobolSequence_DifferentSeeds_ReturnDifferentSequences)
+    {
+        const Vector4d a = scrambled_sobol_sequence<double, 4>(1, 0);
+        const Vector4d b = scrambled_sobol_sequence<double, 4>(2, 0);
+
+        EXPECT_NEQ(a, b);
+    }
+
     static const size_t PointCount = 256;
 
     TEST_CASE(Generate2DRandomSequenceImage)
@@ -28,6 +28,7 @@
 //
 
 // appleseed.foundation headers.
+#include "foundation/hash/hash.h"
 #include "foundation/math/fp.h"
 #include "foundation/math/qmc.h"
 #include "foundation/math/rng/mersennetwister.h"
@@ -36,6 +37,7 @@
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/string/string.h"
+#include "foundation/utility/gnuplotfile.h"
 #include "foundation/utility/iostreamop.h"
 #include "foundation/utility/test.h"
 #include "foundation/utility/testutils.h"
@@ -45,6 +47,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -130,6 +133,173 @@ TEST_SUITE(Foundation_Math_Sampling_QMCSamplingContext)
         EXPECT_EQ(4, child_child_context.m_dimension);
         EXPECT_EQ(0, child_child_context.m_instance);
     }
+
+    TEST_CASE(SobolMode_InitialStateIsCorrect)
+    {
+        RNG rng;
+        SamplingContext context(rng, SamplingContext::SobolMode, 2, 64, 7);
+
+        EXPECT_EQ(2, context.m_dimension);
+        EXPECT_EQ(0, context.m_instance);
+        EXPECT_EQ(hash_uint32(7), context.m_sequence_seed);
+        EXPECT_EQ(0, context.m_sequence_base);
+        EXPECT_EQ(SamplingContext::VectorType(0.0), context.m_offset);
+    }
+
+    TEST_CASE(SobolMode_TestSplitting)
+    {
+        RNG rng;
+        SamplingContext context(rng, SamplingContext::SobolMode, 2, 0, 7);
+        context.next2<Vector2d>();
+        context.next2<Vector2d>();
+        context.next2<Vector2d>();
+
+        SamplingContext child_context = context.split(3, 4);
+
+        EXPECT_EQ(2, child_context.m_base_dimension);
+        EXPECT_EQ(3, child_context.m_dimension);
+        EXPECT_EQ(0, child_context.m_instance);
+        EXPECT_EQ(context.m_sequence_seed, child_context.m_sequence_seed);
+        EXPECT_EQ(2 * 4, child_context.m_sequence_base);
+    }
+
+    TEST_CASE(SobolMode_TestSplittingWithUnknownSampleCount)
+    {
+        RNG rng;
+        SamplingContext context(rng, SamplingContext::SobolMode, 2, 0, 7);
+        context.next2<Vector2d>();
+
+        SamplingContext child_context = context.split(2, 0);
+
+        EXPECT_NEQ(context.m_sequence_seed, child_context.m_sequence_seed);
+        EXPECT_EQ(0, child_context.m_sequence_base);
+    }
+
+    TEST_CASE(SobolMode_PixelSamplesAreStratified)
+    {
+        const size_t SampleCount = 256;
+
+        RNG rng;
+        SamplingContext context(rng, SamplingContext::SobolMode, 2, 0, 7);
+
+        std::vector<bool> used_x(SampleCount, false);
+        std::vector<bool> used_y(SampleCount, false);
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            const Vector2d s = context.next2<Vector2d>();
+            const size_t x = truncate<size_t>(s.x * SampleCount);
+            const size_t y = truncate<size_t>(s.y * SampleCount);
+
+            EXPECT_FALSE(used_x[x]);
+            EXPECT_FALSE(used_y[y]);
+
+            used_x[x] = true;
+            used_y[y] = true;
+        }
+    }
+
+    TEST_CASE(SobolMode_SetScreenOffset_RotatesSamples)
+    {
+        RNG rng;
+        SamplingContext context(rng, SamplingContext::SobolMode, 2, 0, 7);
+        SamplingContext rotated_context(rng, SamplingContext::SobolMode, 2, 0, 7);
+        rotated_context.set_screen_offset(0.25);
+
+        const Vector2d s = context.next2<Vector2d>();
+        const Vector2d r = rotated_context.next2<Vector2d>();
+
+        EXPECT_FEQ(frac(s.x + 0.25), r.x);
+        EXPECT_FEQ(frac(s.y + 0.25 + 0.6180339887498949), r.y);
+    }
+}
+
+TEST_SUITE(Foundation_Math_Sampling_QMCSamplingContext_Convergence)
+{
+    typedef MersenneTwister RNG;
+    typedef QMCSamplingContext<RNG> SamplingContext;
+
+    // A pixel straddling a geometric edge, lit by an area light.
+    double shade(SamplingContext& context)
+    {
+        const Vector2d pixel_sample = context.next2<Vector2d>();
+
+        SamplingContext child_context = context.split(2, 1);
+        const Vector2d light_sample = child_context.next2<Vector2d>();
+
+        const double visibility = pixel_sample.x < pixel_sample.y ? 1.0 : 0.0;
+        return visibility * (square(light_sample.x) + light_sample.y);
+    }
+
+    // Return the RMS error of the pixel values over a number of pixels.
+    double compute_rms_error(
+        const SamplingContext::Mode mode,
+        const size_t                pixel_count,
+        const size_t                sample_count)
+    {
+        const double ExactValue = 5.0 / 12.0;
+
+        RNG rng;
+        double squared_error = 0.0;
+
+        for (size_t i = 0; i < pixel_count; ++i)
+        {
+            const size_t instance = hash_uint32(static_cast<std::uint32_t>(i));
+            SamplingContext context(rng, mode, 2, 0, instance);
+
+            double value = 0.0;
+
+            for (size_t j = 0; j < sample_count; ++j)
+                value += shade(context);
+
+            value /= sample_count;
+            squared_error += square(value - ExactValue);
+        }
+
+        return std::sqrt(squared_error / pixel_count);
+    }
+
+    TEST_CASE(SobolMode_ConvergesFasterThanRNGMode)
+    {
+        const size_t PixelCount = 256;
+
+        std::vector<Vector2d> rng_error;
+        std::vector<Vector2d> qmc_error;
+        std::vector<Vector2d> sobol_error;
+
+        for (size_t sample_count = 1; sample_count <= 256; sample_count *= 2)
+        {
+            const double n = static_cast<double>(sample_count);
+            rng_error.emplace_back(n, compute_rms_error(SamplingContext::RNGMode, PixelCount, sample_count));
+            qmc_error.emplace_back(n, compute_rms_error(SamplingContext::QMCMode, PixelCount, sample_count));
+            sobol_error.emplace_back(n, compute_rms_error(SamplingContext::SobolMode, PixelCount, sample_count));
+        }
+
+        GnuplotFile plotfile;
+        plotfile.set_title("RMS Error");
+        plotfile.set_xlabel("Samples per Pixel");
+        plotfile.set_logscale_x();
+        plotfile.set_logscale_y();
+        plotfile
+            .new_plot()
+            .set_points(rng_error)
+            .set_title("RNG")
+            .set_color("blue");
+        plotfile
+            .new_plot()
+            .set_points(qmc_error)
+            .set_title("QMC")
+            .set_color("red");
+        plotfile
+            .new_plot()
+            .set_points(sobol_error)
+            .set_title("Sobol")
+            .set_color("green");
+        plotfile.write("unit tests/outputs/test_sampling_convergence.gnuplot");
+
+        // At 64 samples per pixel, scrambled Sobol sampling should at least halve the error of random sampling.
+        EXPECT_LT(0.5 * rng_error[6].y, sobol_error[6].y);
+    }
 }
 
 TEST_SUITE(Foundation_Math_Sampling_QMCSamplingContext_DirectIlluminationSimulation)
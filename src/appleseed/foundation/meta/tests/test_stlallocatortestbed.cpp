@@ -30,6 +30,7 @@
 // appleseed.foundation headers.
 #include "foundation/core/exceptions/exception.h"
 #include "foundation/memory/alignedallocator.h"
+#include "foundation/memory/largeallocator.h"
 #include "foundation/memory/poolallocator.h"
 #include "foundation/utility/test.h"
 
@@ -1399,4 +1400,12 @@ TEST_SUITE(StlAllocatorTestbed)
         AlignedAllocator<int> allocator(32);
         TestAlloc(allocator);
     }
+
+    SET_DEFAULT_CONSTRUCTABLE_OFF(LargeAllocator);
+
+    TEST_CASE(LargeAllocator)
+    {
+        LargeAllocator<int> allocator(32);
+        TestAlloc(allocator);
+    }
 }
@@ -0,0 +1,218 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/utility/test.h"
+#include "foundation/utility/xmlscanner.h"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Utility_XMLScanner)
+{
+    struct Fixture
+    {
+        std::string                 m_document;
+        std::unique_ptr<XMLScanner> m_scanner;
+
+        XMLScanner& scan(const char* document)
+        {
+            m_document = document;
+
+            m_scanner.reset(new XMLScanner(m_document.data(), m_document.data() + m_document.size()));
+
+            return *m_scanner;
+        }
+
+        std::string name() const
+        {
+            return std::string(m_scanner->get_name(), m_scanner->get_name_length());
+        }
+
+        std::string attribute_name(const size_t index) const
+        {
+            const XMLScanner::Attribute& attribute = m_scanner->get_attribute(index);
+            return std::string(attribute.m_name, attribute.m_name_length);
+        }
+    };
+
+    TEST_CASE_F(Next_GivenElementsAndText_ReportsTokensInDocumentOrder, Fixture)
+    {
+        XMLScanner& scanner = scan("<?xml version=\"1.0\"?><a><b>text</b></a>");
+
+        EXPECT_EQ(XMLScanner::TokenStartElement, scanner.next());
+        EXPECT_EQ("a", name());
+        EXPECT_EQ(1, scanner.get_depth());
+
+        EXPECT_EQ(XMLScanner::TokenStartElement, scanner.next());
+        EXPECT_EQ("b", name());
+        EXPECT_EQ(2, scanner.get_depth());
+
+        EXPECT_EQ(XMLScanner::TokenCharacters, scanner.next());
+        EXPECT_EQ("text", scanner.get_characters());
+
+        EXPECT_EQ(XMLScanner::TokenEndElement, scanner.next());
+        EXPECT_EQ("b", name());
+
+        EXPECT_EQ(XMLScanner::TokenEndElement, scanner.next());
+        EXPECT_EQ("a", name());
+        EXPECT_EQ(0, scanner.get_depth());
+
+        EXPECT_EQ(XMLScanner::TokenEndOfDocument, scanner.next());
+    }
+
+    TEST_CASE_F(Next_GivenEmptyElement_ReportsStartAndEndElements, Fixture)
+    {
+        XMLScanner& scanner = scan("<a name=\"x\" />");
+
+        EXPECT_EQ(XMLScanner::TokenStartElement, scanner.next());
+        EXPECT_EQ(1, scanner.get_attribute_count());
+
+        EXPECT_EQ(XMLScanner::TokenEndElement, scanner.next());
+        EXPECT_EQ("a", name());
+
+        EXPECT_EQ(XMLScanner::TokenEndOfDocument, scanner.next());
+    }
+
+    TEST_CASE_F(Next_GivenAttributes_DecodesValues, Fixture)
+    {
+        XMLScanner& scanner = scan("<a first='1 &lt; 2' second=\"&quot;&#65;&#x42;&amp;\" third=\"x\r\ny\tz\"/>");
+
+        ASSERT_EQ(XMLScanner::TokenStartElement, scanner.next());
+        ASSERT_EQ(3, scanner.get_attribute_count());
+
+        EXPECT_EQ("first", attribute_name(0));
+        EXPECT_EQ("1 < 2", scanner.get_attribute(0).m_value);
+
+        EXPECT_EQ("second", attribute_name(1));
+        EXPECT_EQ("\"AB&", scanner.get_attribute(1).m_value);
+
+        EXPECT_EQ("third", attribute_name(2));
+        EXPECT_EQ("x y z", scanner.get_attribute(2).m_value);
+    }
+
+    TEST_CASE_F(Next_GivenCharacterDataWithReferencesAndLineEndings_DecodesCharacterData, Fixture)
+    {
+        XMLScanner& scanner = scan("<a>x\r\ny\r&#233;</a>");
+
+        scanner.next();
+
+        ASSERT_EQ(XMLScanner::TokenCharacters, scanner.next());
+        EXPECT_EQ("x\ny\n\xC3\xA9", scanner.get_characters());
+    }
+
+    TEST_CASE_F(Next_GivenCommentsAndCDATASection_SkipsCommentsAndReportsCDATAVerbatim, Fixture)
+    {
+        XMLScanner& scanner = scan("<!-- header --><a><!-- <b> --><![CDATA[<b>&amp;</b>]]></a>");
+
+        EXPECT_EQ(XMLScanner::TokenStartElement, scanner.next());
+
+        ASSERT_EQ(XMLScanner::TokenCharacters, scanner.next());
+        EXPECT_EQ("<b>&amp;</b>", scanner.get_characters());
+
+        EXPECT_EQ(XMLScanner::TokenEndElement, scanner.next());
+        EXPECT_EQ(XMLScanner::TokenEndOfDocument, scanner.next());
+    }
+
+    TEST_CASE_F(SkipElement_SkipsNestedContent, Fixture)
+    {
+        XMLScanner& scanner = scan("<a><b x=\">\"><c/>text<b/></b><d/></a>");
+
+        scanner.next();
+
+        ASSERT_EQ(XMLScanner::TokenStartElement, scanner.next());
+        EXPECT_EQ("b", name());
+
+        const char* begin = scanner.get_token_position();
+        ASSERT_TRUE(scanner.skip_element());
+
+        EXPECT_EQ("<b x=\">\"><c/>text<b/></b>", std::string(begin, scanner.get_position()));
+
+        EXPECT_EQ(XMLScanner::TokenStartElement, scanner.next());
+        EXPECT_EQ("d", name());
+    }
+
+    TEST_CASE_F(Next_GivenMismatchedEndTag_ReportsError, Fixture)
+    {
+        XMLScanner& scanner = scan("<a>\n<b></a>");
+
+        scanner.next();
+        scanner.next();
+        scanner.next();
+
+        ASSERT_EQ(XMLScanner::TokenError, scanner.next());
+
+        size_t line, column;
+        XMLScanner::get_line_and_column(m_document.data(), scanner.get_error_position(), line, column);
+
+        EXPECT_EQ(2, line);
+        EXPECT_EQ(4, column);
+    }
+
+    TEST_CASE_F(Next_GivenDuplicateAttribute_ReportsError, Fixture)
+    {
+        XMLScanner& scanner = scan("<a x=\"1\" x=\"2\"/>");
+
+        EXPECT_EQ(XMLScanner::TokenError, scanner.next());
+    }
+
+    TEST_CASE_F(Next_GivenUnknownEntity_ReportsError, Fixture)
+    {
+        XMLScanner& scanner = scan("<a>&nbsp;</a>");
+
+        scanner.next();
+
+        EXPECT_EQ(XMLScanner::TokenError, scanner.next());
+    }
+
+    TEST_CASE_F(Next_GivenUnclosedElement_ReportsError, Fixture)
+    {
+        XMLScanner& scanner = scan("<a><b></b>");
+
+        scanner.next();
+        scanner.next();
+        scanner.next();
+
+        EXPECT_EQ(XMLScanner::TokenError, scanner.next());
+    }
+
+    TEST_CASE_F(Next_GivenTwoRootElements_ReportsError, Fixture)
+    {
+        XMLScanner& scanner = scan("<a/><b/>");
+
+        scanner.next();
+        scanner.next();
+
+        EXPECT_EQ(XMLScanner::TokenError, scanner.next());
+    }
+}
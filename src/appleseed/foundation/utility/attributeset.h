@@ -103,6 +103,9 @@ class AttributeSet
         const size_t        index,
         T*                  value) const;
 
+    // Return the size (in bytes) of this object in memory.
+    size_t get_memory_size() const;
+
   private:
     struct Channel
     {
@@ -0,0 +1,192 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "memorymappedfile.h"
+
+// Platform headers.
+#if defined _WIN32
+#include "foundation/platform/windows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace foundation
+{
+
+//
+// MemoryMappedFile class implementation.
+//
+
+MemoryMappedFile::MemoryMappedFile()
+  : m_is_open(false)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_mapping(nullptr)
+{
+}
+
+MemoryMappedFile::MemoryMappedFile(const char* path)
+  : m_is_open(false)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_mapping(nullptr)
+{
+    open(path);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+#if defined _WIN32
+
+bool MemoryMappedFile::open(const char* path)
+{
+    close();
+
+    const HANDLE file =
+        CreateFileA(
+            path,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (file_size.QuadPart > 0)
+    {
+        // The mapping object keeps a reference to the file.
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (mapping == nullptr)
+            return false;
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        m_data = static_cast<const char*>(view);
+        m_size = static_cast<size_t>(file_size.QuadPart);
+        m_mapping = mapping;
+    }
+    else CloseHandle(file);
+
+    m_is_open = true;
+
+    return true;
+}
+
+void MemoryMappedFile::close()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping != nullptr)
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+
+    m_is_open = false;
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+}
+
+#else
+
+bool MemoryMappedFile::open(const char* path)
+{
+    close();
+
+    const int fd = ::open(path, O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat file_status;
+    if (fstat(fd, &file_status) == -1)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    if (file_status.st_size > 0)
+    {
+        const size_t size = static_cast<size_t>(file_status.st_size);
+
+        // The mapping keeps a reference to the file, the descriptor is no longer needed.
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (view == MAP_FAILED)
+            return false;
+
+        // The file is typically read from start to end.
+        madvise(view, size, MADV_SEQUENTIAL);
+
+        m_data = static_cast<const char*>(view);
+        m_size = size;
+    }
+    else ::close(fd);
+
+    m_is_open = true;
+
+    return true;
+}
+
+void MemoryMappedFile::close()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<char*>(m_data), m_size);
+
+    m_is_open = false;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+}   // namespace foundation
@@ -0,0 +1,103 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// A read-only view of the entire content of a file, mapped into memory.
+//
+// Pages are loaded lazily by the operating system as they are accessed, which
+// avoids copying the file into an intermediate buffer.
+//
+
+class APPLESEED_DLLSYMBOL MemoryMappedFile
+  : public NonCopyable
+{
+  public:
+    // Constructors.
+    MemoryMappedFile();
+    explicit MemoryMappedFile(const char* path);
+
+    // Destructor, unmaps the file if it is still mapped.
+    ~MemoryMappedFile();
+
+    // Map a file into memory.
+    // Return true on success, false on error.
+    bool open(const char* path);
+
+    // Unmap the file.
+    void close();
+
+    // Return true if a file is mapped, false otherwise.
+    bool is_open() const;
+
+    // Access the content of the file. data() returns nullptr for empty files.
+    const char* data() const;
+    size_t size() const;
+
+  private:
+    bool        m_is_open;
+    const char* m_data;
+    size_t      m_size;
+    void*       m_mapping;      // mapping handle, only used on Windows
+};
+
+
+//
+// MemoryMappedFile class implementation.
+//
+
+inline bool MemoryMappedFile::is_open() const
+{
+    return m_is_open;
+}
+
+inline const char* MemoryMappedFile::data() const
+{
+    return m_data;
+}
+
+inline size_t MemoryMappedFile::size() const
+{
+    return m_size;
+}
+
+}   // namespace foundation
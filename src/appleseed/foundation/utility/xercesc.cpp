@@ -32,11 +32,18 @@
 
 // appleseed.foundation headers.
 #include "foundation/string/string.h"
+#include "foundation/utility/xmlscanner.h"
 
 // Xerces-C++ headers.
 #include "xercesc/util/PlatformUtils.hpp"
 #include "xercesc/util/XMLException.hpp"
 #include "xercesc/util/XMLExceptMsgs.hpp"
+#include "xercesc/util/XMLString.hpp"
+#include "xercesc/util/XMLUni.hpp"
+
+// Standard headers.
+#include <cstdint>
+#include <cstring>
 
 using namespace xercesc;
 
@@ -119,6 +126,238 @@ bool XercesCContext::is_initialized() const
 }
 
 
+//
+// Transcoding functions implementation.
+//
+
+void transcode_utf8(
+    const char*                 s,
+    const size_t                length,
+    std::basic_string<XMLCh>&   output)
+{
+    output.clear();
+    output.reserve(length);
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+    const unsigned char* end = p + length;
+
+    while (p < end)
+    {
+        // Fast path for ASCII characters.
+        if (*p < 0x80)
+        {
+            output += static_cast<XMLCh>(*p++);
+            continue;
+        }
+
+        size_t continuation_count;
+        std::uint32_t code_point;
+
+        if ((*p & 0xE0) == 0xC0)
+        {
+            continuation_count = 1;
+            code_point = *p & 0x1F;
+        }
+        else if ((*p & 0xF0) == 0xE0)
+        {
+            continuation_count = 2;
+            code_point = *p & 0x0F;
+        }
+        else if ((*p & 0xF8) == 0xF0)
+        {
+            continuation_count = 3;
+            code_point = *p & 0x07;
+        }
+        else
+        {
+            // Invalid leading byte.
+            output += static_cast<XMLCh>(0xFFFD);
+            ++p;
+            continue;
+        }
+
+        ++p;
+
+        size_t i = 0;
+        for (; i < continuation_count && p < end && (*p & 0xC0) == 0x80; ++i, ++p)
+            code_point = (code_point << 6) | (*p & 0x3F);
+
+        if (i < continuation_count)
+            output += static_cast<XMLCh>(0xFFFD);
+        else if (code_point < 0x10000)
+            output += static_cast<XMLCh>(code_point);
+        else
+        {
+            // Encode as a surrogate pair.
+            code_point -= 0x10000;
+            output += static_cast<XMLCh>(0xD800 + (code_point >> 10));
+            output += static_cast<XMLCh>(0xDC00 + (code_point & 0x3FF));
+        }
+    }
+}
+
+
+//
+// XMLScannerAttributes class implementation.
+//
+
+namespace
+{
+    bool is_namespace_declaration(const char* name, const size_t name_length)
+    {
+        return
+            name_length >= 5 &&
+            std::memcmp(name, "xmlns", 5) == 0 &&
+            (name_length == 5 || name[5] == ':');
+    }
+}
+
+XMLScannerAttributes::XMLScannerAttributes()
+  : m_count(0)
+{
+}
+
+void XMLScannerAttributes::set(const XMLScanner& scanner)
+{
+    m_count = 0;
+
+    const size_t attribute_count = scanner.get_attribute_count();
+
+    for (size_t i = 0; i < attribute_count; ++i)
+    {
+        const XMLScanner::Attribute& source = scanner.get_attribute(i);
+
+        if (is_namespace_declaration(source.m_name, source.m_name_length))
+            continue;
+
+        if (m_count == m_attributes.size())
+            m_attributes.emplace_back();
+
+        Attribute& attribute = m_attributes[m_count++];
+
+        transcode_utf8(source.m_name, source.m_name_length, attribute.m_qname);
+        transcode_utf8(source.m_value.data(), source.m_value.size(), attribute.m_value);
+
+        const size_t colon = attribute.m_qname.find(static_cast<XMLCh>(':'));
+        attribute.m_local_name_offset = colon == std::basic_string<XMLCh>::npos ? 0 : colon + 1;
+    }
+}
+
+XMLSize_t XMLScannerAttributes::getLength() const
+{
+    return m_count;
+}
+
+const XMLCh* XMLScannerAttributes::getURI(const XMLSize_t index) const
+{
+    return index < m_count ? XMLUni::fgZeroLenString : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getLocalName(const XMLSize_t index) const
+{
+    return index < m_count
+        ? m_attributes[index].m_qname.c_str() + m_attributes[index].m_local_name_offset
+        : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getQName(const XMLSize_t index) const
+{
+    return index < m_count ? m_attributes[index].m_qname.c_str() : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getType(const XMLSize_t index) const
+{
+    return index < m_count ? XMLUni::fgCDATAString : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getValue(const XMLSize_t index) const
+{
+    return index < m_count ? m_attributes[index].m_value.c_str() : nullptr;
+}
+
+bool XMLScannerAttributes::getIndex(
+    const XMLCh* const      uri,
+    const XMLCh* const      local_part,
+    XMLSize_t&              index) const
+{
+    // Since namespaces are not processed, only attributes without namespace can match.
+    if (uri != nullptr && *uri != 0)
+        return false;
+
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        if (XMLString::equals(getLocalName(i), local_part))
+        {
+            index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int XMLScannerAttributes::getIndex(
+    const XMLCh* const      uri,
+    const XMLCh* const      local_part) const
+{
+    XMLSize_t index;
+    return getIndex(uri, local_part, index) ? static_cast<int>(index) : -1;
+}
+
+bool XMLScannerAttributes::getIndex(
+    const XMLCh* const      qname,
+    XMLSize_t&              index) const
+{
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        if (XMLString::equals(m_attributes[i].m_qname.c_str(), qname))
+        {
+            index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int XMLScannerAttributes::getIndex(
+    const XMLCh* const      qname) const
+{
+    XMLSize_t index;
+    return getIndex(qname, index) ? static_cast<int>(index) : -1;
+}
+
+const XMLCh* XMLScannerAttributes::getType(
+    const XMLCh* const      uri,
+    const XMLCh* const      local_part) const
+{
+    XMLSize_t index;
+    return getIndex(uri, local_part, index) ? getType(index) : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getType(
+    const XMLCh* const      qname) const
+{
+    XMLSize_t index;
+    return getIndex(qname, index) ? getType(index) : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getValue(
+    const XMLCh* const      uri,
+    const XMLCh* const      local_part) const
+{
+    XMLSize_t index;
+    return getIndex(uri, local_part, index) ? getValue(index) : nullptr;
+}
+
+const XMLCh* XMLScannerAttributes::getValue(
+    const XMLCh* const      qname) const
+{
+    XMLSize_t index;
+    return getIndex(qname, index) ? getValue(index) : nullptr;
+}
+
+
 //
 // ErrorLogger class implementation.
 //
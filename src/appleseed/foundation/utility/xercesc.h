@@ -49,9 +49,11 @@
 #include <memory>
 #include <stack>
 #include <string>
+#include <vector>
 
 // Forward declarations.
 namespace foundation    { class Logger; }
+namespace foundation    { class XMLScanner; }
 
 namespace foundation
 {
@@ -114,6 +116,72 @@ std::basic_string<char> transcode(const XMLCh* s);
 std::basic_string<XMLCh> transcode(const char* s);
 std::basic_string<XMLCh> transcode(const std::string& s);
 
+// Convert a UTF-8 string to UTF-16 without going through Xerces-C++'s transcoding service.
+void transcode_utf8(
+    const char*                 s,
+    const size_t                length,
+    std::basic_string<XMLCh>&   output);
+
+
+//
+// The attributes of the current element of a foundation::XMLScanner, exposed through
+// the SAX2 interface. Namespaces are not processed: URIs are always empty, local names
+// are qualified names stripped from their prefix, and namespace declarations are omitted.
+//
+
+class XMLScannerAttributes
+  : public xercesc::Attributes
+{
+  public:
+    // Constructor.
+    XMLScannerAttributes();
+
+    // Capture the attributes of the element whose start was just reported by a scanner.
+    void set(const XMLScanner& scanner);
+
+    // xercesc::Attributes interface.
+    XMLSize_t getLength() const override;
+    const XMLCh* getURI(const XMLSize_t index) const override;
+    const XMLCh* getLocalName(const XMLSize_t index) const override;
+    const XMLCh* getQName(const XMLSize_t index) const override;
+    const XMLCh* getType(const XMLSize_t index) const override;
+    const XMLCh* getValue(const XMLSize_t index) const override;
+    bool getIndex(
+        const XMLCh* const      uri,
+        const XMLCh* const      local_part,
+        XMLSize_t&              index) const override;
+    int getIndex(
+        const XMLCh* const      uri,
+        const XMLCh* const      local_part) const override;
+    bool getIndex(
+        const XMLCh* const      qname,
+        XMLSize_t&              index) const override;
+    int getIndex(
+        const XMLCh* const      qname) const override;
+    const XMLCh* getType(
+        const XMLCh* const      uri,
+        const XMLCh* const      local_part) const override;
+    const XMLCh* getType(
+        const XMLCh* const      qname) const override;
+    const XMLCh* getValue(
+        const XMLCh* const      uri,
+        const XMLCh* const      local_part) const override;
+    const XMLCh* getValue(
+        const XMLCh* const      qname) const override;
+
+  private:
+    struct Attribute
+    {
+        std::basic_string<XMLCh>    m_qname;
+        size_t                      m_local_name_offset;
+        std::basic_string<XMLCh>    m_value;
+    };
+
+    // Attributes are stored in a vector that is never shrunk, to reuse their string buffers.
+    std::vector<Attribute>  m_attributes;
+    size_t                  m_count;
+};
+
 
 //
 // Element handler interface.
@@ -225,9 +293,14 @@ class SAX2ContentHandler
   public:
     typedef IElementHandlerFactory<ElementID> ElementHandlerFactoryType;
 
+    typedef IElementHandler<ElementID> ElementHandlerType;
+
     // Constructor.
     SAX2ContentHandler();
 
+    // Constructor, the root handler receives notifications about the top-level elements.
+    explicit SAX2ContentHandler(std::unique_ptr<ElementHandlerType> root_handler);
+
     // Destructor.
     ~SAX2ContentHandler() override;
 
@@ -255,9 +328,13 @@ class SAX2ContentHandler
         const XMLCh* const                          chars,
         const XMLSize_t                             length) override;
 
-  private:
-    typedef IElementHandler<ElementID> ElementHandlerType;
+    // Notify the handler of the current element of a complete child element that was
+    // parsed separately, for instance by another thread. The handler is not adopted.
+    void insert_child_element(
+        const ElementID                             id,
+        ElementHandlerType*                         handler);
 
+  private:
     struct FactoryInfo
     {
         ElementID                   m_id;
@@ -404,6 +481,13 @@ SAX2ContentHandler<ElementID>::SAX2ContentHandler()
     m_handler_stack.push(new ElementHandlerBase<ElementID>());
 }
 
+template <typename ElementID>
+SAX2ContentHandler<ElementID>::SAX2ContentHandler(std::unique_ptr<ElementHandlerType> root_handler)
+{
+    assert(root_handler);
+    m_handler_stack.push(root_handler.release());
+}
+
 template <typename ElementID>
 SAX2ContentHandler<ElementID>::~SAX2ContentHandler()
 {
@@ -490,4 +574,15 @@ void SAX2ContentHandler<ElementID>::characters(
     m_handler_stack.top()->characters(chars, length);
 }
 
+template <typename ElementID>
+void SAX2ContentHandler<ElementID>::insert_child_element(
+    const ElementID                             id,
+    ElementHandlerType*                         handler)
+{
+    assert(!m_handler_stack.empty());
+
+    m_handler_stack.top()->start_child_element(id, handler);
+    m_handler_stack.top()->end_child_element(id, handler);
+}
+
 }   // namespace foundation
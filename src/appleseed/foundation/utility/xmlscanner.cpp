@@ -0,0 +1,654 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "xmlscanner.h"
+
+// Standard headers.
+#include <cstdint>
+#include <cstring>
+
+namespace foundation
+{
+
+//
+// XMLScanner class implementation.
+//
+
+namespace
+{
+    inline bool is_whitespace(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    inline bool is_name_start_char(const char c)
+    {
+        return
+            (c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') ||
+            c == '_' || c == ':' ||
+            static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    inline bool is_name_char(const char c)
+    {
+        return
+            is_name_start_char(c) ||
+            (c >= '0' && c <= '9') ||
+            c == '-' || c == '.';
+    }
+
+    inline bool starts_with(
+        const char*     begin,
+        const char*     end,
+        const char*     prefix,
+        const size_t    prefix_length)
+    {
+        return
+            static_cast<size_t>(end - begin) >= prefix_length &&
+            std::memcmp(begin, prefix, prefix_length) == 0;
+    }
+
+    inline bool equal_names(
+        const char*     lhs,
+        const size_t    lhs_length,
+        const char*     rhs,
+        const size_t    rhs_length)
+    {
+        return lhs_length == rhs_length && std::memcmp(lhs, rhs, lhs_length) == 0;
+    }
+
+    void append_utf8(const std::uint32_t code_point, std::string& output)
+    {
+        if (code_point < 0x80)
+            output += static_cast<char>(code_point);
+        else if (code_point < 0x800)
+        {
+            output += static_cast<char>(0xC0 | (code_point >> 6));
+            output += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000)
+        {
+            output += static_cast<char>(0xE0 | (code_point >> 12));
+            output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else
+        {
+            output += static_cast<char>(0xF0 | (code_point >> 18));
+            output += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    // Decode the character reference &#...; or &#x...; whose content is [begin, end).
+    bool decode_character_reference(
+        const char*     begin,
+        const char*     end,
+        std::uint32_t&  code_point)
+    {
+        std::uint32_t base = 10;
+
+        if (begin < end && *begin == 'x')
+        {
+            base = 16;
+            ++begin;
+        }
+
+        if (begin == end)
+            return false;
+
+        code_point = 0;
+
+        for (; begin < end; ++begin)
+        {
+            std::uint32_t digit;
+
+            const char c = *begin;
+            if (c >= '0' && c <= '9')
+                digit = c - '0';
+            else if (base == 16 && c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+            else if (base == 16 && c >= 'A' && c <= 'F')
+                digit = c - 'A' + 10;
+            else return false;
+
+            code_point = code_point * base + digit;
+
+            if (code_point > 0x10FFFF)
+                return false;
+        }
+
+        return code_point != 0 && (code_point < 0xD800 || code_point > 0xDFFF);
+    }
+}
+
+XMLScanner::XMLScanner(
+    const char*     begin,
+    const char*     end)
+  : m_begin(begin)
+  , m_end(end)
+  , m_cur(begin)
+  , m_token_position(begin)
+  , m_decode(true)
+  , m_seen_root(false)
+  , m_pending_end(false)
+  , m_name(nullptr, 0)
+  , m_attribute_count(0)
+  , m_error_position(nullptr)
+{
+    // Skip the UTF-8 byte order mark.
+    if (starts_with(m_cur, m_end, "\xEF\xBB\xBF", 3))
+        m_cur += 3;
+}
+
+XMLScanner::Token XMLScanner::next()
+{
+    if (m_pending_end)
+    {
+        // Report the end of an empty element.
+        m_pending_end = false;
+        m_open_elements.pop_back();
+        return TokenEndElement;
+    }
+
+    while (true)
+    {
+        m_token_position = m_cur;
+
+        if (m_cur == m_end)
+        {
+            if (!m_open_elements.empty())
+                return error(m_cur, "unexpected end of document");
+
+            if (!m_seen_root)
+                return error(m_cur, "the document has no root element");
+
+            return TokenEndOfDocument;
+        }
+
+        if (*m_cur == '<')
+        {
+            if (starts_with(m_cur, m_end, "</", 2))
+                return scan_end_element();
+
+            if (starts_with(m_cur, m_end, "<!--", 4))
+            {
+                m_cur += 4;
+                if (!skip_markup("-->"))
+                    return error(m_token_position, "unterminated comment");
+                continue;
+            }
+
+            if (starts_with(m_cur, m_end, "<?", 2))
+            {
+                m_cur += 2;
+                if (!skip_markup("?>"))
+                    return error(m_token_position, "unterminated processing instruction");
+                continue;
+            }
+
+            if (starts_with(m_cur, m_end, "<![CDATA[", 9))
+                return scan_cdata_section();
+
+            if (starts_with(m_cur, m_end, "<!DOCTYPE", 9))
+            {
+                if (!m_open_elements.empty() || m_seen_root)
+                    return error(m_cur, "unexpected document type declaration");
+                if (!skip_doctype())
+                    return error(m_token_position, "unterminated document type declaration");
+                continue;
+            }
+
+            return scan_start_element();
+        }
+
+        // Character data.
+        const char* text_end = static_cast<const char*>(std::memchr(m_cur, '<', m_end - m_cur));
+        if (text_end == nullptr)
+            text_end = m_end;
+
+        const char* text_begin = m_cur;
+        m_cur = text_end;
+
+        if (m_open_elements.empty())
+        {
+            // Only whitespace is allowed outside of the root element.
+            for (const char* p = text_begin; p < text_end; ++p)
+            {
+                if (!is_whitespace(*p))
+                    return error(p, "character data outside of the root element");
+            }
+
+            continue;
+        }
+
+        if (m_decode)
+        {
+            if (!decode(text_begin, text_end, false, m_characters))
+                return TokenError;
+        }
+
+        return TokenCharacters;
+    }
+}
+
+bool XMLScanner::skip_element()
+{
+    assert(!m_open_elements.empty());
+
+    if (m_pending_end)
+    {
+        m_pending_end = false;
+        m_open_elements.pop_back();
+        return true;
+    }
+
+    const size_t depth = m_open_elements.size();
+
+    m_decode = false;
+
+    while (m_open_elements.size() >= depth)
+    {
+        const Token token = next();
+
+        if (token == TokenError || token == TokenEndOfDocument)
+        {
+            m_decode = true;
+            return false;
+        }
+    }
+
+    m_decode = true;
+
+    return true;
+}
+
+void XMLScanner::get_line_and_column(
+    const char*     begin,
+    const char*     position,
+    size_t&         line,
+    size_t&         column)
+{
+    line = 1;
+
+    const char* line_begin = begin;
+
+    for (const char* p = begin; p < position; ++p)
+    {
+        if (*p == '\n')
+        {
+            ++line;
+            line_begin = p + 1;
+        }
+    }
+
+    column = static_cast<size_t>(position - line_begin) + 1;
+}
+
+XMLScanner::Token XMLScanner::scan_start_element()
+{
+    ++m_cur;    // skip '<'
+
+    Name name;
+    if (!scan_name(name))
+        return error(m_cur, "invalid element name");
+
+    if (m_open_elements.empty() && m_seen_root)
+        return error(m_token_position, "the document has more than one root element");
+
+    m_attribute_count = 0;
+
+    while (true)
+    {
+        const char* before_whitespace = m_cur;
+        skip_whitespace();
+
+        if (m_cur == m_end)
+            return error(m_token_position, "unterminated start tag");
+
+        if (*m_cur == '>')
+        {
+            ++m_cur;
+            break;
+        }
+
+        if (*m_cur == '/')
+        {
+            if (!starts_with(m_cur, m_end, "/>", 2))
+                return error(m_cur, "expected \"/>\"");
+
+            m_cur += 2;
+            m_pending_end = true;
+            break;
+        }
+
+        // Attributes must be separated by whitespace.
+        if (m_cur == before_whitespace)
+            return error(m_cur, "expected whitespace");
+
+        Name attribute_name;
+        if (!scan_name(attribute_name))
+            return error(m_cur, "invalid attribute name");
+
+        for (size_t i = 0; i < m_attribute_count; ++i)
+        {
+            const Attribute& other = m_attributes[i];
+            if (equal_names(other.m_name, other.m_name_length, attribute_name.first, attribute_name.second))
+                return error(attribute_name.first, "duplicate attribute");
+        }
+
+        skip_whitespace();
+
+        if (m_cur == m_end || *m_cur != '=')
+            return error(m_cur, "expected '='");
+
+        ++m_cur;
+
+        skip_whitespace();
+
+        // Attributes are stored in a vector that is never shrunk, to reuse their string buffers.
+        if (m_attribute_count == m_attributes.size())
+            m_attributes.emplace_back();
+
+        Attribute& attribute = m_attributes[m_attribute_count++];
+        attribute.m_name = attribute_name.first;
+        attribute.m_name_length = attribute_name.second;
+
+        if (!scan_attribute_value(attribute.m_value))
+            return TokenError;
+    }
+
+    m_name = name;
+    m_open_elements.push_back(name);
+    m_seen_root = true;
+
+    return TokenStartElement;
+}
+
+XMLScanner::Token XMLScanner::scan_end_element()
+{
+    m_cur += 2;     // skip "</"
+
+    Name name;
+    if (!scan_name(name))
+        return error(m_cur, "invalid element name");
+
+    skip_whitespace();
+
+    if (m_cur == m_end || *m_cur != '>')
+        return error(m_cur, "expected '>'");
+
+    ++m_cur;
+
+    if (m_open_elements.empty())
+        return error(m_token_position, "unexpected end tag");
+
+    const Name& open_element = m_open_elements.back();
+    if (!equal_names(open_element.first, open_element.second, name.first, name.second))
+        return error(m_token_position, "end tag does not match start tag");
+
+    m_name = name;
+    m_open_elements.pop_back();
+
+    return TokenEndElement;
+}
+
+XMLScanner::Token XMLScanner::scan_cdata_section()
+{
+    if (m_open_elements.empty())
+        return error(m_cur, "CDATA section outside of the root element");
+
+    m_cur += 9;     // skip "<![CDATA["
+
+    const char* cdata_begin = m_cur;
+    if (!skip_markup("]]>"))
+        return error(m_token_position, "unterminated CDATA section");
+
+    if (m_decode)
+    {
+        // Only line endings are normalized in CDATA sections.
+        m_characters.clear();
+
+        for (const char* p = cdata_begin, *e = m_cur - 3; p < e; ++p)
+        {
+            if (*p == '\r')
+            {
+                m_characters += '\n';
+                if (p + 1 < e && p[1] == '\n')
+                    ++p;
+            }
+            else m_characters += *p;
+        }
+    }
+
+    return TokenCharacters;
+}
+
+bool XMLScanner::skip_markup(const char* terminator)
+{
+    const size_t terminator_length = std::strlen(terminator);
+
+    while (m_cur < m_end)
+    {
+        const char* p = static_cast<const char*>(std::memchr(m_cur, terminator[0], m_end - m_cur));
+        if (p == nullptr)
+            break;
+
+        if (starts_with(p, m_end, terminator, terminator_length))
+        {
+            m_cur = p + terminator_length;
+            return true;
+        }
+
+        m_cur = p + 1;
+    }
+
+    m_cur = m_end;
+    return false;
+}
+
+bool XMLScanner::skip_doctype()
+{
+    // Skip the declaration, including its internal subset if any.
+    size_t bracket_depth = 0;
+    char quote = 0;
+
+    for (m_cur += 9; m_cur < m_end; ++m_cur)
+    {
+        const char c = *m_cur;
+
+        if (quote != 0)
+        {
+            if (c == quote)
+                quote = 0;
+        }
+        else if (c == '"' || c == '\'')
+            quote = c;
+        else if (c == '[')
+            ++bracket_depth;
+        else if (c == ']' && bracket_depth > 0)
+            --bracket_depth;
+        else if (c == '>' && bracket_depth == 0)
+        {
+            ++m_cur;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool XMLScanner::scan_name(Name& name)
+{
+    const char* begin = m_cur;
+
+    if (m_cur == m_end || !is_name_start_char(*m_cur))
+        return false;
+
+    ++m_cur;
+
+    while (m_cur < m_end && is_name_char(*m_cur))
+        ++m_cur;
+
+    name.first = begin;
+    name.second = static_cast<size_t>(m_cur - begin);
+
+    return true;
+}
+
+bool XMLScanner::scan_attribute_value(std::string& value)
+{
+    if (m_cur == m_end || (*m_cur != '"' && *m_cur != '\''))
+    {
+        error(m_cur, "expected quoted attribute value");
+        return false;
+    }
+
+    const char quote = *m_cur++;
+    const char* value_begin = m_cur;
+
+    while (m_cur < m_end && *m_cur != quote)
+    {
+        if (*m_cur == '<')
+        {
+            error(m_cur, "'<' not allowed in attribute values");
+            return false;
+        }
+
+        ++m_cur;
+    }
+
+    if (m_cur == m_end)
+    {
+        error(value_begin - 1, "unterminated attribute value");
+        return false;
+    }
+
+    const char* value_end = m_cur++;
+
+    return m_decode ? decode(value_begin, value_end, true, value) : true;
+}
+
+bool XMLScanner::decode(
+    const char*         begin,
+    const char*         end,
+    const bool          attribute,
+    std::string&        output)
+{
+    output.clear();
+
+    while (begin < end)
+    {
+        // Copy the longest run of characters that need no processing.
+        const char* run_end = begin;
+        while (run_end < end &&
+               *run_end != '&' &&
+               *run_end != '\r' &&
+               !(attribute && (*run_end == '\t' || *run_end == '\n')))
+            ++run_end;
+
+        output.append(begin, run_end);
+        begin = run_end;
+
+        if (begin == end)
+            break;
+
+        const char c = *begin;
+
+        if (c == '&')
+        {
+            const char* reference_end = static_cast<const char*>(std::memchr(begin, ';', end - begin));
+            if (reference_end == nullptr)
+            {
+                error(begin, "unterminated entity reference");
+                return false;
+            }
+
+            const char* name = begin + 1;
+            const size_t name_length = static_cast<size_t>(reference_end - name);
+
+            if (equal_names(name, name_length, "lt", 2))
+                output += '<';
+            else if (equal_names(name, name_length, "gt", 2))
+                output += '>';
+            else if (equal_names(name, name_length, "amp", 3))
+                output += '&';
+            else if (equal_names(name, name_length, "quot", 4))
+                output += '"';
+            else if (equal_names(name, name_length, "apos", 4))
+                output += '\'';
+            else
+            {
+                std::uint32_t code_point;
+                if (name_length == 0 ||
+                    *name != '#' ||
+                    !decode_character_reference(name + 1, reference_end, code_point))
+                {
+                    error(begin, "invalid entity reference");
+                    return false;
+                }
+
+                append_utf8(code_point, output);
+            }
+
+            begin = reference_end + 1;
+        }
+        else
+        {
+            // Normalize line endings to '\n', and whitespace characters in attribute values to ' '.
+            if (c == '\r' && begin + 1 < end && begin[1] == '\n')
+                ++begin;
+
+            output += attribute ? ' ' : '\n';
+            ++begin;
+        }
+    }
+
+    return true;
+}
+
+void XMLScanner::skip_whitespace()
+{
+    while (m_cur < m_end && is_whitespace(*m_cur))
+        ++m_cur;
+}
+
+XMLScanner::Token XMLScanner::error(
+    const char*         position,
+    const char*         message)
+{
+    m_error_message = message;
+    m_error_position = position;
+    return TokenError;
+}
+
+}   // namespace foundation
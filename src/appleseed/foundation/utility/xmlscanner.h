@@ -0,0 +1,218 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace foundation
+{
+
+//
+// A lightweight, non-validating XML pull parser reading a UTF-8 document from memory.
+//
+// The scanner checks that the document is well-formed (properly nested elements,
+// quoted and unique attributes, known entity references) but skips document type
+// declarations, processing instructions and comments, and does not process namespaces.
+//
+// Element and attribute names point directly into the input buffer and are not
+// null-terminated. Character data and attribute values are decoded (entity and
+// character references are replaced, line endings and whitespace in attribute
+// values are normalized) into buffers that remain valid until the next call to
+// next() or skip_element().
+//
+
+class APPLESEED_DLLSYMBOL XMLScanner
+  : public NonCopyable
+{
+  public:
+    enum Token
+    {
+        TokenStartElement,          // an empty element is reported as a start element followed by an end element
+        TokenEndElement,
+        TokenCharacters,            // a run of character data or a CDATA section
+        TokenEndOfDocument,
+        TokenError                  // the document is malformed, see get_error_message()
+    };
+
+    struct Attribute
+    {
+        const char*     m_name;
+        size_t          m_name_length;
+        std::string     m_value;
+    };
+
+    // Constructor. The buffer must remain valid for the lifetime of the scanner.
+    XMLScanner(
+        const char*     begin,
+        const char*     end);
+
+    // Read the next token.
+    Token next();
+
+    // Skip the content of the element whose start was just reported, up to and including
+    // its end. The end of the element is not reported. Return false if the element is
+    // malformed, in which case the error can be retrieved with get_error_message().
+    bool skip_element();
+
+    // Return the name of the current element (after TokenStartElement and TokenEndElement).
+    const char* get_name() const;
+    size_t get_name_length() const;
+
+    // Return the attributes of the current element (after TokenStartElement).
+    size_t get_attribute_count() const;
+    const Attribute& get_attribute(const size_t index) const;
+
+    // Return the current character data (after TokenCharacters).
+    const std::string& get_characters() const;
+
+    // Return the number of currently open elements.
+    size_t get_depth() const;
+
+    // Return the position in the buffer of the beginning of the last token.
+    const char* get_token_position() const;
+
+    // Return the position in the buffer where scanning will resume.
+    const char* get_position() const;
+
+    // Return a description of the error and its position in the buffer (after TokenError).
+    const std::string& get_error_message() const;
+    const char* get_error_position() const;
+
+    // Compute the 1-based line and column numbers of a position in a buffer.
+    static void get_line_and_column(
+        const char*     begin,
+        const char*     position,
+        size_t&         line,
+        size_t&         column);
+
+  private:
+    typedef std::pair<const char*, size_t> Name;
+
+    const char*             m_begin;
+    const char*             m_end;
+    const char*             m_cur;
+    const char*             m_token_position;
+    bool                    m_decode;
+    bool                    m_seen_root;
+    bool                    m_pending_end;
+    std::vector<Name>       m_open_elements;
+    Name                    m_name;
+    std::vector<Attribute>  m_attributes;
+    size_t                  m_attribute_count;
+    std::string             m_characters;
+    std::string             m_error_message;
+    const char*             m_error_position;
+
+    Token scan_start_element();
+    Token scan_end_element();
+    Token scan_cdata_section();
+    bool skip_markup(const char* terminator);
+    bool skip_doctype();
+    bool scan_name(Name& name);
+    bool scan_attribute_value(std::string& value);
+    bool decode(
+        const char*         begin,
+        const char*         end,
+        const bool          attribute,
+        std::string&        output);
+    void skip_whitespace();
+    Token error(
+        const char*         position,
+        const char*         message);
+};
+
+
+//
+// XMLScanner class implementation.
+//
+
+inline const char* XMLScanner::get_name() const
+{
+    return m_name.first;
+}
+
+inline size_t XMLScanner::get_name_length() const
+{
+    return m_name.second;
+}
+
+inline size_t XMLScanner::get_attribute_count() const
+{
+    return m_attribute_count;
+}
+
+inline const XMLScanner::Attribute& XMLScanner::get_attribute(const size_t index) const
+{
+    assert(index < m_attribute_count);
+    return m_attributes[index];
+}
+
+inline const std::string& XMLScanner::get_characters() const
+{
+    return m_characters;
+}
+
+inline size_t XMLScanner::get_depth() const
+{
+    return m_open_elements.size();
+}
+
+inline const char* XMLScanner::get_token_position() const
+{
+    return m_token_position;
+}
+
+inline const char* XMLScanner::get_position() const
+{
+    return m_cur;
+}
+
+inline const std::string& XMLScanner::get_error_message() const
+{
+    return m_error_message;
+}
+
+inline const char* XMLScanner::get_error_position() const
+{
+    return m_error_position;
+}
+
+}   // namespace foundation
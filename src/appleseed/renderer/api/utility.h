@@ -31,6 +31,7 @@
 
 // API headers.
 #include "renderer/utility/bbox.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/messagecontext.h"
 #include "renderer/utility/paramarray.h"
 #include "renderer/utility/pluginstore.h"
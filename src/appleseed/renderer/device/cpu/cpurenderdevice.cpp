@@ -41,6 +41,7 @@
 #include "renderer/modeling/frame/frame.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/settingsparsing.h"
 
 // appleseed.foundation headers.
 #include "foundation/containers/dictionary.h"
@@ -127,9 +128,10 @@ CPURenderDevice::~CPURenderDevice()
 }
 
 bool CPURenderDevice::initialize(
-    const SearchPaths&      resource_search_paths,
-    ITileCallbackFactory*   tile_callback_factory,
-    IAbortSwitch&           abort_switch)
+    const SearchPaths&          resource_search_paths,
+    ITileCallbackFactory*       tile_callback_factory,
+    const ProjectChanges::Type  changes,
+    IAbortSwitch&               abort_switch)
 {
     // Construct a search paths string from the project's search paths.
     const std::string project_search_paths =
@@ -163,15 +165,26 @@ bool CPURenderDevice::initialize(
     // Initialize OSL.
     m_renderer_services->initialize(m_texture_store);
 
+    // Renderer components (light samplers, lighting engine, frame renderer) only depend
+    // on lights, geometry and settings. Keep them if only the camera or shading changed.
+    const bool reuse_components =
+        m_components != nullptr &&
+        (changes & ~(ProjectChanges::Camera | ProjectChanges::Shading)) == 0;
+
     // Create renderer components.
-    m_components.reset(
-        new RendererComponents(
-            get_project(),
-            get_params(),
-            tile_callback_factory,
-            m_texture_store,
-            *m_texture_system,
-            *m_shading_system));
+    if (reuse_components)
+        RENDERER_LOG_INFO("reusing renderer components (changes: %s).", ProjectChanges::to_string(changes).c_str());
+    else
+    {
+        m_components.reset(
+            new RendererComponents(
+                get_project(),
+                get_params(),
+                tile_callback_factory,
+                m_texture_store,
+                *m_texture_system,
+                *m_shading_system));
+    }
 
     // Set OSL search paths.
     std::string prev_osl_search_paths;
@@ -180,6 +193,7 @@ bool CPURenderDevice::initialize(
     {
         RENDERER_LOG_INFO("setting osl shader search paths to %s", project_search_paths.c_str());
         get_project().get_scene()->release_optimized_osl_shader_groups();
+        m_shading_system->clear_shader_group_cache();
         m_shading_system->attribute("searchpath:shader", project_search_paths);
     }
 
@@ -196,13 +210,15 @@ bool CPURenderDevice::initialize(
     // Re-optimize shader groups that need updating.
     if (!get_project().get_scene()->create_optimized_osl_shader_groups(
             *m_shading_system,
+            get_project().search_paths(),
             m_osl_compiler.get(),
+            get_rendering_thread_count(get_params()),
             &abort_switch))
     {
         return false;
     }
 
-    return m_components->create();
+    return reuse_components || m_components->create();
 }
 
 bool CPURenderDevice::build_or_update_scene()
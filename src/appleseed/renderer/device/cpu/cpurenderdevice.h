@@ -64,6 +64,7 @@ class CPURenderDevice
     bool initialize(
         const foundation::SearchPaths&  resource_search_paths,
         ITileCallbackFactory*           tile_callback_factory,
+        const ProjectChanges::Type      changes,
         foundation::IAbortSwitch&       abort_switch) override;
 
     bool build_or_update_scene() override;
@@ -30,6 +30,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/kernel/rendering/irenderercontroller.h"
+#include "renderer/modeling/project/projectchangetracker.h"
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
@@ -56,10 +57,12 @@ class IRenderDevice
     // Destructor.
     virtual ~IRenderDevice() = default;
 
-    // Initialize the render device.
+    // Initialize the render device. `changes` describes what changed in the project
+    // since the last initialization; devices may use it to skip unaffected work.
     virtual bool initialize(
         const foundation::SearchPaths&  resource_search_paths,
         ITileCallbackFactory*           tile_callback_factory,
+        const ProjectChanges::Type      changes,
         foundation::IAbortSwitch&       abort_switch)  = 0;
 
     // Build or update ray tracing acceleration structures.
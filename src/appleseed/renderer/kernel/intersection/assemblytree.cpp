@@ -35,6 +35,7 @@
 #include "renderer/global/globaltypes.h"
 #include "renderer/kernel/intersection/intersectionsettings.h"
 #include "renderer/kernel/shading/shadingpoint.h"
+#include "renderer/modeling/camera/camera.h"
 #include "renderer/modeling/entity/entityvector.h"
 #include "renderer/modeling/object/curveobject.h"
 #include "renderer/modeling/object/meshobject.h"
@@ -82,6 +83,7 @@ AssemblyTree::AssemblyTree(const Scene& scene)
   , m_scene(scene)
 #ifdef APPLESEED_WITH_EMBREE
   , m_use_embree(false)
+  , m_use_embree_instancing(false)
   , m_dirty(false)
 #endif
 {
@@ -94,8 +96,18 @@ AssemblyTree::~AssemblyTree()
 
 void AssemblyTree::update()
 {
+#ifdef APPLESEED_WITH_EMBREE
+    // The instance scene references assembly tree items and Embree scenes that may go away.
+    m_embree_instance_scene.reset();
+#endif
+
     rebuild_assembly_tree();
     update_tree_hierarchy();
+
+#ifdef APPLESEED_WITH_EMBREE
+    if (use_embree() && use_embree_instancing())
+        create_embree_instance_scene();
+#endif
 }
 
 size_t AssemblyTree::get_memory_size() const
@@ -463,9 +475,25 @@ void AssemblyTree::set_use_embree(const bool value)
     }
 }
 
+bool AssemblyTree::use_embree_instancing() const
+{
+    return m_use_embree_instancing;
+}
+
+void AssemblyTree::set_use_embree_instancing(const bool value)
+{
+    m_use_embree_instancing = value;
+}
+
 void AssemblyTree::create_embree_scene(const Assembly& assembly)
 {
-    const std::uint64_t hash = hash_assembly_geometry(assembly, MeshObjectFactory().get_model());
+    // Embree scenes hold both the triangles and the curves of an assembly.
+    const std::uint64_t geometry_hashes[2] =
+    {
+        hash_assembly_geometry(assembly, MeshObjectFactory().get_model()),
+        hash_assembly_geometry(assembly, CurveObjectFactory().get_model())
+    };
+    const std::uint64_t hash = siphash24(geometry_hashes, sizeof(geometry_hashes));
     Lazy<EmbreeScene>* scene = m_embree_scene_repository.acquire(hash);
 
     if (scene == nullptr)
@@ -494,6 +522,57 @@ void AssemblyTree::delete_embree_scene(const UniqueID assembly_id)
     }
 }
 
+void AssemblyTree::create_embree_instance_scene()
+{
+    if (m_items.empty())
+        return;
+
+    // Procedural objects can only be intersected by the built-in traversal.
+    for (const_each<ItemVector> i = m_items; i; ++i)
+    {
+        if (!i->m_assembly->get_render_data().m_procedural_object_instances.empty())
+        {
+            RENDERER_LOG_INFO("scene contains procedural objects, not using Embree instancing.");
+            return;
+        }
+    }
+
+    RENDERER_LOG_INFO(
+        "building Embree instance scene (%s %s)...",
+        pretty_int(m_items.size()).c_str(),
+        plural(m_items.size(), "assembly instance").c_str());
+
+    EmbreeInstanceScene::InstanceVector instances;
+    instances.reserve(m_items.size());
+
+    for (const_each<ItemVector> i = m_items; i; ++i)
+    {
+        const EmbreeSceneContainer::const_iterator it = m_embree_scenes.find(i->m_assembly_uid);
+        assert(it != m_embree_scenes.end());
+
+        // Embree scenes must be built before they can be instanced.
+        Access<EmbreeScene> embree_scene(it->second);
+
+        EmbreeInstanceScene::Instance instance;
+        instance.m_scene = embree_scene.get();
+        instance.m_transform_sequence = &i->m_transform_sequence;
+        instance.m_vis_flags = i->m_assembly_instance->get_vis_flags();
+        instances.push_back(instance);
+    }
+
+    // Transform sequences are resampled over the shutter interval of the active camera,
+    // which is also the interval normalized ray times refer to.
+    const Camera* camera = m_scene.get_render_data().m_active_camera;
+
+    m_embree_instance_scene.reset(
+        new EmbreeInstanceScene(
+            EmbreeInstanceScene::Arguments(
+                m_scene.get_embree_device(),
+                instances,
+                camera != nullptr ? camera->get_shutter_open_begin_time() : 0.0f,
+                camera != nullptr ? camera->get_shutter_close_end_time() : 1.0f)));
+}
+
 #endif
 
 void AssemblyTree::delete_child_trees(const UniqueID assembly_id)
@@ -53,6 +53,7 @@
 // Standard headers.
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <vector>
 
 // Forward declarations.
@@ -93,6 +94,12 @@ class AssemblyTree
     bool use_embree() const;
     void set_use_embree(const bool value);
 
+    // When enabled, assembly instances are traversed by Embree as well, using a two-level
+    // Embree scene. Otherwise (the default) Embree only traverses the geometry of
+    // assemblies and assembly instances are traversed by this tree.
+    bool use_embree_instancing() const;
+    void set_use_embree_instancing(const bool value);
+
 #endif
 
   private:
@@ -141,8 +148,12 @@ class AssemblyTree
     TreeRepository<EmbreeScene>     m_embree_scene_repository;
     EmbreeSceneContainer            m_embree_scenes;
     bool                            m_use_embree;
+    bool                            m_use_embree_instancing;
     bool                            m_dirty; // is used to determine triangle tree / embree switch
 
+    // Must be destroyed before the Embree scenes it instances.
+    std::unique_ptr<EmbreeInstanceScene> m_embree_instance_scene;
+
 #endif
 
     void collect_assembly_instances(
@@ -165,6 +176,7 @@ class AssemblyTree
 
     void create_embree_scene(const Assembly& assembly);
     void delete_embree_scene(const foundation::UniqueID assembly_id);
+    void create_embree_instance_scene();
 
 #endif
 
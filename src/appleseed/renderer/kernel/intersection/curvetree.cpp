@@ -36,6 +36,7 @@
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/containers.h"
 #include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/messagecontext.h"
 #include "renderer/utility/paramarray.h"
 
@@ -44,7 +45,7 @@
 #include "foundation/math/beziercurve.h"
 #include "foundation/math/permutation.h"
 #include "foundation/math/transform.h"
-#include "foundation/memory/alignedallocator.h"
+#include "foundation/memory/largeallocator.h"
 #include "foundation/memory/memory.h"
 #include "foundation/platform/defaulttimers.h"
 #include "foundation/platform/system.h"
@@ -81,8 +82,10 @@ CurveTree::Arguments::Arguments(
 }
 
 CurveTree::CurveTree(const Arguments& arguments)
-  : TreeType(AlignedAllocator<void>(System::get_l1_data_cache_line_size()))
+  : TreeType(LargeAllocator<void>(System::get_l1_data_cache_line_size()))
   , m_arguments(arguments)
+  , m_memory_owner(
+        format("{0}/curve tree #{1}", arguments.m_assembly.get_path(), arguments.m_curve_tree_uid))
 {
     // Retrieve construction parameters.
     const MessageContext message_context(
@@ -108,6 +111,29 @@ CurveTree::CurveTree(const Arguments& arguments)
         StatisticsVector::make(
             "curve tree #" + to_string(m_arguments.m_curve_tree_uid) + " statistics",
             statistics).to_string().c_str());
+
+    // Attribute the memory used by the tree to the assembly it was built for.
+    global_memory_tracker().set(
+        MemoryTracker::CategoryTree,
+        m_memory_owner.c_str(),
+        get_memory_size());
+}
+
+CurveTree::~CurveTree()
+{
+    global_memory_tracker().remove(MemoryTracker::CategoryTree, m_memory_owner.c_str());
+}
+
+size_t CurveTree::get_memory_size() const
+{
+    return
+          TreeType::get_memory_size()
+        - sizeof(*static_cast<const TreeType*>(this))
+        + sizeof(*this)
+        + m_curves1.capacity() * sizeof(Curve1Type)
+        + m_curves3.capacity() * sizeof(Curve3Type)
+        + m_curve_keys.capacity() * sizeof(CurveKey)
+        + get_curve_packets_memory_size();
 }
 
 void CurveTree::collect_curves(std::vector<GAABB3>& curve_bboxes)
@@ -221,7 +247,10 @@ void CurveTree::build_bvh(
         reorder_curve_keys(ordering);
         reorder_curves(ordering);
         reorder_curve_keys_in_leaf_nodes();
+        build_curve_packets();
     }
+
+    statistics.insert_size("curve packets size", get_curve_packets_memory_size());
 }
 
 void CurveTree::reorder_curve_keys(const std::vector<size_t>& ordering)
@@ -301,6 +330,49 @@ void CurveTree::reorder_curve_keys_in_leaf_nodes()
     }
 }
 
+void CurveTree::build_curve_packets()
+{
+    m_curve1_packets.clear();
+    m_curve3_packets.clear();
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        if (!m_nodes[i].is_leaf())
+            continue;
+
+        LeafUserData& user_data = m_nodes[i].get_user_data<LeafUserData>();
+
+        user_data.m_curve1_packet_offset = static_cast<std::uint32_t>(m_curve1_packets.size());
+        for (std::uint32_t j = 0; j < user_data.m_curve1_count; ++j)
+        {
+            if (j % Curve1PacketType::Size == 0)
+                m_curve1_packets.push_back(Curve1PacketType());
+
+            m_curve1_packets.back().set(
+                j % Curve1PacketType::Size,
+                m_curves1[user_data.m_curve1_offset + j]);
+        }
+
+        user_data.m_curve3_packet_offset = static_cast<std::uint32_t>(m_curve3_packets.size());
+        for (std::uint32_t j = 0; j < user_data.m_curve3_count; ++j)
+        {
+            if (j % Curve3PacketType::Size == 0)
+                m_curve3_packets.push_back(Curve3PacketType());
+
+            m_curve3_packets.back().set(
+                j % Curve3PacketType::Size,
+                m_curves3[user_data.m_curve3_offset + j]);
+        }
+    }
+}
+
+size_t CurveTree::get_curve_packets_memory_size() const
+{
+    return
+          m_curve1_packets.capacity() * sizeof(Curve1PacketType)
+        + m_curve3_packets.capacity() * sizeof(Curve3PacketType);
+}
+
 
 //
 // CurveTreeFactory class implementation.
@@ -40,6 +40,7 @@
 #include "foundation/containers/alignedvector.h"
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/math/bvh.h"
+#include "foundation/memory/largeallocator.h"
 #include "foundation/memory/poolallocator.h"
 #include "foundation/utility/lazy.h"
 #include "foundation/utility/uid.h"
@@ -49,6 +50,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 // Forward declarations.
@@ -67,7 +69,8 @@ namespace renderer
 class CurveTree
   : public foundation::bvh::Tree<
                foundation::AlignedVector<
-                   foundation::bvh::Node<GAABB3>
+                   foundation::bvh::Node<GAABB3>,
+                   foundation::LargeAllocator
                >
            >
 {
@@ -91,6 +94,12 @@ class CurveTree
     // Constructor, builds the tree for a given assembly.
     explicit CurveTree(const Arguments& arguments);
 
+    // Destructor.
+    ~CurveTree();
+
+    // Return the size (in bytes) of this object in memory.
+    size_t get_memory_size() const;
+
   private:
     friend class CurveLeafVisitor;
     friend class CurveLeafProbeVisitor;
@@ -101,12 +110,17 @@ class CurveTree
         std::uint32_t       m_curve1_count;
         std::uint32_t       m_curve3_offset;
         std::uint32_t       m_curve3_count;
+        std::uint32_t       m_curve1_packet_offset;
+        std::uint32_t       m_curve3_packet_offset;
     };
 
-    const Arguments         m_arguments;
-    std::vector<Curve1Type> m_curves1;
-    std::vector<Curve3Type> m_curves3;
-    std::vector<CurveKey>   m_curve_keys;
+    const Arguments                                 m_arguments;
+    const std::string                               m_memory_owner;
+    std::vector<Curve1Type>                         m_curves1;
+    std::vector<Curve3Type>                         m_curves3;
+    std::vector<CurveKey>                           m_curve_keys;
+    foundation::AlignedVector<Curve1PacketType>     m_curve1_packets;
+    foundation::AlignedVector<Curve3PacketType>     m_curve3_packets;
 
     void collect_curves(std::vector<GAABB3>& curve_bboxes);
 
@@ -123,6 +137,12 @@ class CurveTree
 
     // Reorder curve keys in leaf nodes so that all degree-1 curve keys come before degree-3 ones.
     void reorder_curve_keys_in_leaf_nodes();
+
+    // Store the curves of each leaf node into curve packets.
+    void build_curve_packets();
+
+    // Return the size (in bytes) of the curve packets.
+    size_t get_curve_packets_memory_size() const;
 };
 
 
@@ -275,35 +295,57 @@ inline bool CurveLeafVisitor::visit(
 {
     const CurveTree::LeafUserData& user_data = node.get_user_data<CurveTree::LeafUserData>();
 
-    size_t curve_index = node.get_item_index();
+    const size_t curve1_index = node.get_item_index();
+    const size_t curve3_index = curve1_index + user_data.m_curve1_count;
     size_t hit_curve_index = ~size_t(0);
     GScalar u, v, t = ray.m_tmax;
 
-    for (std::uint32_t i = 0; i < user_data.m_curve1_count; ++i, ++curve_index)
+    // The curve intersector works with distances scaled by the norm of the ray direction.
+    const GScalar norm_dir = foundation::norm(ray.m_dir);
+
+    for (std::uint32_t i = 0, p = 0; i < user_data.m_curve1_count; i += Curve1PacketType::Size, ++p)
     {
-        const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i];
-        if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+        const Curve1PacketType& packet = m_tree.m_curve1_packets[user_data.m_curve1_packet_offset + p];
+        const size_t mask = packet.cull(m_xfm_matrix, t * norm_dir);
+
+        for (std::uint32_t j = 0; j < Curve1PacketType::Size; ++j)
         {
-            m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve1;
-            m_shading_point.m_ray.m_tmax = static_cast<double>(t);
-            m_shading_point.m_bary[0] = static_cast<float>(u);
-            m_shading_point.m_bary[1] = static_cast<float>(v);
-            hit_curve_index = curve_index;
+            if ((mask & (size_t(1) << j)) == 0)
+                continue;
+
+            const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i + j];
+            if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+            {
+                m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve1;
+                m_shading_point.m_ray.m_tmax = static_cast<double>(t);
+                m_shading_point.m_bary[0] = static_cast<float>(u);
+                m_shading_point.m_bary[1] = static_cast<float>(v);
+                hit_curve_index = curve1_index + i + j;
+            }
         }
     }
 
     FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(curve1_curve_count));
 
-    for (std::uint32_t i = 0; i < user_data.m_curve3_count; ++i, ++curve_index)
+    for (std::uint32_t i = 0, p = 0; i < user_data.m_curve3_count; i += Curve3PacketType::Size, ++p)
     {
-        const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i];
-        if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+        const Curve3PacketType& packet = m_tree.m_curve3_packets[user_data.m_curve3_packet_offset + p];
+        const size_t mask = packet.cull(m_xfm_matrix, t * norm_dir);
+
+        for (std::uint32_t j = 0; j < Curve3PacketType::Size; ++j)
         {
-            m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve3;
-            m_shading_point.m_ray.m_tmax = static_cast<double>(t);
-            m_shading_point.m_bary[0] = static_cast<float>(u);
-            m_shading_point.m_bary[1] = static_cast<float>(v);
-            hit_curve_index = curve_index;
+            if ((mask & (size_t(1) << j)) == 0)
+                continue;
+
+            const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i + j];
+            if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix, u, v, t))
+            {
+                m_shading_point.m_primitive_type = ShadingPoint::PrimitiveCurve3;
+                m_shading_point.m_ray.m_tmax = static_cast<double>(t);
+                m_shading_point.m_bary[0] = static_cast<float>(u);
+                m_shading_point.m_bary[1] = static_cast<float>(v);
+                hit_curve_index = curve3_index + i + j;
+            }
         }
     }
 
@@ -346,27 +388,48 @@ inline bool CurveLeafProbeVisitor::visit(
 {
     const CurveTree::LeafUserData& user_data = node.get_user_data<CurveTree::LeafUserData>();
 
-    for (std::uint32_t i = 0; i < user_data.m_curve1_count; ++i)
+    // The curve intersector works with distances scaled by the norm of the ray direction.
+    const GScalar scaled_tmax = ray.m_tmax * foundation::norm(ray.m_dir);
+
+    for (std::uint32_t i = 0, p = 0; i < user_data.m_curve1_count; i += Curve1PacketType::Size, ++p)
     {
-        const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i];
-        if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix))
+        const Curve1PacketType& packet = m_tree.m_curve1_packets[user_data.m_curve1_packet_offset + p];
+        const size_t mask = packet.cull(m_xfm_matrix, scaled_tmax);
+
+        for (std::uint32_t j = 0; j < Curve1PacketType::Size; ++j)
         {
-            FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + 1));
-            m_hit = true;
-            return false;
+            if ((mask & (size_t(1) << j)) == 0)
+                continue;
+
+            const Curve1Type& curve = m_tree.m_curves1[user_data.m_curve1_offset + i + j];
+            if (Curve1IntersectorType::intersect(curve, ray, m_xfm_matrix))
+            {
+                FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + j + 1));
+                m_hit = true;
+                return false;
+            }
         }
     }
 
     FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(curve1_curve_count));
 
-    for (std::uint32_t i = 0; i < user_data.m_curve3_count; ++i)
+    for (std::uint32_t i = 0, p = 0; i < user_data.m_curve3_count; i += Curve3PacketType::Size, ++p)
     {
-        const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i];
-        if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix))
+        const Curve3PacketType& packet = m_tree.m_curve3_packets[user_data.m_curve3_packet_offset + p];
+        const size_t mask = packet.cull(m_xfm_matrix, scaled_tmax);
+
+        for (std::uint32_t j = 0; j < Curve3PacketType::Size; ++j)
         {
-            FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + 1));
-            m_hit = true;
-            return false;
+            if ((mask & (size_t(1) << j)) == 0)
+                continue;
+
+            const Curve3Type& curve = m_tree.m_curves3[user_data.m_curve3_offset + i + j];
+            if (Curve3IntersectorType::intersect(curve, ray, m_xfm_matrix))
+            {
+                FOUNDATION_BVH_TRAVERSAL_STATS(stats.m_intersected_items.insert(i + j + 1));
+                m_hit = true;
+                return false;
+            }
         }
     }
 
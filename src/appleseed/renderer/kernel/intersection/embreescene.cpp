@@ -39,21 +39,28 @@
 #include "renderer/modeling/object/triangle.h"
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/containers.h"
+#include "renderer/utility/transformsequence.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/area.h"
 #include "foundation/math/fp.h"
 #include "foundation/math/intersection/raytrianglemt.h"
+#include "foundation/math/matrix.h"
 #include "foundation/math/minmax.h"
+#include "foundation/math/quaternion.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
 #include "foundation/platform/sse.h"
+#include "foundation/string/string.h"
 #include "foundation/utility/makevector.h"
 #include "foundation/utility/statistics.h"
 #include "foundation/utility/stopwatch.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 using namespace foundation;
 using namespace renderer;
@@ -67,6 +74,7 @@ class EmbreeGeometryData
   public:
     // Vertex data.
     GVector3*               m_vertices;
+    Vector4f*               m_curve_vertices;       // curve control points (x, y, z, radius)
     unsigned int            m_vertices_count;
     unsigned int            m_vertices_stride;
 
@@ -83,9 +91,14 @@ class EmbreeGeometryData
     RTCGeometryType         m_geometry_type;
     RTCGeometry             m_geometry_handle;
 
+    // Type of the primitives reported in shading points.
+    ShadingPoint::PrimitiveType m_primitive_type;
+
     EmbreeGeometryData()
       : m_vertices(nullptr)
+      , m_curve_vertices(nullptr)
       , m_primitives(nullptr)
+      , m_motion_steps_count(1)
       , m_geometry_handle(nullptr)
     {
     }
@@ -93,6 +106,7 @@ class EmbreeGeometryData
     ~EmbreeGeometryData()
     {
         delete[] m_vertices;
+        delete[] m_curve_vertices;
         delete[] m_primitives;
         rtcReleaseGeometry(m_geometry_handle);
     }
@@ -161,27 +175,147 @@ namespace
         }
     };
 
+    template <typename CurveType>
+    size_t get_curve_count(const CurveObject& object);
+
+    template <>
+    size_t get_curve_count<Curve1Type>(const CurveObject& object)
+    {
+        return object.get_curve1_count();
+    }
+
+    template <>
+    size_t get_curve_count<Curve3Type>(const CurveObject& object)
+    {
+        return object.get_curve3_count();
+    }
+
+    template <typename CurveType>
+    const CurveType& get_curve(const CurveObject& object, const size_t index);
+
+    template <>
+    const Curve1Type& get_curve<Curve1Type>(const CurveObject& object, const size_t index)
+    {
+        return object.get_curve1(index);
+    }
+
+    template <>
+    const Curve3Type& get_curve<Curve3Type>(const CurveObject& object, const size_t index)
+    {
+        return object.get_curve3(index);
+    }
+
+    template <typename CurveType>
     void collect_curve_data(
         const ObjectInstance&   object_instance,
         EmbreeGeometryData&     geometry_data)
     {
-        //const Transformd& transform = object_instance.get_transform();
+        assert(
+            geometry_data.m_geometry_type == RTC_GEOMETRY_TYPE_FLAT_LINEAR_CURVE ||
+            geometry_data.m_geometry_type == RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE);
+
+        // Retrieve object space -> assembly space transform for the object instance.
+        const Transformd::MatrixType& transform =
+            object_instance.get_transform().get_local_to_parent();
 
-        switch(geometry_data.m_geometry_type)
+        // Retrieve the object.
+        const CurveObject& curve_object =
+            static_cast<const CurveObject&>(object_instance.get_object());
+
+        const size_t control_point_count = CurveType::Degree + 1;
+        const size_t curve_count = get_curve_count<CurveType>(curve_object);
+
+        //
+        // Retrieve per vertex data.
+        //
+        const unsigned int vertices_count = static_cast<unsigned int>(curve_count * control_point_count);
+        geometry_data.m_vertices_count = vertices_count;
+        geometry_data.m_vertices_stride = sizeof(Vector4f);
+
+        // Allocate memory for the control points. Keep one extra control point for padding.
+        geometry_data.m_curve_vertices = new Vector4f[vertices_count + 1];
+
+        //
+        // Retrieve per primitive data.
+        //
+        geometry_data.m_primitives = new std::uint32_t[curve_count];
+        geometry_data.m_primitives_stride = sizeof(std::uint32_t);
+        geometry_data.m_primitives_count = curve_count;
+
+        for (size_t i = 0; i < curve_count; ++i)
         {
-        case RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE:
-            //
-            // [Note: Girish] Retrieve data from CurveObject here and push it to geometry_data.
-            //
+            // Retrieve the assembly space curve.
+            const CurveType curve(get_curve<CurveType>(curve_object, i), transform);
 
-            break;
+            for (size_t j = 0; j < control_point_count; ++j)
+            {
+                const GVector3& cp = curve.get_control_point(j);
 
-        default:
-            assert(!"Unsupported geometry type.");
-            break;
+                // Embree expects radii while appleseed curves store widths.
+                geometry_data.m_curve_vertices[i * control_point_count + j] =
+                    Vector4f(cp.x, cp.y, cp.z, 0.5f * curve.get_width(j));
+            }
+
+            // Index of the first control point of the curve.
+            geometry_data.m_primitives[i] = static_cast<std::uint32_t>(i * control_point_count);
         }
     }
 
+    template <typename CurveType>
+    std::unique_ptr<EmbreeGeometryData> create_curve_geometry(
+        RTCDevice               device,
+        const ObjectInstance&   object_instance,
+        const size_t            object_instance_idx,
+        const RTCGeometryType   geometry_type,
+        const ShadingPoint::PrimitiveType primitive_type)
+    {
+        std::unique_ptr<EmbreeGeometryData> geometry_data(new EmbreeGeometryData());
+        geometry_data->m_object_instance_idx = object_instance_idx;
+        geometry_data->m_vis_flags = object_instance.get_vis_flags();
+        geometry_data->m_geometry_type = geometry_type;
+        geometry_data->m_primitive_type = primitive_type;
+
+        // Retrieve curve data.
+        collect_curve_data<CurveType>(object_instance, *geometry_data);
+
+        const RTCGeometry geometry_handle = rtcNewGeometry(device, geometry_type);
+        geometry_data->m_geometry_handle = geometry_handle;
+
+        rtcSetGeometryBuildQuality(
+            geometry_handle,
+            RTCBuildQuality::RTC_BUILD_QUALITY_HIGH);
+
+        // Set control points. (x_pos, y_pos, z_pos, radius)
+        rtcSetSharedGeometryBuffer(
+            geometry_handle,                                    // geometry
+            RTC_BUFFER_TYPE_VERTEX,                             // buffer type
+            0,                                                  // slot
+            RTC_FORMAT_FLOAT4,                                  // format
+            geometry_data->m_curve_vertices,                    // buffer
+            0,                                                  // byte offset
+            geometry_data->m_vertices_stride,                   // byte stride
+            geometry_data->m_vertices_count);                   // item count
+
+        // Set curve indices.
+        rtcSetSharedGeometryBuffer(
+            geometry_handle,                                    // geometry
+            RTC_BUFFER_TYPE_INDEX,                              // buffer type
+            0,                                                  // slot
+            RTC_FORMAT_UINT,                                    // format
+            geometry_data->m_primitives,                        // buffer
+            0,                                                  // byte offset
+            geometry_data->m_primitives_stride,                 // byte stride
+            geometry_data->m_primitives_count);                 // item count
+
+        rtcSetGeometryMask(
+            geometry_handle,
+            geometry_data->m_vis_flags);
+
+        rtcCommitGeometry(geometry_handle);
+
+        return geometry_data;
+    }
+
     // Returns minimal tnear needed to compensate double to float transition of ray fields.
     float get_tnear_offset(const RTCRay& ray)
     {
@@ -230,6 +364,112 @@ namespace
 
         embree_ray.tnear = static_cast<float>(shading_ray.m_tmin) + tnear_offset;
     }
+
+    RTCQuaternionDecomposition make_quaternion_decomposition(const Transformd& transform)
+    {
+        // Use the same scaling, rotation, translation decomposition as appleseed's
+        // transform interpolator so that Embree interpolates instance motion alike.
+        Vector3d scaling, translation;
+        Quaterniond rotation;
+        transform.get_local_to_parent().decompose(scaling, rotation, translation);
+
+        RTCQuaternionDecomposition decomposition;
+        rtcInitQuaternionDecomposition(&decomposition);
+
+        decomposition.scale_x = static_cast<float>(scaling.x);
+        decomposition.scale_y = static_cast<float>(scaling.y);
+        decomposition.scale_z = static_cast<float>(scaling.z);
+
+        decomposition.quaternion_r = static_cast<float>(rotation.s);
+        decomposition.quaternion_i = static_cast<float>(rotation.v.x);
+        decomposition.quaternion_j = static_cast<float>(rotation.v.y);
+        decomposition.quaternion_k = static_cast<float>(rotation.v.z);
+
+        decomposition.translation_x = static_cast<float>(translation.x);
+        decomposition.translation_y = static_cast<float>(translation.y);
+        decomposition.translation_z = static_cast<float>(translation.z);
+
+        return decomposition;
+    }
+
+    void set_instance_transforms(
+        RTCGeometry                 geometry_handle,
+        const TransformSequence&    transform_sequence,
+        const float                 shutter_open_begin_time,
+        const float                 shutter_close_end_time)
+    {
+        if (transform_sequence.size() <= 1)
+        {
+            // Static instance.
+            const Matrix4f m(transform_sequence.get_earliest_transform().get_local_to_parent());
+
+            // Embree expects a column-major 3x4 matrix.
+            const float xfm[12] =
+            {
+                m(0, 0), m(1, 0), m(2, 0),
+                m(0, 1), m(1, 1), m(2, 1),
+                m(0, 2), m(1, 2), m(2, 2),
+                m(0, 3), m(1, 3), m(2, 3)
+            };
+
+            rtcSetGeometryTransform(
+                geometry_handle,
+                0,
+                RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,
+                xfm);
+
+            return;
+        }
+
+        // Embree only supports uniformly spaced time steps over the shutter interval:
+        // resample the transform sequence, using several steps per motion segment.
+        const size_t time_step_count =
+            std::min(
+                (transform_sequence.size() - 1) * EmbreeInstanceTimeStepsPerMotionSegment + 1,
+                EmbreeInstanceMaxTimeStepCount);
+
+        rtcSetGeometryTimeStepCount(
+            geometry_handle,
+            static_cast<unsigned int>(time_step_count));
+
+        float prev_quaternion[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+
+        for (size_t i = 0; i < time_step_count; ++i)
+        {
+            const float time =
+                lerp(
+                    shutter_open_begin_time,
+                    shutter_close_end_time,
+                    static_cast<float>(i) / (time_step_count - 1));
+
+            RTCQuaternionDecomposition decomposition =
+                make_quaternion_decomposition(transform_sequence.evaluate(time));
+
+            // Keep consecutive rotations in the same hemisphere so that Embree
+            // interpolates along the shortest arc.
+            if (i > 0 &&
+                decomposition.quaternion_r * prev_quaternion[0] +
+                decomposition.quaternion_i * prev_quaternion[1] +
+                decomposition.quaternion_j * prev_quaternion[2] +
+                decomposition.quaternion_k * prev_quaternion[3] < 0.0f)
+            {
+                decomposition.quaternion_r = -decomposition.quaternion_r;
+                decomposition.quaternion_i = -decomposition.quaternion_i;
+                decomposition.quaternion_j = -decomposition.quaternion_j;
+                decomposition.quaternion_k = -decomposition.quaternion_k;
+            }
+
+            prev_quaternion[0] = decomposition.quaternion_r;
+            prev_quaternion[1] = decomposition.quaternion_i;
+            prev_quaternion[2] = decomposition.quaternion_j;
+            prev_quaternion[3] = decomposition.quaternion_k;
+
+            rtcSetGeometryTransformQuaternion(
+                geometry_handle,
+                static_cast<unsigned int>(i),
+                &decomposition);
+        }
+    }
 }
 
 
@@ -274,18 +514,25 @@ EmbreeScene::EmbreeScene(const EmbreeScene::Arguments& arguments)
 
     m_geometry_container.reserve(instance_count);
 
+    // Geometry IDs are indices into the geometry container.
+    const auto attach_geometry = [this](std::unique_ptr<EmbreeGeometryData> geometry_data)
+    {
+        rtcAttachGeometryByID(
+            m_scene,
+            geometry_data->m_geometry_handle,
+            static_cast<unsigned int>(m_geometry_container.size()));
+
+        m_geometry_container.push_back(std::move(geometry_data));
+    };
+
+    size_t triangle_geometry_count = 0;
+    size_t curve_geometry_count = 0;
+
     for (size_t instance_idx = 0; instance_idx < instance_count; ++instance_idx)
     {
         const ObjectInstance* object_instance = instance_container.get_by_index(instance_idx);
         assert(object_instance);
 
-        RTCGeometry geometry_handle;
-
-        // Set per instance data.
-        std::unique_ptr<EmbreeGeometryData> geometry_data(new EmbreeGeometryData());
-        geometry_data->m_object_instance_idx = instance_idx;
-        geometry_data->m_vis_flags = object_instance->get_vis_flags();
-
         //
         // Collect geometry data for the instance.
         //
@@ -293,12 +540,17 @@ EmbreeScene::EmbreeScene(const EmbreeScene::Arguments& arguments)
 
         if (strcmp(object_model, MeshObjectFactory().get_model()) == 0)
         {
+            // Set per instance data.
+            std::unique_ptr<EmbreeGeometryData> geometry_data(new EmbreeGeometryData());
+            geometry_data->m_object_instance_idx = instance_idx;
+            geometry_data->m_vis_flags = object_instance->get_vis_flags();
             geometry_data->m_geometry_type = RTC_GEOMETRY_TYPE_TRIANGLE;
+            geometry_data->m_primitive_type = ShadingPoint::PrimitiveTriangle;
 
             // Retrieve triangle data.
             collect_triangle_data(*object_instance, *geometry_data);
 
-            geometry_handle = rtcNewGeometry(
+            const RTCGeometry geometry_handle = rtcNewGeometry(
                 m_device,
                 RTC_GEOMETRY_TYPE_TRIANGLE);
 
@@ -348,57 +600,47 @@ EmbreeScene::EmbreeScene(const EmbreeScene::Arguments& arguments)
                 geometry_data->m_vis_flags);
 
             rtcCommitGeometry(geometry_handle);
+
+            attach_geometry(std::move(geometry_data));
+            ++triangle_geometry_count;
         }
         else if (strcmp(object_model, CurveObjectFactory().get_model()) == 0)
         {
-            geometry_data->m_geometry_type = RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE;
-
-            // Retrieve curve data.
-            collect_curve_data(*object_instance, *geometry_data);
-
-            geometry_handle = rtcNewGeometry(
-                m_device,
-                RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE);
+            const CurveObject& curve_object =
+                static_cast<const CurveObject&>(object_instance->get_object());
 
-            rtcSetGeometryBuildQuality(
-                geometry_handle,
-                RTCBuildQuality::RTC_BUILD_QUALITY_HIGH);
-
-            // Set vertices. (x_pos, y_pos, z_pos, radii)
-            rtcSetSharedGeometryBuffer(
-                geometry_handle,                                // geometry
-                RTC_BUFFER_TYPE_INDEX,                          // buffer type
-                0,                                              // slot
-                RTC_FORMAT_FLOAT4,                              // format
-                geometry_data->m_vertices,                      // buffer
-                0,                                              // byte offset
-                geometry_data->m_vertices_stride,               // byte stride
-                geometry_data->m_vertices_count);               // item count
-
-            // Set vertex indices.
-            rtcSetSharedGeometryBuffer(
-                geometry_handle,                                // geometry
-                RTC_BUFFER_TYPE_INDEX,                          // buffer type
-                0,                                              // slot
-                RTC_FORMAT_UINT4,                               // format
-                geometry_data->m_primitives,                    // buffer
-                0,                                              // byte offset
-                geometry_data->m_primitives_stride,             // byte stride
-                geometry_data->m_primitives_count);             // item count
+            // Degree-1 curves.
+            if (curve_object.get_curve1_count() > 0)
+            {
+                attach_geometry(
+                    create_curve_geometry<Curve1Type>(
+                        m_device,
+                        *object_instance,
+                        instance_idx,
+                        RTC_GEOMETRY_TYPE_FLAT_LINEAR_CURVE,
+                        ShadingPoint::PrimitiveCurve1));
+                ++curve_geometry_count;
+            }
 
+            // Degree-3 curves.
+            if (curve_object.get_curve3_count() > 0)
+            {
+                attach_geometry(
+                    create_curve_geometry<Curve3Type>(
+                        m_device,
+                        *object_instance,
+                        instance_idx,
+                        RTC_GEOMETRY_TYPE_FLAT_BEZIER_CURVE,
+                        ShadingPoint::PrimitiveCurve3));
+                ++curve_geometry_count;
+            }
         }
-        else
-        {
-            // Unsupported object type.
-            continue;
-        }
-
-        rtcAttachGeometryByID(m_scene, geometry_handle, static_cast<unsigned int>(instance_idx));
-        m_geometry_container.push_back(std::move(geometry_data));
     }
 
     rtcCommitScene(m_scene);
 
+    statistics.insert("triangle geometries", triangle_geometry_count);
+    statistics.insert("curve geometries", curve_geometry_count);
     statistics.insert_time("total build time", stopwatch.measure().get_seconds());
 
     RENDERER_LOG_DEBUG("%s",
@@ -429,69 +671,208 @@ void EmbreeScene::intersect(ShadingPoint& shading_point) const
     rtcIntersect1(m_scene, &rayhit, &intersectArgs);
 
     if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
+        read_hit(rayhit, shading_point);
+}
+
+bool EmbreeScene::occlude(const ShadingRay& shading_ray) const
+{
+    RTCRayQueryContext context;
+    rtcInitRayQueryContext(&context);
+
+    RTCOccludedArguments occludedArgs;
+    rtcInitOccludedArguments(&occludedArgs);
+    occludedArgs.context = &context;
+
+    RTCRay ray;
+    shading_ray_to_embree_ray(shading_ray, ray);
+
+    rtcOccluded1(m_scene, &ray, &occludedArgs);
+
+    if (ray.tfar < signed_min<float>())
+        return true;
+
+    return false;
+}
+
+void EmbreeScene::read_hit(
+    const RTCRayHit&        rayhit,
+    ShadingPoint&           shading_point) const
+{
+    assert(rayhit.hit.geomID < m_geometry_container.size());
+
+    const auto& geometry_data = m_geometry_container[rayhit.hit.geomID];
+    assert(geometry_data);
+
+    shading_point.m_object_instance_index = geometry_data->m_object_instance_idx;
+    // TODO: remove regions
+    shading_point.m_primitive_index = rayhit.hit.primID;
+    shading_point.m_primitive_type = geometry_data->m_primitive_type;
+    shading_point.m_ray.m_tmax = rayhit.ray.tfar;
+
+    if (geometry_data->m_primitive_type != ShadingPoint::PrimitiveTriangle)
     {
-        assert(rayhit.hit.geomID < m_geometry_container.size());
+        // Embree reports the curve parameter in u and the signed distance to the
+        // curve axis in v, in [-1, 1]. appleseed curves expect the curve parameter
+        // in v and the position across the ribbon in u, in [0, 1].
+        shading_point.m_bary[0] = saturate(0.5f * (rayhit.hit.v + 1.0f));
+        shading_point.m_bary[1] = rayhit.hit.u;
+        return;
+    }
 
-        const auto& geometry_data = m_geometry_container[rayhit.hit.geomID];
-        assert(geometry_data);
+    shading_point.m_bary[0] = rayhit.hit.u;
+    shading_point.m_bary[1] = rayhit.hit.v;
 
-        shading_point.m_bary[0] = rayhit.hit.u;
-        shading_point.m_bary[1] = rayhit.hit.v;
+    const std::uint32_t v0_idx = geometry_data->m_primitives[rayhit.hit.primID * 3];
+    const std::uint32_t v1_idx = geometry_data->m_primitives[rayhit.hit.primID * 3 + 1];
+    const std::uint32_t v2_idx = geometry_data->m_primitives[rayhit.hit.primID * 3 + 2];
 
-        shading_point.m_object_instance_index = geometry_data->m_object_instance_idx;
-        // TODO: remove regions
-        shading_point.m_primitive_index = rayhit.hit.primID;
-        shading_point.m_primitive_type = ShadingPoint::PrimitiveTriangle;
-        shading_point.m_ray.m_tmax = rayhit.ray.tfar;
+    if (geometry_data->m_motion_steps_count > 1)
+    {
+        const std::uint32_t last_motion_step_idx = geometry_data->m_motion_steps_count - 1;
 
-        const std::uint32_t v0_idx = geometry_data->m_primitives[rayhit.hit.primID * 3];
-        const std::uint32_t v1_idx = geometry_data->m_primitives[rayhit.hit.primID * 3 + 1];
-        const std::uint32_t v2_idx = geometry_data->m_primitives[rayhit.hit.primID * 3 + 2];
+        const std::uint32_t motion_step_begin_idx = static_cast<std::uint32_t>(rayhit.ray.time * last_motion_step_idx);
+        const std::uint32_t motion_step_end_idx = motion_step_begin_idx + 1;
 
-        if (geometry_data->m_motion_steps_count > 1)
-        {
-            const std::uint32_t last_motion_step_idx = geometry_data->m_motion_steps_count - 1;
+        const std::uint32_t motion_step_begin_offset = motion_step_begin_idx * geometry_data->m_vertices_count;
+        const std::uint32_t motion_step_end_offset = motion_step_end_idx * geometry_data->m_vertices_count;
 
-            const std::uint32_t motion_step_begin_idx = static_cast<std::uint32_t>(rayhit.ray.time * last_motion_step_idx);
-            const std::uint32_t motion_step_end_idx = motion_step_begin_idx + 1;
+        const float motion_step_begin_time = static_cast<float>(motion_step_begin_idx) / last_motion_step_idx;
 
-            const std::uint32_t motion_step_begin_offset = motion_step_begin_idx * geometry_data->m_vertices_count;
-            const std::uint32_t motion_step_end_offset = motion_step_end_idx * geometry_data->m_vertices_count;
+        // Linear interpolation coefficients.
+        const float p = (rayhit.ray.time - motion_step_begin_time) * last_motion_step_idx;
+        const float q = 1.0f - p;
 
-            const float motion_step_begin_time = static_cast<float>(motion_step_begin_idx) / last_motion_step_idx;
+        assert(p > 0.0f && p <= 1.0f);
 
-            // Linear interpolation coefficients.
-            const float p = (rayhit.ray.time - motion_step_begin_time) * last_motion_step_idx;
-            const float q = 1.0f - p;
+        const TriangleType triangle(
+            Vector3d(
+                geometry_data->m_vertices[motion_step_begin_offset + v0_idx] * q
+                + geometry_data->m_vertices[motion_step_end_offset + v0_idx] * p),
+            Vector3d(
+                geometry_data->m_vertices[motion_step_begin_offset + v1_idx] * q
+                + geometry_data->m_vertices[motion_step_end_offset + v1_idx] * p),
+            Vector3d(
+                geometry_data->m_vertices[motion_step_begin_offset + v2_idx] * q
+                + geometry_data->m_vertices[motion_step_end_offset + v2_idx] * p));
 
-            assert(p > 0.0f && p <= 1.0f);
+        shading_point.m_triangle_support_plane.initialize(triangle);
+    }
+    else
+    {
+        const TriangleType triangle(
+            Vector3d(geometry_data->m_vertices[v0_idx]),
+            Vector3d(geometry_data->m_vertices[v1_idx]),
+            Vector3d(geometry_data->m_vertices[v2_idx]));
 
-            const TriangleType triangle(
-                Vector3d(
-                    geometry_data->m_vertices[motion_step_begin_offset + v0_idx] * q
-                    + geometry_data->m_vertices[motion_step_end_offset + v0_idx] * p),
-                Vector3d(
-                    geometry_data->m_vertices[motion_step_begin_offset + v1_idx] * q
-                    + geometry_data->m_vertices[motion_step_end_offset + v1_idx] * p),
-                Vector3d(
-                    geometry_data->m_vertices[motion_step_begin_offset + v2_idx] * q
-                    + geometry_data->m_vertices[motion_step_end_offset + v2_idx] * p));
+        shading_point.m_triangle_support_plane.initialize(triangle);
+    }
+}
 
-            shading_point.m_triangle_support_plane.initialize(triangle);
-        }
-        else
-        {
-            const TriangleType triangle(
-                Vector3d(geometry_data->m_vertices[v0_idx]),
-                Vector3d(geometry_data->m_vertices[v1_idx]),
-                Vector3d(geometry_data->m_vertices[v2_idx]));
 
-            shading_point.m_triangle_support_plane.initialize(triangle);
-        }
+//
+//  EmbreeInstanceScene class implementation.
+//
+
+EmbreeInstanceScene::EmbreeInstanceScene(const EmbreeInstanceScene::Arguments& arguments)
+{
+    // Start stopwatch.
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    Statistics statistics;
+
+    const RTCDevice device = arguments.m_device.m_device;
+    m_scene = rtcNewScene(device);
+
+    rtcSetSceneBuildQuality(
+        m_scene,
+        RTCBuildQuality::RTC_BUILD_QUALITY_HIGH);
+
+    const size_t instance_count = arguments.m_instances.size();
+    m_scenes.reserve(instance_count);
+
+    size_t moving_instance_count = 0;
+
+    for (size_t instance_idx = 0; instance_idx < instance_count; ++instance_idx)
+    {
+        const Instance& instance = arguments.m_instances[instance_idx];
+        assert(instance.m_scene);
+        assert(instance.m_transform_sequence);
+
+        const RTCGeometry geometry_handle = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+
+        rtcSetGeometryInstancedScene(geometry_handle, instance.m_scene->m_scene);
+
+        set_instance_transforms(
+            geometry_handle,
+            *instance.m_transform_sequence,
+            arguments.m_shutter_open_begin_time,
+            arguments.m_shutter_close_end_time);
+
+        if (instance.m_transform_sequence->size() > 1)
+            ++moving_instance_count;
+
+        rtcSetGeometryMask(geometry_handle, instance.m_vis_flags);
+
+        rtcCommitGeometry(geometry_handle);
+
+        // Instance IDs are indices into the instance array.
+        rtcAttachGeometryByID(m_scene, geometry_handle, static_cast<unsigned int>(instance_idx));
+
+        // The scene keeps a reference to the geometry.
+        rtcReleaseGeometry(geometry_handle);
+
+        m_scenes.push_back(instance.m_scene);
     }
+
+    rtcCommitScene(m_scene);
+
+    statistics.insert("instances", instance_count);
+    statistics.insert("moving instances", moving_instance_count);
+    statistics.insert_time("total build time", stopwatch.measure().get_seconds());
+
+    RENDERER_LOG_DEBUG("%s",
+        StatisticsVector::make(
+            "Embree instance scene statistics",
+            statistics).to_string().c_str());
 }
 
-bool EmbreeScene::occlude(const ShadingRay& shading_ray) const
+EmbreeInstanceScene::~EmbreeInstanceScene()
+{
+    rtcReleaseScene(m_scene);
+}
+
+size_t EmbreeInstanceScene::intersect(
+    const ShadingRay&       shading_ray,
+    ShadingPoint&           shading_point) const
+{
+    RTCRayQueryContext context;
+    rtcInitRayQueryContext(&context);
+
+    RTCIntersectArguments intersectArgs;
+    rtcInitIntersectArguments(&intersectArgs);
+    intersectArgs.context = &context;
+
+    RTCRayHit rayhit;
+    shading_ray_to_embree_ray(shading_ray, rayhit.ray);
+
+    rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+    rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+
+    rtcIntersect1(m_scene, &rayhit, &intersectArgs);
+
+    if (rayhit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+        return ~size_t(0);
+
+    const size_t instance_idx = rayhit.hit.instID[0];
+    assert(instance_idx < m_scenes.size());
+
+    m_scenes[instance_idx]->read_hit(rayhit, shading_point);
+
+    return instance_idx;
+}
+
+bool EmbreeInstanceScene::occlude(const ShadingRay& shading_ray) const
 {
     RTCRayQueryContext context;
     rtcInitRayQueryContext(&context);
@@ -505,10 +886,7 @@ bool EmbreeScene::occlude(const ShadingRay& shading_ray) const
 
     rtcOccluded1(m_scene, &ray, &occludedArgs);
 
-    if (ray.tfar < signed_min<float>())
-        return true;
-
-    return false;
+    return ray.tfar < signed_min<float>();
 }
 
 EmbreeSceneFactory::EmbreeSceneFactory(const EmbreeScene::Arguments& arguments)
@@ -44,6 +44,8 @@
 #include <embree4/rtcore.h>
 
 // Standard headers.
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <vector>
@@ -52,6 +54,7 @@
 namespace renderer { class Assembly; }
 namespace renderer { class ShadingPoint; }
 namespace renderer { class ShadingRay; }
+namespace renderer { class TransformSequence; }
 
 namespace renderer
 {
@@ -71,6 +74,7 @@ class EmbreeDevice
 
   private:
     friend class EmbreeScene;
+    friend class EmbreeInstanceScene;
 
     RTCDevice m_device;
 };
@@ -100,9 +104,76 @@ class EmbreeScene
     bool occlude(const ShadingRay& shading_ray) const;
 
   private:
+    friend class EmbreeInstanceScene;
+
     RTCDevice                   m_device;
     RTCScene                    m_scene;
     EmbreeGeometryDataContainer m_geometry_container;
+
+    // Fill the shading point from a hit on one of the geometries of this scene.
+    void read_hit(
+        const RTCRayHit&        rayhit,
+        ShadingPoint&           shading_point) const;
+};
+
+
+//
+// Two-level Embree scene.
+//
+// Every assembly instance becomes an Embree instance of the Embree scene of
+// its assembly, so that both assembly-level and object-level traversal happen
+// inside Embree. Motion of assembly instances is expressed with Embree's
+// multi-segment instance transforms.
+//
+
+class EmbreeInstanceScene
+  : public foundation::NonCopyable
+{
+  public:
+    struct Instance
+    {
+        const EmbreeScene*          m_scene;
+        const TransformSequence*    m_transform_sequence;       // prepared, cumulated transform sequence
+        std::uint32_t               m_vis_flags;
+    };
+
+    typedef std::vector<Instance> InstanceVector;
+
+    struct Arguments
+    {
+        const EmbreeDevice&     m_device;
+        const InstanceVector&   m_instances;
+        const float             m_shutter_open_begin_time;
+        const float             m_shutter_close_end_time;
+
+        Arguments(
+            const EmbreeDevice&     embree_device,
+            const InstanceVector&   instances,
+            const float             shutter_open_begin_time,
+            const float             shutter_close_end_time)
+          : m_device(embree_device)
+          , m_instances(instances)
+          , m_shutter_open_begin_time(shutter_open_begin_time)
+          , m_shutter_close_end_time(shutter_close_end_time)
+        {}
+    };
+
+    explicit EmbreeInstanceScene(const Arguments& arguments);
+
+    ~EmbreeInstanceScene();
+
+    // Intersect a world space ray with the scene and store the closest hit in the shading point.
+    // Return the index of the instance that was hit, or ~size_t(0) if nothing was hit.
+    size_t intersect(
+        const ShadingRay&       shading_ray,
+        ShadingPoint&           shading_point) const;
+
+    // Return true if the world space ray hits anything.
+    bool occlude(const ShadingRay& shading_ray) const;
+
+  private:
+    RTCScene                        m_scene;
+    std::vector<const EmbreeScene*> m_scenes;
 };
 
 typedef std::map<
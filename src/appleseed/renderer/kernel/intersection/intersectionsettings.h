@@ -107,11 +107,16 @@ typedef foundation::BezierCurve3<GScalar> Curve3Type;
 typedef foundation::BezierCurveIntersector<Curve1Type> Curve1IntersectorType;
 typedef foundation::BezierCurveIntersector<Curve3Type> Curve3IntersectorType;
 
+// Curve packets used to cull the curves of a leaf four at a time.
+typedef foundation::BezierCurvePacket<Curve1Type> Curve1PacketType;
+typedef foundation::BezierCurvePacket<Curve3Type> Curve3PacketType;
+
 // Matrix used in curve intersections
 typedef foundation::Matrix<GScalar, 4, 4> CurveMatrixType;
 
-// Maximum number of curves per leaf.
-const size_t CurveTreeDefaultMaxLeafSize = 1;
+// Maximum number of curves per leaf. Curves of a leaf are culled against
+// the ray in packets of Curve1PacketType::Size / Curve3PacketType::Size.
+const size_t CurveTreeDefaultMaxLeafSize = 4;
 
 // Relative cost of traversing an interior node.
 const GScalar CurveTreeDefaultInteriorNodeTraversalCost(1.0);
@@ -137,6 +142,14 @@ const size_t CurveTreeStackSize = 64;
 const size_t EmbreeSceneAccessCacheLines = 128;
 const size_t EmbreeSceneAccessCacheWays = 2;
 
+// Number of Embree instance time steps per motion segment of an assembly instance.
+// Embree only supports uniformly spaced time steps, so transform sequences are
+// resampled over the shutter interval.
+const size_t EmbreeInstanceTimeStepsPerMotionSegment = 4;
+
+// Maximum number of time steps of an Embree instance (RTC_MAX_TIME_STEP_COUNT).
+const size_t EmbreeInstanceMaxTimeStepCount = 129;
+
 #endif
 
 //
@@ -91,6 +91,32 @@ namespace
             lhs.get_assembly_instance().get_uid() == rhs.get_assembly_instance().get_uid();
     }
 
+#ifdef APPLESEED_WITH_EMBREE
+
+    // Compute the world space ray to trace through the Embree instance scene.
+    ShadingRay make_embree_instance_ray(
+        const ShadingRay&           ray,
+        const ShadingPoint*         parent_shading_point)
+    {
+        ShadingRay result(ray);
+
+        if (parent_shading_point &&
+            parent_shading_point->get_primitive_type() == ShadingPoint::PrimitiveTriangle)
+        {
+            // Like the built-in traversal, start from the properly offset previous
+            // intersection point, computed in assembly instance space.
+            const Transformd& transform = parent_shading_point->get_assembly_instance_transform();
+            result.m_org =
+                transform.point_to_parent(
+                    parent_shading_point->get_offset_point(
+                        transform.vector_to_local(ray.m_dir)));
+        }
+
+        return result;
+    }
+
+#endif
+
     // Print a message if a self-intersection situation is detected.
     void report_self_intersection(
         const ShadingPoint&         shading_point,
@@ -152,30 +178,54 @@ bool Intersector::trace(
     // Retrieve assembly tree.
     const AssemblyTree& assembly_tree = m_trace_context.get_assembly_tree();
 
-    // Check the intersection between the ray and the assembly tree.
-    AssemblyTreeIntersector intersector;
-    AssemblyLeafVisitor visitor(
-        shading_point,
-        assembly_tree,
-        m_triangle_tree_cache,
-        m_curve_tree_cache,
 #ifdef APPLESEED_WITH_EMBREE
-        m_embree_scene_cache,
+
+    if (assembly_tree.m_embree_instance_scene)
+    {
+        // Let Embree traverse both assembly instances and their geometry.
+        const size_t item_index =
+            assembly_tree.m_embree_instance_scene->intersect(
+                make_embree_instance_ray(ray, parent_shading_point),
+                shading_point);
+
+        if (item_index != ~size_t(0))
+        {
+            const AssemblyTree::Item& item = assembly_tree.m_items[item_index];
+            shading_point.m_assembly_instance = item.m_assembly_instance;
+            shading_point.m_assembly_instance_transform_seq = &item.m_transform_sequence;
+            shading_point.m_assembly_instance_transform =
+                item.m_transform_sequence.evaluate(ray.m_time.m_absolute);
+        }
+    }
+    else
+
 #endif
-        parent_shading_point
+    {
+        // Check the intersection between the ray and the assembly tree.
+        AssemblyTreeIntersector intersector;
+        AssemblyLeafVisitor visitor(
+            shading_point,
+            assembly_tree,
+            m_triangle_tree_cache,
+            m_curve_tree_cache,
+#ifdef APPLESEED_WITH_EMBREE
+            m_embree_scene_cache,
+#endif
+            parent_shading_point
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-        , m_triangle_tree_traversal_stats
+            , m_triangle_tree_traversal_stats
 #endif
-        );
-    intersector.intersect_no_motion(
-        assembly_tree,
-        shading_point.m_ray,
-        ray_info,
-        visitor
+            );
+        intersector.intersect_no_motion(
+            assembly_tree,
+            shading_point.m_ray,
+            ray_info,
+            visitor
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-        , m_assembly_tree_traversal_stats
+            , m_assembly_tree_traversal_stats
 #endif
-        );
+            );
+    }
 
     // Detect and report self-intersections.
     if (m_report_self_intersections)
@@ -210,6 +260,18 @@ bool Intersector::trace_probe(
     // Retrieve assembly tree.
     const AssemblyTree& assembly_tree = m_trace_context.get_assembly_tree();
 
+#ifdef APPLESEED_WITH_EMBREE
+
+    // Let Embree traverse both assembly instances and their geometry.
+    if (assembly_tree.m_embree_instance_scene)
+    {
+        return
+            assembly_tree.m_embree_instance_scene->occlude(
+                make_embree_instance_ray(ray, parent_shading_point));
+    }
+
+#endif
+
     // Check the intersection between the ray and the assembly tree.
     AssemblyTreeProbeIntersector intersector;
     AssemblyLeafProbeVisitor visitor(
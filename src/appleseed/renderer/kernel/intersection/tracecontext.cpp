@@ -93,6 +93,11 @@ void TraceContext::set_use_embree(const bool value)
     m_assembly_tree->set_use_embree(value);
 }
 
+void TraceContext::set_use_embree_instancing(const bool value)
+{
+    m_assembly_tree->set_use_embree_instancing(value);
+}
+
 #endif
 
 }   // namespace renderer
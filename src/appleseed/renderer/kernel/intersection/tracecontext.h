@@ -70,6 +70,7 @@ class APPLESEED_DLLSYMBOL TraceContext
 
 #ifdef APPLESEED_WITH_EMBREE
     void set_use_embree(const bool value);
+    void set_use_embree_instancing(const bool value);
 #endif
 
   private:
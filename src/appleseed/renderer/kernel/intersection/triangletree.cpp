@@ -50,6 +50,7 @@
 #include "renderer/modeling/scene/containers.h"
 #include "renderer/modeling/scene/objectinstance.h"
 #include "renderer/utility/bbox.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/messagecontext.h"
 #include "renderer/utility/paramarray.h"
 
@@ -60,7 +61,7 @@
 #include "foundation/math/transform.h"
 #include "foundation/math/treeoptimizer.h"
 #include "foundation/math/vector.h"
-#include "foundation/memory/alignedallocator.h"
+#include "foundation/memory/largeallocator.h"
 #include "foundation/memory/memory.h"
 #include "foundation/platform/system.h"
 #include "foundation/platform/timers.h"
@@ -395,8 +396,10 @@ TriangleTree::Arguments::Arguments(
 }
 
 TriangleTree::TriangleTree(const Arguments& arguments)
-  : TreeType(AlignedAllocator<void>(System::get_l1_data_cache_line_size()))
+  : TreeType(LargeAllocator<void>(System::get_l1_data_cache_line_size()))
   , m_arguments(arguments)
+  , m_memory_owner(
+        format("{0}/triangle tree #{1}", arguments.m_assembly.get_path(), arguments.m_triangle_tree_uid))
 {
     // Retrieve construction parameters.
     const MessageContext message_context(
@@ -430,6 +433,12 @@ TriangleTree::TriangleTree(const Arguments& arguments)
         StatisticsVector::make(
             "triangle tree #" + to_string(m_arguments.m_triangle_tree_uid) + " statistics",
             statistics).to_string().c_str());
+
+    // Attribute the memory used by the tree to the assembly it was built for.
+    global_memory_tracker().set(
+        MemoryTracker::CategoryTree,
+        m_memory_owner.c_str(),
+        get_memory_size());
 }
 
 TriangleTree::~TriangleTree()
@@ -439,6 +448,8 @@ TriangleTree::~TriangleTree()
         m_arguments.m_triangle_tree_uid);
 
     delete_intersection_filters();
+
+    global_memory_tracker().remove(MemoryTracker::CategoryTree, m_memory_owner.c_str());
 }
 
 void TriangleTree::update_non_geometry(const bool enable_intersection_filters)
@@ -1177,7 +1188,7 @@ namespace
                 filter_key.m_materials.size(),
                 filter_key.m_materials.size() > 1 ? "s" : "",
                 pretty_size(intersection_filter->get_masks_memory_size()).c_str(),
-                pretty_size(intersection_filter->get_masks_memory_size()).c_str(),
+                pretty_size(intersection_filter->get_uv_memory_size()).c_str(),
                 filter_key_hash);
 
             // Store this intersection filter.
@@ -1280,6 +1291,8 @@ void TriangleTree::update_intersection_filters()
         object_instances_to_filter_keys,
         m_intersection_filters_repository,
         m_intersection_filters);
+
+    track_intersection_filters_memory_size();
 }
 
 void TriangleTree::delete_intersection_filters()
@@ -1289,6 +1302,26 @@ void TriangleTree::delete_intersection_filters()
 
     m_intersection_filters_repository.clear();
     m_intersection_filters.clear();
+
+    track_intersection_filters_memory_size();
+}
+
+void TriangleTree::track_intersection_filters_memory_size() const
+{
+    size_t memory_size = 0;
+
+    for (const_each<IntersectionFilterRepository> i = m_intersection_filters_repository; i; ++i)
+    {
+        memory_size +=
+            i->second->get_masks_memory_size() +
+            i->second->get_uv_memory_size();
+    }
+
+    // An empty repository removes the entry.
+    global_memory_tracker().set(
+        MemoryTracker::CategoryTree,
+        (m_memory_owner + "/intersection filters").c_str(),
+        memory_size);
 }
 
 
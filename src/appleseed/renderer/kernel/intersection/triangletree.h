@@ -42,6 +42,7 @@
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/math/aabb.h"
 #include "foundation/math/bvh.h"
+#include "foundation/memory/largeallocator.h"
 #include "foundation/math/ray.h"
 #include "foundation/memory/poolallocator.h"
 #include "foundation/utility/lazy.h"
@@ -52,6 +53,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 // Forward declarations.
@@ -75,7 +77,8 @@ typedef std::map<std::uint64_t, IntersectionFilter*> IntersectionFilterRepositor
 class TriangleTree
   : public foundation::bvh::Tree<
                foundation::AlignedVector<
-                   foundation::bvh::Node<foundation::AABB3d>
+                   foundation::bvh::Node<foundation::AABB3d>,
+                   foundation::LargeAllocator
                >
            >
 {
@@ -116,13 +119,19 @@ class TriangleTree
     friend class TriangleLeafVisitor;
     friend class TriangleLeafProbeVisitor;
 
+    typedef std::vector<
+        std::uint8_t,
+        foundation::LargeAllocator<std::uint8_t>
+    > LeafDataVector;
+
     const Arguments                             m_arguments;
+    const std::string                           m_memory_owner;
 
     size_t                                      m_static_triangle_count;
     size_t                                      m_moving_triangle_count;
 
     std::vector<TriangleKey>                    m_triangle_keys;
-    std::vector<std::uint8_t>                   m_leaf_data;
+    LeafDataVector                              m_leaf_data;
 
     IntersectionFilterRepository                m_intersection_filters_repository;
     std::vector<const IntersectionFilter*>      m_intersection_filters;
@@ -154,6 +163,8 @@ class TriangleTree
 
     void update_intersection_filters();
     void delete_intersection_filters();
+
+    void track_intersection_filters_memory_size() const;
 };
 
 
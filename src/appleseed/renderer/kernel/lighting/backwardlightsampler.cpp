@@ -108,15 +108,15 @@ BackwardLightSampler::BackwardLightSampler(
             }
             else
             {
-                // Insert into non-physical lights to be evaluated using a CDF.
+                // Insert into non-physical lights to be evaluated using an emitter table.
                 const size_t light_index = m_non_physical_lights.size();
                 m_non_physical_lights.push_back(light_info);
 
-                // Insert the light into the CDF.
+                // Insert the light into the emitter table.
                 // todo: compute importance.
                 float importance = 1.0f;
                 importance *= light_info.m_light->get_uncached_importance_multiplier();
-                m_non_physical_lights_cdf.insert(light_index, importance);
+                m_non_physical_lights_table.insert(light_index, importance);
             }
         });
     m_non_physical_light_count = m_non_physical_lights.size();
@@ -148,8 +148,8 @@ BackwardLightSampler::BackwardLightSampler(
                 const float shape_importance = m_params.m_importance_sampling ? area : 1.0f;
                 const float shape_prob = shape_importance * importance_multiplier;
 
-                // Insert the light-emitting shape into the CDF.
-                m_emitting_shapes_cdf.insert(emitting_shape_index, shape_prob);
+                // Insert the light-emitting shape into the emitter table.
+                m_emitting_shapes_table.insert(emitting_shape_index, shape_prob);
 
                 // Accept this shape.
                 return true;
@@ -159,9 +159,9 @@ BackwardLightSampler::BackwardLightSampler(
     // Build the hash table of emitting shapes.
     build_emitting_shape_hash_table();
 
-    // Prepare the non-physical lights CDF for sampling.
-    if (m_non_physical_lights_cdf.valid())
-        m_non_physical_lights_cdf.prepare();
+    // Prepare the non-physical lights table for sampling.
+    if (m_non_physical_lights_table.valid())
+        m_non_physical_lights_table.prepare();
 
     if (m_use_light_tree)
     {
@@ -178,13 +178,13 @@ BackwardLightSampler::BackwardLightSampler(
     }
     else
     {
-        // Prepare the light-emitting shapes CDF for smapling.
-        if (m_emitting_shapes_cdf.valid())
-            m_emitting_shapes_cdf.prepare();
+        // Prepare the light-emitting shapes table for sampling.
+        if (m_emitting_shapes_table.valid())
+            m_emitting_shapes_table.prepare();
 
         // Store the shape probability densities into the emitting shapes.
         for (size_t i = 0, e = m_emitting_shapes.size(); i < e; ++i)
-            m_emitting_shapes[i].m_shape_prob = m_emitting_shapes_cdf[i].second;
+            m_emitting_shapes[i].m_shape_prob = m_emitting_shapes_table[i].second;
     }
 
     RENDERER_LOG_INFO(
@@ -112,7 +112,7 @@ class BackwardLightSampler
 inline bool BackwardLightSampler::has_lights() const
 {
     return
-        m_non_physical_lights_cdf.valid() ||
+        m_non_physical_lights_table.valid() ||
         !m_emitting_shapes.empty() ||
         !m_light_tree_lights.empty();
 }
@@ -64,15 +64,15 @@ ForwardLightSampler::ForwardLightSampler(const Scene& scene, const ParamArray& p
         TransformSequence(),
         [&](const NonPhysicalLightInfo& light_info)
         {
-            // Insert into non-physical lights to be evaluated using a CDF.
+            // Insert into non-physical lights to be evaluated using an emitter table.
             const size_t light_index = m_non_physical_lights.size();
             m_non_physical_lights.push_back(light_info);
 
-            // Insert the light into the CDF.
+            // Insert the light into the emitter table.
             // todo: compute importance.
             float importance = 1.0f;
             importance *= light_info.m_light->get_uncached_importance_multiplier();
-            m_non_physical_lights_cdf.insert(light_index, importance);
+            m_non_physical_lights_table.insert(light_index, importance);
         });
     m_non_physical_light_count = m_non_physical_lights.size();
 
@@ -94,8 +94,8 @@ ForwardLightSampler::ForwardLightSampler(const Scene& scene, const ParamArray& p
             const float shape_importance = m_params.m_importance_sampling ? area : 1.0f;
             const float shape_prob = shape_importance * importance_multiplier;
 
-            // Insert the light-emitting shape into the CDF.
-            m_emitting_shapes_cdf.insert(emitting_shape_index, shape_prob);
+            // Insert the light-emitting shape into the emitter table.
+            m_emitting_shapes_table.insert(emitting_shape_index, shape_prob);
 
             // Accept this shape.
             return true;
@@ -104,15 +104,15 @@ ForwardLightSampler::ForwardLightSampler(const Scene& scene, const ParamArray& p
     // Build the hash table of emitting shapes.
     build_emitting_shape_hash_table();
 
-    // Prepare the CDFs for sampling.
-    if (m_non_physical_lights_cdf.valid())
-        m_non_physical_lights_cdf.prepare();
-    if (m_emitting_shapes_cdf.valid())
-        m_emitting_shapes_cdf.prepare();
+    // Prepare the emitter tables for sampling.
+    if (m_non_physical_lights_table.valid())
+        m_non_physical_lights_table.prepare();
+    if (m_emitting_shapes_table.valid())
+        m_emitting_shapes_table.prepare();
 
     // Store the shape probability densities into the emitting shapes.
     for (size_t i = 0, e = m_emitting_shapes.size(); i < e; ++i)
-        m_emitting_shapes[i].set_shape_prob(m_emitting_shapes_cdf[i].second);
+        m_emitting_shapes[i].set_shape_prob(m_emitting_shapes_table[i].second);
 
    RENDERER_LOG_INFO(
         "found %s %s, %s emitting %s.",
@@ -127,11 +127,11 @@ void ForwardLightSampler::sample(
     const Vector3f&                     s,
     LightSample&                        light_sample) const
 {
-    assert(m_non_physical_lights_cdf.valid() || m_emitting_shapes_cdf.valid());
+    assert(m_non_physical_lights_table.valid() || m_emitting_shapes_table.valid());
 
-    if (m_non_physical_lights_cdf.valid())
+    if (m_non_physical_lights_table.valid())
     {
-        if (m_emitting_shapes_cdf.valid())
+        if (m_emitting_shapes_table.valid())
         {
             if (s[0] < 0.5f)
             {
@@ -177,9 +177,9 @@ void ForwardLightSampler::sample_non_physical_lights(
     const Vector3f&                     s,
     LightSample&                        light_sample) const
 {
-    assert(m_non_physical_lights_cdf.valid());
+    assert(m_non_physical_lights_table.valid());
 
-    const EmitterCDF::ItemWeightPair result = m_non_physical_lights_cdf.sample(s[0]);
+    const EmitterTable::ItemWeightPair result = m_non_physical_lights_table.sample(s[0]);
     const size_t light_index = result.first;
     const float light_prob = result.second;
 
@@ -89,7 +89,7 @@ class ForwardLightSampler
 
 inline bool ForwardLightSampler::has_lights() const
 {
-    return m_non_physical_lights_cdf.valid() || m_emitting_shapes_cdf.valid();
+    return m_non_physical_lights_table.valid() || m_emitting_shapes_table.valid();
 }
 
 }   // namespace renderer
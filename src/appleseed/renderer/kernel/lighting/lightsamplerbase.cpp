@@ -656,10 +656,10 @@ void LightSamplerBase::sample_emitting_shapes(
     const Vector3f&                     s,
     LightSample&                        light_sample) const
 {
-    assert(m_emitting_shapes_cdf.valid());
+    assert(m_emitting_shapes_table.valid());
 
     // Fetch the emitting shape.
-    const EmitterCDF::ItemWeightPair result = m_emitting_shapes_cdf.sample(s[0]);
+    const EmitterTable::ItemWeightPair result = m_emitting_shapes_table.sample(s[0]);
     const size_t emitter_index = result.first;
     const float emitter_prob = result.second;
     const EmittingShape& emitting_shape = m_emitting_shapes[emitter_index];
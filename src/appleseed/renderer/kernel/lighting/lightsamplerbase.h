@@ -36,7 +36,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
-#include "foundation/math/cdf.h"
+#include "foundation/math/aliastable.h"
 
 // Standard headers.
 #include <functional>
@@ -82,7 +82,10 @@ class LightSamplerBase
 
     typedef std::vector<NonPhysicalLightInfo> NonPhysicalLightVector;
     typedef std::vector<EmittingShape> EmittingShapeVector;
-    typedef foundation::CDF<size_t, float> EmitterCDF;
+
+    // Emitters are selected with alias tables so that the cost of a light sample
+    // does not depend on the number of emitters.
+    typedef foundation::AliasTable<size_t, float> EmitterTable;
 
     typedef std::function<void (const NonPhysicalLightInfo&)> LightHandlingFunction;
     typedef std::function<bool (const Material*, const float, const size_t)> ShapeHandlingFunction;
@@ -94,8 +97,8 @@ class LightSamplerBase
 
     size_t                                  m_non_physical_light_count;
 
-    EmitterCDF                              m_non_physical_lights_cdf;
-    EmitterCDF                              m_emitting_shapes_cdf;
+    EmitterTable                            m_non_physical_lights_table;
+    EmitterTable                            m_emitting_shapes_table;
 
     EmittingShapeKeyHasher                  m_shape_key_hasher;
     EmittingShapeHashTable                  m_emitting_shape_hash_table;
@@ -955,10 +955,12 @@ SampleAccumulationBuffer* LightTracingSampleGeneratorFactory::create_sample_accu
 {
     const CanvasProperties& props = m_frame.image().properties();
 
+    // Give each rendering thread its own splat buffer.
     return
         new GlobalSampleAccumulationBuffer(
             props.m_canvas_width,
-            props.m_canvas_height);
+            props.m_canvas_height,
+            get_rendering_thread_count(m_params));
 }
 
 }   // namespace renderer
@@ -39,6 +39,7 @@
 #include "renderer/kernel/shading/shadingcontext.h"
 #include "renderer/kernel/shading/shadingpoint.h"
 #include "renderer/kernel/shading/shadingray.h"
+#include "renderer/kernel/volume/densitygrid.h"
 #include "renderer/modeling/bsdf/bsdf.h"
 #include "renderer/modeling/bsdf/bsdfsample.h"
 #include "renderer/modeling/bssrdf/bssrdf.h"
@@ -131,8 +132,6 @@ class PathTracer
         const ShadingPoint&         shading_point,
         const bool                  clear_arena = true);
 
-    const ShadingPoint& get_path_vertex(const size_t i) const;
-
   private:
     PathVisitor&                    m_path_visitor;
     VolumeVisitor&                  m_volume_visitor;
@@ -795,6 +794,9 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
     const ShadingRay::Medium* medium = ray.get_current_medium();
     const Volume* volume = medium->get_volume();
 
+    // Distances are sampled with delta tracking in volumes defined by a density grid.
+    const DensityGrid* density_grid = volume->get_density_grid();
+
     // Trace the ray across the volume.
     exit_point.clear();
     shading_context.get_intersector().trace(
@@ -857,11 +859,28 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
 
         // Sample distance.
         float distance_sample, distance_pdf;
+        bool escaped = extinction_is_null;
         if (extinction_is_null)
         {
             distance_sample = 0.0f;
             distance_pdf = 0.0f;
         }
+        else if (density_grid != nullptr)
+        {
+            // The probability density depends on the transmission; it is computed below.
+            double t;
+            escaped =
+                !density_grid->sample_collision(
+                    sampling_context,
+                    volume_ray.m_org,
+                    volume_ray.m_dir,
+                    0.0,
+                    volume_ray.m_tmax,
+                    extinction_coef[channel],
+                    t);
+            distance_sample = static_cast<float>(t);
+            distance_pdf = 0.0f;
+        }
         else
         {
             sampling_context.split_in_place(1, 1);
@@ -877,7 +896,7 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
 
         // Continue path tracing if sampled distance exceeds total length of the ray,
         // otherwise process the scattering event.
-        if (extinction_is_null || volume_ray.m_tmax < distance_sample)
+        if (escaped || volume_ray.m_tmax < distance_sample)
         {
             Spectrum transmission;
             volume->evaluate_transmission(
@@ -923,6 +942,15 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
             distance_sample,
             transmission);
 
+        // In volumes defined by a density grid, coefficients scale with the density
+        // and delta tracking samples distances proportionally to extinction * transmission.
+        float density = 1.0f;
+        if (density_grid != nullptr)
+        {
+            density = density_grid->get_density(volume_ray.point_at(distance_sample));
+            distance_pdf = extinction_coef[channel] * density * transmission[channel];
+        }
+
         // Compute MIS weight.
         // MIS terms are:
         //  - scattering albedo,
@@ -935,9 +963,11 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
             if (extinction_coef[i] > 1.0e-6f)
             {
                 const float probability =
-                    foundation::exponential_distribution_pdf(
-                        distance_sample,
-                        extinction_coef[i]);
+                    density_grid != nullptr
+                        ? extinction_coef[i] * density * transmission[i]
+                        : foundation::exponential_distribution_pdf(
+                              distance_sample,
+                              extinction_coef[i]);
                 mis_weights_sum += foundation::square(probability);
             }
         }
@@ -950,7 +980,7 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
 
         vertex.m_throughput *= scattering_coef;
         vertex.m_throughput *= transmission;
-        vertex.m_throughput *= current_mis_weight / distance_pdf;
+        vertex.m_throughput *= density * current_mis_weight / distance_pdf;
 
         // Sample phase function.
         foundation::Vector3f incoming;
@@ -993,10 +1023,4 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
     return true;
 }
 
-template <typename PathVisitor, typename VolumeVisitor, bool Adjoint>
-inline const ShadingPoint& PathTracer<PathVisitor, VolumeVisitor, Adjoint>::get_path_vertex(const size_t i) const
-{
-    return reinterpret_cast<const ShadingPoint*>(m_shading_point_arena.get_storage())[i];
-}
-
 }   // namespace renderer
@@ -332,18 +332,39 @@ const ShadingPoint& Tracer::do_trace_between(
 void Tracer::evaluate_alpha(
     const Material&             material,
     const ShadingPoint&         shading_point,
-    Alpha&                      alpha) const
+    Alpha&                      alpha)
 {
     alpha = shading_point.get_alpha();
 
+    // Nothing more to do if the surface is already fully transparent.
+    if (alpha[0] == 0.0f)
+        return;
+
     // Apply OSL transparency if needed.
     if (const ShaderGroup* sg = material.get_render_data().m_shader_group)
     {
         if (sg->has_transparency())
         {
-            Alpha a;
-            m_shadergroup_exec.execute_shadow(*sg, shading_point, a);
-            alpha *= a;
+            if (sg->is_uniform())
+            {
+                // The transparency of uniform shader groups is the same everywhere:
+                // execute the shader group on the first hit only.
+                const OpacityCacheKey key(sg->get_uid(), sg->get_definition_hash());
+                OpacityCache::const_iterator i = m_opacity_cache.find(key);
+                if (i == m_opacity_cache.end())
+                {
+                    Alpha a;
+                    m_shadergroup_exec.execute_shadow(*sg, shading_point, a);
+                    i = m_opacity_cache.emplace(key, a).first;
+                }
+                alpha *= i->second;
+            }
+            else
+            {
+                Alpha a;
+                m_shadergroup_exec.execute_shadow(*sg, shading_point, a);
+                alpha *= a;
+            }
         }
     }
 }
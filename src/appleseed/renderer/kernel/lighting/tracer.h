@@ -39,14 +39,21 @@
 // appleseed.foundation headers.
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/math/vector.h"
+#include "foundation/utility/uid.h"
+
+// Boost headers.
+#include "boost/unordered/unordered_map.hpp"
 
 // Standard headers.
 #include <cstddef>
+#include <cstdint>
+#include <utility>
 
 // Forward declarations.
 namespace renderer  { class Material;}
 namespace renderer  { class OSLShaderGroupExec; }
 namespace renderer  { class Scene; }
+namespace renderer  { class ShaderGroup; }
 namespace renderer  { class ShadingContext; }
 
 namespace renderer
@@ -58,6 +65,12 @@ namespace renderer
 // point-to-point visibility. It automatically takes into account alpha
 // transparency.
 //
+// The transparency of uniform OSL shader groups (see ShaderGroup::is_uniform())
+// is evaluated once and cached, so that shadow rays crossing many partially
+// transparent surfaces (hair, foliage) don't execute these shaders at every hit.
+// Cache entries are keyed by shader group UID and definition hash: an edited
+// shader group gets a new definition hash and its transparency is evaluated again.
+//
 
 class Tracer
   : public foundation::NonCopyable
@@ -171,6 +184,10 @@ class Tracer
     const size_t                        m_max_iterations;
     ShadingPoint                        m_shading_points[2];
 
+    typedef std::pair<foundation::UniqueID, std::uint64_t> OpacityCacheKey;
+    typedef boost::unordered_map<OpacityCacheKey, Alpha> OpacityCache;
+    OpacityCache                        m_opacity_cache;
+
     const ShadingPoint& do_trace(
         const ShadingContext&           shading_context,
         const ShadingRay&               ray,
@@ -187,7 +204,7 @@ class Tracer
     void evaluate_alpha(
         const Material&                 material,
         const ShadingPoint&             shading_point,
-        Alpha&                          alpha) const;
+        Alpha&                          alpha);
 };
 
 
@@ -35,6 +35,7 @@
 #include "renderer/kernel/lighting/scatteringmode.h"
 #include "renderer/kernel/shading/directshadingcomponents.h"
 #include "renderer/kernel/shading/shadingcontext.h"
+#include "renderer/kernel/volume/densitygrid.h"
 #include "renderer/modeling/light/light.h"
 #include "renderer/modeling/scene/visibilityflags.h"
 #include "renderer/modeling/volume/volume.h"
@@ -46,6 +47,7 @@
 // Standard headers.
 #include <cassert>
 #include <cmath>
+#include <limits>
 
 using namespace foundation;
 
@@ -164,6 +166,10 @@ namespace
 //       DirectLightingIntegrator::take_single_material_sample
 //       DirectLightingIntegrator::add_emitting_shape_sample_contribution
 //       DirectLightingIntegrator::add_non_physical_light_sample_contribution
+//
+//   draw_distance_sample
+//       draw_exponential_sample (homogeneous volumes)
+//       DensityGrid::sample_collision (volumes defined by a density grid)
 
 VolumeLightingIntegrator::VolumeLightingIntegrator(
     const ShadingContext&           shading_context,
@@ -180,6 +186,7 @@ VolumeLightingIntegrator::VolumeLightingIntegrator(
     : m_shading_context(shading_context)
     , m_light_sampler(light_sampler)
     , m_volume(volume)
+    , m_density_grid(volume.get_density_grid())
     , m_volume_ray(volume_ray)
     , m_volume_data(volume_data)
     , m_shading_point(shading_point)
@@ -220,12 +227,13 @@ void VolumeLightingIntegrator::add_single_distance_sample_contribution(
     // Exponential sampling.
     //
 
-    if (extinction_coef[channel] > 0.0f)
+    float exponential_sample;
+    if (extinction_coef[channel] > 0.0f &&
+        draw_distance_sample(sampling_context, extinction_coef[channel], exponential_sample))
     {
-        const float exponential_sample =
-            draw_exponential_sample(sampling_context, m_volume_ray, extinction_coef[channel]);
-        const float exponential_prob =
-            evaluate_exponential_sample(exponential_sample, m_volume_ray, extinction_coef[channel]);
+        Spectrum probabilities;
+        evaluate_distance_sample(exponential_sample, extinction_coef, probabilities);
+        const float exponential_prob = probabilities[channel];
         const float equiangular_prob =
             equiangular_distance_sampler.evaluate(exponential_sample);
 
@@ -235,14 +243,7 @@ void VolumeLightingIntegrator::add_single_distance_sample_contribution(
         for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
         {
             if (extinction_coef[i] > 0.0f)
-            {
-                const float probability =
-                    evaluate_exponential_sample(
-                        exponential_sample,
-                        m_volume_ray,
-                        extinction_coef[i]);
-                mis_weights_sum += square(probability);
-            }
+                mis_weights_sum += square(probabilities[i]);
         }
         const float mis_weight_channel =
             Spectrum::size() *
@@ -286,8 +287,8 @@ void VolumeLightingIntegrator::add_single_distance_sample_contribution(
             equiangular_distance_sampler.sample();
         const float equiangular_prob =
             equiangular_distance_sampler.evaluate(equiangular_sample);
-        const float exponential_prob = evaluate_exponential_sample(
-            equiangular_sample, m_volume_ray, extinction_coef[channel]);
+        const float exponential_prob = evaluate_distance_sample(
+            equiangular_sample, extinction_coef[channel]);
 
         DirectShadingComponents inscattered;
         take_single_direction_sample(
@@ -329,21 +330,19 @@ void VolumeLightingIntegrator::add_single_distance_sample_contribution_exponenti
     if (extinction_coef[channel] == 0.0f)
         return;
 
-    const float exponential_sample = draw_exponential_sample(
-        sampling_context, m_volume_ray, extinction_coef[channel]);
-    const float exponential_prob = evaluate_exponential_sample(
-        exponential_sample, m_volume_ray, extinction_coef[channel]);
+    float exponential_sample;
+    if (!draw_distance_sample(sampling_context, extinction_coef[channel], exponential_sample))
+        return;
+
+    Spectrum probabilities;
+    evaluate_distance_sample(exponential_sample, extinction_coef, probabilities);
+    const float exponential_prob = probabilities[channel];
 
     // Calculate MIS weight for spectral channel sampling (balance heuristic).
     // One-sample estimator is used (Veach: 9.2.4 eq. 9.15).
     float mis_weights_sum = 0.0f;
     for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
-    {
-        const float probability =
-            evaluate_exponential_sample(
-                exponential_sample, m_volume_ray, extinction_coef[i]);
-        mis_weights_sum += square(probability);
-    }
+        mis_weights_sum += square(probabilities[i]);
     const float mis_weight_channel =
         Spectrum::size() *
         square(exponential_prob) /
@@ -583,6 +582,82 @@ void VolumeLightingIntegrator::take_single_direction_sample(
     }
 }
 
+bool VolumeLightingIntegrator::draw_distance_sample(
+    SamplingContext&    sampling_context,
+    const float         extinction,
+    float&              distance) const
+{
+    if (m_density_grid == nullptr)
+    {
+        distance = draw_exponential_sample(sampling_context, m_volume_ray, extinction);
+        return true;
+    }
+
+    // The density grid is bounded: delta tracking terminates on infinite rays.
+    const double tmax =
+        m_volume_ray.is_finite()
+            ? m_volume_ray.m_tmax
+            : std::numeric_limits<double>::max();
+
+    double t;
+    if (!m_density_grid->sample_collision(
+            sampling_context,
+            m_volume_ray.m_org,
+            m_volume_ray.m_dir,
+            0.0,
+            tmax,
+            extinction,
+            t))
+        return false;
+
+    distance = static_cast<float>(t);
+    return true;
+}
+
+void VolumeLightingIntegrator::evaluate_distance_sample(
+    const float         distance,
+    const Spectrum&     extinction_coef,
+    Spectrum&           probabilities) const
+{
+    if (m_density_grid == nullptr)
+    {
+        for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+            probabilities[i] = evaluate_exponential_sample(distance, m_volume_ray, extinction_coef[i]);
+        return;
+    }
+
+    // Delta tracking samples collisions with a probability density equal to the local
+    // extinction coefficient times the transmission from the ray origin.
+    const float density = m_density_grid->get_density(m_volume_ray.point_at(distance));
+    const float optical_depth =
+        m_density_grid->compute_optical_depth(
+            m_volume_ray.m_org,
+            m_volume_ray.m_dir,
+            0.0,
+            static_cast<double>(distance));
+
+    for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+        probabilities[i] = extinction_coef[i] * density * std::exp(-extinction_coef[i] * optical_depth);
+}
+
+float VolumeLightingIntegrator::evaluate_distance_sample(
+    const float         distance,
+    const float         extinction) const
+{
+    if (m_density_grid == nullptr)
+        return evaluate_exponential_sample(distance, m_volume_ray, extinction);
+
+    const float density = m_density_grid->get_density(m_volume_ray.point_at(distance));
+    const float optical_depth =
+        m_density_grid->compute_optical_depth(
+            m_volume_ray.m_org,
+            m_volume_ray.m_dir,
+            0.0,
+            static_cast<double>(distance));
+
+    return extinction * density * std::exp(-extinction * optical_depth);
+}
+
 float VolumeLightingIntegrator::draw_exponential_sample(
     SamplingContext&    sampling_context,
     const ShadingRay&   volume_ray,
@@ -41,6 +41,7 @@
 
 // Forward declarations.
 namespace renderer  { class BackwardLightSampler; }
+namespace renderer  { class DensityGrid; }
 namespace renderer  { class DirectShadingComponents; }
 namespace renderer  { class LightSample; }
 namespace renderer  { class ShadingContext; }
@@ -57,6 +58,10 @@ namespace renderer
 // Combines exponential importance sampling (based on Beer's law) and
 // equiangular sampling (based on proximity to light sources).
 //
+// In volumes defined by a density grid, exponential sampling is replaced by
+// delta tracking, which samples distances proportionally to the local extinction
+// times the transmission.
+//
 // For more information:
 //
 //   Importance Sampling Techniques for Path Tracing in Participating Media
@@ -101,6 +106,7 @@ class VolumeLightingIntegrator
     const BackwardLightSampler&         m_light_sampler;
     const ShadingRay::Time&             m_time;
     const Volume&                       m_volume;
+    const DensityGrid*                  m_density_grid;
     const ShadingRay&                   m_volume_ray;
     const void*                         m_volume_data;
     const ShadingPoint&                 m_shading_point;
@@ -130,6 +136,25 @@ class VolumeLightingIntegrator
         DirectShadingComponents&        radiance,
         const bool                      sample_phasefunction) const;
 
+    // Draw a distance sample with exponential sampling or, in volumes defined by
+    // a density grid, with delta tracking. Return false if delta tracking didn't
+    // find any collision along the ray.
+    bool draw_distance_sample(
+        SamplingContext&                sampling_context,
+        const float                     extinction,
+        float&                          distance) const;
+
+    // Evaluate the probability density of a distance sample for every spectral channel.
+    void evaluate_distance_sample(
+        const float                     distance,
+        const Spectrum&                 extinction_coef,
+        Spectrum&                       probabilities) const;
+
+    // Evaluate the probability density of a distance sample for a single spectral channel.
+    float evaluate_distance_sample(
+        const float                     distance,
+        const float                     extinction) const;
+
     float draw_exponential_sample(
         SamplingContext&                sampling_context,
         const ShadingRay&               volume_ray,
@@ -33,15 +33,13 @@
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
 #include "renderer/global/globaltypes.h"
+#include "renderer/kernel/rendering/pixelcontext.h"
 #include "renderer/kernel/shading/shadingresult.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/vector.h"
 #include "foundation/utility/statistics.h"
 
-// Forward declarations.
-namespace renderer  { class PixelContext; }
-
 using namespace foundation;
 
 namespace renderer
@@ -76,6 +74,25 @@ namespace
             shading_result.m_main.set(0.0f);
         }
 
+        void render_samples(
+            const size_t                sample_count,
+            SamplingContext             sampling_contexts[],
+            const PixelContext          pixel_contexts[],
+            const Vector2d              image_points[],
+            AOVAccumulatorContainer&    aov_accumulators,
+            ShadingResult               shading_results[]) override
+        {
+            for (size_t i = 0; i < sample_count; ++i)
+            {
+                render_sample(
+                    sampling_contexts[i],
+                    pixel_contexts[i],
+                    image_points[i],
+                    aov_accumulators,
+                    shading_results[i]);
+            }
+        }
+
         StatisticsVector get_statistics() const override
         {
             return StatisticsVector();
@@ -66,7 +66,7 @@ ShadingResultFrameBuffer* EphemeralShadingResultFrameBufferFactory::create(
         new ShadingResultFrameBuffer(
             tile.get_width(),
             tile.get_height(),
-            frame.aov_images().size(),
+            ShadingResultFrameBuffer::Layout(frame),
             tile_bbox);
 
     framebuffer->clear();
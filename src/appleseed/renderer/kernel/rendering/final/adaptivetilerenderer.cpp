@@ -54,6 +54,7 @@
 #include "foundation/image/image.h"
 #include "foundation/image/tile.h"
 #include "foundation/math/aabb.h"
+#include "foundation/math/bluenoise.h"
 #include "foundation/math/fastmath.h"
 #include "foundation/math/filtersamplingtable.h"
 #include "foundation/math/ordering.h"
@@ -343,7 +344,7 @@ namespace
                 new ShadingResultFrameBuffer(
                     tile.get_width(),
                     tile.get_height(),
-                    frame.aov_images().size(),
+                    framebuffer->get_layout(),
                     tile_bbox));
 
             if (m_params.m_pass_count > 1)
@@ -616,6 +617,7 @@ namespace
         struct Parameters
         {
             const SamplingContext::Mode         m_sampling_mode;
+            const bool                          m_blue_noise;
             const size_t                        m_batch_size;
             const size_t                        m_min_samples;
             const size_t                        m_max_samples;
@@ -625,6 +627,7 @@ namespace
 
             explicit Parameters(const ParamArray& params)
               : m_sampling_mode(get_sampling_context_mode(params))
+              , m_blue_noise(m_sampling_mode == SamplingContext::SobolMode && get_sampling_blue_noise(params))
               , m_batch_size(params.get_required<size_t>("batch_size", 16))
               , m_min_samples(params.get_required<size_t>("min_samples", 0))
               , m_max_samples(params.get_required<size_t>("max_samples", 256))
@@ -800,6 +803,12 @@ namespace
                             static_cast<std::uint32_t>(
                                 pass_hash + pixel_index + (pb.m_spp * frame_width * frame_height)));
 
+                    // With blue noise sampling, all pixels of a batch share the same scrambled sequence.
+                    const size_t sequence_instance =
+                        m_params.m_blue_noise
+                            ? hash_uint32(static_cast<std::uint32_t>(pass_hash + pb.m_spp))
+                            : instance;
+
                     // Render this pixel.
                     sample_pixel(
                         frame,
@@ -809,6 +818,7 @@ namespace
                         second_framebuffer,
                         pass_hash,
                         instance,
+                        sequence_instance,
                         batch_size,
                         aov_count);
                 }
@@ -825,6 +835,7 @@ namespace
             ShadingResultFrameBuffer*           second_framebuffer,
             const std::uint32_t                 pass_hash,
             const size_t                        instance,
+            const size_t                        sequence_instance,
             const size_t                        batch_size,
             const size_t                        aov_count)
         {
@@ -836,7 +847,9 @@ namespace
                 m_params.m_sampling_mode,
                 2,                          // number of dimensions
                 0,                          // number of samples -- unknown
-                instance);                  // initial instance number
+                sequence_instance);         // initial instance number
+            if (m_params.m_blue_noise)
+                sampling_context.set_screen_offset(blue_noise<double>(pi.x, pi.y));
 
             for (size_t i = 0; i < batch_size; ++i)
             {
@@ -50,6 +50,7 @@
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/math/aabb.h"
+#include "foundation/math/bluenoise.h"
 #include "foundation/math/filtersamplingtable.h"
 #include "foundation/math/population.h"
 #include "foundation/math/scalar.h"
@@ -144,7 +145,8 @@ namespace
 
             on_pixel_begin(frame, pi, pt, tile_bbox, aov_accumulators);
 
-            // Create a sampling context.
+            // Create a sampling context. With blue noise sampling, all pixels share
+            // the same scrambled sequence, rotated by the blue noise mask.
             const size_t frame_width = frame.image().properties().m_canvas_width;
             const size_t pixel_index = pi.y * frame_width + pi.x;
             const size_t instance = hash_uint32(static_cast<std::uint32_t>(pass_hash + pixel_index));
@@ -154,7 +156,9 @@ namespace
                 m_params.m_sampling_mode,
                 2,                          // number of dimensions
                 0,                          // number of samples -- unknown
-                instance);                  // initial instance number
+                m_params.m_blue_noise ? pass_hash : instance);  // initial instance number
+            if (m_params.m_blue_noise)
+                sampling_context.set_screen_offset(blue_noise<double>(pi.x, pi.y));
 
             const ROI roi(
                 pi.x,
@@ -240,12 +244,14 @@ namespace
         struct Parameters
         {
             const SamplingContext::Mode     m_sampling_mode;
+            const bool                      m_blue_noise;
             const size_t                    m_min_samples;
             const size_t                    m_max_samples;
             const bool                      m_force_aa;
 
             explicit Parameters(const ParamArray& params)
               : m_sampling_mode(get_sampling_context_mode(params))
+              , m_blue_noise(m_sampling_mode == SamplingContext::SobolMode && get_sampling_blue_noise(params))
               , m_min_samples(params.get_required<size_t>("min_samples", 0))
               , m_max_samples(params.get_required<size_t>("max_samples", 64))
               , m_force_aa(params.get_optional<bool>("force_antialiasing", false))
@@ -51,6 +51,7 @@
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/math/aabb.h"
+#include "foundation/math/bluenoise.h"
 #include "foundation/math/filtersamplingtable.h"
 #include "foundation/math/population.h"
 #include "foundation/math/scalar.h"
@@ -59,8 +60,12 @@
 #include "foundation/utility/statistics.h"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <deque>
+#include <vector>
 
 using namespace foundation;
 
@@ -85,7 +90,14 @@ namespace
           : m_params(params)
           , m_sample_renderer(factory->create(thread_index))
           , m_sample_count(m_params.m_samples)
+          , m_deferred_shading_results(
+                m_params.m_wavefront
+                    ? std::max(m_params.m_wavefront_batch_size, m_params.m_samples)    // a batch holds at least one pixel
+                    : 0)
         {
+            for (ShadingResult& shading_result : m_deferred_shading_results)
+                shading_result.m_aov_count = frame.aov_images().size();
+
             const size_t sample_aov_index = frame.aovs().get_index("pixel_sample_count");
 
             // If the sample count AOV is enabled, we need to reset its normalization
@@ -110,13 +122,30 @@ namespace
             RENDERER_LOG_INFO(
                 "uniform pixel renderer settings:\n"
                 "  samples                       %s\n"
-                "  force anti-aliasing           %s",
+                "  force anti-aliasing           %s\n"
+                "  wavefront                     %s",
                 pretty_uint(m_params.m_samples).c_str(),
-                m_params.m_force_aa ? "on" : "off");
+                m_params.m_force_aa ? "on" : "off",
+                m_params.m_wavefront
+                    ? ("on, batches of " + pretty_uint(m_params.m_wavefront_batch_size) + " samples").c_str()
+                    : "off");
 
             m_sample_renderer->print_settings();
         }
 
+        void on_tile_begin(
+            const Frame&                frame,
+            const size_t                tile_x,
+            const size_t                tile_y,
+            Tile&                       tile,
+            TileStack&                  aov_tiles) override
+        {
+            PixelRendererBase::on_tile_begin(frame, tile_x, tile_y, tile, aov_tiles);
+
+            // Drop pixels left over from an aborted tile.
+            clear_deferred_pixels();
+        }
+
         void render_pixel(
             const Frame&                frame,
             Tile&                       tile,
@@ -128,38 +157,28 @@ namespace
             AOVAccumulatorContainer&    aov_accumulators,
             ShadingResultFrameBuffer&   framebuffer) override
         {
+            if (m_params.m_wavefront)
+            {
+                // Render the current batch if this pixel doesn't fit in it.
+                if (!m_deferred_pixels.empty() &&
+                    m_deferred_image_points.size() + m_sample_count > m_params.m_wavefront_batch_size)
+                    flush_pixels(frame, tile_bbox, aov_accumulators, framebuffer);
+
+                defer_pixel(frame, pass_hash, pi, pt);
+                return;
+            }
+
             const size_t aov_count = frame.aov_images().size();
 
             on_pixel_begin(frame, pi, pt, tile_bbox, aov_accumulators);
 
-            // Create a sampling context.
-            const size_t frame_width = frame.image().properties().m_canvas_width;
-            const size_t pixel_index = pi.y * frame_width + pi.x;
-            const size_t instance = hash_uint32(static_cast<std::uint32_t>(pass_hash + pixel_index));
-            SamplingContext::RNGType rng(pass_hash, instance);
-            SamplingContext sampling_context(
-                rng,
-                m_params.m_sampling_mode,
-                2,                          // number of dimensions
-                0,                          // number of samples -- unknown
-                instance);                  // initial instance number
+            SamplingContext::RNGType rng(pass_hash, get_pixel_instance(frame, pass_hash, pi));
+            SamplingContext sampling_context = create_sampling_context(rng, pass_hash, pi, frame);
 
             for (size_t i = 0, e = m_sample_count; i < e; ++i)
             {
-                // Generate a uniform sample in [0,1)^2.
-                const Vector2f s =
-                    m_sample_count > 1 || m_params.m_force_aa
-                        ? sampling_context.next2<Vector2f>()
-                        : Vector2f(0.5f);
-
-                // Sample the pixel filter.
-                const auto& filter_table = frame.get_filter_sampling_table();
-                const Vector2d pf(
-                    static_cast<double>(filter_table.sample(s[0]) + 0.5f),
-                    static_cast<double>(filter_table.sample(s[1]) + 0.5f));
-
                 // Compute the sample position in NDC.
-                const Vector2d sample_position = frame.get_sample_position(pi.x + pf.x, pi.y + pf.y);
+                const Vector2d sample_position = next_sample_position(frame, sampling_context, pi);
 
                 // Create a pixel context that identifies the pixel and sample currently being rendered.
                 const PixelContext pixel_context(pi, sample_position);
@@ -186,6 +205,47 @@ namespace
             on_pixel_end(frame, pi, pt, tile_bbox, aov_accumulators);
         }
 
+        void flush_pixels(
+            const Frame&                frame,
+            const AABB2i&               tile_bbox,
+            AOVAccumulatorContainer&    aov_accumulators,
+            ShadingResultFrameBuffer&   framebuffer) override
+        {
+            if (m_deferred_pixels.empty())
+                return;
+
+            // Render all the samples of the batch at once.
+            m_sample_renderer->render_samples(
+                m_deferred_image_points.size(),
+                m_deferred_sampling_contexts.data(),
+                m_deferred_pixel_contexts.data(),
+                m_deferred_image_points.data(),
+                aov_accumulators,
+                m_deferred_shading_results.data());
+
+            // Merge the samples into the framebuffer, pixel by pixel.
+            for (const DeferredPixel& pixel : m_deferred_pixels)
+            {
+                on_pixel_begin(frame, pixel.m_pi, pixel.m_pt, tile_bbox, aov_accumulators);
+
+                for (size_t i = pixel.m_first_sample, e = i + m_sample_count; i < e; ++i)
+                {
+                    // Update sampling statistics.
+                    m_total_sampling_dim.insert(m_deferred_sampling_contexts[i].get_total_dimension());
+
+                    // Merge the sample into the framebuffer.
+                    const ShadingResult& shading_result = m_deferred_shading_results[i];
+                    if (shading_result.is_valid())
+                        framebuffer.add(Vector2u(pixel.m_pt), shading_result);
+                    else signal_invalid_sample();
+                }
+
+                on_pixel_end(frame, pixel.m_pi, pixel.m_pt, tile_bbox, aov_accumulators);
+            }
+
+            clear_deferred_pixels();
+        }
+
         StatisticsVector get_statistics() const override
         {
             Statistics stats;
@@ -207,21 +267,133 @@ namespace
         struct Parameters
         {
             const SamplingContext::Mode     m_sampling_mode;
+            const bool                      m_blue_noise;
             const size_t                    m_samples;
             const bool                      m_force_aa;
+            const bool                      m_wavefront;
+            const size_t                    m_wavefront_batch_size;
 
             explicit Parameters(const ParamArray& params)
               : m_sampling_mode(get_sampling_context_mode(params))
+              , m_blue_noise(m_sampling_mode == SamplingContext::SobolMode && get_sampling_blue_noise(params))
               , m_samples(params.get_required<size_t>("samples", 64))
               , m_force_aa(params.get_optional<bool>("force_antialiasing", false))
+              , m_wavefront(params.get_optional<bool>("wavefront", false))
+              , m_wavefront_batch_size(params.get_optional<size_t>("wavefront_batch_size", 1024))
             {
             }
         };
 
+        // A pixel whose samples are waiting to be rendered.
+        struct DeferredPixel
+        {
+            Vector2i                        m_pi;
+            Vector2i                        m_pt;
+            size_t                          m_first_sample;
+        };
+
         const Parameters                    m_params;
         auto_release_ptr<ISampleRenderer>   m_sample_renderer;
         const size_t                        m_sample_count;
         Population<std::uint64_t>           m_total_sampling_dim;
+
+        // Wavefront rendering. The random number generators of deferred pixels
+        // are kept in a deque since sampling contexts reference them.
+        std::vector<DeferredPixel>              m_deferred_pixels;
+        std::deque<SamplingContext::RNGType>    m_deferred_rngs;
+        std::vector<SamplingContext>            m_deferred_sampling_contexts;
+        std::vector<PixelContext>               m_deferred_pixel_contexts;
+        std::vector<Vector2d>                   m_deferred_image_points;
+        std::vector<ShadingResult>              m_deferred_shading_results;     // preallocated, not copyable
+
+        size_t get_pixel_instance(
+            const Frame&                frame,
+            const std::uint32_t         pass_hash,
+            const Vector2i&             pi) const
+        {
+            const size_t frame_width = frame.image().properties().m_canvas_width;
+            const size_t pixel_index = pi.y * frame_width + pi.x;
+            return hash_uint32(static_cast<std::uint32_t>(pass_hash + pixel_index));
+        }
+
+        SamplingContext create_sampling_context(
+            SamplingContext::RNGType&   rng,
+            const std::uint32_t         pass_hash,
+            const Vector2i&             pi,
+            const Frame&                frame) const
+        {
+            // With blue noise sampling, all pixels share the same scrambled sequence,
+            // rotated by the blue noise mask.
+            SamplingContext sampling_context(
+                rng,
+                m_params.m_sampling_mode,
+                2,                          // number of dimensions
+                0,                          // number of samples -- unknown
+                m_params.m_blue_noise ? pass_hash : get_pixel_instance(frame, pass_hash, pi));  // initial instance number
+            if (m_params.m_blue_noise)
+                sampling_context.set_screen_offset(blue_noise<double>(pi.x, pi.y));
+
+            return sampling_context;
+        }
+
+        // Return the position in NDC of the next sample of a pixel.
+        Vector2d next_sample_position(
+            const Frame&                frame,
+            SamplingContext&            sampling_context,
+            const Vector2i&             pi) const
+        {
+            // Generate a uniform sample in [0,1)^2.
+            const Vector2f s =
+                m_sample_count > 1 || m_params.m_force_aa
+                    ? sampling_context.next2<Vector2f>()
+                    : Vector2f(0.5f);
+
+            // Sample the pixel filter.
+            const auto& filter_table = frame.get_filter_sampling_table();
+            const Vector2d pf(
+                static_cast<double>(filter_table.sample(s[0]) + 0.5f),
+                static_cast<double>(filter_table.sample(s[1]) + 0.5f));
+
+            // Compute the sample position in NDC.
+            return frame.get_sample_position(pi.x + pf.x, pi.y + pf.y);
+        }
+
+        void defer_pixel(
+            const Frame&                frame,
+            const std::uint32_t         pass_hash,
+            const Vector2i&             pi,
+            const Vector2i&             pt)
+        {
+            assert(m_deferred_image_points.size() + m_sample_count <= m_deferred_shading_results.size());
+
+            DeferredPixel pixel;
+            pixel.m_pi = pi;
+            pixel.m_pt = pt;
+            pixel.m_first_sample = m_deferred_image_points.size();
+            m_deferred_pixels.push_back(pixel);
+
+            m_deferred_rngs.emplace_back(pass_hash, get_pixel_instance(frame, pass_hash, pi));
+            SamplingContext sampling_context = create_sampling_context(m_deferred_rngs.back(), pass_hash, pi, frame);
+
+            for (size_t i = 0, e = m_sample_count; i < e; ++i)
+            {
+                const Vector2d sample_position = next_sample_position(frame, sampling_context, pi);
+
+                m_deferred_sampling_contexts.push_back(sampling_context);
+                m_deferred_pixel_contexts.emplace_back(pi, sample_position);
+                m_deferred_shading_results[m_deferred_image_points.size()].clear();
+                m_deferred_image_points.push_back(sample_position);
+            }
+        }
+
+        void clear_deferred_pixels()
+        {
+            m_deferred_pixels.clear();
+            m_deferred_rngs.clear();
+            m_deferred_sampling_contexts.clear();
+            m_deferred_pixel_contexts.clear();
+            m_deferred_image_points.clear();
+        }
     };
 }
 
@@ -252,6 +424,24 @@ Dictionary UniformPixelRendererFactory::get_params_metadata()
                 "help",
                 "When using 1 sample/pixel and Force Anti-Aliasing is disabled, samples are placed at the center of pixels"));
 
+    metadata.dictionaries().insert(
+        "wavefront",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Wavefront Rendering")
+            .insert(
+                "help",
+                "Trace the primary rays of a batch of pixels first, then shade the hits grouped by material for better cache coherence"));
+
+    metadata.dictionaries().insert(
+        "wavefront_batch_size",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "1024")
+            .insert("label", "Wavefront Batch Size")
+            .insert("help", "Number of samples rendered together in wavefront mode"));
+
     return metadata;
 }
 
@@ -263,6 +453,16 @@ UniformPixelRendererFactory::UniformPixelRendererFactory(
   , m_factory(factory)
   , m_params(params)
 {
+    // These AOVs measure pixels while their samples are being rendered, which
+    // doesn't happen anymore when samples of different pixels are interleaved.
+    if (m_params.get_optional<bool>("wavefront", false) &&
+        (frame.aovs().get_index("pixel_time") != ~size_t(0) ||
+         frame.aovs().get_index("invalid_samples") != ~size_t(0)))
+    {
+        RENDERER_LOG_WARNING(
+            "wavefront rendering is not compatible with the pixel time and invalid samples aovs, disabling it.");
+        m_params.insert("wavefront", false);
+    }
 }
 
 void UniformPixelRendererFactory::release()
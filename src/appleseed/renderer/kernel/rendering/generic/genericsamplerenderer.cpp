@@ -49,25 +49,31 @@
 #include "renderer/kernel/texturing/texturecache.h"
 #include "renderer/modeling/camera/camera.h"
 #include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/material/material.h"
 #include "renderer/modeling/scene/scene.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/color.h"
 #include "foundation/image/image.h"
 #include "foundation/image/regularspectrum.h"
+#include "foundation/math/population.h"
 #include "foundation/math/vector.h"
 #include "foundation/memory/arena.h"
 #include "foundation/string/string.h"
 #include "foundation/utility/statistics.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <string>
+#include <vector>
 
 // Forward declarations.
 namespace renderer  { class PixelContext; }
+namespace renderer  { class ShaderGroup; }
 
 using namespace foundation;
 
@@ -186,90 +192,16 @@ namespace
                   return;
                 }
 
-            ShadingPoint shading_points[2];
-            size_t shading_point_index = 0;
-            const ShadingPoint* shading_point_ptr = nullptr;
-            size_t iterations = 0;
-
             // Inform the AOV accumulators that we are about to render a sample.
             aov_accumulators.on_sample_begin(pixel_context);
 
-            while (true)
-            {
-                // Put a hard limit on the number of iterations.
-                if (++iterations >= m_params.m_max_iterations)
-                {
-                    RENDERER_LOG_WARNING(
-                        "reached hard iteration limit (%s), breaking primary ray trace loop.",
-                        pretty_int(m_params.m_max_iterations).c_str());
-                    break;
-                }
-
-                m_arena.clear();
-
-                // Trace the ray.
-                shading_points[shading_point_index].clear();
-                m_intersector.trace(
-                    primary_ray,
-                    shading_points[shading_point_index],
-                    shading_point_ptr);
-
-                // Update the pointers to the shading points.
-                shading_point_ptr = &shading_points[shading_point_index];
-                shading_point_index = 1 - shading_point_index;
-
-                if (iterations == 1)
-                {
-                    // Shade the first intersection point along the ray.
-                    const bool terminate_path =
-                        m_shading_engine.shade(
-                            sampling_context,
-                            pixel_context,
-                            m_shading_context,
-                            *shading_point_ptr,
-                            aov_accumulators,
-                            shading_result);
-
-                    if (terminate_path)
-                        break;
-                }
-                else
-                {
-                    // Shade the next intersection point along the ray.
-                    ShadingResult local_result(shading_result.m_aov_count);
-                    const bool terminate_path =
-                        m_shading_engine.shade(
-                            sampling_context,
-                            pixel_context,
-                            m_shading_context,
-                            *shading_point_ptr,
-                            aov_accumulators,
-                            local_result);
-
-                    // Composite `shading_result` over `local_result`.
-                    shading_result.composite_over(local_result);
-
-                    if (terminate_path)
-                        break;
-                }
-
-                // Stop once we hit the environment.
-                if (!shading_point_ptr->hit_surface())
-                    break;
-
-                // Stop once we hit full opacity.
-                if (shading_result.m_main.a > m_opacity_threshold)
-                    break;
-
-                // Move the ray origin to the intersection point.
-                primary_ray.m_org = shading_point_ptr->get_point();
-                if (primary_ray.m_has_differentials)
-                {
-                    const double t = shading_point_ptr->get_distance();
-                    primary_ray.m_rx_org = primary_ray.m_rx_org + t * primary_ray.m_rx_dir;
-                    primary_ray.m_ry_org = primary_ray.m_ry_org + t * primary_ray.m_ry_dir;
-                }
-            }
+            shade_primary_ray(
+                sampling_context,
+                pixel_context,
+                primary_ray,
+                nullptr,
+                aov_accumulators,
+                shading_result);
 
             // Inform the AOV accumulators that we are done rendering a sample.
             aov_accumulators.on_sample_end(pixel_context);
@@ -298,9 +230,103 @@ namespace
 #endif
         }
 
+        void render_samples(
+            const size_t                sample_count,
+            SamplingContext             sampling_contexts[],
+            const PixelContext          pixel_contexts[],
+            const Vector2d              image_points[],
+            AOVAccumulatorContainer&    aov_accumulators,
+            ShadingResult               shading_results[]) override
+        {
+            if (m_batch_hits.size() < sample_count)
+            {
+                m_batch_rays.resize(sample_count);
+                m_batch_hits.resize(sample_count);
+            }
+
+            m_batch_entries.clear();
+
+            // Spawn and trace all primary rays first.
+            for (size_t i = 0; i < sample_count; ++i)
+            {
+                ShadingRay& primary_ray = m_batch_rays[i];
+                if (!m_scene.get_render_data().m_active_camera->spawn_ray(
+                        sampling_contexts[i],
+                        Dual2d(image_points[i], m_image_point_dx, m_image_point_dy),
+                        primary_ray))
+                {
+                    shading_results[i].m_main.set(0.0f);
+                    shading_results[i].m_main.a = 1.0f;
+                    continue;
+                }
+
+                ShadingPoint& hit = m_batch_hits[i];
+                hit.clear();
+                m_intersector.trace(primary_ray, hit);
+
+                BatchEntry entry;
+                entry.m_material = hit.hit_surface() ? hit.get_material() : nullptr;
+                entry.m_shader_group =
+                    entry.m_material != nullptr
+                        ? entry.m_material->get_render_data().m_shader_group
+                        : nullptr;
+                entry.m_index = i;
+                m_batch_entries.push_back(entry);
+            }
+
+            // Group the intersections that will run the same shading code. Sorting is
+            // stable so that samples of the same group remain in screen space order.
+            std::stable_sort(m_batch_entries.begin(), m_batch_entries.end());
+
+            // Shade the intersections one group at a time.
+            size_t shading_group_count = 0;
+            for (size_t i = 0, e = m_batch_entries.size(); i < e; ++i)
+            {
+                const BatchEntry& entry = m_batch_entries[i];
+
+                if (i == 0 || m_batch_entries[i - 1] < entry)
+                    ++shading_group_count;
+
+                const size_t index = entry.m_index;
+
+                aov_accumulators.on_sample_begin(pixel_contexts[index]);
+
+                shade_primary_ray(
+                    sampling_contexts[index],
+                    pixel_contexts[index],
+                    m_batch_rays[index],
+                    &m_batch_hits[index],
+                    aov_accumulators,
+                    shading_results[index]);
+
+                aov_accumulators.on_sample_end(pixel_contexts[index]);
+            }
+
+            m_batch_size.insert(sample_count);
+            m_batch_shading_groups.insert(shading_group_count);
+        }
+
         StatisticsVector get_statistics() const override
         {
             StatisticsVector stats;
+
+            if (m_batch_size.get_size() > 0)
+            {
+                Statistics wavefront_stats;
+                wavefront_stats.insert("batch size", m_batch_size);
+                wavefront_stats.insert("shading groups per batch", m_batch_shading_groups);
+                stats.insert("wavefront statistics", wavefront_stats);
+            }
+
+            // Populations merge across rendering threads into per-thread averages and extremes.
+            Population<std::uint64_t> arena_peak_size, arena_block_count;
+            arena_peak_size.insert(m_arena.get_peak_size());
+            arena_block_count.insert(m_arena.get_block_count());
+            Statistics arena_stats;
+            arena_stats.insert("peak size", arena_peak_size, "bytes");
+            arena_stats.insert("blocks", arena_block_count);
+            stats.insert("shading arena statistics", arena_stats);
+
             stats.merge(m_texture_cache.get_statistics());
             stats.merge(m_intersector.get_statistics());
             stats.merge(m_lighting_engine->get_statistics());
@@ -308,6 +334,22 @@ namespace
         }
 
       private:
+        // A sample of a wavefront batch, ordered by the shading code it will run.
+        struct BatchEntry
+        {
+            const ShaderGroup*      m_shader_group;
+            const Material*         m_material;
+            size_t                  m_index;
+
+            bool operator<(const BatchEntry& rhs) const
+            {
+                return
+                    m_shader_group != rhs.m_shader_group
+                        ? std::less<const ShaderGroup*>()(m_shader_group, rhs.m_shader_group)
+                        : std::less<const Material*>()(m_material, rhs.m_material);
+            }
+        };
+
         struct Parameters
         {
             const float     m_transparency_threshold;
@@ -339,6 +381,114 @@ namespace
 
         Vector2d                    m_image_point_dx;
         Vector2d                    m_image_point_dy;
+
+        // Wavefront rendering.
+        std::vector<ShadingRay>     m_batch_rays;
+        std::vector<ShadingPoint>   m_batch_hits;
+        std::vector<BatchEntry>     m_batch_entries;
+        Population<std::uint64_t>   m_batch_size;
+        Population<std::uint64_t>   m_batch_shading_groups;
+
+        // Shade the intersections along a primary ray until full opacity is reached.
+        // If `first_hit` is not null, it is used as the first intersection along the ray.
+        void shade_primary_ray(
+            SamplingContext&            sampling_context,
+            const PixelContext&         pixel_context,
+            ShadingRay&                 primary_ray,
+            const ShadingPoint*         first_hit,
+            AOVAccumulatorContainer&    aov_accumulators,
+            ShadingResult&              shading_result)
+        {
+            ShadingPoint shading_points[2];
+            size_t shading_point_index = 0;
+            const ShadingPoint* shading_point_ptr = nullptr;
+            size_t iterations = 0;
+
+            while (true)
+            {
+                // Put a hard limit on the number of iterations.
+                if (++iterations >= m_params.m_max_iterations)
+                {
+                    RENDERER_LOG_WARNING(
+                        "reached hard iteration limit (%s), breaking primary ray trace loop.",
+                        pretty_int(m_params.m_max_iterations).c_str());
+                    break;
+                }
+
+                m_arena.clear();
+
+                if (iterations == 1 && first_hit != nullptr)
+                {
+                    // The first intersection has already been found.
+                    shading_point_ptr = first_hit;
+                }
+                else
+                {
+                    // Trace the ray.
+                    shading_points[shading_point_index].clear();
+                    m_intersector.trace(
+                        primary_ray,
+                        shading_points[shading_point_index],
+                        shading_point_ptr);
+
+                    // Update the pointers to the shading points.
+                    shading_point_ptr = &shading_points[shading_point_index];
+                    shading_point_index = 1 - shading_point_index;
+                }
+
+                if (iterations == 1)
+                {
+                    // Shade the first intersection point along the ray.
+                    const bool terminate_path =
+                        m_shading_engine.shade(
+                            sampling_context,
+                            pixel_context,
+                            m_shading_context,
+                            *shading_point_ptr,
+                            aov_accumulators,
+                            shading_result);
+
+                    if (terminate_path)
+                        break;
+                }
+                else
+                {
+                    // Shade the next intersection point along the ray.
+                    ShadingResult local_result(shading_result.m_aov_count);
+                    const bool terminate_path =
+                        m_shading_engine.shade(
+                            sampling_context,
+                            pixel_context,
+                            m_shading_context,
+                            *shading_point_ptr,
+                            aov_accumulators,
+                            local_result);
+
+                    // Composite `shading_result` over `local_result`.
+                    shading_result.composite_over(local_result);
+
+                    if (terminate_path)
+                        break;
+                }
+
+                // Stop once we hit the environment.
+                if (!shading_point_ptr->hit_surface())
+                    break;
+
+                // Stop once we hit full opacity.
+                if (shading_result.m_main.a > m_opacity_threshold)
+                    break;
+
+                // Move the ray origin to the intersection point.
+                primary_ray.m_org = shading_point_ptr->get_point();
+                if (primary_ray.m_has_differentials)
+                {
+                    const double t = shading_point_ptr->get_distance();
+                    primary_ray.m_rx_org = primary_ray.m_rx_org + t * primary_ray.m_rx_dir;
+                    primary_ray.m_ry_org = primary_ray.m_ry_org + t * primary_ray.m_ry_dir;
+                }
+            }
+        }
     };
 }
 
@@ -31,30 +31,89 @@
 #include "globalsampleaccumulationbuffer.h"
 
 // appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
 #include "renderer/kernel/rendering/sample.h"
 #include "renderer/modeling/frame/frame.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
-#include "foundation/image/color.h"
 #include "foundation/image/image.h"
 #include "foundation/image/pixel.h"
 #include "foundation/image/tile.h"
+#include "foundation/string/string.h"
 #include "foundation/utility/job/iabortswitch.h"
+#include "foundation/utility/job/ijob.h"
+#include "foundation/utility/job/jobmanager.h"
+#include "foundation/utility/job/jobqueue.h"
 
 // Boost headers.
 #include "boost/chrono/duration.hpp"
 
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
 using namespace foundation;
 
 namespace renderer
 {
 
+//
+// GlobalSampleAccumulationBuffer::ReduceSplatTilesJob class implementation.
+//
+
+class GlobalSampleAccumulationBuffer::ReduceSplatTilesJob
+  : public IJob
+{
+  public:
+    ReduceSplatTilesJob(
+        GlobalSampleAccumulationBuffer& buffer,
+        const size_t                    tile_begin,
+        const size_t                    tile_end)
+      : m_buffer(buffer)
+      , m_tile_begin(tile_begin)
+      , m_tile_end(tile_end)
+    {
+    }
+
+    void execute(const size_t thread_index) override
+    {
+        m_buffer.reduce_splat_tiles(m_tile_begin, m_tile_end);
+    }
+
+  private:
+    GlobalSampleAccumulationBuffer&     m_buffer;
+    const size_t                        m_tile_begin;
+    const size_t                        m_tile_end;
+};
+
+
+//
+// GlobalSampleAccumulationBuffer class implementation.
+//
+
 GlobalSampleAccumulationBuffer::GlobalSampleAccumulationBuffer(
     const size_t    width,
-    const size_t    height)
+    const size_t    height,
+    const size_t    splat_buffer_count,
+    const size_t    max_splat_memory_size)
   : m_fb(width, height, 3)
+  , m_splat_tile_count_x((width + SplatTileSize - 1) / SplatTileSize)
+  , m_splat_tile_count_y((height + SplatTileSize - 1) / SplatTileSize)
+  , m_max_splat_tile_count(max_splat_memory_size / (SplatTileSize * SplatTileSize * 3 * sizeof(float)))
+  , m_splat_buffers(splat_buffer_count)
+  , m_splat_tile_count(0)
+{
+    for (SplatBuffer& splat_buffer : m_splat_buffers)
+        splat_buffer.resize(m_splat_tile_count_x * m_splat_tile_count_y);
+}
+
+GlobalSampleAccumulationBuffer::~GlobalSampleAccumulationBuffer()
 {
+    RENDERER_LOG_DEBUG(
+        "global sample accumulation buffer used %s in splat buffers.",
+        pretty_size(m_splat_tile_count * SplatTileSize * SplatTileSize * 3 * sizeof(float)).c_str());
 }
 
 void GlobalSampleAccumulationBuffer::clear()
@@ -65,9 +124,12 @@ void GlobalSampleAccumulationBuffer::clear()
     m_sample_count = 0;
 
     m_fb.clear();
+
+    free_splat_buffers();
 }
 
 void GlobalSampleAccumulationBuffer::store_samples(
+    const size_t    generator_index,
     const size_t    sample_count,
     const Sample    samples[],
     IAbortSwitch&   abort_switch)
@@ -82,6 +144,15 @@ void GlobalSampleAccumulationBuffer::store_samples(
             break;
     }
 
+    // Sample generators without a splat buffer fall back to atomic additions.
+    SplatBuffer* splat_buffer =
+        generator_index < m_splat_buffers.size()
+            ? &m_splat_buffers[generator_index]
+            : nullptr;
+
+    const size_t width = m_fb.get_width();
+    const size_t height = m_fb.get_height();
+
     size_t counter = 0;
 
     const Sample* sample_end = samples + sample_count;
@@ -90,7 +161,27 @@ void GlobalSampleAccumulationBuffer::store_samples(
         if ((counter++ & 4096) == 0 && abort_switch.is_aborted())
             return;
 
-        m_fb.atomic_add(Vector2u(s->m_pixel_coords), &s->m_color[0]);
+        const Vector2u pi(s->m_pixel_coords);
+
+        if (splat_buffer != nullptr && pi.x < width && pi.y < height)
+        {
+            const size_t tile_x = pi.x / SplatTileSize;
+            const size_t tile_y = pi.y / SplatTileSize;
+            float* tile = get_splat_tile(*splat_buffer, tile_y * m_splat_tile_count_x + tile_x);
+
+            if (tile != nullptr)
+            {
+                const size_t x = pi.x - tile_x * SplatTileSize;
+                const size_t y = pi.y - tile_y * SplatTileSize;
+                float* ptr = tile + (y * SplatTileSize + x) * 3;
+                ptr[0] += s->m_color[0];
+                ptr[1] += s->m_color[1];
+                ptr[2] += s->m_color[2];
+                continue;
+            }
+        }
+
+        m_fb.atomic_add(pi, &s->m_color[0]);
     }
 }
 
@@ -108,6 +199,8 @@ void GlobalSampleAccumulationBuffer::develop_to_frame(
             break;
     }
 
+    reduce_splat_buffers();
+
     Image& image = frame.image();
     const CanvasProperties& frame_props = image.properties();
 
@@ -139,6 +232,115 @@ void GlobalSampleAccumulationBuffer::increment_sample_count(const std::uint64_t
     m_sample_count += delta_sample_count;
 }
 
+void GlobalSampleAccumulationBuffer::reduce_splat_buffers()
+{
+    if (m_splat_tile_count == 0)
+        return;
+
+    // Reduce one row of splat tiles per job, using as many threads as there are splat buffers.
+    JobQueue job_queue;
+    for (size_t ty = 0; ty < m_splat_tile_count_y; ++ty)
+    {
+        job_queue.schedule(
+            new ReduceSplatTilesJob(
+                *this,
+                ty * m_splat_tile_count_x,
+                (ty + 1) * m_splat_tile_count_x));
+    }
+
+    JobManager job_manager(
+        global_logger(),
+        job_queue,
+        std::min(m_splat_buffers.size(), m_splat_tile_count_y));
+
+    job_manager.start();
+    job_queue.wait_until_completion();
+}
+
+Color3f GlobalSampleAccumulationBuffer::get_pixel(
+    const size_t    x,
+    const size_t    y) const
+{
+    const float* ptr = m_fb.pixel(x, y);
+    return Color3f(ptr[1], ptr[2], ptr[3]);
+}
+
+float* GlobalSampleAccumulationBuffer::get_splat_tile(
+    SplatBuffer&    splat_buffer,
+    const size_t    tile_index)
+{
+    std::unique_ptr<float[]>& tile = splat_buffer[tile_index];
+
+    if (!tile)
+    {
+        // Reserve a tile within the memory budget.
+        size_t tile_count = m_splat_tile_count;
+        do
+        {
+            if (tile_count >= m_max_splat_tile_count)
+                return nullptr;
+        } while (!m_splat_tile_count.compare_exchange_weak(tile_count, tile_count + 1));
+
+        tile.reset(new float[SplatTileSize * SplatTileSize * 3]);
+        std::memset(tile.get(), 0, SplatTileSize * SplatTileSize * 3 * sizeof(float));
+    }
+
+    return tile.get();
+}
+
+void GlobalSampleAccumulationBuffer::free_splat_buffers()
+{
+    for (SplatBuffer& splat_buffer : m_splat_buffers)
+    {
+        for (std::unique_ptr<float[]>& tile : splat_buffer)
+            tile.reset();
+    }
+
+    m_splat_tile_count = 0;
+}
+
+void GlobalSampleAccumulationBuffer::reduce_splat_tiles(
+    const size_t    tile_begin,
+    const size_t    tile_end)
+{
+    const size_t width = m_fb.get_width();
+    const size_t height = m_fb.get_height();
+
+    for (size_t tile_index = tile_begin; tile_index < tile_end; ++tile_index)
+    {
+        const size_t origin_x = (tile_index % m_splat_tile_count_x) * SplatTileSize;
+        const size_t origin_y = (tile_index / m_splat_tile_count_x) * SplatTileSize;
+        const size_t tile_width = std::min(SplatTileSize, width - origin_x);
+        const size_t tile_height = std::min(SplatTileSize, height - origin_y);
+
+        for (SplatBuffer& splat_buffer : m_splat_buffers)
+        {
+            float* tile = splat_buffer[tile_index].get();
+
+            if (tile == nullptr)
+                continue;
+
+            for (size_t y = 0; y < tile_height; ++y)
+            {
+                const float* src = tile + y * SplatTileSize * 3;
+                float* dest = m_fb.pixel(origin_x, origin_y + y);
+
+                for (size_t x = 0; x < tile_width; ++x)
+                {
+                    dest[1] += src[0];
+                    dest[2] += src[1];
+                    dest[3] += src[2];
+                    dest += 4;
+                    src += 3;
+                }
+            }
+
+            // Keep the tile allocated since it is likely to be used again.
+            std::memset(tile, 0, SplatTileSize * SplatTileSize * 3 * sizeof(float));
+        }
+    }
+}
+
 void GlobalSampleAccumulationBuffer::develop_to_tile(
     Tile&           tile,
     const size_t    origin_x,
@@ -34,12 +34,16 @@
 
 // appleseed.foundation headers.
 #include "foundation/image/accumulatortile.h"
+#include "foundation/image/color.h"
+#include "foundation/platform/atomic.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/thread.h"
 
 // Standard headers.
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
@@ -50,20 +54,40 @@ namespace renderer      { class Sample; }
 namespace renderer
 {
 
+//
+// A sample accumulation buffer covering the whole frame, used when samples may
+// land anywhere in the frame (e.g. light tracing).
+//
+// Samples stored by the first few sample generators are splatted without atomics
+// into private, lazily allocated, tiled buffers (one per sample generator). These
+// splat buffers are reduced into the shared framebuffer, in parallel, when the
+// buffer is developed. Samples from other generators, or stored once the splat
+// memory budget is exhausted, are atomically added to the shared framebuffer.
+//
+
 class GlobalSampleAccumulationBuffer
   : public SampleAccumulationBuffer
 {
   public:
+    // Default maximum amount of memory used by splat buffers, in bytes.
+    static const size_t DefaultMaxSplatMemorySize = 512 * 1024 * 1024;
+
     // Constructor.
     GlobalSampleAccumulationBuffer(
         const size_t                width,
-        const size_t                height);
+        const size_t                height,
+        const size_t                splat_buffer_count = 0,
+        const size_t                max_splat_memory_size = DefaultMaxSplatMemorySize);
+
+    // Destructor.
+    ~GlobalSampleAccumulationBuffer() override;
 
     // Reset the buffer to its initial state. Thread-safe.
     void clear() override;
 
     // Store a set of samples into the buffer. Thread-safe.
     void store_samples(
+        const size_t                generator_index,
         const size_t                sample_count,
         const Sample                samples[],
         foundation::IAbortSwitch&   abort_switch) override;
@@ -76,9 +100,41 @@ class GlobalSampleAccumulationBuffer
     // Increment the number of samples used for pixel values renormalization. Thread-safe.
     void increment_sample_count(const std::uint64_t delta_sample_count);
 
+    // Add the contents of the splat buffers to the shared framebuffer and reset them.
+    // Not thread-safe. Exposed for tests and benchmarks.
+    void reduce_splat_buffers();
+
+    // Read the accumulated color of a pixel, excluding samples still held in splat buffers.
+    // Not thread-safe. Exposed for tests and benchmarks.
+    foundation::Color3f get_pixel(
+        const size_t                x,
+        const size_t                y) const;
+
   private:
+    class ReduceSplatTilesJob;
+
+    // Size in pixels of a square splat tile.
+    static const size_t SplatTileSize = 32;
+
+    typedef std::vector<std::unique_ptr<float[]>> SplatBuffer;
+
     boost::shared_mutex             m_mutex;
     foundation::AccumulatorTile     m_fb;
+    const size_t                    m_splat_tile_count_x;
+    const size_t                    m_splat_tile_count_y;
+    const size_t                    m_max_splat_tile_count;
+    std::vector<SplatBuffer>        m_splat_buffers;
+    boost::atomic<size_t>           m_splat_tile_count;
+
+    float* get_splat_tile(
+        SplatBuffer&                splat_buffer,
+        const size_t                tile_index);
+
+    void free_splat_buffers();
+
+    void reduce_splat_tiles(
+        const size_t                tile_begin,
+        const size_t                tile_end);
 
     void develop_to_tile(
         foundation::Tile&           tile,
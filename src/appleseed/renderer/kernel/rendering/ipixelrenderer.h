@@ -88,6 +88,15 @@ class IPixelRenderer
         AOVAccumulatorContainer&    aov_accumulators,
         ShadingResultFrameBuffer&   framebuffer) = 0;
 
+    // Finish rendering the pixels whose rendering was deferred, if any. This method
+    // is called once all pixels of a tile have been submitted to render_pixel(),
+    // before the framebuffer gets developed to the tile.
+    virtual void flush_pixels(
+        const Frame&                frame,
+        const foundation::AABB2i&   tile_bbox,
+        AOVAccumulatorContainer&    aov_accumulators,
+        ShadingResultFrameBuffer&   framebuffer) = 0;
+
     // Retrieve performance statistics.
     virtual foundation::StatisticsVector get_statistics() const = 0;
 
@@ -68,6 +68,17 @@ class ISampleRenderer
         AOVAccumulatorContainer&        aov_accumulators,
         ShadingResult&                  shading_result) = 0;
 
+    // Render a batch of samples. Samples may be rendered in any order, but each
+    // sample is completely rendered between the on_sample_begin() and on_sample_end()
+    // notifications of the AOV accumulators.
+    virtual void render_samples(
+        const size_t                    sample_count,
+        SamplingContext                 sampling_contexts[],
+        const PixelContext              pixel_contexts[],
+        const foundation::Vector2d      image_points[],
+        AOVAccumulatorContainer&        aov_accumulators,
+        ShadingResult                   shading_results[]) = 0;
+
     // Retrieve performance statistics.
     virtual foundation::StatisticsVector get_statistics() const = 0;
 };
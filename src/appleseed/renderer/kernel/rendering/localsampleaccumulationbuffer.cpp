@@ -45,6 +45,8 @@
 #include "foundation/image/tile.h"
 #include "foundation/math/scalar.h"
 #include "foundation/platform/atomic.h"
+#include "foundation/platform/compiler.h"
+#include "foundation/platform/thread.h"
 #include "foundation/platform/timers.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/job/iabortswitch.h"
@@ -60,6 +62,27 @@ using namespace foundation;
 namespace renderer
 {
 
+namespace
+{
+    // Add the content of a level to another one and clear the source level.
+    void move_samples(AccumulatorTile& dest, AccumulatorTile& source)
+    {
+        assert(dest.get_pixel_count() == source.get_pixel_count());
+        assert(dest.get_channel_count() == source.get_channel_count());
+
+        float* APPLESEED_RESTRICT dest_ptr = dest.pixel(0);
+        float* APPLESEED_RESTRICT source_ptr = source.pixel(0);
+
+        const size_t value_count = dest.get_pixel_count() * (dest.get_channel_count() + 1);
+
+        for (size_t i = 0; i < value_count; ++i)
+        {
+            dest_ptr[i] += source_ptr[i];
+            source_ptr[i] = 0.0f;
+        }
+    }
+}
+
 //
 // LocalSampleAccumulationBuffer class implementation.
 //
@@ -77,6 +100,13 @@ namespace renderer
 //   pushing samples to and the level that is displayed. As soon as a level contains enough
 //   samples, it becomes the new active level.
 //
+//   To prevent the display from stalling sample generators, the pyramid is double-buffered.
+//   Writers store samples into the levels of the current epoch. To develop the buffer, the
+//   display starts a new epoch, waits for the writers still storing samples into the levels
+//   of the previous epoch to be done, and moves the content of these levels to the read levels
+//   which accumulate samples from all past epochs. Writers never wait on the display; the display
+//   only waits for the completion of store_samples() calls that were already in progress.
+//
 
 // #define PRINT_DETAILED_PERF_REPORTS
 
@@ -91,7 +121,8 @@ LocalSampleAccumulationBuffer::LocalSampleAccumulationBuffer(
 
     while (true)
     {
-        m_levels.push_back(new AccumulatorTile(level_width, level_height, 4));
+        m_levels[0].push_back(new AccumulatorTile(level_width, level_height, 4));
+        m_levels[1].push_back(new AccumulatorTile(level_width, level_height, 4));
         m_read_levels.push_back(new AccumulatorTile(level_width, level_height, 4));
         m_level_scales.push_back(
             Vector2f(
@@ -105,7 +136,7 @@ LocalSampleAccumulationBuffer::LocalSampleAccumulationBuffer(
         level_height = std::max(level_height / 2, MinSize);
     }
 
-    m_remaining_pixels = new boost::atomic<std::int32_t>[m_levels.size()];
+    m_remaining_pixels = new boost::atomic<std::int32_t>[m_read_levels.size()];
 
     clear();
 }
@@ -114,9 +145,10 @@ LocalSampleAccumulationBuffer::~LocalSampleAccumulationBuffer()
 {
     delete[] m_remaining_pixels;
 
-    for (size_t i = 0, e = m_levels.size(); i < e; ++i)
+    for (size_t i = 0, e = m_read_levels.size(); i < e; ++i)
     {
-        delete m_levels[i];
+        delete m_levels[0][i];
+        delete m_levels[1][i];
         delete m_read_levels[i];
     }
 }
@@ -129,6 +161,7 @@ void LocalSampleAccumulationBuffer::clear()
 #endif
 
     // Request exclusive access.
+    boost::mutex::scoped_lock develop_lock(m_develop_mutex);
     LockType::ScopedWriteLock lock(m_lock);
 
 #ifdef PRINT_DETAILED_PERF_REPORTS
@@ -138,18 +171,24 @@ void LocalSampleAccumulationBuffer::clear()
 
     m_sample_count = 0;
 
-    for (size_t i = 0, e = m_levels.size(); i < e; ++i)
+    for (size_t i = 0, e = m_read_levels.size(); i < e; ++i)
     {
-        m_levels[i]->clear();
+        m_levels[0][i]->clear();
+        m_levels[1][i]->clear();
+        m_read_levels[i]->clear();
 
         m_remaining_pixels[i] =
-            static_cast<std::int32_t>(m_levels[i]->get_pixel_count());
+            static_cast<std::int32_t>(m_read_levels[i]->get_pixel_count());
     }
 
-    m_active_level = static_cast<std::uint32_t>(m_levels.size() - 1);
+    m_active_level = static_cast<std::uint32_t>(m_read_levels.size() - 1);
+    m_epoch = 0;
+    m_writer_count[0] = 0;
+    m_writer_count[1] = 0;
 }
 
 void LocalSampleAccumulationBuffer::store_samples(
+    const size_t            generator_index,
     const size_t            sample_count,
     const Sample            samples[],
     IAbortSwitch&           abort_switch)
@@ -173,11 +212,25 @@ void LocalSampleAccumulationBuffer::store_samples(
         RENDERER_LOG_DEBUG("store_samples: acquiring lock: %f", sw.get_seconds() * 1000.0);
 #endif
 
+        // Enter the current epoch. If a new epoch started in the meantime, the display
+        // may already be reading the levels of the epoch we entered, so try again.
+        std::uint32_t epoch;
+        while (true)
+        {
+            epoch = m_epoch;
+            ++m_writer_count[epoch & 1];
+            if (m_epoch == epoch)
+                break;
+            --m_writer_count[epoch & 1];
+        }
+
+        const LevelVector& levels = m_levels[epoch & 1];
+
         // Store samples at every level, starting with the highest resolution level up to the active level.
         size_t counter = 0;
         for (std::uint32_t i = 0, e = m_active_level; i <= e; ++i)
         {
-            AccumulatorTile* level = m_levels[i];
+            AccumulatorTile* level = levels[i];
             const Vector2f& level_scale = m_level_scales[i];
 
             const Sample* sample_end = samples + sample_count;
@@ -185,6 +238,7 @@ void LocalSampleAccumulationBuffer::store_samples(
             {
                 if ((counter++ & 4096) == 0 && abort_switch.is_aborted())
                 {
+                    --m_writer_count[epoch & 1];
                     m_lock.unlock_read();
                     return;
                 }
@@ -197,6 +251,7 @@ void LocalSampleAccumulationBuffer::store_samples(
             }
         }
 
+        --m_writer_count[epoch & 1];
         m_lock.unlock_read();
     }
 
@@ -242,33 +297,33 @@ void LocalSampleAccumulationBuffer::develop_to_frame(
     sw.start();
 #endif
 
-    // Request exclusive access.
-    while (!m_lock.try_lock_write())
-    {
-        foundation::sleep(5);
-        if (abort_switch.is_aborted())
-            return;
-    }
+    // Request exclusive access to the read levels. Writers are not affected.
+    boost::mutex::scoped_lock lock(m_develop_mutex);
+
+    // Start a new epoch and wait for the writers of the previous one.
+    const std::uint32_t epoch = m_epoch++;
+    wait_for_writers(epoch);
 
 #ifdef PRINT_DETAILED_PERF_REPORTS
     sw.measure();
     const double t1 = sw.get_seconds();
-    RENDERER_LOG_DEBUG("develop_to_frame: acquiring lock: %f", t1 * 1000.0);
+    RENDERER_LOG_DEBUG("develop_to_frame: waiting for writers: %f", t1 * 1000.0);
 #endif
 
-    // Copy tile first so the critical section can end before doing the expensive develop_to_tile.
-    const std::uint32_t active_level = m_active_level; // Ensure the same active_level is used for both arrays.
-    const AccumulatorTile& level = *m_levels[active_level];
-    AccumulatorTile& read_level = *m_read_levels[active_level];    
-    read_level.copy_from(level);
+    // Move the samples of the previous epoch to the read levels. The active level only
+    // decreases so levels coarser than the current active level will never be displayed.
+    const std::uint32_t active_level = m_active_level;
+    const LevelVector& levels = m_levels[epoch & 1];
+    for (std::uint32_t i = 0; i <= active_level; ++i)
+        move_samples(*m_read_levels[i], *levels[i]);
 
-    m_lock.unlock_write();
+    const AccumulatorTile& read_level = *m_read_levels[active_level];
 
     Image& color_image = frame.image();
 
     const CanvasProperties& frame_props = color_image.properties();
-    assert(frame_props.m_canvas_width == m_levels[0]->get_width());
-    assert(frame_props.m_canvas_height == m_levels[0]->get_height());
+    assert(frame_props.m_canvas_width == m_read_levels[0]->get_width());
+    assert(frame_props.m_canvas_height == m_read_levels[0]->get_height());
     assert(frame_props.m_channel_count == 4);
 
     const AABB2u& crop_window = frame.get_crop_window();
@@ -308,6 +363,13 @@ void LocalSampleAccumulationBuffer::develop_to_frame(
 #endif
 }
 
+void LocalSampleAccumulationBuffer::wait_for_writers(const std::uint32_t epoch) const
+{
+    // Writers only hold an epoch for the duration of a single store_samples() call.
+    while (m_writer_count[epoch & 1] != 0)
+        foundation::yield();
+}
+
 void LocalSampleAccumulationBuffer::develop_to_tile(
     Tile&                   color_tile,
     const size_t            image_width,
@@ -38,6 +38,9 @@
 #include "foundation/platform/atomic.h"
 #include "foundation/platform/thread.h"
 
+// Boost headers.
+#include "boost/thread/mutex.hpp"
+
 // Standard headers.
 #include <cstddef>
 #include <cstdint>
@@ -70,6 +73,7 @@ class LocalSampleAccumulationBuffer
 
     // Store a set of samples into the buffer. Thread-safe.
     void store_samples(
+        const size_t                            generator_index,
         const size_t                            sample_count,
         const Sample                            samples[],
         foundation::IAbortSwitch&               abort_switch) override;
@@ -94,12 +98,20 @@ class LocalSampleAccumulationBuffer
         foundation::SleepWaitPolicy<5>
     > LockType;
 
-    LockType                                    m_lock;
-    std::vector<foundation::AccumulatorTile*>   m_levels;
-    std::vector<foundation::AccumulatorTile*>   m_read_levels;
+    typedef std::vector<foundation::AccumulatorTile*> LevelVector;
+
+    LockType                                    m_lock;             // excludes writers while clearing
+    boost::mutex                                m_develop_mutex;
+    LevelVector                                 m_levels[2];        // levels being written to, indexed by epoch parity
+    LevelVector                                 m_read_levels;      // samples from all past epochs, only touched while developing
     std::vector<foundation::Vector2f>           m_level_scales;
     boost::atomic<std::int32_t>*                m_remaining_pixels;
     boost::atomic<std::uint32_t>                m_active_level;
+    boost::atomic<std::uint32_t>                m_epoch;
+    boost::atomic<std::uint32_t>                m_writer_count[2];
+
+    // Wait until no writer stores samples into the levels of a given epoch anymore.
+    void wait_for_writers(const std::uint32_t epoch) const;
 };
 
 }   // namespace renderer
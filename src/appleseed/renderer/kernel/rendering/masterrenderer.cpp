@@ -45,14 +45,18 @@
 #include "renderer/modeling/frame/frame.h"
 #include "renderer/modeling/input/inputbinder.h"
 #include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectchangetracker.h"
 #include "renderer/modeling/project/renderingtimer.h"
+#include "renderer/modeling/project/textureconverter.h"
 #include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/settingsparsing.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/memory/autoreleaseptr.h"
+#include "foundation/memory/largeallocator.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/utility/job/iabortswitch.h"
 #include "foundation/utility/otherwise.h"
@@ -61,7 +65,9 @@
 
 // Standard headers.
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <new>
@@ -101,6 +107,145 @@ namespace
       private:
         IRendererController& m_renderer_controller;
     };
+
+    // Measures the time between the start of (re)initialization and the first rendered pixels.
+    class FirstPixelTimer
+    {
+      public:
+        void arm(const ProjectChanges::Type changes)
+        {
+            m_changes = changes;
+            m_reported.store(false);
+            m_stopwatch.start();
+        }
+
+        void report()
+        {
+            bool expected = false;
+            if (m_reported.compare_exchange_strong(expected, true))
+            {
+                m_stopwatch.measure();
+                RENDERER_LOG_INFO(
+                    "time to first pixel (changes: %s): %s.",
+                    ProjectChanges::to_string(m_changes).c_str(),
+                    pretty_time(m_stopwatch.get_seconds()).c_str());
+            }
+        }
+
+      private:
+        ProjectChanges::Type    m_changes = ProjectChanges::All;
+        std::atomic<bool>       m_reported{true};
+        RenderingTimer          m_stopwatch;
+    };
+
+    // A tile callback that notifies a FirstPixelTimer and forwards all calls to another tile callback.
+    class FirstPixelTileCallback
+      : public ITileCallback
+    {
+      public:
+        FirstPixelTileCallback(
+            ITileCallback*              tile_callback,
+            FirstPixelTimer&            timer)
+          : m_tile_callback(tile_callback)
+          , m_timer(timer)
+        {
+        }
+
+        ~FirstPixelTileCallback() override
+        {
+            if (m_tile_callback)
+                m_tile_callback->release();
+        }
+
+        void release() override
+        {
+            delete this;
+        }
+
+        void on_tiled_frame_begin(const Frame* frame) override
+        {
+            if (m_tile_callback)
+                m_tile_callback->on_tiled_frame_begin(frame);
+        }
+
+        void on_tiled_frame_end(const Frame* frame) override
+        {
+            if (m_tile_callback)
+                m_tile_callback->on_tiled_frame_end(frame);
+        }
+
+        void on_tile_begin(
+            const Frame*                frame,
+            const size_t                tile_x,
+            const size_t                tile_y,
+            const size_t                thread_index,
+            const size_t                thread_count) override
+        {
+            if (m_tile_callback)
+                m_tile_callback->on_tile_begin(frame, tile_x, tile_y, thread_index, thread_count);
+        }
+
+        void on_tile_end(
+            const Frame*                frame,
+            const size_t                tile_x,
+            const size_t                tile_y) override
+        {
+            m_timer.report();
+
+            if (m_tile_callback)
+                m_tile_callback->on_tile_end(frame, tile_x, tile_y);
+        }
+
+        void on_progressive_frame_update(
+            const Frame&                frame,
+            const double                time,
+            const std::uint64_t         samples,
+            const double                samples_per_pixel,
+            const std::uint64_t         samples_per_second) override
+        {
+            m_timer.report();
+
+            if (m_tile_callback)
+                m_tile_callback->on_progressive_frame_update(frame, time, samples, samples_per_pixel, samples_per_second);
+        }
+
+      private:
+        ITileCallback*                  m_tile_callback;
+        FirstPixelTimer&                m_timer;
+    };
+
+    class FirstPixelTileCallbackFactory
+      : public ITileCallbackFactory
+    {
+      public:
+        explicit FirstPixelTileCallbackFactory(FirstPixelTimer& timer)
+          : m_tile_callback_factory(nullptr)
+          , m_timer(timer)
+        {
+        }
+
+        void release() override
+        {
+            // Owned by MasterRenderer::Impl.
+        }
+
+        void set_tile_callback_factory(ITileCallbackFactory* tile_callback_factory)
+        {
+            m_tile_callback_factory = tile_callback_factory;
+        }
+
+        ITileCallback* create() override
+        {
+            return
+                new FirstPixelTileCallback(
+                    m_tile_callback_factory->create(),
+                    m_timer);
+        }
+
+      private:
+        ITileCallbackFactory*           m_tile_callback_factory;
+        FirstPixelTimer&                m_timer;
+    };
 }
 
 struct MasterRenderer::Impl
@@ -115,6 +260,10 @@ struct MasterRenderer::Impl
     SerialRendererController*           m_serial_renderer_controller;
     ITileCallbackFactory*               m_serial_tile_callback_factory;
 
+    FirstPixelTimer                     m_first_pixel_timer;
+    FirstPixelTileCallbackFactory       m_first_pixel_tile_callback_factory;
+    ProjectChangeTracker                m_change_tracker;
+
     std::unique_ptr<IRenderDevice>      m_render_device;
 
     Impl(
@@ -130,6 +279,7 @@ struct MasterRenderer::Impl
       , m_display(nullptr)
       , m_serial_renderer_controller(nullptr)
       , m_serial_tile_callback_factory(nullptr)
+      , m_first_pixel_tile_callback_factory(m_first_pixel_timer)
     {
         if (m_tile_callback_factory == nullptr)
         {
@@ -157,6 +307,7 @@ struct MasterRenderer::Impl
       , m_display(nullptr)
       , m_serial_renderer_controller(nullptr)
       , m_serial_tile_callback_factory(nullptr)
+      , m_first_pixel_tile_callback_factory(m_first_pixel_timer)
     {
     }
 
@@ -195,6 +346,12 @@ struct MasterRenderer::Impl
         // Initialize thread-local variables.
         Spectrum::set_mode(get_spectrum_mode(m_params));
 
+        // Configure the placement of large allocations such as acceleration structures and framebuffers.
+        set_large_allocation_policy(get_use_huge_pages(m_params), get_numa_policy(m_params));
+
+        // Warn when tracked memory usage grows beyond the soft budget, if any.
+        global_memory_tracker().set_soft_budget(get_soft_memory_budget(m_params));
+
         // Reset the frame's render info.
         m_project.get_frame()->render_info().clear();
 
@@ -209,6 +366,12 @@ struct MasterRenderer::Impl
             m_tile_callback_factory = m_serial_tile_callback_factory;
         }
 
+        // Tile callbacks also report the time to first pixel after each (re)initialization.
+        m_first_pixel_tile_callback_factory.set_tile_callback_factory(m_tile_callback_factory);
+
+        // Renderer components may have been created with other tile callbacks; rebuild everything.
+        m_change_tracker.clear();
+
         try
         {
             // Render.
@@ -241,6 +404,7 @@ struct MasterRenderer::Impl
         catch (const std::bad_alloc&)
         {
             RENDERER_LOG_ERROR("rendering failed (ran out of memory).");
+            RENDERER_LOG_ERROR("%s", global_memory_tracker().get_statistics().to_string().c_str());
             result.m_status = RenderingResult::Failed;
         }
 #ifdef NDEBUG
@@ -290,18 +454,31 @@ struct MasterRenderer::Impl
         {
             renderer_controller.on_rendering_begin();
 
+            // Find out what changed since the last initialization, if any.
+            const ProjectChanges::Type changes = m_change_tracker.classify(m_project, m_params);
+            if (m_change_tracker.has_snapshot())
+                RENDERER_LOG_INFO("reinitializing rendering (changes: %s).", ProjectChanges::to_string(changes).c_str());
+            m_first_pixel_timer.arm(changes);
+
             // Construct an abort switch that will allow to abort initialization.
             RendererControllerAbortSwitch abort_switch(renderer_controller);
 
             // Expand procedural assemblies before scene entities inputs are bound.
-            if (!m_project.get_scene()->expand_procedural_assemblies(m_project, &abort_switch))
+            if ((changes & ProjectChanges::Geometry) &&
+                !m_project.get_scene()->expand_procedural_assemblies(m_project, &abort_switch))
                 return RenderingResult::Failed; // todo: depends on whether the abort switch was triggered or not
 
+            // Convert texture files to tiled and mipmapped files if requested.
+            if ((changes & (ProjectChanges::Geometry | ProjectChanges::Settings)) &&
+                !convert_textures(abort_switch))
+                return RenderingResult::Failed;
+
             // Bind scene entities inputs.
             if (!bind_scene_entities_inputs())
                 return RenderingResult::Failed;
 
-            const IRendererController::Status status = initialize_and_render_frame(renderer_controller);
+            const IRendererController::Status status =
+                initialize_and_render_frame(renderer_controller, changes);
 
             switch (status)
             {
@@ -321,6 +498,27 @@ struct MasterRenderer::Impl
         }
     }
 
+    // Convert texture files to tiled and mipmapped files if enabled. Return true on success, false otherwise.
+    bool convert_textures(IAbortSwitch& abort_switch) const
+    {
+        const ParamArray& texture_store_params = m_params.child("texture_store");
+
+        if (!texture_store_params.get_optional<bool>("convert_textures", false))
+            return true;
+
+        const std::string cache_directory =
+            texture_store_params.get_optional<std::string>(
+                "converted_textures_directory",
+                TextureConverter::get_default_cache_directory());
+
+        const TextureConverter texture_converter(
+            m_project,
+            cache_directory.c_str(),
+            get_rendering_thread_count(m_params));
+
+        return texture_converter.convert_textures(&abort_switch);
+    }
+
     // Bind all scene entities inputs. Return true on success, false otherwise.
     bool bind_scene_entities_inputs() const
     {
@@ -329,17 +527,32 @@ struct MasterRenderer::Impl
         return input_binder.get_error_count() == 0;
     }
 
+    // Return the tile callback factory to pass to the render device, if any.
+    ITileCallbackFactory* get_tile_callback_factory()
+    {
+        return
+            m_tile_callback_factory != nullptr
+                ? &m_first_pixel_tile_callback_factory
+                : nullptr;
+    }
+
     // Initialize render device and render a frame.
-    IRendererController::Status initialize_and_render_frame(IRendererController& renderer_controller)
+    IRendererController::Status initialize_and_render_frame(
+        IRendererController&        renderer_controller,
+        const ProjectChanges::Type  changes)
     {
         // Construct an abort switch that will allow to abort initialization or rendering.
         RendererControllerAbortSwitch abort_switch(renderer_controller);
 
+        // The state recorded below is only valid once initialization has fully succeeded.
+        m_change_tracker.clear();
+
         // Initialize the render device.
         const bool success =
             m_render_device->initialize(
                 m_resource_search_paths,
-                m_tile_callback_factory,
+                get_tile_callback_factory(),
+                changes,
                 abort_switch);
         if (!success || abort_switch.is_aborted())
         {
@@ -368,6 +581,7 @@ struct MasterRenderer::Impl
 #ifdef APPLESEED_WITH_EMBREE
         const bool use_embree = m_params.get_optional<bool>("use_embree", false);
         m_project.set_use_embree(use_embree);
+        m_project.set_use_embree_instancing(m_params.get_optional<bool>("use_embree_instancing", false));
 #else
         const bool use_embree = false;
 #endif
@@ -376,12 +590,17 @@ struct MasterRenderer::Impl
         else RENDERER_LOG_INFO("using built-in ray tracing kernel.");
 
         // Updating the device scene causes ray tracing acceleration structures to be updated or rebuilt.
-        if (!m_render_device->build_or_update_scene())
+        // Camera, shading and lighting edits leave them untouched.
+        if ((changes & (ProjectChanges::Geometry | ProjectChanges::Settings)) &&
+            !m_render_device->build_or_update_scene())
         {
             recorder.on_render_end(m_project);
             return IRendererController::AbortRendering;
         }
 
+        // Report where memory goes once the scene is ready to be rendered.
+        RENDERER_LOG_DEBUG("%s", global_memory_tracker().get_statistics().to_string().c_str());
+
         // Load the checkpoint if any.
         Frame& frame = *m_project.get_frame();
         const size_t pass_count = m_params.get_optional<size_t>("passes", 1);
@@ -404,6 +623,9 @@ struct MasterRenderer::Impl
             return renderer_controller.get_status();
         }
 
+        // Remember the state of the project for the next reinitialization.
+        m_change_tracker.record(m_project, m_params);
+
         // Execute the main rendering loop.
         const auto status = render_frame(renderer_controller, abort_switch);
 
@@ -455,7 +677,7 @@ struct MasterRenderer::Impl
             // Render the frame.
             const IRendererController::Status status =
                 m_render_device->render_frame(
-                    m_tile_callback_factory,
+                    get_tile_callback_factory(),
                     combined_renderer_controller,
                     abort_switch);
 
@@ -34,11 +34,14 @@
 #include "renderer/kernel/aov/imagestack.h"
 #include "renderer/kernel/rendering/shadingresultframebuffer.h"
 #include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/memorytracker.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/image/tile.h"
+#include "foundation/memory/largeallocator.h"
+#include "foundation/utility/api/apistring.h"
 
 using namespace foundation;
 
@@ -47,17 +50,71 @@ namespace renderer
 
 PermanentShadingResultFrameBufferFactory::PermanentShadingResultFrameBufferFactory(
     const Frame&                frame)
+  : m_storage(nullptr)
+  , m_storage_size(0)
 {
     const CanvasProperties& props = frame.image().properties();
     const std::size_t tile_count_x = props.m_tile_count_x;
     const std::size_t tile_count_y = props.m_tile_count_y;
 
     m_framebuffers.resize(tile_count_x * tile_count_y, nullptr);
+
+    // Lay out the pixel storage of all framebuffers in a single block.
+    const ShadingResultFrameBuffer::Layout layout(frame);
+    m_storage_offsets.reserve(tile_count_x * tile_count_y + 1);
+
+    for (std::size_t ty = 0; ty < tile_count_y; ++ty)
+    {
+        for (std::size_t tx = 0; tx < tile_count_x; ++tx)
+        {
+            const Tile& tile = frame.image().tile(tx, ty);
+            m_storage_offsets.push_back(m_storage_size);
+            m_storage_size +=
+                ShadingResultFrameBuffer::get_storage_size(
+                    tile.get_width(),
+                    tile.get_height(),
+                    layout);
+        }
+    }
+
+    m_storage_offsets.push_back(m_storage_size);
+
+    // If the allocation fails, framebuffers fall back to allocating their own storage.
+    if (m_storage_size > 0)
+    {
+        m_memory_owner = std::string(frame.get_path().c_str()) + "/shading result framebuffers";
+
+        // The budget is soft: warn about the allocation but proceed with it.
+        MemoryTracker& memory_tracker = global_memory_tracker();
+        memory_tracker.check_budget(
+            MemoryTracker::CategoryFrameBuffer,
+            m_memory_owner.c_str(),
+            m_storage_size);
+
+        m_storage = static_cast<std::uint8_t*>(large_malloc(m_storage_size, 16));
+
+        if (m_storage)
+        {
+            memory_tracker.add(
+                MemoryTracker::CategoryFrameBuffer,
+                m_memory_owner.c_str(),
+                m_storage_size);
+        }
+    }
 }
 
 PermanentShadingResultFrameBufferFactory::~PermanentShadingResultFrameBufferFactory()
 {
     clear();
+
+    if (m_storage)
+    {
+        large_free(m_storage, m_storage_size);
+        global_memory_tracker().subtract(
+            MemoryTracker::CategoryFrameBuffer,
+            m_memory_owner.c_str(),
+            m_storage_size);
+    }
 }
 
 void PermanentShadingResultFrameBufferFactory::release()
@@ -86,13 +143,27 @@ ShadingResultFrameBuffer* PermanentShadingResultFrameBufferFactory::create(
     if (m_framebuffers[index] == nullptr)
     {
         const Tile& tile = frame.image().tile(tile_x, tile_y);
+        const ShadingResultFrameBuffer::Layout layout(frame);
+
+        // Only use the preallocated storage if the frame's AOVs still fit in it.
+        const std::size_t storage_size =
+            ShadingResultFrameBuffer::get_storage_size(
+                tile.get_width(),
+                tile.get_height(),
+                layout);
+        std::uint8_t* storage =
+            m_storage != nullptr &&
+            storage_size <= m_storage_offsets[index + 1] - m_storage_offsets[index]
+                ? m_storage + m_storage_offsets[index]
+                : nullptr;
 
         m_framebuffers[index] =
             new ShadingResultFrameBuffer(
                 tile.get_width(),
                 tile.get_height(),
-                frame.aov_images().size(),
-                tile_bbox);
+                layout,
+                tile_bbox,
+                storage);
 
         m_framebuffers[index]->clear();
     }
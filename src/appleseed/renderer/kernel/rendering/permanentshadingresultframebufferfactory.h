@@ -37,6 +37,8 @@
 
 // Standard headers.
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 // Forward declarations.
@@ -73,6 +75,16 @@ class PermanentShadingResultFrameBufferFactory
 
   private:
     std::vector<ShadingResultFrameBuffer*> m_framebuffers;
+
+    // Pixel storage of all framebuffers, allocated in one large block so that it
+    // can be backed by huge pages. Pages are only committed when a framebuffer is
+    // first cleared, by the rendering thread that uses it.
+    std::uint8_t*                           m_storage;
+    std::size_t                             m_storage_size;
+    std::vector<std::size_t>                m_storage_offsets;
+
+    // Name under which the storage is reported to the global memory tracker.
+    std::string                             m_memory_owner;
 };
 
 }   // namespace renderer
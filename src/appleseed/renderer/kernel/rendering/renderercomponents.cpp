@@ -51,17 +51,25 @@
 #include "renderer/kernel/rendering/generic/generictilerenderer.h"
 #include "renderer/kernel/rendering/permanentshadingresultframebufferfactory.h"
 #include "renderer/kernel/rendering/progressive/progressiveframerenderer.h"
+#include "renderer/kernel/rendering/shadingresultframebuffer.h"
 #include "renderer/kernel/shading/oslshadingsystem.h"
 #include "renderer/kernel/texturing/oiiotexturesystem.h"
+#include "renderer/modeling/frame/frame.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/utility/paramarray.h"
 
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/string/string.h"
+
 // OpenImageIO headers.
 #include "foundation/platform/_beginoiioheaders.h"
 #include "OpenImageIO/imagebuf.h"
 #include "foundation/platform/_endoiioheaders.h"
 
 // Standard headers.
+#include <cstddef>
 #include <string>
 
 using namespace foundation;
@@ -93,9 +101,29 @@ namespace
         copy_param(child, source, "passes");
         copy_param(child, source, "spectrum_mode");
         copy_param(child, source, "sampling_mode");
+        copy_param(child, source, "sampling_blue_noise");
         copy_param(child, source, "rendering_threads");
         return child;
     }
+
+    void print_shading_result_framebuffer_memory(
+        const Frame&        frame,
+        const char*         description,
+        const size_t        framebuffer_count)
+    {
+        const CanvasProperties& props = frame.image().properties();
+        const size_t pixel_count = props.m_tile_width * props.m_tile_height * framebuffer_count;
+        const ShadingResultFrameBuffer::Layout layout(frame);
+
+        // Without compaction, the weight, the main image and every AOV use four float channels each.
+        const size_t uncompacted_pixel_size = (1 + 4 + 4 * layout.m_aov_count) * sizeof(float);
+
+        RENDERER_LOG_INFO(
+            "%s use %s (%s without compact aov storage).",
+            description,
+            pretty_size(pixel_count * layout.get_pixel_size()).c_str(),
+            pretty_size(pixel_count * uncompacted_pixel_size).c_str());
+    }
 }
 
 RendererComponents::RendererComponents(
@@ -430,12 +458,18 @@ bool RendererComponents::create_shading_result_framebuffer_factory()
     {
         m_shading_result_framebuffer_factory.reset(
             new EphemeralShadingResultFrameBufferFactory());
+        print_shading_result_framebuffer_memory(m_frame, "ephemeral shading result framebuffers (per tile)", 1);
         return true;
     }
     else if (name == "permanent")
     {
         m_shading_result_framebuffer_factory.reset(
             new PermanentShadingResultFrameBufferFactory(m_frame));
+        const CanvasProperties& props = m_frame.image().properties();
+        print_shading_result_framebuffer_memory(
+            m_frame,
+            "permanent shading result framebuffers",
+            props.m_tile_count_x * props.m_tile_count_y);
         return true;
     }
     else
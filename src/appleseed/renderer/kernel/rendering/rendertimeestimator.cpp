@@ -0,0 +1,238 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "rendertimeestimator.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+using namespace foundation;
+
+namespace renderer
+{
+
+//
+// RenderTimeEstimator class implementation.
+//
+
+namespace
+{
+    struct TileRecord
+    {
+        size_t  m_pixel_count;
+        size_t  m_pass_count;       // number of passes rendered so far
+        double  m_total_time;       // total rendering time over these passes, in seconds
+    };
+}
+
+struct RenderTimeEstimator::Impl
+{
+    const size_t                m_tile_count_x;
+    const size_t                m_tile_count_y;
+    const size_t                m_pass_count;
+    std::vector<TileRecord>     m_tiles;
+    size_t                      m_rendered_tile_count;
+    std::uint64_t               m_rendered_pixel_count;
+    double                      m_total_time;
+
+    Impl(
+        const CanvasProperties& props,
+        const size_t            pass_count)
+      : m_tile_count_x(props.m_tile_count_x)
+      , m_tile_count_y(props.m_tile_count_y)
+      , m_pass_count(pass_count)
+      , m_rendered_tile_count(0)
+      , m_rendered_pixel_count(0)
+      , m_total_time(0.0)
+    {
+        m_tiles.reserve(props.m_tile_count);
+
+        for (size_t y = 0; y < m_tile_count_y; ++y)
+        {
+            for (size_t x = 0; x < m_tile_count_x; ++x)
+            {
+                TileRecord record;
+                record.m_pixel_count = props.get_tile_width(x) * props.get_tile_height(y);
+                record.m_pass_count = 0;
+                record.m_total_time = 0.0;
+                m_tiles.push_back(record);
+            }
+        }
+    }
+
+    double predict_tile_time(const size_t tile_x, const size_t tile_y) const
+    {
+        const TileRecord& tile = m_tiles[tile_y * m_tile_count_x + tile_x];
+
+        if (tile.m_pass_count > 0)
+            return tile.m_total_time / tile.m_pass_count;
+
+        if (m_rendered_pixel_count == 0)
+            return -1.0;
+
+        // Use the average cost per pixel of the rendered neighbors of the tile.
+        double neighbor_time = 0.0;
+        size_t neighbor_pixel_count = 0;
+
+        const size_t min_x = tile_x > 0 ? tile_x - 1 : 0;
+        const size_t min_y = tile_y > 0 ? tile_y - 1 : 0;
+        const size_t max_x = std::min(tile_x + 1, m_tile_count_x - 1);
+        const size_t max_y = std::min(tile_y + 1, m_tile_count_y - 1);
+
+        for (size_t y = min_y; y <= max_y; ++y)
+        {
+            for (size_t x = min_x; x <= max_x; ++x)
+            {
+                const TileRecord& neighbor = m_tiles[y * m_tile_count_x + x];
+
+                if (neighbor.m_pass_count > 0)
+                {
+                    neighbor_time += neighbor.m_total_time / neighbor.m_pass_count;
+                    neighbor_pixel_count += neighbor.m_pixel_count;
+                }
+            }
+        }
+
+        // Fall back to the average cost per pixel of the whole frame.
+        const double time_per_pixel =
+            neighbor_pixel_count > 0
+                ? neighbor_time / neighbor_pixel_count
+                : m_total_time / m_rendered_pixel_count;
+
+        return time_per_pixel * tile.m_pixel_count;
+    }
+
+    double get_remaining_work() const
+    {
+        if (m_rendered_pixel_count == 0)
+            return -1.0;
+
+        double remaining_work = 0.0;
+
+        for (size_t y = 0; y < m_tile_count_y; ++y)
+        {
+            for (size_t x = 0; x < m_tile_count_x; ++x)
+            {
+                const TileRecord& tile = m_tiles[y * m_tile_count_x + x];
+
+                if (tile.m_pass_count < m_pass_count)
+                    remaining_work += (m_pass_count - tile.m_pass_count) * predict_tile_time(x, y);
+            }
+        }
+
+        return remaining_work;
+    }
+};
+
+RenderTimeEstimator::RenderTimeEstimator(
+    const CanvasProperties& props,
+    const size_t            pass_count)
+  : impl(new Impl(props, pass_count))
+{
+}
+
+RenderTimeEstimator::~RenderTimeEstimator()
+{
+    delete impl;
+}
+
+void RenderTimeEstimator::record_tile(
+    const size_t            tile_x,
+    const size_t            tile_y,
+    const double            seconds)
+{
+    assert(tile_x < impl->m_tile_count_x);
+    assert(tile_y < impl->m_tile_count_y);
+
+    TileRecord& tile = impl->m_tiles[tile_y * impl->m_tile_count_x + tile_x];
+    ++tile.m_pass_count;
+    tile.m_total_time += seconds;
+
+    ++impl->m_rendered_tile_count;
+    impl->m_rendered_pixel_count += tile.m_pixel_count;
+    impl->m_total_time += seconds;
+}
+
+size_t RenderTimeEstimator::get_rendered_tile_count() const
+{
+    return impl->m_rendered_tile_count;
+}
+
+std::uint64_t RenderTimeEstimator::get_rendered_pixel_count() const
+{
+    return impl->m_rendered_pixel_count;
+}
+
+double RenderTimeEstimator::predict_tile_time(
+    const size_t            tile_x,
+    const size_t            tile_y) const
+{
+    assert(tile_x < impl->m_tile_count_x);
+    assert(tile_y < impl->m_tile_count_y);
+
+    return impl->predict_tile_time(tile_x, tile_y);
+}
+
+double RenderTimeEstimator::get_remaining_work() const
+{
+    return impl->get_remaining_work();
+}
+
+double RenderTimeEstimator::get_progress() const
+{
+    const double remaining_work = impl->get_remaining_work();
+
+    if (remaining_work < 0.0)
+        return 0.0;
+
+    const double total_work = impl->m_total_time + remaining_work;
+
+    return total_work > 0.0 ? impl->m_total_time / total_work : 1.0;
+}
+
+double RenderTimeEstimator::estimate_remaining_time(const double elapsed_seconds) const
+{
+    const double remaining_work = impl->get_remaining_work();
+
+    if (remaining_work < 0.0 || elapsed_seconds <= 0.0 || impl->m_total_time <= 0.0)
+        return -1.0;
+
+    // Number of tiles rendered in parallel on average so far.
+    const double parallelism = impl->m_total_time / elapsed_seconds;
+
+    return remaining_work / parallelism;
+}
+
+}   // namespace renderer
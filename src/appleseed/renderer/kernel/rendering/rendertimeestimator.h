@@ -0,0 +1,103 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations.
+namespace foundation    { class CanvasProperties; }
+
+namespace renderer
+{
+
+//
+// Estimates the remaining time of a tiled render from the measured rendering time of tiles.
+//
+// The cost of tiles can vary by orders of magnitude across a frame, so the remaining work
+// is predicted tile by tile instead of from the fraction of completed tiles. A tile that
+// was rendered in an earlier pass is expected to cost what it did on average; a tile that
+// was never rendered is predicted from the cost per pixel of its rendered neighbors, or of
+// all rendered tiles if none of its neighbors was rendered yet. The remaining work is then
+// converted to wall clock time using the parallelism observed so far.
+//
+
+class APPLESEED_DLLSYMBOL RenderTimeEstimator
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    RenderTimeEstimator(
+        const foundation::CanvasProperties& props,
+        const size_t                        pass_count);
+
+    // Destructor.
+    ~RenderTimeEstimator();
+
+    // Record the time it took a rendering thread to render a given tile.
+    void record_tile(
+        const size_t                        tile_x,
+        const size_t                        tile_y,
+        const double                        seconds);
+
+    // Return the number of tiles and pixels rendered so far, across all passes.
+    size_t get_rendered_tile_count() const;
+    std::uint64_t get_rendered_pixel_count() const;
+
+    // Return the predicted time it takes one thread to render one pass of a given tile,
+    // in seconds, or a negative value if no tile was recorded yet.
+    double predict_tile_time(
+        const size_t                        tile_x,
+        const size_t                        tile_y) const;
+
+    // Return the predicted thread time needed to render all remaining tile passes,
+    // in seconds, or a negative value if no tile was recorded yet.
+    double get_remaining_work() const;
+
+    // Return the fraction of the total predicted work that was completed, in [0, 1].
+    double get_progress() const;
+
+    // Return the estimated wall clock time until the end of the render given the wall
+    // clock time elapsed since its beginning, in seconds, or a negative value if unknown.
+    double estimate_remaining_time(const double elapsed_seconds) const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}   // namespace renderer
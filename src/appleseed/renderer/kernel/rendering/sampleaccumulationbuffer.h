@@ -59,7 +59,9 @@ class SampleAccumulationBuffer
     virtual void clear() = 0;
 
     // Store a set of samples into the buffer. Thread-safe.
+    // A given sample generator never stores samples concurrently with itself.
     virtual void store_samples(
+        const size_t                generator_index,
         const size_t                sample_count,
         const Sample                samples[],
         foundation::IAbortSwitch&   abort_switch) = 0;
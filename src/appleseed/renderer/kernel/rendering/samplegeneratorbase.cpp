@@ -98,7 +98,7 @@ void SampleGeneratorBase::generate_samples(
     }
 
     if (stored > 0)
-        buffer.store_samples(stored, &m_samples[0], abort_switch);
+        buffer.store_samples(m_generator_index, stored, &m_samples[0], abort_switch);
 }
 
 void SampleGeneratorBase::signal_invalid_sample()
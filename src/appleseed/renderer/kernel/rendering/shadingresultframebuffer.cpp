@@ -31,48 +31,146 @@
 #include "shadingresultframebuffer.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/aov/imagestack.h"
 #include "renderer/kernel/aov/tilestack.h"
 #include "renderer/kernel/shading/shadingresult.h"
+#include "renderer/modeling/frame/frame.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
 #include "foundation/image/color.h"
+#include "foundation/image/image.h"
 #include "foundation/image/tile.h"
 #include "foundation/platform/compiler.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 using namespace foundation;
 
 namespace renderer
 {
 
+//
+// ShadingResultFrameBuffer::Layout class implementation.
+//
+
+ShadingResultFrameBuffer::Layout::Layout()
+  : m_aov_count(0)
+  , m_half_precision_aovs(false)
+{
+}
+
+ShadingResultFrameBuffer::Layout::Layout(const Frame& frame)
+  : m_aov_count(frame.aov_images().size())
+  , m_half_precision_aovs(frame.has_half_precision_aovs())
+{
+    assert(m_aov_count <= MaxAOVCount);
+
+    for (size_t i = 0; i < m_aov_count; ++i)
+    {
+        const size_t channel_count = frame.aov_images().get_image(i).properties().m_channel_count;
+        m_aov_channel_counts[i] = std::min<size_t>(channel_count, 4);
+    }
+}
+
+size_t ShadingResultFrameBuffer::Layout::get_aov_channel_count() const
+{
+    size_t channel_count = 0;
+
+    for (size_t i = 0; i < m_aov_count; ++i)
+        channel_count += m_aov_channel_counts[i];
+
+    return channel_count;
+}
+
+size_t ShadingResultFrameBuffer::Layout::get_float_channel_count() const
+{
+    // The main image is always RGBA; AOVs only live in the accumulator tile in full precision.
+    return m_half_precision_aovs ? 4 : 4 + get_aov_channel_count();
+}
+
+size_t ShadingResultFrameBuffer::Layout::get_pixel_size() const
+{
+    const size_t float_size = (1 + get_float_channel_count()) * sizeof(float);
+    const size_t half_size = m_half_precision_aovs ? get_aov_channel_count() * sizeof(Half) : 0;
+    return float_size + half_size;
+}
+
+
+//
+// ShadingResultFrameBuffer class implementation.
+//
+
 ShadingResultFrameBuffer::ShadingResultFrameBuffer(
     const size_t                    width,
     const size_t                    height,
-    const size_t                    aov_count)
+    const Layout&                   layout,
+    std::uint8_t*                   storage)
   : AccumulatorTile(
         width,
         height,
-        get_total_channel_count(aov_count))
-  , m_aov_count(aov_count)
-  , m_scratch(get_total_channel_count(aov_count))
+        layout.get_float_channel_count(),
+        storage)
+  , m_layout(layout)
+  , m_aov_channel_count(layout.get_aov_channel_count())
+  , m_aov_means(layout.m_half_precision_aovs ? width * height * m_aov_channel_count : 0)
+  , m_scratch(4 + m_aov_channel_count)
 {
 }
 
 ShadingResultFrameBuffer::ShadingResultFrameBuffer(
     const size_t                    width,
     const size_t                    height,
-    const size_t                    aov_count,
-    const AABB2u&                   crop_window)
+    const Layout&                   layout,
+    const AABB2u&                   crop_window,
+    std::uint8_t*                   storage)
   : AccumulatorTile(
         width,
         height,
-        get_total_channel_count(aov_count),
-        crop_window)
-  , m_aov_count(aov_count)
-  , m_scratch(get_total_channel_count(aov_count))
+        layout.get_float_channel_count(),
+        crop_window,
+        storage)
+  , m_layout(layout)
+  , m_aov_channel_count(layout.get_aov_channel_count())
+  , m_aov_means(layout.m_half_precision_aovs ? width * height * m_aov_channel_count : 0)
+  , m_scratch(4 + m_aov_channel_count)
+{
+}
+
+size_t ShadingResultFrameBuffer::get_memory_size(
+    const size_t                    width,
+    const size_t                    height,
+    const Layout&                   layout)
+{
+    return width * height * layout.get_pixel_size();
+}
+
+size_t ShadingResultFrameBuffer::get_storage_size(
+    const size_t                    width,
+    const size_t                    height,
+    const Layout&                   layout)
+{
+    return width * height * (1 + layout.get_float_channel_count()) * sizeof(float);
+}
+
+void ShadingResultFrameBuffer::clear()
 {
+    AccumulatorTile::clear();
+    std::fill(m_aov_means.begin(), m_aov_means.end(), Half(0.0f));
+    std::vector<float>().swap(m_aov_sums);
+}
+
+void ShadingResultFrameBuffer::copy_from(const ShadingResultFrameBuffer& source)
+{
+    assert(m_aov_channel_count == source.m_aov_channel_count);
+    assert(m_layout.m_half_precision_aovs == source.m_layout.m_half_precision_aovs);
+
+    Tile::copy_from(source);
+    m_aov_means = source.m_aov_means;
+    m_aov_sums = source.m_aov_sums;
 }
 
 void ShadingResultFrameBuffer::add(
@@ -86,16 +184,38 @@ void ShadingResultFrameBuffer::add(
     *ptr++ = sample.m_main[2];
     *ptr++ = sample.m_main[3];
 
-    for (size_t i = 0, e = m_aov_count; i < e; ++i)
+    for (size_t i = 0, e = m_layout.m_aov_count; i < e; ++i)
     {
         const Color4f& aov = sample.m_aovs[i];
-        *ptr++ = aov[0];
-        *ptr++ = aov[1];
-        *ptr++ = aov[2];
-        *ptr++ = aov[3];
+        for (size_t c = 0, n = m_layout.m_aov_channel_counts[i]; c < n; ++c)
+            *ptr++ = aov[c];
+    }
+
+    if (!m_layout.m_half_precision_aovs)
+    {
+        AccumulatorTile::add(pi, &m_scratch[0]);
+        return;
     }
 
+    // Ignore samples outside the crop window.
+    if (!m_crop_window.contains(pi))
+        return;
+
+    // Accumulate the main image and update the weight of the pixel.
     AccumulatorTile::add(pi, &m_scratch[0]);
+
+    // Accumulate the AOVs in float until the next flush.
+    const size_t stride = 1 + m_aov_channel_count;
+    if (m_aov_sums.empty())
+        m_aov_sums.assign(m_width * m_height * stride, 0.0f);
+
+    const float* APPLESEED_RESTRICT values = &m_scratch[4];
+    float* APPLESEED_RESTRICT sums = &m_aov_sums[(pi.y * m_width + pi.x) * stride];
+
+    sums[0] += 1.0f;
+
+    for (size_t i = 0, e = m_aov_channel_count; i < e; ++i)
+        sums[1 + i] += values[i];
 }
 
 void ShadingResultFrameBuffer::merge(
@@ -107,19 +227,47 @@ void ShadingResultFrameBuffer::merge(
     const float                     scaling)
 {
     assert(m_channel_count == source.m_channel_count);
+    assert(m_aov_channel_count == source.m_aov_channel_count);
+
+    flush_aov_sums();
 
     const float* APPLESEED_RESTRICT source_ptr = source.pixel(source_x, source_y);
     float* APPLESEED_RESTRICT dest_ptr = pixel(dest_x, dest_y);
 
+    const float dest_weight = dest_ptr[0];
+    const float source_weight = source_ptr[0] * scaling;
+
     for (size_t i = 0, e = m_channel_count; i < e; ++i)
         dest_ptr[i] += source_ptr[i] * scaling;
+
+    if (m_layout.m_half_precision_aovs)
+    {
+        const float total_weight = dest_weight + source_weight;
+        if (total_weight > 0.0f)
+        {
+            const float rcp_total_weight = 1.0f / total_weight;
+            float* APPLESEED_RESTRICT source_means = &m_scratch[4];
+            source.get_aov_means(source_x, source_y, source_means);
+            Half* APPLESEED_RESTRICT dest_means = aov_means(dest_x, dest_y);
+
+            for (size_t i = 0, e = m_aov_channel_count; i < e; ++i)
+            {
+                dest_means[i] =
+                    (dest_means[i] * dest_weight + source_means[i] * source_weight) * rcp_total_weight;
+            }
+        }
+    }
 }
 
 void ShadingResultFrameBuffer::develop_to_tile(
     Tile&                           tile,
-    TileStack&                      aov_tiles) const
+    TileStack&                      aov_tiles)
 {
+    flush_aov_sums();
+
     const float* ptr = pixel(0);
+    const Half* means = m_aov_means.data();
+    const bool half_precision_aovs = m_layout.m_half_precision_aovs;
 
     for (size_t y = 0, h = m_height; y < h; ++y)
     {
@@ -132,14 +280,86 @@ void ShadingResultFrameBuffer::develop_to_tile(
             tile.set_pixel(x, y, color * rcp_weight);
             ptr += 4;
 
-            for (size_t i = 0, e = m_aov_count; i < e; ++i)
+            for (size_t i = 0, e = m_layout.m_aov_count; i < e; ++i)
             {
-                const Color4f aov(ptr[0], ptr[1], ptr[2], ptr[3]);
-                aov_tiles.set_pixel(x, y, i, aov * rcp_weight);
-                ptr += 4;
+                const size_t n = m_layout.m_aov_channel_counts[i];
+                float values[4];
+
+                if (half_precision_aovs)
+                {
+                    for (size_t c = 0; c < n; ++c)
+                        values[c] = means[c];
+                    means += n;
+                }
+                else
+                {
+                    for (size_t c = 0; c < n; ++c)
+                        values[c] = ptr[c] * rcp_weight;
+                    ptr += n;
+                }
+
+                aov_tiles.get_tile(i).set_pixel(x, y, values, n);
             }
         }
     }
 }
 
+void ShadingResultFrameBuffer::flush_aov_sums()
+{
+    if (m_aov_sums.empty())
+        return;
+
+    const size_t stride = 1 + m_aov_channel_count;
+    const float* APPLESEED_RESTRICT sums = m_aov_sums.data();
+    Half* APPLESEED_RESTRICT means = m_aov_means.data();
+
+    for (size_t p = 0, e = m_width * m_height; p < e; ++p)
+    {
+        const float pending_weight = sums[0];
+
+        if (pending_weight > 0.0f)
+        {
+            // The weight of the pixel already includes the pending samples.
+            const float rcp_weight = 1.0f / pixel(p)[0];
+
+            for (size_t i = 0; i < m_aov_channel_count; ++i)
+            {
+                const float mean = means[i];
+                means[i] = mean + (sums[1 + i] - mean * pending_weight) * rcp_weight;
+            }
+        }
+
+        sums += stride;
+        means += m_aov_channel_count;
+    }
+
+    std::vector<float>().swap(m_aov_sums);
+}
+
+void ShadingResultFrameBuffer::get_aov_means(
+    const size_t                    x,
+    const size_t                    y,
+    float*                          values) const
+{
+    const Half* means = aov_means(x, y);
+
+    for (size_t i = 0; i < m_aov_channel_count; ++i)
+        values[i] = means[i];
+
+    if (m_aov_sums.empty())
+        return;
+
+    const size_t stride = 1 + m_aov_channel_count;
+    const float* sums = &m_aov_sums[(y * m_width + x) * stride];
+    const float pending_weight = sums[0];
+
+    if (pending_weight > 0.0f)
+    {
+        const float rcp_weight = 1.0f / pixel(x, y)[0];
+
+        for (size_t i = 0; i < m_aov_channel_count; ++i)
+            values[i] += (sums[1 + i] - values[i] * pending_weight) * rcp_weight;
+    }
+}
+
 }   // namespace renderer
@@ -29,39 +29,101 @@
 
 #pragma once
 
+// appleseed.renderer headers.
+#include "renderer/kernel/aov/aovsettings.h"
+
 // appleseed.foundation headers.
 #include "foundation/image/accumulatortile.h"
 #include "foundation/math/aabb.h"
+#include "foundation/math/half.h"
 #include "foundation/math/vector.h"
 
 // Standard headers.
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 // Forward declarations.
 namespace foundation    { class Tile; }
+namespace renderer      { class Frame; }
 namespace renderer      { class ShadingResult; }
 namespace renderer      { class TileStack; }
 
 namespace renderer
 {
 
+//
+// A framebuffer accumulating shading results: the main image and the filtered AOVs.
+//
+// Each AOV only stores as many channels as its image has. AOVs are accumulated in
+// the underlying accumulator tile as weighted sums, like the main image, unless
+// half precision storage is enabled: they are then kept on the side as weighted
+// means in half precision. Samples added while a tile is being rendered are summed
+// in a temporary float buffer which is folded into the half means, and released,
+// when the framebuffer is developed or merged. Rounding to half precision thus
+// happens once per tile rendering instead of once per sample.
+//
+
 class ShadingResultFrameBuffer
   : public foundation::AccumulatorTile
 {
   public:
+    // Storage layout of the AOVs.
+    struct Layout
+    {
+        size_t  m_aov_count;
+        size_t  m_aov_channel_counts[MaxAOVCount];
+        bool    m_half_precision_aovs;
+
+        // Construct a layout without any AOV.
+        Layout();
+
+        // Construct the layout matching the AOV images of a frame.
+        explicit Layout(const Frame& frame);
+
+        // Return the total number of AOV channels.
+        size_t get_aov_channel_count() const;
+
+        // Return the number of channels in the accumulator tile, excluding the weight channel.
+        size_t get_float_channel_count() const;
+
+        // Return the number of bytes used by one pixel.
+        size_t get_pixel_size() const;
+    };
+
+    // If provided, the storage must hold get_storage_size() bytes and outlive the framebuffer.
     ShadingResultFrameBuffer(
         const size_t                    width,
         const size_t                    height,
-        const size_t                    aov_count);
+        const Layout&                   layout,
+        std::uint8_t*                   storage = nullptr);
 
     ShadingResultFrameBuffer(
         const size_t                    width,
         const size_t                    height,
-        const size_t                    aov_count,
-        const foundation::AABB2u&       crop_window);
+        const Layout&                   layout,
+        const foundation::AABB2u&       crop_window,
+        std::uint8_t*                   storage = nullptr);
+
+    const Layout& get_layout() const;
+
+    // Return the number of bytes used by a framebuffer of a given size and layout.
+    static size_t get_memory_size(
+        const size_t                    width,
+        const size_t                    height,
+        const Layout&                   layout);
+
+    // Return the number of bytes of pixel storage of the underlying accumulator tile.
+    static size_t get_storage_size(
+        const size_t                    width,
+        const size_t                    height,
+        const Layout&                   layout);
 
-    static size_t get_total_channel_count(const size_t aov_count);
+    // Set all pixels to black and all weights to zero.
+    void clear();
+
+    // Copy the contents of a framebuffer with the same dimensions and layout.
+    void copy_from(const ShadingResultFrameBuffer& source);
 
     void add(
         const foundation::Vector2u&     pi,
@@ -75,19 +137,57 @@ class ShadingResultFrameBuffer
         const size_t                    source_y,
         const float                     scaling);
 
+    // Fold pending half precision AOV samples into the means, then develop the framebuffer.
     void develop_to_tile(
         foundation::Tile&               tile,
-        TileStack&                      aov_tiles) const;
+        TileStack&                      aov_tiles);
 
   private:
-    const size_t                        m_aov_count;
+    const Layout                        m_layout;
+    const size_t                        m_aov_channel_count;
+    std::vector<foundation::Half>       m_aov_means;
+    std::vector<float>                  m_aov_sums;     // per pixel: pending weight, then pending weighted sums
     std::vector<float>                  m_scratch;
+
+    // Fold the pending AOV sums into the half precision means and release them.
+    void flush_aov_sums();
+
+    // Compute the AOV means of a pixel in float, including pending samples.
+    void get_aov_means(
+        const size_t                    x,
+        const size_t                    y,
+        float*                          values) const;
+
+    foundation::Half* aov_means(
+        const size_t                    x,
+        const size_t                    y);
+    const foundation::Half* aov_means(
+        const size_t                    x,
+        const size_t                    y) const;
 };
 
-inline size_t ShadingResultFrameBuffer::get_total_channel_count(const size_t aov_count)
+
+//
+// ShadingResultFrameBuffer class implementation.
+//
+
+inline const ShadingResultFrameBuffer::Layout& ShadingResultFrameBuffer::get_layout() const
+{
+    return m_layout;
+}
+
+inline foundation::Half* ShadingResultFrameBuffer::aov_means(
+    const size_t                        x,
+    const size_t                        y)
+{
+    return &m_aov_means[(y * m_width + x) * m_aov_channel_count];
+}
+
+inline const foundation::Half* ShadingResultFrameBuffer::aov_means(
+    const size_t                        x,
+    const size_t                        y) const
 {
-    // The main image plus a number of AOVs, all RGBA.
-    return (1 + aov_count) * 4;
+    return &m_aov_means[(y * m_width + x) * m_aov_channel_count];
 }
 
 }   // namespace renderer
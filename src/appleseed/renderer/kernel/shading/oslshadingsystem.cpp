@@ -54,6 +54,46 @@ void OSLShadingSystem::release()
     delete this;
 }
 
+OSL::ShaderGroupRef OSLShadingSystem::get_cached_shader_group(const std::uint64_t hash) const
+{
+    const auto i = m_shader_group_cache.find(hash);
+    return i != m_shader_group_cache.end() ? i->second : OSL::ShaderGroupRef();
+}
+
+void OSLShadingSystem::insert_cached_shader_group(
+    const std::uint64_t         hash,
+    const OSL::ShaderGroupRef&  shader_group_ref)
+{
+    m_shader_group_cache[hash] = shader_group_ref;
+}
+
+void OSLShadingSystem::clear_shader_group_cache()
+{
+    m_shader_group_cache.clear();
+}
+
+size_t OSLShadingSystem::evict_unreferenced_shader_groups()
+{
+    size_t evicted_count = 0;
+
+    for (auto i = m_shader_group_cache.begin(); i != m_shader_group_cache.end(); )
+    {
+        if (i->second.use_count() == 1)
+        {
+            i = m_shader_group_cache.erase(i);
+            ++evicted_count;
+        }
+        else ++i;
+    }
+
+    return evicted_count;
+}
+
+size_t OSLShadingSystem::get_cached_shader_group_count() const
+{
+    return m_shader_group_cache.size();
+}
+
 
 //
 // OSLShadingSystemFactory class implementation.
@@ -34,6 +34,11 @@
 #include "OSL/oslversion.h"
 #include "foundation/platform/_endoslheaders.h"
 
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
 // Forward declarations.
 namespace renderer { class OIIOErrorHandler; }
 namespace renderer { class OIIOTextureSystem; }
@@ -45,6 +50,11 @@ namespace renderer
 //
 // Simple wrapper around OSL's ShadingSystem.
 //
+// Also keeps a cache of the shader groups created by this shading system,
+// indexed by a hash of their definition, so that identical shader groups
+// are only created, optimized and JIT-compiled once. Shader groups that are
+// no longer used by any scene entity are evicted after each scene setup.
+//
 
 class OSLShadingSystem
   : public OSL::ShadingSystem
@@ -52,9 +62,29 @@ class OSLShadingSystem
   public:
     void release();
 
+    // Return the cached shader group with a given definition hash, or an empty reference.
+    OSL::ShaderGroupRef get_cached_shader_group(const std::uint64_t hash) const;
+
+    // Insert a shader group into the cache.
+    void insert_cached_shader_group(
+        const std::uint64_t         hash,
+        const OSL::ShaderGroupRef&  shader_group_ref);
+
+    // Remove all shader groups from the cache.
+    void clear_shader_group_cache();
+
+    // Remove the shader groups that are only referenced by the cache.
+    // Return the number of shader groups that were removed.
+    size_t evict_unreferenced_shader_groups();
+
+    // Return the number of shader groups in the cache.
+    size_t get_cached_shader_group_count() const;
+
   private:
     friend class OSLShadingSystemFactory;
 
+    std::unordered_map<std::uint64_t, OSL::ShaderGroupRef> m_shader_group_cache;
+
     OSLShadingSystem(
         RendererServices*   renderer = nullptr,
         OIIOTextureSystem*  texturesystem = nullptr,
@@ -62,6 +62,9 @@ class ShadingResult
     // The main output and AOVs are cleared to transparent black.
     explicit ShadingResult(const size_t aov_count = 0);
 
+    // Clear the main output and AOVs to transparent black.
+    void clear();
+
     // Return true if the main output is finite (not NaN, not infinite) and non-negative.
     bool is_main_valid() const;
 
@@ -88,6 +91,11 @@ inline ShadingResult::ShadingResult(const size_t aov_count)
 {
     assert(aov_count <= MaxAOVCount);
 
+    clear();
+}
+
+inline void ShadingResult::clear()
+{
     m_main.set(0.0f);
 
     for (size_t i = 0, e = m_aov_count; i < e; ++i)
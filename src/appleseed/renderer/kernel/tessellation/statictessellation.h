@@ -144,6 +144,9 @@ class StaticTessellation
     // Compute the local space bounding box of the tessellation over the shutter interval.
     GAABB3 compute_local_bbox() const;
 
+    // Return the size (in bytes) of this object in memory.
+    size_t get_memory_size() const;
+
   private:
     foundation::AttributeSet::ChannelID m_uv_0_cid;         // UV coordinates set #0
     foundation::AttributeSet::ChannelID m_tangents_cid;     // per-vertex tangent vectors
@@ -478,6 +481,23 @@ GAABB3 StaticTessellation<Primitive>::compute_local_bbox() const
     return bbox;
 }
 
+template <typename Primitive>
+size_t StaticTessellation<Primitive>::get_memory_size() const
+{
+    return
+          sizeof(*this)
+        - 6 * sizeof(foundation::AttributeSet)
+        + m_vertices.capacity() * sizeof(GVector3)
+        + m_vertex_normals.capacity() * sizeof(GVector3)
+        + m_primitives.capacity() * sizeof(PrimitiveType)
+        + m_tessellation_attributes.get_memory_size()
+        + m_vertex_attributes.get_memory_size()
+        + m_vertex_normal_attributes.get_memory_size()
+        + m_vertex_tangent_attributes.get_memory_size()
+        + m_vertex_tangent_poses.get_memory_size()
+        + m_primitive_attributes.get_memory_size();
+}
+
 template <typename Primitive>
 void StaticTessellation<Primitive>::create_uv_0_attribute()
 {
@@ -32,13 +32,16 @@
 
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
+#include "renderer/modeling/project/textureconverter.h"
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/scene.h"
 #include "renderer/modeling/texture/texture.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
 #include "foundation/containers/dictionary.h"
+#include "foundation/image/canvasproperties.h"
 #include "foundation/image/color.h"
 #include "foundation/image/colorspace.h"
 #include "foundation/image/tile.h"
@@ -72,6 +75,22 @@ Dictionary TextureStore::get_params_metadata()
             .insert("label", "Texture Cache Size")
             .insert("help", "Texture cache size in bytes"));
 
+    metadata.dictionaries().insert(
+        "convert_textures",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "off")
+            .insert("label", "Convert Textures")
+            .insert("help", "Convert scanline and non-mipmapped texture files to tiled and mipmapped .tx files before rendering"));
+
+    metadata.dictionaries().insert(
+        "converted_textures_directory",
+        Dictionary()
+            .insert("type", "text")
+            .insert("default", TextureConverter::get_default_cache_directory())
+            .insert("label", "Converted Textures Directory")
+            .insert("help", "Directory where converted texture files are cached"));
+
     return metadata;
 }
 
@@ -92,6 +111,9 @@ StatisticsVector TextureStore::get_statistics() const
 {
     Statistics stats = make_single_stage_cache_stats(m_tile_cache);
     stats.insert_size("peak size", m_tile_swapper.get_peak_memory_size());
+    stats.insert("base level tiles loaded", m_tile_swapper.get_base_level_tile_count());
+    stats.insert("mip level tiles loaded", m_tile_swapper.get_mip_level_tile_count());
+    stats.insert("base level tiles avoided", m_tile_swapper.get_avoided_base_level_tile_count());
     return StatisticsVector::make("texture store statistics", stats);
 }
 
@@ -159,6 +181,31 @@ namespace
             }
         }
     }
+
+    // Count the base level tiles covered by a given tile of a given MIP level.
+    size_t count_covered_base_level_tiles(
+        const CanvasProperties&     base_props,
+        const CanvasProperties&     level_props,
+        const size_t                tile_x,
+        const size_t                tile_y)
+    {
+        // Compute the extent of the tile in MIP level space.
+        const size_t origin_x = tile_x * level_props.m_tile_width;
+        const size_t origin_y = tile_y * level_props.m_tile_height;
+        const size_t end_x = std::min(origin_x + level_props.m_tile_width, level_props.m_canvas_width);
+        const size_t end_y = std::min(origin_y + level_props.m_tile_height, level_props.m_canvas_height);
+
+        // Compute the extent of the tile in base level space.
+        const size_t base_x0 = origin_x * base_props.m_canvas_width / level_props.m_canvas_width;
+        const size_t base_y0 = origin_y * base_props.m_canvas_height / level_props.m_canvas_height;
+        const size_t base_x1 = (end_x * base_props.m_canvas_width + level_props.m_canvas_width - 1) / level_props.m_canvas_width;
+        const size_t base_y1 = (end_y * base_props.m_canvas_height + level_props.m_canvas_height - 1) / level_props.m_canvas_height;
+
+        const size_t tile_count_x = (base_x1 - 1) / base_props.m_tile_width - base_x0 / base_props.m_tile_width + 1;
+        const size_t tile_count_y = (base_y1 - 1) / base_props.m_tile_height - base_y0 / base_props.m_tile_height + 1;
+
+        return tile_count_x * tile_count_y;
+    }
 }
 
 TextureStore::TileSwapper::TileSwapper(
@@ -168,6 +215,9 @@ TextureStore::TileSwapper::TileSwapper(
   , m_params(params)
   , m_memory_size(0)
   , m_peak_memory_size(0)
+  , m_base_level_tile_count(0)
+  , m_mip_level_tile_count(0)
+  , m_avoided_base_level_tile_count(0)
 {
     gather_assemblies(scene.assemblies());
     print_settings();
@@ -202,17 +252,41 @@ void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
     if (m_params.m_track_tile_loading)
     {
         RENDERER_LOG_DEBUG(
-            "loading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") "
+            "loading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") of mip level " FMT_SIZE_T " "
             "from texture \"%s\"...",
             key.get_tile_x(),
             key.get_tile_y(),
+            key.get_level(),
             texture->get_path().c_str());
     }
 
     // Load the tile.
-    record.m_tile_ptr = texture->load_tile(key.get_tile_x(), key.get_tile_y());
+    record.m_tile_ptr =
+        texture->load_mip_level_tile(
+            key.get_level(),
+            key.get_tile_x(),
+            key.get_tile_y());
     record.m_owners = 0;
 
+    // Keep track of the base level tiles that the tile stands in for. Generated MIP
+    // levels are computed from the base level, so they don't save any reading.
+    if (key.get_level() == 0)
+        ++m_base_level_tile_count;
+    else
+    {
+        ++m_mip_level_tile_count;
+
+        if (texture->has_stored_mip_levels())
+        {
+            m_avoided_base_level_tile_count +=
+                count_covered_base_level_tiles(
+                    texture->get_mip_level_properties(0),
+                    texture->get_mip_level_properties(key.get_level()),
+                    key.get_tile_x(),
+                    key.get_tile_y());
+        }
+    }
+
     // Convert the tile to the linear RGB color space.
     switch (texture->get_color_space())
     {
@@ -231,9 +305,24 @@ void TextureStore::TileSwapper::load(const TileKey& key, TileRecord& record)
     }
 
     // Track the amount of memory used by the tile cache.
-    m_memory_size += record.m_tile_ptr.get_tile()->get_memory_size();
+    const size_t tile_memory_size = record.m_tile_ptr.get_tile()->get_memory_size();
+    m_memory_size += tile_memory_size;
     m_peak_memory_size = std::max(m_peak_memory_size, m_memory_size);
 
+    // Attribute the memory used by the tile to its texture. The texture path is remembered
+    // since the texture may no longer exist when the tile gets unloaded.
+    TexturePathMap::iterator texture_path_it = m_texture_paths.find(key.m_texture_uid);
+    if (texture_path_it == m_texture_paths.end())
+    {
+        texture_path_it =
+            m_texture_paths.insert(
+                std::make_pair(key.m_texture_uid, std::string(texture->get_path().c_str()))).first;
+    }
+    global_memory_tracker().add(
+        MemoryTracker::CategoryTexture,
+        texture_path_it->second.c_str(),
+        tile_memory_size);
+
     if (m_params.m_track_store_size)
     {
         if (m_memory_size > m_params.m_memory_limit)
@@ -266,6 +355,13 @@ bool TextureStore::TileSwapper::unload(const TileKey& key, TileRecord& record)
     assert(m_memory_size >= tile_memory_size);
     m_memory_size -= tile_memory_size;
 
+    const TexturePathMap::const_iterator texture_path_it = m_texture_paths.find(key.m_texture_uid);
+    assert(texture_path_it != m_texture_paths.end());
+    global_memory_tracker().subtract(
+        MemoryTracker::CategoryTexture,
+        texture_path_it->second.c_str(),
+        tile_memory_size);
+
     if (m_params.m_track_tile_unloading)
     {
         // Fetch the texture container.
@@ -280,19 +376,21 @@ bool TextureStore::TileSwapper::unload(const TileKey& key, TileRecord& record)
         if (texture != nullptr)
         {
             RENDERER_LOG_DEBUG(
-                "unloading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") "
+                "unloading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") of mip level " FMT_SIZE_T " "
                 "from texture \"%s\"...",
                 key.get_tile_x(),
                 key.get_tile_y(),
+                key.get_level(),
                 texture->get_path().c_str());
         }
         else
         {
             RENDERER_LOG_DEBUG(
-                "unloading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") "
+                "unloading tile (" FMT_SIZE_T ", " FMT_SIZE_T ") of mip level " FMT_SIZE_T " "
                 "from defunct texture...",
                 key.get_tile_x(),
-                key.get_tile_y());
+                key.get_tile_y(),
+                key.get_level());
         }
     }
 
@@ -46,6 +46,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <string>
 
 // Forward declarations.
 namespace foundation    { class Dictionary; }
@@ -70,6 +71,7 @@ class TextureStore
         foundation::UniqueID    m_assembly_uid;
         foundation::UniqueID    m_texture_uid;
         std::uint32_t           m_tile_xy;
+        std::uint32_t           m_level;            // MIP level, 0 is the base level
 
         TileKey();
 
@@ -77,7 +79,8 @@ class TextureStore
             const foundation::UniqueID  assembly_uid,
             const foundation::UniqueID  texture_uid,
             const size_t                tile_x,
-            const size_t                tile_y);
+            const size_t                tile_y,
+            const size_t                level = 0);
 
         TileKey(
             const foundation::UniqueID  assembly_uid,
@@ -88,6 +91,7 @@ class TextureStore
 
         size_t get_tile_x() const;
         size_t get_tile_y() const;
+        size_t get_level() const;
 
         // Return an invalid key.
         static TileKey invalid();
@@ -154,6 +158,16 @@ class TextureStore
         // Return the peak memory size in bytes of the tile cache.
         size_t get_peak_memory_size() const;
 
+        // Return the number of tiles loaded from the base level of textures.
+        std::uint64_t get_base_level_tile_count() const;
+
+        // Return the number of tiles loaded from coarser MIP levels of textures.
+        std::uint64_t get_mip_level_tile_count() const;
+
+        // Return the number of base level tiles covered by the MIP level tiles that
+        // were loaded in their place, counting only MIP levels stored in texture files.
+        std::uint64_t get_avoided_base_level_tile_count() const;
+
       private:
         struct Parameters
         {
@@ -166,12 +180,17 @@ class TextureStore
         };
 
         typedef std::map<foundation::UniqueID, const Assembly*> AssemblyMap;
+        typedef std::map<foundation::UniqueID, std::string> TexturePathMap;
 
         const Scene&        m_scene;
         const Parameters    m_params;
         size_t              m_memory_size;
         size_t              m_peak_memory_size;
+        std::uint64_t       m_base_level_tile_count;
+        std::uint64_t       m_mip_level_tile_count;
+        std::uint64_t       m_avoided_base_level_tile_count;
         AssemblyMap         m_assemblies;
+        TexturePathMap      m_texture_paths;    // texture UID -> path of textures with loaded tiles
 
         void gather_assemblies(const AssemblyContainer& assemblies);
     };
@@ -223,10 +242,12 @@ inline TextureStore::TileKey::TileKey(
     const foundation::UniqueID  assembly_uid,
     const foundation::UniqueID  texture_uid,
     const size_t                tile_x,
-    const size_t                tile_y)
+    const size_t                tile_y,
+    const size_t                level)
   : m_assembly_uid(assembly_uid)
   , m_texture_uid(texture_uid)
   , m_tile_xy(static_cast<std::uint32_t>((tile_y << 16) | tile_x))
+  , m_level(static_cast<std::uint32_t>(level))
 {
     assert(tile_x < (1UL << 16));
     assert(tile_y < (1UL << 16));
@@ -239,6 +260,7 @@ inline TextureStore::TileKey::TileKey(
   : m_assembly_uid(assembly_uid)
   , m_texture_uid(texture_uid)
   , m_tile_xy(tile_xy)
+  , m_level(0)
 {
 }
 
@@ -246,6 +268,7 @@ inline TextureStore::TileKey::TileKey(const TileKey& rhs)
   : m_assembly_uid(rhs.m_assembly_uid)
   , m_texture_uid(rhs.m_texture_uid)
   , m_tile_xy(rhs.m_tile_xy)
+  , m_level(rhs.m_level)
 {
 }
 
@@ -259,19 +282,26 @@ inline size_t TextureStore::TileKey::get_tile_y() const
     return static_cast<size_t>(m_tile_xy >> 16);
 }
 
+inline size_t TextureStore::TileKey::get_level() const
+{
+    return static_cast<size_t>(m_level);
+}
+
 inline TextureStore::TileKey TextureStore::TileKey::invalid()
 {
-    return
-        TileKey(
-            ~foundation::UniqueID(0),   // assembly unique ID
-            ~foundation::UniqueID(0),   // texture unique ID
-            ~std::uint32_t(0));         // tile X and Y coordinates
+    TileKey key(
+        ~foundation::UniqueID(0),       // assembly unique ID
+        ~foundation::UniqueID(0),       // texture unique ID
+        ~std::uint32_t(0));             // tile X and Y coordinates
+    key.m_level = ~std::uint32_t(0);    // MIP level
+    return key;
 }
 
 inline bool TextureStore::TileKey::operator==(const TileKey& rhs) const
 {
     return
         m_tile_xy == rhs.m_tile_xy &&
+        m_level == rhs.m_level &&
         m_texture_uid == rhs.m_texture_uid &&
         m_assembly_uid == rhs.m_assembly_uid;
 }
@@ -286,7 +316,9 @@ inline bool TextureStore::TileKey::operator<(const TileKey& rhs) const
     return
         m_assembly_uid == rhs.m_assembly_uid ?
             m_texture_uid == rhs.m_texture_uid ?
-                m_tile_xy < rhs.m_tile_xy :
+                m_level == rhs.m_level ?
+                    m_tile_xy < rhs.m_tile_xy :
+                m_level < rhs.m_level :
             m_texture_uid < rhs.m_texture_uid :
         m_assembly_uid < rhs.m_assembly_uid;
 }
@@ -302,7 +334,8 @@ inline size_t TextureStore::TileKeyHasher::operator()(const TileKey& key) const
         foundation::mix_uint32(
             static_cast<std::uint32_t>(key.m_assembly_uid),
             static_cast<std::uint32_t>(key.m_texture_uid),
-            static_cast<std::uint32_t>(key.m_tile_xy));
+            static_cast<std::uint32_t>(key.m_tile_xy),
+            static_cast<std::uint32_t>(key.m_level));
 }
 
 
@@ -320,4 +353,19 @@ inline size_t TextureStore::TileSwapper::get_peak_memory_size() const
     return m_peak_memory_size;
 }
 
+inline std::uint64_t TextureStore::TileSwapper::get_base_level_tile_count() const
+{
+    return m_base_level_tile_count;
+}
+
+inline std::uint64_t TextureStore::TileSwapper::get_mip_level_tile_count() const
+{
+    return m_mip_level_tile_count;
+}
+
+inline std::uint64_t TextureStore::TileSwapper::get_avoided_base_level_tile_count() const
+{
+    return m_avoided_base_level_tile_count;
+}
+
 }   // namespace renderer
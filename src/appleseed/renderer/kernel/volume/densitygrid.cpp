@@ -0,0 +1,285 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Interface header.
+#include "densitygrid.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using namespace foundation;
+
+namespace renderer
+{
+
+//
+// DensityGrid class implementation.
+//
+
+struct DensityGrid::OpticalDepthVisitor
+{
+    const DensityGrid&  m_grid;
+    const Vector3d&     m_org;
+    const Vector3d&     m_dir;
+    double              m_optical_depth;
+
+    OpticalDepthVisitor(
+        const DensityGrid&  grid,
+        const Vector3d&     org,
+        const Vector3d&     dir)
+      : m_grid(grid)
+      , m_org(org)
+      , m_dir(dir)
+      , m_optical_depth(0.0)
+    {
+    }
+
+    bool visit(const double t0, const double t1, const float min_density, const float max_density)
+    {
+        // Bricks of uniform density (apron included) don't need to be walked voxel by voxel.
+        if (min_density == max_density)
+            m_optical_depth += max_density * (t1 - t0);
+        else m_optical_depth += m_grid.integrate_density(m_org, m_dir, t0, t1);
+
+        return true;
+    }
+};
+
+struct DensityGrid::DeltaTrackingVisitor
+{
+    const DensityGrid&  m_grid;
+    const Vector3d&     m_org;
+    const Vector3d&     m_dir;
+    SamplingContext&    m_sampling_context;
+    const float         m_extinction_scale;
+    double              m_t;
+    bool                m_collided;
+
+    DeltaTrackingVisitor(
+        const DensityGrid&  grid,
+        const Vector3d&     org,
+        const Vector3d&     dir,
+        SamplingContext&    sampling_context,
+        const float         extinction_scale)
+      : m_grid(grid)
+      , m_org(org)
+      , m_dir(dir)
+      , m_sampling_context(sampling_context)
+      , m_extinction_scale(extinction_scale)
+      , m_t(0.0)
+      , m_collided(false)
+    {
+    }
+
+    bool visit(const double t0, const double t1, const float min_density, const float max_density)
+    {
+        // The maximum density of the brick gives a tight majorant over this segment.
+        const double majorant = static_cast<double>(m_extinction_scale) * max_density;
+        if (majorant <= 0.0)
+            return true;
+
+        double t = t0;
+
+        while (true)
+        {
+            m_sampling_context.split_in_place(2, 1);
+            const Vector2d s = m_sampling_context.next2<Vector2d>();
+
+            // Tentative collision with the majorant medium. Free flights are memoryless,
+            // so leaving the brick simply continues tracking in the next one.
+            t -= std::log(1.0 - s[0]) / majorant;
+            if (t >= t1)
+                return true;
+
+            // Accept the collision with probability density / majorant, otherwise it is a null collision.
+            if (s[1] * max_density < m_grid.get_grid_density(m_org + t * m_dir))
+            {
+                m_t = t;
+                m_collided = true;
+                return false;
+            }
+        }
+    }
+};
+
+DensityGrid::DensityGrid(
+    std::unique_ptr<VoxelGrid>      voxel_grid,
+    const size_t                    density_channel_index,
+    const AABB3d&                   bbox)
+  : m_voxel_grid(std::move(voxel_grid))
+  , m_density_channel_index(density_channel_index)
+  , m_bbox(bbox)
+  , m_rcp_extent(Vector3d(1.0) / bbox.extent())
+  , m_occupancy_grid(*m_voxel_grid, density_channel_index, 0.0f)
+{
+    assert(density_channel_index < m_voxel_grid->get_channel_count());
+    assert(bbox.is_valid());
+}
+
+float DensityGrid::compute_optical_depth(
+    const Vector3d&                 org,
+    const Vector3d&                 dir,
+    const double                    tmin,
+    const double                    tmax) const
+{
+    Vector3d grid_org, grid_dir;
+    to_grid_space(org, dir, grid_org, grid_dir);
+
+    OpticalDepthVisitor visitor(*this, grid_org, grid_dir);
+    m_occupancy_grid.traverse(grid_org, grid_dir, tmin, tmax, visitor);
+
+    return static_cast<float>(visitor.m_optical_depth);
+}
+
+bool DensityGrid::sample_collision(
+    SamplingContext&                sampling_context,
+    const Vector3d&                 org,
+    const Vector3d&                 dir,
+    const double                    tmin,
+    const double                    tmax,
+    const float                     extinction_scale,
+    double&                         t) const
+{
+    Vector3d grid_org, grid_dir;
+    to_grid_space(org, dir, grid_org, grid_dir);
+
+    DeltaTrackingVisitor visitor(*this, grid_org, grid_dir, sampling_context, extinction_scale);
+    m_occupancy_grid.traverse(grid_org, grid_dir, tmin, tmax, visitor);
+
+    t = visitor.m_t;
+    return visitor.m_collided;
+}
+
+size_t DensityGrid::get_memory_size() const
+{
+    return
+          sizeof(*this)
+        - sizeof(OccupancyGrid)
+        + m_occupancy_grid.get_memory_size()
+        + m_voxel_grid->get_xres()
+            * m_voxel_grid->get_yres()
+            * m_voxel_grid->get_zres()
+            * m_voxel_grid->get_channel_count()
+            * sizeof(float);
+}
+
+float DensityGrid::integrate_density(
+    const Vector3d&                 grid_org,
+    const Vector3d&                 grid_dir,
+    const double                    t0,
+    const double                    t1) const
+{
+    // Set up a 3D DDA over the voxels, like OccupancyGrid::traverse() does over the bricks.
+    const size_t res[3] =
+    {
+        m_voxel_grid->get_xres(),
+        m_voxel_grid->get_yres(),
+        m_voxel_grid->get_zres()
+    };
+    const Vector3d entry = grid_org + t0 * grid_dir;
+    size_t cell[3];
+    int step[3];
+    double t_next[3], t_delta[3];
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const double scale = static_cast<double>(res[i]);
+
+        cell[i] =
+            std::min(
+                truncate<size_t>(std::max(entry[i] * scale, 0.0)),
+                res[i] - 1);
+
+        if (grid_dir[i] > 0.0)
+        {
+            step[i] = +1;
+            t_next[i] = ((cell[i] + 1) / scale - grid_org[i]) / grid_dir[i];
+            t_delta[i] = 1.0 / (scale * grid_dir[i]);
+        }
+        else if (grid_dir[i] < 0.0)
+        {
+            step[i] = -1;
+            t_next[i] = (cell[i] / scale - grid_org[i]) / grid_dir[i];
+            t_delta[i] = -1.0 / (scale * grid_dir[i]);
+        }
+        else
+        {
+            step[i] = 0;
+            t_next[i] = std::numeric_limits<double>::max();
+            t_delta[i] = std::numeric_limits<double>::max();
+        }
+    }
+
+    double optical_depth = 0.0;
+    double t = t0;
+
+    while (true)
+    {
+        // Find the dimension along which the ray leaves the current voxel.
+        const size_t axis =
+            t_next[0] < t_next[1]
+                ? (t_next[0] < t_next[2] ? 0 : 2)
+                : (t_next[1] < t_next[2] ? 1 : 2);
+
+        const double t_exit = std::min(t_next[axis], t1);
+
+        if (t_exit > t)
+        {
+            const float density = m_voxel_grid->voxel(cell[0], cell[1], cell[2])[m_density_channel_index];
+            optical_depth += density * (t_exit - t);
+        }
+
+        if (t_exit >= t1)
+            break;
+
+        // Move to the next voxel.
+        if (step[axis] > 0)
+        {
+            if (++cell[axis] == res[axis])
+                break;
+        }
+        else
+        {
+            if (cell[axis]-- == 0)
+                break;
+        }
+
+        t = t_exit;
+        t_next[axis] += t_delta[axis];
+    }
+
+    return static_cast<float>(optical_depth);
+}
+
+}   // namespace renderer
@@ -0,0 +1,175 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/volume/occupancygrid.h"
+#include "renderer/kernel/volume/volume.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/aabb.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+
+namespace renderer
+{
+
+//
+// A heterogeneous density field defined by one channel of a voxel grid mapped onto
+// an axis-aligned box in world space.
+//
+// Densities are constant over each voxel, so optical depths along rays are computed
+// exactly by walking the voxels pierced by the ray. Empty space is skipped with an
+// occupancy grid whose brick majorants also drive delta tracking.
+//
+// Ray parameters are expressed in the units of the ray they apply to: mapping a ray
+// to the unit cube of the voxel grid does not change them.
+//
+
+class DensityGrid
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor. Takes ownership of the voxel grid.
+    DensityGrid(
+        std::unique_ptr<VoxelGrid>  voxel_grid,
+        const size_t                density_channel_index,
+        const foundation::AABB3d&   bbox);
+
+    // Return the world space box the voxel grid is mapped onto.
+    const foundation::AABB3d& get_bbox() const;
+
+    // Access the occupancy grid.
+    const OccupancyGrid& get_occupancy_grid() const;
+
+    // Return the density at a given world space point, 0 outside the box.
+    float get_density(const foundation::Vector3d& point) const;
+
+    // Return the integral of the density over the segment [tmin, tmax] of a world space ray.
+    float compute_optical_depth(
+        const foundation::Vector3d& org,
+        const foundation::Vector3d& dir,
+        const double                tmin,
+        const double                tmax) const;
+
+    // Sample the first collision along the segment [tmin, tmax) of a world space ray,
+    // in a medium whose extinction coefficient is extinction_scale times the density,
+    // using delta tracking. Return false if the ray leaves the segment without colliding.
+    bool sample_collision(
+        SamplingContext&            sampling_context,
+        const foundation::Vector3d& org,
+        const foundation::Vector3d& dir,
+        const double                tmin,
+        const double                tmax,
+        const float                 extinction_scale,
+        double&                     t) const;
+
+    // Return the size (in bytes) of this object in memory.
+    size_t get_memory_size() const;
+
+  private:
+    std::unique_ptr<VoxelGrid>      m_voxel_grid;
+    const size_t                    m_density_channel_index;
+    const foundation::AABB3d        m_bbox;
+    const foundation::Vector3d      m_rcp_extent;
+    const OccupancyGrid             m_occupancy_grid;
+
+    // Map a world space ray to the unit cube of the voxel grid.
+    void to_grid_space(
+        const foundation::Vector3d& org,
+        const foundation::Vector3d& dir,
+        foundation::Vector3d&       grid_org,
+        foundation::Vector3d&       grid_dir) const;
+
+    // Return the density of the voxel containing a given point of the unit cube.
+    float get_grid_density(const foundation::Vector3d& grid_point) const;
+
+    // Return the integral of the density over a segment of a grid space ray.
+    float integrate_density(
+        const foundation::Vector3d& grid_org,
+        const foundation::Vector3d& grid_dir,
+        const double                t0,
+        const double                t1) const;
+
+    struct OpticalDepthVisitor;
+    struct DeltaTrackingVisitor;
+};
+
+
+//
+// DensityGrid class implementation.
+//
+
+inline const foundation::AABB3d& DensityGrid::get_bbox() const
+{
+    return m_bbox;
+}
+
+inline const OccupancyGrid& DensityGrid::get_occupancy_grid() const
+{
+    return m_occupancy_grid;
+}
+
+inline float DensityGrid::get_density(const foundation::Vector3d& point) const
+{
+    if (!m_bbox.contains(point))
+        return 0.0f;
+
+    return get_grid_density((point - m_bbox.min) * m_rcp_extent);
+}
+
+inline void DensityGrid::to_grid_space(
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    foundation::Vector3d&           grid_org,
+    foundation::Vector3d&           grid_dir) const
+{
+    grid_org = (org - m_bbox.min) * m_rcp_extent;
+    grid_dir = dir * m_rcp_extent;
+}
+
+inline float DensityGrid::get_grid_density(const foundation::Vector3d& grid_point) const
+{
+    // Same voxel selection as foundation::VoxelGrid3::nearest_lookup() and OccupancyGrid.
+    const size_t nx = m_voxel_grid->get_xres();
+    const size_t ny = m_voxel_grid->get_yres();
+    const size_t nz = m_voxel_grid->get_zres();
+    const size_t x = foundation::truncate<size_t>(foundation::clamp(grid_point.x * nx, 0.0, nx - 1.0));
+    const size_t y = foundation::truncate<size_t>(foundation::clamp(grid_point.y * ny, 0.0, ny - 1.0));
+    const size_t z = foundation::truncate<size_t>(foundation::clamp(grid_point.z * nz, 0.0, nz - 1.0));
+
+    return m_voxel_grid->voxel(x, y, z)[m_density_channel_index];
+}
+
+}   // namespace renderer
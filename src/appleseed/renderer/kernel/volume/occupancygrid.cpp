@@ -30,6 +30,10 @@
 // Interface header.
 #include "occupancygrid.h"
 
+// Standard headers.
+#include <cassert>
+#include <cstring>
+
 using namespace foundation;
 
 namespace renderer
@@ -43,11 +47,12 @@ OccupancyGrid::OccupancyGrid(
     const VoxelGrid&    voxel_grid,
     const size_t        density_channel_index,
     const float         occupancy_threshold)
-  : m_grid(
-        voxel_grid.get_xres(),
-        voxel_grid.get_yres(),
-        voxel_grid.get_zres(),
-        1)
+  : m_nx(voxel_grid.get_xres())
+  , m_ny(voxel_grid.get_yres())
+  , m_nz(voxel_grid.get_zres())
+  , m_bx((m_nx + BrickSize - 1) / BrickSize)
+  , m_by((m_ny + BrickSize - 1) / BrickSize)
+  , m_bz((m_nz + BrickSize - 1) / BrickSize)
 {
     initialize(
         voxel_grid,
@@ -55,26 +60,146 @@ OccupancyGrid::OccupancyGrid(
         occupancy_threshold);
 }
 
+size_t OccupancyGrid::get_empty_brick_count() const
+{
+    size_t count = 0;
+
+    for (const Brick& brick : m_bricks)
+        count += brick.m_mask_index == EmptyBrick ? 1 : 0;
+
+    return count;
+}
+
+size_t OccupancyGrid::get_partial_brick_count() const
+{
+    return m_masks.size();
+}
+
+size_t OccupancyGrid::get_full_brick_count() const
+{
+    size_t count = 0;
+
+    for (const Brick& brick : m_bricks)
+        count += brick.m_mask_index == FullBrick ? 1 : 0;
+
+    return count;
+}
+
+size_t OccupancyGrid::get_memory_size() const
+{
+    return
+          sizeof(*this)
+        + m_bricks.capacity() * sizeof(Brick)
+        + m_masks.capacity() * sizeof(BrickMask);
+}
+
 void OccupancyGrid::initialize(
     const VoxelGrid&    voxel_grid,
     const size_t        density_channel_index,
     const float         occupancy_threshold)
 {
-    for (size_t z = 0; z < m_grid.get_zres(); ++z)
+    m_bricks.resize(m_bx * m_by * m_bz);
+    m_masks.clear();
+
+    for (size_t bz = 0; bz < m_bz; ++bz)
+    {
+        for (size_t by = 0; by < m_by; ++by)
+        {
+            for (size_t bx = 0; bx < m_bx; ++bx)
+            {
+                Brick& brick = m_bricks[(bz * m_by + by) * m_bx + bx];
+
+                compute_density_range(
+                    voxel_grid,
+                    density_channel_index,
+                    bx,
+                    by,
+                    bz,
+                    brick);
+
+                // Compute the occupancy of the voxels of this brick.
+                BrickMask mask;
+                std::memset(mask.m_bits, 0, sizeof(mask.m_bits));
+                size_t voxel_count = 0;
+                size_t occupied_voxel_count = 0;
+
+                const size_t x_end = std::min((bx + 1) * BrickSize, m_nx);
+                const size_t y_end = std::min((by + 1) * BrickSize, m_ny);
+                const size_t z_end = std::min((bz + 1) * BrickSize, m_nz);
+
+                for (size_t z = bz * BrickSize; z < z_end; ++z)
+                {
+                    for (size_t y = by * BrickSize; y < y_end; ++y)
+                    {
+                        for (size_t x = bx * BrickSize; x < x_end; ++x)
+                        {
+                            const float density_sum =
+                                get_density_sum(
+                                    voxel_grid,
+                                    density_channel_index,
+                                    x,
+                                    y,
+                                    z);
+
+                            ++voxel_count;
+
+                            if (density_sum > occupancy_threshold)
+                            {
+                                const size_t bit = get_bit_index(x % BrickSize, y % BrickSize, z % BrickSize);
+                                mask.m_bits[bit / 64] |= std::uint64_t(1) << (bit % 64);
+                                ++occupied_voxel_count;
+                            }
+                        }
+                    }
+                }
+
+                // Only store occupancy bits for partially occupied bricks.
+                if (occupied_voxel_count == 0)
+                    brick.m_mask_index = EmptyBrick;
+                else if (occupied_voxel_count == voxel_count)
+                    brick.m_mask_index = FullBrick;
+                else
+                {
+                    brick.m_mask_index = static_cast<std::uint32_t>(m_masks.size());
+                    m_masks.push_back(mask);
+                }
+            }
+        }
+    }
+
+    m_masks.shrink_to_fit();
+}
+
+void OccupancyGrid::compute_density_range(
+    const VoxelGrid&    voxel_grid,
+    const size_t        density_channel_index,
+    const size_t        bx,
+    const size_t        by,
+    const size_t        bz,
+    Brick&              brick) const
+{
+    brick.m_min_density = std::numeric_limits<float>::max();
+    brick.m_max_density = 0.0f;
+
+    // Include a one-voxel apron around the brick to bound interpolated lookups.
+    const size_t x_begin = bx * BrickSize > 0 ? bx * BrickSize - 1 : 0;
+    const size_t y_begin = by * BrickSize > 0 ? by * BrickSize - 1 : 0;
+    const size_t z_begin = bz * BrickSize > 0 ? bz * BrickSize - 1 : 0;
+    const size_t x_end = std::min((bx + 1) * BrickSize + 1, m_nx);
+    const size_t y_end = std::min((by + 1) * BrickSize + 1, m_ny);
+    const size_t z_end = std::min((bz + 1) * BrickSize + 1, m_nz);
+
+    for (size_t z = z_begin; z < z_end; ++z)
     {
-        for (size_t y = 0; y < m_grid.get_yres(); ++y)
+        for (size_t y = y_begin; y < y_end; ++y)
         {
-            for (size_t x = 0; x < m_grid.get_xres(); ++x)
+            for (size_t x = x_begin; x < x_end; ++x)
             {
-                const float density_sum =
-                    get_density_sum(
-                        voxel_grid,
-                        density_channel_index,
-                        x,
-                        y,
-                        z);
-
-                m_grid.voxel(x, y, z)[0] = density_sum > occupancy_threshold ? 1 : 0;
+                const float density = voxel_grid.voxel(x, y, z)[density_channel_index];
+                assert(density >= 0.0f);
+
+                brick.m_min_density = std::min(brick.m_min_density, density);
+                brick.m_max_density = std::max(brick.m_max_density, density);
             }
         }
     }
@@ -33,36 +33,138 @@
 #include "renderer/kernel/volume/volume.h"
 
 // appleseed.foundation headers.
-#include "foundation/math/voxelgrid.h"
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 namespace renderer
 {
 
+//
+// A sparse occupancy grid built from the density channel of a voxel grid.
+//
+// The grid is split into bricks of BrickSize^3 voxels. Each brick stores the
+// minimum and maximum density of its voxels (plus a one-voxel apron so that
+// interpolated lookups are bounded too); per-voxel occupancy bits are only
+// stored for bricks that are partially occupied. This allows to skip empty
+// space when marching rays and provides tight majorants for delta and ratio
+// tracking.
+//
+// All points and rays are expressed in the unit cube [0,1]^3, like lookups
+// in the voxel grid.
+//
+// The grid is used by DensityGrid, which backs the heterogeneous GridVolume model.
+//
+
 class OccupancyGrid
   : public foundation::NonCopyable
 {
   public:
+    // Size of a brick in voxels along each dimension.
+    static const size_t BrickSize = 8;
+
     OccupancyGrid(
         const VoxelGrid&    voxel_grid,
         const size_t        density_channel_index,
         const float         occupancy_threshold);
 
+    // Return true if the voxel containing a given point contains fluid.
     bool has_fluid(const foundation::Vector3d& point) const;
 
+    // Return the maximum density of the brick containing a given point.
+    float get_max_density(const foundation::Vector3d& point) const;
+
+    // Visit the non-empty bricks pierced by the segment [tmin, tmax) of a ray, in
+    // front-to-back order. For each brick, the visitor's method
+    //
+    //   bool visit(double t0, double t1, float min_density, float max_density);
+    //
+    // is called with the ray segment [t0, t1) overlapping the brick. Traversal
+    // stops as soon as visit() returns false.
+    template <typename Visitor>
+    void traverse(
+        const foundation::Vector3d& org,
+        const foundation::Vector3d& dir,
+        const double                tmin,
+        const double                tmax,
+        Visitor&                    visitor) const;
+
+    // Return the number of empty, partially occupied and fully occupied bricks.
+    size_t get_empty_brick_count() const;
+    size_t get_partial_brick_count() const;
+    size_t get_full_brick_count() const;
+
+    // Return the size (in bytes) of this object in memory.
+    size_t get_memory_size() const;
+
   private:
-    foundation::VoxelGrid3<unsigned char, double> m_grid;
+    static const std::uint32_t EmptyBrick = ~std::uint32_t(0);
+    static const std::uint32_t FullBrick = ~std::uint32_t(0) - 1;
+
+    struct Brick
+    {
+        float               m_min_density;
+        float               m_max_density;
+        std::uint32_t       m_mask_index;       // EmptyBrick, FullBrick or index into m_masks
+    };
+
+    struct BrickMask
+    {
+        std::uint64_t       m_bits[BrickSize * BrickSize * BrickSize / 64];
+    };
+
+    size_t                  m_nx;               // grid resolution in voxels
+    size_t                  m_ny;
+    size_t                  m_nz;
+    size_t                  m_bx;               // grid resolution in bricks
+    size_t                  m_by;
+    size_t                  m_bz;
+    std::vector<Brick>      m_bricks;
+    std::vector<BrickMask>  m_masks;
 
     void initialize(
         const VoxelGrid&    voxel_grid,
         const size_t        density_channel_index,
         const float         occupancy_threshold);
 
+    void compute_density_range(
+        const VoxelGrid&    voxel_grid,
+        const size_t        density_channel_index,
+        const size_t        bx,
+        const size_t        by,
+        const size_t        bz,
+        Brick&              brick) const;
+
     float get_density_sum(
         const VoxelGrid&    voxel_grid,
         const size_t        density_channel_index,
         const size_t        x,
         const size_t        y,
         const size_t        z) const;
+
+    void get_voxel_coordinates(
+        const foundation::Vector3d& point,
+        size_t&             x,
+        size_t&             y,
+        size_t&             z) const;
+
+    const Brick& get_brick(
+        const size_t        bx,
+        const size_t        by,
+        const size_t        bz) const;
+
+    static size_t get_bit_index(
+        const size_t        x,
+        const size_t        y,
+        const size_t        z);
 };
 
 
@@ -72,9 +174,167 @@ class OccupancyGrid
 
 inline bool OccupancyGrid::has_fluid(const foundation::Vector3d& point) const
 {
-    unsigned char result;
-    m_grid.nearest_lookup(point, &result);
-    return result == 1;
+    size_t x, y, z;
+    get_voxel_coordinates(point, x, y, z);
+
+    const Brick& brick = get_brick(x / BrickSize, y / BrickSize, z / BrickSize);
+
+    if (brick.m_mask_index == EmptyBrick)
+        return false;
+
+    if (brick.m_mask_index == FullBrick)
+        return true;
+
+    const size_t bit = get_bit_index(x % BrickSize, y % BrickSize, z % BrickSize);
+    return (m_masks[brick.m_mask_index].m_bits[bit / 64] & (std::uint64_t(1) << (bit % 64))) != 0;
+}
+
+inline float OccupancyGrid::get_max_density(const foundation::Vector3d& point) const
+{
+    size_t x, y, z;
+    get_voxel_coordinates(point, x, y, z);
+
+    return get_brick(x / BrickSize, y / BrickSize, z / BrickSize).m_max_density;
+}
+
+template <typename Visitor>
+void OccupancyGrid::traverse(
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    Visitor&                        visitor) const
+{
+    // Clip the ray segment against the unit cube.
+    double t0 = tmin, t1 = tmax;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        if (dir[i] == 0.0)
+        {
+            if (org[i] < 0.0 || org[i] > 1.0)
+                return;
+        }
+        else
+        {
+            const double rcp_dir = 1.0 / dir[i];
+            double ta = -org[i] * rcp_dir;
+            double tb = (1.0 - org[i]) * rcp_dir;
+            if (ta > tb)
+                std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+        }
+    }
+
+    if (t0 >= t1)
+        return;
+
+    // Set up a 3D DDA over the bricks.
+    const size_t res[3] = { m_nx, m_ny, m_nz };
+    const size_t brick_res[3] = { m_bx, m_by, m_bz };
+    const foundation::Vector3d entry = org + t0 * dir;
+    size_t cell[3];
+    int step[3];
+    double t_next[3], t_delta[3];
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        // Number of bricks per unit length along this dimension.
+        const double scale = static_cast<double>(res[i]) / BrickSize;
+
+        cell[i] =
+            std::min(
+                foundation::truncate<size_t>(std::max(entry[i] * scale, 0.0)),
+                brick_res[i] - 1);
+
+        if (dir[i] > 0.0)
+        {
+            step[i] = +1;
+            t_next[i] = ((cell[i] + 1) / scale - org[i]) / dir[i];
+            t_delta[i] = 1.0 / (scale * dir[i]);
+        }
+        else if (dir[i] < 0.0)
+        {
+            step[i] = -1;
+            t_next[i] = (cell[i] / scale - org[i]) / dir[i];
+            t_delta[i] = -1.0 / (scale * dir[i]);
+        }
+        else
+        {
+            step[i] = 0;
+            t_next[i] = std::numeric_limits<double>::max();
+            t_delta[i] = std::numeric_limits<double>::max();
+        }
+    }
+
+    double t = t0;
+
+    while (true)
+    {
+        // Find the dimension along which the ray leaves the current brick.
+        const size_t axis =
+            t_next[0] < t_next[1]
+                ? (t_next[0] < t_next[2] ? 0 : 2)
+                : (t_next[1] < t_next[2] ? 1 : 2);
+
+        const double t_exit = std::min(t_next[axis], t1);
+
+        const Brick& brick = get_brick(cell[0], cell[1], cell[2]);
+        if (brick.m_mask_index != EmptyBrick && t_exit > t)
+        {
+            if (!visitor.visit(t, t_exit, brick.m_min_density, brick.m_max_density))
+                return;
+        }
+
+        if (t_exit >= t1)
+            return;
+
+        // Move to the next brick.
+        if (step[axis] > 0)
+        {
+            if (++cell[axis] == brick_res[axis])
+                return;
+        }
+        else
+        {
+            if (cell[axis]-- == 0)
+                return;
+        }
+
+        t = t_exit;
+        t_next[axis] += t_delta[axis];
+    }
+}
+
+inline void OccupancyGrid::get_voxel_coordinates(
+    const foundation::Vector3d&     point,
+    size_t&                         x,
+    size_t&                         y,
+    size_t&                         z) const
+{
+    // Same voxel selection as foundation::VoxelGrid3::nearest_lookup().
+    x = foundation::truncate<size_t>(foundation::clamp(point.x * m_nx, 0.0, m_nx - 1.0));
+    y = foundation::truncate<size_t>(foundation::clamp(point.y * m_ny, 0.0, m_ny - 1.0));
+    z = foundation::truncate<size_t>(foundation::clamp(point.z * m_nz, 0.0, m_nz - 1.0));
+}
+
+inline const OccupancyGrid::Brick& OccupancyGrid::get_brick(
+    const size_t                    bx,
+    const size_t                    by,
+    const size_t                    bz) const
+{
+    assert(bx < m_bx);
+    assert(by < m_by);
+    assert(bz < m_bz);
+    return m_bricks[(bz * m_by + by) * m_bx + bx];
+}
+
+inline size_t OccupancyGrid::get_bit_index(
+    const size_t                    x,
+    const size_t                    y,
+    const size_t                    z)
+{
+    return (z * BrickSize + y) * BrickSize + x;
 }
 
 }   // namespace renderer
@@ -0,0 +1,209 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/modeling/aov/cryptomatteweightbuffer.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+
+BENCHMARK_SUITE(Renderer_Modeling_AOV_CryptomatteWeightBuffer)
+{
+    const size_t TileSize = 64;
+    const size_t PixelCount = TileSize * TileSize;
+    const size_t SamplesPerPixel = 64;
+    const size_t LayerCount = 6;
+
+    //
+    // Previous implementation: one heap-allocated array of entries per pixel of the frame.
+    //
+
+    class ReferenceWeightMap
+    {
+      public:
+        struct Entry
+        {
+            std::uint32_t   m_key;
+            float           m_value;
+        };
+
+        explicit ReferenceWeightMap(const size_t size)
+          : m_size(static_cast<std::uint32_t>(size))
+          , m_index(0)
+          , m_map(new Entry[size])
+        {
+        }
+
+        ReferenceWeightMap(const ReferenceWeightMap& other)
+          : m_size(other.m_size)
+          , m_index(other.m_index)
+          , m_map(new Entry[other.m_size])
+        {
+            std::copy(other.m_map, other.m_map + m_index, m_map);
+        }
+
+        ReferenceWeightMap& operator=(const ReferenceWeightMap& rhs) = delete;
+
+        ~ReferenceWeightMap()
+        {
+            delete[] m_map;
+        }
+
+        void insert(const std::uint32_t key, const float value)
+        {
+            for (size_t i = 0; i < m_index; ++i)
+            {
+                if (m_map[i].m_key == key)
+                {
+                    m_map[i].m_value = value;
+                    return;
+                }
+            }
+
+            if (m_index < m_size)
+            {
+                m_map[m_index].m_key = key;
+                m_map[m_index].m_value = value;
+                ++m_index;
+            }
+        }
+
+        float get(const std::uint32_t key) const
+        {
+            for (size_t i = 0; i < m_index; ++i)
+            {
+                if (m_map[i].m_key == key)
+                    return m_map[i].m_value;
+            }
+
+            return 0.0f;
+        }
+
+        void clear()
+        {
+            m_index = 0;
+        }
+
+        const Entry* begin() const { return m_map; }
+        const Entry* end() const { return m_map + m_index; }
+
+      private:
+        std::uint32_t   m_size;
+        std::uint32_t   m_index;
+        Entry*          m_map;
+    };
+
+    struct Fixture
+    {
+        std::vector<std::uint32_t>                      m_ids;
+        std::vector<ReferenceWeightMap>                 m_reference_weights;
+        std::vector<std::pair<float, std::uint32_t>>    m_ranked;
+        CryptomatteWeightBuffer                         m_weights;
+        float                                           m_dummy;
+
+        Fixture()
+          : m_ids(PixelCount * SamplesPerPixel)
+          , m_reference_weights(PixelCount, ReferenceWeightMap(LayerCount))
+          , m_dummy(0.0f)
+        {
+            // Most pixels see a few objects, pixels along object edges see more.
+            MersenneTwister rng;
+            for (size_t i = 0; i < PixelCount; ++i)
+            {
+                const std::uint32_t id_count = i % 8 == 0 ? 8 : 3;
+                const std::uint32_t base_id = rand_int1(rng, 0, 1000);
+
+                for (size_t j = 0; j < SamplesPerPixel; ++j)
+                    m_ids[i * SamplesPerPixel + j] = base_id + rand_int1(rng, 0, id_count - 1);
+            }
+        }
+    };
+
+    // The previous implementation allocated one weight map per pixel of the frame when the image was created.
+    BENCHMARK_CASE(Reference_AllocateWeightMaps_1920x1080)
+    {
+        std::vector<ReferenceWeightMap> weights(1920 * 1080, ReferenceWeightMap(LayerCount));
+    }
+
+    BENCHMARK_CASE_F(Reference_AccumulateTile, Fixture)
+    {
+        for (size_t i = 0; i < PixelCount; ++i)
+        {
+            ReferenceWeightMap& weight_map = m_reference_weights[i];
+            weight_map.clear();
+
+            for (size_t j = 0; j < SamplesPerPixel; ++j)
+            {
+                const std::uint32_t id = m_ids[i * SamplesPerPixel + j];
+                weight_map.insert(id, weight_map.get(id) + 1.0f);
+            }
+
+            m_ranked.clear();
+            for (const auto& entry : weight_map)
+                m_ranked.push_back(std::make_pair(entry.m_value, entry.m_key));
+
+            std::sort(
+                m_ranked.begin(),
+                m_ranked.end(),
+                [](const std::pair<float, std::uint32_t>& a, const std::pair<float, std::uint32_t>& b)
+                {
+                    return a.first > b.first;
+                });
+
+            m_dummy += m_ranked[0].first;
+        }
+    }
+
+    BENCHMARK_CASE_F(AccumulateTile, Fixture)
+    {
+        m_weights.reset(PixelCount, LayerCount);
+
+        for (size_t i = 0; i < PixelCount; ++i)
+        {
+            for (size_t j = 0; j < SamplesPerPixel; ++j)
+                m_weights.insert(i, m_ids[i * SamplesPerPixel + j], 1.0f);
+
+            m_weights.finalize(i);
+
+            m_dummy += m_weights.get_entries(i)[0].m_weight;
+        }
+    }
+}
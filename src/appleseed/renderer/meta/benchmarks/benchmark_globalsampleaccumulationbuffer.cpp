@@ -0,0 +1,173 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/globalsampleaccumulationbuffer.h"
+#include "renderer/kernel/rendering/sample.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/platform/thread.h"
+#include "foundation/utility/benchmark.h"
+#include "foundation/utility/job/abortswitch.h"
+
+// Boost headers.
+#include "boost/thread/thread.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+
+BENCHMARK_SUITE(Renderer_Kernel_Rendering_GlobalSampleAccumulationBuffer)
+{
+    //
+    // Splat samples into a global sample accumulation buffer from several threads.
+    // Most samples land in a small bright region of the frame, similar to what happens
+    // around caustics in light tracing, which maximizes contention on the atomic path.
+    //
+
+    const size_t Width = 1024;
+    const size_t Height = 1024;
+    const size_t SamplesPerThread = 64 * 1024;
+
+    struct Fixture
+    {
+        std::vector<Sample>                                 m_samples;
+        AbortSwitch                                         m_abort_switch;
+        std::unique_ptr<GlobalSampleAccumulationBuffer>     m_buffer;
+
+        Fixture()
+          : m_samples(SamplesPerThread)
+        {
+            MersenneTwister rng;
+
+            for (size_t i = 0; i < SamplesPerThread; ++i)
+            {
+                Sample& sample = m_samples[i];
+
+                if (i % 8 == 0)
+                {
+                    // Scattered sample.
+                    sample.m_pixel_coords.x = rand_int1(rng, 0, static_cast<int>(Width - 1));
+                    sample.m_pixel_coords.y = rand_int1(rng, 0, static_cast<int>(Height - 1));
+                }
+                else
+                {
+                    // Caustic sample.
+                    sample.m_pixel_coords.x = rand_int1(rng, 500, 515);
+                    sample.m_pixel_coords.y = rand_int1(rng, 500, 515);
+                }
+
+                sample.m_color = Color4f(1.0f);
+            }
+        }
+
+        void splat(
+            GlobalSampleAccumulationBuffer& buffer,
+            const size_t                    thread_count)
+        {
+            boost::thread_group threads;
+
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                threads.create_thread(
+                    [this, &buffer, i]()
+                    {
+                        buffer.store_samples(i, m_samples.size(), &m_samples[0], m_abort_switch);
+                    });
+            }
+
+            threads.join_all();
+        }
+
+        GlobalSampleAccumulationBuffer& get_buffer(const size_t thread_count, const bool use_splat_buffers)
+        {
+            // Like during rendering, splat tiles remain allocated from one pass to the next.
+            if (!m_buffer)
+            {
+                m_buffer.reset(
+                    new GlobalSampleAccumulationBuffer(
+                        Width,
+                        Height,
+                        use_splat_buffers ? thread_count : 0));
+            }
+
+            return *m_buffer;
+        }
+
+        void store(const size_t thread_count, const bool use_splat_buffers)
+        {
+            splat(get_buffer(thread_count, use_splat_buffers), thread_count);
+        }
+    };
+
+    BENCHMARK_CASE_F(Atomic_1Thread, Fixture)
+    {
+        store(1, false);
+    }
+
+    BENCHMARK_CASE_F(SplatBuffers_1Thread, Fixture)
+    {
+        store(1, true);
+    }
+
+    BENCHMARK_CASE_F(Atomic_4Threads, Fixture)
+    {
+        store(4, false);
+    }
+
+    BENCHMARK_CASE_F(SplatBuffers_4Threads, Fixture)
+    {
+        store(4, true);
+    }
+
+    BENCHMARK_CASE_F(Atomic_16Threads, Fixture)
+    {
+        store(16, false);
+    }
+
+    BENCHMARK_CASE_F(SplatBuffers_16Threads, Fixture)
+    {
+        store(16, true);
+    }
+
+    // Reduction only happens when the frame is developed, i.e. much less often than samples are stored.
+    BENCHMARK_CASE_F(StoreAndReduce_SplatBuffers_4Threads, Fixture)
+    {
+        GlobalSampleAccumulationBuffer& buffer = get_buffer(4, true);
+        splat(buffer, 4);
+        buffer.reduce_splat_buffers();
+    }
+}
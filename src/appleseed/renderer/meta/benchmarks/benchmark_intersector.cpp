@@ -0,0 +1,267 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/intersection/intersector.h"
+#include "renderer/kernel/intersection/tracecontext.h"
+#include "renderer/kernel/shading/shadingpoint.h"
+#include "renderer/kernel/shading/shadingray.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/visibilityflags.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/testutils.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/xorshift32.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/memory/autoreleaseptr.h"
+#include "foundation/string/string.h"
+#include "foundation/utility/benchmark.h"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+using namespace foundation;
+using namespace renderer;
+
+// Ray casting throughput (the inverse of the time per case is the number of rays/s)
+// of the built-in kernel, of Embree traversing assembly geometry only (mixed mode)
+// and of Embree traversing assembly instances as well (two-level mode).
+
+BENCHMARK_SUITE(Renderer_Kernel_Intersection_Intersector)
+{
+    // A grid of instances of a tessellated plane, half of them moving.
+    struct GridScene
+      : public TestSceneBase
+    {
+        static const size_t PlaneResolution = 16;
+        static const size_t InstanceGridSize = 8;
+
+        GridScene()
+        {
+            auto_release_ptr<Assembly> assembly(
+                AssemblyFactory().create("assembly", ParamArray()));
+
+            create_plane_object(*assembly);
+
+            assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "plane_inst",
+                    ParamArray(),
+                    "plane",
+                    Transformd::identity(),
+                    StringDictionary()));
+
+            m_scene.assemblies().insert(assembly);
+
+            for (size_t y = 0; y < InstanceGridSize; ++y)
+            {
+                for (size_t x = 0; x < InstanceGridSize; ++x)
+                {
+                    const std::string name = "assembly_inst_" + to_string(x) + "_" + to_string(y);
+
+                    auto_release_ptr<AssemblyInstance> assembly_instance(
+                        AssemblyInstanceFactory::create(name.c_str(), ParamArray(), "assembly"));
+
+                    const Vector3d position(
+                        static_cast<double>(x) - 0.5 * (InstanceGridSize - 1),
+                        static_cast<double>(y) - 0.5 * (InstanceGridSize - 1),
+                        0.0);
+
+                    TransformSequence& transform_sequence = assembly_instance->transform_sequence();
+                    transform_sequence.set_transform(
+                        0.0f,
+                        Transformd::from_local_to_parent(Matrix4d::make_translation(position)));
+
+                    if ((x + y) % 2 == 1)
+                    {
+                        transform_sequence.set_transform(
+                            1.0f,
+                            Transformd::from_local_to_parent(
+                                Matrix4d::make_translation(position + Vector3d(0.0, 0.0, 0.5)) *
+                                Matrix4d::make_rotation_z(0.5)));
+                    }
+
+                    m_scene.assembly_instances().insert(assembly_instance);
+                }
+            }
+        }
+
+        static void create_plane_object(Assembly& assembly)
+        {
+            auto_release_ptr<MeshObject> mesh_object(
+                MeshObjectFactory().create("plane", ParamArray()));
+
+            for (size_t y = 0; y <= PlaneResolution; ++y)
+            {
+                for (size_t x = 0; x <= PlaneResolution; ++x)
+                {
+                    mesh_object->push_vertex(
+                        GVector3(
+                            static_cast<float>(x) / PlaneResolution - 0.5f,
+                            static_cast<float>(y) / PlaneResolution - 0.5f,
+                            0.0f));
+                }
+            }
+
+            mesh_object->push_vertex_normal(GVector3(0.0f, 0.0f, 1.0f));
+
+            for (size_t y = 0; y < PlaneResolution; ++y)
+            {
+                for (size_t x = 0; x < PlaneResolution; ++x)
+                {
+                    const size_t v0 = y * (PlaneResolution + 1) + x;
+                    const size_t v1 = v0 + 1;
+                    const size_t v2 = v1 + PlaneResolution + 1;
+                    const size_t v3 = v0 + PlaneResolution + 1;
+
+                    mesh_object->push_triangle(Triangle(v0, v1, v2, 0, 0, 0, 0));
+                    mesh_object->push_triangle(Triangle(v2, v3, v0, 0, 0, 0, 0));
+                }
+            }
+
+            mesh_object->push_material_slot("material");
+
+            auto_release_ptr<Object> object(mesh_object.release());
+            assembly.objects().insert(object);
+        }
+    };
+
+    template <bool UseEmbree, bool UseEmbreeInstancing>
+    struct Fixture
+      : public StaticTestSceneContext<GridScene>
+    {
+        TraceContext    m_trace_context;
+        TextureStore    m_texture_store;
+        TextureCache    m_texture_cache;
+        Intersector     m_intersector;
+        Xorshift32      m_rng;
+        size_t          m_hit_count;
+
+        Fixture()
+          : m_trace_context(m_scene)
+          , m_texture_store(m_scene)
+          , m_texture_cache(m_texture_store)
+          , m_intersector(m_trace_context, m_texture_cache)
+          , m_hit_count(0)
+        {
+#ifdef APPLESEED_WITH_EMBREE
+            m_trace_context.set_use_embree(UseEmbree);
+            m_trace_context.set_use_embree_instancing(UseEmbreeInstancing);
+#endif
+            m_trace_context.update();
+        }
+
+        ShadingRay make_random_ray()
+        {
+            const double half_size = 0.5 * GridScene::InstanceGridSize;
+            const Vector3d target(
+                rand_double2(m_rng, -half_size, half_size),
+                rand_double2(m_rng, -half_size, half_size),
+                0.0);
+            const Vector3d origin(0.0, 0.0, 10.0);
+
+            return
+                ShadingRay(
+                    origin,
+                    normalize(target - origin),
+                    ShadingRay::Time::create_with_normalized_time(rand_float2(m_rng), 0.0f, 1.0f),
+                    VisibilityFlags::CameraRay,
+                    0);
+        }
+
+        void trace()
+        {
+            ShadingPoint shading_point;
+            if (m_intersector.trace(make_random_ray(), shading_point))
+                ++m_hit_count;
+        }
+
+        void trace_probe()
+        {
+            if (m_intersector.trace_probe(make_random_ray()))
+                ++m_hit_count;
+        }
+    };
+
+    typedef Fixture<false, false> BuiltInFixture;
+
+    BENCHMARK_CASE_F(Trace_BuiltIn, BuiltInFixture)
+    {
+        trace();
+    }
+
+    BENCHMARK_CASE_F(TraceProbe_BuiltIn, BuiltInFixture)
+    {
+        trace_probe();
+    }
+
+#ifdef APPLESEED_WITH_EMBREE
+
+    typedef Fixture<true, false> EmbreeMixedFixture;
+    typedef Fixture<true, true> EmbreeInstancesFixture;
+
+    BENCHMARK_CASE_F(Trace_EmbreeMixed, EmbreeMixedFixture)
+    {
+        trace();
+    }
+
+    BENCHMARK_CASE_F(TraceProbe_EmbreeMixed, EmbreeMixedFixture)
+    {
+        trace_probe();
+    }
+
+    BENCHMARK_CASE_F(Trace_EmbreeInstances, EmbreeInstancesFixture)
+    {
+        trace();
+    }
+
+    BENCHMARK_CASE_F(TraceProbe_EmbreeInstances, EmbreeInstancesFixture)
+    {
+        trace_probe();
+    }
+
+#endif
+}
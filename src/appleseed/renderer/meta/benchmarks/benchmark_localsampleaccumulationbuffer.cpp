@@ -28,14 +28,30 @@
 
 // appleseed.renderer headers.
 #include "renderer/kernel/rendering/localsampleaccumulationbuffer.h"
+#include "renderer/kernel/rendering/sample.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
 #include "foundation/image/accumulatortile.h"
+#include "foundation/image/color.h"
 #include "foundation/image/pixel.h"
 #include "foundation/image/tile.h"
 #include "foundation/math/aabb.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
 #include "foundation/math/vector.h"
+#include "foundation/memory/autoreleaseptr.h"
+#include "foundation/platform/atomic.h"
 #include "foundation/utility/benchmark.h"
+#include "foundation/utility/job/abortswitch.h"
+
+// Boost headers.
+#include "boost/thread/thread.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
 
 using namespace foundation;
 using namespace renderer;
@@ -76,4 +92,66 @@ BENCHMARK_SUITE(Renderer_Kernel_Rendering_LocalSampleAccumulationBuffer)
             0, 0,
             m_rect);
     }
+
+    struct ConcurrentFixture
+    {
+        static const size_t Width = 512;
+        static const size_t Height = 512;
+        static const size_t BatchSize = 16 * 1024;
+        static const size_t BatchCount = 16;
+
+        auto_release_ptr<Frame>         m_frame;
+        LocalSampleAccumulationBuffer   m_buffer;
+        std::vector<Sample>             m_samples;
+        AbortSwitch                     m_abort_switch;
+
+        ConcurrentFixture()
+          : m_frame(
+                FrameFactory::create(
+                    "frame",
+                    ParamArray()
+                        .insert("resolution", "512 512")
+                        .insert("tile_size", "64 64")))
+          , m_buffer(Width, Height)
+          , m_samples(BatchSize)
+        {
+            MersenneTwister rng;
+
+            for (Sample& sample : m_samples)
+            {
+                sample.m_pixel_coords.x = rand_int1(rng, 0, static_cast<int>(Width - 1));
+                sample.m_pixel_coords.y = rand_int1(rng, 0, static_cast<int>(Height - 1));
+                sample.m_color = Color4f(rand_float1(rng));
+            }
+        }
+
+        void store_samples()
+        {
+            for (size_t i = 0; i < BatchCount; ++i)
+                m_buffer.store_samples(0, m_samples.size(), &m_samples[0], m_abort_switch);
+        }
+    };
+
+    BENCHMARK_CASE_F(StoreSamples, ConcurrentFixture)
+    {
+        store_samples();
+    }
+
+    // Store samples while another thread continuously develops the buffer, as the display does during interactive rendering.
+    BENCHMARK_CASE_F(StoreSamples_WhileDeveloping, ConcurrentFixture)
+    {
+        boost::atomic<bool> done(false);
+
+        boost::thread display_thread(
+            [this, &done]()
+            {
+                while (!done)
+                    m_buffer.develop_to_frame(m_frame.ref(), m_abort_switch);
+            });
+
+        store_samples();
+
+        done = true;
+        display_thread.join();
+    }
 }
@@ -0,0 +1,211 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectfilereader.h"
+#include "renderer/modeling/project/projectfilewriter.h"
+#include "renderer/modeling/project/projectformatrevision.h"
+
+// appleseed.foundation headers.
+#include "foundation/memory/autoreleaseptr.h"
+#include "foundation/utility/benchmark.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <fstream>
+
+using namespace foundation;
+using namespace renderer;
+namespace bf = boost::filesystem;
+
+namespace
+{
+    // A generated project made of many assemblies, each containing many object
+    // instances. Objects are procedural so that the benchmarks measure parsing,
+    // serialization and entity construction rather than geometry I/O.
+
+    const size_t AssemblyCount = 32;
+    const size_t ObjectInstanceCount = 1024;    // per assembly
+
+    const char* ProjectFilePath = "unit benchmarks/outputs/benchmark_projectfilereader.appleseed";
+    const char* BinaryProjectFilePath = "unit benchmarks/outputs/benchmark_projectfilereader.appleseedb";
+    const char* SchemaFilePath = "../../../schemas/project.xsd";    // path relative to project file
+
+    const int WriteOptions =
+        ProjectFileWriter::OmitHeaderComment |
+        ProjectFileWriter::OmitHandlingAssetFiles;
+
+    void generate_project_file()
+    {
+        bf::create_directories(bf::path(ProjectFilePath).parent_path());
+
+        std::ofstream file(ProjectFilePath);
+
+        file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        file << "<project format_revision=\"" << ProjectFormatRevision << "\">\n";
+        file << "    <scene>\n";
+        file << "        <camera name=\"camera\" model=\"pinhole_camera\">\n";
+        file << "            <parameter name=\"film_dimensions\" value=\"0.025 0.025\" />\n";
+        file << "            <parameter name=\"focal_length\" value=\"0.035\" />\n";
+        file << "        </camera>\n";
+
+        for (size_t i = 0; i < AssemblyCount; ++i)
+        {
+            file << "        <assembly name=\"assembly" << i << "\">\n";
+            file << "            <material name=\"material\" model=\"generic_material\" />\n";
+            file << "            <object name=\"sphere\" model=\"sphere_object\">\n";
+            file << "                <parameter name=\"radius\" value=\"0.5\" />\n";
+            file << "            </object>\n";
+
+            for (size_t j = 0; j < ObjectInstanceCount; ++j)
+            {
+                file << "            <object_instance name=\"instance" << j << "\" object=\"sphere\">\n";
+                file << "                <transform>\n";
+                file << "                    <matrix>\n";
+                file << "                        1.0 0.0 0.0 " << j << ".0\n";
+                file << "                        0.0 1.0 0.0 0.0\n";
+                file << "                        0.0 0.0 1.0 " << i << ".0\n";
+                file << "                        0.0 0.0 0.0 1.0\n";
+                file << "                    </matrix>\n";
+                file << "                </transform>\n";
+                file << "                <assign_material slot=\"default\" side=\"front\" material=\"material\" />\n";
+                file << "            </object_instance>\n";
+            }
+
+            file << "        </assembly>\n";
+            file << "        <assembly_instance name=\"assembly" << i << "_inst\" assembly=\"assembly" << i << "\" />\n";
+        }
+
+        file << "    </scene>\n";
+        file << "    <output>\n";
+        file << "        <frame name=\"beauty\">\n";
+        file << "            <parameter name=\"camera\" value=\"camera\" />\n";
+        file << "            <parameter name=\"resolution\" value=\"64 64\" />\n";
+        file << "        </frame>\n";
+        file << "    </output>\n";
+        file << "    <configurations>\n";
+        file << "        <configuration name=\"final\" base=\"base_final\" />\n";
+        file << "        <configuration name=\"interactive\" base=\"base_interactive\" />\n";
+        file << "    </configurations>\n";
+        file << "</project>\n";
+    }
+
+    auto_release_ptr<Project> read_project_file(const char* filepath, const int options)
+    {
+        return
+            ProjectFileReader::read(
+                filepath,
+                SchemaFilePath,
+                options | ProjectFileReader::OmitProjectFileUpdate);
+    }
+}
+
+BENCHMARK_SUITE(Renderer_Modeling_Project_ProjectFileReader)
+{
+    struct Fixture
+    {
+        Fixture()
+        {
+            generate_project_file();
+        }
+
+        void read(const int options)
+        {
+            auto_release_ptr<Project> project(read_project_file(ProjectFilePath, options));
+        }
+    };
+
+    BENCHMARK_CASE_F(Read_Xerces, Fixture)
+    {
+        read(ProjectFileReader::Defaults);
+    }
+
+    BENCHMARK_CASE_F(Read_XercesWithoutSchemaValidation, Fixture)
+    {
+        read(ProjectFileReader::OmitProjectSchemaValidation);
+    }
+
+    BENCHMARK_CASE_F(Read_LightweightParser, Fixture)
+    {
+        read(ProjectFileReader::UseLightweightParser);
+    }
+
+    struct BinaryFixture
+    {
+        BinaryFixture()
+        {
+            generate_project_file();
+
+            auto_release_ptr<Project> project(
+                read_project_file(ProjectFilePath, ProjectFileReader::UseLightweightParser));
+
+            ProjectFileWriter::write(project.ref(), BinaryProjectFilePath, WriteOptions);
+        }
+    };
+
+    BENCHMARK_CASE_F(Read_BinaryProjectFile, BinaryFixture)
+    {
+        auto_release_ptr<Project> project(
+            read_project_file(BinaryProjectFilePath, ProjectFileReader::Defaults));
+    }
+}
+
+BENCHMARK_SUITE(Renderer_Modeling_Project_ProjectFileWriter)
+{
+    struct Fixture
+    {
+        auto_release_ptr<Project> m_project;
+
+        Fixture()
+        {
+            generate_project_file();
+
+            m_project = read_project_file(ProjectFilePath, ProjectFileReader::UseLightweightParser);
+        }
+    };
+
+    BENCHMARK_CASE_F(Write_PlainProjectFile, Fixture)
+    {
+        ProjectFileWriter::write(
+            m_project.ref(),
+            "unit benchmarks/outputs/benchmark_projectfilewriter.appleseed",
+            WriteOptions);
+    }
+
+    BENCHMARK_CASE_F(Write_BinaryProjectFile, Fixture)
+    {
+        ProjectFileWriter::write(
+            m_project.ref(),
+            "unit benchmarks/outputs/benchmark_projectfilewriter.appleseedb",
+            WriteOptions);
+    }
+}
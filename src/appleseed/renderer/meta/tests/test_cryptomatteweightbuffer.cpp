@@ -0,0 +1,127 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/modeling/aov/cryptomatteweightbuffer.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <cstdint>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_AOV_CryptomatteWeightBuffer)
+{
+    TEST_CASE(Insert_SameIdTwice_AccumulatesWeight)
+    {
+        CryptomatteWeightBuffer buffer;
+        buffer.reset(4, 2);
+
+        buffer.insert(1, 42, 1.0f);
+        buffer.insert(1, 42, 2.0f);
+
+        ASSERT_EQ(1, buffer.finalize(1));
+        EXPECT_EQ(42, buffer.get_entries(1)[0].m_id);
+        EXPECT_EQ(3.0f, buffer.get_entries(1)[0].m_weight);
+        EXPECT_EQ(3.0f, buffer.get_total_weight(1));
+    }
+
+    TEST_CASE(Insert_DoesNotAffectOtherPixels)
+    {
+        CryptomatteWeightBuffer buffer;
+        buffer.reset(4, 2);
+
+        buffer.insert(1, 42, 1.0f);
+
+        EXPECT_EQ(0, buffer.finalize(0));
+        EXPECT_EQ(0, buffer.finalize(2));
+        EXPECT_EQ(0.0f, buffer.get_total_weight(2));
+    }
+
+    TEST_CASE(Finalize_SortsIdsByDecreasingWeight)
+    {
+        CryptomatteWeightBuffer buffer;
+        buffer.reset(1, 3);
+
+        buffer.insert(0, 1, 1.0f);
+        buffer.insert(0, 2, 3.0f);
+        buffer.insert(0, 3, 2.0f);
+
+        ASSERT_EQ(3, buffer.finalize(0));
+        EXPECT_EQ(2, buffer.get_entries(0)[0].m_id);
+        EXPECT_EQ(3, buffer.get_entries(0)[1].m_id);
+        EXPECT_EQ(1, buffer.get_entries(0)[2].m_id);
+    }
+
+    TEST_CASE(Finalize_GivenMoreIdsThanMaxIdCount_KeepsHighestWeightedIds)
+    {
+        CryptomatteWeightBuffer buffer;
+        buffer.reset(1, 2);
+
+        // Insert more IDs than the capacity of the pixel to force intermediate evictions.
+        const float Weights[] = { 1.0f, 5.0f, 2.0f, 7.0f, 3.0f, 4.0f, 6.0f };
+        for (std::uint32_t i = 0; i < 7; ++i)
+            buffer.insert(0, i + 1, Weights[i]);
+
+        ASSERT_EQ(2, buffer.finalize(0));
+        EXPECT_EQ(4, buffer.get_entries(0)[0].m_id);
+        EXPECT_EQ(7, buffer.get_entries(0)[1].m_id);
+        EXPECT_EQ(28.0f, buffer.get_total_weight(0));
+    }
+
+    TEST_CASE(Finalize_GivenEqualWeights_OrdersIdsDeterministically)
+    {
+        CryptomatteWeightBuffer buffer;
+        buffer.reset(1, 2);
+
+        buffer.insert(0, 9, 1.0f);
+        buffer.insert(0, 3, 1.0f);
+        buffer.insert(0, 5, 1.0f);
+
+        ASSERT_EQ(2, buffer.finalize(0));
+        EXPECT_EQ(3, buffer.get_entries(0)[0].m_id);
+        EXPECT_EQ(5, buffer.get_entries(0)[1].m_id);
+    }
+
+    TEST_CASE(Reset_ClearsAllPixels)
+    {
+        CryptomatteWeightBuffer buffer;
+        buffer.reset(4, 2);
+        buffer.insert(3, 42, 1.0f);
+
+        buffer.reset(4, 2);
+
+        EXPECT_EQ(0, buffer.get_entry_count(3));
+        EXPECT_EQ(0.0f, buffer.get_total_weight(3));
+    }
+}
@@ -0,0 +1,191 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/volume/densitygrid.h"
+#include "renderer/kernel/volume/volume.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/aabb.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Volume_DensityGrid)
+{
+    // A 32^3 grid mapped onto [-1,3]^3, with a blob of varying density in one corner
+    // and a constant density slab elsewhere, surrounded by empty space.
+    struct Fixture
+    {
+        std::unique_ptr<DensityGrid> m_density_grid;
+
+        Fixture()
+        {
+            std::unique_ptr<VoxelGrid> grid(new VoxelGrid(32, 32, 32, 1));
+
+            for (size_t z = 0; z < 32; ++z)
+            {
+                for (size_t y = 0; y < 32; ++y)
+                {
+                    for (size_t x = 0; x < 32; ++x)
+                    {
+                        float density = 0.0f;
+
+                        if (x >= 4 && x < 12 && y >= 4 && y < 12 && z >= 4 && z < 12)
+                            density = 0.25f * ((x + 2 * y + 3 * z) % 7);
+                        else if (x >= 20 && x < 28)
+                            density = 0.5f;
+
+                        grid->voxel(x, y, z)[0] = density;
+                    }
+                }
+            }
+
+            m_density_grid.reset(
+                new DensityGrid(
+                    std::move(grid),
+                    0,
+                    AABB3d(Vector3d(-1.0), Vector3d(3.0))));
+        }
+
+        double integrate_density_brute_force(
+            const Vector3d&     org,
+            const Vector3d&     dir,
+            const double        tmin,
+            const double        tmax) const
+        {
+            const size_t StepCount = 200000;
+            const double step = (tmax - tmin) / StepCount;
+
+            double sum = 0.0;
+
+            for (size_t i = 0; i < StepCount; ++i)
+                sum += m_density_grid->get_density(org + (tmin + (i + 0.5) * step) * dir);
+
+            return sum * step;
+        }
+    };
+
+    TEST_CASE_F(GetDensity_GivenPointOutsideBoundingBox_ReturnsZero, Fixture)
+    {
+        EXPECT_EQ(0.0f, m_density_grid->get_density(Vector3d(2.125, 0.0, -1.5)));
+        EXPECT_EQ(0.5f, m_density_grid->get_density(Vector3d(2.125, 0.0, 0.0)));
+    }
+
+    TEST_CASE_F(ComputeOpticalDepth_GivenRayCrossingGrid_MatchesBruteForceIntegration, Fixture)
+    {
+        const Vector3d org(-2.0, -1.5, -1.25);
+        const Vector3d dir(1.0, 0.75, 0.8);
+
+        const double expected = integrate_density_brute_force(org, dir, 0.0, 6.0);
+        const float optical_depth = m_density_grid->compute_optical_depth(org, dir, 0.0, 6.0);
+
+        EXPECT_GT(0.0, expected);
+        EXPECT_FEQ_EPS(expected, static_cast<double>(optical_depth), 1.0e-3 * expected);
+    }
+
+    TEST_CASE_F(ComputeOpticalDepth_GivenSubsegment_MatchesBruteForceIntegration, Fixture)
+    {
+        const Vector3d org(-1.0, 0.1, 0.3);
+        const Vector3d dir(2.0, 0.0, 0.0);
+
+        const double expected = integrate_density_brute_force(org, dir, 0.3, 1.7);
+        const float optical_depth = m_density_grid->compute_optical_depth(org, dir, 0.3, 1.7);
+
+        EXPECT_FEQ_EPS(expected, static_cast<double>(optical_depth), 1.0e-3 * expected);
+    }
+
+    TEST_CASE_F(ComputeOpticalDepth_GivenRayMissingGrid_ReturnsZero, Fixture)
+    {
+        const float optical_depth =
+            m_density_grid->compute_optical_depth(
+                Vector3d(-2.0, 4.0, 0.0),
+                Vector3d(1.0, 0.0, 0.0),
+                0.0,
+                10.0);
+
+        EXPECT_EQ(0.0f, optical_depth);
+    }
+
+    TEST_CASE_F(SampleCollision_EscapeProbabilityMatchesTransmission, Fixture)
+    {
+        const Vector3d org(-2.0, -1.5, -1.25);
+        const Vector3d dir(1.0, 0.75, 0.8);
+        const float ExtinctionScale = 0.5f;
+
+        const float optical_depth = m_density_grid->compute_optical_depth(org, dir, 0.0, 6.0);
+        const double expected_transmission = std::exp(-ExtinctionScale * optical_depth);
+
+        SamplingContext::RNGType rng;
+        SamplingContext sampling_context(rng, SamplingContext::RNGMode);
+
+        const size_t SampleCount = 20000;
+        size_t escaped_count = 0;
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            double t;
+            if (m_density_grid->sample_collision(sampling_context, org, dir, 0.0, 6.0, ExtinctionScale, t))
+            {
+                EXPECT_TRUE(t >= 0.0 && t < 6.0);
+                EXPECT_GT(0.0f, m_density_grid->get_density(org + t * dir));
+            }
+            else ++escaped_count;
+        }
+
+        const double transmission = static_cast<double>(escaped_count) / SampleCount;
+
+        EXPECT_FEQ_EPS(expected_transmission, transmission, 0.02);
+    }
+
+    TEST_CASE_F(SampleCollision_GivenRayMissingGrid_ReturnsFalse, Fixture)
+    {
+        SamplingContext::RNGType rng;
+        SamplingContext sampling_context(rng, SamplingContext::RNGMode);
+
+        double t;
+        const bool collided =
+            m_density_grid->sample_collision(
+                sampling_context,
+                Vector3d(-2.0, 4.0, 0.0),
+                Vector3d(1.0, 0.0, 0.0),
+                0.0,
+                10.0,
+                1.0f,
+                t);
+
+        EXPECT_FALSE(collided);
+    }
+}
@@ -27,13 +27,21 @@
 //
 
 // appleseed.renderer headers.
+#include "renderer/modeling/bsdf/energycompensation.h"
+#include "renderer/modeling/bsdf/energycompensationtables.h"
 #include "renderer/modeling/bsdf/glassbsdf.h"
 #include "renderer/modeling/bsdf/glossylayerbsdf.h"
 #include "renderer/modeling/bsdf/microfacethelper.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/scalar.h"
 #include "foundation/utility/test.h"
 
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+
+using namespace foundation;
 using namespace renderer;
 
 TEST_SUITE(Renderer_Modeling_BSDF_EnergyCompensation)
@@ -52,4 +60,112 @@ TEST_SUITE(Renderer_Modeling_BSDF_EnergyCompensation)
     {
         write_dielectric_layer_directional_albedo_tables("unit tests/outputs");
     }
+
+    // Compares lookups into the interpolation tables against direct interpolation of the albedo tables.
+
+    class TestAlbedoTable2D
+      : public AlbedoTable2D
+    {
+      public:
+        TestAlbedoTable2D()
+          : AlbedoTable2D(g_glossy_ggx_albedo_table)
+        {
+        }
+
+        float get_reference_directional_albedo(const float cos_theta, const float roughness) const
+        {
+            size_t i, j;
+            const float s = floor_frac(cos_theta * (TableSize - 1), i);
+            const float t = floor_frac(roughness * (TableSize - 1), j);
+
+            const size_t i1 = std::min(i + 1, TableSize - 1);
+            const size_t j1 = std::min(j + 1, TableSize - 1);
+
+            return
+                lerp(
+                    lerp(dir_table(i, j ), dir_table(i1, j ), s),
+                    lerp(dir_table(i, j1), dir_table(i1, j1), s),
+                    t);
+        }
+    };
+
+    class TestAlbedoTable3D
+      : public AlbedoTable3D
+    {
+      public:
+        TestAlbedoTable3D()
+          : AlbedoTable3D(g_glass_ggx_albedo_table, 1.01f, 3.0f)
+        {
+        }
+
+        float get_reference_directional_albedo(const float eta, const float roughness, const float cos_theta) const
+        {
+            size_t ix, iy, iz;
+            const float s = floor_frac(cos_theta * (TableSize - 1), ix);
+            const float t = floor_frac(roughness * (TableSize - 1), iy);
+            const float u = floor_frac((TableSize - 1) * saturate((eta - m_min_eta) / (m_max_eta - m_min_eta)), iz);
+
+            const size_t ix1 = std::min(ix + 1, TableSize - 1);
+            const size_t iy1 = std::min(iy + 1, TableSize - 1);
+            const size_t iz1 = std::min(iz + 1, TableSize - 1);
+
+            const float q =
+                lerp(
+                    lerp(dir_table(ix, iy , iz), dir_table(ix1, iy , iz), s),
+                    lerp(dir_table(ix, iy1, iz), dir_table(ix1, iy1, iz), s),
+                    t);
+            const float r =
+                lerp(
+                    lerp(dir_table(ix, iy , iz1), dir_table(ix1, iy , iz1), s),
+                    lerp(dir_table(ix, iy1, iz1), dir_table(ix1, iy1, iz1), s),
+                    t);
+
+            return lerp(q, r, u);
+        }
+    };
+
+    const size_t LookupTestSteps = 37;
+    const float LookupTestEps = 1.0e-5f;
+
+    TEST_CASE(AlbedoTable2D_GetDirectionalAlbedo_MatchesBilinearInterpolation)
+    {
+        const TestAlbedoTable2D table;
+
+        for (size_t j = 0; j <= LookupTestSteps; ++j)
+        {
+            for (size_t i = 0; i <= LookupTestSteps; ++i)
+            {
+                const float cos_theta = static_cast<float>(i) / LookupTestSteps;
+                const float roughness = static_cast<float>(j) / LookupTestSteps;
+
+                EXPECT_FEQ_EPS(
+                    table.get_reference_directional_albedo(cos_theta, roughness),
+                    table.get_directional_albedo(cos_theta, roughness),
+                    LookupTestEps);
+            }
+        }
+    }
+
+    TEST_CASE(AlbedoTable3D_GetDirectionalAlbedo_MatchesTrilinearInterpolation)
+    {
+        const TestAlbedoTable3D table;
+
+        for (size_t k = 0; k <= LookupTestSteps; ++k)
+        {
+            for (size_t j = 0; j <= LookupTestSteps; ++j)
+            {
+                for (size_t i = 0; i <= LookupTestSteps; ++i)
+                {
+                    const float eta = lerp(1.01f, 3.0f, static_cast<float>(k) / LookupTestSteps);
+                    const float roughness = static_cast<float>(j) / LookupTestSteps;
+                    const float cos_theta = static_cast<float>(i) / LookupTestSteps;
+
+                    EXPECT_FEQ_EPS(
+                        table.get_reference_directional_albedo(eta, roughness, cos_theta),
+                        table.get_directional_albedo(eta, roughness, cos_theta),
+                        LookupTestEps);
+                }
+            }
+        }
+    }
 }
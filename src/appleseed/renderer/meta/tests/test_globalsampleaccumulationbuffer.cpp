@@ -0,0 +1,155 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/globalsampleaccumulationbuffer.h"
+#include "renderer/kernel/rendering/sample.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Rendering_GlobalSampleAccumulationBuffer)
+{
+    const size_t Width = 100;
+    const size_t Height = 70;
+
+    std::vector<Sample> make_random_samples(const size_t sample_count)
+    {
+        MersenneTwister rng;
+        std::vector<Sample> samples(sample_count);
+
+        for (Sample& sample : samples)
+        {
+            sample.m_pixel_coords.x = rand_int1(rng, 0, static_cast<int>(Width - 1));
+            sample.m_pixel_coords.y = rand_int1(rng, 0, static_cast<int>(Height - 1));
+            sample.m_color = Color4f(rand_float1(rng), rand_float1(rng), rand_float1(rng), 1.0f);
+        }
+
+        return samples;
+    }
+
+    bool have_same_pixels(
+        const GlobalSampleAccumulationBuffer&   lhs,
+        const GlobalSampleAccumulationBuffer&   rhs)
+    {
+        for (size_t y = 0; y < Height; ++y)
+        {
+            for (size_t x = 0; x < Width; ++x)
+            {
+                if (!feq(lhs.get_pixel(x, y), rhs.get_pixel(x, y), 1.0e-4f))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    TEST_CASE(StoreSamples_WithSplatBuffers_MatchesAtomicPath)
+    {
+        const std::vector<Sample> samples = make_random_samples(10000);
+        AbortSwitch abort_switch;
+
+        GlobalSampleAccumulationBuffer atomic_buffer(Width, Height);
+        atomic_buffer.clear();
+        atomic_buffer.store_samples(0, samples.size() / 2, &samples[0], abort_switch);
+        atomic_buffer.store_samples(1, samples.size() / 2, &samples[samples.size() / 2], abort_switch);
+
+        GlobalSampleAccumulationBuffer splat_buffer(Width, Height, 2);
+        splat_buffer.clear();
+        splat_buffer.store_samples(0, samples.size() / 2, &samples[0], abort_switch);
+        splat_buffer.store_samples(1, samples.size() / 2, &samples[samples.size() / 2], abort_switch);
+        splat_buffer.reduce_splat_buffers();
+
+        EXPECT_TRUE(have_same_pixels(atomic_buffer, splat_buffer));
+    }
+
+    TEST_CASE(StoreSamples_GeneratorWithoutSplatBuffer_FallsBackToAtomicPath)
+    {
+        const std::vector<Sample> samples = make_random_samples(1000);
+        AbortSwitch abort_switch;
+
+        GlobalSampleAccumulationBuffer atomic_buffer(Width, Height);
+        atomic_buffer.clear();
+        atomic_buffer.store_samples(0, samples.size(), &samples[0], abort_switch);
+
+        GlobalSampleAccumulationBuffer splat_buffer(Width, Height, 1);
+        splat_buffer.clear();
+        splat_buffer.store_samples(3, samples.size(), &samples[0], abort_switch);
+
+        EXPECT_TRUE(have_same_pixels(atomic_buffer, splat_buffer));
+    }
+
+    TEST_CASE(StoreSamples_SplatMemoryBudgetExhausted_FallsBackToAtomicPath)
+    {
+        const std::vector<Sample> samples = make_random_samples(10000);
+        AbortSwitch abort_switch;
+
+        GlobalSampleAccumulationBuffer atomic_buffer(Width, Height);
+        atomic_buffer.clear();
+        atomic_buffer.store_samples(0, samples.size(), &samples[0], abort_switch);
+
+        // Only leave room for a single 32x32 splat tile.
+        GlobalSampleAccumulationBuffer splat_buffer(Width, Height, 1, 32 * 32 * 3 * sizeof(float));
+        splat_buffer.clear();
+        splat_buffer.store_samples(0, samples.size(), &samples[0], abort_switch);
+        splat_buffer.reduce_splat_buffers();
+
+        EXPECT_TRUE(have_same_pixels(atomic_buffer, splat_buffer));
+    }
+
+    TEST_CASE(ReduceSplatBuffers_CalledTwice_DoesNotAccumulateSamplesTwice)
+    {
+        const std::vector<Sample> samples = make_random_samples(1000);
+        AbortSwitch abort_switch;
+
+        GlobalSampleAccumulationBuffer atomic_buffer(Width, Height);
+        atomic_buffer.clear();
+        atomic_buffer.store_samples(0, samples.size(), &samples[0], abort_switch);
+
+        GlobalSampleAccumulationBuffer splat_buffer(Width, Height, 1);
+        splat_buffer.clear();
+        splat_buffer.store_samples(0, samples.size(), &samples[0], abort_switch);
+        splat_buffer.reduce_splat_buffers();
+        splat_buffer.reduce_splat_buffers();
+
+        EXPECT_TRUE(have_same_pixels(atomic_buffer, splat_buffer));
+    }
+}
@@ -0,0 +1,250 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/modeling/frame/incrementalcheckpoint.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/image/pixel.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+namespace bf = boost::filesystem;
+
+TEST_SUITE(Renderer_Modeling_Frame_IncrementalCheckpoint)
+{
+    struct Fixture
+    {
+        const bf::path  m_directory;
+        Image           m_color;
+        Image           m_depth;
+
+        explicit Fixture(const char* name)
+          : m_directory(bf::path("unit tests/outputs") / name)
+          , m_color(32, 32, 16, 16, 4, PixelFormatFloat)
+          , m_depth(32, 32, 16, 16, 1, PixelFormatFloat)
+        {
+            bf::remove_all(m_directory);
+
+            m_color.clear(Color4f(0.25f, 0.5f, 0.75f, 1.0f));
+            m_depth.clear(Color<float, 1>(2.0f));
+        }
+
+        std::string get_path() const
+        {
+            return (m_directory / "render.ckpt").string();
+        }
+
+        bf::path get_segment_path(const char* pass) const
+        {
+            return m_directory / (std::string("render.") + pass + ".ckpt");
+        }
+
+        std::vector<const ICanvas*> get_layers() const
+        {
+            return { &m_color, &m_depth };
+        }
+    };
+
+    TEST_CASE(Save_FirstPass_WritesAllTiles)
+    {
+        Fixture f("test_incrementalcheckpoint_savefirstpass");
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+
+        EXPECT_EQ(8, checkpoint.save(f.get_layers(), 0));
+
+        checkpoint.wait();
+        EXPECT_TRUE(checkpoint.exists());
+        EXPECT_TRUE(bf::exists(f.get_segment_path("00000")));
+    }
+
+    TEST_CASE(Save_SecondPass_OnlyWritesChangedTiles)
+    {
+        Fixture f("test_incrementalcheckpoint_savesecondpass");
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+        checkpoint.save(f.get_layers(), 0);
+
+        f.m_color.set_pixel(20, 3, Color4f(1.0f));
+
+        EXPECT_EQ(1, checkpoint.save(f.get_layers(), 1));
+        EXPECT_EQ(0, checkpoint.save(f.get_layers(), 2));
+    }
+
+    TEST_CASE(Save_AllTilesChanged_DeletesSupersededSegments)
+    {
+        Fixture f("test_incrementalcheckpoint_deletesuperseded");
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+        checkpoint.save(f.get_layers(), 0);
+
+        f.m_color.clear(Color4f(1.0f));
+        f.m_depth.clear(Color<float, 1>(3.0f));
+        checkpoint.save(f.get_layers(), 1);
+        checkpoint.wait();
+
+        EXPECT_FALSE(bf::exists(f.get_segment_path("00000")));
+        EXPECT_TRUE(bf::exists(f.get_segment_path("00001")));
+    }
+
+    TEST_CASE(Save_NewChain_DeletesSegmentsOfPreviousChain)
+    {
+        Fixture f("test_incrementalcheckpoint_newchain");
+
+        {
+            IncrementalCheckpoint checkpoint(f.get_path());
+            checkpoint.save(f.get_layers(), 0);
+
+            f.m_color.set_pixel(20, 3, Color4f(1.0f));
+            checkpoint.save(f.get_layers(), 1);
+
+            f.m_color.set_pixel(0, 31, Color4f(1.0f));
+            checkpoint.save(f.get_layers(), 2);
+        }
+
+        // A new checkpoint object starts a new chain.
+        IncrementalCheckpoint checkpoint(f.get_path());
+        EXPECT_EQ(8, checkpoint.save(f.get_layers(), 1));
+        checkpoint.wait();
+
+        EXPECT_FALSE(bf::exists(f.get_segment_path("00000")));
+        EXPECT_TRUE(bf::exists(f.get_segment_path("00001")));
+        EXPECT_FALSE(bf::exists(f.get_segment_path("00002")));
+    }
+
+    TEST_CASE(Load_RestoresLatestTiles)
+    {
+        Fixture f("test_incrementalcheckpoint_load");
+
+        {
+            IncrementalCheckpoint checkpoint(f.get_path());
+            checkpoint.save(f.get_layers(), 0);
+
+            f.m_color.set_pixel(20, 3, Color4f(1.0f));
+            checkpoint.save(f.get_layers(), 1);
+        }
+
+        Image color(32, 32, 16, 16, 4, PixelFormatFloat);
+        Image depth(32, 32, 16, 16, 1, PixelFormatFloat);
+        color.clear(Color4f(0.0f));
+        depth.clear(Color<float, 1>(0.0f));
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+        size_t last_pass = 0;
+        ASSERT_TRUE(checkpoint.load({ &color, &depth }, last_pass));
+
+        EXPECT_EQ(1, last_pass);
+
+        Color4f c;
+        color.get_pixel(20, 3, c);
+        EXPECT_EQ(Color4f(1.0f), c);
+        color.get_pixel(0, 31, c);
+        EXPECT_EQ(Color4f(0.25f, 0.5f, 0.75f, 1.0f), c);
+
+        Color<float, 1> d;
+        depth.get_pixel(31, 31, d);
+        EXPECT_EQ(2.0f, d[0]);
+    }
+
+    TEST_CASE(Load_DamagedLastSegment_ResumesFromPreviousSegments)
+    {
+        Fixture f("test_incrementalcheckpoint_damaged");
+
+        {
+            IncrementalCheckpoint checkpoint(f.get_path());
+            checkpoint.save(f.get_layers(), 0);
+
+            f.m_color.set_pixel(20, 3, Color4f(1.0f));
+            checkpoint.save(f.get_layers(), 1);
+        }
+
+        // Simulate a render interrupted while writing the last segment.
+        bf::resize_file(f.get_segment_path("00001"), 48);
+
+        Image color(32, 32, 16, 16, 4, PixelFormatFloat);
+        Image depth(32, 32, 16, 16, 1, PixelFormatFloat);
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+        size_t last_pass = 0;
+        ASSERT_TRUE(checkpoint.load({ &color, &depth }, last_pass));
+
+        EXPECT_EQ(0, last_pass);
+
+        Color4f c;
+        color.get_pixel(20, 3, c);
+        EXPECT_EQ(Color4f(0.25f, 0.5f, 0.75f, 1.0f), c);
+    }
+
+    TEST_CASE(Load_IncompatibleLayers_ReturnsFalse)
+    {
+        Fixture f("test_incrementalcheckpoint_incompatible");
+
+        {
+            IncrementalCheckpoint checkpoint(f.get_path());
+            checkpoint.save(f.get_layers(), 0);
+        }
+
+        Image color(32, 32, 8, 8, 4, PixelFormatFloat);
+        Image depth(32, 32, 8, 8, 1, PixelFormatFloat);
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+        size_t last_pass;
+        EXPECT_FALSE(checkpoint.load({ &color, &depth }, last_pass));
+    }
+
+    TEST_CASE(Save_AfterLoad_OnlyWritesChangedTiles)
+    {
+        Fixture f("test_incrementalcheckpoint_saveafterload");
+
+        {
+            IncrementalCheckpoint checkpoint(f.get_path());
+            checkpoint.save(f.get_layers(), 0);
+        }
+
+        IncrementalCheckpoint checkpoint(f.get_path());
+        size_t last_pass;
+        ASSERT_TRUE(checkpoint.load({ &f.m_color, &f.m_depth }, last_pass));
+
+        f.m_depth.set_pixel(5, 5, Color<float, 1>(7.0f));
+
+        EXPECT_EQ(1, checkpoint.save(f.get_layers(), last_pass + 1));
+    }
+}
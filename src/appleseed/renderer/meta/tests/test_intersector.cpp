@@ -35,7 +35,10 @@
 #include "renderer/kernel/shading/shadingray.h"
 #include "renderer/kernel/texturing/texturecache.h"
 #include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/modeling/object/meshobject.h"
 #include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
 #include "renderer/modeling/scene/assembly.h"
 #include "renderer/modeling/scene/assemblyinstance.h"
 #include "renderer/modeling/scene/containers.h"
@@ -44,13 +47,17 @@
 #include "renderer/modeling/scene/visibilityflags.h"
 #include "renderer/utility/paramarray.h"
 #include "renderer/utility/testutils.h"
+#include "renderer/utility/transformsequence.h"
 
 // appleseed.foundation headers.
 #include "foundation/containers/dictionary.h"
+#include "foundation/curve/curvebasis.h"
+#include "foundation/image/color.h"
 #include "foundation/math/matrix.h"
 #include "foundation/math/transform.h"
 #include "foundation/math/vector.h"
 #include "foundation/memory/autoreleaseptr.h"
+#include "foundation/utility/iostreamop.h"
 #include "foundation/utility/test.h"
 
 using namespace foundation;
@@ -181,5 +188,204 @@ TEST_SUITE(Renderer_Kernel_Intersection_Intersector)
         EXPECT_FALSE(hit);
     }
 
+#endif  // APPLESEED_WITH_EMBREE
+
+    // A single straight, vertical curve of width 0.2 centered at the origin.
+    struct CurveScene
+      : public TestSceneBase
+    {
+        CurveScene()
+        {
+            auto_release_ptr<Assembly> assembly(
+                AssemblyFactory().create("assembly", ParamArray()));
+
+            auto_release_ptr<CurveObject> curve_object(
+                CurveObjectFactory().create("curve", ParamArray()));
+
+            static const GVector3 ControlPoints[] = { GVector3(0.0, -1.0, 0.0), GVector3(0.0, 1.0, 0.0) };
+            curve_object->push_basis(CurveBasis::Linear);
+            curve_object->push_curve1(Curve1Type(ControlPoints, GScalar(0.2), GScalar(1.0), Color3f(1.0f)));
+
+            assembly->objects().insert(auto_release_ptr<Object>(curve_object));
+
+            assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "curve_inst",
+                    ParamArray(),
+                    "curve",
+                    Transformd::identity(),
+                    StringDictionary()));
+
+            m_scene.assembly_instances().insert(
+                auto_release_ptr<AssemblyInstance>(
+                    AssemblyInstanceFactory::create(
+                        "assembly_instance",
+                        ParamArray(),
+                        "assembly")));
+
+            m_scene.assemblies().insert(assembly);
+        }
+    };
+
+    // A unit square in the z = 0 plane, instanced with a translation from x = 0 at t = 0 to x = 2 at t = 1.
+    struct MovingInstanceScene
+      : public TestSceneBase
+    {
+        MovingInstanceScene()
+        {
+            auto_release_ptr<Assembly> assembly(
+                AssemblyFactory().create("assembly", ParamArray()));
+
+            auto_release_ptr<MeshObject> mesh_object(
+                MeshObjectFactory().create("square", ParamArray()));
+
+            mesh_object->push_vertex(GVector3(-0.5f, -0.5f, 0.0f));
+            mesh_object->push_vertex(GVector3( 0.5f, -0.5f, 0.0f));
+            mesh_object->push_vertex(GVector3( 0.5f,  0.5f, 0.0f));
+            mesh_object->push_vertex(GVector3(-0.5f,  0.5f, 0.0f));
+            mesh_object->push_vertex_normal(GVector3(0.0f, 0.0f, 1.0f));
+            mesh_object->push_triangle(Triangle(0, 1, 2, 0, 0, 0, 0));
+            mesh_object->push_triangle(Triangle(2, 3, 0, 0, 0, 0, 0));
+            mesh_object->push_material_slot("material");
+
+            assembly->objects().insert(auto_release_ptr<Object>(mesh_object));
+
+            assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "square_inst",
+                    ParamArray(),
+                    "square",
+                    Transformd::identity(),
+                    StringDictionary()));
+
+            auto_release_ptr<AssemblyInstance> assembly_instance(
+                AssemblyInstanceFactory::create(
+                    "assembly_instance",
+                    ParamArray(),
+                    "assembly"));
+
+            TransformSequence& transform_sequence = assembly_instance->transform_sequence();
+            transform_sequence.set_transform(
+                0.0f,
+                Transformd::identity());
+            transform_sequence.set_transform(
+                1.0f,
+                Transformd::from_local_to_parent(Matrix4d::make_translation(Vector3d(2.0, 0.0, 0.0))));
+
+            m_scene.assembly_instances().insert(assembly_instance);
+            m_scene.assemblies().insert(assembly);
+        }
+    };
+
+    template <typename SceneType, bool UseEmbree, bool UseEmbreeInstancing>
+    struct SceneFixture
+      : public StaticTestSceneContext<SceneType>
+    {
+        TraceContext    m_trace_context;
+        TextureStore    m_texture_store;
+        TextureCache    m_texture_cache;
+        Intersector     m_intersector;
+
+        SceneFixture()
+          : m_trace_context(StaticTestSceneContext<SceneType>::m_scene)
+          , m_texture_store(StaticTestSceneContext<SceneType>::m_scene)
+          , m_texture_cache(m_texture_store)
+          , m_intersector(m_trace_context, m_texture_cache)
+        {
+#ifdef APPLESEED_WITH_EMBREE
+            m_trace_context.set_use_embree(UseEmbree);
+            m_trace_context.set_use_embree_instancing(UseEmbreeInstancing);
+#endif
+            m_trace_context.update();
+        }
+
+        bool trace_down(
+            const Vector3d&     origin,
+            const float         time,
+            ShadingPoint&       shading_point)
+        {
+            const ShadingRay ray(
+                origin,
+                Vector3d(0.0, 0.0, -1.0),
+                ShadingRay::Time::create_with_normalized_time(time, 0.0f, 1.0f),
+                VisibilityFlags::CameraRay,
+                0);                             // depth
+
+            return m_intersector.trace(ray, shading_point);
+        }
+    };
+
+    typedef SceneFixture<CurveScene, false, false> BuiltInCurveFixture;
+    typedef SceneFixture<MovingInstanceScene, false, false> BuiltInMovingInstanceFixture;
+
+    TEST_CASE_F(Trace_GivenRayHittingCurveAxis_ReturnsCurveParameterInSecondBarycentricCoordinate, BuiltInCurveFixture)
+    {
+        ShadingPoint shading_point;
+        const bool hit = trace_down(Vector3d(0.0, 0.5, 2.0), 0.0f, shading_point);
+
+        ASSERT_TRUE(hit);
+        EXPECT_EQ(ShadingPoint::PrimitiveCurve1, shading_point.get_primitive_type());
+        EXPECT_FEQ_EPS(0.5f, shading_point.get_bary()[0], 0.05f);
+        EXPECT_FEQ_EPS(0.75f, shading_point.get_bary()[1], 1.0e-3f);
+    }
+
+    TEST_CASE_F(Trace_GivenMovingAssemblyInstance_HitsInstanceAtRayTime, BuiltInMovingInstanceFixture)
+    {
+        ShadingPoint shading_point;
+        const bool hit = trace_down(Vector3d(1.0, 0.0, 2.0), 0.5f, shading_point);
+
+        ASSERT_TRUE(hit);
+        EXPECT_FEQ_EPS(2.0, shading_point.get_distance(), 1.0e-6);
+        EXPECT_FEQ_EPS(Vector3d(1.0, 0.0, 0.0), shading_point.get_point(), 1.0e-6);
+    }
+
+    TEST_CASE_F(Trace_GivenMovingAssemblyInstanceAndRayTimeBeforeMotion_MissesInstance, BuiltInMovingInstanceFixture)
+    {
+        ShadingPoint shading_point;
+        const bool hit = trace_down(Vector3d(1.0, 0.0, 2.0), 0.0f, shading_point);
+
+        EXPECT_FALSE(hit);
+    }
+
+#ifdef APPLESEED_WITH_EMBREE
+
+    // Embree reports the curve parameter in u and the distance to the curve axis in v;
+    // EmbreeScene::read_hit() must map them to the layout of the built-in curve intersector.
+
+    typedef SceneFixture<CurveScene, true, false> EmbreeCurveFixture;
+
+    TEST_CASE_F(Trace_Embree_GivenRayHittingCurveAxis_ReturnsCurveParameterInSecondBarycentricCoordinate, EmbreeCurveFixture)
+    {
+        ShadingPoint shading_point;
+        const bool hit = trace_down(Vector3d(0.0, 0.5, 2.0), 0.0f, shading_point);
+
+        ASSERT_TRUE(hit);
+        EXPECT_EQ(ShadingPoint::PrimitiveCurve1, shading_point.get_primitive_type());
+        EXPECT_FEQ_EPS(0.5f, shading_point.get_bary()[0], 0.05f);
+        EXPECT_FEQ_EPS(0.75f, shading_point.get_bary()[1], 1.0e-3f);
+    }
+
+    // In two-level mode, the motion of assembly instances is handled by Embree instances.
+
+    typedef SceneFixture<MovingInstanceScene, true, true> EmbreeInstancesMovingInstanceFixture;
+
+    TEST_CASE_F(Trace_EmbreeInstances_GivenMovingAssemblyInstance_HitsInstanceAtRayTime, EmbreeInstancesMovingInstanceFixture)
+    {
+        ShadingPoint shading_point;
+        const bool hit = trace_down(Vector3d(1.0, 0.0, 2.0), 0.5f, shading_point);
+
+        ASSERT_TRUE(hit);
+        EXPECT_FEQ_EPS(2.0, shading_point.get_distance(), 1.0e-6);
+        EXPECT_FEQ_EPS(Vector3d(1.0, 0.0, 0.0), shading_point.get_point(), 1.0e-6);
+    }
+
+    TEST_CASE_F(Trace_EmbreeInstances_GivenMovingAssemblyInstanceAndRayTimeBeforeMotion_MissesInstance, EmbreeInstancesMovingInstanceFixture)
+    {
+        ShadingPoint shading_point;
+        const bool hit = trace_down(Vector3d(1.0, 0.0, 2.0), 0.0f, shading_point);
+
+        EXPECT_FALSE(hit);
+    }
+
 #endif  // APPLESEED_WITH_EMBREE
 }
@@ -0,0 +1,149 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/utility/memorytracker.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Utility_MemoryTracker)
+{
+    TEST_CASE(GetSize_GivenUnknownOwner_ReturnsZero)
+    {
+        MemoryTracker tracker;
+
+        EXPECT_EQ(0, tracker.get_size(MemoryTracker::CategoryTree, "/assembly"));
+    }
+
+    TEST_CASE(Set_ReplacesPreviousSize)
+    {
+        MemoryTracker tracker;
+        tracker.set(MemoryTracker::CategoryTree, "/assembly", 100);
+        tracker.set(MemoryTracker::CategoryTree, "/assembly", 40);
+
+        EXPECT_EQ(40, tracker.get_size(MemoryTracker::CategoryTree, "/assembly"));
+        EXPECT_EQ(40, tracker.get_category_size(MemoryTracker::CategoryTree));
+        EXPECT_EQ(40, tracker.get_total_size());
+    }
+
+    TEST_CASE(AddAndSubtract_AccumulateSizes)
+    {
+        MemoryTracker tracker;
+        tracker.add(MemoryTracker::CategoryTexture, "/texture", 100);
+        tracker.add(MemoryTracker::CategoryTexture, "/texture", 50);
+        tracker.subtract(MemoryTracker::CategoryTexture, "/texture", 30);
+
+        EXPECT_EQ(120, tracker.get_size(MemoryTracker::CategoryTexture, "/texture"));
+        EXPECT_EQ(120, tracker.get_total_size());
+    }
+
+    TEST_CASE(Remove_StopsAttributingMemoryToOwner)
+    {
+        MemoryTracker tracker;
+        tracker.set(MemoryTracker::CategoryObject, "/assembly/object", 100);
+        tracker.set(MemoryTracker::CategoryTree, "/assembly/object", 10);
+        tracker.remove(MemoryTracker::CategoryObject, "/assembly/object");
+
+        EXPECT_EQ(0, tracker.get_size(MemoryTracker::CategoryObject, "/assembly/object"));
+        EXPECT_EQ(10, tracker.get_total_size());
+    }
+
+    TEST_CASE(GetOwnerSize_SumsOwnerAndDescendantsAcrossCategories)
+    {
+        MemoryTracker tracker;
+        tracker.set(MemoryTracker::CategoryObject, "/scene/assembly/object1", 100);
+        tracker.set(MemoryTracker::CategoryObject, "/scene/assembly/object2", 200);
+        tracker.set(MemoryTracker::CategoryTree, "/scene/assembly/triangle tree #1", 400);
+        tracker.set(MemoryTracker::CategoryObject, "/scene/assembly2/object", 800);
+        tracker.set(MemoryTracker::CategoryTexture, "/scene/assembly", 1000);
+
+        EXPECT_EQ(1700, tracker.get_owner_size("/scene/assembly"));
+        EXPECT_EQ(100, tracker.get_owner_size("/scene/assembly/object1"));
+        EXPECT_EQ(2500, tracker.get_owner_size("/scene"));
+        EXPECT_EQ(2500, tracker.get_owner_size(""));
+    }
+
+    TEST_CASE(GetPeakTotalSize_ReturnsHighestTotalSize)
+    {
+        MemoryTracker tracker;
+        tracker.set(MemoryTracker::CategoryFrameBuffer, "/frame", 100);
+        tracker.set(MemoryTracker::CategoryTree, "/assembly", 50);
+        tracker.remove(MemoryTracker::CategoryFrameBuffer, "/frame");
+
+        EXPECT_EQ(50, tracker.get_total_size());
+        EXPECT_EQ(150, tracker.get_peak_total_size());
+    }
+
+    TEST_CASE(CheckBudget_GivenNoBudget_ReturnsTrue)
+    {
+        MemoryTracker tracker;
+        tracker.set(MemoryTracker::CategoryTree, "/assembly", 1000);
+
+        EXPECT_TRUE(tracker.check_budget(MemoryTracker::CategoryFrameBuffer, "/frame", 1000));
+    }
+
+    TEST_CASE(CheckBudget_GivenAllocationWithinBudget_ReturnsTrue)
+    {
+        MemoryTracker tracker;
+        tracker.set_soft_budget(1000);
+        tracker.set(MemoryTracker::CategoryTree, "/assembly", 600);
+
+        EXPECT_TRUE(tracker.check_budget(MemoryTracker::CategoryFrameBuffer, "/frame", 400));
+    }
+
+    TEST_CASE(CheckBudget_GivenAllocationExceedingBudget_ReturnsFalse)
+    {
+        MemoryTracker tracker;
+        tracker.set_soft_budget(1000);
+        tracker.set(MemoryTracker::CategoryTree, "/assembly", 600);
+
+        EXPECT_FALSE(tracker.check_budget(MemoryTracker::CategoryFrameBuffer, "/frame", 401));
+    }
+
+    TEST_CASE(GetEntries_ReturnsSizesPerCategoryAndOwner)
+    {
+        MemoryTracker tracker;
+        tracker.set(MemoryTracker::CategoryTree, "/assembly/triangle tree #1", 42);
+
+        const Dictionary entries = tracker.get_entries();
+
+        EXPECT_TRUE(entries.dictionaries().exist("object"));
+        EXPECT_EQ(
+            "42",
+            std::string(entries.dictionary("tree").get("/assembly/triangle tree #1")));
+    }
+}
@@ -0,0 +1,235 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/volume/occupancygrid.h"
+#include "renderer/kernel/volume/volume.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Volume_OccupancyGrid)
+{
+    struct Segment
+    {
+        double  m_t0;
+        double  m_t1;
+        float   m_max_density;
+    };
+
+    struct SegmentCollector
+    {
+        std::vector<Segment> m_segments;
+        size_t               m_max_segments;
+
+        SegmentCollector()
+          : m_max_segments(~size_t(0))
+        {
+        }
+
+        bool visit(const double t0, const double t1, const float min_density, const float max_density)
+        {
+            m_segments.push_back(Segment{ t0, t1, max_density });
+            return m_segments.size() < m_max_segments;
+        }
+    };
+
+    // A 32^3 grid with a single dense 4^3 blob centered at voxel (20, 20, 20).
+    struct Fixture
+    {
+        VoxelGrid m_grid;
+
+        Fixture()
+          : m_grid(32, 32, 32, 1)
+        {
+            for (size_t z = 0; z < 32; ++z)
+            {
+                for (size_t y = 0; y < 32; ++y)
+                {
+                    for (size_t x = 0; x < 32; ++x)
+                    {
+                        const bool inside =
+                            x >= 18 && x < 22 &&
+                            y >= 18 && y < 22 &&
+                            z >= 18 && z < 22;
+                        m_grid.voxel(x, y, z)[0] = inside ? 2.0f : 0.0f;
+                    }
+                }
+            }
+        }
+    };
+
+    TEST_CASE(Constructor_EmptyGrid_AllBricksAreEmpty)
+    {
+        VoxelGrid grid(16, 16, 16, 1);
+        for (size_t z = 0; z < 16; ++z)
+        {
+            for (size_t y = 0; y < 16; ++y)
+            {
+                for (size_t x = 0; x < 16; ++x)
+                    grid.voxel(x, y, z)[0] = 0.0f;
+            }
+        }
+
+        const OccupancyGrid occupancy_grid(grid, 0, 0.1f);
+
+        EXPECT_EQ(8, occupancy_grid.get_empty_brick_count());
+        EXPECT_EQ(0, occupancy_grid.get_partial_brick_count());
+        EXPECT_EQ(0, occupancy_grid.get_full_brick_count());
+        EXPECT_FALSE(occupancy_grid.has_fluid(Vector3d(0.5)));
+    }
+
+    TEST_CASE_F(Constructor_SingleBlob_OnlyStoresMaskForPartialBrick, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        // The blob and its 3x3x3 dilation lie entirely in brick (2, 2, 2).
+        EXPECT_EQ(63, occupancy_grid.get_empty_brick_count());
+        EXPECT_EQ(1, occupancy_grid.get_partial_brick_count());
+        EXPECT_EQ(0, occupancy_grid.get_full_brick_count());
+    }
+
+    TEST_CASE_F(HasFluid, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        EXPECT_TRUE(occupancy_grid.has_fluid(Vector3d(20.5 / 32)));
+        EXPECT_TRUE(occupancy_grid.has_fluid(Vector3d(17.5 / 32)));     // dilated voxel
+        EXPECT_FALSE(occupancy_grid.has_fluid(Vector3d(16.5 / 32)));    // same brick, empty voxel
+        EXPECT_FALSE(occupancy_grid.has_fluid(Vector3d(4.5 / 32)));     // empty brick
+    }
+
+    TEST_CASE_F(GetMaxDensity, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        EXPECT_EQ(2.0f, occupancy_grid.get_max_density(Vector3d(16.5 / 32)));
+        EXPECT_EQ(0.0f, occupancy_grid.get_max_density(Vector3d(4.5 / 32)));
+    }
+
+    TEST_CASE_F(Traverse_RayThroughBlob_VisitsOnlyNonEmptyBrick, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        SegmentCollector collector;
+        occupancy_grid.traverse(
+            Vector3d(-1.0, 20.5 / 32, 20.5 / 32),
+            Vector3d(1.0, 0.0, 0.0),
+            0.0,
+            10.0,
+            collector);
+
+        ASSERT_EQ(1, collector.m_segments.size());
+        EXPECT_FEQ(1.0 + 16.0 / 32, collector.m_segments[0].m_t0);
+        EXPECT_FEQ(1.0 + 24.0 / 32, collector.m_segments[0].m_t1);
+        EXPECT_EQ(2.0f, collector.m_segments[0].m_max_density);
+    }
+
+    TEST_CASE_F(Traverse_RayMissingBlob_VisitsNothing, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        SegmentCollector collector;
+        occupancy_grid.traverse(
+            Vector3d(-1.0, 4.5 / 32, 20.5 / 32),
+            Vector3d(1.0, 0.0, 0.0),
+            0.0,
+            10.0,
+            collector);
+
+        EXPECT_TRUE(collector.m_segments.empty());
+    }
+
+    TEST_CASE_F(Traverse_RayMissingUnitCube_VisitsNothing, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        SegmentCollector collector;
+        occupancy_grid.traverse(
+            Vector3d(-1.0, 2.0, 0.5),
+            Vector3d(1.0, 0.0, 0.0),
+            0.0,
+            10.0,
+            collector);
+
+        EXPECT_TRUE(collector.m_segments.empty());
+    }
+
+    TEST_CASE_F(Traverse_NegativeDirection_ClipsSegmentToRayExtent, Fixture)
+    {
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+
+        SegmentCollector collector;
+        occupancy_grid.traverse(
+            Vector3d(20.5 / 32, 20.5 / 32, 2.0),
+            Vector3d(0.0, 0.0, -1.0),
+            0.0,
+            2.0 - 20.0 / 32,
+            collector);
+
+        ASSERT_EQ(1, collector.m_segments.size());
+        EXPECT_FEQ(2.0 - 24.0 / 32, collector.m_segments[0].m_t0);
+        EXPECT_FEQ(2.0 - 20.0 / 32, collector.m_segments[0].m_t1);
+    }
+
+    TEST_CASE_F(Traverse_VisitorReturnsFalse_StopsTraversal, Fixture)
+    {
+        // Fill the whole grid so that every brick is visited.
+        for (size_t z = 0; z < 32; ++z)
+        {
+            for (size_t y = 0; y < 32; ++y)
+            {
+                for (size_t x = 0; x < 32; ++x)
+                    m_grid.voxel(x, y, z)[0] = 1.0f;
+            }
+        }
+
+        const OccupancyGrid occupancy_grid(m_grid, 0, 0.1f);
+        EXPECT_EQ(64, occupancy_grid.get_full_brick_count());
+
+        SegmentCollector collector;
+        collector.m_max_segments = 2;
+        occupancy_grid.traverse(
+            Vector3d(-1.0, 0.5, 0.5),
+            Vector3d(1.0, 0.0, 0.0),
+            0.0,
+            10.0,
+            collector);
+
+        EXPECT_EQ(2, collector.m_segments.size());
+    }
+}
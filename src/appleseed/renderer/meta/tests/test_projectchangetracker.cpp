@@ -0,0 +1,219 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bsdf/lambertianbrdf.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/camera/pinholecamera.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectchangetracker.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/testutils.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/memory/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Project_ProjectChangeTracker)
+{
+    struct Fixture
+    {
+        auto_release_ptr<Project>   m_project;
+        Scene*                      m_scene;
+        Assembly*                   m_assembly;
+        ParamArray                  m_params;
+        ProjectChangeTracker        m_tracker;
+
+        Fixture()
+          : m_project(ProjectFactory::create("project"))
+        {
+            m_project->set_scene(SceneFactory::create());
+            m_scene = m_project->get_scene();
+
+            m_scene->cameras().insert(
+                PinholeCameraFactory().create(
+                    "camera",
+                    ParamArray()
+                        .insert("film_width", "0.025")
+                        .insert("film_height", "0.025")
+                        .insert("focal_length", "0.035")));
+
+            auto_release_ptr<Assembly> assembly(AssemblyFactory().create("assembly", ParamArray()));
+            m_assembly = assembly.get();
+
+            m_assembly->bsdfs().insert(LambertianBRDFFactory().create("bsdf", ParamArray()));
+
+            m_assembly->objects().insert(
+                auto_release_ptr<Object>(
+                    new BoundingBoxObject(
+                        "object",
+                        GAABB3(GVector3(-1.0), GVector3(+1.0)))));
+
+            m_assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "object_inst",
+                    ParamArray(),
+                    "object",
+                    Transformd::identity(),
+                    StringDictionary()));
+
+            m_scene->assemblies().insert(assembly);
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create("assembly_inst", ParamArray(), "assembly"));
+
+            m_params.insert("passes", "1");
+        }
+    };
+
+    TEST_CASE_F(Classify_GivenNoRecordedState_ReturnsAll, Fixture)
+    {
+        EXPECT_FALSE(m_tracker.has_snapshot());
+        EXPECT_EQ(ProjectChanges::All, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenUnchangedProject_ReturnsNone, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        EXPECT_EQ(ProjectChanges::None, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenClearedTracker_ReturnsAll, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+        m_tracker.clear();
+
+        EXPECT_EQ(ProjectChanges::All, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenModifiedCameraParameter_ReturnsCamera, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_scene->cameras().get_by_name("camera")->get_parameters().insert("focal_length", "0.050");
+
+        EXPECT_EQ(ProjectChanges::Camera, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenMovedCamera_ReturnsCamera, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_scene->cameras().get_by_name("camera")->transform_sequence().set_transform(
+            0.0f,
+            Transformd::from_local_to_parent(Matrix4d::make_translation(Vector3d(1.0))));
+
+        EXPECT_EQ(ProjectChanges::Camera, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenModifiedShutterOfActiveCamera_ReturnsCameraAndGeometry, Fixture)
+    {
+        m_project->set_frame(
+            FrameFactory::create(
+                "frame",
+                ParamArray()
+                    .insert("resolution", "16 16")
+                    .insert("camera", "camera")));
+
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_scene->cameras().get_by_name("camera")->get_parameters().insert("shutter_close_end_time", "0.5");
+
+        EXPECT_EQ(
+            ProjectChanges::Camera | ProjectChanges::Geometry,
+            m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenAddedBSDF_ReturnsShading, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_assembly->bsdfs().insert(LambertianBRDFFactory().create("bsdf2", ParamArray()));
+
+        EXPECT_EQ(ProjectChanges::Shading, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenRemovedObjectInstance_ReturnsGeometryAndLighting, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_assembly->object_instances().remove(m_assembly->object_instances().get_by_name("object_inst"));
+
+        EXPECT_EQ(
+            ProjectChanges::Geometry | ProjectChanges::Lighting,
+            m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenMovedAssemblyInstance_ReturnsGeometryAndLighting, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_scene->assembly_instances().get_by_name("assembly_inst")->transform_sequence().set_transform(
+            0.0f,
+            Transformd::from_local_to_parent(Matrix4d::make_scaling(Vector3d(2.0))));
+
+        EXPECT_EQ(
+            ProjectChanges::Geometry | ProjectChanges::Lighting,
+            m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE_F(Classify_GivenModifiedRenderSetting_ReturnsSettings, Fixture)
+    {
+        m_tracker.record(m_project.ref(), m_params);
+
+        m_params.insert("passes", "2");
+
+        EXPECT_EQ(ProjectChanges::Settings, m_tracker.classify(m_project.ref(), m_params));
+    }
+
+    TEST_CASE(ToString_GivenSeveralChanges_ReturnsCommaSeparatedNames)
+    {
+        EXPECT_EQ("none", ProjectChanges::to_string(ProjectChanges::None));
+        EXPECT_EQ("all", ProjectChanges::to_string(ProjectChanges::All));
+        EXPECT_EQ(
+            "camera, geometry",
+            ProjectChanges::to_string(ProjectChanges::Camera | ProjectChanges::Geometry));
+    }
+}
@@ -75,6 +75,146 @@ TEST_SUITE(Renderer_Modeling_Project_ProjectFileReader)
         EXPECT_TRUE(identical);
     }
 
+    TEST_CASE(ParsingOfConfigurationBlocks_WithLightweightParser)
+    {
+        auto_release_ptr<Project> project =
+            ProjectFileReader::read(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate | ProjectFileReader::UseLightweightParser);
+
+        ASSERT_NEQ(0, project.get());
+
+        const bool success =
+            ProjectFileWriter::write(
+                project.ref(),
+                "unit tests/outputs/test_projectfilereader_configurationblocks_lightweight.appleseed",
+                ProjectFileWriter::OmitHeaderComment);
+
+        ASSERT_TRUE(success);
+
+        const bool identical =
+            compare_text_files(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                "unit tests/outputs/test_projectfilereader_configurationblocks_lightweight.appleseed");
+
+        EXPECT_TRUE(identical);
+    }
+
+    TEST_CASE(LightweightParserAndXercesBuildIdenticalProjects)
+    {
+        const char* InputFilePath = "unit tests/inputs/test_projectfilereader_assemblies.appleseed";
+        const char* XercesOutputFilePath = "unit tests/outputs/test_projectfilereader_assemblies_xerces.appleseed";
+        const char* LightweightOutputFilePath = "unit tests/outputs/test_projectfilereader_assemblies_lightweight.appleseed";
+
+        auto_release_ptr<Project> xerces_project =
+            ProjectFileReader::read(
+                InputFilePath,
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate | ProjectFileReader::OmitProjectSchemaValidation);
+
+        auto_release_ptr<Project> lightweight_project =
+            ProjectFileReader::read(
+                InputFilePath,
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate | ProjectFileReader::UseLightweightParser);
+
+        ASSERT_NEQ(0, xerces_project.get());
+        ASSERT_NEQ(0, lightweight_project.get());
+
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                xerces_project.ref(),
+                XercesOutputFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                lightweight_project.ref(),
+                LightweightOutputFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+
+        EXPECT_TRUE(compare_text_files(XercesOutputFilePath, LightweightOutputFilePath));
+    }
+
+    TEST_CASE(ParsingOfConfigurationBlocks_ThroughBinaryProjectFile)
+    {
+        const char* BinaryFilePath = "unit tests/outputs/test_projectfilereader_configurationblocks.appleseedb";
+        const char* OutputFilePath = "unit tests/outputs/test_projectfilereader_configurationblocks_binary.appleseed";
+
+        auto_release_ptr<Project> xml_project =
+            ProjectFileReader::read(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate | ProjectFileReader::OmitProjectSchemaValidation);
+
+        ASSERT_NEQ(0, xml_project.get());
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                xml_project.ref(),
+                BinaryFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+
+        auto_release_ptr<Project> binary_project =
+            ProjectFileReader::read(
+                BinaryFilePath,
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate);
+
+        ASSERT_NEQ(0, binary_project.get());
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                binary_project.ref(),
+                OutputFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+
+        EXPECT_TRUE(
+            compare_text_files(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                OutputFilePath));
+    }
+
+    TEST_CASE(BinaryProjectFileRoundTrip_BuildsIdenticalProject)
+    {
+        const char* InputFilePath = "unit tests/inputs/test_projectfilereader_assemblies.appleseed";
+        const char* XMLOutputFilePath = "unit tests/outputs/test_projectfilereader_assemblies_roundtrip_xml.appleseed";
+        const char* BinaryFilePath = "unit tests/outputs/test_projectfilereader_assemblies_roundtrip.appleseedb";
+        const char* BinaryOutputFilePath = "unit tests/outputs/test_projectfilereader_assemblies_roundtrip_binary.appleseed";
+
+        auto_release_ptr<Project> xml_project =
+            ProjectFileReader::read(
+                InputFilePath,
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate | ProjectFileReader::OmitProjectSchemaValidation);
+
+        ASSERT_NEQ(0, xml_project.get());
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                xml_project.ref(),
+                BinaryFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                xml_project.ref(),
+                XMLOutputFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+
+        auto_release_ptr<Project> binary_project =
+            ProjectFileReader::read(
+                BinaryFilePath,
+                nullptr,
+                ProjectFileReader::OmitProjectFileUpdate);
+
+        ASSERT_NEQ(0, binary_project.get());
+        ASSERT_TRUE(
+            ProjectFileWriter::write(
+                binary_project.ref(),
+                BinaryOutputFilePath,
+                ProjectFileWriter::OmitHeaderComment));
+
+        EXPECT_TRUE(compare_text_files(XMLOutputFilePath, BinaryOutputFilePath));
+    }
+
     TEST_CASE(ReadValidPackedProject)
     {
         const char* UnpackDirectory = "unit tests/inputs/test_projectfilereader_validpackedproject.unpacked/";
@@ -0,0 +1,121 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/rendertimeestimator.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/pixel.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Rendering_RenderTimeEstimator)
+{
+    struct Fixture
+    {
+        // 4x2 tiles of 10x10 pixels, except for the last column which is 5 pixels wide.
+        const CanvasProperties  m_props;
+
+        Fixture()
+          : m_props(35, 20, 10, 10, 4, PixelFormatFloat)
+        {
+        }
+    };
+
+    TEST_CASE_F(EstimateRemainingTime_GivenNoRecordedTile_ReturnsNegativeValue, Fixture)
+    {
+        RenderTimeEstimator estimator(m_props, 1);
+
+        EXPECT_LT(0.0, estimator.estimate_remaining_time(1.0));
+        EXPECT_EQ(0.0, estimator.get_progress());
+    }
+
+    TEST_CASE_F(PredictTileTime_GivenRenderedTile_ReturnsAverageTimeOverPasses, Fixture)
+    {
+        RenderTimeEstimator estimator(m_props, 2);
+
+        estimator.record_tile(0, 0, 1.0);
+        estimator.record_tile(0, 0, 3.0);
+
+        EXPECT_FEQ(2.0, estimator.predict_tile_time(0, 0));
+    }
+
+    TEST_CASE_F(PredictTileTime_GivenUnrenderedTile_UsesCostPerPixelOfNeighbors, Fixture)
+    {
+        RenderTimeEstimator estimator(m_props, 1);
+
+        estimator.record_tile(0, 0, 100.0);     // expensive corner, not adjacent to tile (3, 1)
+        estimator.record_tile(2, 0, 1.0);
+
+        // Tile (3, 1) only has half as many pixels as tile (2, 0).
+        EXPECT_FEQ(0.5, estimator.predict_tile_time(3, 1));
+    }
+
+    TEST_CASE_F(PredictTileTime_GivenNoRenderedNeighbor_UsesAverageCostPerPixel, Fixture)
+    {
+        RenderTimeEstimator estimator(m_props, 1);
+
+        estimator.record_tile(0, 0, 1.0);
+        estimator.record_tile(0, 1, 3.0);
+
+        EXPECT_FEQ(2.0, estimator.predict_tile_time(3, 0) * 2.0);
+    }
+
+    TEST_CASE_F(GetRemainingWork_AccountsForRemainingPasses, Fixture)
+    {
+        RenderTimeEstimator estimator(m_props, 2);
+
+        // Render every tile once, with the first tile being 100 times more expensive.
+        for (size_t y = 0; y < 2; ++y)
+        {
+            for (size_t x = 0; x < 4; ++x)
+                estimator.record_tile(x, y, x == 0 && y == 0 ? 100.0 : 1.0);
+        }
+
+        EXPECT_FEQ(107.0, estimator.get_remaining_work());
+        EXPECT_FEQ(0.5, estimator.get_progress());
+    }
+
+    TEST_CASE_F(EstimateRemainingTime_DividesRemainingWorkByObservedParallelism, Fixture)
+    {
+        RenderTimeEstimator estimator(m_props, 2);
+
+        for (size_t y = 0; y < 2; ++y)
+        {
+            for (size_t x = 0; x < 4; ++x)
+                estimator.record_tile(x, y, 1.0);
+        }
+
+        // 8 seconds of thread time in 2 seconds of wall clock time: 4 tiles in parallel.
+        EXPECT_FEQ(2.0, estimator.estimate_remaining_time(2.0));
+    }
+}
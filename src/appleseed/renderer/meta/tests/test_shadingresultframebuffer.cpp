@@ -0,0 +1,240 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/aov/tilestack.h"
+#include "renderer/kernel/rendering/shadingresultframebuffer.h"
+#include "renderer/kernel/shading/shadingresult.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/math/half.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Rendering_ShadingResultFrameBuffer)
+{
+    ShadingResultFrameBuffer::Layout make_layout(const bool half_precision_aovs)
+    {
+        // One RGBA AOV and one single-channel AOV.
+        ShadingResultFrameBuffer::Layout layout;
+        layout.m_aov_count = 2;
+        layout.m_aov_channel_counts[0] = 4;
+        layout.m_aov_channel_counts[1] = 1;
+        layout.m_half_precision_aovs = half_precision_aovs;
+        return layout;
+    }
+
+    void add_sample(
+        ShadingResultFrameBuffer&   framebuffer,
+        const Vector2u&             pi,
+        const float                 main,
+        const float                 aov0,
+        const float                 aov1)
+    {
+        ShadingResult sample(2);
+        sample.m_main = Color4f(main);
+        sample.m_aovs[0] = Color4f(aov0);
+        sample.m_aovs[1] = Color4f(aov1);
+        framebuffer.add(pi, sample);
+    }
+
+    struct Fixture
+    {
+        Tile        m_main_tile;
+        Tile        m_aov0_tile;
+        Tile        m_aov1_tile;
+        TileStack   m_aov_tiles;
+
+        Fixture()
+          : m_main_tile(2, 2, 4, PixelFormatFloat)
+          , m_aov0_tile(2, 2, 4, PixelFormatFloat)
+          , m_aov1_tile(2, 2, 1, PixelFormatFloat)
+        {
+            m_aov_tiles.append(&m_aov0_tile);
+            m_aov_tiles.append(&m_aov1_tile);
+        }
+    };
+
+    TEST_CASE(Layout_GivenFloatPrecisionAOVs_StoresAOVChannelsInAccumulatorTile)
+    {
+        const ShadingResultFrameBuffer::Layout layout = make_layout(false);
+
+        EXPECT_EQ(5, layout.get_aov_channel_count());
+        EXPECT_EQ(9, layout.get_float_channel_count());
+        EXPECT_EQ(10 * sizeof(float), layout.get_pixel_size());
+    }
+
+    TEST_CASE(Layout_GivenHalfPrecisionAOVs_StoresAOVChannelsSeparately)
+    {
+        const ShadingResultFrameBuffer::Layout layout = make_layout(true);
+
+        EXPECT_EQ(5, layout.get_aov_channel_count());
+        EXPECT_EQ(4, layout.get_float_channel_count());
+        EXPECT_EQ(5 * sizeof(float) + 5 * sizeof(Half), layout.get_pixel_size());
+    }
+
+    TEST_CASE_F(DevelopToTile_GivenFloatPrecisionAOVs_DevelopsAverages, Fixture)
+    {
+        ShadingResultFrameBuffer framebuffer(2, 2, make_layout(false));
+        framebuffer.clear();
+
+        add_sample(framebuffer, Vector2u(1, 0), 1.0f, 2.0f, 3.0f);
+        add_sample(framebuffer, Vector2u(1, 0), 3.0f, 4.0f, 5.0f);
+
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        Color4f main, aov0;
+        m_main_tile.get_pixel(1, 0, main);
+        m_aov0_tile.get_pixel(1, 0, aov0);
+        EXPECT_FEQ(Color4f(2.0f), main);
+        EXPECT_FEQ(Color4f(3.0f), aov0);
+        EXPECT_FEQ(4.0f, m_aov1_tile.get_component<float>(1, 0, 0));
+        EXPECT_EQ(0.0f, m_aov1_tile.get_component<float>(0, 0, 0));
+    }
+
+    TEST_CASE_F(DevelopToTile_GivenHalfPrecisionAOVs_DevelopsAverages, Fixture)
+    {
+        ShadingResultFrameBuffer framebuffer(2, 2, make_layout(true));
+        framebuffer.clear();
+
+        add_sample(framebuffer, Vector2u(1, 0), 1.0f, 2.0f, 3.0f);
+        add_sample(framebuffer, Vector2u(1, 0), 3.0f, 4.0f, 5.0f);
+
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        Color4f main, aov0;
+        m_main_tile.get_pixel(1, 0, main);
+        m_aov0_tile.get_pixel(1, 0, aov0);
+        EXPECT_FEQ(Color4f(2.0f), main);
+        EXPECT_FEQ_EPS(Color4f(3.0f), aov0, 1.0e-3f);
+        EXPECT_FEQ_EPS(4.0f, m_aov1_tile.get_component<float>(1, 0, 0), 1.0e-3f);
+        EXPECT_EQ(0.0f, m_aov1_tile.get_component<float>(0, 0, 0));
+    }
+
+    TEST_CASE_F(DevelopToTile_GivenManyHalfPrecisionSamples_DoesNotLosePrecision, Fixture)
+    {
+        ShadingResultFrameBuffer framebuffer(2, 2, make_layout(true));
+        framebuffer.clear();
+
+        // The sum of these samples cannot be represented in half precision, their average can.
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            const float offset = (i & 1) ? 1.0f : -1.0f;
+            add_sample(framebuffer, Vector2u(0, 1), 1.0f, 10.0f + offset, 20.0f + offset);
+        }
+
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        Color4f aov0;
+        m_aov0_tile.get_pixel(0, 1, aov0);
+        EXPECT_FEQ_EPS(Color4f(10.0f), aov0, 1.0e-2f);
+        EXPECT_FEQ_EPS(20.0f, m_aov1_tile.get_component<float>(0, 1, 0), 1.0e-2f);
+    }
+
+    TEST_CASE_F(DevelopToTile_GivenManyHalfPrecisionSamplesAwayFromMean_DoesNotStall, Fixture)
+    {
+        ShadingResultFrameBuffer framebuffer(2, 2, make_layout(true));
+        framebuffer.clear();
+
+        // Updating a half precision running mean with each of the later samples would stall at 0.5.
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            const float value = i < 5000 ? 0.0f : 2.0f;
+            add_sample(framebuffer, Vector2u(1, 1), 1.0f, value, value);
+        }
+
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        Color4f aov0;
+        m_aov0_tile.get_pixel(1, 1, aov0);
+        EXPECT_FEQ_EPS(Color4f(1.0f), aov0, 1.0e-3f);
+        EXPECT_FEQ_EPS(1.0f, m_aov1_tile.get_component<float>(1, 1, 0), 1.0e-3f);
+    }
+
+    TEST_CASE_F(DevelopToTile_GivenHalfPrecisionSamplesOverSeveralPasses_DevelopsAverages, Fixture)
+    {
+        ShadingResultFrameBuffer framebuffer(2, 2, make_layout(true));
+        framebuffer.clear();
+
+        add_sample(framebuffer, Vector2u(0, 0), 1.0f, 1.0f, 1.0f);
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        add_sample(framebuffer, Vector2u(0, 0), 1.0f, 4.0f, 4.0f);
+        add_sample(framebuffer, Vector2u(0, 0), 1.0f, 4.0f, 4.0f);
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        Color4f aov0;
+        m_aov0_tile.get_pixel(0, 0, aov0);
+        EXPECT_FEQ_EPS(Color4f(3.0f), aov0, 1.0e-3f);
+        EXPECT_FEQ_EPS(3.0f, m_aov1_tile.get_component<float>(0, 0, 0), 1.0e-3f);
+    }
+
+    TEST_CASE_F(Merge_GivenHalfPrecisionAOVs_MergesWeightedAverages, Fixture)
+    {
+        ShadingResultFrameBuffer framebuffer(2, 2, make_layout(true));
+        framebuffer.clear();
+        add_sample(framebuffer, Vector2u(0, 0), 1.0f, 2.0f, 2.0f);
+
+        ShadingResultFrameBuffer source(2, 2, make_layout(true));
+        source.clear();
+        add_sample(source, Vector2u(1, 1), 1.0f, 5.0f, 5.0f);
+        add_sample(source, Vector2u(1, 1), 1.0f, 5.0f, 5.0f);
+        add_sample(source, Vector2u(1, 1), 1.0f, 5.0f, 5.0f);
+
+        framebuffer.merge(0, 0, source, 1, 1, 1.0f);
+        framebuffer.develop_to_tile(m_main_tile, m_aov_tiles);
+
+        Color4f aov0;
+        m_aov0_tile.get_pixel(0, 0, aov0);
+        EXPECT_FEQ_EPS(Color4f(4.25f), aov0, 1.0e-3f);
+        EXPECT_FEQ_EPS(4.25f, m_aov1_tile.get_component<float>(0, 0, 0), 1.0e-3f);
+    }
+
+    TEST_CASE(CopyFrom_GivenHalfPrecisionAOVs_CopiesAOVs)
+    {
+        ShadingResultFrameBuffer source(2, 2, make_layout(true));
+        source.clear();
+        add_sample(source, Vector2u(0, 0), 1.0f, 7.0f, 7.0f);
+
+        ShadingResultFrameBuffer copy(2, 2, make_layout(true));
+        copy.copy_from(source);
+
+        Fixture fixture;
+        copy.develop_to_tile(fixture.m_main_tile, fixture.m_aov_tiles);
+
+        EXPECT_FEQ_EPS(7.0f, fixture.m_aov1_tile.get_component<float>(0, 0, 0), 1.0e-3f);
+    }
+}
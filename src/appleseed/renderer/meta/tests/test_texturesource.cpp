@@ -0,0 +1,259 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/input/source.h"
+#include "renderer/modeling/input/sourceinputs.h"
+#include "renderer/modeling/input/texturesource.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/modeling/texture/tileptr.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/testutils.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/colorspace.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/tile.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/memory/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+#include "foundation/utility/uid.h"
+
+// Standard headers.
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Input_TextureSource)
+{
+    //
+    // A 16x16 texture with a full MIP chain in which all texels of a level are equal to the
+    // index of the level, so that a trilinear lookup returns the (fractional) level it used.
+    //
+
+    class LevelIndexTexture
+      : public Texture
+    {
+      public:
+        explicit LevelIndexTexture(const char* name)
+          : Texture(name, ParamArray())
+        {
+            for (size_t level = 0, size = 16; size > 0; ++level, size /= 2)
+            {
+                m_level_props.emplace_back(size, size, size, size, 3, PixelFormatFloat);
+
+                m_level_tiles.emplace_back(new Tile(size, size, 3, PixelFormatFloat));
+                m_level_tiles.back()->clear(Color3f(static_cast<float>(level)));
+            }
+        }
+
+        void release() override
+        {
+            delete this;
+        }
+
+        const char* get_model() const override
+        {
+            return "level_index_texture";
+        }
+
+        ColorSpace get_color_space() const override
+        {
+            return ColorSpaceLinearRGB;
+        }
+
+        const CanvasProperties& properties() override
+        {
+            return m_level_props[0];
+        }
+
+        Source* create_source(
+            const UniqueID          assembly_uid,
+            const TextureInstance&  texture_instance) override
+        {
+            return new TextureSource(assembly_uid, texture_instance);
+        }
+
+        TilePtr load_tile(
+            const size_t            tile_x,
+            const size_t            tile_y) override
+        {
+            return load_mip_level_tile(0, tile_x, tile_y);
+        }
+
+        size_t get_mip_level_count() override
+        {
+            return m_level_props.size();
+        }
+
+        const CanvasProperties& get_mip_level_properties(
+            const size_t            level) override
+        {
+            return m_level_props[level];
+        }
+
+        TilePtr load_mip_level_tile(
+            const size_t            level,
+            const size_t            tile_x,
+            const size_t            tile_y) override
+        {
+            assert(tile_x == 0);
+            assert(tile_y == 0);
+            return TilePtr::make_non_owning(m_level_tiles[level].get());
+        }
+
+        bool has_stored_mip_levels() override
+        {
+            return true;
+        }
+
+      private:
+        std::vector<CanvasProperties>       m_level_props;
+        std::vector<std::unique_ptr<Tile>>  m_level_tiles;
+    };
+
+    struct TestScene
+      : public TestSceneBase
+    {
+        TestScene()
+        {
+            m_scene.textures().insert(
+                auto_release_ptr<Texture>(new LevelIndexTexture("texture")));
+
+            create_texture_instance("bilinear_texture_inst", "texture", "bilinear");
+            create_texture_instance("trilinear_texture_inst", "texture", "trilinear");
+        }
+
+        void create_texture_instance(
+            const char*             name,
+            const char*             texture_name,
+            const char*             filtering_mode)
+        {
+            m_scene.texture_instances().insert(
+                TextureInstanceFactory::create(
+                    name,
+                    ParamArray()
+                        .insert("addressing_mode", "clamp")
+                        .insert("filtering_mode", filtering_mode),
+                    texture_name,
+                    Transformf::identity()));
+        }
+    };
+
+    struct Fixture
+      : public StaticTestSceneContext<TestScene>
+    {
+        TextureStore                        m_texture_store;
+        TextureCache                        m_texture_cache;
+
+        Fixture()
+          : m_texture_store(m_scene)
+          , m_texture_cache(m_texture_store)
+        {
+        }
+
+        // Sample a texture instance of the scene at the center of the texture.
+        float lookup(
+            const char*                     texture_instance_name,
+            const Vector2f&                 duvdx,
+            const Vector2f&                 duvdy)
+        {
+            const TextureInstance* texture_instance =
+                m_scene.texture_instances().get_by_name(texture_instance_name);
+            assert(texture_instance != nullptr);
+
+            std::unique_ptr<Source> source(
+                texture_instance->get_texture().create_source(~UniqueID(0), *texture_instance));
+
+            float value;
+            source->evaluate(
+                m_texture_cache,
+                SourceInputs(Vector2f(0.5f), duvdx, duvdy),
+                value);
+
+            return value;
+        }
+
+        // Return the screen space partial derivative of the texture coordinates
+        // matching a footprint of a given number of base level texels.
+        static Vector2f footprint(const float texel_count)
+        {
+            return Vector2f(texel_count / 16.0f, 0.0f);
+        }
+    };
+
+    TEST_CASE_F(Evaluate_TrilinearFilteringWithoutRayDifferentials_UsesBaseLevel, Fixture)
+    {
+        EXPECT_EQ(0.0f, lookup("trilinear_texture_inst", Vector2f(0.0f), Vector2f(0.0f)));
+    }
+
+    TEST_CASE_F(Evaluate_TrilinearFilteringUnderMagnification_UsesBaseLevel, Fixture)
+    {
+        EXPECT_EQ(0.0f, lookup("trilinear_texture_inst", footprint(0.5f), footprint(0.25f)));
+    }
+
+    TEST_CASE_F(Evaluate_TrilinearFilteringWithFootprintOfFourTexels_UsesLevelTwo, Fixture)
+    {
+        EXPECT_FEQ(2.0f, lookup("trilinear_texture_inst", footprint(4.0f), Vector2f(0.0f)));
+    }
+
+    TEST_CASE_F(Evaluate_TrilinearFilteringWithFractionalFootprint_BlendsBracketingLevels, Fixture)
+    {
+        // The footprint is the larger of the two axes: 2^1.25 texels, i.e. 3/4 of level 1 and 1/4 of level 2.
+        const float value =
+            lookup(
+                "trilinear_texture_inst",
+                footprint(1.0f),
+                footprint(std::pow(2.0f, 1.25f)));
+
+        EXPECT_FEQ_EPS(1.25f, value, 1.0e-4f);
+    }
+
+    TEST_CASE_F(Evaluate_TrilinearFilteringWithFootprintLargerThanTexture_UsesCoarsestLevel, Fixture)
+    {
+        EXPECT_EQ(4.0f, lookup("trilinear_texture_inst", footprint(1000.0f), Vector2f(0.0f)));
+    }
+
+    TEST_CASE_F(Evaluate_BilinearFiltering_IgnoresFootprint, Fixture)
+    {
+        EXPECT_EQ(0.0f, lookup("bilinear_texture_inst", footprint(4.0f), Vector2f(0.0f)));
+    }
+}
@@ -36,6 +36,7 @@
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/kernel/shading/shadingpoint.h"
 #include "renderer/kernel/shading/shadingresult.h"
+#include "renderer/modeling/aov/cryptomatteweightbuffer.h"
 #include "renderer/modeling/color/colorspace.h"
 #include "renderer/modeling/frame/frame.h"
 
@@ -273,119 +274,6 @@ namespace
         }
     };
 
-    class WeightMap
-    {
-      public:
-        struct Entry
-        {
-            std::uint32_t   m_key;
-            float           m_value;
-
-            Entry()
-              : m_key(0)
-              , m_value(0.0f)
-            {
-            }
-        };
-
-        explicit WeightMap(const size_t size)
-          : m_size(static_cast<std::uint32_t>(size))
-          , m_index(0)
-        {
-            assert(size > 0);
-            m_map = new Entry[size];
-        }
-
-        WeightMap(const WeightMap& other)
-          : m_size(other.m_size)
-          , m_index(other.m_index)
-        {
-            m_map = new Entry[m_size];
-            for (size_t i = 0; i < m_index; ++i)
-                m_map[i] = other.m_map[i];
-        }
-
-        WeightMap& operator=(const WeightMap& rhs)
-        {
-            if (m_size != rhs.m_size)
-            {
-                delete[] m_map;
-                m_map = new Entry[rhs.m_size];
-            }
-
-            m_size = rhs.m_size;
-            m_index = rhs.m_size;
-            for (size_t i = 0; i < m_index; ++i)
-                m_map[i] = rhs.m_map[i];
-
-            return *this;
-        }
-
-        ~WeightMap()
-        {
-            delete[] m_map;
-        }
-
-        void insert(const std::uint32_t key, const float value)
-        {
-            assert(m_map);
-
-            for (size_t i = 0; i < m_index; ++i)
-            {
-                if (m_map[i].m_key == key)
-                {
-                    m_map[i].m_value = value;
-                    return;
-                }
-            }
-
-            if (m_index < m_size)
-            {
-                m_map[m_index].m_key = key;
-                m_map[m_index].m_value = value;
-                ++m_index;
-            }
-        }
-
-        float get(const std::uint32_t key) const
-        {
-            assert(m_map);
-
-            for (size_t i = 0; i < m_index; ++i)
-            {
-                if (m_map[i].m_key == key)
-                    return m_map[i].m_value;
-            }
-
-            return 0.0f;
-        }
-
-        void clear()
-        {
-            m_index = 0;
-        }
-
-        bool empty() const
-        {
-            return m_index == 0;
-        }
-
-        Entry* begin() const
-        {
-            return m_map;
-        }
-
-        Entry* end() const
-        {
-            return m_map + m_index;
-        }
-
-      private:
-        std::uint32_t   m_size;
-        std::uint32_t   m_index;
-        Entry*          m_map;
-    };
-
     // Code taken from Cryptomatte specification.
     float hash_to_float(std::uint32_t hash)
     {
@@ -418,13 +306,11 @@ namespace
       public:
         CryptomatteAOVAccumulator(
             Image&                              aov_image,
-            std::vector<WeightMap>&             pixel_samples,
             NameMap*                            tile_name_array,
             size_t                              num_layers,
             CryptomatteAOV::CryptomatteType     layer_type)
           : m_aov_image(aov_image)
           , m_num_layers(num_layers)
-          , m_pixel_samples(pixel_samples)
           , m_tile_name_maps(tile_name_array)
           , m_layer_type(layer_type)
         {
@@ -440,20 +326,17 @@ namespace
             const CanvasProperties& props = frame.image().properties();
             const Tile& tile = frame.image().tile(tile_x, tile_y);
 
-            m_frame_width = props.m_canvas_width;
-            m_tile_index = tile_y * props.m_tile_count_y + tile_x;
+            m_tile_index = tile_y * props.m_tile_count_x + tile_x;
 
             // Fetch the tile bounds (inclusive).
             m_tile_origin_x = tile_x * props.m_tile_width;
             m_tile_origin_y = tile_y * props.m_tile_height;
             m_tile_end_x = m_tile_origin_x + tile.get_width() - 1;
             m_tile_end_y = m_tile_origin_y + tile.get_height() - 1;
+            m_tile_width = tile.get_width();
 
-            for (size_t ry = m_tile_origin_y; ry <= m_tile_end_y; ++ry)
-            {
-                for (size_t rx = m_tile_origin_x; rx <= m_tile_end_x; ++rx)
-                    m_pixel_samples[ry * m_frame_width + rx].clear();
-            }
+            // Reuse the same storage for the weights of all tiles.
+            m_weights.reset(tile.get_pixel_count(), m_num_layers);
 
             m_crop_window =
                 frame.has_crop_window()
@@ -466,7 +349,6 @@ namespace
             const size_t                tile_x,
             const size_t                tile_y) override
         {
-            std::vector<std::pair<float, std::uint32_t>> ranked_vector;
             std::vector<float> pixel_values;
             constexpr float uint32_max_rcp = 1.0f / static_cast<float>(std::numeric_limits<std::uint32_t>::max()); // todo: in other places `4294967295u` is used instead. only one way to "get" this number should be used probably?
 
@@ -474,30 +356,23 @@ namespace
             {
                 for (size_t rx = m_tile_origin_x; rx <= m_tile_end_x; ++rx)
                 {
-                    const WeightMap& weight_map = m_pixel_samples[ry * m_frame_width + rx];
+                    const size_t pixel_index = (ry - m_tile_origin_y) * m_tile_width + (rx - m_tile_origin_x);
 
-                    if (!weight_map.empty())
+                    // Sort IDs by decreasing weight and keep the highest-weighted ones.
+                    const size_t ranked_count = m_weights.finalize(pixel_index);
+
+                    if (ranked_count > 0)
                     {
-                        clear_keep_memory(ranked_vector);
+                        const CryptomatteWeightBuffer::Entry* ranked = m_weights.get_entries(pixel_index);
+
                         clear_keep_memory(pixel_values);
 
-                        float total_weight = 0.0f;
-                        for (const auto& item : weight_map)
-                            total_weight += item.m_value;
+                        float total_weight = m_weights.get_total_weight(pixel_index);
 
                         if (total_weight == 0.0f)
                             total_weight = 1.0f;
 
-                        for (const auto& item : weight_map)
-                            ranked_vector.push_back(std::make_pair(item.m_value, item.m_key));
-
-                        sort(ranked_vector.begin(), ranked_vector.end(),
-                            [](std::pair<float, std::uint32_t> const& a, std::pair<float, std::uint32_t> const& b)
-                            {
-                                return a.first > b.first;
-                            });
-
-                        const std::uint32_t m3hash_preview = ranked_vector[0].second;
+                        const std::uint32_t m3hash_preview = ranked[0].m_id;
 
                         // Preview channels (deprecated in recent Cryptomatte specification).
                         float r(0.0f), g(0.0f), b(0.0f);
@@ -512,19 +387,19 @@ namespace
                         pixel_values.push_back(b);
 
                         // Remove background contribution.
-                        size_t ranked_vector_start = 0;
-                        if (ranked_vector.size() > 1 && m3hash_preview == 0)
-                            ranked_vector_start = 1;
+                        size_t ranked_start = 0;
+                        if (ranked_count > 1 && m3hash_preview == 0)
+                            ranked_start = 1;
 
                         // Ranked channels.
-                        for (size_t i = ranked_vector_start, e = std::min(ranked_vector.size(), m_num_layers); i < e; ++i)
+                        for (size_t i = ranked_start; i < ranked_count; ++i)
                         {
-                            const std::uint32_t m3hash = ranked_vector[i].second;
+                            const std::uint32_t m3hash = ranked[i].m_id;
                             float rank(0.0f), coverage(0.0f);
                             if (m3hash != 0)
                             {
                                 rank = hash_to_float(m3hash);
-                                coverage = ranked_vector[i].first / total_weight;
+                                coverage = ranked[i].m_weight / total_weight;
                             }
                             pixel_values.push_back(rank);
                             pixel_values.push_back(coverage);
@@ -535,7 +410,7 @@ namespace
                         // 3 channels for the preview image and subtracting that from the
                         // total number of AOV channels.
                         const size_t num_channels = (m_num_layers * 2) + 3;
-                        const size_t filled_channels = (ranked_vector.size() - ranked_vector_start) * 2 + 3;
+                        const size_t filled_channels = (ranked_count - ranked_start) * 2 + 3;
 
                         for (size_t i = filled_channels; i < num_channels; ++i)
                             pixel_values.push_back(0.0f);
@@ -600,16 +475,14 @@ namespace
             if (!m_crop_window.contains(pixel_pos))
                 return;
 
-            m_tile_name_maps[m_tile_index][m3hash] = obj_name;
+            NameMap& name_map = m_tile_name_maps[m_tile_index];
+            if (name_map.find(m3hash) == name_map.end())
+                name_map.insert(std::make_pair(m3hash, obj_name));
 
             const size_t x = pixel_pos.x - m_tile_origin_x;
             const size_t y = pixel_pos.y - m_tile_origin_y;
 
-            WeightMap& weight_map =
-                m_pixel_samples[(m_tile_origin_y + y) * m_frame_width + (m_tile_origin_x + x)];
-
-            const float old_value = weight_map.get(m3hash);
-            weight_map.insert(m3hash, old_value + 1.0f);
+            m_weights.insert(y * m_tile_width + x, m3hash, 1.0f);
         }
 
       private:
@@ -617,12 +490,12 @@ namespace
         size_t                          m_tile_origin_y;
         size_t                          m_tile_end_x;
         size_t                          m_tile_end_y;
+        size_t                          m_tile_width;
         size_t                          m_tile_index;
-        size_t                          m_frame_width;
         AABB2u                          m_crop_window;
         Image&                          m_aov_image;
         size_t                          m_num_layers;
-        std::vector<WeightMap>&         m_pixel_samples;
+        CryptomatteWeightBuffer         m_weights;
         NameMap*                        m_tile_name_maps;
         CryptomatteAOV::CryptomatteType m_layer_type;
     };
@@ -641,7 +514,6 @@ namespace
 
 struct CryptomatteAOV::Impl
 {
-    std::vector<WeightMap>              m_pixel_samples;
     NameMap*                            m_tile_name_maps;
     std::unique_ptr<Image>              m_image;
     size_t                              m_num_layers;
@@ -794,7 +666,6 @@ void CryptomatteAOV::create_image(
             tile_height,
             channel_count,
             PixelFormatFloat));
-    impl->m_pixel_samples.resize(canvas_width * canvas_height, WeightMap(impl->m_num_layers));
     const auto& image_props = impl->m_image->properties();
     impl->m_tile_name_maps = new NameMap[image_props.m_tile_count];
     clear_image();
@@ -823,7 +694,6 @@ auto_release_ptr<AOVAccumulator> CryptomatteAOV::create_accumulator() const
         auto_release_ptr<AOVAccumulator>(
             new CryptomatteAOVAccumulator(
                 *impl->m_image,
-                impl->m_pixel_samples,
                 impl->m_tile_name_maps,
                 impl->m_num_layers,
                 impl->m_layer_type));
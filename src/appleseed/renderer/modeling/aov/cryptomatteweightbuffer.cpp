@@ -0,0 +1,127 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "cryptomatteweightbuffer.h"
+
+// Standard headers.
+#include <algorithm>
+
+namespace renderer
+{
+
+//
+// CryptomatteWeightBuffer class implementation.
+//
+
+namespace
+{
+    // Order IDs by decreasing weight; break ties with IDs to get deterministic results.
+    struct HasHigherWeight
+    {
+        bool operator()(
+            const CryptomatteWeightBuffer::Entry&   lhs,
+            const CryptomatteWeightBuffer::Entry&   rhs) const
+        {
+            return
+                lhs.m_weight > rhs.m_weight ||
+                (lhs.m_weight == rhs.m_weight && lhs.m_id < rhs.m_id);
+        }
+    };
+}
+
+CryptomatteWeightBuffer::CryptomatteWeightBuffer()
+  : m_max_id_count(0)
+  , m_capacity(0)
+{
+}
+
+void CryptomatteWeightBuffer::reset(
+    const size_t                pixel_count,
+    const size_t                max_id_count)
+{
+    assert(max_id_count > 0);
+
+    m_max_id_count = max_id_count;
+    m_capacity = 2 * max_id_count;
+
+    m_entries.resize(pixel_count * m_capacity);
+    m_entry_counts.assign(pixel_count, 0);
+    m_total_weights.assign(pixel_count, 0.0f);
+}
+
+size_t CryptomatteWeightBuffer::finalize(const size_t pixel_index)
+{
+    assert(pixel_index < m_entry_counts.size());
+
+    Entry* entries = &m_entries[pixel_index * m_capacity];
+    size_t entry_count = m_entry_counts[pixel_index];
+
+    entry_count = trim(pixel_index, entries, entry_count);
+    std::sort(entries, entries + entry_count, HasHigherWeight());
+
+    for (size_t i = 0; i < entry_count; ++i)
+        m_total_weights[pixel_index] += entries[i].m_weight;
+
+    m_entry_counts[pixel_index] = static_cast<std::uint32_t>(entry_count);
+
+    return entry_count;
+}
+
+size_t CryptomatteWeightBuffer::get_memory_size() const
+{
+    return
+        sizeof(*this) +
+        m_entries.capacity() * sizeof(Entry) +
+        m_entry_counts.capacity() * sizeof(std::uint32_t) +
+        m_total_weights.capacity() * sizeof(float);
+}
+
+size_t CryptomatteWeightBuffer::trim(
+    const size_t                pixel_index,
+    Entry*                      entries,
+    const size_t                entry_count)
+{
+    if (entry_count <= m_max_id_count)
+        return entry_count;
+
+    std::nth_element(
+        entries,
+        entries + m_max_id_count,
+        entries + entry_count,
+        HasHigherWeight());
+
+    // Keep track of the weight of evicted IDs.
+    for (size_t i = m_max_id_count; i < entry_count; ++i)
+        m_total_weights[pixel_index] += entries[i].m_weight;
+
+    return m_max_id_count;
+}
+
+}   // namespace renderer
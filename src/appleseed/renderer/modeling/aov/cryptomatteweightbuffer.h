@@ -0,0 +1,156 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace renderer
+{
+
+//
+// Fixed-capacity storage for the weights of object IDs in each pixel of a tile.
+//
+// All pixels share a single block of memory which is reused from one tile to the next.
+// Each pixel has room for twice as many IDs as are eventually kept. When a pixel runs
+// out of room, only the IDs with the highest weights are kept. The weights of evicted
+// IDs still count toward the total weight of the pixel.
+//
+
+class CryptomatteWeightBuffer
+  : public foundation::NonCopyable
+{
+  public:
+    struct Entry
+    {
+        std::uint32_t   m_id;
+        float           m_weight;
+    };
+
+    // Constructor.
+    CryptomatteWeightBuffer();
+
+    // Set the number of pixels and the maximum number of IDs kept per pixel, and clear all pixels.
+    void reset(
+        const size_t            pixel_count,
+        const size_t            max_id_count);
+
+    // Add a weight to a given ID in a given pixel.
+    void insert(
+        const size_t            pixel_index,
+        const std::uint32_t     id,
+        const float             weight);
+
+    // Sort the IDs of a given pixel by decreasing weight and keep at most the maximum number
+    // of IDs per pixel. Return the number of remaining IDs. Must be called once per pixel.
+    size_t finalize(const size_t pixel_index);
+
+    // Access the IDs of a given pixel.
+    const Entry* get_entries(const size_t pixel_index) const;
+    size_t get_entry_count(const size_t pixel_index) const;
+
+    // Return the sum of all weights inserted into a given pixel, including evicted ones.
+    // Only valid after finalize() has been called for this pixel.
+    float get_total_weight(const size_t pixel_index) const;
+
+    // Return the amount of memory used by this buffer, in bytes.
+    size_t get_memory_size() const;
+
+  private:
+    size_t                      m_max_id_count;
+    size_t                      m_capacity;
+    std::vector<Entry>          m_entries;
+    std::vector<std::uint32_t>  m_entry_counts;
+    std::vector<float>          m_total_weights;        // weights of evicted IDs until the pixel is finalized
+
+    // Keep only the IDs with the highest weights among a pixel's IDs.
+    size_t trim(
+        const size_t            pixel_index,
+        Entry*                  entries,
+        const size_t            entry_count);
+};
+
+
+//
+// CryptomatteWeightBuffer class implementation.
+//
+
+inline void CryptomatteWeightBuffer::insert(
+    const size_t                pixel_index,
+    const std::uint32_t         id,
+    const float                 weight)
+{
+    assert(pixel_index < m_entry_counts.size());
+
+    Entry* entries = &m_entries[pixel_index * m_capacity];
+    size_t entry_count = m_entry_counts[pixel_index];
+
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        if (entries[i].m_id == id)
+        {
+            entries[i].m_weight += weight;
+            return;
+        }
+    }
+
+    if (entry_count == m_capacity)
+        entry_count = trim(pixel_index, entries, entry_count);
+
+    entries[entry_count].m_id = id;
+    entries[entry_count].m_weight = weight;
+    m_entry_counts[pixel_index] = static_cast<std::uint32_t>(entry_count + 1);
+}
+
+inline const CryptomatteWeightBuffer::Entry* CryptomatteWeightBuffer::get_entries(const size_t pixel_index) const
+{
+    assert(pixel_index < m_entry_counts.size());
+    return &m_entries[pixel_index * m_capacity];
+}
+
+inline size_t CryptomatteWeightBuffer::get_entry_count(const size_t pixel_index) const
+{
+    assert(pixel_index < m_entry_counts.size());
+    return m_entry_counts[pixel_index];
+}
+
+inline float CryptomatteWeightBuffer::get_total_weight(const size_t pixel_index) const
+{
+    assert(pixel_index < m_total_weights.size());
+    return m_total_weights[pixel_index];
+}
+
+}   // namespace renderer
@@ -35,12 +35,17 @@
 #include "foundation/image/image.h"
 #include "foundation/image/tile.h"
 #include "foundation/math/scalar.h"
+#include "foundation/memory/memory.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 
 // Boost headers.
 #include "boost/filesystem/fstream.hpp"
 
 // Standard headers.
 #include <algorithm>
+#include <cassert>
 #include <iomanip>
 
 using namespace foundation;
@@ -110,6 +115,57 @@ namespace
 
         of << "};" << std::endl;
     }
+
+    // Bilinearly interpolate the four values (a, b, c, d) of a cell of an interpolation table.
+    inline float bilinear_interpolation(const float cell[4], const float s, const float t)
+    {
+        assert(is_aligned(cell, 16));
+
+#ifdef APPLESEED_USE_SSE
+
+        const __m128 weights =
+            _mm_set_ps(
+                s * t,
+                (1.0f - s) * t,
+                s * (1.0f - t),
+                (1.0f - s) * (1.0f - t));
+
+        __m128 x = _mm_mul_ps(_mm_load_ps(cell), weights);
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+
+        return _mm_cvtss_f32(x);
+
+#else
+
+        return lerp(lerp(cell[0], cell[1], s), lerp(cell[2], cell[3], s), t);
+
+#endif
+    }
+
+    // Trilinearly interpolate the eight values (a, b, c, d, e, f, g, h) of a cell of an interpolation table.
+    inline float trilinear_interpolation(const float cell[8], const float s, const float t, const float u)
+    {
+        assert(is_aligned(cell, 32));
+
+#ifdef APPLESEED_USE_SSE
+
+        const __m128 lo = _mm_load_ps(cell);
+        const __m128 hi = _mm_load_ps(cell + 4);
+
+        APPLESEED_SIMD4_ALIGN float values[4];
+        _mm_store_ps(values, _mm_add_ps(lo, _mm_mul_ps(_mm_set1_ps(u), _mm_sub_ps(hi, lo))));
+
+        return bilinear_interpolation(values, s, t);
+
+#else
+
+        const float q = lerp(lerp(cell[0], cell[1], s), lerp(cell[2], cell[3], s), t);
+        const float r = lerp(lerp(cell[4], cell[5], s), lerp(cell[6], cell[7], s), t);
+        return lerp(q, r, u);
+
+#endif
+    }
 }
 
 
@@ -120,6 +176,7 @@ namespace
 AlbedoTable2D::AlbedoTable2D()
   : TableSize(32)
   , TableHeight(TableSize + 1)
+  , m_interp_table(nullptr)
 {
     m_data = new float[array_size()];
     m_albedo_table = m_data;
@@ -130,13 +187,19 @@ AlbedoTable2D::AlbedoTable2D(const float* table)
   : TableSize(32)
   , TableHeight(TableSize + 1)
   , m_data(nullptr)
+  , m_interp_table(nullptr)
 {
     m_albedo_table = const_cast<float*>(table);
     m_avg_table = m_albedo_table + TableSize * TableSize;
+
+    build_interpolation_table();
 }
 
 AlbedoTable2D::~AlbedoTable2D()
 {
+    if (m_interp_table)
+        aligned_free(m_interp_table);
+
     delete[] m_data;
 }
 
@@ -145,6 +208,32 @@ size_t AlbedoTable2D::array_size() const
     return TableSize * TableHeight;
 }
 
+void AlbedoTable2D::build_interpolation_table()
+{
+    assert(m_interp_table == nullptr);
+
+    m_interp_table =
+        static_cast<float*>(
+            aligned_malloc(TableSize * TableSize * 4 * sizeof(float), 16));
+
+    float* p = m_interp_table;
+
+    for (size_t j = 0; j < TableSize; ++j)
+    {
+        const size_t j1 = std::min(j + 1, TableSize - 1);
+
+        for (size_t i = 0; i < TableSize; ++i)
+        {
+            const size_t i1 = std::min(i + 1, TableSize - 1);
+
+            *p++ = dir_table(i , j );
+            *p++ = dir_table(i1, j );
+            *p++ = dir_table(i , j1);
+            *p++ = dir_table(i1, j1);
+        }
+    }
+}
+
 float AlbedoTable2D::get_directional_albedo(const float cos_theta, const float roughness) const
 {
     assert(cos_theta >= 0.0f);
@@ -160,17 +249,9 @@ float AlbedoTable2D::get_directional_albedo(const float cos_theta, const float r
     const float s = floor_frac(x, i);
     const float t = floor_frac(y, j);
 
-    const size_t i1 = std::min(i + 1, TableSize - 1);
-    const size_t j1 = std::min(j + 1, TableSize - 1);
-
-    // Fetch the values.
-    const float a = dir_table(i , j );
-    const float b = dir_table(i1, j );
-    const float c = dir_table(i , j1);
-    const float d = dir_table(i1, j1);
-
     // Bilinear interpolation.
-    return lerp(lerp(a, b, s), lerp(c, d, s), t);
+    assert(m_interp_table);
+    return bilinear_interpolation(m_interp_table + (j * TableSize + i) * 4, s, t);
 }
 
 float AlbedoTable2D::get_average_albedo(const float roughness) const
@@ -258,6 +339,8 @@ void AlbedoTable2D::write_table_to_cpp_array(
 
 AlbedoTable3D::AlbedoTable3D(const float min_eta, const float max_eta)
   : TableSize(16)
+  , m_dir_interp_table(nullptr)
+  , m_avg_interp_table(nullptr)
   , m_min_eta(min_eta)
   , m_max_eta(max_eta)
 {
@@ -270,16 +353,25 @@ AlbedoTable3D::AlbedoTable3D(const float min_eta, const float max_eta)
 AlbedoTable3D::AlbedoTable3D(const float* table, const float min_eta, const float max_eta)
   : TableSize(16)
   , m_data(nullptr)
+  , m_dir_interp_table(nullptr)
+  , m_avg_interp_table(nullptr)
   , m_min_eta(min_eta)
   , m_max_eta(max_eta)
 {
     m_albedo_table = const_cast<float*>(table);
 
     init();
+    build_interpolation_tables();
 }
 
 AlbedoTable3D::~AlbedoTable3D()
 {
+    if (m_dir_interp_table)
+        aligned_free(m_dir_interp_table);
+
+    if (m_avg_interp_table)
+        aligned_free(m_avg_interp_table);
+
     delete[] m_data;
 }
 
@@ -297,6 +389,64 @@ size_t AlbedoTable3D::array_size() const
     return dir_table_size + avg_table_size;
 }
 
+void AlbedoTable3D::build_interpolation_tables()
+{
+    assert(m_dir_interp_table == nullptr);
+    assert(m_avg_interp_table == nullptr);
+
+    m_dir_interp_table =
+        static_cast<float*>(
+            aligned_malloc(TableSize * TableSize * TableSize * 8 * sizeof(float), 64));
+
+    float* p = m_dir_interp_table;
+
+    for (size_t z = 0; z < TableSize; ++z)
+    {
+        const size_t z1 = std::min(z + 1, TableSize - 1);
+
+        for (size_t y = 0; y < TableSize; ++y)
+        {
+            const size_t y1 = std::min(y + 1, TableSize - 1);
+
+            for (size_t x = 0; x < TableSize; ++x)
+            {
+                const size_t x1 = std::min(x + 1, TableSize - 1);
+
+                *p++ = dir_table(x , y , z );
+                *p++ = dir_table(x1, y , z );
+                *p++ = dir_table(x , y1, z );
+                *p++ = dir_table(x1, y1, z );
+
+                *p++ = dir_table(x , y , z1);
+                *p++ = dir_table(x1, y , z1);
+                *p++ = dir_table(x , y1, z1);
+                *p++ = dir_table(x1, y1, z1);
+            }
+        }
+    }
+
+    m_avg_interp_table =
+        static_cast<float*>(
+            aligned_malloc(TableSize * TableSize * 4 * sizeof(float), 16));
+
+    p = m_avg_interp_table;
+
+    for (size_t y = 0; y < TableSize; ++y)
+    {
+        const size_t y1 = std::min(y + 1, TableSize - 1);
+
+        for (size_t x = 0; x < TableSize; ++x)
+        {
+            const size_t x1 = std::min(x + 1, TableSize - 1);
+
+            *p++ = avg_table(x , y );
+            *p++ = avg_table(x1, y );
+            *p++ = avg_table(x , y1);
+            *p++ = avg_table(x1, y1);
+        }
+    }
+}
+
 float AlbedoTable3D::get_directional_albedo(const float eta, const float roughness, const float cos_theta) const
 {
     assert(eta >= m_min_eta);
@@ -316,25 +466,14 @@ float AlbedoTable3D::get_directional_albedo(const float eta, const float roughne
     const float t = floor_frac(y, iy);
     const float u = floor_frac(z, iz);
 
-    const size_t ix1 = std::min(ix + 1, TableSize - 1);
-    const size_t iy1 = std::min(iy + 1, TableSize - 1);
-    const size_t iz1 = std::min(iz + 1, TableSize - 1);
-
-    // Fetch the values.
-    const float a = dir_table(ix , iy , iz);
-    const float b = dir_table(ix1, iy , iz);
-    const float c = dir_table(ix , iy1, iz);
-    const float d = dir_table(ix1, iy1, iz);
-
-    const float e = dir_table(ix , iy , iz1);
-    const float f = dir_table(ix1, iy , iz1);
-    const float g = dir_table(ix , iy1, iz1);
-    const float h = dir_table(ix1, iy1, iz1);
-
     // Trilinear interpolation.
-    const float q = lerp(lerp(a, b, s), lerp(c, d, s), t);
-    const float r = lerp(lerp(e, f, s), lerp(g, h, s), t);
-    return lerp(q, r, u);
+    assert(m_dir_interp_table);
+    return
+        trilinear_interpolation(
+            m_dir_interp_table + ((iz * TableSize + iy) * TableSize + ix) * 8,
+            s,
+            t,
+            u);
 }
 
 float AlbedoTable3D::get_average_albedo(const float eta, const float roughness) const
@@ -352,17 +491,9 @@ float AlbedoTable3D::get_average_albedo(const float eta, const float roughness)
     const float s = floor_frac(x, ix);
     const float t = floor_frac(y, iy);
 
-    const size_t ix1 = std::min(ix + 1, TableSize - 1);
-    const size_t iy1 = std::min(iy + 1, TableSize - 1);
-
-    // Fetch the values.
-    const float a = avg_table(ix , iy );
-    const float b = avg_table(ix1, iy );
-    const float c = avg_table(ix , iy1);
-    const float d = avg_table(ix1, iy1);
-
     // Bilinear interpolation.
-    return lerp(lerp(a, b, s), lerp(c, d, s), t);
+    assert(m_avg_interp_table);
+    return bilinear_interpolation(m_avg_interp_table + (iy * TableSize + ix) * 4, s, t);
 }
 
 float AlbedoTable3D::dir_table(const size_t x, const size_t y, const size_t z) const
@@ -69,6 +69,10 @@ class AlbedoTable2D
 
     size_t array_size() const;
 
+    // Build the interpolation table from the directional albedo table.
+    // Derived classes that compute the albedo table must call this method.
+    void build_interpolation_table();
+
     float dir_table(const size_t x , const size_t y) const;
     float avg_table(const size_t x) const;
 
@@ -78,6 +82,10 @@ class AlbedoTable2D
     float*          m_albedo_table;
     float*          m_avg_table;
     float*          m_data;
+
+    // Directional albedo table with the four values needed by each bilinear
+    // lookup stored contiguously, 16-byte aligned.
+    float*          m_interp_table;
 };
 
 
@@ -117,6 +125,10 @@ class AlbedoTable3D
 
     size_t array_size() const;
 
+    // Build the interpolation tables from the directional and average albedo tables.
+    // Derived classes that compute the albedo tables must call this method.
+    void build_interpolation_tables();
+
     float dir_table(const size_t x, const size_t y, const size_t z) const;
     float& dir_table(const size_t x, const size_t y, const size_t z);
 
@@ -129,6 +141,12 @@ class AlbedoTable3D
     float*          m_avg_table;
     float*          m_data;
 
+    // Directional and average albedo tables with the eight (resp. four) values
+    // needed by each trilinear (resp. bilinear) lookup stored contiguously,
+    // aligned so that each lookup touches a single cache line.
+    float*          m_dir_interp_table;
+    float*          m_avg_interp_table;
+
     const float     m_min_eta;
     const float     m_max_eta;
 };
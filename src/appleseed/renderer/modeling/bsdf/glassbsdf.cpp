@@ -823,6 +823,8 @@ namespace
                     avg_table(y, z) = average_albedo(TableSize, &dir_table(0, y, z));
                 }
             }
+
+            build_interpolation_tables();
         }
 
       private:
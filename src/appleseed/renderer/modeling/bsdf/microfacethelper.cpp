@@ -39,11 +39,14 @@
 #include "foundation/math/qmc.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
 
 // Boost headers.
 #include "boost/filesystem/path.hpp"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 
 using namespace foundation;
@@ -94,6 +97,8 @@ namespace
                 m_avg_table[i] = average_albedo(TableSize, p);
                 p += TableSize;
             }
+
+            build_interpolation_table();
         }
 
       private:
@@ -121,6 +126,8 @@ namespace
             const float     alpha,
             const size_t    sample_count)
         {
+            assert(sample_count % 4 == 0);
+
             // Special cases.
             if (cos_theta == 0.0f || alpha == 0.0f)
                 return 1.0f;
@@ -128,50 +135,61 @@ namespace
             // Build the outgoing vector.
             const float sin_theta = std::sqrt(1.0f - square(cos_theta));
             const Vector3f wo(sin_theta, cos_theta, 0.0f);
+            const Vector3f n(0.0f, 1.0f, 0.0f);
+
+            Vector3fx4 wo4;
+            for (size_t j = 0; j < 4; ++j)
+                wo4.set(j, wo);
 
             float R = 0.0f;
 
-            for (size_t i = 0; i < sample_count; ++i)
+            // Process samples four at a time using the vectorized MDF methods.
+            for (size_t i = 0; i < sample_count; i += 4)
             {
-                // Generate a uniform sample in [0,1)^3.
-                const size_t Bases[] = { 2 };
-                const Vector2f s = hammersley_sequence<float, 2>(Bases, sample_count, i);
-                R += sample<GGXMDF>(s, wo, alpha);
+                // Generate uniform samples in [0,1)^2.
+                Vector2fx4 s4;
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    const size_t Bases[] = { 2 };
+                    s4.set(j, hammersley_sequence<float, 2>(Bases, sample_count, i + j));
+                }
+
+                Vector3fx4 m4;
+                MDF::sample(wo4, s4, alpha, alpha, m4);
+
+                Vector3fx4 wi4;
+                bool valid[4];
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    Vector3f m = m4.get(j);
+                    const float cos_oh = std::abs(dot(wo, m));
+
+                    Vector3f wi = reflect(wo, m);
+
+                    if (BSDF::force_above_surface(wi, n))
+                    {
+                        m = normalize(wo + wi);
+                        m4.set(j, m);
+                    }
+
+                    wi4.set(j, wi);
+                    valid[j] = cos_oh != 0.0f && wi.y != 0.0f;
+                }
+
+                APPLESEED_SIMD4_ALIGN float G[4];
+                APPLESEED_SIMD4_ALIGN float G1[4];
+                MDF::G(wi4, wo4, m4, alpha, alpha, G);
+                MDF::G1(wo4, m4, alpha, alpha, G1);
+
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    if (valid[j])
+                        R += G[j] / G1[j];
+                }
             }
 
             return std::min(R / static_cast<float>(sample_count), 1.0f);
         }
-
-        template <typename MDF>
-        static float sample(
-            const Vector2f& s,
-            const Vector3f& wo,
-            const float     alpha)
-        {
-            Vector3f m = MDF::sample(wo, s, alpha);
-
-            const float cos_oh = std::abs(dot(wo, m));
-            const float cos_on = std::abs(wo.y);
-
-            if (cos_on == 0.0f || cos_oh == 0.0f)
-                return 0.0f;
-
-            const Vector3f n(0.0f, 1.0f, 0.0f);
-
-            Vector3f wi = reflect(wo, m);
-
-            if (BSDF::force_above_surface(wi, n))
-                m = normalize(wo + wi);
-
-            const float cos_in = std::abs(wi.y);
-
-            if (cos_in == 0.0f)
-                return 0.0f;
-
-            const float G = MDF::G(wi, wo, m, alpha);
-            const float G1 = MDF::G1(wo, m, alpha);
-            return G / G1;
-        }
     };
 
     struct AlbedoTables
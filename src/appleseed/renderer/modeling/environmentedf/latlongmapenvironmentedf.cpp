@@ -42,17 +42,21 @@
 #include "renderer/modeling/input/inputarray.h"
 #include "renderer/modeling/input/source.h"
 #include "renderer/modeling/input/sourceinputs.h"
+#include "renderer/modeling/input/texturesource.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/texture/texture.h"
 #include "renderer/utility/paramarray.h"
 #include "renderer/utility/transformsequence.h"
 
 // appleseed.foundation headers.
 #include "foundation/containers/dictionary.h"
 #include "foundation/image/color.h"
+#include "foundation/hash/murmurhash.h"
 #include "foundation/image/colorspace.h"
 #include "foundation/math/matrix.h"
-#include "foundation/math/sampling/imageimportancesampler.h"
+#include "foundation/math/sampling/aliasimageimportancesampler.h"
 #include "foundation/math/scalar.h"
 #include "foundation/math/transform.h"
 #include "foundation/math/vector.h"
@@ -62,19 +66,30 @@
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/searchpaths.h"
 #include "foundation/utility/stopwatch.h"
 
+// Boost headers.
+#include "boost/filesystem.hpp"
+
 // Standard headers.
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // Forward declarations.
 namespace renderer  { class OnFrameBeginRecorder; }
 namespace renderer  { class OnRenderBeginRecorder; }
 
 using namespace foundation;
+namespace bf = boost::filesystem;
 
 namespace renderer
 {
@@ -95,11 +110,16 @@ namespace
     //   http://www.cs.kuleuven.be/~graphics/index.php/environment-maps
     //
 
-    typedef ImageImportanceSampler<Color3f, float> ImageImportanceSamplerType;
+    typedef AliasImageImportanceSampler<float> ImageImportanceSamplerType;
+
+    // Bump this version whenever the computation of importance maps changes to invalidate cached files.
+    const char* ImportanceMapCacheVersion = "2";
 
     class ImageSampler
     {
       public:
+        typedef Color3f Payload;
+
         ImageSampler(
             TextureCache&   texture_cache,
             const Source*   radiance_source,
@@ -167,6 +187,7 @@ namespace
           , m_importance_map_width(0)
           , m_importance_map_height(0)
           , m_probability_scale(0.0f)
+          , m_importance_map_signature(0)
         {
             m_inputs.declare("radiance", InputFormat::SpectralIlluminance);
             m_inputs.declare("radiance_multiplier", InputFormat::Float, "1.0");
@@ -174,6 +195,12 @@ namespace
 
             m_phi_shift = deg_to_rad(m_params.get_optional<float>("horizontal_shift", 0.0f));
             m_theta_shift = deg_to_rad(m_params.get_optional<float>("vertical_shift", 0.0f));
+
+            m_cache_importance_map = m_params.get_optional<bool>("cache_importance_map", false);
+            m_importance_map_cache_directory =
+                m_params.get_optional<std::string>(
+                    "importance_map_cache_directory",
+                    LatLongMapEnvironmentEDFFactory::get_default_importance_map_cache_directory());
         }
 
         void release() override
@@ -203,7 +230,7 @@ namespace
 
             // Build importance map only if this environment EDF is the active one.
             if (project.get_scene()->get_environment()->get_uncached_environment_edf() == this)
-                build_importance_map(*project.get_scene(), abort_switch);
+                build_importance_map(project, abort_switch);
 
             return true;
         }
@@ -227,16 +254,14 @@ namespace
 
             // Sample the importance map.
             size_t x, y;
-            Color3f payload;
+            Vector2f offset;
             float prob_xy;
-            m_importance_sampler->sample(s, x, y, payload, prob_xy);
+            m_importance_sampler->sample(s, x, y, offset, prob_xy);
             assert(prob_xy >= 0.0f);
 
             // Compute the coordinates in [0,1)^2 of the sample.
-            const float jitter_x = frac(s[0] * m_importance_map_width);
-            const float jitter_y = frac(s[1] * m_importance_map_height);
-            const float u = (x + jitter_x) * m_rcp_importance_map_width;
-            const float v = (y + jitter_y) * m_rcp_importance_map_height;
+            const float u = (x + offset[0]) * m_rcp_importance_map_width;
+            const float v = (y + offset[1]) * m_rcp_importance_map_height;
             assert(u >= 0.0f && u < 1.0f);
             assert(v >= 0.0f && v < 1.0f);
 
@@ -259,7 +284,7 @@ namespace
             outgoing = transform.vector_to_parent(local_outgoing);
 
             // Return the emitted radiance.
-            value.set(payload, g_std_lighting_conditions, Spectrum::Illuminance);
+            lookup_environment_map(shading_context, u, v, value);
 
             // Compute the probability density of this direction.
             probability = prob_xy * m_probability_scale / sin_theta;
@@ -374,6 +399,9 @@ namespace
         float   m_phi_shift;                        // horizontal shift in radians
         float   m_theta_shift;                      // vertical shift in radians
 
+        bool        m_cache_importance_map;
+        std::string m_importance_map_cache_directory;
+
         size_t  m_importance_map_width;
         size_t  m_importance_map_height;
 
@@ -382,8 +410,9 @@ namespace
         float   m_probability_scale;
 
         std::unique_ptr<ImageImportanceSamplerType> m_importance_sampler;
+        std::uint64_t                               m_importance_map_signature;
 
-        void build_importance_map(const Scene& scene, IAbortSwitch* abort_switch)
+        void build_importance_map(const Project& project, IAbortSwitch* abort_switch)
         {
             Stopwatch<DefaultWallclockTimer> stopwatch;
             stopwatch.start();
@@ -391,6 +420,18 @@ namespace
             const Source* radiance_source = m_inputs.source("radiance");
             assert(radiance_source);
 
+            // Keep the current importance map if its inputs did not change since it was built.
+            const std::uint64_t signature = compute_importance_map_signature();
+            if (m_importance_sampler && signature == m_importance_map_signature)
+            {
+                RENDERER_LOG_DEBUG(
+                    "reusing importance map for environment edf \"%s\".",
+                    get_path().c_str());
+                return;
+            }
+
+            m_importance_map_signature = signature;
+
             const Source::Hints radiance_source_hints = radiance_source->get_hints();
             m_importance_map_width = radiance_source_hints.m_width;
             m_importance_map_height = radiance_source_hints.m_height;
@@ -401,7 +442,43 @@ namespace
             const size_t texel_count = m_importance_map_width * m_importance_map_height;
             m_probability_scale = texel_count / (2.0f * PiSquare<float>());
 
-            TextureStore texture_store(scene);
+            m_importance_sampler.reset(
+                new ImageImportanceSamplerType(
+                    m_importance_map_width,
+                    m_importance_map_height));
+
+            // Try to load the importance map from the cache.
+            bf::path cache_file_path;
+            if (m_cache_importance_map)
+            {
+                MurmurHash hash;
+                if (compute_importance_map_hash(project, hash))
+                {
+                    cache_file_path = bf::absolute(m_importance_map_cache_directory) / (hash.to_string() + ".impmap");
+
+                    if (read_importance_map(cache_file_path))
+                    {
+                        stopwatch.measure();
+
+                        RENDERER_LOG_INFO(
+                            "loaded importance map for environment edf \"%s\" from %s in %s.",
+                            get_path().c_str(),
+                            cache_file_path.string().c_str(),
+                            pretty_time(stopwatch.get_seconds()).c_str());
+
+                        return;
+                    }
+                }
+                else
+                {
+                    RENDERER_LOG_DEBUG(
+                        "importance map for environment edf \"%s\" cannot be cached because its radiance "
+                        "is not a texture file or its radiance multiplier is not uniform.",
+                        get_path().c_str());
+                }
+            }
+
+            TextureStore texture_store(*project.get_scene());
             TextureCache texture_cache(texture_store);
             ImageSampler sampler(
                 texture_cache,
@@ -411,11 +488,6 @@ namespace
                 m_importance_map_width,
                 m_importance_map_height);
 
-            m_importance_sampler.reset(
-                new ImageImportanceSamplerType(
-                    m_importance_map_width,
-                    m_importance_map_height));
-
             RENDERER_LOG_INFO(
                 "building " FMT_SIZE_T "x" FMT_SIZE_T " importance map "
                 "for environment edf \"%s\"...",
@@ -426,7 +498,7 @@ namespace
             m_importance_sampler->rebuild(sampler, abort_switch);
 
             if (is_aborted(abort_switch))
-                m_importance_sampler.reset();
+                m_importance_sampler.reset();   // also invalidates m_importance_map_signature
             else
             {
                 stopwatch.measure();
@@ -435,7 +507,124 @@ namespace
                     "built importance map for environment edf \"%s\" in %s.",
                     get_path().c_str(),
                     pretty_time(stopwatch.get_seconds()).c_str());
+
+                if (!cache_file_path.empty())
+                    write_importance_map(cache_file_path);
+            }
+        }
+
+        // Compute a signature of the inputs of the importance map, valid for the lifetime of this entity.
+        std::uint64_t compute_importance_map_signature() const
+        {
+            MurmurHash hash;
+            hash.append(m_inputs.source("radiance")->compute_signature());
+            hash.append(m_inputs.source("radiance_multiplier")->compute_signature());
+            hash.append(m_exposure_multiplier);
+            return hash.h1();
+        }
+
+        // Compute a hash of everything that affects the importance map. Return false if the
+        // importance map depends on inputs that cannot be hashed and thus cannot be cached.
+        bool compute_importance_map_hash(const Project& project, MurmurHash& hash) const
+        {
+            const TextureSource* radiance_source =
+                dynamic_cast<const TextureSource*>(m_inputs.source("radiance"));
+            if (radiance_source == nullptr)
+                return false;
+
+            const Source* multiplier_source = m_inputs.source("radiance_multiplier");
+            if (!multiplier_source->is_uniform())
+                return false;
+
+            hash.append(ImportanceMapCacheVersion);
+
+            const TextureInstance& texture_instance = radiance_source->get_texture_instance();
+            const Texture& texture = texture_instance.get_texture();
+
+            StringArray paths;
+            texture.collect_asset_paths(paths);
+
+            if (paths.empty())
+                return false;
+
+            for (const std::string& path : array_vector<std::vector<std::string>>(paths))
+            {
+                const std::string qualified_path = to_string(project.search_paths().qualify(path));
+                if (!hash_file_contents(qualified_path, hash))
+                    return false;
             }
+
+            hash.append(static_cast<int>(texture.get_color_space()));
+            hash.append(static_cast<int>(texture_instance.get_addressing_mode()));
+            hash.append(static_cast<int>(texture_instance.get_filtering_mode()));
+            hash.append(texture_instance.get_transform().get_local_to_parent());
+
+            float multiplier;
+            multiplier_source->evaluate_uniform(multiplier);
+            hash.append(multiplier);
+            hash.append(m_exposure_multiplier);
+
+            hash.append(static_cast<std::uint64_t>(m_importance_map_width));
+            hash.append(static_cast<std::uint64_t>(m_importance_map_height));
+
+            return true;
+        }
+
+        bool read_importance_map(const bf::path& file_path)
+        {
+            std::ifstream file(file_path.string().c_str(), std::ios::in | std::ios::binary);
+
+            if (!file.is_open())
+                return false;
+
+            if (!m_importance_sampler->read(file))
+            {
+                RENDERER_LOG_WARNING(
+                    "ignoring invalid importance map cache file %s.",
+                    file_path.string().c_str());
+                return false;
+            }
+
+            return true;
+        }
+
+        void write_importance_map(const bf::path& file_path) const
+        {
+            // Write to a temporary file first so that an interrupted write
+            // never leaves a truncated file in the cache.
+            bf::path temp_path = file_path;
+            temp_path += ".tmp";
+
+            try
+            {
+                bf::create_directories(file_path.parent_path());
+
+                {
+                    std::ofstream file(temp_path.string().c_str(), std::ios::out | std::ios::binary);
+                    m_importance_sampler->write(file);
+                    file.close();
+
+                    if (!file)
+                        throw std::runtime_error("i/o error");
+                }
+
+                bf::rename(temp_path, file_path);
+            }
+            catch (const std::exception& e)     // namespace qualification required
+            {
+                RENDERER_LOG_WARNING(
+                    "failed to write importance map cache file %s: %s.",
+                    file_path.string().c_str(),
+                    e.what());
+
+                boost::system::error_code ec;
+                bf::remove(temp_path, ec);
+                return;
+            }
+
+            RENDERER_LOG_DEBUG(
+                "wrote importance map cache file %s.",
+                file_path.string().c_str());
         }
 
         void lookup_environment_map(
@@ -584,11 +773,34 @@ DictionaryArray LatLongMapEnvironmentEDFFactory::get_input_metadata() const
             .insert("use", "optional")
             .insert("help", "Environment texture vertical shift in degrees"));
 
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "cache_importance_map")
+            .insert("label", "Cache Importance Map")
+            .insert("type", "boolean")
+            .insert("use", "optional")
+            .insert("default", "false")
+            .insert("help", "Cache the importance map on disk and reuse it across renders"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "importance_map_cache_directory")
+            .insert("label", "Importance Map Cache Directory")
+            .insert("type", "text")
+            .insert("use", "optional")
+            .insert("default", get_default_importance_map_cache_directory())
+            .insert("help", "Directory where importance maps are cached"));
+
     add_common_input_metadata(metadata);
 
     return metadata;
 }
 
+std::string LatLongMapEnvironmentEDFFactory::get_default_importance_map_cache_directory()
+{
+    return (bf::temp_directory_path() / "appleseed" / "importance_maps").string();
+}
+
 auto_release_ptr<EnvironmentEDF> LatLongMapEnvironmentEDFFactory::create(
     const char*         name,
     const ParamArray&   params) const
@@ -39,6 +39,9 @@
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Standard headers.
+#include <string>
+
 // Forward declarations.
 namespace foundation    { class Dictionary; }
 namespace foundation    { class DictionaryArray; }
@@ -72,6 +75,9 @@ class APPLESEED_DLLSYMBOL LatLongMapEnvironmentEDFFactory
     foundation::auto_release_ptr<EnvironmentEDF> create(
         const char*         name,
         const ParamArray&   params) const override;
+
+    // Return the default directory where importance maps are cached.
+    static std::string get_default_importance_map_cache_directory();
 };
 
 }   // namespace renderer
@@ -41,15 +41,18 @@
 #include "renderer/modeling/aov/aovfactoryregistrar.h"
 #include "renderer/modeling/aov/denoiseraov.h"
 #include "renderer/modeling/aov/iaovfactory.h"
+#include "renderer/modeling/frame/incrementalcheckpoint.h"
 #include "renderer/modeling/postprocessingstage/postprocessingstage.h"
 #include "renderer/utility/bbox.h"
 #include "renderer/utility/filesystem.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
 #include "foundation/containers/dictionary.h"
 #include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/image/analysis.h"
+#include "foundation/image/canvasproperties.h"
 #include "foundation/image/color.h"
 #include "foundation/image/conversion.h"
 #include "foundation/image/genericimagefilereader.h"
@@ -124,6 +127,7 @@ struct Frame::Impl
     bool                                 m_checkpoint_resume;
     std::string                          m_checkpoint_resume_path;
     std::string                          m_ref_image_path;
+    bool                                 m_half_precision_aovs;
 
     // Child entities.
     AOVContainer                         m_aovs;
@@ -136,11 +140,18 @@ struct Frame::Impl
     std::unique_ptr<Image>               m_ref_image;
     std::unique_ptr<ImageStack>          m_aov_images;
 
+    // Name and size under which the images are reported to the global memory tracker.
+    std::string                          m_memory_owner;
+    size_t                               m_memory_size;
+
     // Internal state.
     std::unique_ptr<FilterSamplingTable> m_filter_sampling_table;
     ParamArray                           m_render_info;
     size_t                               m_initial_pass = 0;
 
+    // Incremental checkpoint being written, if any.
+    std::unique_ptr<IncrementalCheckpoint> m_incremental_checkpoint;
+
     explicit Impl(Frame* parent)
       : m_aovs(parent)
       , m_internal_aovs(parent)
@@ -253,10 +264,29 @@ Frame::Frame(
         impl->m_internal_aovs.insert(auto_release_ptr<AOV>(aov));
     }
     else impl->m_denoiser_aov = nullptr;
+
+    // Attribute the memory used by the main and AOV images to this frame.
+    // Memory is added rather than set since frames with the same name may coexist.
+    impl->m_memory_owner = get_path().c_str();
+    impl->m_memory_size = m_props.m_pixel_count * m_props.m_pixel_size;
+    for (size_t i = 0, e = impl->m_aov_images->size(); i < e; ++i)
+    {
+        const CanvasProperties& aov_props = impl->m_aov_images->get_image(i).properties();
+        impl->m_memory_size += aov_props.m_pixel_count * aov_props.m_pixel_size;
+    }
+    global_memory_tracker().add(
+        MemoryTracker::CategoryFrameBuffer,
+        impl->m_memory_owner.c_str(),
+        impl->m_memory_size);
 }
 
 Frame::~Frame()
 {
+    global_memory_tracker().subtract(
+        MemoryTracker::CategoryFrameBuffer,
+        impl->m_memory_owner.c_str(),
+        impl->m_memory_size);
+
     delete impl;
 }
 
@@ -282,7 +312,8 @@ void Frame::print_settings()
         "  denoising mode                %s\n"
         "  create checkpoint             %s\n"
         "  resume checkpoint             %s\n"
-        "  reference image path          %s",
+        "  reference image path          %s\n"
+        "  aov precision                 %s",
         get_path().c_str(),
         get_uid(),
         camera_name != nullptr ? camera_name : "none",
@@ -302,7 +333,8 @@ void Frame::print_settings()
         impl->m_denoising_mode == DenoisingMode::WriteOutputs ? "write outputs" : "denoise",
         impl->m_checkpoint_create ? impl->m_checkpoint_create_path.c_str() : "off",
         impl->m_checkpoint_resume ? impl->m_checkpoint_resume_path.c_str() : "off",
-        impl->m_ref_image_path.empty() ? "n/a" : impl->m_ref_image_path.c_str());
+        impl->m_ref_image_path.empty() ? "n/a" : impl->m_ref_image_path.c_str(),
+        impl->m_half_precision_aovs ? "half" : "float");
 }
 
 const AOVContainer& Frame::aovs() const
@@ -401,6 +433,11 @@ std::uint32_t Frame::get_noise_seed() const
     return impl->m_noise_seed;
 }
 
+bool Frame::has_half_precision_aovs() const
+{
+    return impl->m_half_precision_aovs;
+}
+
 void Frame::collect_asset_paths(StringArray& paths) const
 {
     for (const AOV& aov : impl->m_aovs)
@@ -531,14 +568,20 @@ void Frame::denoise(
 
 namespace
 {
-    size_t get_checkpoint_total_channel_count(const size_t aov_count)
+    size_t get_checkpoint_total_channel_count(const Frame& frame)
     {
-        // The beauty image plus the shading result framebuffer.
-        return ShadingResultFrameBuffer::get_total_channel_count(aov_count) + 1;
+        // The weight channel plus the channels of the shading result framebuffer.
+        return ShadingResultFrameBuffer::Layout(frame).get_float_channel_count() + 1;
     }
 
     typedef std::vector<std::tuple<std::string, CanvasProperties, ImageAttributes>> CheckpointProperties;
 
+    // Checkpoints with the .ckpt extension are written incrementally, tile by tile.
+    bool is_incremental_checkpoint_path(const std::string& path)
+    {
+        return lower_case(bf::path(path).extension().string()) == ".ckpt";
+    }
+
 
     //
     // Interface used to save the rendering buffer in checkpoints.
@@ -558,7 +601,7 @@ namespace
                 m_frame.image().properties().m_canvas_height,
                 m_frame.image().properties().m_tile_width,
                 m_frame.image().properties().m_tile_height,
-                get_checkpoint_total_channel_count(m_frame.aov_images().size()),
+                get_checkpoint_total_channel_count(m_frame),
                 PixelFormatFloat)
         {
             assert(buffer_factory);
@@ -634,7 +677,10 @@ namespace
         const bf::path boost_file_path(checkpoint_path);
         const bf::path directory = boost_file_path.parent_path();
         const std::string base_file_name = boost_file_path.stem().string() + ".denoiser";
-        const std::string extension = boost_file_path.extension().string();
+        const std::string extension =
+            is_incremental_checkpoint_path(checkpoint_path)
+                ? ".exr"
+                : boost_file_path.extension().string();
 
         const std::string hist_file_name = base_file_name + ".hist" + extension;
         hist_path = (directory / hist_file_name).string();
@@ -681,7 +727,7 @@ namespace
 
         // Check that the shading buffer layer has correct amount of channel.
         // The checkpoint should contain the beauty image and the shading buffer.
-        const size_t expect_channel_count = get_checkpoint_total_channel_count(frame.aov_images().size());
+        const size_t expect_channel_count = get_checkpoint_total_channel_count(frame);
         if (std::get<1>(checkpoint_props[1]).m_channel_count != expect_channel_count)
         {
             RENDERER_LOG_ERROR("incorrect checkpoint: the shading buffer doesn't contain the correct number of channels.");
@@ -780,6 +826,25 @@ namespace
         if (!result)
             RENDERER_LOG_ERROR("could not save denoiser checkpoint.");
     }
+
+    // Return the layers stored in incremental checkpoints: the shading buffer
+    // followed by the unfiltered AOVs. The beauty image and the filtered AOVs
+    // are rebuilt from the shading buffer and don't need to be stored.
+    std::vector<ICanvas*> get_incremental_checkpoint_layers(
+        const Frame&                    frame,
+        ShadingBufferCanvas&            shading_canvas)
+    {
+        std::vector<ICanvas*> layers;
+        layers.push_back(&shading_canvas);
+
+        for (const AOV& aov : frame.aovs())
+        {
+            if (dynamic_cast<const UnfilteredAOV*>(&aov) != nullptr)
+                layers.push_back(&aov.get_image());
+        }
+
+        return layers;
+    }
 }
 
 bool Frame::load_checkpoint(
@@ -789,6 +854,56 @@ bool Frame::load_checkpoint(
     if  (!impl->m_checkpoint_resume)
         return true;
 
+    if (is_incremental_checkpoint_path(impl->m_checkpoint_resume_path))
+    {
+        // Keep the checkpoint around if we're going to extend it.
+        std::unique_ptr<IncrementalCheckpoint> checkpoint(
+            new IncrementalCheckpoint(impl->m_checkpoint_resume_path));
+
+        if (!checkpoint->exists())
+        {
+            RENDERER_LOG_WARNING("no checkpoint found, starting a new render.");
+            return true;
+        }
+
+        ShadingBufferCanvas shading_canvas(*this, buffer_factory);
+        size_t last_pass;
+        if (!checkpoint->load(get_incremental_checkpoint_layers(*this, shading_canvas), last_pass))
+        {
+            RENDERER_LOG_ERROR(
+                "failed to load checkpoint %s.",
+                impl->m_checkpoint_resume_path.c_str());
+            return false;
+        }
+
+        const size_t start_pass = last_pass + 1;
+
+        if (start_pass < pass_count)
+        {
+            for (size_t i = 0, e = internal_aovs().size(); i < e; ++i)
+            {
+                DenoiserAOV* denoiser_aov = dynamic_cast<DenoiserAOV*>(internal_aovs().get_by_index(i));
+                if (denoiser_aov != nullptr)
+                {
+                    if (!load_denoiser_checkpoint(impl->m_checkpoint_resume_path, denoiser_aov))
+                        return false;
+                }
+            }
+        }
+
+        if (impl->m_checkpoint_create && impl->m_checkpoint_create_path == impl->m_checkpoint_resume_path)
+            impl->m_incremental_checkpoint = std::move(checkpoint);
+
+        RENDERER_LOG_INFO(
+            "successfully read checkpoint %s, resuming rendering at pass %s.",
+            impl->m_checkpoint_resume_path.c_str(),
+            pretty_uint(start_pass + 1).c_str());
+
+        impl->m_initial_pass = start_pass;
+
+        return true;
+    }
+
     bf::path bf_path(impl->m_checkpoint_resume_path.c_str());
 
     // Check if the file exists.
@@ -928,6 +1043,37 @@ void Frame::save_checkpoint(
     if (!impl->m_checkpoint_create)
         return;
 
+    if (is_incremental_checkpoint_path(impl->m_checkpoint_create_path))
+    {
+        if (!impl->m_incremental_checkpoint)
+            impl->m_incremental_checkpoint.reset(new IncrementalCheckpoint(impl->m_checkpoint_create_path));
+
+        // Only the tiles that changed since the last pass are written, in the background.
+        ShadingBufferCanvas shading_canvas(*this, buffer_factory);
+        const std::vector<ICanvas*> layers = get_incremental_checkpoint_layers(*this, shading_canvas);
+        const size_t changed_tile_count =
+            impl->m_incremental_checkpoint->save(
+                std::vector<const ICanvas*>(layers.begin(), layers.end()),
+                pass_index);
+
+        // todo: write denoiser checkpoints incrementally too.
+        for (const AOV& aov : internal_aovs())
+        {
+            const DenoiserAOV* denoiser_aov = dynamic_cast<const DenoiserAOV*>(&aov);
+            if (denoiser_aov != nullptr)
+                save_denoiser_checkpoint(impl->m_checkpoint_create_path, denoiser_aov);
+        }
+
+        RENDERER_LOG_INFO(
+            "writing pass %s to checkpoint %s (%s changed %s).",
+            pretty_uint(pass_index + 1).c_str(),
+            impl->m_checkpoint_create_path.c_str(),
+            pretty_uint(changed_tile_count).c_str(),
+            plural(changed_tile_count, "tile").c_str());
+
+        return;
+    }
+
     create_parent_directories(impl->m_checkpoint_create_path.c_str());
 
     GenericImageFileWriter writer(impl->m_checkpoint_create_path.c_str());
@@ -1436,10 +1582,10 @@ void Frame::extract_parameters()
 
             const std::string extension = lower_case(bf_path.extension().string());
 
-            if (extension != ".exr")
+            if (extension != ".exr" && extension != ".ckpt")
             {
-                // Only .exr files are allowed.
-                RENDERER_LOG_ERROR("checkpoint file must be an \".exr\" file, disabling checkpoint creation.");
+                // Only .exr and .ckpt files are allowed.
+                RENDERER_LOG_ERROR("checkpoint file must be an \".exr\" or \".ckpt\" file, disabling checkpoint creation.");
                 impl->m_checkpoint_create = false;
             }
             else
@@ -1472,10 +1618,10 @@ void Frame::extract_parameters()
 
             const std::string extension = lower_case(bf_path.extension().string());
 
-            if (extension != ".exr")
+            if (extension != ".exr" && extension != ".ckpt")
             {
-                // Only .exr files are allowed.
-                RENDERER_LOG_ERROR("checkpoint file must be an \".exr\" file, disabling checkpoint resuming.");
+                // Only .exr and .ckpt files are allowed.
+                RENDERER_LOG_ERROR("checkpoint file must be an \".exr\" or \".ckpt\" file, disabling checkpoint resuming.");
                 impl->m_checkpoint_resume = false;
             }
             else
@@ -1495,6 +1641,32 @@ void Frame::extract_parameters()
 
     // Retrieve reference image path parameters.
     impl->m_ref_image_path = m_params.get_optional<std::string>("reference_image", "");
+
+    // Retrieve AOV precision parameter.
+    {
+        const std::string aov_precision = m_params.get_optional<std::string>("aov_precision", "float");
+
+        if (aov_precision == "float")
+            impl->m_half_precision_aovs = false;
+        else if (aov_precision == "half")
+            impl->m_half_precision_aovs = true;
+        else
+        {
+            RENDERER_LOG_ERROR(
+                "invalid value \"%s\" for parameter \"%s\", using default value \"%s\".",
+                aov_precision.c_str(),
+                "aov_precision",
+                "float");
+            impl->m_half_precision_aovs = false;
+        }
+
+        // Checkpoints store the shading result framebuffers as float images.
+        if (impl->m_half_precision_aovs && (impl->m_checkpoint_create || impl->m_checkpoint_resume))
+        {
+            RENDERER_LOG_WARNING("half precision aovs are not supported with checkpoints, using float precision.");
+            impl->m_half_precision_aovs = false;
+        }
+    }
 }
 
 AOVContainer& Frame::internal_aovs() const
@@ -1579,6 +1751,18 @@ DictionaryArray FrameFactory::get_input_metadata()
             .insert("use", "optional")
             .insert("default", "0"));
 
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "aov_precision")
+            .insert("label", "AOV Precision")
+            .insert("type", "enumeration")
+            .insert("items",
+                Dictionary()
+                    .insert("Float", "float")
+                    .insert("Half", "half"))
+            .insert("use", "optional")
+            .insert("default", "float"));
+
     metadata.push_back(
         Dictionary()
             .insert("name", "enable_dithering")
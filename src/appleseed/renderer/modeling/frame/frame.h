@@ -131,6 +131,9 @@ class APPLESEED_DLLSYMBOL Frame
     // Get the noise seed.
     std::uint32_t get_noise_seed() const;
 
+    // Return true if filtered AOVs are accumulated in half precision.
+    bool has_half_precision_aovs() const;
+
     // Expose asset file paths referenced by this entity to the outside.
     void collect_asset_paths(foundation::StringArray& paths) const override;
     void update_asset_paths(const foundation::StringDictionary& mappings) override;
@@ -0,0 +1,745 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "incrementalcheckpoint.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/icanvas.h"
+#include "foundation/image/tile.h"
+#include "foundation/string/string.h"
+#include "foundation/utility/bufferedfile.h"
+
+// LZ4 headers.
+#include <lz4.h>
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+#include "boost/thread/thread.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <utility>
+
+using namespace foundation;
+namespace bf = boost::filesystem;
+
+namespace renderer
+{
+
+namespace
+{
+    //
+    // Segment file format (all integers in native byte order):
+    //
+    //   char[8]        magic ("ASCKPT" followed by two zero bytes)
+    //   uint32         format version
+    //   uint32         pass index
+    //   uint32         layer count
+    //   per layer:     uint32 canvas width, canvas height, tile width, tile height,
+    //                  channel count, channel size
+    //   per tile:      uint32 layer index, tile x, tile y, raw size, compressed size
+    //                  uint64 hash of the raw tile bytes
+    //                  compressed bytes
+    //   uint32         end of records marker (~0)
+    //   uint32         record count
+    //
+
+    const char SegmentMagic[8] = { 'A', 'S', 'C', 'K', 'P', 'T', '\0', '\0' };
+    const std::uint32_t SegmentVersion = 1;
+    const std::uint32_t EndOfRecords = ~std::uint32_t(0);
+    const size_t NoSegment = ~size_t(0);
+
+    struct LayerHeader
+    {
+        std::uint32_t   m_canvas_width;
+        std::uint32_t   m_canvas_height;
+        std::uint32_t   m_tile_width;
+        std::uint32_t   m_tile_height;
+        std::uint32_t   m_channel_count;
+        std::uint32_t   m_channel_size;
+
+        explicit LayerHeader(const CanvasProperties& props)
+          : m_canvas_width(static_cast<std::uint32_t>(props.m_canvas_width))
+          , m_canvas_height(static_cast<std::uint32_t>(props.m_canvas_height))
+          , m_tile_width(static_cast<std::uint32_t>(props.m_tile_width))
+          , m_tile_height(static_cast<std::uint32_t>(props.m_tile_height))
+          , m_channel_count(static_cast<std::uint32_t>(props.m_channel_count))
+          , m_channel_size(static_cast<std::uint32_t>(props.m_channel_size))
+        {
+        }
+
+        bool operator==(const LayerHeader& rhs) const
+        {
+            return
+                m_canvas_width == rhs.m_canvas_width &&
+                m_canvas_height == rhs.m_canvas_height &&
+                m_tile_width == rhs.m_tile_width &&
+                m_tile_height == rhs.m_tile_height &&
+                m_channel_count == rhs.m_channel_count &&
+                m_channel_size == rhs.m_channel_size;
+        }
+    };
+
+    struct TileRecord
+    {
+        std::uint32_t               m_layer;
+        std::uint32_t               m_tile_x;
+        std::uint32_t               m_tile_y;
+        std::uint64_t               m_hash;
+        std::vector<std::uint8_t>   m_bytes;
+    };
+
+    struct Segment
+    {
+        size_t                      m_pass_index;
+        std::vector<LayerHeader>    m_layers;
+        std::vector<TileRecord>     m_records;
+        std::vector<size_t>         m_obsolete_passes;  // segments to delete once this one is complete
+        bool                        m_replace_all;      // delete all other segments when committing this one
+    };
+
+    // Fast, non-cryptographic hash only used to detect tiles that changed.
+    std::uint64_t hash_bytes(const std::uint8_t* bytes, const size_t size)
+    {
+        std::uint64_t h = 0xCBF29CE484222325ull ^ size;
+
+        size_t i = 0;
+
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 32;
+        }
+
+        for (; i < size; ++i)
+        {
+            h = (h ^ bytes[i]) * 0x100000001B3ull;
+            h ^= h >> 32;
+        }
+
+        return h;
+    }
+
+    // Group the bytes of same significance together: exponent and high mantissa
+    // bytes of neighboring floats are very similar and compress much better.
+    void shuffle_bytes(
+        const std::uint8_t*         src,
+        std::uint8_t*               dst,
+        const size_t                size,
+        const size_t                element_size)
+    {
+        const size_t element_count = size / element_size;
+
+        for (size_t k = 0; k < element_size; ++k)
+        {
+            std::uint8_t* plane = dst + k * element_count;
+            for (size_t i = 0; i < element_count; ++i)
+                plane[i] = src[i * element_size + k];
+        }
+
+        const size_t tail = element_count * element_size;
+        std::memcpy(dst + tail, src + tail, size - tail);
+    }
+
+    void unshuffle_bytes(
+        const std::uint8_t*         src,
+        std::uint8_t*               dst,
+        const size_t                size,
+        const size_t                element_size)
+    {
+        const size_t element_count = size / element_size;
+
+        for (size_t k = 0; k < element_size; ++k)
+        {
+            const std::uint8_t* plane = src + k * element_count;
+            for (size_t i = 0; i < element_count; ++i)
+                dst[i * element_size + k] = plane[i];
+        }
+
+        const size_t tail = element_count * element_size;
+        std::memcpy(dst + tail, src + tail, size - tail);
+    }
+}
+
+struct IncrementalCheckpoint::Impl
+{
+    struct TileState
+    {
+        std::uint64_t   m_hash;
+        size_t          m_segment;                      // pass index of the segment holding the tile
+    };
+
+    bf::path                                m_directory;
+    std::string                             m_stem;
+
+    std::vector<std::vector<TileState>>     m_tiles;    // per layer, per tile
+    std::map<size_t, size_t>                m_segments; // pass index -> number of live tiles
+    bool                                    m_rewrite;  // next segment must contain all tiles
+
+    std::unique_ptr<Segment>                m_pending;
+    std::unique_ptr<boost::thread>          m_writer_thread;
+    std::atomic<bool>                       m_write_failed;
+
+    explicit Impl(const std::string& path)
+      : m_rewrite(true)
+      , m_write_failed(false)
+    {
+        const bf::path bf_path(path);
+        m_directory = bf_path.parent_path();
+        m_stem = bf_path.stem().string();
+    }
+
+    bf::path get_segment_path(const size_t pass_index) const
+    {
+        return m_directory / (m_stem + "." + pad_left(to_string(pass_index), '0', 5) + ".ckpt");
+    }
+
+    // Return the segments found on disk, sorted by pass index.
+    std::vector<std::pair<size_t, bf::path>> list_segments() const
+    {
+        std::vector<std::pair<size_t, bf::path>> segments;
+
+        const bf::path directory = m_directory.empty() ? bf::path(".") : m_directory;
+        boost::system::error_code ec;
+        if (!bf::is_directory(directory, ec))
+            return segments;
+
+        const std::string prefix = m_stem + ".";
+        const std::string suffix = ".ckpt";
+
+        for (bf::directory_iterator i(directory, ec), e; !ec && i != e; i.increment(ec))
+        {
+            const std::string filename = i->path().filename().string();
+
+            if (filename.size() <= prefix.size() + suffix.size() ||
+                !starts_with(filename, prefix) ||
+                !ends_with(filename, suffix))
+                continue;
+
+            const std::string digits =
+                filename.substr(prefix.size(), filename.size() - prefix.size() - suffix.size());
+
+            if (!std::all_of(digits.begin(), digits.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+                continue;
+
+            segments.emplace_back(from_string<size_t>(digits), i->path());
+        }
+
+        std::sort(
+            segments.begin(),
+            segments.end(),
+            [](const std::pair<size_t, bf::path>& lhs, const std::pair<size_t, bf::path>& rhs)
+            {
+                return lhs.first < rhs.first;
+            });
+
+        return segments;
+    }
+
+    void reset(const std::vector<LayerHeader>& layers)
+    {
+        m_tiles.clear();
+        m_tiles.resize(layers.size());
+
+        for (size_t i = 0, e = layers.size(); i < e; ++i)
+        {
+            const LayerHeader& layer = layers[i];
+            const size_t tile_count_x = (layer.m_canvas_width + layer.m_tile_width - 1) / layer.m_tile_width;
+            const size_t tile_count_y = (layer.m_canvas_height + layer.m_tile_height - 1) / layer.m_tile_height;
+            m_tiles[i].assign(tile_count_x * tile_count_y, TileState{ 0, NoSegment });
+        }
+
+        m_segments.clear();
+        m_rewrite = true;
+    }
+
+    void write_pending_segment()
+    {
+        const Segment& segment = *m_pending;
+        const bf::path segment_path = get_segment_path(segment.m_pass_index);
+        const bf::path temp_path = segment_path.string() + ".tmp";
+
+        try
+        {
+            create_parent_directories(segment_path);
+            write_segment(segment, temp_path);
+
+            // Segments of later passes belong to an older chain and must not be
+            // replayed on top of this one.
+            if (segment.m_replace_all)
+            {
+                for (const auto& s : list_segments())
+                {
+                    if (s.first > segment.m_pass_index)
+                        bf::remove(s.second);
+                }
+            }
+
+            // Commit the segment.
+            bf::rename(temp_path, segment_path);
+        }
+        catch (const std::exception& e)
+        {
+            RENDERER_LOG_ERROR(
+                "failed to write checkpoint segment %s: %s",
+                segment_path.string().c_str(),
+                e.what());
+
+            boost::system::error_code ec;
+            bf::remove(temp_path, ec);
+
+            m_write_failed = true;
+            return;
+        }
+
+        // Delete the segments whose tiles have all been superseded. Until then,
+        // earlier segments are harmless: replaying them before this one has no effect.
+        if (segment.m_replace_all)
+        {
+            for (const auto& s : list_segments())
+            {
+                if (s.first != segment.m_pass_index)
+                {
+                    boost::system::error_code ec;
+                    bf::remove(s.second, ec);
+                }
+            }
+        }
+        else
+        {
+            for (const size_t pass_index : segment.m_obsolete_passes)
+            {
+                boost::system::error_code ec;
+                bf::remove(get_segment_path(pass_index), ec);
+            }
+        }
+
+        RENDERER_LOG_DEBUG(
+            "wrote %s %s to checkpoint segment %s.",
+            pretty_uint(segment.m_records.size()).c_str(),
+            plural(segment.m_records.size(), "tile").c_str(),
+            segment_path.string().c_str());
+    }
+
+    static void create_parent_directories(const bf::path& path)
+    {
+        const bf::path parent = path.parent_path();
+        if (!parent.empty())
+            bf::create_directories(parent);
+    }
+
+    static void write_segment(const Segment& segment, const bf::path& path)
+    {
+        BufferedFile file(
+            path.string().c_str(),
+            BufferedFile::BinaryType,
+            BufferedFile::WriteMode);
+
+        if (!file.is_open())
+            throw ExceptionIOError();
+
+        checked_write(file, SegmentMagic, sizeof(SegmentMagic));
+        checked_write(file, SegmentVersion);
+        checked_write(file, static_cast<std::uint32_t>(segment.m_pass_index));
+        checked_write(file, static_cast<std::uint32_t>(segment.m_layers.size()));
+
+        for (const LayerHeader& layer : segment.m_layers)
+            checked_write(file, layer);
+
+        std::vector<std::uint8_t> shuffled;
+        std::vector<std::uint8_t> compressed;
+
+        for (const TileRecord& record : segment.m_records)
+        {
+            const size_t raw_size = record.m_bytes.size();
+
+            shuffled.resize(raw_size);
+            shuffle_bytes(
+                record.m_bytes.data(),
+                shuffled.data(),
+                raw_size,
+                segment.m_layers[record.m_layer].m_channel_size);
+
+            compressed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(raw_size))));
+            const int compressed_size =
+                LZ4_compress_default(
+                    reinterpret_cast<const char*>(shuffled.data()),
+                    reinterpret_cast<char*>(compressed.data()),
+                    static_cast<int>(raw_size),
+                    static_cast<int>(compressed.size()));
+
+            if (compressed_size <= 0)
+                throw ExceptionIOError("tile compression failed");
+
+            checked_write(file, record.m_layer);
+            checked_write(file, record.m_tile_x);
+            checked_write(file, record.m_tile_y);
+            checked_write(file, static_cast<std::uint32_t>(raw_size));
+            checked_write(file, static_cast<std::uint32_t>(compressed_size));
+            checked_write(file, record.m_hash);
+            checked_write(file, compressed.data(), static_cast<size_t>(compressed_size));
+        }
+
+        checked_write(file, EndOfRecords);
+        checked_write(file, static_cast<std::uint32_t>(segment.m_records.size()));
+
+        if (!file.close())
+            throw ExceptionIOError();
+    }
+
+    // Read a segment and apply it: its tiles are copied to the layers and the
+    // tile states are updated. Every tile is decompressed once and checked
+    // against its hash; tiles are staged until the whole segment is validated
+    // so that a damaged segment leaves the layers untouched.
+    // Return false if the segment is damaged or incompatible with the layers.
+    bool read_segment(
+        const bf::path&                         path,
+        const size_t                            pass_index,
+        const std::vector<LayerHeader>&         expected_layers,
+        const std::vector<ICanvas*>&            layers)
+    {
+        try
+        {
+            BufferedFile file(
+                path.string().c_str(),
+                BufferedFile::BinaryType,
+                BufferedFile::ReadMode);
+
+            if (!file.is_open())
+                return false;
+
+            char magic[sizeof(SegmentMagic)];
+            checked_read(file, magic, sizeof(magic));
+            if (std::memcmp(magic, SegmentMagic, sizeof(SegmentMagic)) != 0)
+                return false;
+
+            std::uint32_t version, segment_pass_index, layer_count;
+            checked_read(file, version);
+            checked_read(file, segment_pass_index);
+            checked_read(file, layer_count);
+
+            if (version != SegmentVersion ||
+                segment_pass_index != pass_index ||
+                layer_count != expected_layers.size())
+                return false;
+
+            for (const LayerHeader& expected_layer : expected_layers)
+            {
+                LayerHeader layer = expected_layer;
+                checked_read(file, layer);
+                if (!(layer == expected_layer))
+                    return false;
+            }
+
+            std::vector<std::uint8_t> compressed;
+            std::vector<std::uint8_t> shuffled;
+            std::vector<TileRecord> records;
+
+            while (true)
+            {
+                std::uint32_t layer_index;
+                checked_read(file, layer_index);
+
+                if (layer_index == EndOfRecords)
+                    break;
+
+                std::uint32_t tile_x, tile_y, raw_size, compressed_size;
+                std::uint64_t hash;
+                checked_read(file, tile_x);
+                checked_read(file, tile_y);
+                checked_read(file, raw_size);
+                checked_read(file, compressed_size);
+                checked_read(file, hash);
+
+                if (layer_index >= expected_layers.size())
+                    return false;
+
+                const LayerHeader& layer = expected_layers[layer_index];
+                const size_t tile_count_x = (layer.m_canvas_width + layer.m_tile_width - 1) / layer.m_tile_width;
+                const size_t tile_index = tile_y * tile_count_x + tile_x;
+                if (tile_x >= tile_count_x || tile_index >= m_tiles[layer_index].size())
+                    return false;
+
+                const Tile& tile = layers[layer_index]->tile(tile_x, tile_y);
+                if (tile.get_size() != raw_size ||
+                    compressed_size > static_cast<std::uint32_t>(LZ4_compressBound(static_cast<int>(raw_size))))
+                    return false;
+
+                compressed.resize(compressed_size);
+                checked_read(file, compressed.data(), compressed_size);
+
+                shuffled.resize(raw_size);
+                const int decompressed_size =
+                    LZ4_decompress_safe(
+                        reinterpret_cast<const char*>(compressed.data()),
+                        reinterpret_cast<char*>(shuffled.data()),
+                        static_cast<int>(compressed_size),
+                        static_cast<int>(raw_size));
+
+                if (decompressed_size != static_cast<int>(raw_size))
+                    return false;
+
+                TileRecord record;
+                record.m_layer = layer_index;
+                record.m_tile_x = tile_x;
+                record.m_tile_y = tile_y;
+                record.m_hash = hash;
+                record.m_bytes.resize(raw_size);
+                unshuffle_bytes(shuffled.data(), record.m_bytes.data(), raw_size, layer.m_channel_size);
+
+                if (hash_bytes(record.m_bytes.data(), raw_size) != hash)
+                    return false;
+
+                records.push_back(std::move(record));
+            }
+
+            std::uint32_t expected_record_count;
+            checked_read(file, expected_record_count);
+
+            if (records.size() != expected_record_count)
+                return false;
+
+            // The segment is valid: apply it.
+            for (const TileRecord& record : records)
+            {
+                const LayerHeader& layer = expected_layers[record.m_layer];
+                const size_t tile_count_x = (layer.m_canvas_width + layer.m_tile_width - 1) / layer.m_tile_width;
+
+                Tile& tile = layers[record.m_layer]->tile(record.m_tile_x, record.m_tile_y);
+                std::memcpy(tile.get_storage(), record.m_bytes.data(), record.m_bytes.size());
+
+                TileState& state = m_tiles[record.m_layer][record.m_tile_y * tile_count_x + record.m_tile_x];
+                if (state.m_segment != NoSegment)
+                    --m_segments[state.m_segment];
+                state.m_hash = record.m_hash;
+                state.m_segment = pass_index;
+                ++m_segments[pass_index];
+            }
+
+            return true;
+        }
+        catch (const Exception&)
+        {
+            return false;
+        }
+    }
+};
+
+IncrementalCheckpoint::IncrementalCheckpoint(const std::string& path)
+  : impl(new Impl(path))
+{
+}
+
+IncrementalCheckpoint::~IncrementalCheckpoint()
+{
+    wait();
+    delete impl;
+}
+
+bool IncrementalCheckpoint::exists() const
+{
+    return !impl->list_segments().empty();
+}
+
+size_t IncrementalCheckpoint::save(
+    const std::vector<const ICanvas*>&  layers,
+    const size_t                        pass_index)
+{
+    wait();
+
+    std::vector<LayerHeader> layer_headers;
+    for (const ICanvas* layer : layers)
+        layer_headers.emplace_back(layer->properties());
+
+    // Start a new chain if the previous write failed, if the layers changed
+    // or if this pass would overwrite a segment that is still in use.
+    if (impl->m_write_failed ||
+        impl->m_tiles.size() != layers.size() ||
+        impl->m_segments.count(pass_index) != 0)
+    {
+        impl->m_write_failed = false;
+        impl->reset(layer_headers);
+    }
+    else
+    {
+        for (size_t i = 0, e = layers.size(); i < e; ++i)
+        {
+            if (impl->m_tiles[i].size() != layers[i]->properties().m_tile_count)
+            {
+                impl->reset(layer_headers);
+                break;
+            }
+        }
+    }
+
+    std::unique_ptr<Segment> segment(new Segment());
+    segment->m_pass_index = pass_index;
+    segment->m_layers = layer_headers;
+    segment->m_replace_all = impl->m_rewrite;
+
+    if (impl->m_rewrite)
+        impl->m_segments.clear();
+
+    // Always create an entry for the new segment, even if no tile changed:
+    // the most recent segment is the one that records the last pass.
+    size_t& live_tile_count = impl->m_segments[pass_index];
+
+    for (size_t layer_index = 0, layer_count = layers.size(); layer_index < layer_count; ++layer_index)
+    {
+        const ICanvas& layer = *layers[layer_index];
+        const CanvasProperties& props = layer.properties();
+
+        for (size_t tile_y = 0; tile_y < props.m_tile_count_y; ++tile_y)
+        {
+            for (size_t tile_x = 0; tile_x < props.m_tile_count_x; ++tile_x)
+            {
+                const Tile& tile = layer.tile(tile_x, tile_y);
+                const std::uint64_t hash = hash_bytes(tile.get_storage(), tile.get_size());
+
+                Impl::TileState& state = impl->m_tiles[layer_index][tile_y * props.m_tile_count_x + tile_x];
+
+                if (!impl->m_rewrite && state.m_segment != NoSegment && state.m_hash == hash)
+                    continue;
+
+                if (!impl->m_rewrite && state.m_segment != NoSegment)
+                    --impl->m_segments[state.m_segment];
+
+                state.m_hash = hash;
+                state.m_segment = pass_index;
+                ++live_tile_count;
+
+                TileRecord record;
+                record.m_layer = static_cast<std::uint32_t>(layer_index);
+                record.m_tile_x = static_cast<std::uint32_t>(tile_x);
+                record.m_tile_y = static_cast<std::uint32_t>(tile_y);
+                record.m_hash = hash;
+                record.m_bytes.assign(tile.get_storage(), tile.get_storage() + tile.get_size());
+                segment->m_records.push_back(std::move(record));
+            }
+        }
+    }
+
+    // Collect the segments that no longer hold any live tile.
+    for (auto i = impl->m_segments.begin(); i != impl->m_segments.end(); )
+    {
+        if (i->first != pass_index && i->second == 0)
+        {
+            segment->m_obsolete_passes.push_back(i->first);
+            i = impl->m_segments.erase(i);
+        }
+        else ++i;
+    }
+
+    impl->m_rewrite = false;
+
+    const size_t changed_tile_count = segment->m_records.size();
+
+    // Compress and write the segment in the background.
+    impl->m_pending = std::move(segment);
+    impl->m_writer_thread.reset(new boost::thread(&Impl::write_pending_segment, impl));
+
+    return changed_tile_count;
+}
+
+void IncrementalCheckpoint::wait()
+{
+    if (impl->m_writer_thread)
+    {
+        impl->m_writer_thread->join();
+        impl->m_writer_thread.reset();
+        impl->m_pending.reset();
+    }
+}
+
+bool IncrementalCheckpoint::load(
+    const std::vector<ICanvas*>&        layers,
+    size_t&                             last_pass)
+{
+    wait();
+
+    std::vector<LayerHeader> layer_headers;
+    for (const ICanvas* layer : layers)
+        layer_headers.emplace_back(layer->properties());
+
+    impl->reset(layer_headers);
+
+    const auto segments = impl->list_segments();
+    if (segments.empty())
+        return false;
+
+    // Replay the segments in order, stopping at the first damaged one.
+    size_t applied_segment_count = 0;
+    for (const auto& s : segments)
+    {
+        if (!impl->read_segment(s.second, s.first, layer_headers, layers))
+        {
+            RENDERER_LOG_WARNING(
+                "checkpoint segment %s is damaged or incompatible, ignoring it and the ones that follow.",
+                s.second.string().c_str());
+            break;
+        }
+
+        last_pass = s.first;
+        impl->m_segments[s.first];      // keep track of segments without live tiles so they get deleted
+        ++applied_segment_count;
+    }
+
+    // Make sure every tile was restored.
+    for (const auto& layer_tiles : impl->m_tiles)
+    {
+        for (const Impl::TileState& state : layer_tiles)
+        {
+            if (state.m_segment == NoSegment)
+            {
+                RENDERER_LOG_ERROR("checkpoint is incomplete: some tiles are missing.");
+                impl->reset(layer_headers);
+                return false;
+            }
+        }
+    }
+
+    // If some segments were ignored, the next checkpoint starts a new chain
+    // so that they can't be mixed with newer segments.
+    impl->m_rewrite = applied_segment_count < segments.size();
+
+    return true;
+}
+
+}   // namespace renderer
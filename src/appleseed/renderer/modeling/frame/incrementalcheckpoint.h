@@ -0,0 +1,101 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declarations.
+namespace foundation    { class ICanvas; }
+
+namespace renderer
+{
+
+//
+// Incremental, tile-level rendering checkpoints.
+//
+// A checkpoint is a chain of segment files stored next to the checkpoint path:
+// checkpointing pass N of render.ckpt writes render.0000N.ckpt. Each segment
+// only contains the tiles that changed since the previous segment, compressed
+// with LZ4 after their bytes were shuffled by significance (which makes
+// floating-point data far more compressible).
+//
+// Tiles are snapshotted synchronously but compressed and written to disk on
+// a background thread. Segments are written to a temporary file and renamed
+// once complete, so an interrupted render always leaves a consistent chain
+// behind. Segments whose tiles have all been superseded by newer segments are
+// deleted as soon as the superseding segment is complete.
+//
+// Loading replays the complete segments in pass order, stopping at the first
+// damaged one, and fails if some tile ends up missing.
+//
+
+class IncrementalCheckpoint
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    explicit IncrementalCheckpoint(const std::string& path);
+
+    // Destructor, waits for the pending segment to be written.
+    ~IncrementalCheckpoint();
+
+    // Return true if at least one segment exists on disk.
+    bool exists() const;
+
+    // Snapshot the tiles of the given layers that changed since the last
+    // checkpoint and write them in the background. Waits for the previous
+    // segment to be written first. Returns the number of tiles that changed.
+    size_t save(
+        const std::vector<const foundation::ICanvas*>&  layers,
+        const size_t                                    pass_index);
+
+    // Wait until the pending segment, if any, has been written.
+    void wait();
+
+    // Load the latest consistent set of tiles into the given layers, and
+    // retrieve the index of the last checkpointed pass. Return false if the
+    // checkpoint is missing, damaged or incompatible with the layers.
+    // Subsequent calls to save() only write tiles that changed since.
+    bool load(
+        const std::vector<foundation::ICanvas*>&        layers,
+        size_t&                                         last_pass);
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}   // namespace renderer
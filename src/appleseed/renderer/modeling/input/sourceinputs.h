@@ -34,6 +34,9 @@
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Forward declarations.
+namespace renderer  { class ShadingPoint; }
+
 namespace renderer
 {
 
@@ -44,13 +47,32 @@ class APPLESEED_DLLSYMBOL SourceInputs
     float   m_uv_x;
     float   m_uv_y;
 
+    // Screen space partial derivatives of the texture coordinates from UV set #0.
+    // They are zero when ray differentials are not available, and ignored when
+    // a shading point is provided.
+    float   m_duvdx_x;
+    float   m_duvdx_y;
+    float   m_duvdy_x;
+    float   m_duvdy_y;
+
+    // Shading point from which the screen space partial derivatives are computed on demand,
+    // i.e. only by texture sources that need them. May be null.
+    const ShadingPoint* m_shading_point;
+
     // World space intersection point.
     double  m_point_x;
     double  m_point_y;
     double  m_point_z;
 
-    // Constructor.
+    // Constructors.
     explicit SourceInputs(const foundation::Vector2f& uv);
+    SourceInputs(
+        const foundation::Vector2f& uv,
+        const foundation::Vector2f& duvdx,
+        const foundation::Vector2f& duvdy);
+    SourceInputs(
+        const foundation::Vector2f& uv,
+        const ShadingPoint&         shading_point);
 };
 
 
@@ -61,6 +83,44 @@ class APPLESEED_DLLSYMBOL SourceInputs
 inline SourceInputs::SourceInputs(const foundation::Vector2f& uv)
   : m_uv_x(uv.x)
   , m_uv_y(uv.y)
+  , m_duvdx_x(0.0f)
+  , m_duvdx_y(0.0f)
+  , m_duvdy_x(0.0f)
+  , m_duvdy_y(0.0f)
+  , m_shading_point(nullptr)
+  , m_point_x(0.0)
+  , m_point_y(0.0)
+  , m_point_z(0.0)
+{
+}
+
+inline SourceInputs::SourceInputs(
+    const foundation::Vector2f& uv,
+    const foundation::Vector2f& duvdx,
+    const foundation::Vector2f& duvdy)
+  : m_uv_x(uv.x)
+  , m_uv_y(uv.y)
+  , m_duvdx_x(duvdx.x)
+  , m_duvdx_y(duvdx.y)
+  , m_duvdy_x(duvdy.x)
+  , m_duvdy_y(duvdy.y)
+  , m_shading_point(nullptr)
+  , m_point_x(0.0)
+  , m_point_y(0.0)
+  , m_point_z(0.0)
+{
+}
+
+inline SourceInputs::SourceInputs(
+    const foundation::Vector2f& uv,
+    const ShadingPoint&         shading_point)
+  : m_uv_x(uv.x)
+  , m_uv_y(uv.y)
+  , m_duvdx_x(0.0f)
+  , m_duvdx_y(0.0f)
+  , m_duvdy_x(0.0f)
+  , m_duvdy_y(0.0f)
+  , m_shading_point(&shading_point)
   , m_point_x(0.0)
   , m_point_y(0.0)
   , m_point_z(0.0)
@@ -35,10 +35,12 @@
 #include "renderer/modeling/object/meshobjectprimitives.h"
 #include "renderer/modeling/object/meshobjectreader.h"
 #include "renderer/modeling/object/triangle.h"
+#include "renderer/utility/memorytracker.h"
 
 // appleseed.foundation headers.
 #include "foundation/containers/dictionary.h"
 #include "foundation/utility/api/apiarray.h"
+#include "foundation/utility/api/apistring.h"
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/foreach.h"
 
@@ -65,6 +67,7 @@ struct MeshObject::Impl
 {
     StaticTriangleTess          m_tess;
     std::vector<std::string>    m_material_slots;
+    std::string                 m_memory_owner;
 };
 
 MeshObject::MeshObject(
@@ -78,6 +81,9 @@ MeshObject::MeshObject(
 
 MeshObject::~MeshObject()
 {
+    if (!impl->m_memory_owner.empty())
+        global_memory_tracker().remove(MemoryTracker::CategoryObject, impl->m_memory_owner.c_str());
+
     delete impl;
 }
 
@@ -153,6 +159,29 @@ void MeshObject::rasterize(ObjectRasterizer& rasterizer) const
     rasterizer.end_object();
 }
 
+bool MeshObject::on_frame_begin(
+    const Project&          project,
+    const BaseGroup*        parent,
+    OnFrameBeginRecorder&   recorder,
+    IAbortSwitch*           abort_switch)
+{
+    if (!Object::on_frame_begin(project, parent, recorder, abort_switch))
+        return false;
+
+    // The object may have been renamed or moved since the last frame.
+    const std::string memory_owner = get_path().c_str();
+    if (!impl->m_memory_owner.empty() && impl->m_memory_owner != memory_owner)
+        global_memory_tracker().remove(MemoryTracker::CategoryObject, impl->m_memory_owner.c_str());
+    impl->m_memory_owner = memory_owner;
+
+    global_memory_tracker().set(
+        MemoryTracker::CategoryObject,
+        impl->m_memory_owner.c_str(),
+        impl->m_tess.get_memory_size());
+
+    return true;
+}
+
 void MeshObject::reserve_vertices(const size_t count)
 {
     impl->m_tess.m_vertices.reserve(count);
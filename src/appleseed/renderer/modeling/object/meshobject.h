@@ -48,11 +48,15 @@
 // Forward declarations.
 namespace foundation    { class Dictionary; }
 namespace foundation    { class DictionaryArray; }
+namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class SearchPaths; }
 namespace foundation    { class StringArray; }
 namespace foundation    { class StringDictionary; }
+namespace renderer      { class BaseGroup; }
 namespace renderer      { class ObjectRasterizer; }
+namespace renderer      { class OnFrameBeginRecorder; }
 namespace renderer      { class ParamArray; }
+namespace renderer      { class Project; }
 namespace renderer      { class Source; }
 namespace renderer      { class Triangle; }
 
@@ -87,6 +91,13 @@ class APPLESEED_DLLSYMBOL MeshObject
     // Send this object to an object rasterizer.
     void rasterize(ObjectRasterizer& drawer) const override;
 
+    // Report the memory used by the geometry of this object to the global memory tracker.
+    bool on_frame_begin(
+        const Project&              project,
+        const BaseGroup*            parent,
+        OnFrameBeginRecorder&       recorder,
+        foundation::IAbortSwitch*   abort_switch = nullptr) override;
+
     // Insert and access vertices.
     void reserve_vertices(const size_t count);
     size_t push_vertex(const GVector3& vertex);
@@ -0,0 +1,1087 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "binaryprojectfilereader.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/aov/aovfactoryregistrar.h"
+#include "renderer/modeling/aov/iaovfactory.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bsdf/bsdffactoryregistrar.h"
+#include "renderer/modeling/bsdf/ibsdffactory.h"
+#include "renderer/modeling/bssrdf/bssrdf.h"
+#include "renderer/modeling/bssrdf/bssrdffactoryregistrar.h"
+#include "renderer/modeling/bssrdf/ibssrdffactory.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/camera/camerafactoryregistrar.h"
+#include "renderer/modeling/camera/icamerafactory.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/display/display.h"
+#include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/edf/edffactoryregistrar.h"
+#include "renderer/modeling/edf/iedffactory.h"
+#include "renderer/modeling/environment/environment.h"
+#include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/environmentedf/environmentedffactoryregistrar.h"
+#include "renderer/modeling/environmentedf/ienvironmentedffactory.h"
+#include "renderer/modeling/environmentshader/environmentshader.h"
+#include "renderer/modeling/environmentshader/environmentshaderfactoryregistrar.h"
+#include "renderer/modeling/environmentshader/ienvironmentshaderfactory.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/light/ilightfactory.h"
+#include "renderer/modeling/light/light.h"
+#include "renderer/modeling/light/lightfactoryregistrar.h"
+#include "renderer/modeling/material/imaterialfactory.h"
+#include "renderer/modeling/material/material.h"
+#include "renderer/modeling/material/materialfactoryregistrar.h"
+#include "renderer/modeling/object/iobjectfactory.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/objectfactoryregistrar.h"
+#include "renderer/modeling/postprocessingstage/ipostprocessingstagefactory.h"
+#include "renderer/modeling/postprocessingstage/postprocessingstage.h"
+#include "renderer/modeling/postprocessingstage/postprocessingstagefactoryregistrar.h"
+#include "renderer/modeling/project/configuration.h"
+#include "renderer/modeling/project/configurationcontainer.h"
+#include "renderer/modeling/project/eventcounters.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectfilereader.h"
+#include "renderer/modeling/project/projectformatrevision.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyfactoryregistrar.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/iassemblyfactory.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+#include "renderer/modeling/surfaceshader/isurfaceshaderfactory.h"
+#include "renderer/modeling/surfaceshader/surfaceshader.h"
+#include "renderer/modeling/surfaceshader/surfaceshaderfactoryregistrar.h"
+#include "renderer/modeling/texture/itexturefactory.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/modeling/texture/texturefactoryregistrar.h"
+#include "renderer/modeling/volume/ivolumefactory.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/modeling/volume/volumefactoryregistrar.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/pluginstore.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/math/aabb.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/api/apiarray.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/memorymappedfile.h"
+#include "foundation/utility/searchpaths.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+#include "boost/filesystem/operations.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+namespace bf = boost::filesystem;
+
+namespace renderer
+{
+
+//
+// BinaryProjectFileReader class implementation.
+//
+// See binaryprojectfilewriter.cpp for a description of the file layout.
+//
+
+namespace
+{
+    // Signature of binary project files.
+    const char Signature[10] = { 'B', 'I', 'N', 'A', 'R', 'Y', 'P', 'R', 'O', 'J' };
+
+    // Latest version of the binary project file format supported by this code.
+    const std::uint16_t Version = 1;
+
+    class Reader
+    {
+      public:
+        // Constructor.
+        Reader(
+            Project&            project,
+            const int           options,
+            EventCounters&      event_counters,
+            const char*         begin,
+            const char*         end)
+          : m_project(project)
+          , m_options(options)
+          , m_event_counters(event_counters)
+          , m_ptr(reinterpret_cast<const std::uint8_t*>(begin))
+          , m_end(reinterpret_cast<const std::uint8_t*>(end))
+        {
+        }
+
+        // Read the whole file into the project.
+        // Throws foundation::ExceptionIOError.
+        void read()
+        {
+            read_header();
+            read_string_table();
+            read_project();
+
+            if (m_ptr != m_end)
+                throw ExceptionIOError("unexpected data at end of file");
+        }
+
+      private:
+        Project&                        m_project;
+        const int                       m_options;
+        EventCounters&                  m_event_counters;
+        const std::uint8_t*             m_ptr;
+        const std::uint8_t*             m_end;
+        std::vector<std::string>        m_strings;
+        const TextureFactoryRegistrar   m_texture_factory_registrar;
+
+        //
+        // Primitives.
+        //
+
+        void check_available(const size_t size) const
+        {
+            if (static_cast<size_t>(m_end - m_ptr) < size)
+                throw ExceptionIOError("unexpected end of file");
+        }
+
+        template <typename T>
+        T get()
+        {
+            check_available(sizeof(T));
+
+            T value;
+            std::memcpy(&value, m_ptr, sizeof(T));
+            m_ptr += sizeof(T);
+
+            return value;
+        }
+
+        size_t get_count()
+        {
+            return get<std::uint32_t>();
+        }
+
+        bool get_flag()
+        {
+            return get<std::uint8_t>() != 0;
+        }
+
+        const std::string& get_string()
+        {
+            const std::uint32_t index = get<std::uint32_t>();
+
+            if (index >= m_strings.size())
+                throw ExceptionIOError("invalid string index");
+
+            return m_strings[index];
+        }
+
+        Matrix4d get_matrix()
+        {
+            Matrix4d m;
+
+            for (size_t i = 0; i < 16; ++i)
+                m[i] = get<double>();
+
+            return m;
+        }
+
+        void read_string_dictionary(StringDictionary& strings)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& key = get_string();
+                const std::string& value = get_string();
+                strings.insert(key.c_str(), value.c_str());
+            }
+        }
+
+        void read_params(Dictionary& params)
+        {
+            read_string_dictionary(params.strings());
+
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& key = get_string();
+                Dictionary child;
+                read_params(child);
+                params.dictionaries().insert(key.c_str(), child);
+            }
+        }
+
+        void read_transform_sequence(TransformSequence& transform_sequence)
+        {
+            transform_sequence.clear();
+
+            const size_t count = get_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float time = get<float>();
+                transform_sequence.set_transform(time, Transformd::from_local_to_parent(get_matrix()));
+            }
+
+            if (count == 0)
+                transform_sequence.set_transform(0.0f, Transformd::identity());
+        }
+
+        // Read a transform sequence into an entity, or skip it if the entity could not be created.
+        template <typename Entity>
+        void read_transform_sequence(Entity* entity)
+        {
+            TransformSequence scratch;
+            read_transform_sequence(entity ? entity->transform_sequence() : scratch);
+        }
+
+        void read_value_array(ColorValueArray& values)
+        {
+            const size_t count = get_count();
+            check_available(count * sizeof(float));
+
+            values.resize(count);
+
+            if (count > 0)
+            {
+                std::memcpy(&values[0], m_ptr, count * sizeof(float));
+                m_ptr += count * sizeof(float);
+            }
+        }
+
+        //
+        // Entities.
+        //
+
+        template <typename Entity, typename EntityFactoryRegistrar>
+        auto_release_ptr<Entity> create_entity(
+            const EntityFactoryRegistrar&   registrar,
+            const char*                     type,
+            const std::string&              model,
+            const std::string&              name,
+            const ParamArray&               params)
+        {
+            try
+            {
+                const typename EntityFactoryRegistrar::FactoryType* factory =
+                    registrar.lookup(model.c_str());
+
+                if (factory)
+                    return factory->create(name.c_str(), params);
+
+                RENDERER_LOG_ERROR(
+                    "while defining %s \"%s\": invalid model \"%s\".",
+                    type,
+                    name.c_str(),
+                    model.c_str());
+                m_event_counters.signal_error();
+            }
+            catch (const ExceptionDictionaryKeyNotFound& e)
+            {
+                RENDERER_LOG_ERROR(
+                    "while defining %s \"%s\": required parameter \"%s\" missing.",
+                    type,
+                    name.c_str(),
+                    e.string());
+                m_event_counters.signal_error();
+            }
+            catch (const ExceptionUnknownEntity& e)
+            {
+                RENDERER_LOG_ERROR(
+                    "while defining %s \"%s\": unknown entity \"%s\".",
+                    type,
+                    name.c_str(),
+                    e.string());
+                m_event_counters.signal_error();
+            }
+
+            return auto_release_ptr<Entity>(nullptr);
+        }
+
+        // Read the name, model and parameters of an entity and create it.
+        template <typename Entity>
+        auto_release_ptr<Entity> read_entity(const char* type)
+        {
+            const std::string& name = get_string();
+            const std::string& model = get_string();
+
+            ParamArray params;
+            read_params(params);
+
+            return
+                create_entity<Entity>(
+                    m_project.get_factory_registrar<Entity>(),
+                    type,
+                    model,
+                    name,
+                    params);
+        }
+
+        template <typename Container, typename Entity>
+        void insert(Container& container, auto_release_ptr<Entity> entity)
+        {
+            if (entity.get() == nullptr)
+                return;
+
+            if (container.get_by_name(entity->get_name()) != nullptr)
+            {
+                RENDERER_LOG_ERROR(
+                    "an entity with the path \"%s\" already exists.",
+                    entity->get_path().c_str());
+                m_event_counters.signal_error();
+                return;
+            }
+
+            container.insert(entity);
+        }
+
+        template <typename Entity, typename Container>
+        void read_entities(Container& container, const char* type)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+                insert(container, read_entity<Entity>(type));
+        }
+
+        // Like read_entities(), for entities followed by a transform sequence.
+        template <typename Entity, typename Container>
+        void read_entities_with_transform_sequence(Container& container, const char* type)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                auto_release_ptr<Entity> entity = read_entity<Entity>(type);
+                read_transform_sequence(entity.get());
+                insert(container, entity);
+            }
+        }
+
+        void read_colors(ColorContainer& colors)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                ColorValueArray values, alpha;
+                read_value_array(values);
+                read_value_array(alpha);
+
+                try
+                {
+                    insert(
+                        colors,
+                        alpha.empty()
+                            ? ColorEntityFactory::create(name.c_str(), params, values)
+                            : ColorEntityFactory::create(name.c_str(), params, values, alpha));
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining color \"%s\": required parameter \"%s\" missing.",
+                        name.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+            }
+        }
+
+        void read_textures(TextureContainer& textures)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& model = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                try
+                {
+                    const TextureFactoryRegistrar::FactoryType* factory =
+                        m_texture_factory_registrar.lookup(model.c_str());
+
+                    if (factory)
+                    {
+                        insert(
+                            textures,
+                            factory->create(
+                                name.c_str(),
+                                params,
+                                m_project.search_paths()));
+                    }
+                    else
+                    {
+                        RENDERER_LOG_ERROR(
+                            "while defining texture \"%s\": invalid model \"%s\".",
+                            name.c_str(),
+                            model.c_str());
+                        m_event_counters.signal_error();
+                    }
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining texture \"%s\": required parameter \"%s\" missing.",
+                        name.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+            }
+        }
+
+        void read_texture_instances(TextureInstanceContainer& texture_instances)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& texture = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                const Transformd transform = Transformd::from_local_to_parent(get_matrix());
+
+                try
+                {
+                    insert(
+                        texture_instances,
+                        TextureInstanceFactory::create(
+                            name.c_str(),
+                            params,
+                            texture.c_str(),
+                            Transformf(
+                                transform.get_local_to_parent(),
+                                transform.get_parent_to_local())));
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining texture instance \"%s\": required parameter \"%s\" missing.",
+                        name.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+            }
+        }
+
+        void read_lights(LightContainer& lights)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                auto_release_ptr<Light> light = read_entity<Light>("light");
+                const Transformd transform = Transformd::from_local_to_parent(get_matrix());
+
+                if (light.get())
+                {
+                    light->set_transform(transform);
+                    insert(lights, light);
+                }
+            }
+        }
+
+        void read_objects(ObjectContainer& objects)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& model = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                try
+                {
+                    const IObjectFactory* factory =
+                        m_project.get_factory_registrar<Object>().lookup(model.c_str());
+
+                    if (factory)
+                    {
+                        ObjectArray created_objects;
+                        if (!factory->create(
+                                name.c_str(),
+                                params,
+                                m_project.search_paths(),
+                                (m_options & ProjectFileReader::OmitReadingMeshFiles) != 0,
+                                created_objects))
+                            m_event_counters.signal_error();
+
+                        for (size_t j = 0, f = created_objects.size(); j < f; ++j)
+                            insert(objects, auto_release_ptr<Object>(created_objects[j]));
+                    }
+                    else
+                    {
+                        RENDERER_LOG_ERROR(
+                            "while defining object \"%s\": invalid model \"%s\".",
+                            name.c_str(),
+                            model.c_str());
+                        m_event_counters.signal_error();
+                    }
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining object \"%s\": required parameter \"%s\" missing.",
+                        name.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+                catch (const ExceptionUnknownEntity& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining object \"%s\": unknown entity \"%s\".",
+                        name.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+                catch (const Exception& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining object \"%s\": %s",
+                        name.c_str(),
+                        e.what());
+                    m_event_counters.signal_error();
+                }
+            }
+        }
+
+        void read_object_instances(ObjectInstanceContainer& object_instances)
+        {
+            const size_t count = get_count();
+
+            // The transforms of all instances come first, as a packed array of matrices.
+            const size_t MatrixSize = 16 * sizeof(double);
+            check_available(count * MatrixSize);
+            const std::uint8_t* matrices = m_ptr;
+            m_ptr += count * MatrixSize;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& object = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                StringDictionary front_material_mappings;
+                StringDictionary back_material_mappings;
+                read_string_dictionary(front_material_mappings);
+                read_string_dictionary(back_material_mappings);
+
+                Matrix4d local_to_parent;
+                std::memcpy(&local_to_parent[0], matrices + i * MatrixSize, MatrixSize);
+
+                insert(
+                    object_instances,
+                    ObjectInstanceFactory::create(
+                        name.c_str(),
+                        params,
+                        object.c_str(),
+                        Transformd::from_local_to_parent(local_to_parent),
+                        front_material_mappings,
+                        back_material_mappings));
+            }
+        }
+
+        void read_shader_groups(ShaderGroupContainer& shader_groups)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                auto_release_ptr<ShaderGroup> shader_group(
+                    ShaderGroupFactory::create(get_string().c_str()));
+
+                for (size_t j = 0, f = get_count(); j < f; ++j)
+                {
+                    const std::string& type = get_string();
+                    const std::string& name = get_string();
+                    const std::string& layer = get_string();
+
+                    ParamArray params;
+                    for (size_t k = 0, g = get_count(); k < g; ++k)
+                    {
+                        const std::string& param_name = get_string();
+                        const std::string& param_value = get_string();
+                        params.insert_path(param_name.c_str(), param_value);
+                    }
+
+                    const std::string& code = get_string();
+
+                    if (code.empty())
+                    {
+                        shader_group->add_shader(
+                            type.c_str(),
+                            name.c_str(),
+                            layer.c_str(),
+                            params);
+                    }
+                    else
+                    {
+                        shader_group->add_source_shader(
+                            type.c_str(),
+                            name.c_str(),
+                            layer.c_str(),
+                            code.c_str(),
+                            params);
+                    }
+                }
+
+                for (size_t j = 0, f = get_count(); j < f; ++j)
+                {
+                    const std::string& src_layer = get_string();
+                    const std::string& src_param = get_string();
+                    const std::string& dst_layer = get_string();
+                    const std::string& dst_param = get_string();
+
+                    shader_group->add_connection(
+                        src_layer.c_str(),
+                        src_param.c_str(),
+                        dst_layer.c_str(),
+                        dst_param.c_str());
+                }
+
+                insert(shader_groups, shader_group);
+            }
+        }
+
+        void read_assembly_instances(AssemblyInstanceContainer& assembly_instances)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& assembly = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                auto_release_ptr<AssemblyInstance> assembly_instance(
+                    AssemblyInstanceFactory::create(
+                        name.c_str(),
+                        params,
+                        assembly.c_str()));
+
+                read_transform_sequence(assembly_instance->transform_sequence());
+
+                insert(assembly_instances, assembly_instance);
+            }
+        }
+
+        void read_assemblies(AssemblyContainer& assemblies)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& model = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                const bool is_procedural = get_flag();
+
+                auto_release_ptr<Assembly> assembly;
+
+                const IAssemblyFactory* factory =
+                    m_project.get_factory_registrar<Assembly>().lookup(model.c_str());
+
+                if (factory)
+                    assembly = factory->create(name.c_str(), params);
+                else
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining assembly \"%s\": invalid model \"%s\".",
+                        name.c_str(),
+                        model.c_str());
+                    m_event_counters.signal_error();
+                }
+
+                if (!is_procedural)
+                {
+                    if (assembly.get())
+                        read_assembly_contents(assembly.ref());
+                    else
+                    {
+                        // Read the contents anyway to move on to the next entity.
+                        auto_release_ptr<Assembly> scratch(AssemblyFactory().create(name.c_str(), ParamArray()));
+                        read_assembly_contents(scratch.ref());
+                    }
+                }
+
+                insert(assemblies, assembly);
+            }
+        }
+
+        void read_assembly_contents(Assembly& assembly)
+        {
+            read_colors(assembly.colors());
+            read_textures(assembly.textures());
+            read_texture_instances(assembly.texture_instances());
+            read_entities<BSDF>(assembly.bsdfs(), "bsdf");
+            read_entities<BSSRDF>(assembly.bssrdfs(), "bssrdf");
+            read_entities<EDF>(assembly.edfs(), "edf");
+            read_shader_groups(assembly.shader_groups());
+            read_entities<SurfaceShader>(assembly.surface_shaders(), "surface shader");
+            read_entities<Material>(assembly.materials(), "material");
+            read_lights(assembly.lights());
+            read_objects(assembly.objects());
+            read_object_instances(assembly.object_instances());
+            read_entities<Volume>(assembly.volumes(), "volume");
+            read_assemblies(assembly.assemblies());
+            read_assembly_instances(assembly.assembly_instances());
+        }
+
+        void read_environment(Scene& scene)
+        {
+            const std::string& name = get_string();
+            const std::string& model = get_string();
+
+            ParamArray params;
+            read_params(params);
+
+            if (model == EnvironmentFactory::get_model())
+                scene.set_environment(EnvironmentFactory::create(name.c_str(), params));
+            else
+            {
+                RENDERER_LOG_ERROR(
+                    "while defining environment \"%s\": invalid model \"%s\".",
+                    name.c_str(),
+                    model.c_str());
+                m_event_counters.signal_error();
+            }
+        }
+
+        void read_scene()
+        {
+            // Discover and load plugins before building the scene.
+            m_project.get_plugin_store().load_all_plugins_from_paths(m_project.search_paths());
+
+            auto_release_ptr<Scene> scene(SceneFactory::create());
+
+            read_params(scene->get_parameters());
+            read_entities_with_transform_sequence<Camera>(scene->cameras(), "camera");
+            read_colors(scene->colors());
+            read_textures(scene->textures());
+            read_texture_instances(scene->texture_instances());
+            read_entities_with_transform_sequence<EnvironmentEDF>(scene->environment_edfs(), "environment edf");
+            read_entities<EnvironmentShader>(scene->environment_shaders(), "environment shader");
+            if (get_flag())
+                read_environment(scene.ref());
+            read_shader_groups(scene->shader_groups());
+            read_assemblies(scene->assemblies());
+            read_assembly_instances(scene->assembly_instances());
+
+            const GAABB3 scene_bbox = scene->compute_bbox();
+            const Vector3d scene_center(scene_bbox.center());
+
+            RENDERER_LOG_INFO(
+                "scene bounding box: (%f, %f, %f)-(%f, %f, %f).\n"
+                "scene bounding sphere: center (%f, %f, %f), diameter %f.",
+                scene_bbox.min[0], scene_bbox.min[1], scene_bbox.min[2],
+                scene_bbox.max[0], scene_bbox.max[1], scene_bbox.max[2],
+                scene_center[0], scene_center[1], scene_center[2],
+                scene_bbox.diameter());
+
+            m_project.set_scene(scene);
+        }
+
+        void read_aovs(AOVContainer& aovs)
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& model = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                try
+                {
+                    const IAOVFactory* factory =
+                        m_project.get_factory_registrar<AOV>().lookup(model.c_str());
+
+                    if (factory)
+                    {
+                        auto_release_ptr<AOV> aov = factory->create(params);
+
+                        if (aovs.get_by_name(aov->get_name()) == nullptr)
+                            aovs.insert(aov);
+                        else
+                        {
+                            RENDERER_LOG_ERROR(
+                                "an aov with the path \"%s\" already exists.",
+                                aov->get_path().c_str());
+                            m_event_counters.signal_error();
+                        }
+                    }
+                    else
+                    {
+                        RENDERER_LOG_ERROR(
+                            "while defining aov: invalid model \"%s\".",
+                            model.c_str());
+                        m_event_counters.signal_error();
+                    }
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining aov \"%s\": required parameter \"%s\" missing.",
+                        model.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+                catch (const ExceptionUnknownEntity& e)
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining aov \"%s\": unknown entity \"%s\".",
+                        model.c_str(),
+                        e.string());
+                    m_event_counters.signal_error();
+                }
+            }
+        }
+
+        void read_frame()
+        {
+            const std::string& name = get_string();
+
+            ParamArray params;
+            read_params(params);
+
+            AOVContainer aovs;
+            read_aovs(aovs);
+
+            PostProcessingStageContainer post_processing_stages;
+            read_entities<PostProcessingStage>(post_processing_stages, "post-processing stage");
+
+            auto_release_ptr<Frame> frame(
+                FrameFactory::create(
+                    name.c_str(),
+                    params,
+                    aovs,
+                    m_project.search_paths()));
+
+            frame->post_processing_stages().swap(post_processing_stages);
+
+            m_project.set_frame(frame);
+        }
+
+        void read_configurations()
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& name = get_string();
+                const std::string& base_name = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                auto_release_ptr<Configuration> configuration(
+                    ConfigurationFactory::create(name.c_str(), params));
+
+                // Handle configuration inheritance.
+                if (!base_name.empty())
+                {
+                    const Configuration* base =
+                        m_project.configurations().get_by_name(base_name.c_str());
+
+                    if (base)
+                        configuration->set_base(base);
+                    else
+                    {
+                        RENDERER_LOG_ERROR(
+                            "while defining configuration \"%s\": the configuration \"%s\" does not exist.",
+                            configuration->get_path().c_str(),
+                            base_name.c_str());
+                        m_event_counters.signal_error();
+                    }
+                }
+
+                m_project.configurations().insert(configuration);
+            }
+        }
+
+        void read_search_paths()
+        {
+            for (size_t i = 0, e = get_count(); i < e; ++i)
+            {
+                const std::string& path = get_string();
+
+                // Skip search paths if asked to do so.
+                if (!(m_options & ProjectFileReader::OmitSearchPaths) && !path.empty())
+                    m_project.search_paths().push_back_explicit_path(path);
+            }
+        }
+
+        //
+        // File structure.
+        //
+
+        void read_header()
+        {
+            check_available(sizeof(Signature));
+
+            if (std::memcmp(m_ptr, Signature, sizeof(Signature)) != 0)
+                throw ExceptionIOError("invalid binary project file signature");
+
+            m_ptr += sizeof(Signature);
+
+            if (get<std::uint16_t>() > Version)
+                throw ExceptionIOError("unsupported binary project file version");
+        }
+
+        void read_string_table()
+        {
+            const size_t count = get_count();
+
+            // Each string takes at least four bytes, don't trust the count blindly.
+            m_strings.reserve(std::min(count, static_cast<size_t>(m_end - m_ptr) / 4));
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t length = get<std::uint32_t>();
+                check_available(length);
+                m_strings.emplace_back(reinterpret_cast<const char*>(m_ptr), length);
+                m_ptr += length;
+            }
+        }
+
+        void read_project()
+        {
+            const size_t format_revision = get<std::uint32_t>();
+
+            if (format_revision > ProjectFormatRevision)
+            {
+                RENDERER_LOG_WARNING(
+                    "this project was created with a newer version of appleseed; it may fail to load or render properly with this version.");
+                m_event_counters.signal_warning();
+            }
+
+            m_project.set_format_revision(format_revision);
+
+            read_search_paths();
+
+            if (get_flag())
+            {
+                const std::string& name = get_string();
+
+                ParamArray params;
+                read_params(params);
+
+                m_project.set_display(DisplayFactory::create(name.c_str(), params));
+            }
+
+            if (get_flag())
+                read_scene();
+
+            if (get_flag())
+                read_frame();
+
+            read_configurations();
+        }
+    };
+}
+
+bool BinaryProjectFileReader::is_binary_project_file(const char* filepath)
+{
+    BufferedFile file(
+        filepath,
+        BufferedFile::BinaryType,
+        BufferedFile::ReadMode);
+
+    if (!file.is_open())
+        return false;
+
+    char signature[sizeof(Signature)];
+
+    return
+        file.read(signature, sizeof(signature)) == sizeof(signature) &&
+        std::memcmp(signature, Signature, sizeof(Signature)) == 0;
+}
+
+auto_release_ptr<Project> BinaryProjectFileReader::read(
+    const char*                     project_filepath,
+    const int                       options,
+    EventCounters&                  event_counters)
+{
+    assert(project_filepath);
+
+    // Create an empty project.
+    auto_release_ptr<Project> project(ProjectFactory::create(project_filepath));
+    project->set_path(project_filepath);
+    project->search_paths().set_root_path(
+        bf::absolute(project_filepath).parent_path().string());
+
+    RENDERER_LOG_INFO("loading binary project file %s...", project_filepath);
+
+    const MemoryMappedFile file(project_filepath);
+    if (!file.is_open())
+    {
+        RENDERER_LOG_ERROR("failed to open project file %s for reading.", project_filepath);
+        event_counters.signal_error();
+        return auto_release_ptr<Project>(nullptr);
+    }
+
+    try
+    {
+        Reader reader(
+            project.ref(),
+            options,
+            event_counters,
+            file.data(),
+            file.data() + file.size());
+
+        reader.read();
+    }
+    catch (const ExceptionIOError& e)
+    {
+        RENDERER_LOG_ERROR("failed to load project file %s: %s.", project_filepath, e.what());
+        event_counters.signal_error();
+        return auto_release_ptr<Project>(nullptr);
+    }
+
+    return project;
+}
+
+}   // namespace renderer
@@ -0,0 +1,738 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "binaryprojectfilewriter.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bssrdf/bssrdf.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/display/display.h"
+#include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/environment/environment.h"
+#include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/environmentshader/environmentshader.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/light/light.h"
+#include "renderer/modeling/material/material.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/modeling/object/curveobjectwriter.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/meshobjectwriter.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/postprocessingstage/postprocessingstage.h"
+#include "renderer/modeling/project/assethandler.h"
+#include "renderer/modeling/project/configuration.h"
+#include "renderer/modeling/project/configurationcontainer.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectfilewriter.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/proceduralassembly.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/shadergroup/shader.h"
+#include "renderer/modeling/shadergroup/shaderconnection.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+#include "renderer/modeling/shadergroup/shaderparam.h"
+#include "renderer/modeling/surfaceshader/surfaceshader.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/platform/defaulttimers.h"
+#include "foundation/string/string.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/foreach.h"
+#include "foundation/utility/searchpaths.h"
+#include "foundation/utility/stopwatch.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace foundation;
+namespace bf = boost::filesystem;
+
+namespace renderer
+{
+
+//
+// BinaryProjectFileWriter class implementation.
+//
+// File layout:
+//
+//   signature          10 bytes, "BINARYPROJ"
+//   version            uint16
+//   string count       uint32
+//   strings            string count x (uint32 length, length bytes)
+//   project            see Writer::write_project()
+//
+// All strings in the project section are uint32 indices into the string
+// table. Counts are uint32, flags are uint8, times are float, matrices are
+// 16 doubles in row-major order. Collections are written in container order.
+//
+
+namespace
+{
+    // Version of the binary project file format being written by this code.
+    const std::uint16_t Version = 1;
+
+    class Writer
+    {
+      public:
+        // Constructor.
+        Writer(
+            const char*         filepath,
+            const int           options)
+          : m_project_new_root_dir(bf::path(filepath).parent_path())
+          , m_options(options)
+        {
+        }
+
+        // Serialize a project into memory.
+        void write_project(const Project& project)
+        {
+            put(static_cast<std::uint32_t>(project.get_format_revision()));
+
+            write_search_paths(project);
+
+            put_flag(project.get_display() != nullptr);
+            if (project.get_display())
+                write(*project.get_display());
+
+            put_flag(project.get_scene() != nullptr);
+            if (project.get_scene())
+                write_scene(*project.get_scene());
+
+            put_flag(project.get_frame() != nullptr);
+            if (project.get_frame())
+                write_frame(*project.get_frame());
+
+            write_configurations(project);
+        }
+
+        // Write the string table followed by the serialized project to disk.
+        // Throws foundation::ExceptionIOError.
+        void write_file(BufferedFile& file) const
+        {
+            static const char Signature[10] = { 'B', 'I', 'N', 'A', 'R', 'Y', 'P', 'R', 'O', 'J' };
+            checked_write(file, Signature, sizeof(Signature));
+            checked_write(file, Version);
+
+            checked_write(file, static_cast<std::uint32_t>(m_strings.size()));
+            for (const std::string* s : m_strings)
+            {
+                checked_write(file, static_cast<std::uint32_t>(s->size()));
+                checked_write(file, s->data(), s->size());
+            }
+
+            checked_write(file, m_body.data(), m_body.size());
+        }
+
+      private:
+        typedef std::unordered_map<std::string, std::uint32_t> StringIndexMap;
+
+        const bf::path                  m_project_new_root_dir;
+        const int                       m_options;
+        StringIndexMap                  m_string_indices;
+        std::vector<const std::string*> m_strings;
+        std::vector<std::uint8_t>       m_body;
+
+        // Append the raw bytes of a value.
+        template <typename T>
+        void put(const T& value)
+        {
+            const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+            m_body.insert(m_body.end(), bytes, bytes + sizeof(T));
+        }
+
+        void put_count(const size_t count)
+        {
+            put(static_cast<std::uint32_t>(count));
+        }
+
+        void put_flag(const bool flag)
+        {
+            put(static_cast<std::uint8_t>(flag ? 1 : 0));
+        }
+
+        // Append the index of a string, adding it to the string table if needed.
+        void put_string(const char* s)
+        {
+            const auto result =
+                m_string_indices.emplace(s, static_cast<std::uint32_t>(m_strings.size()));
+
+            if (result.second)
+                m_strings.push_back(&result.first->first);
+
+            put(result.first->second);
+        }
+
+        void put_string(const std::string& s)
+        {
+            put_string(s.c_str());
+        }
+
+        template <typename T>
+        void put_matrix(const Matrix<T, 4, 4>& m)
+        {
+            for (size_t i = 0; i < 16; ++i)
+                put(static_cast<double>(m[i]));
+        }
+
+        void put_string_dictionary(const StringDictionary& strings)
+        {
+            put_count(strings.size());
+
+            for (const_each<StringDictionary> i = strings; i; ++i)
+            {
+                put_string(i->key());
+                put_string(i->value());
+            }
+        }
+
+        // Write a (possibly hierarchical) set of parameters.
+        void write_params(const Dictionary& params)
+        {
+            put_string_dictionary(params.strings());
+
+            put_count(params.dictionaries().size());
+
+            for (const_each<DictionaryDictionary> i = params.dictionaries(); i; ++i)
+            {
+                put_string(i->key());
+                write_params(i->value());
+            }
+        }
+
+        // Write a transform sequence.
+        void write_transform_sequence(const TransformSequence& transform_sequence)
+        {
+            put_count(transform_sequence.size());
+
+            for (size_t i = 0, e = transform_sequence.size(); i < e; ++i)
+            {
+                float time;
+                Transformd transform;
+                transform_sequence.get_transform(i, time, transform);
+
+                put(time);
+                put_matrix(transform.get_local_to_parent());
+            }
+        }
+
+        // Write an array of color values.
+        void write_value_array(const ColorValueArray& values)
+        {
+            put_count(values.size());
+
+            for (size_t i = 0, e = values.size(); i < e; ++i)
+                put(values[i]);
+        }
+
+        template <typename Entity>
+        void write_entity(const Entity& entity)
+        {
+            write_entity(entity, entity.get_name());
+        }
+
+        template <typename Entity>
+        void write_entity(const Entity& entity, const char* entity_name)
+        {
+            put_string(entity_name);
+            put_string(entity.get_model());
+            write_params(entity.get_parameters());
+        }
+
+        template <typename Collection>
+        void write_collection(const Collection& collection)
+        {
+            put_count(collection.size());
+
+            for (const auto& entity : collection)
+                write(entity);
+        }
+
+        void write(const AOV& aov)
+        {
+            put_string(aov.get_model());
+            write_params(aov.get_parameters());
+        }
+
+        void write(const Assembly& assembly)
+        {
+            write_entity(assembly);
+
+            // Don't write the content of the assembly if it was
+            // generated procedurally.
+            const bool is_procedural = dynamic_cast<const ProceduralAssembly*>(&assembly) != nullptr;
+            put_flag(is_procedural);
+
+            if (!is_procedural)
+            {
+                write_collection(assembly.colors());
+                write_collection(assembly.textures());
+                write_collection(assembly.texture_instances());
+                write_collection(assembly.bsdfs());
+                write_collection(assembly.bssrdfs());
+                write_collection(assembly.edfs());
+                write_collection(assembly.shader_groups());
+                write_collection(assembly.surface_shaders());
+                write_collection(assembly.materials());
+                write_collection(assembly.lights());
+                write_object_collection(assembly.objects());
+                write_object_instance_collection(assembly.object_instances());
+                write_collection(assembly.volumes());
+                write_collection(assembly.assemblies());
+                write_collection(assembly.assembly_instances());
+            }
+        }
+
+        void write(const AssemblyInstance& assembly_instance)
+        {
+            put_string(assembly_instance.get_name());
+            put_string(assembly_instance.get_assembly_name());
+            write_params(assembly_instance.get_parameters());
+            write_transform_sequence(assembly_instance.transform_sequence());
+        }
+
+        void write(const BSDF& bsdf)
+        {
+            write_entity(bsdf);
+        }
+
+        void write(const BSSRDF& bssrdf)
+        {
+            write_entity(bssrdf);
+        }
+
+        void write(const Camera& camera)
+        {
+            write_entity(camera);
+            write_transform_sequence(camera.transform_sequence());
+        }
+
+        void write(const ColorEntity& color_entity)
+        {
+            put_string(color_entity.get_name());
+            write_params(color_entity.get_parameters());
+            write_value_array(color_entity.get_values());
+            write_value_array(color_entity.get_alpha());
+        }
+
+        void write_configurations(const Project& project)
+        {
+            std::vector<const Configuration*> configurations;
+
+            for (const Configuration& configuration : project.configurations())
+            {
+                if (!BaseConfigurationFactory::is_base_configuration(configuration.get_name()))
+                    configurations.push_back(&configuration);
+            }
+
+            put_count(configurations.size());
+
+            for (const Configuration* configuration : configurations)
+            {
+                put_string(configuration->get_name());
+                put_string(configuration->get_base() ? configuration->get_base()->get_name() : "");
+                write_params(configuration->get_parameters());
+            }
+        }
+
+        void write(const Display& display)
+        {
+            put_string(display.get_name());
+            write_params(display.get_parameters());
+        }
+
+        void write(const EDF& edf)
+        {
+            write_entity(edf);
+        }
+
+        void write(const Environment& environment)
+        {
+            write_entity(environment);
+        }
+
+        void write(const EnvironmentEDF& env_edf)
+        {
+            write_entity(env_edf);
+            write_transform_sequence(env_edf.transform_sequence());
+        }
+
+        void write(const EnvironmentShader& env_shader)
+        {
+            write_entity(env_shader);
+        }
+
+        void write_frame(const Frame& frame)
+        {
+            put_string(frame.get_name());
+            write_params(frame.get_parameters());
+            write_collection(frame.aovs());
+            write_collection(frame.post_processing_stages());
+        }
+
+        void write(const Light& light)
+        {
+            write_entity(light);
+            put_matrix(light.get_transform().get_local_to_parent());
+        }
+
+        void write(const Material& material)
+        {
+            write_entity(material);
+        }
+
+        void write(const Volume& volume)
+        {
+            write_entity(volume);
+        }
+
+        // Write a collection of objects. Objects that were loaded from the
+        // same mesh file are written once, under the name of the mesh file.
+        void write_object_collection(ObjectContainer& objects)
+        {
+            const size_t count_offset = m_body.size();
+            put_count(0);
+
+            std::set<std::string> groups;
+            std::uint32_t count = 0;
+
+            for (Object& object : objects)
+            {
+                if (strcmp(object.get_model(), MeshObjectFactory().get_model()) == 0)
+                {
+                    if (write_mesh_object(static_cast<MeshObject&>(object), groups))
+                        ++count;
+                }
+                else if (strcmp(object.get_model(), CurveObjectFactory().get_model()) == 0)
+                {
+                    write_curve_object(static_cast<CurveObject&>(object));
+                    ++count;
+                }
+                else
+                {
+                    write_entity(object);
+                    ++count;
+                }
+            }
+
+            std::memcpy(&m_body[count_offset], &count, sizeof(count));
+        }
+
+        // Write a mesh object. Return false if nothing needed to be written.
+        bool write_mesh_object(MeshObject& object, std::set<std::string>& groups)
+        {
+            ParamArray& params = object.get_parameters();
+
+            // If the object is a mesh primitive, do not write geometry to disk.
+            if (params.strings().exist("primitive"))
+            {
+                write_entity(object);
+                return true;
+            }
+
+            if (params.strings().exist("__base_object_name"))
+            {
+                // This object belongs to a group of objects.
+                const std::string group_name = params.get<std::string>("__base_object_name");
+                if (groups.find(group_name) != groups.end())
+                    return false;
+
+                // This is the first time we encounter this group of objects.
+                groups.insert(group_name);
+
+                // Write the object group.
+                params.strings().remove("__base_object_name");
+                write_entity(object, group_name.c_str());
+                params.strings().insert("__base_object_name", group_name);
+            }
+            else if (params.strings().exist("filename") || params.dictionaries().exist("filename"))
+            {
+                // This object has a filename parameter.
+                write_entity(object);
+            }
+            else
+            {
+                // This object does not belong to a group and does not have a filename parameter.
+                write_orphan_mesh_object(object);
+            }
+
+            return true;
+        }
+
+        // Object name mapping established by write_orphan_mesh_object().
+        typedef std::map<std::string, std::string> ObjectNameMapping;
+        ObjectNameMapping m_object_name_mapping;
+
+        // Get the new name of an object, given its old name.
+        std::string translate_object_name(const std::string& old_name) const
+        {
+            const ObjectNameMapping::const_iterator i = m_object_name_mapping.find(old_name);
+            return i == m_object_name_mapping.end() ? old_name : i->second;
+        }
+
+        // Write a mesh object without a filename, storing its geometry in a mesh file.
+        void write_orphan_mesh_object(const MeshObject& object)
+        {
+            // Construct the name of the mesh file.
+            const std::string object_name = object.get_name();
+            const std::string filename = object_name + ".binarymesh";
+
+            if (!(m_options & ProjectFileWriter::OmitWritingGeometryFiles))
+            {
+                // Write the mesh file to disk.
+                const std::string filepath = (m_project_new_root_dir / filename).string();
+                MeshObjectWriter::write(object, object_name.c_str(), filepath.c_str());
+            }
+
+            // Output a "filename" parameter but don't add it to the object.
+            ParamArray params = object.get_parameters();
+            params.insert("filename", filename);
+
+            put_string(object_name);
+            put_string(MeshObjectFactory().get_model());
+            write_params(params);
+
+            // Update the object name mapping.
+            m_object_name_mapping[object_name] = object_name + "." + object_name;
+        }
+
+        void write_curve_object(CurveObject& object)
+        {
+            ParamArray& params = object.get_parameters();
+
+            if (!params.strings().exist("filepath"))
+            {
+                const std::string object_name = object.get_name();
+                const std::string filename = object_name + ".binarycurve";
+
+                if (!(m_options & ProjectFileWriter::OmitWritingGeometryFiles))
+                {
+                    // Write the curve file to disk.
+                    const std::string filepath = (m_project_new_root_dir / filename).string();
+                    CurveObjectWriter::write(object, filepath.c_str());
+                }
+
+                // Add a file path parameter to the object.
+                params.insert("filepath", filename);
+            }
+
+            write_entity(object);
+        }
+
+        // Write a collection of object instances. The transforms of all
+        // instances are written first, as a single packed array of matrices.
+        void write_object_instance_collection(const ObjectInstanceContainer& object_instances)
+        {
+            put_count(object_instances.size());
+
+            for (const ObjectInstance& object_instance : object_instances)
+                put_matrix(object_instance.get_transform().get_local_to_parent());
+
+            for (const ObjectInstance& object_instance : object_instances)
+            {
+                put_string(object_instance.get_name());
+                put_string(translate_object_name(object_instance.get_object_name()));
+                write_params(object_instance.get_parameters());
+                put_string_dictionary(object_instance.get_front_material_mappings());
+                put_string_dictionary(object_instance.get_back_material_mappings());
+            }
+        }
+
+        void write(const PostProcessingStage& stage)
+        {
+            write_entity(stage);
+        }
+
+        void write_scene(const Scene& scene)
+        {
+            write_params(scene.get_parameters());
+            write_collection(scene.cameras());
+            write_collection(scene.colors());
+            write_collection(scene.textures());
+            write_collection(scene.texture_instances());
+            write_collection(scene.environment_edfs());
+            write_collection(scene.environment_shaders());
+            put_flag(scene.get_environment() != nullptr);
+            if (scene.get_environment())
+                write(*scene.get_environment());
+            write_collection(scene.shader_groups());
+            write_collection(scene.assemblies());
+            write_collection(scene.assembly_instances());
+        }
+
+        void write_search_paths(const Project& project)
+        {
+            const SearchPaths& search_paths = project.search_paths();
+
+            put_count(search_paths.get_explicit_path_count());
+
+            for (size_t i = 0; i < search_paths.get_explicit_path_count(); ++i)
+                put_string(search_paths.get_explicit_path(i));
+        }
+
+        void write(const Shader& shader)
+        {
+            put_string(shader.get_type());
+            put_string(shader.get_shader());
+            put_string(shader.get_layer());
+
+            put_count(shader.shader_params().size());
+
+            for (const ShaderParam& param : shader.shader_params())
+            {
+                put_string(param.get_name());
+                put_string(param.get_value_as_string());
+            }
+
+            put_string(shader.get_source_code() ? shader.get_source_code() : "");
+        }
+
+        void write(const ShaderConnection& connection)
+        {
+            put_string(connection.get_src_layer());
+            put_string(connection.get_src_param());
+            put_string(connection.get_dst_layer());
+            put_string(connection.get_dst_param());
+        }
+
+        void write(const ShaderGroup& shader_group)
+        {
+            put_string(shader_group.get_name());
+            write_collection(shader_group.shaders());
+            write_collection(shader_group.shader_connections());
+        }
+
+        void write(const SurfaceShader& surface_shader)
+        {
+            write_entity(surface_shader);
+        }
+
+        void write(const Texture& texture)
+        {
+            write_entity(texture);
+        }
+
+        void write(const TextureInstance& texture_instance)
+        {
+            put_string(texture_instance.get_name());
+            put_string(texture_instance.get_texture_name());
+            write_params(texture_instance.get_parameters());
+            put_matrix(texture_instance.get_transform().get_local_to_parent());
+        }
+    };
+}
+
+bool BinaryProjectFileWriter::write(
+    Project&        project,
+    const char*     filepath,
+    const int       options)
+{
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    RENDERER_LOG_INFO("writing binary project file %s...", filepath);
+
+    if (!(options & ProjectFileWriter::OmitHandlingAssetFiles))
+    {
+        // Manage references to external asset files.
+        const AssetHandler asset_handler(
+            project,
+            filepath,
+            (options & ProjectFileWriter::CopyAllAssets) != 0
+                ? AssetHandler::CopyAllAssets
+                : AssetHandler::CopyRelativeAssetsOnly);
+        if (!asset_handler.handle_assets())
+        {
+            RENDERER_LOG_ERROR("failed to write project file %s.", filepath);
+            return false;
+        }
+    }
+
+    // Serialize the project.
+    Writer writer(filepath, options);
+    writer.write_project(project);
+
+    // Write the file.
+    try
+    {
+        BufferedFile file(
+            filepath,
+            BufferedFile::BinaryType,
+            BufferedFile::WriteMode);
+
+        if (!file.is_open())
+            throw ExceptionIOError();
+
+        writer.write_file(file);
+
+        if (!file.close())
+            throw ExceptionIOError();
+    }
+    catch (const ExceptionIOError&)
+    {
+        RENDERER_LOG_ERROR("failed to write project file %s: i/o error.", filepath);
+        return false;
+    }
+
+    stopwatch.measure();
+
+    RENDERER_LOG_INFO(
+        "wrote binary project file %s in %s.",
+        filepath,
+        pretty_time(stopwatch.get_seconds()).c_str());
+
+    return true;
+}
+
+}   // namespace renderer
@@ -115,7 +115,7 @@ Dictionary Configuration::get_metadata()
         "sampling_mode",
         Dictionary()
             .insert("type", "enum")
-            .insert("values", "rng|qmc")
+            .insert("values", "rng|qmc|sobol")
             .insert("default", "qmc")
             .insert("label", "Sampler")
             .insert("help", "Sampling algorithm used in Monte Carlo integration")
@@ -131,7 +131,20 @@ Dictionary Configuration::get_metadata()
                         "qmc",
                         Dictionary()
                             .insert("label", "QMC")
-                            .insert("help", "Quasi Monte Carlo sampler"))));
+                            .insert("help", "Quasi Monte Carlo sampler"))
+                    .insert(
+                        "sobol",
+                        Dictionary()
+                            .insert("label", "Sobol")
+                            .insert("help", "Owen-scrambled Sobol sampler"))));
+
+    metadata.insert(
+        "sampling_blue_noise",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Blue Noise Sampling")
+            .insert("help", "Distribute the error of the Sobol sampler as blue noise in screen space"));
 
     metadata.dictionaries().insert(
         "passes",
@@ -170,6 +183,44 @@ Dictionary Configuration::get_metadata()
             .insert("label", "Render Threads")
             .insert("help", "Number of threads to use for rendering"));
 
+    metadata.insert(
+        "huge_pages",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "true")
+            .insert("label", "Huge Pages")
+            .insert("help", "Back acceleration structures and framebuffers with transparent huge pages when available"));
+
+    metadata.insert(
+        "numa_policy",
+        Dictionary()
+            .insert("type", "enum")
+            .insert("values", "first_touch|interleave")
+            .insert("default", "first_touch")
+            .insert("label", "NUMA Policy")
+            .insert("help", "Placement of acceleration structures and framebuffers on multi-socket machines")
+            .insert(
+                "options",
+                Dictionary()
+                    .insert(
+                        "first_touch",
+                        Dictionary()
+                            .insert("label", "First Touch")
+                            .insert("help", "Place memory on the socket of the thread that first writes it"))
+                    .insert(
+                        "interleave",
+                        Dictionary()
+                            .insert("label", "Interleave")
+                            .insert("help", "Distribute memory evenly across all sockets"))));
+
+    metadata.insert(
+        "soft_memory_budget",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "0")
+            .insert("label", "Soft Memory Budget")
+            .insert("help", "Warn when tracked memory usage exceeds this many bytes (0 to disable)"));
+
 #ifdef APPLESEED_WITH_EMBREE
 
     metadata.insert(
@@ -179,6 +230,14 @@ Dictionary Configuration::get_metadata()
             .insert("label", "Use Embree")
             .insert("help", "Whether to use Embree ray tracing kernels or appleseed internal ones"));
 
+    metadata.insert(
+        "use_embree_instancing",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Use Embree Instancing")
+            .insert("help", "Whether Embree also traverses assembly instances or only the geometry of assemblies"));
+
 #endif
 
     metadata.dictionaries().insert(
@@ -348,6 +348,12 @@ void Project::set_use_embree(const bool value)
         impl->m_trace_context->set_use_embree(value);
 }
 
+void Project::set_use_embree_instancing(const bool value)
+{
+    if (impl->m_trace_context)
+        impl->m_trace_context->set_use_embree_instancing(value);
+}
+
 #endif
 
 bool Project::has_trace_context() const
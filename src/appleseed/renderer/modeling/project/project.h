@@ -163,6 +163,9 @@ class APPLESEED_DLLSYMBOL Project
 #ifdef APPLESEED_WITH_EMBREE
     // Set use Embree flag for trace context
     void set_use_embree(const bool value);
+
+    // Set whether Embree also traverses assembly instances
+    void set_use_embree_instancing(const bool value);
 #endif
 
     // Return true if the trace context has already been built.
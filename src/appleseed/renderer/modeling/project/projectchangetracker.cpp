@@ -0,0 +1,370 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "projectchangetracker.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bssrdf/bssrdf.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/environment/environment.h"
+#include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/environmentshader/environmentshader.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/light/light.h"
+#include "renderer/modeling/material/material.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+#include "renderer/modeling/surfaceshader/surfaceshader.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/hash/murmurhash.h"
+#include "foundation/math/transform.h"
+#include "foundation/utility/api/apistring.h"
+#include "foundation/utility/searchpaths.h"
+#include "foundation/utility/uid.h"
+
+// Standard headers.
+#include <cstddef>
+#include <unordered_map>
+
+using namespace foundation;
+
+namespace renderer
+{
+
+//
+// ProjectChanges class implementation.
+//
+
+std::string ProjectChanges::to_string(const Type changes)
+{
+    if (changes == None)
+        return "none";
+
+    if (changes == All)
+        return "all";
+
+    static const struct { Values m_value; const char* m_name; } Names[] =
+    {
+        { Camera,   "camera" },
+        { Shading,  "shading" },
+        { Lighting, "lighting" },
+        { Geometry, "geometry" },
+        { Settings, "settings" }
+    };
+
+    std::string result;
+
+    for (const auto& entry : Names)
+    {
+        if (changes & entry.m_value)
+        {
+            if (!result.empty())
+                result += ", ";
+            result += entry.m_name;
+        }
+    }
+
+    return result;
+}
+
+
+//
+// ProjectChangeTracker class implementation.
+//
+
+namespace
+{
+    void hash_dictionary(MurmurHash& hash, const Dictionary& dictionary)
+    {
+        for (const auto& kv : dictionary.strings())
+        {
+            hash.append(kv.key());
+            hash.append(kv.value());
+        }
+
+        for (const auto& kv : dictionary.dictionaries())
+        {
+            hash.append(kv.key());
+            hash_dictionary(hash, kv.value());
+        }
+    }
+
+    void hash_shutter_times(MurmurHash& hash, const Dictionary& camera_params)
+    {
+        static const char* Names[] = { "shutter_open_begin_time", "shutter_close_end_time" };
+
+        for (const char* name : Names)
+            hash.append(camera_params.strings().exist(name) ? camera_params.strings().get(name) : "");
+    }
+
+    void hash_transform_sequence(MurmurHash& hash, const TransformSequence& sequence)
+    {
+        for (size_t i = 0, e = sequence.size(); i < e; ++i)
+        {
+            float time;
+            Transformd transform;
+            sequence.get_transform(i, time, transform);
+            hash.append(time);
+            hash.append(transform.get_local_to_parent());
+        }
+    }
+
+    struct Snapshot
+    {
+        struct Record
+        {
+            ProjectChanges::Type    m_changes;
+            std::uint64_t           m_fingerprint;
+        };
+
+        typedef std::unordered_map<UniqueID, Record> RecordMap;
+
+        RecordMap                   m_records;
+        std::uint64_t               m_settings_fingerprint;
+
+        // The fingerprint of an entity covers its signature and its parameters.
+        // Entity types whose state partly lives outside of their parameters
+        // (transforms, shader graphs) mix the extra state in through `extra`.
+        void add(
+            const Entity&               entity,
+            const ProjectChanges::Type  changes,
+            const MurmurHash&           extra = MurmurHash())
+        {
+            MurmurHash hash;
+            hash_dictionary(hash, entity.get_parameters());
+
+            Record record;
+            record.m_changes = changes;
+            record.m_fingerprint =
+                Entity::combine_signatures(
+                    Entity::combine_signatures(entity.compute_signature(), hash.h1()),
+                    extra.h1());
+
+            m_records[entity.get_uid()] = record;
+        }
+
+        template <typename EntityCollection>
+        void add_all(const EntityCollection& entities, const ProjectChanges::Type changes)
+        {
+            for (const auto& entity : entities)
+                add(entity, changes);
+        }
+
+        void add_base_group(const BaseGroup& group, const SearchPaths& search_paths)
+        {
+            // Colors and textures can be bound to any input, including lights and alpha maps.
+            add_all(group.colors(), ProjectChanges::Shading | ProjectChanges::Lighting);
+            add_all(group.textures(), ProjectChanges::Shading | ProjectChanges::Lighting | ProjectChanges::Geometry);
+            add_all(group.texture_instances(), ProjectChanges::Shading | ProjectChanges::Lighting | ProjectChanges::Geometry);
+
+            // Shader groups may be used as surface shaders or as light sources.
+            for (const auto& shader_group : group.shader_groups())
+            {
+                MurmurHash extra;
+                extra.append(shader_group.compute_definition_hash(search_paths));
+                add(shader_group, ProjectChanges::Shading | ProjectChanges::Lighting, extra);
+            }
+
+            for (const auto& assembly : group.assemblies())
+            {
+                add(assembly, ProjectChanges::Geometry | ProjectChanges::Lighting);
+                add_assembly(assembly, search_paths);
+            }
+
+            for (const auto& assembly_instance : group.assembly_instances())
+            {
+                MurmurHash extra;
+                hash_transform_sequence(extra, assembly_instance.transform_sequence());
+                add(assembly_instance, ProjectChanges::Geometry | ProjectChanges::Lighting, extra);
+            }
+        }
+
+        void add_assembly(const Assembly& assembly, const SearchPaths& search_paths)
+        {
+            add_base_group(assembly, search_paths);
+
+            add_all(assembly.bsdfs(), ProjectChanges::Shading);
+            add_all(assembly.bssrdfs(), ProjectChanges::Shading);
+            add_all(assembly.volumes(), ProjectChanges::Shading);
+            add_all(assembly.surface_shaders(), ProjectChanges::Shading);
+            add_all(assembly.edfs(), ProjectChanges::Lighting);
+            add_all(assembly.lights(), ProjectChanges::Lighting);
+
+            // Materials carry EDFs and alpha maps in addition to surface appearance.
+            add_all(assembly.materials(), ProjectChanges::Shading | ProjectChanges::Lighting | ProjectChanges::Geometry);
+
+            add_all(assembly.objects(), ProjectChanges::Geometry | ProjectChanges::Lighting);
+            add_all(assembly.object_instances(), ProjectChanges::Geometry | ProjectChanges::Lighting);
+        }
+
+        void add_project(const Project& project, const ParamArray& params)
+        {
+            m_records.clear();
+
+            const SearchPaths& search_paths = project.search_paths();
+
+            if (const Scene* scene = project.get_scene())
+            {
+                // Transforms of assembly instances are resampled over the shutter interval
+                // of the active camera when Embree traverses assembly instances.
+                MurmurHash scene_extra;
+                if (const Camera* camera = project.get_uncached_active_camera())
+                {
+                    scene_extra.append(camera->get_uid());
+                    hash_shutter_times(scene_extra, camera->get_parameters());
+                }
+
+                add(*scene, ProjectChanges::Geometry, scene_extra);
+                add_base_group(*scene, search_paths);
+
+                for (const auto& camera : scene->cameras())
+                {
+                    MurmurHash extra;
+                    hash_transform_sequence(extra, camera.transform_sequence());
+                    add(camera, ProjectChanges::Camera, extra);
+                }
+
+                if (const Environment* environment = scene->get_environment())
+                    add(*environment, ProjectChanges::Shading | ProjectChanges::Lighting);
+
+                for (const auto& environment_edf : scene->environment_edfs())
+                {
+                    MurmurHash extra;
+                    hash_transform_sequence(extra, environment_edf.transform_sequence());
+                    add(environment_edf, ProjectChanges::Lighting, extra);
+                }
+
+                add_all(scene->environment_shaders(), ProjectChanges::Shading | ProjectChanges::Lighting);
+            }
+
+            if (const Frame* frame = project.get_frame())
+                add(*frame, ProjectChanges::Settings);
+
+            MurmurHash settings_hash;
+            hash_dictionary(settings_hash, params);
+            for (size_t i = 0, e = search_paths.get_path_count(); i < e; ++i)
+                settings_hash.append(search_paths.get_path(i));
+            m_settings_fingerprint = settings_hash.h1();
+        }
+    };
+}
+
+struct ProjectChangeTracker::Impl
+{
+    bool        m_has_snapshot;
+    Snapshot    m_snapshot;
+
+    Impl()
+      : m_has_snapshot(false)
+    {
+    }
+};
+
+ProjectChangeTracker::ProjectChangeTracker()
+  : impl(new Impl())
+{
+}
+
+ProjectChangeTracker::~ProjectChangeTracker()
+{
+    delete impl;
+}
+
+void ProjectChangeTracker::clear()
+{
+    impl->m_has_snapshot = false;
+    impl->m_snapshot.m_records.clear();
+}
+
+bool ProjectChangeTracker::has_snapshot() const
+{
+    return impl->m_has_snapshot;
+}
+
+void ProjectChangeTracker::record(
+    const Project&      project,
+    const ParamArray&   params)
+{
+    impl->m_snapshot.add_project(project, params);
+    impl->m_has_snapshot = true;
+}
+
+ProjectChanges::Type ProjectChangeTracker::classify(
+    const Project&      project,
+    const ParamArray&   params) const
+{
+    if (!impl->m_has_snapshot)
+        return ProjectChanges::All;
+
+    Snapshot current;
+    current.add_project(project, params);
+
+    const Snapshot& previous = impl->m_snapshot;
+    ProjectChanges::Type changes = ProjectChanges::None;
+
+    if (current.m_settings_fingerprint != previous.m_settings_fingerprint)
+        changes |= ProjectChanges::Settings;
+
+    // Entities that were added or modified.
+    for (const auto& kv : current.m_records)
+    {
+        const auto it = previous.m_records.find(kv.first);
+        if (it == previous.m_records.end() || it->second.m_fingerprint != kv.second.m_fingerprint)
+            changes |= kv.second.m_changes;
+    }
+
+    // Entities that were removed.
+    for (const auto& kv : previous.m_records)
+    {
+        if (current.m_records.find(kv.first) == current.m_records.end())
+            changes |= kv.second.m_changes;
+    }
+
+    return changes;
+}
+
+}   // namespace renderer
@@ -0,0 +1,116 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstdint>
+#include <string>
+
+// Forward declarations.
+namespace renderer  { class ParamArray; }
+namespace renderer  { class Project; }
+
+namespace renderer
+{
+
+//
+// Classes of project edits, used to decide which parts of the renderer
+// need to be rebuilt when rendering is reinitialized.
+//
+
+class APPLESEED_DLLSYMBOL ProjectChanges
+{
+  public:
+    typedef std::uint32_t Type;
+
+    enum Values
+    {
+        None            = 0,
+        Camera          = 1UL << 0,     // cameras
+        Shading         = 1UL << 1,     // BSDFs, BSSRDFs, surface shaders, shader groups, textures
+        Lighting        = 1UL << 2,     // lights, EDFs, environment
+        Geometry        = 1UL << 3,     // objects, instances, assemblies, alpha maps, shutter of the active camera
+        Settings        = 1UL << 4,     // frame, render settings, search paths
+        All             = ~0U
+    };
+
+    // Return a human-readable description of a set of changes, e.g. "camera, shading".
+    static std::string to_string(const Type changes);
+};
+
+
+//
+// Keep track of the state of the entities of a project between two renderings
+// and classify the edits that happened in between.
+//
+// Every entity is fingerprinted from its unique ID, its version ID and its
+// parameters. Entities that appeared, disappeared or whose fingerprint changed
+// contribute the change classes of their entity type to the result.
+//
+
+class APPLESEED_DLLSYMBOL ProjectChangeTracker
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    ProjectChangeTracker();
+
+    // Destructor.
+    ~ProjectChangeTracker();
+
+    // Forget the recorded state; the next classification will report all changes.
+    void clear();
+
+    // Return true if a state has been recorded.
+    bool has_snapshot() const;
+
+    // Record the current state of a project and of the render settings.
+    void record(
+        const Project&      project,
+        const ParamArray&   params);
+
+    // Compare the current state of a project and of the render settings against
+    // the last recorded state. Returns ProjectChanges::All if no state was recorded.
+    ProjectChanges::Type classify(
+        const Project&      project,
+        const ParamArray&   params) const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}   // namespace renderer
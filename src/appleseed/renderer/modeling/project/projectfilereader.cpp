@@ -33,6 +33,7 @@
 // appleseed.renderer headers.
 #include "renderer/modeling/project-builtin/cornellboxproject.h"
 #include "renderer/modeling/project-builtin/defaultproject.h"
+#include "renderer/modeling/project/binaryprojectfilereader.h"
 #include "renderer/modeling/project/configuration.h"
 #include "renderer/modeling/project/eventcounters.h"
 #include "renderer/modeling/project/project.h"
@@ -92,7 +93,12 @@ auto_release_ptr<Project> ProjectFileReader::read(
     EventCounters event_counters;
 
     auto_release_ptr<Project> project =
-        XMLProjectFileReader::read(
+        BinaryProjectFileReader::is_binary_project_file(project_filepath)
+            ? BinaryProjectFileReader::read(
+                project_filepath,
+                options,
+                event_counters)
+            : XMLProjectFileReader::read(
                 project_filepath,
                 schema_filepath,
                 options,
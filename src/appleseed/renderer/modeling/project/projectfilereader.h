@@ -57,10 +57,12 @@ class APPLESEED_DLLSYMBOL ProjectFileReader
         OmitReadingMeshFiles        = 1UL << 0,     // do not read mesh files from disk
         OmitProjectFileUpdate       = 1UL << 1,     // do not update the project file format to the latest revision
         OmitSearchPaths             = 1UL << 2,     // do not read search paths from the project
-        OmitProjectSchemaValidation = 1UL << 3      // do not validate project against schema
+        OmitProjectSchemaValidation = 1UL << 3,     // do not validate project against schema
+        UseLightweightParser        = 1UL << 4      // parse with the built-in, multithreaded parser instead of Xerces-C++ (implies OmitProjectSchemaValidation)
     };
 
     // Read a project from disk (or load a built-in project).
+    // Binary project files are recognized by their signature.
     // Return 0 if reading or parsing the file failed.
     static foundation::auto_release_ptr<Project> read(
         const char*                     project_filepath,
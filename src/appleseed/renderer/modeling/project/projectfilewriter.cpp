@@ -31,6 +31,7 @@
 #include "projectfilewriter.h"
 
 // appleseed.renderer headers.
+#include "renderer/modeling/project/binaryprojectfilewriter.h"
 #include "renderer/modeling/project/xmlprojectfilewriter.h"
 
 // appleseed.foundation headers.
@@ -64,6 +65,12 @@ bool ProjectFileWriter::write(
             options,
             extra_comments);
 
+    if (ext == ".appleseedb")
+        return BinaryProjectFileWriter::write(
+            project,
+            filepath,
+            options);
+
     return XMLProjectFileWriter::write_plain_project_file(
         project,
         filepath,
@@ -54,7 +54,8 @@ class APPLESEED_DLLSYMBOL ProjectFileWriter
         CopyAllAssets               = 1UL << 3      // copy all asset files (by default copy asset files with relative paths only)
     };
 
-    // Write a project to disk.
+    // Write a project to disk. The file format is selected by the file extension:
+    // .appleseedz for packed projects, .appleseedb for binary projects, plain XML otherwise.
     // Returns true on success, false otherwise.
     static bool write(
         Project&        project,
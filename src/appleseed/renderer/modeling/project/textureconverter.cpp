@@ -0,0 +1,379 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "textureconverter.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/basegroup.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/texture/texture.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/hash/murmurhash.h"
+#include "foundation/platform/timers.h"
+#include "foundation/string/string.h"
+#include "foundation/utility/api/apistring.h"
+#include "foundation/utility/api/specializedapiarrays.h"
+#include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/job/ijob.h"
+#include "foundation/utility/job/jobmanager.h"
+#include "foundation/utility/job/jobqueue.h"
+#include "foundation/utility/searchpaths.h"
+#include "foundation/utility/stopwatch.h"
+
+// OIIO headers.
+#include "foundation/platform/_beginoiioheaders.h"
+#include "OpenImageIO/imagebufalgo.h"
+#include "OpenImageIO/imageio.h"
+#include "foundation/platform/_endoiioheaders.h"
+
+// Boost headers.
+#include "boost/filesystem/operations.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace boost::filesystem;
+using namespace foundation;
+
+namespace renderer
+{
+
+//
+// TextureConverter class implementation.
+//
+
+namespace
+{
+    // Bump this version whenever the conversion settings change to invalidate cached files.
+    const char* ConversionVersion = "1";
+
+    void collect_textures(const BaseGroup& group, std::vector<Texture*>& textures)
+    {
+        for (Texture& texture : group.textures())
+            textures.push_back(&texture);
+
+        for (const Assembly& assembly : group.assemblies())
+            collect_textures(assembly, textures);
+    }
+
+    // Return true if an image file is scanline or has no mipmap levels.
+    bool needs_conversion(const std::string& filepath)
+    {
+#if OIIO_VERSION < 20000
+        std::unique_ptr<OIIO::ImageInput> input(OIIO::ImageInput::open(filepath));
+#else
+        std::unique_ptr<OIIO::ImageInput> input = OIIO::ImageInput::open(filepath);
+#endif
+
+        // Let the texture report the error when it attempts to open the file.
+        if (input == nullptr)
+            return false;
+
+        const OIIO::ImageSpec& spec = input->spec();
+        const bool is_tiled = spec.tile_width > 0 && spec.tile_height > 0;
+
+        OIIO::ImageSpec mip_spec;
+        const bool is_mipmapped = input->seek_subimage(0, 1, mip_spec);
+
+        input->close();
+
+        return !is_tiled || !is_mipmapped;
+    }
+
+    //
+    // A job that converts one image file to a tiled and mipmapped .tx file.
+    //
+
+    class ConvertTextureJob
+      : public IJob
+    {
+      public:
+        ConvertTextureJob(
+            const std::string&  source_path,
+            const path&         dest_path,
+            IAbortSwitch*       abort_switch)
+          : m_source_path(source_path)
+          , m_dest_path(dest_path)
+          , m_abort_switch(abort_switch)
+          , m_success(false)
+        {
+        }
+
+        void execute(const std::size_t thread_index) override
+        {
+            if (is_aborted(m_abort_switch))
+                return;
+
+            RENDERER_LOG_INFO(
+                "converting texture file %s to %s...",
+                m_source_path.c_str(),
+                m_dest_path.string().c_str());
+
+            Stopwatch<DefaultWallclockTimer> stopwatch;
+            stopwatch.start();
+
+            // Write to a temporary file first so that an interrupted conversion
+            // never leaves a truncated file in the cache.
+            path temp_path = m_dest_path;
+            temp_path += ".tmp";
+
+            // Pixel values are preserved: color space conversion is left to the textures.
+            OIIO::ImageSpec spec;
+            spec.tile_width = 64;
+            spec.tile_height = 64;
+            spec.attribute("maketx:constant_color_detect", 1);
+            spec.attribute("maketx:fixnan", "box3");
+
+            std::stringstream errors;
+            if (!OIIO::ImageBufAlgo::make_texture(
+                    OIIO::ImageBufAlgo::MakeTxTexture,
+                    m_source_path,
+                    temp_path.string(),
+                    spec,
+                    &errors))
+            {
+                RENDERER_LOG_ERROR(
+                    "failed to convert texture file %s: %s",
+                    m_source_path.c_str(),
+                    errors.str().c_str());
+                remove_temp_file(temp_path);
+                return;
+            }
+
+            try
+            {
+                boost::filesystem::rename(temp_path, m_dest_path);
+            }
+            catch (const std::exception& e)     // namespace qualification required
+            {
+                RENDERER_LOG_ERROR(
+                    "failed to move %s to %s: %s.",
+                    temp_path.string().c_str(),
+                    m_dest_path.string().c_str(),
+                    e.what());
+                remove_temp_file(temp_path);
+                return;
+            }
+
+            stopwatch.measure();
+
+            RENDERER_LOG_DEBUG(
+                "converted texture file %s in %s.",
+                m_source_path.c_str(),
+                pretty_time(stopwatch.get_seconds()).c_str());
+
+            m_success = true;
+        }
+
+        bool is_successful() const
+        {
+            return m_success;
+        }
+
+      private:
+        const std::string   m_source_path;
+        const path          m_dest_path;
+        IAbortSwitch*       m_abort_switch;
+        bool                m_success;
+
+        static void remove_temp_file(const path& temp_path)
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(temp_path, ec);
+        }
+    };
+
+    // Make textures read converted files for the duration of the render. The parameters
+    // of the textures are left untouched so that saving the project keeps the original
+    // files. Textures without converted files revert to their own files.
+    void substitute_converted_files(
+        const std::vector<Texture*>&            textures,
+        const std::map<std::string, path>&      converted_paths)
+    {
+        StringDictionary mappings;
+        for (const auto& kv : converted_paths)
+            mappings.insert(kv.first.c_str(), kv.second.string());
+
+        for (Texture* texture : textures)
+            texture->substitute_asset_paths(mappings);
+    }
+}
+
+TextureConverter::TextureConverter(
+    Project&                project,
+    const char*             cache_directory,
+    const std::size_t       thread_count)
+  : m_project(project)
+  , m_cache_directory(absolute(cache_directory))
+  , m_thread_count(std::max<std::size_t>(thread_count, 1))
+{
+}
+
+bool TextureConverter::convert_textures(IAbortSwitch* abort_switch) const
+{
+    const Scene* scene = m_project.get_scene();
+    if (scene == nullptr)
+        return true;
+
+    try
+    {
+        create_directories(m_cache_directory);
+    }
+    catch (const std::exception& e)     // namespace qualification required
+    {
+        RENDERER_LOG_ERROR(
+            "failed to create texture cache directory %s: %s.",
+            m_cache_directory.string().c_str(),
+            e.what());
+        return false;
+    }
+
+    // Collect the textures of the scene and of all its assemblies.
+    std::vector<Texture*> textures;
+    collect_textures(*scene, textures);
+
+    // Collect the unique file paths referenced by textures.
+    std::set<std::string> asset_paths;
+    for (const Texture* texture : textures)
+    {
+        StringArray paths;
+        texture->collect_asset_paths(paths);
+
+        const std::vector<std::string> texture_paths = array_vector<std::vector<std::string>>(paths);
+        asset_paths.insert(texture_paths.begin(), texture_paths.end());
+    }
+
+    // Find which files need to be converted, and where to store them.
+    std::map<std::string, path> converted_paths;
+    std::vector<std::unique_ptr<ConvertTextureJob>> jobs;
+    std::set<path> scheduled_dest_paths;
+    std::size_t reused_file_count = 0;
+
+    for (const std::string& asset_path : asset_paths)
+    {
+        if (is_aborted(abort_switch))
+            return false;
+
+        const std::string qualified_path = to_string(m_project.search_paths().qualify(asset_path));
+
+        if (!exists(qualified_path) || !needs_conversion(qualified_path))
+            continue;
+
+        MurmurHash hash;
+        hash.append(ConversionVersion);
+        if (!hash_file_contents(qualified_path, hash))
+        {
+            RENDERER_LOG_WARNING("failed to read texture file %s, skipping conversion.", qualified_path.c_str());
+            continue;
+        }
+
+        const path dest_path = m_cache_directory / (hash.to_string() + ".tx");
+        converted_paths[asset_path] = dest_path;
+
+        if (exists(dest_path))
+        {
+            RENDERER_LOG_DEBUG(
+                "using cached texture file %s for %s.",
+                dest_path.string().c_str(),
+                qualified_path.c_str());
+            ++reused_file_count;
+        }
+        else if (scheduled_dest_paths.insert(dest_path).second)
+            jobs.emplace_back(new ConvertTextureJob(qualified_path, dest_path, abort_switch));
+    }
+
+    if (converted_paths.empty())
+    {
+        substitute_converted_files(textures, converted_paths);
+        return true;
+    }
+
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    // Convert files in parallel.
+    if (!jobs.empty())
+    {
+        JobQueue job_queue;
+        for (const std::unique_ptr<ConvertTextureJob>& job : jobs)
+            job_queue.schedule(job.get(), false);
+
+        JobManager job_manager(
+            global_logger(),
+            job_queue,
+            std::min(m_thread_count, jobs.size()));
+
+        job_manager.start();
+        job_queue.wait_until_completion();
+    }
+
+    if (is_aborted(abort_switch))
+        return false;
+
+    bool success = true;
+    for (const std::unique_ptr<ConvertTextureJob>& job : jobs)
+        success = success && job->is_successful();
+
+    if (!success)
+        return false;
+
+    stopwatch.measure();
+
+    RENDERER_LOG_INFO(
+        "converted %s texture %s and reused %s cached texture %s in %s.",
+        pretty_uint(jobs.size()).c_str(),
+        plural(jobs.size(), "file").c_str(),
+        pretty_uint(reused_file_count).c_str(),
+        plural(reused_file_count, "file").c_str(),
+        pretty_time(stopwatch.get_seconds()).c_str());
+
+    substitute_converted_files(textures, converted_paths);
+
+    return true;
+}
+
+std::string TextureConverter::get_default_cache_directory()
+{
+    return (temp_directory_path() / "appleseed" / "textures").string();
+}
+
+}   // namespace renderer
@@ -0,0 +1,80 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+// Boost headers.
+#include "boost/filesystem/path.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+// Forward declarations.
+namespace foundation    { class IAbortSwitch; }
+namespace renderer      { class Project; }
+
+namespace renderer
+{
+
+//
+// Converts the scanline or non-mipmapped image files referenced by the textures
+// of a project to tiled and mipmapped .tx files, and makes the textures read the
+// converted files until the end of the render. The parameters of the textures are
+// not modified. This allows the texture store to only load the tiles that are
+// actually accessed during rendering.
+//
+// Converted files are stored in a cache directory and named after a hash of the
+// contents of the source file, so that they are reused across renders and across
+// projects sharing the same image files.
+//
+
+class TextureConverter
+{
+  public:
+    // Constructor.
+    TextureConverter(
+        Project&                    project,
+        const char*                 cache_directory,
+        const std::size_t           thread_count);
+
+    // Convert texture files in parallel and substitute them for the original files.
+    // Return true on success, false if at least one conversion failed or if conversion was aborted.
+    bool convert_textures(foundation::IAbortSwitch* abort_switch = nullptr) const;
+
+    // Return the default cache directory.
+    static std::string get_default_cache_directory();
+
+  private:
+    Project&                        m_project;
+    const boost::filesystem::path   m_cache_directory;
+    const std::size_t               m_thread_count;
+};
+
+}   // namespace renderer
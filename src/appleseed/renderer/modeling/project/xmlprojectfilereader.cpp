@@ -110,16 +110,22 @@
 #include "foundation/memory/memory.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/defaulttimers.h"
+#include "foundation/platform/system.h"
 #include "foundation/platform/types.h"
 #include "foundation/string/string.h"
 #include "foundation/utility/api/apiarray.h"
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/iterators.h"
+#include "foundation/utility/job/ijob.h"
+#include "foundation/utility/job/jobmanager.h"
+#include "foundation/utility/job/jobqueue.h"
+#include "foundation/utility/memorymappedfile.h"
 #include "foundation/utility/otherwise.h"
 #include "foundation/utility/searchpaths.h"
 #include "foundation/utility/stopwatch.h"
 #include "foundation/utility/xercesc.h"
+#include "foundation/utility/xmlscanner.h"
 #include "foundation/utility/zip.h"
 
 // Xerces-C++ headers.
@@ -2241,6 +2247,12 @@ namespace
             return m_assembly;
         }
 
+        // Adopt an assembly that was parsed separately.
+        void set_assembly(auto_release_ptr<Assembly> assembly)
+        {
+            m_assembly = assembly;
+        }
+
       private:
         auto_release_ptr<Assembly>  m_assembly;
         std::string                 m_name;
@@ -3024,6 +3036,24 @@ namespace
       public:
         ContentHandler(Project* project, ParseContext& context)
           : m_context(context)
+        {
+            register_factories();
+        }
+
+        ContentHandler(
+            Project*                            project,
+            ParseContext&                       context,
+            std::unique_ptr<ElementHandlerType> root_handler)
+          : SAX2ContentHandler<ProjectElementID>(std::move(root_handler))
+          , m_context(context)
+        {
+            register_factories();
+        }
+
+      private:
+        ParseContext& m_context;
+
+        void register_factories()
         {
             register_factory_helper<ValuesElementHandler>("alpha", ElementAlpha);
             register_factory_helper<AOVElementHandler>("aov", ElementAOV);
@@ -3077,9 +3107,6 @@ namespace
             register_factory("project", ElementProject, std::move(factory));
         }
 
-      private:
-        ParseContext& m_context;
-
         struct ProjectElementHandlerFactory
           : public IElementHandlerFactory<ProjectElementID>
         {
@@ -3122,6 +3149,363 @@ namespace
             register_factory(name, id, std::move(factory));
         }
     };
+
+
+    //
+    // Lightweight parser.
+    //
+    // Reads a project file with foundation::XMLScanner instead of Xerces-C++'s parser and
+    // reports its content to the same content handler, so that both parsers build the same
+    // project. The document is checked for well-formedness but is not validated against
+    // the project schema.
+    //
+    // Assemblies that are direct children of the <scene> element do not depend on each
+    // other: the parser skips them and hands them over to worker threads, each with its
+    // own content handler, then inserts the resulting assemblies into the scene, in
+    // document order, right before the end of the <scene> element.
+    //
+
+    class ParseAssemblyJob;
+
+    class LightweightParser
+      : public NonCopyable
+    {
+      public:
+        LightweightParser(
+            const char*         filepath,
+            const char*         document_begin,
+            ParseContext&       context,
+            ContentHandler&     content_handler,
+            const size_t        thread_count);      // 0 to parse assemblies sequentially
+
+        ~LightweightParser();
+
+        // Parse the elements contained in [begin, end).
+        // Return false if the document is malformed.
+        bool parse(const char* begin, const char* end);
+
+      private:
+        const char*                                     m_filepath;
+        const char*                                     m_document_begin;
+        ParseContext&                                   m_context;
+        ContentHandler&                                 m_content_handler;
+        const size_t                                    m_thread_count;
+        XMLScannerAttributes                            m_attributes;
+        std::basic_string<XMLCh>                        m_name;
+        std::basic_string<XMLCh>                        m_characters;
+        std::unique_ptr<JobQueue>                       m_job_queue;
+        std::unique_ptr<JobManager>                     m_job_manager;
+        std::vector<std::unique_ptr<ParseAssemblyJob>>  m_jobs;
+
+        void schedule_assembly(const char* begin, const char* end);
+        bool insert_assemblies();
+        void wait_for_jobs();
+
+        const XMLCh* transcode_name(const XMLScanner& scanner);
+
+        void report_error(
+            const char*         position,
+            const char*         message);
+    };
+
+
+    //
+    // Root element handler of the content handlers of worker threads.
+    //
+
+    class AssemblyCollectorElementHandler
+      : public ElementHandlerBaseType
+    {
+      public:
+        void end_child_element(
+            const ProjectElementID      element,
+            ElementHandlerType*         handler) override
+        {
+            assert(element == ElementAssembly);
+            m_assembly = static_cast<AssemblyElementHandler*>(handler)->get_assembly();
+        }
+
+        auto_release_ptr<Assembly> get_assembly()
+        {
+            return m_assembly;
+        }
+
+      private:
+        auto_release_ptr<Assembly> m_assembly;
+    };
+
+
+    //
+    // Job parsing a single <assembly> element on a worker thread.
+    //
+
+    class ParseAssemblyJob
+      : public IJob
+    {
+      public:
+        ParseAssemblyJob(
+            const char*         filepath,
+            const char*         document_begin,
+            const char*         begin,
+            const char*         end,
+            ParseContext&       parent_context)
+          : m_filepath(filepath)
+          , m_document_begin(document_begin)
+          , m_begin(begin)
+          , m_end(end)
+          , m_parent_context(parent_context)
+          , m_success(false)
+        {
+        }
+
+        void execute(const size_t thread_index) override
+        {
+            // Errors are counted separately and merged once the job has completed.
+            ParseContext context(
+                m_parent_context.get_project(),
+                m_parent_context.get_options(),
+                m_event_counters);
+
+            AssemblyCollectorElementHandler* collector = new AssemblyCollectorElementHandler();
+            ContentHandler content_handler(
+                &context.get_project(),
+                context,
+                std::unique_ptr<ElementHandlerType>(collector));
+
+            LightweightParser parser(
+                m_filepath,
+                m_document_begin,
+                context,
+                content_handler,
+                0);
+
+            m_success = parser.parse(m_begin, m_end);
+            m_assembly = collector->get_assembly();
+        }
+
+        bool is_successful() const
+        {
+            return m_success;
+        }
+
+        const EventCounters& get_event_counters() const
+        {
+            return m_event_counters;
+        }
+
+        auto_release_ptr<Assembly> get_assembly()
+        {
+            return m_assembly;
+        }
+
+      private:
+        const char*                 m_filepath;
+        const char*                 m_document_begin;
+        const char*                 m_begin;
+        const char*                 m_end;
+        ParseContext&               m_parent_context;
+        EventCounters               m_event_counters;
+        bool                        m_success;
+        auto_release_ptr<Assembly>  m_assembly;
+    };
+
+
+    //
+    // LightweightParser class implementation.
+    //
+
+    bool has_name(const XMLScanner& scanner, const char* name)
+    {
+        const size_t name_length = std::strlen(name);
+
+        return
+            scanner.get_name_length() == name_length &&
+            std::memcmp(scanner.get_name(), name, name_length) == 0;
+    }
+
+    LightweightParser::LightweightParser(
+        const char*             filepath,
+        const char*             document_begin,
+        ParseContext&           context,
+        ContentHandler&         content_handler,
+        const size_t            thread_count)
+      : m_filepath(filepath)
+      , m_document_begin(document_begin)
+      , m_context(context)
+      , m_content_handler(content_handler)
+      , m_thread_count(thread_count)
+    {
+    }
+
+    LightweightParser::~LightweightParser()
+    {
+        // Jobs reference the document and the parse context; they must not outlive them.
+        wait_for_jobs();
+    }
+
+    bool LightweightParser::parse(const char* begin, const char* end)
+    {
+        XMLScanner scanner(begin, end);
+
+        // Depth of the <scene> element, or 0 outside of it.
+        size_t scene_depth = 0;
+
+        while (true)
+        {
+            switch (scanner.next())
+            {
+              case XMLScanner::TokenStartElement:
+                if (m_thread_count > 0 &&
+                    scene_depth > 0 &&
+                    scanner.get_depth() == scene_depth + 1 &&
+                    has_name(scanner, "assembly"))
+                {
+                    const char* element_begin = scanner.get_token_position();
+
+                    if (!scanner.skip_element())
+                    {
+                        report_error(scanner.get_error_position(), scanner.get_error_message().c_str());
+                        return false;
+                    }
+
+                    schedule_assembly(element_begin, scanner.get_position());
+                }
+                else
+                {
+                    if (has_name(scanner, "scene"))
+                        scene_depth = scanner.get_depth();
+
+                    const XMLCh* local_name = transcode_name(scanner);
+                    m_attributes.set(scanner);
+                    m_content_handler.startElement(
+                        XMLUni::fgZeroLenString,
+                        local_name,
+                        m_name.c_str(),
+                        m_attributes);
+                }
+                break;
+
+              case XMLScanner::TokenEndElement:
+                {
+                    if (scanner.get_depth() + 1 == scene_depth)
+                    {
+                        // All assemblies must be in the scene before it is completed.
+                        scene_depth = 0;
+                        if (!insert_assemblies())
+                            return false;
+                    }
+
+                    const XMLCh* local_name = transcode_name(scanner);
+                    m_content_handler.endElement(
+                        XMLUni::fgZeroLenString,
+                        local_name,
+                        m_name.c_str());
+                }
+                break;
+
+              case XMLScanner::TokenCharacters:
+                {
+                    const std::string& characters = scanner.get_characters();
+                    transcode_utf8(characters.data(), characters.size(), m_characters);
+                    m_content_handler.characters(m_characters.c_str(), m_characters.size());
+                }
+                break;
+
+              case XMLScanner::TokenEndOfDocument:
+                return insert_assemblies();
+
+              case XMLScanner::TokenError:
+                report_error(scanner.get_error_position(), scanner.get_error_message().c_str());
+                return false;
+
+              assert_otherwise;
+            }
+        }
+    }
+
+    void LightweightParser::schedule_assembly(const char* begin, const char* end)
+    {
+        if (!m_job_queue)
+        {
+            m_job_queue.reset(new JobQueue());
+            m_job_manager.reset(
+                new JobManager(
+                    global_logger(),
+                    *m_job_queue,
+                    m_thread_count,
+                    JobManager::KeepRunningOnEmptyQueue));
+            m_job_manager->start();
+        }
+
+        m_jobs.emplace_back(
+            new ParseAssemblyJob(
+                m_filepath,
+                m_document_begin,
+                begin,
+                end,
+                m_context));
+
+        m_job_queue->schedule(m_jobs.back().get(), false);
+    }
+
+    bool LightweightParser::insert_assemblies()
+    {
+        wait_for_jobs();
+
+        bool success = true;
+
+        for (const std::unique_ptr<ParseAssemblyJob>& job : m_jobs)
+        {
+            m_context.get_event_counters().signal_warnings(job->get_event_counters().get_warning_count());
+            m_context.get_event_counters().signal_errors(job->get_event_counters().get_error_count());
+
+            success = success && job->is_successful();
+
+            AssemblyElementHandler handler(m_context);
+            handler.set_assembly(job->get_assembly());
+            m_content_handler.insert_child_element(ElementAssembly, &handler);
+        }
+
+        m_jobs.clear();
+
+        return success;
+    }
+
+    void LightweightParser::wait_for_jobs()
+    {
+        if (m_job_queue)
+        {
+            m_job_queue->wait_until_completion();
+            m_job_manager.reset();
+            m_job_queue.reset();
+        }
+    }
+
+    const XMLCh* LightweightParser::transcode_name(const XMLScanner& scanner)
+    {
+        transcode_utf8(scanner.get_name(), scanner.get_name_length(), m_name);
+
+        // Return the local name, i.e. the qualified name stripped from its prefix.
+        const size_t colon = m_name.find(static_cast<XMLCh>(':'));
+        return colon == std::basic_string<XMLCh>::npos ? m_name.c_str() : m_name.c_str() + colon + 1;
+    }
+
+    void LightweightParser::report_error(
+        const char*             position,
+        const char*             message)
+    {
+        size_t line, column;
+        XMLScanner::get_line_and_column(m_document_begin, position, line, column);
+
+        RENDERER_LOG_ERROR(
+            "while reading %s, at line %s, column %s: %s.",
+            m_filepath,
+            pretty_uint(line).c_str(),
+            pretty_uint(column).c_str(),
+            message);
+
+        m_context.get_event_counters().signal_error();
+    }
 }
 
 namespace
@@ -3189,11 +3573,13 @@ auto_release_ptr<Project> XMLProjectFileReader::read(
         project_filepath = actual_project_filepath.data();
     }
 
+    // Xerces-C++ is also required by the lightweight parser, for string transcoding.
     XercesCContext xerces_context(global_logger());
     if (!xerces_context.is_initialized())
         return auto_release_ptr<Project>(nullptr);
 
-    if (!(options & ProjectFileReader::OmitProjectSchemaValidation) && schema_filepath == nullptr)
+    if (!(options & (ProjectFileReader::OmitProjectSchemaValidation | ProjectFileReader::UseLightweightParser)) &&
+        schema_filepath == nullptr)
     {
         RENDERER_LOG_ERROR(
             "project schema validation enabled, but no schema filepath provided.");
@@ -3243,7 +3629,8 @@ auto_release_ptr<Project> XMLProjectFileReader::read_archive(
     if (!xerces_context.is_initialized())
         return auto_release_ptr<Project>();
 
-    if (!(options & ProjectFileReader::OmitProjectSchemaValidation) && schema_filepath == nullptr)
+    if (!(options & (ProjectFileReader::OmitProjectSchemaValidation | ProjectFileReader::UseLightweightParser)) &&
+        schema_filepath == nullptr)
     {
         RENDERER_LOG_ERROR(
             "archive schema validation enabled, but no schema filepath provided.");
@@ -3280,6 +3667,9 @@ auto_release_ptr<Project> XMLProjectFileReader::load_project_file(
         project->search_paths() = *search_paths;
     }
 
+    if (options & ProjectFileReader::UseLightweightParser)
+        return load_project_file_lightweight(project, options, event_counters);
+
     // Create the error handler.
     std::unique_ptr<ErrorLogger> error_handler(
         new ErrorLoggerAndCounter(
@@ -3341,4 +3731,37 @@ auto_release_ptr<Project> XMLProjectFileReader::load_project_file(
     return project;
 }
 
+auto_release_ptr<Project> XMLProjectFileReader::load_project_file_lightweight(
+    auto_release_ptr<Project>       project,
+    const int                       options,
+    EventCounters&                  event_counters)
+{
+    const char* project_filepath = project->get_path();
+
+    RENDERER_LOG_INFO("loading project file %s...", project_filepath);
+
+    const MemoryMappedFile file(project_filepath);
+    if (!file.is_open())
+    {
+        RENDERER_LOG_ERROR("failed to open project file %s for reading.", project_filepath);
+        event_counters.signal_error();
+        return auto_release_ptr<Project>(nullptr);
+    }
+
+    ParseContext context(project.ref(), options, event_counters);
+    ContentHandler content_handler(project.get(), context);
+
+    LightweightParser parser(
+        project_filepath,
+        file.data(),
+        context,
+        content_handler,
+        System::get_logical_cpu_core_count());
+
+    if (!parser.parse(file.data(), file.data() + file.size()))
+        return auto_release_ptr<Project>(nullptr);
+
+    return project;
+}
+
 }   // namespace renderer
@@ -71,6 +71,11 @@ class XMLProjectFileReader
         const int                       options,
         EventCounters&                  event_counters,
         const foundation::SearchPaths*  search_paths = nullptr);
+
+    static foundation::auto_release_ptr<Project> load_project_file_lightweight(
+        foundation::auto_release_ptr<Project> project,
+        const int                       options,
+        EventCounters&                  event_counters);
 };
 
 }   // namespace renderer
@@ -31,6 +31,7 @@
 #include "basegroup.h"
 
 // appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
 #include "renderer/kernel/shading/oslshadingsystem.h"
 #include "renderer/modeling/color/colorentity.h"
 #include "renderer/modeling/scene/assembly.h"
@@ -40,7 +41,20 @@
 #include "renderer/modeling/texture/texture.h"
 
 // appleseed.foundation headers.
+#include "foundation/platform/timers.h"
+#include "foundation/string/string.h"
 #include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/job/ijob.h"
+#include "foundation/utility/job/jobmanager.h"
+#include "foundation/utility/job/jobqueue.h"
+#include "foundation/utility/searchpaths.h"
+#include "foundation/utility/stopwatch.h"
+
+// Standard headers.
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <unordered_set>
 
 using namespace foundation;
 
@@ -107,35 +121,198 @@ void BaseGroup::clear()
     impl->m_assembly_instances.clear();
 }
 
+namespace
+{
+    //
+    // A job that optimizes and JIT-compiles one OSL shader group.
+    //
+
+    class OptimizeShaderGroupJob
+      : public IJob
+    {
+      public:
+        OptimizeShaderGroupJob(
+            OSLShadingSystem&   shading_system,
+            const ShaderGroup&  shader_group,
+            IAbortSwitch*       abort_switch)
+          : m_shading_system(shading_system)
+          , m_shader_group(shader_group)
+          , m_abort_switch(abort_switch)
+          , m_success(false)
+          , m_time(0.0)
+        {
+        }
+
+        void execute(const size_t thread_index) override
+        {
+            if (is_aborted(m_abort_switch))
+                return;
+
+            Stopwatch<DefaultWallclockTimer> stopwatch;
+            stopwatch.start();
+
+            try
+            {
+                m_shader_group.optimize_osl_shader_group(m_shading_system);
+                m_success = true;
+            }
+            catch (const std::exception& e)
+            {
+                RENDERER_LOG_ERROR(
+                    "failed to optimize shader group \"%s\": %s.",
+                    m_shader_group.get_path().c_str(),
+                    e.what());
+            }
+
+            m_time = stopwatch.measure().get_seconds();
+        }
+
+        const ShaderGroup& get_shader_group() const
+        {
+            return m_shader_group;
+        }
+
+        bool is_successful() const
+        {
+            return m_success;
+        }
+
+        double get_time() const
+        {
+            return m_time;
+        }
+
+      private:
+        OSLShadingSystem&   m_shading_system;
+        const ShaderGroup&  m_shader_group;
+        IAbortSwitch*       m_abort_switch;
+        bool                m_success;
+        double              m_time;
+    };
+}
+
 bool BaseGroup::create_optimized_osl_shader_groups(
     OSLShadingSystem&           shading_system,
+    const SearchPaths&          search_paths,
     const ShaderCompiler*       shader_compiler,
+    const size_t                thread_count,
     IAbortSwitch*               abort_switch)
 {
-    for (Assembly& assembly : assemblies())
+    // Collect the shader groups of this group and of all child assemblies that need to be set up.
+    std::vector<ShaderGroup*> shader_groups;
+    collect_invalid_shader_groups(shader_groups);
+
+    if (shader_groups.empty())
+    {
+        shading_system.evict_unreferenced_shader_groups();
+        return true;
+    }
+
+    Stopwatch<DefaultWallclockTimer> stopwatch;
+    stopwatch.start();
+
+    // Create the OSL shader groups. This must be done sequentially since
+    // OSL's shader group construction API is stateful. Identical shader
+    // groups share a single OSL shader group.
+    const size_t initial_cached_group_count = shading_system.get_cached_shader_group_count();
+    for (ShaderGroup* shader_group : shader_groups)
     {
         if (is_aborted(abort_switch))
             return false;
 
-        if (!assembly.create_optimized_osl_shader_groups(
+        if (!shader_group->create_osl_shader_group(
                 shading_system,
+                search_paths,
                 shader_compiler,
                 abort_switch))
             return false;
     }
+    const size_t created_group_count =
+        shading_system.get_cached_shader_group_count() - initial_cached_group_count;
 
-    for (ShaderGroup& shader_group : shader_groups())
+    // Release the OSL shader groups that no shader group uses anymore.
+    const size_t evicted_group_count = shading_system.evict_unreferenced_shader_groups();
+    if (evicted_group_count > 0)
     {
-        if (is_aborted(abort_switch))
-            return false;
+        RENDERER_LOG_DEBUG(
+            "evicted %s unused %s from the cache.",
+            pretty_uint(evicted_group_count).c_str(),
+            plural(evicted_group_count, "shader group").c_str());
+    }
 
-        if (!shader_group.create_optimized_osl_shader_group(
-                shading_system,
-                shader_compiler,
-                abort_switch))
-            return false;
+    if (is_aborted(abort_switch))
+        return false;
+
+    // Optimize and JIT-compile the distinct OSL shader groups in parallel.
+    std::vector<std::unique_ptr<OptimizeShaderGroupJob>> jobs;
+    std::unordered_set<const void*> scheduled_groups;
+    for (const ShaderGroup* shader_group : shader_groups)
+    {
+        if (scheduled_groups.insert(shader_group->osl_shader_group()).second)
+        {
+            jobs.emplace_back(
+                new OptimizeShaderGroupJob(
+                    shading_system,
+                    *shader_group,
+                    abort_switch));
+        }
+    }
+
+    const size_t effective_thread_count = std::max<size_t>(std::min(thread_count, jobs.size()), 1);
+
+    JobQueue job_queue;
+    for (const std::unique_ptr<OptimizeShaderGroupJob>& job : jobs)
+        job_queue.schedule(job.get(), false);
+
+    JobManager job_manager(
+        global_logger(),
+        job_queue,
+        effective_thread_count);
+
+    job_manager.start();
+    job_queue.wait_until_completion();
+
+    if (is_aborted(abort_switch))
+        return false;
+
+    bool success = true;
+    for (const std::unique_ptr<OptimizeShaderGroupJob>& job : jobs)
+    {
+        RENDERER_LOG_DEBUG(
+            "optimized shader group \"%s\" in %s.",
+            job->get_shader_group().get_path().c_str(),
+            pretty_time(job->get_time()).c_str());
+
+        success = success && job->is_successful();
     }
 
+    if (!success)
+        return false;
+
+    // Query the properties of the optimized shader groups.
+    try
+    {
+        for (ShaderGroup* shader_group : shader_groups)
+            shader_group->query_osl_shader_group_info(shading_system);
+    }
+    catch (const std::exception& e)
+    {
+        RENDERER_LOG_ERROR("failed to query shader group properties: %s.", e.what());
+        return false;
+    }
+
+    stopwatch.measure();
+
+    RENDERER_LOG_INFO(
+        "set up %s %s (%s created, %s reused) in %s using %s %s.",
+        pretty_uint(shader_groups.size()).c_str(),
+        plural(shader_groups.size(), "shader group").c_str(),
+        pretty_uint(created_group_count).c_str(),
+        pretty_uint(shader_groups.size() - created_group_count).c_str(),
+        pretty_time(stopwatch.get_seconds()).c_str(),
+        pretty_uint(effective_thread_count).c_str(),
+        plural(effective_thread_count, "thread").c_str());
+
     return true;
 }
 
@@ -158,6 +335,18 @@ AssemblyInstanceContainer& BaseGroup::assembly_instances() const
     return impl->m_assembly_instances;
 }
 
+void BaseGroup::collect_invalid_shader_groups(std::vector<ShaderGroup*>& shader_groups) const
+{
+    for (Assembly& assembly : assemblies())
+        assembly.collect_invalid_shader_groups(shader_groups);
+
+    for (ShaderGroup& shader_group : impl->m_shader_groups)
+    {
+        if (!shader_group.is_valid())
+            shader_groups.push_back(&shader_group);
+    }
+}
+
 void BaseGroup::collect_asset_paths(StringArray& paths) const
 {
     invoke_collect_asset_paths(colors(), paths);
@@ -35,8 +35,13 @@
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
+namespace foundation    { class SearchPaths; }
 namespace foundation    { class StringArray; }
 namespace foundation    { class StringDictionary; }
 namespace renderer      { class Entity; }
@@ -45,6 +50,7 @@ namespace renderer      { class OnRenderBeginRecorder; }
 namespace renderer      { class OSLShadingSystem; }
 namespace renderer      { class Project; }
 namespace renderer      { class ShaderCompiler; }
+namespace renderer      { class ShaderGroup; }
 
 namespace renderer
 {
@@ -71,11 +77,15 @@ class APPLESEED_DLLSYMBOL BaseGroup
     // Clear the base group contents.
     void clear();
 
-    // Create OSL shader groups and optimize them.
+    // Create OSL shader groups of this group and of all child assemblies,
+    // and optimize them in parallel using a given number of threads.
+    // Search paths must be the ones from which the shading system loads shaders.
     bool create_optimized_osl_shader_groups(
-        OSLShadingSystem&           shading_system,
-        const ShaderCompiler*       shader_compiler,
-        foundation::IAbortSwitch*   abort_switch = nullptr);
+        OSLShadingSystem&              shading_system,
+        const foundation::SearchPaths& search_paths,
+        const ShaderCompiler*          shader_compiler,
+        const size_t                   thread_count,
+        foundation::IAbortSwitch*      abort_switch = nullptr);
 
     // Release internal OSL shader groups.
     void release_optimized_osl_shader_groups();
@@ -114,6 +124,8 @@ class APPLESEED_DLLSYMBOL BaseGroup
   private:
     struct Impl;
     Impl* impl;
+
+    void collect_invalid_shader_groups(std::vector<ShaderGroup*>& shader_groups) const;
 };
 
 }   // namespace renderer
@@ -37,16 +37,24 @@
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
+#include "foundation/hash/murmurhash.h"
 #include "foundation/string/string.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/searchpaths.h"
 #include "foundation/utility/uid.h"
 
+// Boost headers.
+#include "boost/filesystem.hpp"
+#include "boost/system/error_code.hpp"
+
 // Standard headers.
 #include <cassert>
+#include <cstdint>
+#include <ctime>
 #include <string>
 
 using namespace foundation;
+namespace bf = boost::filesystem;
 
 namespace renderer
 {
@@ -338,4 +346,35 @@ bool Shader::add(OSLShadingSystem& shading_system)
     return true;
 }
 
+void Shader::append_to_hash(
+    MurmurHash&             hash,
+    const SearchPaths&      search_paths) const
+{
+    hash.append(impl->m_type);
+    hash.append(impl->m_shader);
+    hash.append(get_layer());
+    hash.append(impl->m_source_code);
+
+    for (const ShaderParam& param : impl->m_params)
+        param.append_to_hash(hash);
+
+    // Source shaders are fully described by their source code. Otherwise, identify
+    // the compiled shader file so that a shader recompiled on disk is not mistaken
+    // for its previous version.
+    if (impl->m_source_code.empty())
+    {
+        std::string filename = impl->m_shader;
+        if (!ends_with(filename, ".oso"))
+            filename += ".oso";
+
+        const std::string filepath = to_string(search_paths.qualify(filename));
+        hash.append(filepath);
+
+        boost::system::error_code ec;
+        const std::time_t mtime = bf::last_write_time(bf::path(filepath), ec);
+        if (!ec)
+            hash.append(static_cast<std::uint64_t>(mtime));
+    }
+}
+
 }   // namespace renderer
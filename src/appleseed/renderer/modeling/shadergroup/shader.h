@@ -43,6 +43,7 @@
 #include <cstddef>
 
 // Forward declarations.
+namespace foundation    { class MurmurHash; }
 namespace foundation    { class SearchPaths; }
 namespace renderer      { class Assembly; }
 namespace renderer      { class OSLShadingSystem; }
@@ -100,6 +101,12 @@ class APPLESEED_DLLSYMBOL Shader
     bool compile_shader(const ShaderCompiler* compiler);
 
     bool add(OSLShadingSystem& shading_system);
+
+    // Hash the definition of this shader. Search paths are used to find the
+    // compiled shader file so that its path and modification time are included.
+    void append_to_hash(
+        foundation::MurmurHash&         hash,
+        const foundation::SearchPaths&  search_paths) const;
 };
 
 }   // namespace renderer
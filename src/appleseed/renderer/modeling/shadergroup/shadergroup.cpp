@@ -38,15 +38,19 @@
 #include "renderer/utility/paramarray.h"
 
 // appleseed.foundation headers.
+#include "foundation/hash/murmurhash.h"
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/searchpaths.h"
 #include "foundation/utility/uid.h"
 
 // Boost headers.
 #include "boost/unordered/unordered_map.hpp"
 
 // Standard headers.
+#include <cassert>
+#include <cstdint>
 #include <exception>
 #include <utility>
 
@@ -92,6 +96,7 @@ struct ShaderGroup::Impl
     ShaderContainer             m_shaders;
     ShaderConnectionContainer   m_connections;
     mutable OSL::ShaderGroupRef m_shader_group_ref;
+    std::uint64_t               m_definition_hash;
     mutable SurfaceAreaMap      m_surface_areas;
 };
 
@@ -123,6 +128,7 @@ void ShaderGroup::clear()
     impl->m_shaders.clear();
     impl->m_connections.clear();
     impl->m_shader_group_ref.reset();
+    impl->m_definition_hash = 0;
     m_flags = 0;
 }
 
@@ -187,8 +193,9 @@ void ShaderGroup::add_connection(
             dst_param);
 }
 
-bool ShaderGroup::create_optimized_osl_shader_group(
+bool ShaderGroup::create_osl_shader_group(
     OSLShadingSystem&       shading_system,
+    const SearchPaths&      search_paths,
     const ShaderCompiler*   shader_compiler,
     IAbortSwitch*           abort_switch)
 {
@@ -197,6 +204,17 @@ bool ShaderGroup::create_optimized_osl_shader_group(
 
     RENDERER_LOG_DEBUG("setting up shader group \"%s\"...", get_path().c_str());
 
+    // Reuse an identical shader group if one was already created.
+    const std::uint64_t hash = compute_definition_hash(search_paths);
+    OSL::ShaderGroupRef cached_shader_group_ref = shading_system.get_cached_shader_group(hash);
+    if (cached_shader_group_ref.get() != nullptr)
+    {
+        RENDERER_LOG_DEBUG("reusing cached osl shader group for shader group \"%s\".", get_path().c_str());
+        impl->m_shader_group_ref = cached_shader_group_ref;
+        impl->m_definition_hash = hash;
+        return true;
+    }
+
     if (!compile_source_shaders(shader_compiler))
         return false;
 
@@ -241,19 +259,8 @@ bool ShaderGroup::create_optimized_osl_shader_group(
         }
 
         impl->m_shader_group_ref = shader_group_ref;
-
-        get_shadergroup_closures_info(shading_system);
-        report_has_closure("bsdf", HasBSDFs);
-        report_has_closure(g_emission_str.c_str(), HasEmission);
-        report_has_closure(g_transparent_str.c_str(), HasTransparency);
-        report_has_closure(g_subsurface_str.c_str(), HasSubsurface);
-        report_has_closure(g_debug_str.c_str(), HasDebug);
-
-        report_has_closure("NPR", HasNPR);
-        report_has_closure(g_matte_str.c_str(), HasMatte);
-
-        get_shadergroup_globals_info(shading_system);
-        report_uses_global("dPdtime", UsesdPdTime);
+        impl->m_definition_hash = hash;
+        shading_system.insert_cached_shader_group(hash, shader_group_ref);
 
         return true;
     }
@@ -264,9 +271,65 @@ bool ShaderGroup::create_optimized_osl_shader_group(
     }
 }
 
+void ShaderGroup::optimize_osl_shader_group(OSLShadingSystem& shading_system) const
+{
+    assert(is_valid());
+
+    // Passing no shading context makes OSL use a per-thread one.
+    shading_system.optimize_group(impl->m_shader_group_ref.get(), nullptr);
+}
+
+void ShaderGroup::query_osl_shader_group_info(OSLShadingSystem& shading_system)
+{
+    assert(is_valid());
+
+    get_shadergroup_closures_info(shading_system);
+    report_has_closure("bsdf", HasBSDFs);
+    report_has_closure(g_emission_str.c_str(), HasEmission);
+    report_has_closure(g_transparent_str.c_str(), HasTransparency);
+    report_has_closure(g_subsurface_str.c_str(), HasSubsurface);
+    report_has_closure(g_debug_str.c_str(), HasDebug);
+
+    report_has_closure("NPR", HasNPR);
+    report_has_closure(g_matte_str.c_str(), HasMatte);
+
+    get_shadergroup_globals_info(shading_system);
+    report_uses_global("dPdtime", UsesdPdTime);
+
+    get_shadergroup_inputs_info(shading_system);
+    RENDERER_LOG_DEBUG(
+        "shader group \"%s\" %s.",
+        get_path().c_str(),
+        is_uniform() ? "is uniform" : "is not uniform");
+}
+
+std::uint64_t ShaderGroup::compute_definition_hash(const SearchPaths& search_paths) const
+{
+    MurmurHash hash;
+
+    for (const Shader& shader : impl->m_shaders)
+        shader.append_to_hash(hash, search_paths);
+
+    for (const ShaderConnection& connection : impl->m_connections)
+    {
+        hash.append(connection.get_src_layer());
+        hash.append(connection.get_src_param());
+        hash.append(connection.get_dst_layer());
+        hash.append(connection.get_dst_param());
+    }
+
+    return hash.h1() ^ hash.h2();
+}
+
+std::uint64_t ShaderGroup::get_definition_hash() const
+{
+    return impl->m_definition_hash;
+}
+
 void ShaderGroup::release_optimized_osl_shader_group()
 {
     impl->m_shader_group_ref.reset();
+    impl->m_definition_hash = 0;
 }
 
 const ShaderContainer& ShaderGroup::shaders() const
@@ -485,6 +548,55 @@ void ShaderGroup::report_uses_global(const char* global_name, const Flags flag)
     }
 }
 
+void ShaderGroup::get_shadergroup_inputs_info(OSLShadingSystem& shading_system)
+{
+    // Assume the shader group depends on the shading point.
+    m_flags &= ~IsUniform;
+
+    // The outputs of a shader group that doesn't read any global, user data,
+    // attribute or texture are the same at every shading point. This allows
+    // to cache them, for instance when evaluating transparency along shadow rays.
+    static const char* InputAttributeNames[] =
+    {
+        "num_globals_needed",
+        "num_userdata",
+        "num_attributes_needed",
+        "unknown_attributes_needed",
+        "num_textures_needed",
+        "unknown_textures_needed"
+    };
+
+    for (const char* attribute_name : InputAttributeNames)
+    {
+        int count = 0;
+        if (!query_int_attribute(shading_system, attribute_name, count) || count != 0)
+            return;
+    }
+
+    m_flags |= IsUniform;
+}
+
+bool ShaderGroup::query_int_attribute(
+    OSLShadingSystem&       shading_system,
+    const char*             attribute_name,
+    int&                    value) const
+{
+    if (!shading_system.getattribute(
+            impl->m_shader_group_ref.get(),
+            attribute_name,
+            value))
+    {
+        RENDERER_LOG_WARNING(
+            "getattribute: %s call failed for shader group \"%s\"; "
+            "assuming shader group is not uniform.",
+            attribute_name,
+            get_path().c_str());
+        return false;
+    }
+
+    return true;
+}
+
 void ShaderGroup::set_surface_area(
     const AssemblyInstance* assembly_instance,
     const ObjectInstance*   object_instance,
@@ -46,6 +46,7 @@
 // Forward declarations.
 namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class DictionaryArray; }
+namespace foundation    { class SearchPaths; }
 namespace renderer      { class AssemblyInstance; }
 namespace renderer      { class OSLShadingSystem; }
 namespace renderer      { class ObjectInstance; }
@@ -94,11 +95,29 @@ class APPLESEED_DLLSYMBOL ShaderGroup
         const char*                 dst_layer,
         const char*                 dst_param);
 
-    // Create internal OSL shader group.
-    bool create_optimized_osl_shader_group(
-        OSLShadingSystem&           shading_system,
-        const ShaderCompiler*       shader_compiler,
-        foundation::IAbortSwitch*   abort_switch = nullptr);
+    // Create internal OSL shader group without optimizing it.
+    // Reuse an identical shader group from the shading system's cache if there is one.
+    // Search paths must be the ones from which the shading system loads shaders.
+    bool create_osl_shader_group(
+        OSLShadingSystem&              shading_system,
+        const foundation::SearchPaths& search_paths,
+        const ShaderCompiler*          shader_compiler,
+        foundation::IAbortSwitch*      abort_switch = nullptr);
+
+    // Optimize and JIT-compile internal OSL shader group.
+    // Can be called concurrently on different shader groups.
+    void optimize_osl_shader_group(OSLShadingSystem& shading_system) const;
+
+    // Query the closures, globals and inputs used by the optimized OSL shader group.
+    void query_osl_shader_group_info(OSLShadingSystem& shading_system);
+
+    // Compute a hash of the shaders, parameters and connections of this group.
+    // Search paths are used to include the compiled shader files in the hash.
+    std::uint64_t compute_definition_hash(
+        const foundation::SearchPaths& search_paths) const;
+
+    // Return the definition hash of the internal OSL shader group, or 0 if there is none.
+    std::uint64_t get_definition_hash() const;
 
     // Release internal OSL shader group.
     void release_optimized_osl_shader_group();
@@ -136,6 +155,10 @@ class APPLESEED_DLLSYMBOL ShaderGroup
     // Return true if the shader group uses the dPdtime global.
     bool uses_dPdtime() const;
 
+    // Return true if the outputs of the shader group do not depend on the shading point,
+    // i.e. if the shader group does not read globals, user data, attributes or textures.
+    bool is_uniform() const;
+
     // Return the surface area of an object.
     // Can only be called if the shader group has emission closures.
     float get_surface_area(
@@ -173,7 +196,10 @@ class APPLESEED_DLLSYMBOL ShaderGroup
 
         // Globals.
         UsesdPdTime     = 1u << 7,
-        UsesAllGlobals  = UsesdPdTime
+        UsesAllGlobals  = UsesdPdTime,
+
+        // Inputs.
+        IsUniform       = 1u << 8
     };
 
     std::uint32_t m_flags;
@@ -192,6 +218,12 @@ class APPLESEED_DLLSYMBOL ShaderGroup
     void get_shadergroup_globals_info(OSLShadingSystem& shading_system);
     void report_uses_global(const char* global_name, const Flags flag) const;
 
+    void get_shadergroup_inputs_info(OSLShadingSystem& shading_system);
+    bool query_int_attribute(
+        OSLShadingSystem&           shading_system,
+        const char*                 attribute_name,
+        int&                        value) const;
+
     void set_surface_area(
         const AssemblyInstance* assembly_instance,
         const ObjectInstance*   object_instance,
@@ -266,4 +298,9 @@ inline bool ShaderGroup::uses_dPdtime() const
     return (m_flags & UsesdPdTime) != 0;
 }
 
+inline bool ShaderGroup::is_uniform() const
+{
+    return (m_flags & IsUniform) != 0;
+}
+
 }   // namespace renderer
@@ -34,6 +34,7 @@
 #include "renderer/kernel/shading/oslshadingsystem.h"
 
 // appleseed.foundation headers.
+#include "foundation/hash/murmurhash.h"
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/uid.h"
 
@@ -98,6 +99,36 @@ const void* ShaderParam::get_value() const
     return &impl->m_float_value;
 }
 
+void ShaderParam::append_to_hash(MurmurHash& hash) const
+{
+    hash.append(get_name());
+    hash.append(static_cast<int>(impl->m_type_desc.basetype));
+    hash.append(static_cast<int>(impl->m_type_desc.aggregate));
+    hash.append(static_cast<int>(impl->m_type_desc.vecsemantics));
+    hash.append(impl->m_type_desc.arraylen);
+
+    if (!impl->m_float_array_value.empty())
+    {
+        for (const float value : impl->m_float_array_value)
+            hash.append(value);
+    }
+    else if (!impl->m_int_array_value.empty())
+    {
+        for (const int value : impl->m_int_array_value)
+            hash.append(value);
+    }
+    else if (impl->m_type_desc == OSL::TypeDesc::TypeInt)
+        hash.append(impl->m_int_value);
+    else if (impl->m_type_desc == OSL::TypeDesc::TypeString)
+        hash.append(impl->m_string_storage);
+    else
+    {
+        // All the other param types use the float storage.
+        for (size_t i = 0, e = impl->m_type_desc.aggregate; i < e; ++i)
+            hash.append(impl->m_float_value[i]);
+    }
+}
+
 std::string ShaderParam::get_value_as_string() const
 {
     std::stringstream ss;
@@ -44,6 +44,7 @@
 #include <vector>
 
 // Forward declarations.
+namespace foundation { class MurmurHash; }
 namespace renderer  { class OSLShadingSystem; }
 namespace renderer  { class Shader; }
 
@@ -186,6 +187,8 @@ class APPLESEED_DLLSYMBOL ShaderParam
     // Return a const void pointer to this param value.
     const void* get_value() const;
 
+    void append_to_hash(foundation::MurmurHash& hash) const;
+
     // Add this param to OSL's shading system.
     bool add(OSLShadingSystem& shading_system);
 };
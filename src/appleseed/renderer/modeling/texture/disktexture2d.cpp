@@ -36,6 +36,7 @@
 #include "renderer/modeling/input/texturesource.h"
 #include "renderer/modeling/texture/texture.h"
 #include "renderer/modeling/texture/tileptr.h"
+#include "renderer/utility/memorytracker.h"
 #include "renderer/utility/messagecontext.h"
 #include "renderer/utility/paramarray.h"
 
@@ -44,8 +45,11 @@
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/colorspace.h"
 #include "foundation/image/genericprogressiveimagefilereader.h"
+#include "foundation/image/image.h"
+#include "foundation/image/mipmap.h"
 #include "foundation/image/tile.h"
 #include "foundation/platform/thread.h"
+#include "foundation/platform/types.h"
 #include "foundation/string/string.h"
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/api/specializedapiarrays.h"
@@ -54,8 +58,12 @@
 #include "foundation/utility/uid.h"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
 using namespace foundation;
 
@@ -64,9 +72,43 @@ namespace renderer
 
 namespace
 {
+    //
+    // Tile accessor reading the base level of a texture from its file, one tile at a time.
+    //
+
+    class FileTileAccessor
+    {
+      public:
+        explicit FileTileAccessor(GenericProgressiveImageFileReader& reader)
+          : m_reader(reader)
+        {
+        }
+
+        const Tile& get_tile(const size_t tile_x, const size_t tile_y)
+        {
+            // Tiles are read one at a time and are discarded right away.
+            m_tile.reset(m_reader.read_tile(tile_x, tile_y));
+            return *m_tile;
+        }
+
+      private:
+        GenericProgressiveImageFileReader&  m_reader;
+        std::unique_ptr<Tile>               m_tile;
+    };
+
+
     //
     // 2D on-disk texture.
     //
+    // MIP levels stored in the texture file (for instance in .tx files) are read as is.
+    // Textures without MIP levels get a full MIP chain, generated level by level the first
+    // time one of its tiles is requested and kept in memory until the file is closed.
+    //
+    // Generated MIP levels are not subject to the texture store budget: they use about a
+    // third of the memory of the base level for as long as the file is open, and they are
+    // reported to the memory tracker as a child of the texture. Only textures that store
+    // their MIP levels, such as .tx files, benefit from tile streaming at all levels.
+    //
 
     const char* Model = "disk_texture_2d";
 
@@ -80,6 +122,7 @@ namespace
             const SearchPaths&      search_paths)
           : Texture(name, params)
           , m_reader(&global_logger())
+          , m_file_has_mip_levels(false)
         {
             const EntityDefMessageContext context("texture", this);
 
@@ -100,6 +143,11 @@ namespace
             else m_color_space = ColorSpaceCIEXYZ;
         }
 
+        ~DiskTexture2d() override
+        {
+            release_mip_levels();
+        }
+
         void release() override
         {
             delete this;
@@ -114,11 +162,10 @@ namespace
             const Project&          project,
             const BaseGroup*        parent) override
         {
-            if (m_reader.is_open())
-            {
-                RENDERER_LOG_INFO("closing texture file %s...", m_filepath.c_str());
-                m_reader.close();
-            }
+            close_image_file();
+
+            // Substitute files only apply to the render that requested them.
+            m_substitute_filepath.clear();
 
             Texture::on_render_end(project, parent);
         }
@@ -143,6 +190,23 @@ namespace
             m_params.set("filename", mappings.get(m_params.get("filename")));
         }
 
+        void substitute_asset_paths(const StringDictionary& mappings) override
+        {
+            const char* filename = m_params.get("filename");
+            const std::string substitute_filepath =
+                mappings.exist(filename) ? mappings.get<std::string>(filename) : std::string();
+
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (substitute_filepath != m_substitute_filepath)
+            {
+                // Switch to the new file the next time pixels are read.
+                close_image_file();
+
+                m_substitute_filepath = substitute_filepath;
+            }
+        }
+
         const CanvasProperties& properties() override
         {
             boost::mutex::scoped_lock lock(m_mutex);
@@ -160,19 +224,75 @@ namespace
         TilePtr load_tile(
             const size_t            tile_x,
             const size_t            tile_y) override
+        {
+            return load_mip_level_tile(0, tile_x, tile_y);
+        }
+
+        size_t get_mip_level_count() override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            open_image_file();
+            return m_level_props.size();
+        }
+
+        const CanvasProperties& get_mip_level_properties(
+            const size_t            level) override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            open_image_file();
+            assert(level < m_level_props.size());
+            return m_level_props[level];
+        }
+
+        TilePtr load_mip_level_tile(
+            const size_t            level,
+            const size_t            tile_x,
+            const size_t            tile_y) override
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+            open_image_file();
+            assert(level < m_level_props.size());
+
+            if (m_file_has_mip_levels)
+            {
+                m_reader.choose_mip_level(level);
+                return TilePtr::make_owning(m_reader.read_tile(tile_x, tile_y));
+            }
+
+            if (level == 0)
+                return TilePtr::make_owning(m_reader.read_tile(tile_x, tile_y));
+
+            if (m_generated_levels.empty())
+                generate_mip_levels();
+
+            // The texture store owns and may evict its tiles, hand it a copy.
+            return TilePtr::make_owning(new Tile(m_generated_levels[level - 1]->tile(tile_x, tile_y)));
+        }
+
+        bool has_stored_mip_levels() override
         {
             boost::mutex::scoped_lock lock(m_mutex);
             open_image_file();
-            return TilePtr::make_owning(m_reader.read_tile(tile_x, tile_y));
+            return m_file_has_mip_levels;
         }
 
       private:
         std::string                         m_filepath;
+        std::string                         m_substitute_filepath;
         ColorSpace                          m_color_space;
 
         mutable boost::mutex                m_mutex;
         GenericProgressiveImageFileReader   m_reader;
         CanvasProperties                    m_props;
+        std::vector<CanvasProperties>       m_level_props;
+        bool                                m_file_has_mip_levels;
+        std::vector<std::unique_ptr<Image>> m_generated_levels;     // MIP levels 1 and above, when not stored in the file
+        std::string                         m_memory_owner;
+
+        const std::string& get_active_filepath() const
+        {
+            return m_substitute_filepath.empty() ? m_filepath : m_substitute_filepath;
+        }
 
         void open_image_file()
         {
@@ -180,11 +300,123 @@ namespace
             {
                 RENDERER_LOG_INFO(
                     "opening texture file %s and reading metadata...",
-                    m_filepath.c_str());
+                    get_active_filepath().c_str());
 
-                m_reader.open(m_filepath.c_str());
+                m_reader.open(get_active_filepath().c_str());
                 m_reader.read_canvas_properties(m_props);
+
+                gather_mip_level_properties();
+            }
+        }
+
+        void close_image_file()
+        {
+            if (m_reader.is_open())
+            {
+                RENDERER_LOG_INFO("closing texture file %s...", get_active_filepath().c_str());
+                m_reader.close();
             }
+
+            release_mip_levels();
+        }
+
+        void generate_mip_levels()
+        {
+            size_t memory_size = 0;
+            for (size_t level = 1; level < m_level_props.size(); ++level)
+                memory_size += m_level_props[level].m_pixel_count * m_level_props[level].m_pixel_size;
+
+            RENDERER_LOG_DEBUG(
+                "generating " FMT_SIZE_T " mip level%s of texture file %s (%s)...",
+                m_level_props.size() - 1,
+                m_level_props.size() > 2 ? "s" : "",
+                get_active_filepath().c_str(),
+                pretty_size(memory_size).c_str());
+
+            // Generated levels live outside of the texture store, account for them separately.
+            m_memory_owner = std::string(get_path().c_str()) + "/mip_levels";
+            global_memory_tracker().check_budget(
+                MemoryTracker::CategoryTexture,
+                m_memory_owner.c_str(),
+                memory_size);
+
+            // The base level is read from the file exactly once, the other levels are
+            // generated from the level right above them.
+            FileTileAccessor file_source(m_reader);
+            m_generated_levels.push_back(
+                generate_mip_level(file_source, m_props, m_level_props[1]));
+
+            for (size_t level = 2; level < m_level_props.size(); ++level)
+            {
+                ImageTileAccessor image_source(*m_generated_levels.back());
+                m_generated_levels.push_back(
+                    generate_mip_level(image_source, m_level_props[level - 1], m_level_props[level]));
+            }
+
+            global_memory_tracker().set(
+                MemoryTracker::CategoryTexture,
+                m_memory_owner.c_str(),
+                memory_size);
+        }
+
+        void release_mip_levels()
+        {
+            m_generated_levels.clear();
+
+            if (!m_memory_owner.empty())
+            {
+                global_memory_tracker().remove(MemoryTracker::CategoryTexture, m_memory_owner.c_str());
+                m_memory_owner.clear();
+            }
+        }
+
+        void gather_mip_level_properties()
+        {
+            m_level_props.clear();
+            m_level_props.push_back(m_props);
+
+            const size_t file_level_count = m_reader.get_mip_level_count();
+            m_file_has_mip_levels = file_level_count > 1;
+
+            if (m_file_has_mip_levels)
+            {
+                for (size_t level = 1; level < file_level_count; ++level)
+                {
+                    CanvasProperties props;
+                    m_reader.choose_mip_level(level);
+                    m_reader.read_canvas_properties(props);
+                    m_level_props.push_back(props);
+                }
+
+                m_reader.choose_mip_level(0);
+            }
+            else
+            {
+                // Halve the dimensions of the base level down to a single pixel.
+                size_t width = m_props.m_canvas_width;
+                size_t height = m_props.m_canvas_height;
+
+                while (width > 1 || height > 1)
+                {
+                    width = std::max<size_t>(width / 2, 1);
+                    height = std::max<size_t>(height / 2, 1);
+
+                    m_level_props.emplace_back(
+                        width,
+                        height,
+                        std::min(m_props.m_tile_width, width),
+                        std::min(m_props.m_tile_height, height),
+                        m_props.m_channel_count,
+                        m_props.m_pixel_format);
+                }
+            }
+
+            RENDERER_LOG_DEBUG(
+                "texture file %s has " FMT_SIZE_T " mip level%s (%s).",
+                get_active_filepath().c_str(),
+                m_level_props.size(),
+                m_level_props.size() > 1 ? "s" : "",
+                m_file_has_mip_levels ? "read from file" : "generated on first use");
         }
     };
 }
@@ -30,6 +30,12 @@
 // Interface header.
 #include "texture.h"
 
+// appleseed.renderer headers.
+#include "renderer/modeling/texture/tileptr.h"
+
+// Standard headers.
+#include <cassert>
+
 using namespace foundation;
 
 namespace renderer
@@ -57,4 +63,35 @@ Texture::Texture(
     set_name(name);
 }
 
+size_t Texture::get_mip_level_count()
+{
+    return 1;
+}
+
+const CanvasProperties& Texture::get_mip_level_properties(
+    const size_t        level)
+{
+    assert(level == 0);
+    return properties();
+}
+
+TilePtr Texture::load_mip_level_tile(
+    const size_t        level,
+    const size_t        tile_x,
+    const size_t        tile_y)
+{
+    assert(level == 0);
+    return load_tile(tile_x, tile_y);
+}
+
+bool Texture::has_stored_mip_levels()
+{
+    return false;
+}
+
+void Texture::substitute_asset_paths(
+    const StringDictionary& mappings)
+{
+}
+
 }   // namespace renderer
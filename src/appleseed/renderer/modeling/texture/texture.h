@@ -44,6 +44,7 @@
 
 // Forward declarations.
 namespace foundation    { class CanvasProperties; }
+namespace foundation    { class StringDictionary; }
 namespace foundation    { class Tile; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class Source; }
@@ -87,6 +88,32 @@ class APPLESEED_DLLSYMBOL Texture
     virtual TilePtr load_tile(
         const size_t                tile_x,
         const size_t                tile_y) = 0;
+
+    // Return the number of MIP levels of this texture, including the base level.
+    // Textures that are not mipmapped only have the base level.
+    virtual size_t get_mip_level_count();
+
+    // Access canvas properties of a given MIP level. Level 0 is the base level.
+    virtual const foundation::CanvasProperties& get_mip_level_properties(
+        const size_t                level);
+
+    // Load a given tile of a given MIP level. Level 0 is the base level.
+    virtual TilePtr load_mip_level_tile(
+        const size_t                level,
+        const size_t                tile_x,
+        const size_t                tile_y);
+
+    // Return true if the MIP levels of this texture are stored along with the base level,
+    // false if they are computed from the base level (or if there are none).
+    virtual bool has_stored_mip_levels();
+
+    // Read pixels from substitute files until the end of the current render, without
+    // modifying the parameters of this texture. Mappings are from asset paths, as
+    // returned by collect_asset_paths(), to absolute paths of substitute files.
+    // Asset paths without a mapping revert to their own file.
+    // The default implementation does nothing.
+    virtual void substitute_asset_paths(
+        const foundation::StringDictionary& mappings);
 };
 
 }   // namespace renderer
@@ -0,0 +1,549 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Interface header.
+#include "gridvolume.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/shading/shadingray.h"
+#include "renderer/kernel/volume/densitygrid.h"
+#include "renderer/kernel/volume/volume.h"
+#include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/utility/memorytracker.h"
+#include "renderer/utility/messagecontext.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/math/aabb.h"
+#include "foundation/math/phasefunction.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/string/string.h"
+#include "foundation/utility/api/specializedapiarrays.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/makevector.h"
+#include "foundation/utility/searchpaths.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+
+using namespace foundation;
+
+namespace renderer
+{
+
+namespace
+{
+    const char* Model = "grid_volume";
+}
+
+//
+// Grid volume.
+//
+// Transmission is computed exactly from the optical depth of the density grid. Distances
+// are sampled with delta tracking by the lighting engines (see DensityGrid).
+//
+
+class GridVolume
+  : public Volume
+{
+  public:
+    GridVolume(
+        const char*         name,
+        const ParamArray&   params)
+      : Volume(name, params)
+    {
+        m_inputs.declare("absorption", InputFormat::SpectralReflectance);
+        m_inputs.declare("absorption_multiplier", InputFormat::Float, "1.0");
+        m_inputs.declare("scattering", InputFormat::SpectralReflectance);
+        m_inputs.declare("scattering_multiplier", InputFormat::Float, "1.0");
+        m_inputs.declare("average_cosine", InputFormat::Float, "0.0");
+    }
+
+    ~GridVolume() override
+    {
+        if (!m_memory_owner.empty())
+            global_memory_tracker().remove(MemoryTracker::CategoryObject, m_memory_owner.c_str());
+    }
+
+    void release() override
+    {
+        delete this;
+    }
+
+    const char* get_model() const override
+    {
+        return Model;
+    }
+
+    bool on_frame_begin(
+        const Project&          project,
+        const BaseGroup*        parent,
+        OnFrameBeginRecorder&   recorder,
+        IAbortSwitch*           abort_switch) override
+    {
+        if (!Volume::on_frame_begin(project, parent, recorder, abort_switch))
+            return false;
+
+        const OnFrameBeginMessageContext context("volume", this);
+
+        const std::string phase_function =
+            m_params.get_required<std::string>(
+                "phase_function_model",
+                "isotropic",
+                make_vector("isotropic", "henyey"),
+                context);
+
+        if (phase_function == "isotropic")
+            m_phase_function.reset(new IsotropicPhaseFunction());
+        else if (phase_function == "henyey")
+        {
+            const float g =
+                clamp(
+                    m_params.get_optional<float>("average_cosine", 0.0f),
+                    -0.99f, +0.99f);
+            m_phase_function.reset(new HenyeyPhaseFunction(g));
+        }
+        else return false;
+
+        const std::string filepath =
+            to_string(project.search_paths().qualify(m_params.get_required<std::string>("filename", "", context)));
+
+        const AABB3d bbox(
+            m_params.get_optional<Vector3d>("bbox_min", Vector3d(0.0)),
+            m_params.get_optional<Vector3d>("bbox_max", Vector3d(1.0)));
+
+        if (!bbox.is_valid() || min_value(bbox.extent()) <= 0.0)
+        {
+            RENDERER_LOG_ERROR("%s: invalid bounding box.", context.get());
+            return false;
+        }
+
+        // Only reload the fluid file if it changed since the last frame.
+        if (m_density_grid == nullptr || filepath != m_filepath || bbox != m_density_grid->get_bbox())
+        {
+            m_density_grid.reset();
+            m_filepath.clear();
+
+            if (!load_density_grid(filepath, bbox, context))
+                return false;
+
+            m_filepath = filepath;
+        }
+
+        return true;
+    }
+
+    bool is_homogeneous() const override
+    {
+        return false;
+    }
+
+    const DensityGrid* get_density_grid() const override
+    {
+        return m_density_grid.get();
+    }
+
+    size_t compute_input_data_size() const override
+    {
+        return sizeof(InputValues);
+    }
+
+    void prepare_inputs(
+        Arena&              arena,
+        const ShadingRay&   volume_ray,
+        void*               data) const override
+    {
+        InputValues* values = static_cast<InputValues*>(data);
+
+        values->m_absorption *= values->m_absorption_multiplier;
+        values->m_scattering *= values->m_scattering_multiplier;
+
+        // Precompute extinction.
+        values->m_precomputed.m_extinction = values->m_absorption + values->m_scattering;
+    }
+
+    float sample(
+        SamplingContext&    sampling_context,
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Vector3f&           incoming) const override
+    {
+        sampling_context.split_in_place(2, 1);
+        const Vector2f s = sampling_context.next2<Vector2f>();
+
+        const Vector3f outgoing(normalize(volume_ray.m_dir));
+        return m_phase_function->sample(outgoing, s, incoming);
+    }
+
+    float evaluate(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        const Vector3f&     incoming) const override
+    {
+        const Vector3f outgoing = Vector3f(normalize(volume_ray.m_dir));
+        return m_phase_function->evaluate(outgoing, incoming);
+    }
+
+    void evaluate_transmission(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+
+        const float optical_depth =
+            m_density_grid->compute_optical_depth(
+                volume_ray.m_org,
+                volume_ray.m_dir,
+                0.0,
+                static_cast<double>(distance));
+
+        for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+            spectrum[i] = std::exp(-optical_depth * values->m_precomputed.m_extinction[i]);
+    }
+
+    void evaluate_transmission(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        Spectrum&           spectrum) const override
+    {
+        // The density grid is bounded: rays of infinite length have a finite optical depth.
+        const double tmax =
+            volume_ray.is_finite()
+                ? volume_ray.m_tmax
+                : std::numeric_limits<double>::max();
+
+        const InputValues* values = static_cast<const InputValues*>(data);
+
+        const float optical_depth =
+            m_density_grid->compute_optical_depth(
+                volume_ray.m_org,
+                volume_ray.m_dir,
+                0.0,
+                tmax);
+
+        for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+            spectrum[i] = std::exp(-optical_depth * values->m_precomputed.m_extinction[i]);
+    }
+
+    void scattering_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        spectrum = values->m_scattering;
+        spectrum *= get_density(volume_ray, distance);
+    }
+
+    const Spectrum& scattering_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        return values->m_scattering;
+    }
+
+    void absorption_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        spectrum = values->m_absorption;
+        spectrum *= get_density(volume_ray, distance);
+    }
+
+    const Spectrum& absorption_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        return values->m_absorption;
+    }
+
+    void extinction_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        spectrum = values->m_precomputed.m_extinction;
+        spectrum *= get_density(volume_ray, distance);
+    }
+
+    const Spectrum& extinction_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        return values->m_precomputed.m_extinction;
+    }
+
+  private:
+    typedef GridVolumeInputValues InputValues;
+
+    std::unique_ptr<PhaseFunction>  m_phase_function;
+    std::unique_ptr<DensityGrid>    m_density_grid;
+    std::string                     m_filepath;
+    std::string                     m_memory_owner;
+
+    float get_density(
+        const ShadingRay&   volume_ray,
+        const float         distance) const
+    {
+        return m_density_grid->get_density(volume_ray.point_at(static_cast<double>(distance)));
+    }
+
+    bool load_density_grid(
+        const std::string&                  filepath,
+        const AABB3d&                       bbox,
+        const OnFrameBeginMessageContext&   context)
+    {
+        RENDERER_LOG_INFO("%s: loading fluid file %s...", context.get(), filepath.c_str());
+
+        FluidChannels channels;
+        std::unique_ptr<VoxelGrid> fluid_grid = read_fluid_file(filepath.c_str(), channels);
+
+        if (fluid_grid == nullptr)
+        {
+            RENDERER_LOG_ERROR("%s: failed to load fluid file %s.", context.get(), filepath.c_str());
+            return false;
+        }
+
+        if (channels.m_density_index == FluidChannels::NotPresent)
+        {
+            RENDERER_LOG_ERROR("%s: fluid file %s has no density channel.", context.get(), filepath.c_str());
+            return false;
+        }
+
+        // Only keep the density channel.
+        std::unique_ptr<VoxelGrid> density_grid(
+            new VoxelGrid(
+                fluid_grid->get_xres(),
+                fluid_grid->get_yres(),
+                fluid_grid->get_zres(),
+                1));
+
+        for (size_t z = 0; z < fluid_grid->get_zres(); ++z)
+        {
+            for (size_t y = 0; y < fluid_grid->get_yres(); ++y)
+            {
+                for (size_t x = 0; x < fluid_grid->get_xres(); ++x)
+                {
+                    const float density = fluid_grid->voxel(x, y, z)[channels.m_density_index];
+                    density_grid->voxel(x, y, z)[0] = std::max(density, 0.0f);
+                }
+            }
+        }
+
+        fluid_grid.reset();
+
+        m_density_grid.reset(new DensityGrid(std::move(density_grid), 0, bbox));
+
+        const OccupancyGrid& occupancy_grid = m_density_grid->get_occupancy_grid();
+        RENDERER_LOG_INFO(
+            "%s: built density grid with " FMT_SIZE_T " empty, " FMT_SIZE_T " partially occupied "
+            "and " FMT_SIZE_T " fully occupied bricks (%s).",
+            context.get(),
+            occupancy_grid.get_empty_brick_count(),
+            occupancy_grid.get_partial_brick_count(),
+            occupancy_grid.get_full_brick_count(),
+            pretty_size(m_density_grid->get_memory_size()).c_str());
+
+        m_memory_owner = std::string(get_path().c_str());
+        global_memory_tracker().set(
+            MemoryTracker::CategoryObject,
+            m_memory_owner.c_str(),
+            m_density_grid->get_memory_size());
+
+        return true;
+    }
+};
+
+
+//
+// GridVolumeFactory class implementation.
+//
+
+void GridVolumeFactory::release()
+{
+    delete this;
+}
+
+const char* GridVolumeFactory::get_model() const
+{
+    return Model;
+}
+
+Dictionary GridVolumeFactory::get_model_metadata() const
+{
+    return
+        Dictionary()
+            .insert("name", Model)
+            .insert("label", "Grid Volume");
+}
+
+DictionaryArray GridVolumeFactory::get_input_metadata() const
+{
+    DictionaryArray metadata;
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "filename")
+            .insert("label", "Fluid File")
+            .insert("type", "file")
+            .insert("file_picker_mode", "open")
+            .insert("file_picker_type", "fluid")
+            .insert("use", "required"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "bbox_min")
+            .insert("label", "Bounding Box Min")
+            .insert("type", "text")
+            .insert("use", "optional")
+            .insert("default", "0.0 0.0 0.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "bbox_max")
+            .insert("label", "Bounding Box Max")
+            .insert("type", "text")
+            .insert("use", "optional")
+            .insert("default", "1.0 1.0 1.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "absorption")
+            .insert("label", "Absorption Coefficient")
+            .insert("type", "colormap")
+            .insert("entity_types",
+                Dictionary().insert("color", "Colors"))
+            .insert("use", "required")
+            .insert("default", "0.5"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "absorption_multiplier")
+            .insert("label", "Absorption Coefficient Multiplier")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0.0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "200.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "1.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "scattering")
+            .insert("label", "Scattering Coefficient")
+            .insert("type", "colormap")
+            .insert("entity_types",
+                Dictionary().insert("color", "Colors"))
+            .insert("use", "required")
+            .insert("default", "0.5"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "scattering_multiplier")
+            .insert("label", "Scattering Coefficient Multiplier")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0.0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "200.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "1.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "phase_function_model")
+            .insert("label", "Phase Function Model")
+            .insert("type", "enumeration")
+            .insert("items",
+                Dictionary()
+                    .insert("Isotropic", "isotropic")
+                    .insert("Henyey-Greenstein", "henyey"))
+            .insert("use", "required")
+            .insert("default", "isotropic")
+            .insert("on_change", "rebuild_form"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "average_cosine")
+            .insert("label", "Average Cosine (g)")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "-1.0")
+                    .insert("type", "soft"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "1.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "0.0")
+            .insert("visible_if",
+                Dictionary().insert("phase_function_model", "henyey")));
+
+    return metadata;
+}
+
+auto_release_ptr<Volume> GridVolumeFactory::create(
+    const char*         name,
+    const ParamArray&   params) const
+{
+    return auto_release_ptr<Volume>(new GridVolume(name, params));
+}
+
+}   // namespace renderer
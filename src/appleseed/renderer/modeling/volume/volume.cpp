@@ -64,6 +64,11 @@ Volume::Volume(
     set_name(name);
 }
 
+const DensityGrid* Volume::get_density_grid() const
+{
+    return nullptr;
+}
+
 size_t Volume::compute_input_data_size() const
 {
     return get_inputs().compute_data_size();
@@ -44,6 +44,7 @@
 
 // Forward declarations.
 namespace foundation    { class Arena; }
+namespace renderer      { class DensityGrid; }
 namespace renderer      { class ParamArray; }
 namespace renderer      { class ShadingContext; }
 namespace renderer      { class ShadingRay; }
@@ -69,6 +70,12 @@ class APPLESEED_DLLSYMBOL Volume
     // Return true if this volume represents homogeneous media, else false.
     virtual bool is_homogeneous() const = 0;
 
+    // Return the density grid of heterogeneous volumes whose coefficients are proportional
+    // to a density field, or nullptr. For such volumes, the coefficients returned for the
+    // ray origin are those of unit density; they are scaled by the density everywhere else.
+    // Returns nullptr by default.
+    virtual const DensityGrid* get_density_grid() const;
+
     // Return the size in bytes to allocate for the input values of this volume
     // and its precomputed values, if any. By default, enough space is allocated
     // for the inputs alone, i.e. this returns get_inputs().compute_data_size().
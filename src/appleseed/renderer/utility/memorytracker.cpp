@@ -0,0 +1,455 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// Interface header.
+#include "memorytracker.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+
+// appleseed.foundation headers.
+#include "foundation/containers/dictionary.h"
+#include "foundation/core/concepts/singleton.h"
+#include "foundation/string/string.h"
+
+// Boost headers.
+#include "boost/thread/locks.hpp"
+#include "boost/thread/mutex.hpp"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+
+namespace renderer
+{
+
+//
+// MemoryTracker class implementation.
+//
+
+namespace
+{
+    // Return true if a given owner is equal to or is a descendant of a given ancestor.
+    bool is_owned_by(const std::string& owner, const std::string& ancestor)
+    {
+        if (owner.compare(0, ancestor.size(), ancestor) != 0)
+            return false;
+
+        return
+            owner.size() == ancestor.size() ||
+            ancestor.empty() ||
+            ancestor.back() == '/' ||
+            owner[ancestor.size()] == '/';
+    }
+}
+
+struct MemoryTracker::Impl
+{
+    typedef std::map<std::string, std::size_t> EntryMap;
+
+    struct Entry
+    {
+        std::size_t         m_size;
+        Category            m_category;
+        const std::string*  m_owner;
+
+        bool operator<(const Entry& rhs) const
+        {
+            return m_size > rhs.m_size;
+        }
+    };
+
+    mutable boost::mutex    m_mutex;
+    EntryMap                m_entries[CategoryCount];
+    std::size_t             m_category_sizes[CategoryCount];
+    std::size_t             m_total_size;
+    std::size_t             m_peak_total_size;
+    std::size_t             m_soft_budget;
+    bool                    m_over_budget;
+
+    Impl()
+      : m_total_size(0)
+      , m_peak_total_size(0)
+      , m_soft_budget(0)
+      , m_over_budget(false)
+    {
+        std::fill(m_category_sizes, m_category_sizes + CategoryCount, std::size_t(0));
+    }
+
+    // Replace the size of an entry. Return a warning message if the soft budget was just crossed.
+    std::string update(
+        const Category          category,
+        const char*             owner,
+        const std::size_t       new_size)
+    {
+        assert(category < CategoryCount);
+        assert(owner != nullptr);
+
+        EntryMap& entries = m_entries[category];
+        std::size_t old_size = 0;
+
+        if (new_size > 0)
+        {
+            std::size_t& size = entries[owner];
+            old_size = size;
+            size = new_size;
+        }
+        else
+        {
+            const EntryMap::iterator i = entries.find(owner);
+            if (i == entries.end())
+                return std::string();
+            old_size = i->second;
+            entries.erase(i);
+        }
+
+        assert(m_category_sizes[category] >= old_size);
+        assert(m_total_size >= old_size);
+        m_category_sizes[category] += new_size - old_size;
+        m_total_size += new_size - old_size;
+        m_peak_total_size = std::max(m_peak_total_size, m_total_size);
+
+        if (m_soft_budget == 0 || m_total_size <= m_soft_budget)
+        {
+            m_over_budget = false;
+            return std::string();
+        }
+
+        if (m_over_budget)
+            return std::string();
+
+        m_over_budget = true;
+
+        return
+            "tracked memory usage of " + pretty_size(m_total_size) +
+            " exceeds soft budget of " + pretty_size(m_soft_budget) +
+            "; largest owners: " + list_largest_entries(5) + ".";
+    }
+
+    std::size_t get_size(const Category category, const char* owner) const
+    {
+        assert(category < CategoryCount);
+
+        const EntryMap::const_iterator i = m_entries[category].find(owner);
+        return i != m_entries[category].end() ? i->second : 0;
+    }
+
+    void collect_largest_entries(
+        const std::size_t       max_count,
+        std::vector<Entry>&     result) const
+    {
+        for (std::size_t c = 0; c < CategoryCount; ++c)
+        {
+            for (const auto& entry : m_entries[c])
+                result.push_back(Entry{ entry.second, static_cast<Category>(c), &entry.first });
+        }
+
+        const std::size_t count = std::min(max_count, result.size());
+        std::partial_sort(result.begin(), result.begin() + count, result.end());
+        result.resize(count);
+    }
+
+    std::string list_largest_entries(const std::size_t max_count) const
+    {
+        std::vector<Entry> entries;
+        collect_largest_entries(max_count, entries);
+
+        std::string result;
+
+        for (const Entry& entry : entries)
+        {
+            if (!result.empty())
+                result += ", ";
+
+            result +=
+                *entry.m_owner + " (" + get_category_name(entry.m_category) +
+                ", " + pretty_size(entry.m_size) + ")";
+        }
+
+        return result.empty() ? "none" : result;
+    }
+};
+
+const char* MemoryTracker::get_category_name(const Category category)
+{
+    switch (category)
+    {
+      case CategoryObject: return "object";
+      case CategoryTexture: return "texture";
+      case CategoryTree: return "tree";
+      case CategoryFrameBuffer: return "framebuffer";
+      default: return "unknown";
+    }
+}
+
+MemoryTracker::MemoryTracker()
+  : impl(new Impl())
+{
+}
+
+MemoryTracker::~MemoryTracker()
+{
+    delete impl;
+}
+
+void MemoryTracker::set(
+    const Category              category,
+    const char*                 owner,
+    const std::size_t           size)
+{
+    std::string warning;
+
+    {
+        boost::mutex::scoped_lock lock(impl->m_mutex);
+        warning = impl->update(category, owner, size);
+    }
+
+    if (!warning.empty())
+        RENDERER_LOG_WARNING("%s", warning.c_str());
+}
+
+void MemoryTracker::add(
+    const Category              category,
+    const char*                 owner,
+    const std::size_t           size)
+{
+    std::string warning;
+
+    {
+        boost::mutex::scoped_lock lock(impl->m_mutex);
+        warning = impl->update(category, owner, impl->get_size(category, owner) + size);
+    }
+
+    if (!warning.empty())
+        RENDERER_LOG_WARNING("%s", warning.c_str());
+}
+
+void MemoryTracker::subtract(
+    const Category              category,
+    const char*                 owner,
+    const std::size_t           size)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    // The entry may have been cleared in the meantime.
+    const std::size_t old_size = impl->get_size(category, owner);
+    impl->update(category, owner, old_size > size ? old_size - size : 0);
+}
+
+void MemoryTracker::remove(
+    const Category              category,
+    const char*                 owner)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    impl->update(category, owner, 0);
+}
+
+void MemoryTracker::clear()
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    for (std::size_t c = 0; c < CategoryCount; ++c)
+    {
+        impl->m_entries[c].clear();
+        impl->m_category_sizes[c] = 0;
+    }
+
+    impl->m_total_size = 0;
+    impl->m_over_budget = false;
+}
+
+std::size_t MemoryTracker::get_size(
+    const Category              category,
+    const char*                 owner) const
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    return impl->get_size(category, owner);
+}
+
+std::size_t MemoryTracker::get_owner_size(const char* owner) const
+{
+    const std::string ancestor(owner);
+    std::size_t size = 0;
+
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    for (std::size_t c = 0; c < CategoryCount; ++c)
+    {
+        const Impl::EntryMap& entries = impl->m_entries[c];
+
+        // Descendants share the ancestor as a prefix and are therefore stored contiguously.
+        for (Impl::EntryMap::const_iterator i = entries.lower_bound(ancestor), e = entries.end();
+             i != e && i->first.compare(0, ancestor.size(), ancestor) == 0; ++i)
+        {
+            if (is_owned_by(i->first, ancestor))
+                size += i->second;
+        }
+    }
+
+    return size;
+}
+
+std::size_t MemoryTracker::get_category_size(const Category category) const
+{
+    assert(category < CategoryCount);
+
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    return impl->m_category_sizes[category];
+}
+
+std::size_t MemoryTracker::get_total_size() const
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    return impl->m_total_size;
+}
+
+std::size_t MemoryTracker::get_peak_total_size() const
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    return impl->m_peak_total_size;
+}
+
+void MemoryTracker::set_soft_budget(const std::size_t size)
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    impl->m_soft_budget = size;
+    impl->m_over_budget = size > 0 && impl->m_total_size > size;
+}
+
+std::size_t MemoryTracker::get_soft_budget() const
+{
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+    return impl->m_soft_budget;
+}
+
+bool MemoryTracker::check_budget(
+    const Category              category,
+    const char*                 owner,
+    const std::size_t           size) const
+{
+    std::string warning;
+
+    {
+        boost::mutex::scoped_lock lock(impl->m_mutex);
+
+        if (impl->m_soft_budget == 0 || impl->m_total_size + size <= impl->m_soft_budget)
+            return true;
+
+        warning =
+            "allocating " + pretty_size(size) + " of " + get_category_name(category) +
+            " memory for " + owner + " would bring tracked memory usage to " +
+            pretty_size(impl->m_total_size + size) + ", exceeding soft budget of " +
+            pretty_size(impl->m_soft_budget) + "; largest owners: " +
+            impl->list_largest_entries(5) + ".";
+    }
+
+    RENDERER_LOG_WARNING("%s", warning.c_str());
+
+    return false;
+}
+
+Dictionary MemoryTracker::get_entries() const
+{
+    Dictionary result;
+
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    for (std::size_t c = 0; c < CategoryCount; ++c)
+    {
+        Dictionary entries;
+
+        for (const auto& entry : impl->m_entries[c])
+            entries.insert(entry.first.c_str(), entry.second);
+
+        result.insert(get_category_name(static_cast<Category>(c)), entries);
+    }
+
+    return result;
+}
+
+StatisticsVector MemoryTracker::get_statistics(const std::size_t max_owner_count) const
+{
+    Statistics totals;
+    Statistics owners;
+
+    boost::mutex::scoped_lock lock(impl->m_mutex);
+
+    for (std::size_t c = 0; c < CategoryCount; ++c)
+        totals.insert_size(get_category_name(static_cast<Category>(c)), impl->m_category_sizes[c]);
+
+    totals.insert_size("total", impl->m_total_size);
+    totals.insert_size("peak total", impl->m_peak_total_size);
+
+    if (impl->m_soft_budget > 0)
+        totals.insert_size("soft budget", impl->m_soft_budget);
+
+    std::vector<Impl::Entry> entries;
+    impl->collect_largest_entries(max_owner_count, entries);
+
+    for (const Impl::Entry& entry : entries)
+    {
+        owners.insert_size(
+            *entry.m_owner + " (" + get_category_name(entry.m_category) + ")",
+            entry.m_size);
+    }
+
+    StatisticsVector vec;
+    vec.insert("memory usage", totals);
+    vec.insert("largest memory owners", owners);
+    return vec;
+}
+
+
+//
+// Global memory tracker.
+//
+
+namespace
+{
+    class GlobalMemoryTracker
+      : public Singleton<MemoryTracker>
+    {
+      private:
+        friend class Singleton<MemoryTracker>;
+
+        GlobalMemoryTracker() {}
+    };
+}
+
+MemoryTracker& global_memory_tracker()
+{
+    return GlobalMemoryTracker::instance();
+}
+
+}   // namespace renderer
@@ -0,0 +1,155 @@
+
+//
+// This source file is part of appleseed.
+// Visit https://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2020 Francois Beaune, The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/utility/statistics.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace foundation    { class Dictionary; }
+
+namespace renderer
+{
+
+//
+// Attributes memory usage to the entities that own it.
+//
+// Owners are identified by a path such as the path of a scene entity. Sizes attributed
+// to an owner are also attributed to all its ancestors, e.g. the memory used by the
+// triangle tree of an assembly can be queried together with that of its objects.
+//
+// An optional soft budget can be set: the tracker then warns, once each time the budget
+// is crossed, when the total amount of tracked memory exceeds it. Large allocations can
+// additionally check the budget before they are made.
+//
+// All methods of this class are thread-safe.
+//
+
+class APPLESEED_DLLSYMBOL MemoryTracker
+  : public foundation::NonCopyable
+{
+  public:
+    enum Category
+    {
+        CategoryObject,             // geometry of objects
+        CategoryTexture,            // texture tiles held in texture stores
+        CategoryTree,               // acceleration structures and intersection filters
+        CategoryFrameBuffer,        // frame images and render buffers
+        CategoryCount
+    };
+
+    // Return the name of a category.
+    static const char* get_category_name(const Category category);
+
+    // Constructor.
+    MemoryTracker();
+
+    // Destructor.
+    ~MemoryTracker();
+
+    // Attribute a given number of bytes to an owner, replacing any previous amount.
+    // Attributing 0 bytes is equivalent to calling remove().
+    void set(
+        const Category          category,
+        const char*             owner,
+        const std::size_t       size);
+
+    // Increase or decrease the number of bytes attributed to an owner.
+    void add(
+        const Category          category,
+        const char*             owner,
+        const std::size_t       size);
+    void subtract(
+        const Category          category,
+        const char*             owner,
+        const std::size_t       size);
+
+    // Stop attributing memory to an owner.
+    void remove(
+        const Category          category,
+        const char*             owner);
+
+    // Forget all tracked memory. The soft budget and the peak size are kept.
+    void clear();
+
+    // Return the number of bytes attributed to an owner in a given category.
+    std::size_t get_size(
+        const Category          category,
+        const char*             owner) const;
+
+    // Return the number of bytes attributed to an owner and its descendants, in all categories.
+    std::size_t get_owner_size(const char* owner) const;
+
+    // Return the number of bytes attributed to a given category.
+    std::size_t get_category_size(const Category category) const;
+
+    // Return the total number of tracked bytes.
+    std::size_t get_total_size() const;
+
+    // Return the highest total number of tracked bytes seen so far.
+    std::size_t get_peak_total_size() const;
+
+    // Set/get the soft memory budget in bytes. A budget of 0 disables budget checks.
+    void set_soft_budget(const std::size_t size);
+    std::size_t get_soft_budget() const;
+
+    // Return true if allocating a given number of additional bytes for an owner would keep
+    // the total within the soft budget. Otherwise, log a warning listing the largest owners
+    // and return false. Always return true if no soft budget is set.
+    bool check_budget(
+        const Category          category,
+        const char*             owner,
+        const std::size_t       size) const;
+
+    // Return all tracked entries as { category name: { owner: size in bytes } }.
+    foundation::Dictionary get_entries() const;
+
+    // Return statistics listing the per-category totals and the largest owners.
+    foundation::StatisticsVector get_statistics(const std::size_t max_owner_count = 10) const;
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+
+//
+// A globally accessible memory tracker.
+//
+
+APPLESEED_DLLSYMBOL MemoryTracker& global_memory_tracker();
+
+}   // namespace renderer
@@ -106,12 +106,12 @@ SamplingContext::Mode get_sampling_context_mode(const ParamArray& params)
         params.get_required<std::string>(
             "sampling_mode",
             "qmc",
-            make_vector("rng", "qmc"));
+            make_vector("rng", "qmc", "sobol"));
 
     return
-        sampling_mode == "rng"
-            ? SamplingContext::RNGMode
-            : SamplingContext::QMCMode;
+        sampling_mode == "rng" ? SamplingContext::RNGMode :
+        sampling_mode == "sobol" ? SamplingContext::SobolMode :
+        SamplingContext::QMCMode;
 }
 
 std::string get_sampling_context_mode_name(const SamplingContext::Mode mode)
@@ -120,10 +120,16 @@ std::string get_sampling_context_mode_name(const SamplingContext::Mode mode)
     {
       case SamplingContext::RNGMode: return "rng";
       case SamplingContext::QMCMode: return "qmc";
+      case SamplingContext::SobolMode: return "sobol";
       default: return "unknown";
     }
 }
 
+bool get_sampling_blue_noise(const ParamArray& params)
+{
+    return params.get_optional<bool>("sampling_blue_noise", false);
+}
+
 size_t get_rendering_thread_count(const ParamArray& params)
 {
     const size_t core_count = System::get_logical_cpu_core_count();
@@ -171,4 +177,28 @@ size_t get_rendering_thread_count(const ParamArray& params)
     return thread_count;
 }
 
+bool get_use_huge_pages(const ParamArray& params)
+{
+    return params.get_optional<bool>("huge_pages", true);
+}
+
+NUMAPolicy get_numa_policy(const ParamArray& params)
+{
+    const std::string numa_policy =
+        params.get_optional<std::string>(
+            "numa_policy",
+            "first_touch",
+            make_vector("first_touch", "interleave"));
+
+    return
+        numa_policy == "interleave"
+            ? NUMAPolicy::Interleave
+            : NUMAPolicy::FirstTouch;
+}
+
+size_t get_soft_memory_budget(const ParamArray& params)
+{
+    return params.get_optional<size_t>("soft_memory_budget", 0);
+}
+
 }   // namespace renderer
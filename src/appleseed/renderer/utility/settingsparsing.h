@@ -31,6 +31,9 @@
 // appleseed.renderer headers.
 #include "renderer/global/globaltypes.h"
 
+// appleseed.foundation headers.
+#include "foundation/memory/largeallocator.h"
+
 // appleseed.main headers.
 #include "main/dllsymbol.h"
 
@@ -55,7 +58,17 @@ std::string get_spectrum_mode_name(const Spectrum::Mode mode);
 APPLESEED_DLLSYMBOL SamplingContext::Mode get_sampling_context_mode(const ParamArray& params);
 std::string get_sampling_context_mode_name(const SamplingContext::Mode mode);
 
+// Whether pixels share the same scrambled sequence, decorrelated by a blue noise mask (Sobol mode only).
+bool get_sampling_blue_noise(const ParamArray& params);
+
 // Rendering threads.
 APPLESEED_DLLSYMBOL size_t get_rendering_thread_count(const ParamArray& params);
 
+// Placement of large allocations such as acceleration structures and framebuffers.
+bool get_use_huge_pages(const ParamArray& params);
+foundation::NUMAPolicy get_numa_policy(const ParamArray& params);
+
+// Soft memory budget in bytes, 0 if none.
+size_t get_soft_memory_budget(const ParamArray& params);
+
 }   // namespace renderer